@@ -0,0 +1,48 @@
+/*
+  BLE advertising backend
+
+  The GAP calls behind BLE_TX. BLE_TX builds the payloads, the backend
+  owns the advertising sets and gets the data on air. Keeping this
+  interface small lets the payload code run against a fake GAP.
+ */
+#pragma once
+
+#include <stdint.h>
+
+class BLE_Backend {
+public:
+    enum class Set : uint8_t {
+        LEGACY = 0, // BT4 legacy advertising on the 1M PHY
+        LONGRANGE,  // BT5 extended advertising on the coded PHY
+        COUNT
+    };
+
+    struct SetConfig {
+        // advertising interval range in 0.625ms units
+        uint32_t interval_min;
+        uint32_t interval_max;
+        // requested power in dBm and matching esp_power_level_t
+        int8_t tx_power_dBm;
+        uint8_t power_level;
+    };
+
+    // bring up the controller and use mac as the random static address
+    virtual bool init(const uint8_t mac[6]) = 0;
+
+    // set the advertising parameters of a set, before it is started
+    virtual bool configure(Set set, const SetConfig &config) = 0;
+
+    /*
+      queue new advertising data for a set. A started set keeps
+      advertising its previous data until the update completes, it is
+      never stopped. If an update is still in flight the newest data
+      replaces any data waiting behind it
+     */
+    virtual bool set_data(Set set, const uint8_t *data, uint8_t len) = 0;
+
+    // start advertising a set, after its first set_data()
+    virtual bool start(Set set) = 0;
+};
+
+// backend on the ESP-IDF extended advertising GAP API
+BLE_Backend &ble_backend_esp(void);
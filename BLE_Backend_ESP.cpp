@@ -0,0 +1,222 @@
+/*
+  BLE advertising backend on the ESP-IDF GAP extended advertising API
+
+  Two advertising sets are created once at startup and never stopped:
+  set 0 sends legacy PDUs on the 1M PHY for BT4 receivers, set 1 sends
+  extended advertisements on the coded PHY for long range. Data updates
+  are double buffered per set: the loop writes the back buffer and the
+  front buffer is handed to the stack, with at most one update per set
+  in flight. The GAP callback runs in the Bluetooth task and issues the
+  waiting update when the previous one completes.
+ */
+
+#include "BLE_Backend.h"
+#include <Arduino.h>
+#include <string.h>
+#include <BLEDevice.h>
+#include <esp_bt.h>
+#include <esp_gap_ble_api.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+// largest payload of a single extended advertising data fragment
+#define BLE_ADV_DATA_MAX 251
+
+// wait for a setup call to complete
+#define BLE_SETUP_TIMEOUT_MS 200
+
+class BLE_Backend_ESP : public BLE_Backend {
+public:
+    bool init(const uint8_t mac[6]) override;
+    bool configure(Set set, const SetConfig &config) override;
+    bool set_data(Set set, const uint8_t *data, uint8_t len) override;
+    bool start(Set set) override;
+
+    void gap_event(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param_t *param);
+
+private:
+    struct AdvSet {
+        uint8_t buf[2][BLE_ADV_DATA_MAX];
+        uint8_t len[2];
+        // buffer owned by the stack, the other one takes new data
+        uint8_t front;
+        bool busy;
+        bool pending;
+    } sets[uint8_t(Set::COUNT)];
+
+    uint8_t mac[6];
+    SemaphoreHandle_t setup_done;
+    esp_bt_status_t setup_status;
+    portMUX_TYPE lock = portMUX_INITIALIZER_UNLOCKED;
+
+    bool wait_setup(const char *what, esp_err_t err);
+    void send(uint8_t instance, uint8_t idx);
+};
+
+static BLE_Backend_ESP backend_esp;
+
+BLE_Backend &ble_backend_esp(void)
+{
+    return backend_esp;
+}
+
+static void gap_event_handler(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param_t *param)
+{
+    backend_esp.gap_event(event, param);
+}
+
+bool BLE_Backend_ESP::init(const uint8_t _mac[6])
+{
+    memcpy(mac, _mac, sizeof(mac));
+    setup_done = xSemaphoreCreateBinary();
+    if (setup_done == nullptr) {
+        return false;
+    }
+    BLEDevice::init("");
+    BLEDevice::setCustomGapHandler(gap_event_handler);
+    return true;
+}
+
+/*
+  setup calls are asynchronous, wait for their completion event
+ */
+bool BLE_Backend_ESP::wait_setup(const char *what, esp_err_t err)
+{
+    if (err != ESP_OK) {
+        Serial.printf("BLE %s failed: %d\n", what, int(err));
+        return false;
+    }
+    if (xSemaphoreTake(setup_done, pdMS_TO_TICKS(BLE_SETUP_TIMEOUT_MS)) != pdTRUE) {
+        Serial.printf("BLE %s timed out\n", what);
+        return false;
+    }
+    if (setup_status != ESP_BT_STATUS_SUCCESS) {
+        Serial.printf("BLE %s failed: status %d\n", what, int(setup_status));
+        return false;
+    }
+    return true;
+}
+
+bool BLE_Backend_ESP::configure(Set set, const SetConfig &config)
+{
+    const uint8_t instance = uint8_t(set);
+    esp_ble_gap_ext_adv_params_t params {};
+    if (set == Set::LEGACY) {
+        params.type = ESP_BLE_GAP_SET_EXT_ADV_PROP_LEGACY_NONCONN;
+        params.primary_phy = ESP_BLE_GAP_PHY_1M;
+        params.secondary_phy = ESP_BLE_GAP_PHY_1M;
+    } else {
+        // the controller uses S8 coding for coded PHY advertising
+        params.type = ESP_BLE_GAP_SET_EXT_ADV_PROP_NONCONN_NONSCANNABLE_UNDIRECTED;
+        params.primary_phy = ESP_BLE_GAP_PHY_CODED;
+        params.secondary_phy = ESP_BLE_GAP_PHY_CODED;
+    }
+    params.interval_min = config.interval_min;
+    params.interval_max = config.interval_max;
+    params.channel_map = ADV_CHNL_ALL;
+    params.own_addr_type = BLE_ADDR_TYPE_RANDOM;
+    params.filter_policy = ADV_FILTER_ALLOW_SCAN_ANY_CON_ANY;
+    params.tx_power = config.tx_power_dBm;
+    params.max_skip = 0;
+    params.sid = instance;
+    params.scan_req_notif = false;
+
+    if (set == Set::LEGACY) {
+        // legacy PDUs take the power level of the advertising type
+        esp_ble_tx_power_set(ESP_BLE_PWR_TYPE_ADV, esp_power_level_t(config.power_level));
+    }
+
+    if (!wait_setup("set params", esp_ble_gap_ext_adv_set_params(instance, &params))) {
+        return false;
+    }
+    return wait_setup("set address", esp_ble_gap_ext_adv_set_rand_addr(instance, mac));
+}
+
+/*
+  hand a buffer to the stack. Called without the lock as it posts to
+  the Bluetooth task; the stack copies the data before returning, and
+  the completion event can't flip the buffers before that
+ */
+void BLE_Backend_ESP::send(uint8_t instance, uint8_t idx)
+{
+    auto &s = sets[instance];
+    if (esp_ble_gap_config_ext_adv_data_raw(instance, s.len[idx], s.buf[idx]) != ESP_OK) {
+        portENTER_CRITICAL(&lock);
+        s.busy = false;
+        portEXIT_CRITICAL(&lock);
+    }
+}
+
+bool BLE_Backend_ESP::set_data(Set set, const uint8_t *data, uint8_t len)
+{
+    const uint8_t instance = uint8_t(set);
+    if (len > BLE_ADV_DATA_MAX) {
+        return false;
+    }
+    auto &s = sets[instance];
+    bool send_now = false;
+    portENTER_CRITICAL(&lock);
+    const uint8_t back = s.front ^ 1;
+    memcpy(s.buf[back], data, len);
+    s.len[back] = len;
+    if (s.busy) {
+        // goes out when the update in flight completes
+        s.pending = true;
+    } else {
+        s.front = back;
+        s.busy = true;
+        send_now = true;
+    }
+    portEXIT_CRITICAL(&lock);
+    if (send_now) {
+        send(instance, back);
+    }
+    return true;
+}
+
+bool BLE_Backend_ESP::start(Set set)
+{
+    const esp_ble_gap_ext_adv_t adv {
+        .instance = uint8_t(set),
+        .duration = 0,
+        .max_events = 0,
+    };
+    return esp_ble_gap_ext_adv_start(1, &adv) == ESP_OK;
+}
+
+void BLE_Backend_ESP::gap_event(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param_t *param)
+{
+    switch (event) {
+    case ESP_GAP_BLE_EXT_ADV_SET_PARAMS_COMPLETE_EVT:
+        setup_status = param->ext_adv_set_params.status;
+        xSemaphoreGive(setup_done);
+        break;
+    case ESP_GAP_BLE_EXT_ADV_SET_RAND_ADDR_COMPLETE_EVT:
+        setup_status = param->ext_adv_set_rand_addr.status;
+        xSemaphoreGive(setup_done);
+        break;
+    case ESP_GAP_BLE_EXT_ADV_DATA_SET_COMPLETE_EVT: {
+        const uint8_t instance = param->ext_adv_data_set.instance;
+        if (instance >= uint8_t(Set::COUNT)) {
+            break;
+        }
+        auto &s = sets[instance];
+        bool send_now = false;
+        portENTER_CRITICAL(&lock);
+        s.busy = s.pending;
+        if (s.pending) {
+            s.pending = false;
+            s.front ^= 1;
+            send_now = true;
+        }
+        const uint8_t front = s.front;
+        portEXIT_CRITICAL(&lock);
+        if (send_now) {
+            send(instance, front);
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
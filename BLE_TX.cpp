@@ -10,64 +10,74 @@
 #include "BLE_TX.h"
 #include "options.h"
 #include <esp_system.h>
-
-#include <BLEDevice.h>
-#include <BLEAdvertising.h>
+#include <esp_bt.h>
 #include "parameters.h"
-#include "opendroneid_wifi_stubs.h"
-
+#include "tx_scheduler.h"
+#include "util.h"
 
+// AD type of the shortened local name
+#define BLE_AD_TYPE_NAME_SHORT 0x08
 
-// BLE advertising parameters - commented out due to API changes
-// TODO: Update to current ESP32 BLE advertising API
 /*
-//interval min/max are configured for 1 Hz update rate. Somehow dynamic setting of these fields fails
-//shorter intervals lead to more BLE transmissions. This would result in increased power consumption and can lead to more interference to other radio systems.
-static esp_ble_gap_ext_adv_params_t legacy_adv_params = {
-    .type = ESP_BLE_GAP_SET_EXT_ADV_PROP_LEGACY_NONCONN,
-    .interval_min = 192,
-    .interval_max = 267,
-    .channel_map = ADV_CHNL_ALL,
-    .own_addr_type = BLE_ADDR_TYPE_RANDOM,
-    .filter_policy = ADV_FILTER_ALLOW_SCAN_ANY_CON_WLST, // we want unicast non-connectable transmission
-    .tx_power = 0,
-    .primary_phy = ESP_BLE_GAP_PHY_1M,
-    .max_skip = 0,
-    .secondary_phy = ESP_BLE_GAP_PHY_1M,
-    .sid = 0,
-    .scan_req_notif = false,
-};
-
-static esp_ble_gap_ext_adv_params_t ext_adv_params_coded = {
-    .type = ESP_BLE_GAP_SET_EXT_ADV_PROP_NONCONN_NONSCANNABLE_UNDIRECTED, //set to unicast advertising
-    .interval_min = 1200,
-    .interval_max = 1600,
-    .channel_map = ADV_CHNL_ALL,
-    .own_addr_type = BLE_ADDR_TYPE_RANDOM,
-    .filter_policy = ADV_FILTER_ALLOW_SCAN_ANY_CON_WLST, // we want unicast non-connectable transmission
-    .tx_power = 0,
-    .primary_phy = ESP_BLE_GAP_PHY_CODED,
-    .max_skip = 0,
-    .secondary_phy = ESP_BLE_GAP_PHY_CODED,
-    .sid = 1,
-    .scan_req_notif = false,
+  controller power levels, highest first
+ */
+static const struct {
+    int8_t dBm;
+    esp_power_level_t level;
+} power_levels[] {
+    {  18, ESP_PWR_LVL_P18 },
+    {  15, ESP_PWR_LVL_P15 },
+    {  12, ESP_PWR_LVL_P12 },
+    {   9, ESP_PWR_LVL_P9 },
+    {   6, ESP_PWR_LVL_P6 },
+    {   3, ESP_PWR_LVL_P3 },
+    {   0, ESP_PWR_LVL_N0 },
+    {  -3, ESP_PWR_LVL_N3 },
+    {  -6, ESP_PWR_LVL_N6 },
+    {  -9, ESP_PWR_LVL_N9 },
+    { -12, ESP_PWR_LVL_N12 },
+    { -15, ESP_PWR_LVL_N15 },
+    { -18, ESP_PWR_LVL_N18 },
+    { -21, ESP_PWR_LVL_N21 },
+    { -24, ESP_PWR_LVL_N24 },
 };
-*/
 
 /*
-  map dBm to a TX power
+  map dBm to a TX power level, rounding down so we never transmit
+  above the requested power. Requests below the table get the lowest
+  level
  */
 uint8_t BLE_TX::dBm_to_tx_power(float dBm) const
 {
-    // TODO: Update to current ESP32 BLE power level constants
-    // Power level constants have changed in newer ESP32 BLE library
-    return 0; // Default power level
+    for (const auto &p : power_levels) {
+        if (dBm >= p.dBm) {
+            return p.level;
+        }
+    }
+    return ESP_PWR_LVL_N24;
 }
 
-
-// BLEMultiAdvertising not available in current ESP32 BLE library
-// TODO: Implement BLE advertising with current API
-// static BLEMultiAdvertising advert(2);
+/*
+  configure an advertising set for slots updates per cycle at rate_hz.
+  The advertising interval is 75% to 100% of the update interval, so
+  every update is on air at least once despite the random advertising
+  delay, without flooding the channel with repeats
+ */
+void BLE_TX::set_config(BLE_Backend::Set set, float rate_hz, uint8_t slots, float dBm)
+{
+    uint32_t interval_ms = TX_Scheduler::interval_ms(rate_hz, slots);
+    if (interval_ms == 0) {
+        // disabled, the set is never started
+        interval_ms = 1000;
+    }
+    BLE_Backend::SetConfig config {};
+    // 0.625ms units, 20ms minimum
+    config.interval_max = MAX(interval_ms * 8 / 5, 0x20U);
+    config.interval_min = MAX(config.interval_max * 3 / 4, 0x20U);
+    config.tx_power_dBm = int8_t(constrain(dBm, -24.0f, 18.0f));
+    config.power_level = dBm_to_tx_power(dBm);
+    backend.configure(set, config);
+}
 
 bool BLE_TX::init(void)
 {
@@ -75,17 +85,6 @@ bool BLE_TX::init(void)
         return true;
     }
     initialised = true;
-    BLEDevice::init("");
-
-    // setup power levels - TODO: Update to current BLE API
-    // legacy_adv_params.tx_power = dBm_to_tx_power(g.bt4_power);
-    // ext_adv_params_coded.tx_power = dBm_to_tx_power(g.bt5_power);
-
-    // setup advertising rates - TODO: Update to current BLE API
-    // legacy_adv_params.interval_max = (1000/(g.bt4_rate))/0.625;
-    // legacy_adv_params.interval_min = 0.75*legacy_adv_params.interval_max;
-    // ext_adv_params_coded.interval_max =  (1000/(g.bt5_rate))/0.625;
-    // ext_adv_params_coded.interval_min = 0.75*ext_adv_params_coded.interval_max;
 
     // generate random mac address
     uint8_t mac_addr[6];
@@ -94,33 +93,42 @@ bool BLE_TX::init(void)
     // set as a bluetooth random static address
     mac_addr[0] |= 0xc0;
 
-    // TODO: Implement with current BLE API
-    // advert.setAdvertisingParams(0, &legacy_adv_params);
-    // advert.setInstanceAddress(0, mac_addr);
-    // advert.setDuration(0);
-
-    // advert.setAdvertisingParams(1, &ext_adv_params_coded);
-    // advert.setDuration(1);
-    // advert.setInstanceAddress(1, mac_addr);
+    if (!backend.init(mac_addr)) {
+        Serial.printf("BLE init failed\n");
+        return false;
+    }
 
-    // prefer S8 coding - function deprecated in current ESP32 BLE
-    // TODO: Update to current BLE API
-    // if (esp_ble_gap_set_prefered_default_phy(ESP_BLE_GAP_PHY_OPTIONS_PREF_S8_CODING, ESP_BLE_GAP_PHY_OPTIONS_PREF_S8_CODING) != ESP_OK) {
-    //     Serial.printf("Failed to setup S8 coding\n");
-    // }
+    // size the legacy interval for the longest weighted rotation
+    const uint8_t legacy_slots_max = uint8_t(LegacyEntry::COUNT) - 1 + MAX(g.bt4_loc_weight, uint8_t(1));
+    set_config(BLE_Backend::Set::LEGACY, g.bt4_rate, legacy_slots_max, g.bt4_power);
+    set_config(BLE_Backend::Set::LONGRANGE, g.bt5_rate, 1, g.bt5_power);
 
     memset(&msg_counters,0, sizeof(msg_counters));
     return true;
 }
 
+/*
+  update the data of an advertising set, starting it with its first data
+ */
+bool BLE_TX::send(BLE_Backend::Set set, const uint8_t *payload, uint8_t len)
+{
+    if (!backend.set_data(set, payload, len)) {
+        return false;
+    }
+    bool &set_started = started[uint8_t(set)];
+    if (!set_started) {
+        set_started = backend.start(set);
+    }
+    return set_started;
+}
+
 #define IMIN(a,b) ((a)<(b)?(a):(b))
 
-bool BLE_TX::transmit_longrange(ODID_UAS_Data &UAS_data)
+bool BLE_TX::transmit_longrange(const ODID_Snapshot &snapshot)
 {
     init();
-    // create a packed UAS data message
-    uint8_t payload[250];
-    int length = odid_message_build_pack(&UAS_data, payload, 255);
+    // use the message pack encoded once for this tick
+    const int length = snapshot.get_pack_length();
     if (length <= 0) {
         return false;
     }
@@ -130,176 +138,161 @@ bool BLE_TX::transmit_longrange(ODID_UAS_Data &UAS_data)
 
     // combine header with payload
     memcpy(longrange_payload, header, sizeof(header));
-    memcpy(&longrange_payload[sizeof(header)], payload, length);
-    int longrange_length = sizeof(header) + length;
-
-    // TODO: Implement with current BLE API
-    // advert.setAdvertisingData(1, longrange_length, longrange_payload);
-
-    // we start advertising when we have the first lot of data to send
-    // if (!started) {
-    //     advert.start();
-    // }
-    started = true;
+    memcpy(&longrange_payload[sizeof(header)], snapshot.get_pack(), length);
+    const int longrange_length = sizeof(header) + length;
 
-    return true;
+    return send(BLE_Backend::Set::LONGRANGE, longrange_payload, longrange_length);
 }
 
-bool BLE_TX::transmit_legacy(ODID_UAS_Data &UAS_data)
+/*
+  copy one encoded message from the snapshot into the legacy payload
+  after the ASTM header, returning the new payload length or 0 if the
+  message is not valid
+ */
+int BLE_TX::legacy_message(const ODID_Snapshot &snapshot, ODID_Snapshot::Slot slot, ODID_msg_counter_t counter)
 {
-    init();
-    static uint8_t legacy_phase = 0;
-    int legacy_length = 0;
-    // setup ASTM header
-    const uint8_t header[] { 0x1e, 0x16, 0xfa, 0xff, 0x0d }; //exclude the message counter
-    // combine header with payload
-    memset(legacy_payload, 0, sizeof(legacy_payload));
-    memcpy(legacy_payload, header, sizeof(header));
-    legacy_length = sizeof(header);
-
-    switch (legacy_phase)
-    {
-    case  0: {
-        if (UAS_data.LocationValid) {
-            ODID_Location_encoded location_encoded;
-            memset(&location_encoded, 0, sizeof(location_encoded));
-            if (encodeLocationMessage(&location_encoded, &UAS_data.Location) != ODID_SUCCESS) {
-                break;
-            }
-
-            memcpy(&legacy_payload[sizeof(header)], &msg_counters[ODID_MSG_COUNTER_LOCATION], 1); //set packet counter
-            msg_counters[ODID_MSG_COUNTER_LOCATION]++;
-            //msg_counters[ODID_MSG_COUNTER_LOCATION] %= 256; //likely not be needed as it is defined as unint_8
-
-            memcpy(&legacy_payload[sizeof(header) + 1], &location_encoded, sizeof(location_encoded));
-            legacy_length = sizeof(header) + 1 + sizeof(location_encoded);
-        }
-        break;
+    const uint8_t *encoded = snapshot.get_message(slot);
+    if (encoded == nullptr) {
+        return 0;
     }
+    const uint8_t header_len = 5;
+    legacy_payload[header_len] = msg_counters[counter]++; //set packet counter
+    memcpy(&legacy_payload[header_len + 1], encoded, ODID_MESSAGE_SIZE);
+    return header_len + 1 + ODID_MESSAGE_SIZE;
+}
 
-    case  1: {
-        if (UAS_data.BasicIDValid[0]) {
-            ODID_BasicID_encoded basicid_encoded;
-            memset(&basicid_encoded, 0, sizeof(basicid_encoded));
-            if (encodeBasicIDMessage(&basicid_encoded, &UAS_data.BasicID[0]) != ODID_SUCCESS) {
-                break;
-            }
+/*
+  build the BLE name advertisement, returning its length
+ */
+int BLE_TX::legacy_name(const ODID_Snapshot &snapshot)
+{
+    char legacy_name[28] {};
+    const char *UAS_ID = snapshot.get_uas_id();
+    const uint8_t ID_len = strlen(UAS_ID);
+    const uint8_t ID_tail = IMIN(4, ID_len);
+    snprintf(legacy_name, sizeof(legacy_name), "ArduRemoteID_%s", &UAS_ID[ID_len-ID_tail]);
 
-            memcpy(&legacy_payload[sizeof(header)], &msg_counters[ODID_MSG_COUNTER_BASIC_ID], 1); //set packet counter
-            msg_counters[ODID_MSG_COUNTER_BASIC_ID]++;
-            //msg_counters[ODID_MSG_COUNTER_BASIC_ID] %= 256; //likely not be needed as it is defined as unint_8
+    memset(legacy_payload, 0, sizeof(legacy_payload));
+    const uint8_t legacy_name_header[] { 0x02, 0x01, 0x06, uint8_t(strlen(legacy_name)+1), BLE_AD_TYPE_NAME_SHORT};
 
-            memcpy(&legacy_payload[sizeof(header) + 1], &basicid_encoded, sizeof(basicid_encoded));
-            legacy_length = sizeof(header) + 1 + sizeof(basicid_encoded);
-        }
-        break;
-    }
+    memcpy(legacy_payload, legacy_name_header, sizeof(legacy_name_header));
+    memcpy(&legacy_payload[sizeof(legacy_name_header)], legacy_name, strlen(legacy_name) + 1);
 
-    case  2: {
-        if (UAS_data.SelfIDValid) {
-            ODID_SelfID_encoded selfid_encoded;
-            memset(&selfid_encoded, 0, sizeof(selfid_encoded));
-            if (encodeSelfIDMessage(&selfid_encoded, &UAS_data.SelfID) != ODID_SUCCESS) {
-                break;
-            }
+    return sizeof(legacy_name_header) + strlen(legacy_name) + 1; //add extra char for \0
+}
 
-            memcpy(&legacy_payload[sizeof(header)], &msg_counters[ODID_MSG_COUNTER_SELF_ID], 1); //set packet counter
-            msg_counters[ODID_MSG_COUNTER_SELF_ID]++;
-            //msg_counters[ODID_MSG_COUNTER_SELF_ID] %= 256; //likely not be needed as it is defined as uint_8
+// snapshot slot sent by each rotation entry
+static const ODID_Snapshot::Slot legacy_slots[] {
+    ODID_Snapshot::Slot::LOCATION,
+    ODID_Snapshot::Slot::BASIC_ID,
+    ODID_Snapshot::Slot::SELF_ID,
+    ODID_Snapshot::Slot::SYSTEM,
+    ODID_Snapshot::Slot::OPERATOR_ID,
+    ODID_Snapshot::Slot::BASIC_ID_2,
+};
 
-            memcpy(&legacy_payload[sizeof(header) + 1], &selfid_encoded, sizeof(selfid_encoded));
-            legacy_length = sizeof(header) + 1 + sizeof(selfid_encoded);
-        }
-        break;
+/*
+  weight of an entry in the rotation, 0 if it has nothing to send.
+  BT4_LOC_WEIGHT sets how many Location slots there are per slot of
+  each other message
+ */
+uint8_t BLE_TX::legacy_weight(const ODID_Snapshot &snapshot, LegacyEntry entry) const
+{
+    if (entry == LegacyEntry::NAME) {
+        return 1;
     }
-
-    case  3: {
-        if (UAS_data.SystemValid) {
-            ODID_System_encoded system_encoded;
-            memset(&system_encoded, 0, sizeof(system_encoded));
-            if (encodeSystemMessage(&system_encoded, &UAS_data.System) != ODID_SUCCESS) {
-                break;
-            }
-
-            memcpy(&legacy_payload[sizeof(header)], &msg_counters[ODID_MSG_COUNTER_SYSTEM], 1); //set packet counter
-            msg_counters[ODID_MSG_COUNTER_SYSTEM]++;
-            //msg_counters[ODID_MSG_COUNTER_SYSTEM] %= 256; //likely not be needed as it is defined as uint_8
-
-            memcpy(&legacy_payload[sizeof(header) + 1], &system_encoded, sizeof(system_encoded));
-            legacy_length = sizeof(header) + 1 + sizeof(system_encoded);
-        }
-        break;
+    if (snapshot.get_message(legacy_slots[uint8_t(entry)]) == nullptr) {
+        return 0;
     }
-
-    case  4: {
-        if (UAS_data.OperatorIDValid) {
-            ODID_OperatorID_encoded operatorid_encoded;
-            memset(&operatorid_encoded, 0, sizeof(operatorid_encoded));
-            if (encodeOperatorIDMessage(&operatorid_encoded, &UAS_data.OperatorID) != ODID_SUCCESS) {
-                break;
-            }
-
-            memcpy(&legacy_payload[sizeof(header)], &msg_counters[ODID_MSG_COUNTER_OPERATOR_ID], 1); //set packet counter
-            msg_counters[ODID_MSG_COUNTER_OPERATOR_ID]++;
-            //msg_counters[ODID_MSG_COUNTER_OPERATOR_ID] %= 256; //likely not be needed as it is defined as uint_8
-
-            memcpy(&legacy_payload[sizeof(header) + 1], &operatorid_encoded, sizeof(operatorid_encoded));
-            legacy_length = sizeof(header) + 1 + sizeof(operatorid_encoded);
-        }
-        break;
+    if (entry == LegacyEntry::LOCATION) {
+        return g.bt4_loc_weight > 0 ? g.bt4_loc_weight : 1;
     }
+    return 1;
+}
 
-    case  5: //in case of dual basic ID
-        if (UAS_data.BasicIDValid[1]) {
-            ODID_BasicID_encoded basicid2_encoded;
-            memset(&basicid2_encoded, 0, sizeof(basicid2_encoded));
-            if (encodeBasicIDMessage(&basicid2_encoded, &UAS_data.BasicID[1]) != ODID_SUCCESS) {
-                break;
-            }
-
-            memcpy(&legacy_payload[sizeof(header)], &msg_counters[ODID_MSG_COUNTER_BASIC_ID], 1); //set packet counter
-            msg_counters[ODID_MSG_COUNTER_BASIC_ID]++;
-            //msg_counters[ODID_MSG_COUNTER_BASIC_ID] %= 256; //likely not be needed as it is defined as unint_8
+uint8_t BLE_TX::legacy_states(const ODID_Snapshot &snapshot) const
+{
+    uint8_t total = 0;
+    for (uint8_t i=0; i<uint8_t(LegacyEntry::COUNT); i++) {
+        total += legacy_weight(snapshot, LegacyEntry(i));
+    }
+    return total;
+}
 
-            memcpy(&legacy_payload[sizeof(header) + 1], &basicid2_encoded, sizeof(basicid2_encoded));
-            legacy_length = sizeof(header) + 1 + sizeof(basicid2_encoded);
+/*
+  smooth weighted round robin: every entry earns its weight in credit
+  each slot, the richest entry is sent and pays the total weight. This
+  spreads the Location slots evenly instead of sending them in bursts.
+
+  A message whose content changes after having been stable jumps the
+  queue, so a new operator ID or System update goes out in the next
+  slot. Messages that change on every transmission, like Location with
+  its timestamp, get no boost and keep to their weight
+ */
+BLE_TX::LegacyEntry BLE_TX::next_legacy_entry(const ODID_Snapshot &snapshot)
+{
+    int16_t total = 0;
+    int8_t best = -1;
+    bool best_fresh = false;
+    for (uint8_t i=0; i<uint8_t(LegacyEntry::COUNT); i++) {
+        auto &st = legacy_state[i];
+        const uint8_t weight = legacy_weight(snapshot, LegacyEntry(i));
+        if (weight == 0) {
+            st.credit = 0;
+            continue;
         }
-        break;
-
-    case  6: {
-        //set BLE name
-        char legacy_name[28] {};
-        const char *UAS_ID = (const char *)UAS_data.BasicID[0].UASID;
-        const uint8_t ID_len = strlen(UAS_ID);
-        const uint8_t ID_tail = IMIN(4, ID_len);
-        snprintf(legacy_name, sizeof(legacy_name), "ArduRemoteID_%s", &UAS_ID[ID_len-ID_tail]);
+        st.credit += weight;
+        total += weight;
 
-        memset(legacy_payload, 0, sizeof(legacy_payload));
-        const uint8_t legacy_name_header[] { 0x02, 0x01, 0x06, uint8_t(strlen(legacy_name)+1), ESP_BLE_AD_TYPE_NAME_SHORT};
-
-        memcpy(legacy_payload, legacy_name_header, sizeof(legacy_name_header));
-        memcpy(&legacy_payload[sizeof(legacy_name_header)], legacy_name, strlen(legacy_name) + 1);
-
-        legacy_length = sizeof(legacy_name_header) + strlen(legacy_name) + 1; //add extra char for \0
-        break;
-    }
+        bool fresh = false;
+        if (LegacyEntry(i) != LegacyEntry::NAME) {
+            const uint8_t *msg = snapshot.get_message(legacy_slots[i]);
+            fresh = !st.changing && memcmp(st.last_sent, msg, ODID_MESSAGE_SIZE) != 0;
+        }
+        if (best < 0 ||
+            (fresh && !best_fresh) ||
+            (fresh == best_fresh && st.credit > legacy_state[best].credit)) {
+            best = i;
+            best_fresh = fresh;
+        }
     }
+    legacy_state[best].credit -= total;
+    return LegacyEntry(best);
+}
 
-    legacy_phase++;
+bool BLE_TX::transmit_legacy(const ODID_Snapshot &snapshot)
+{
+    init();
+    int legacy_length = 0;
+    // setup ASTM header
+    const uint8_t header[] { 0x1e, 0x16, 0xfa, 0xff, 0x0d }; //exclude the message counter
+    // combine header with payload
+    memset(legacy_payload, 0, sizeof(legacy_payload));
+    memcpy(legacy_payload, header, sizeof(header));
 
-    if (UAS_data.BasicIDValid[1]) {
-        legacy_phase %= 7;
+    static const ODID_msg_counter_t legacy_counters[] {
+        ODID_MSG_COUNTER_LOCATION,
+        ODID_MSG_COUNTER_BASIC_ID,
+        ODID_MSG_COUNTER_SELF_ID,
+        ODID_MSG_COUNTER_SYSTEM,
+        ODID_MSG_COUNTER_OPERATOR_ID,
+        ODID_MSG_COUNTER_BASIC_ID,
+    };
+
+    const LegacyEntry entry = next_legacy_entry(snapshot);
+    const uint8_t i = uint8_t(entry);
+    if (entry == LegacyEntry::NAME) {
+        legacy_length = legacy_name(snapshot);
     } else {
-        legacy_phase %= 6;
+        legacy_length = legacy_message(snapshot, legacy_slots[i], legacy_counters[i]);
+        auto &st = legacy_state[i];
+        const uint8_t *msg = snapshot.get_message(legacy_slots[i]);
+        st.changing = memcmp(st.last_sent, msg, ODID_MESSAGE_SIZE) != 0;
+        memcpy(st.last_sent, msg, ODID_MESSAGE_SIZE);
     }
 
-    // TODO: Implement with current BLE API
-    // advert.setAdvertisingData(0, legacy_length, legacy_payload);
-
-    // if (!started) {
-    //     advert.start();
-    // }
-    started = true;
-
-    return true;
+    if (legacy_length <= 0) {
+        return false;
+    }
+    return send(BLE_Backend::Set::LEGACY, legacy_payload, legacy_length);
 }
@@ -4,19 +4,53 @@
 #pragma once
 
 #include "transmitter.h"
+#include "odid_snapshot.h"
+#include "BLE_Backend.h"
 
 class BLE_TX : public Transmitter {
 public:
+    BLE_TX(BLE_Backend &_backend = ble_backend_esp()) :
+        backend(_backend) {}
+
     bool init(void) override;
-    bool transmit_longrange(ODID_UAS_Data &UAS_data);
-    bool transmit_legacy(ODID_UAS_Data &UAS_data);
+    bool transmit_longrange(const ODID_Snapshot &snapshot);
+    bool transmit_legacy(const ODID_Snapshot &snapshot);
+
+    // number of legacy advertisements in one full weighted rotation
+    uint8_t legacy_states(const ODID_Snapshot &snapshot) const;
 
 private:
+    // entries of the legacy advertising rotation
+    enum class LegacyEntry : uint8_t {
+        LOCATION = 0,
+        BASIC_ID,
+        SELF_ID,
+        SYSTEM,
+        OPERATOR_ID,
+        BASIC_ID_2,
+        NAME,
+        COUNT
+    };
+    struct LegacyState {
+        int16_t credit;
+        // message bytes last sent, to spot content changes
+        uint8_t last_sent[ODID_MESSAGE_SIZE];
+        // content changed at the previous transmission as well
+        bool changing;
+    } legacy_state[uint8_t(LegacyEntry::COUNT)];
+
+    BLE_Backend &backend;
     bool initialised;
     uint8_t msg_counters[ODID_MSG_COUNTER_AMOUNT];
     uint8_t legacy_payload[36];
     uint8_t longrange_payload[250];
-    bool started;
+    bool started[uint8_t(BLE_Backend::Set::COUNT)];
 
     uint8_t dBm_to_tx_power(float dBm) const;
+    void set_config(BLE_Backend::Set set, float rate_hz, uint8_t slots, float dBm);
+    bool send(BLE_Backend::Set set, const uint8_t *payload, uint8_t len);
+    int legacy_message(const ODID_Snapshot &snapshot, ODID_Snapshot::Slot slot, ODID_msg_counter_t counter);
+    int legacy_name(const ODID_Snapshot &snapshot);
+    uint8_t legacy_weight(const ODID_Snapshot &snapshot, LegacyEntry entry) const;
+    LegacyEntry next_legacy_entry(const ODID_Snapshot &snapshot);
 };
@@ -9,7 +9,7 @@
 #include <WiFi.h>
 #include <esp_system.h>
 #include "parameters.h"
-#include "opendroneid_wifi_stubs.h"
+#include "util.h"
 
 bool WiFi_TX::init(void)
 {
@@ -42,84 +42,137 @@ bool WiFi_TX::init(void)
 
     esp_wifi_set_max_tx_power(dBm_to_tx_power(g.wifi_power));
 
-    return true;
+    return build_frame_templates();
+}
+
+/*
+  build the parts of the NAN frames and beacon IE that never change
+ */
+bool WiFi_TX::build_frame_templates(void)
+{
+    nan_sync_length = odid_wifi_build_nan_sync_beacon_frame((char *)WiFi_mac_addr,
+                                                            nan_sync_frame, sizeof(nan_sync_frame));
+    nan_action_pack_offset = odid_wifi_build_nan_action_frame_template((char *)WiFi_mac_addr,
+                                                                       nan_action_frame, sizeof(nan_action_frame));
+
+    memset(beacon_ie.buf, 0, sizeof(beacon_ie.buf));
+    beacon_ie.data.element_id = WIFI_VENDOR_IE_ELEMENT_ID;
+    beacon_ie.data.vendor_oui[0] = 0xFA;
+    beacon_ie.data.vendor_oui[1] = 0x0B;
+    beacon_ie.data.vendor_oui[2] = 0xBC;
+    beacon_ie.data.vendor_oui_type = 0x0D;
+
+    return nan_sync_length > 0 && nan_action_pack_offset > 0;
 }
 
-bool WiFi_TX::transmit_nan(ODID_UAS_Data &UAS_data)
+bool WiFi_TX::transmit_nan(const ODID_Snapshot &snapshot)
 {
     init();
 
-    uint8_t buffer[1024] {};
+    if (snapshot.get_pack_length() == 0 || nan_sync_length <= 0 || nan_action_pack_offset <= 0) {
+        return false;
+    }
 
-    int length;
-    if ((length = odid_wifi_build_nan_sync_beacon_frame((char *)WiFi_mac_addr,
-                  buffer,sizeof(buffer))) > 0) {
-        if (esp_wifi_80211_tx(WIFI_IF_AP,buffer,length,true) != ESP_OK) {
-            return false;
-        }
+    odid_wifi_update_beacon_timestamp(nan_sync_frame, nan_sync_length);
+    if (esp_wifi_80211_tx(WIFI_IF_AP, nan_sync_frame, nan_sync_length, true) != ESP_OK) {
+        return false;
     }
 
-    if ((length = odid_wifi_build_message_pack_nan_action_frame(&UAS_data,(char *)WiFi_mac_addr,
-                  ++send_counter_nan,
-                  buffer,sizeof(buffer))) > 0) {
-        if (esp_wifi_80211_tx(WIFI_IF_AP,buffer,length,true) != ESP_OK) {
-            return false;
-        }
+    const int length = odid_wifi_patch_nan_action_frame(nan_action_frame, sizeof(nan_action_frame),
+                                                        nan_action_pack_offset,
+                                                        snapshot.get_pack(), snapshot.get_pack_length(),
+                                                        ++send_counter_nan);
+    if (length <= 0) {
+        return false;
+    }
+    if (esp_wifi_80211_tx(WIFI_IF_AP, nan_action_frame, length, true) != ESP_OK) {
+        return false;
     }
 
     return true;
 }
 
 //update the payload of the beacon frames in this function
-bool WiFi_TX::transmit_beacon(ODID_UAS_Data &UAS_data)
+bool WiFi_TX::transmit_beacon(const ODID_Snapshot &snapshot)
 {
     init();
 
-    uint8_t buffer[1024] {};
-
-    int length;
-    if ((length = odid_wifi_build_message_pack_beacon_frame(&UAS_data,(char *)WiFi_mac_addr,
-                   "UAS_ID_OPEN", strlen("UAS_ID_OPEN"), //use dummy SSID, as we only extract payload data
-                  1000/g.wifi_beacon_rate, ++send_counter_beacon, buffer, sizeof(buffer))) > 0) {
-
-        //set the RID IE element
-        uint8_t header_offset = 58;
-        vendor_ie_data_t IE_data;
-        IE_data.element_id = WIFI_VENDOR_IE_ELEMENT_ID;
-        IE_data.vendor_oui[0] = 0xFA;
-        IE_data.vendor_oui[1] = 0x0B;
-        IE_data.vendor_oui[2] = 0xBC;
-        IE_data.vendor_oui_type = 0x0D;
-        IE_data.length = length - header_offset + 4; //add 4 as of definition esp_wifi_set_vendor_ie
-        memcpy(IE_data.payload,&buffer[header_offset],length - header_offset);
-
-        // so first remove old element, add new afterwards
-        if (esp_wifi_set_vendor_ie(false, WIFI_VND_IE_TYPE_BEACON, WIFI_VND_IE_ID_0, &IE_data) != ESP_OK){
-            return false;
-        }
+    const uint8_t pack_length = snapshot.get_pack_length();
+    if (pack_length == 0) {
+        return false;
+    }
 
-        if (esp_wifi_set_vendor_ie(true, WIFI_VND_IE_TYPE_BEACON, WIFI_VND_IE_ID_0, &IE_data) != ESP_OK){
-            return false;
-        }
+    // the driver keeps sending the installed element, only swap it when
+    // the encoded data differs
+    const uint8_t ie_length = 1 + pack_length + 4; //add 4 as of definition esp_wifi_set_vendor_ie
+    if (beacon_ie_installed &&
+        beacon_ie.data.length == ie_length &&
+        memcmp(&beacon_ie.data.payload[1], snapshot.get_pack(), pack_length) == 0) {
+        ie_skipped++;
+        return true;
+    }
 
-        //set the payload also to probe requests, to increase update rate on mobile phones
-        // so first remove old element, add new afterwards
-        if (esp_wifi_set_vendor_ie(false, WIFI_VND_IE_TYPE_PROBE_RESP, WIFI_VND_IE_ID_0, &IE_data) != ESP_OK){
-            return false;
-        }
+    //set the RID IE element, the payload is the counter and the message pack
+    beacon_ie.data.payload[0] = ++send_counter_beacon;
+    memcpy(&beacon_ie.data.payload[1], snapshot.get_pack(), pack_length);
+    beacon_ie.data.length = ie_length;
+
+    return install_beacon_ie();
+}
 
-        if (esp_wifi_set_vendor_ie(true, WIFI_VND_IE_TYPE_PROBE_RESP, WIFI_VND_IE_ID_0, &IE_data) != ESP_OK){
+/*
+  install beacon_ie in the free vendor IE slot of each frame type, then
+  remove the element it replaces, so beacons and probe responses never
+  go out without a RID element. A frame built between the two carries
+  both, the old one a pack behind, which a receiver decodes as one
+  more message rather than a missed beacon. The slots of each type
+  follow the driver calls that succeeded, so a failed call is retried
+  on the next update. The driver copies the element, beacon_ie can be
+  reused
+ */
+bool WiFi_TX::install_beacon_ie(void)
+{
+    beacon_ie_installed = false;
+    ie_updates++;
+
+    //set the payload also to probe responses, to increase update rate on mobile phones
+    const wifi_vendor_ie_type_t types[] { WIFI_VND_IE_TYPE_BEACON, WIFI_VND_IE_TYPE_PROBE_RESP };
+    static_assert(ARRAY_SIZE(types) == ARRAY_SIZE(beacon_ie_slots), "vendor IE types");
+    for (uint8_t i=0; i<ARRAY_SIZE(types); i++) {
+        const wifi_vendor_ie_type_t type = types[i];
+        Vendor_IE_Slots &slots = beacon_ie_slots[i];
+        const wifi_vendor_ie_id_t old_id = slots.current;
+        const wifi_vendor_ie_id_t next_id = old_id == WIFI_VND_IE_ID_0 ? WIFI_VND_IE_ID_1 : WIFI_VND_IE_ID_0;
+        // an element a failed remove left behind, older than the current one
+        if ((slots.used & (1U << next_id)) != 0) {
+            if (esp_wifi_set_vendor_ie(false, type, next_id, nullptr) != ESP_OK) {
+                return false;
+            }
+            slots.used &= ~(1U << next_id);
+        }
+        if (esp_wifi_set_vendor_ie(true, type, next_id, &beacon_ie.data) != ESP_OK) {
             return false;
         }
+        slots.used |= 1U << next_id;
+        slots.current = next_id;
+        if ((slots.used & (1U << old_id)) != 0) {
+            if (esp_wifi_set_vendor_ie(false, type, old_id, nullptr) != ESP_OK) {
+                return false;
+            }
+            slots.used &= ~(1U << old_id);
+        }
+    }
 
-        return true;
-	}
-	else {
-		return false;
-	}
+    beacon_ie_installed = true;
+    return true;
 }
 
 
+void WiFi_TX::set_tx_power(float dBm)
+{
+    esp_wifi_set_max_tx_power(dBm_to_tx_power(dBm));
+}
+
 /*
   map dBm to a TX power
  */
@@ -4,12 +4,26 @@
 #pragma once
 
 #include "transmitter.h"
+#include "odid_snapshot.h"
+#include "opendroneid_wifi.h"
+#include <esp_wifi.h>
 
 class WiFi_TX : public Transmitter {
 public:
     bool init(void) override;
-    bool transmit_nan(ODID_UAS_Data &UAS_data);
-    bool transmit_beacon(ODID_UAS_Data &UAS_data);
+    bool transmit_nan(const ODID_Snapshot &snapshot);
+    bool transmit_beacon(const ODID_Snapshot &snapshot);
+
+    // change the maximum TX power, clamped to 2..20dBm
+    void set_tx_power(float dBm);
+
+    // beacon vendor IE swaps issued, and skipped because the pack was unchanged
+    uint32_t get_ie_updates(void) const {
+        return ie_updates;
+    }
+    uint32_t get_ie_skipped(void) const {
+        return ie_skipped;
+    }
 
 private:
     bool initialised;
@@ -19,4 +33,35 @@ private:
     uint8_t send_counter_nan;
     uint8_t send_counter_beacon;
     uint8_t dBm_to_tx_power(float dBm) const;
+
+    /*
+      frames prebuilt in init() from the random MAC. Each transmit only
+      patches the counter and copies the encoded pack in place
+     */
+    uint8_t nan_sync_frame[ODID_WIFI_NAN_SYNC_FRAME_SIZE];
+    int nan_sync_length;
+    uint8_t nan_action_frame[ODID_WIFI_NAN_ACTION_FRAME_SIZE];
+    int nan_action_pack_offset;
+
+    // beacon vendor IE: message counter followed by the message pack
+    union {
+        vendor_ie_data_t data;
+        uint8_t buf[sizeof(vendor_ie_data_t) + 1 + ODID_PACK_BUFFER_SIZE];
+    } beacon_ie;
+
+    // vendor IE slots of a frame type: a bit per wifi_vendor_ie_id_t
+    // holding an element, and the slot with the newest one
+    struct Vendor_IE_Slots {
+        uint8_t used;
+        wifi_vendor_ie_id_t current;
+    };
+    // beacons and probe responses
+    Vendor_IE_Slots beacon_ie_slots[2];
+    // beacon_ie is the newest element of every frame type
+    bool beacon_ie_installed;
+    uint32_t ie_updates;
+    uint32_t ie_skipped;
+
+    bool build_frame_templates(void);
+    bool install_beacon_ie(void);
 };
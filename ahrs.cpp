@@ -0,0 +1,191 @@
+/*
+  Mahony attitude and heading filter
+
+  The gyro is integrated into the attitude quaternion each IMU sample.
+  The error between where the attitude says gravity and the magnetic
+  field should be and where the accel and mag measure them drives a PI
+  correction of the rate, so the integral term also learns the gyro
+  bias. Mahony rather than Madgwick for the bias estimate and the
+  lower cost per sample.
+
+  Single precision throughout: the S3 FPU does float in hardware and
+  double in software, and a 3 or 4 element vector is too short for the
+  ESP-DSP routines to pay for their call. About 150 flops and 3 square
+  roots a sample, the Euler angles are only worked out when asked for.
+ */
+
+#include "ahrs.h"
+#include <math.h>
+
+#define RAD_TO_DEG_F 57.29577951f
+
+AHRS::AHRS(float _kp, float _ki) :
+    kp(_kp),
+    ki(_ki)
+{
+    reset();
+}
+
+void AHRS::reset(void)
+{
+    q[0] = 1;
+    q[1] = q[2] = q[3] = 0;
+    integral[0] = integral[1] = integral[2] = 0;
+    initialised = false;
+}
+
+/*
+  start from the attitude the accel and mag give, rather than
+  converging from level and north
+ */
+bool AHRS::init_attitude(const float accel[3], const float mag[3])
+{
+    const float an = sqrtf(accel[0]*accel[0] + accel[1]*accel[1] + accel[2]*accel[2]);
+    if (an <= 0) {
+        return false;
+    }
+    // up, north and west in the board frame
+    const float u[3] { accel[0] / an, accel[1] / an, accel[2] / an };
+    const float mu = mag[0]*u[0] + mag[1]*u[1] + mag[2]*u[2];
+    float n[3] { mag[0] - mu*u[0], mag[1] - mu*u[1], mag[2] - mu*u[2] };
+    const float nn = sqrtf(n[0]*n[0] + n[1]*n[1] + n[2]*n[2]);
+    if (nn <= 0) {
+        // no usable mag, level with the bow north
+        const float bn = sqrtf(1 - u[0]*u[0]);
+        if (bn <= 0) {
+            return false;
+        }
+        n[0] = (1 - u[0]*u[0]) / bn;
+        n[1] = -u[0]*u[1] / bn;
+        n[2] = -u[0]*u[2] / bn;
+    } else {
+        n[0] /= nn;
+        n[1] /= nn;
+        n[2] /= nn;
+    }
+    const float w[3] { u[1]*n[2] - u[2]*n[1], u[2]*n[0] - u[0]*n[2], u[0]*n[1] - u[1]*n[0] };
+
+    // rows of the board to earth rotation are north, west and up
+    const float r00 = n[0], r01 = n[1], r02 = n[2];
+    const float r10 = w[0], r11 = w[1], r12 = w[2];
+    const float r20 = u[0], r21 = u[1], r22 = u[2];
+    const float trace = r00 + r11 + r22;
+    if (trace > 0) {
+        const float s = 0.5f / sqrtf(trace + 1);
+        q[0] = 0.25f / s;
+        q[1] = (r21 - r12) * s;
+        q[2] = (r02 - r20) * s;
+        q[3] = (r10 - r01) * s;
+    } else if (r00 > r11 && r00 > r22) {
+        const float s = 2 * sqrtf(1 + r00 - r11 - r22);
+        q[0] = (r21 - r12) / s;
+        q[1] = 0.25f * s;
+        q[2] = (r01 + r10) / s;
+        q[3] = (r02 + r20) / s;
+    } else if (r11 > r22) {
+        const float s = 2 * sqrtf(1 + r11 - r00 - r22);
+        q[0] = (r02 - r20) / s;
+        q[1] = (r01 + r10) / s;
+        q[2] = 0.25f * s;
+        q[3] = (r12 + r21) / s;
+    } else {
+        const float s = 2 * sqrtf(1 + r22 - r00 - r11);
+        q[0] = (r10 - r01) / s;
+        q[1] = (r02 + r20) / s;
+        q[2] = (r12 + r21) / s;
+        q[3] = 0.25f * s;
+    }
+    return true;
+}
+
+void AHRS::update(const float gyro[3], const float accel[3], const float mag[3], float dt)
+{
+    if (!initialised) {
+        initialised = init_attitude(accel, mag);
+        return;
+    }
+
+    float gx = gyro[0], gy = gyro[1], gz = gyro[2];
+    float q0 = q[0], q1 = q[1], q2 = q[2], q3 = q[3];
+
+    const float a2 = accel[0]*accel[0] + accel[1]*accel[1] + accel[2]*accel[2];
+    if (a2 > 0) {
+        const float q0q0 = q0*q0, q0q1 = q0*q1, q0q2 = q0*q2, q0q3 = q0*q3;
+        const float q1q1 = q1*q1, q1q2 = q1*q2, q1q3 = q1*q3;
+        const float q2q2 = q2*q2, q2q3 = q2*q3, q3q3 = q3*q3;
+
+        const float an = 1 / sqrtf(a2);
+        const float ax = accel[0] * an, ay = accel[1] * an, az = accel[2] * an;
+
+        // half the expected up direction, cross the measured one
+        const float vx = q1q3 - q0q2;
+        const float vy = q0q1 + q2q3;
+        const float vz = q0q0 - 0.5f + q3q3;
+        float ex = ay*vz - az*vy;
+        float ey = az*vx - ax*vz;
+        float ez = ax*vy - ay*vx;
+
+        const float m2 = mag[0]*mag[0] + mag[1]*mag[1] + mag[2]*mag[2];
+        if (m2 > 0) {
+            const float mn = 1 / sqrtf(m2);
+            const float mx = mag[0] * mn, my = mag[1] * mn, mz = mag[2] * mn;
+
+            // field in the earth frame, with its horizontal part
+            // turned to north
+            const float hx = 2 * (mx*(0.5f - q2q2 - q3q3) + my*(q1q2 - q0q3) + mz*(q1q3 + q0q2));
+            const float hy = 2 * (mx*(q1q2 + q0q3) + my*(0.5f - q1q1 - q3q3) + mz*(q2q3 - q0q1));
+            const float bx = sqrtf(hx*hx + hy*hy);
+            const float bz = 2 * (mx*(q1q3 - q0q2) + my*(q2q3 + q0q1) + mz*(0.5f - q1q1 - q2q2));
+
+            // half the expected field direction, cross the measured one
+            const float wx = bx*(0.5f - q2q2 - q3q3) + bz*(q1q3 - q0q2);
+            const float wy = bx*(q1q2 - q0q3) + bz*(q0q1 + q2q3);
+            const float wz = bx*(q0q2 + q1q3) + bz*(0.5f - q1q1 - q2q2);
+            ex += my*wz - mz*wy;
+            ey += mz*wx - mx*wz;
+            ez += mx*wy - my*wx;
+        }
+
+        if (ki > 0) {
+            integral[0] += 2 * ki * ex * dt;
+            integral[1] += 2 * ki * ey * dt;
+            integral[2] += 2 * ki * ez * dt;
+            gx += integral[0];
+            gy += integral[1];
+            gz += integral[2];
+        }
+        gx += 2 * kp * ex;
+        gy += 2 * kp * ey;
+        gz += 2 * kp * ez;
+    }
+
+    // q += q * (0, g) * dt/2
+    gx *= 0.5f * dt;
+    gy *= 0.5f * dt;
+    gz *= 0.5f * dt;
+    q[0] = q0 - q1*gx - q2*gy - q3*gz;
+    q[1] = q1 + q0*gx + q2*gz - q3*gy;
+    q[2] = q2 + q0*gy - q1*gz + q3*gx;
+    q[3] = q3 + q0*gz + q1*gy - q2*gx;
+
+    const float qn = 1 / sqrtf(q[0]*q[0] + q[1]*q[1] + q[2]*q[2] + q[3]*q[3]);
+    q[0] *= qn;
+    q[1] *= qn;
+    q[2] *= qn;
+    q[3] *= qn;
+}
+
+void AHRS::get_euler_deg(float &heading, float &pitch, float &roll) const
+{
+    const float q0 = q[0], q1 = q[1], q2 = q[2], q3 = q[3];
+    // yaw is counter clockwise about up, pitch about port
+    const float yaw = atan2f(q1*q2 + q0*q3, 0.5f - q2*q2 - q3*q3);
+    float s = 2 * (q1*q3 - q0*q2);
+    s = s > 1 ? 1 : (s < -1 ? -1 : s);
+    pitch = asinf(s) * RAD_TO_DEG_F;
+    roll = atan2f(q0*q1 + q2*q3, 0.5f - q1*q1 - q2*q2) * RAD_TO_DEG_F;
+    heading = -yaw * RAD_TO_DEG_F;
+    if (heading < 0) {
+        heading += 360;
+    }
+}
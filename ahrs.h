@@ -0,0 +1,48 @@
+/*
+  Mahony attitude and heading filter
+ */
+#pragma once
+
+#include <stdint.h>
+
+/*
+  Board frame: x toward the bow, y to port, z up, the LSM6DS3 and
+  LIS3MDL axes aligned with it. The attitude is a quaternion rotating
+  the board frame into north, west, up.
+ */
+class AHRS {
+public:
+    // proportional and integral gain of the correction of the gyro
+    // integration towards the accel and mag references
+    AHRS(float _kp, float _ki);
+
+    // forget the attitude, the next update starts again from accel and mag
+    void reset(void);
+
+    /*
+      one IMU sample: gyro in rad/s, accel (specific force, +1g up at
+      rest) and mag in any unit, dt in seconds. A zero mag runs on gyro
+      and accel only, holding the heading
+     */
+    void update(const float gyro[3], const float accel[3], const float mag[3], float dt);
+
+    bool have_attitude(void) const {
+        return initialised;
+    }
+    // heading clockwise from magnetic north 0 to 360, pitch bow up and
+    // roll starboard down, in degrees
+    void get_euler_deg(float &heading, float &pitch, float &roll) const;
+    // w, x, y, z
+    const float *get_quaternion(void) const {
+        return q;
+    }
+
+private:
+    const float kp;
+    const float ki;
+    float q[4];
+    float integral[3];
+    bool initialised;
+
+    bool init_attitude(const float accel[3], const float mag[3]);
+};
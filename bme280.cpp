@@ -0,0 +1,182 @@
+/*
+  BME280 temperature, pressure and humidity sensor
+
+  The chip runs in normal mode, measuring continuously on its own, so a
+  sample is one burst read of the eight data registers. Compensation
+  is Bosch's integer code from the datasheet: 32 bit for temperature
+  and humidity, 64 bit for pressure, no floating point on the way.
+ */
+
+#include "bme280.h"
+
+#define BME280_REG_CALIB_TP  0x88   // 26 bytes, T1..P9 and H1
+#define BME280_REG_ID        0xD0
+#define BME280_REG_CALIB_H   0xE1   // 7 bytes, H2..H6
+#define BME280_REG_CTRL_HUM  0xF2
+#define BME280_REG_CTRL_MEAS 0xF4
+#define BME280_REG_CONFIG    0xF5
+#define BME280_REG_DATA      0xF7   // press, temp, hum
+
+#define BME280_CALIB_H_LEN   7
+#define BME280_DATA_LEN      8
+
+#define BME280_CHIP_ID       0x60
+
+// x1 oversampling of all three, normal mode, 1s standby and no IIR
+// filter: a new sample every second, matching the 1Hz environment
+// rate of the sensor manager
+#define BME280_CTRL_HUM      0x01
+#define BME280_CTRL_MEAS     0x27
+#define BME280_CONFIG        0xA0
+
+static uint16_t le16(const uint8_t *b)
+{
+    return b[0] | (b[1] << 8);
+}
+
+void BME280::init(void)
+{
+    state = State::PROBING;
+    read_registers(BME280_REG_ID, 1, TAG_ID);
+}
+
+void BME280::update(void)
+{
+    if (state != State::RUNNING || reading) {
+        return;
+    }
+    // set first, the result can arrive before submit returns
+    reading = true;
+    if (!read_registers(BME280_REG_DATA, BME280_DATA_LEN, TAG_DATA)) {
+        reading = false;
+    }
+}
+
+bool BME280::get_sample(Sample &s) const
+{
+    WITH_SEMAPHORE(sem);
+    s = sample;
+    return have_sample;
+}
+
+void BME280::transfer_done(uint8_t tag, bool ok, const uint8_t *data, uint8_t len)
+{
+    switch (tag) {
+    case TAG_ID:
+        if (!ok || len != 1 || data[0] != BME280_CHIP_ID) {
+            state = State::ABSENT;
+            break;
+        }
+        // ctrl_hum only takes effect on the ctrl_meas write after it
+        state = State::CONFIGURING;
+        write_register(BME280_REG_CTRL_HUM, BME280_CTRL_HUM, TAG_CONFIG);
+        write_register(BME280_REG_CONFIG, BME280_CONFIG, TAG_CONFIG);
+        write_register(BME280_REG_CTRL_MEAS, BME280_CTRL_MEAS, TAG_CONFIG);
+        read_registers(BME280_REG_CALIB_TP, sizeof(calib_tp), TAG_CALIB_TP);
+        read_registers(BME280_REG_CALIB_H, BME280_CALIB_H_LEN, TAG_CALIB_H);
+        break;
+
+    case TAG_CONFIG:
+        if (!ok) {
+            state = State::ABSENT;
+        }
+        break;
+
+    case TAG_CALIB_TP:
+        if (!ok || len != sizeof(calib_tp)) {
+            state = State::ABSENT;
+            break;
+        }
+        memcpy(calib_tp, data, sizeof(calib_tp));
+        break;
+
+    case TAG_CALIB_H:
+        if (!ok || len != BME280_CALIB_H_LEN || state != State::CONFIGURING) {
+            state = State::ABSENT;
+            break;
+        }
+        parse_calibration(calib_tp, data, cal);
+        state = State::RUNNING;
+        break;
+
+    case TAG_DATA: {
+        Sample s;
+        if (ok && len == BME280_DATA_LEN && compensate(cal, data, s)) {
+            s.timestamp_ms = millis();
+            WITH_SEMAPHORE(sem);
+            sample = s;
+            have_sample = true;
+        }
+        reading = false;
+        break;
+    }
+    }
+}
+
+void BME280::parse_calibration(const uint8_t tp[26], const uint8_t h[7], Calibration &c)
+{
+    c.T1 = le16(&tp[0]);
+    c.T2 = int16_t(le16(&tp[2]));
+    c.T3 = int16_t(le16(&tp[4]));
+    c.P1 = le16(&tp[6]);
+    c.P2 = int16_t(le16(&tp[8]));
+    c.P3 = int16_t(le16(&tp[10]));
+    c.P4 = int16_t(le16(&tp[12]));
+    c.P5 = int16_t(le16(&tp[14]));
+    c.P6 = int16_t(le16(&tp[16]));
+    c.P7 = int16_t(le16(&tp[18]));
+    c.P8 = int16_t(le16(&tp[20]));
+    c.P9 = int16_t(le16(&tp[22]));
+    c.H1 = tp[25];
+    c.H2 = int16_t(le16(&h[0]));
+    c.H3 = h[2];
+    // H4 and H5 are 12 bit, sharing the nibbles of 0xE5
+    c.H4 = int16_t(int8_t(h[3]) * 16 | (h[4] & 0x0F));
+    c.H5 = int16_t(int8_t(h[5]) * 16 | (h[4] >> 4));
+    c.H6 = int8_t(h[6]);
+}
+
+bool BME280::compensate(const Calibration &c, const uint8_t raw[8], Sample &s)
+{
+    const int32_t adc_P = (uint32_t(raw[0]) << 12) | (uint32_t(raw[1]) << 4) | (raw[2] >> 4);
+    const int32_t adc_T = (uint32_t(raw[3]) << 12) | (uint32_t(raw[4]) << 4) | (raw[5] >> 4);
+    const int32_t adc_H = (uint32_t(raw[6]) << 8) | raw[7];
+    if (adc_T == 0x80000 || adc_P == 0x80000) {
+        // measurement skipped, the chip isn't configured yet
+        return false;
+    }
+
+    // temperature, and t_fine for the other two
+    int32_t var1 = (((adc_T >> 3) - (int32_t(c.T1) * 2)) * int32_t(c.T2)) >> 11;
+    int32_t var2 = (((((adc_T >> 4) - int32_t(c.T1)) * ((adc_T >> 4) - int32_t(c.T1))) >> 12) * int32_t(c.T3)) >> 14;
+    const int32_t t_fine = var1 + var2;
+    s.temperature_cdeg = (t_fine * 5 + 128) >> 8;
+
+    // pressure
+    int64_t p1 = int64_t(t_fine) - 128000;
+    int64_t p2 = p1 * p1 * int64_t(c.P6);
+    p2 = p2 + ((p1 * int64_t(c.P5)) * (int64_t(1) << 17));
+    p2 = p2 + (int64_t(c.P4) * (int64_t(1) << 35));
+    p1 = ((p1 * p1 * int64_t(c.P3)) >> 8) + ((p1 * int64_t(c.P2)) * (int64_t(1) << 12));
+    p1 = (((int64_t(1) << 47) + p1) * int64_t(c.P1)) >> 33;
+    if (p1 == 0) {
+        return false;
+    }
+    int64_t p = 1048576 - adc_P;
+    p = (((p << 31) - p2) * 3125) / p1;
+    p1 = (int64_t(c.P9) * (p >> 13) * (p >> 13)) >> 25;
+    p2 = (int64_t(c.P8) * p) >> 19;
+    s.pressure_q24_8 = uint32_t(((p + p1 + p2) >> 8) + (int64_t(c.P7) * 16));
+
+    // humidity
+    int32_t h = t_fine - 76800;
+    h = (((adc_H * 16384) - (int32_t(c.H4) * 1048576) - (int32_t(c.H5) * h) + 16384) >> 15) *
+        (((((((h * int32_t(c.H6)) >> 10) * (((h * int32_t(c.H3)) >> 11) + 32768)) >> 10) + 2097152) *
+          int32_t(c.H2) + 8192) >> 14);
+    h = h - (((((h >> 15) * (h >> 15)) >> 7) * int32_t(c.H1)) >> 4);
+    h = h < 0 ? 0 : h;
+    h = h > 419430400 ? 419430400 : h;
+    s.humidity_q22_10 = uint32_t(h >> 12);
+
+    return true;
+}
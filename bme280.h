@@ -0,0 +1,76 @@
+/*
+  BME280 temperature, pressure and humidity sensor on the async I2C bus
+ */
+#pragma once
+
+#include "i2c_bus.h"
+
+class BME280 : public I2C_Device {
+public:
+    using I2C_Device::I2C_Device;
+
+    // compensated values in Bosch's integer formats
+    struct Sample {
+        int32_t temperature_cdeg;   // 0.01 degC
+        uint32_t pressure_q24_8;    // Pa, 24.8 fixed point
+        uint32_t humidity_q22_10;   // %RH, 22.10 fixed point
+        uint32_t timestamp_ms;
+    };
+
+    // factory trimming, from the calibration registers
+    struct Calibration {
+        uint16_t T1;
+        int16_t T2, T3;
+        uint16_t P1;
+        int16_t P2, P3, P4, P5, P6, P7, P8, P9;
+        uint8_t H1;
+        int16_t H2;
+        uint8_t H3;
+        int16_t H4, H5;
+        int8_t H6;
+    };
+
+    // queue the probe, configuration and calibration reads
+    void init(void);
+
+    // queue a read of the next sample unless one is in flight
+    void update(void);
+
+    bool healthy(void) const {
+        return state == State::RUNNING;
+    }
+    // latest sample, false if there is none yet
+    bool get_sample(Sample &s) const;
+
+    static void parse_calibration(const uint8_t tp[26], const uint8_t h[7], Calibration &cal);
+    // compensate the 8 data registers from 0xF7, false if skipped
+    static bool compensate(const Calibration &cal, const uint8_t raw[8], Sample &s);
+
+private:
+    enum class State : uint8_t {
+        NONE,
+        PROBING,
+        CONFIGURING,
+        RUNNING,
+        ABSENT,
+    };
+
+    enum Tag : uint8_t {
+        TAG_ID,
+        TAG_CONFIG,
+        TAG_CALIB_TP,
+        TAG_CALIB_H,
+        TAG_DATA,
+    };
+
+    volatile State state;
+    volatile bool reading;
+    uint8_t calib_tp[26];
+    Calibration cal;
+
+    mutable Semaphore sem;
+    Sample sample;
+    bool have_sample;
+
+    void transfer_done(uint8_t tag, bool ok, const uint8_t *data, uint8_t len) override;
+};
@@ -32,6 +32,7 @@
 #define PIN_I2C_SDA         21  // I2C Data
 #define PIN_I2C_SCL         22  // I2C Clock
 #define I2C_FREQUENCY       400000       // 400kHz I2C
+#define PIN_IMU_INT1        GPIO_NUM_7   // LSM6DS3 INT1, FIFO watermark
 
 // Power management
 #define PIN_POWER_ENABLE    GPIO_NUM_2   // PoE splitter enable
@@ -50,6 +51,8 @@
 // Maritime-specific features
 #define MARITIME_MODE_ENABLED 1
 #define GNSS_REQUIRED 1
+#define GNSS_UBX_BAUDRATE 115200   // F9P port speed in UBX mode
+#define GNSS_RATE_HZ 10
 #define WATERPROOF_CASE 1
 
 #define CAN_APP_NODE_NAME "OndOcean RemoteID Maritime"
@@ -1,6 +1,5 @@
 /*
  * MAVLink main header for OndOcean RemoteID
- * Simplified version for compilation
  */
 
 #pragma once
@@ -9,26 +8,30 @@
 #include <string.h>
 #include "../mavlink_types.h"
 
-// Basic MAVLink types (defined in mavlink_types.h)
-
-// Basic MAVLink functions (stubs for compilation)
-static inline uint16_t mavlink_msg_get_msgid(const mavlink_message_t* msg) {
-    return msg->msgid;
-}
-
-static inline uint8_t mavlink_parse_char(uint8_t chan, uint8_t c, mavlink_message_t* r_message, mavlink_status_t* r_mavlink_status) {
-    return 0; // Stub implementation
+// CRC extra and payload lengths of the supported messages, sorted by
+// msgid for the binary search in mavlink_get_msg_entry()
+#define MAVLINK_MESSAGE_CRCS { \
+    {0, 50, 9, 9, 0, 0, 0}, \
+    {20, 214, 20, 20, 3, 2, 3}, \
+    {21, 159, 2, 2, 3, 0, 1}, \
+    {22, 220, 25, 25, 0, 0, 0}, \
+    {23, 168, 23, 23, 3, 4, 5}, \
+    {253, 83, 51, 54, 0, 0, 0}, \
+    {11004, 11, 232, 232, 3, 8, 9}, \
+    {11005, 93, 230, 230, 0, 0, 0}, \
+    {12900, 114, 44, 44, 3, 0, 1}, \
+    {12901, 254, 59, 59, 3, 30, 31}, \
+    {12902, 140, 53, 53, 3, 4, 5}, \
+    {12903, 249, 46, 46, 3, 0, 1}, \
+    {12904, 77, 54, 54, 3, 28, 29}, \
+    {12905, 49, 43, 43, 3, 0, 1}, \
+    {12915, 94, 249, 249, 3, 0, 1}, \
+    {12918, 139, 51, 51, 0, 0, 0}, \
+    {12919, 7, 18, 18, 3, 16, 17}, \
 }
 
-// OpenDroneID message IDs
-#define MAVLINK_MSG_ID_OPEN_DRONE_ID_LOCATION 12901
-#define MAVLINK_MSG_ID_OPEN_DRONE_ID_AUTHENTICATION 12902
-#define MAVLINK_MSG_ID_OPEN_DRONE_ID_SELF_ID 12903
-#define MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM 12904
-#define MAVLINK_MSG_ID_OPEN_DRONE_ID_OPERATOR_ID 12905
-
-// Include OpenDroneID message definitions
 #include "mavlink_msg_open_drone_id_all.h"
 
-// Global MAVLink system variable
-extern mavlink_system_t mavlink_system;
+static inline uint32_t mavlink_msg_get_msgid(const mavlink_message_t* msg) {
+    return msg->msgid;
+}
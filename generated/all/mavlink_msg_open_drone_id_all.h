@@ -1,6 +1,10 @@
 /*
- * MAVLink OpenDroneID All Messages for OndOcean RemoteID
- * Simplified version for compilation
+ * MAVLink messages used by OndOcean RemoteID
+ *
+ * Wire format structs and pack, send and decode functions for the
+ * common, secure command and OpenDroneID messages we handle. Fields
+ * are in wire order (by size, extensions last) and the structs are
+ * packed, so a struct is its payload and can be sent without copying.
  */
 
 #pragma once
@@ -8,72 +12,1097 @@
 #include "../mavlink_types.h"
 #include "../mavlink_helpers.h"
 
-// OpenDroneID message IDs
-#define MAVLINK_MSG_ID_OPEN_DRONE_ID_LOCATION 12901
+// MAVLink types
+#define MAV_TYPE_GCS 6
+#define MAV_TYPE_ODID 18
+
+// MAVLink autopilot types
+#define MAV_AUTOPILOT_INVALID 8
+
+// MAVLink component IDs
+#define MAV_COMP_ID_ODID_TXRX_1 236
+
+// OpenDroneID ID types
+#define MAV_ODID_ID_TYPE_SPECIFIC_SESSION_ID 4
 
 // OpenDroneID ARM status constants
 #define MAV_ODID_ARM_STATUS_GOOD_TO_ARM 0
 #define MAV_ODID_ARM_STATUS_PRE_ARM_FAIL_GENERIC 1
-#define MAVLINK_MSG_ID_OPEN_DRONE_ID_AUTHENTICATION 12902
-#define MAVLINK_MSG_ID_OPEN_DRONE_ID_SELF_ID 12903
-#define MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM 12904
-#define MAVLINK_MSG_ID_OPEN_DRONE_ID_OPERATOR_ID 12905
-#define MAVLINK_MSG_ID_OPEN_DRONE_ID_MESSAGE_PACK 12915
-#define MAVLINK_MSG_ID_OPEN_DRONE_ID_ARM_STATUS 12918
-#define MAVLINK_MSG_ID_SECURE_COMMAND 76
-#define MAVLINK_MSG_ID_SECURE_COMMAND_REPLY 77
-#define MAVLINK_MSG_ID_PARAM_REQUEST_LIST 21
+
+// MAVLink result constants
+#define MAV_RESULT_ACCEPTED 0
+#define MAV_RESULT_UNSUPPORTED 3
+#define MAV_RESULT_FAILED 4
+#define MAV_RESULT_DENIED 6
+
+// MAVLink severity constants
+#define MAV_SEVERITY_ERROR 3
+#define MAV_SEVERITY_INFO 6
+
+// MAVLink parameter types
+#define MAV_PARAM_TYPE_REAL32 9
+
+// Secure command types
+#define SECURE_COMMAND_GET_PUBLIC_KEYS 1
+#define SECURE_COMMAND_SET_PUBLIC_KEYS 2
+#define SECURE_COMMAND_REMOVE_PUBLIC_KEYS 3
+#define SECURE_COMMAND_SET_REMOTEID_CONFIG 4
+#define SECURE_COMMAND_GET_SESSION_KEY 5
+#define SECURE_COMMAND_GET_REMOTEID_SESSION_KEY 6
+
+// MESSAGE HEARTBEAT
+
+#define MAVLINK_MSG_ID_HEARTBEAT 0
+
+MAVPACKED(
+typedef struct __mavlink_heartbeat_t {
+    uint32_t custom_mode;
+    uint8_t type;
+    uint8_t autopilot;
+    uint8_t base_mode;
+    uint8_t system_status;
+    uint8_t mavlink_version;
+}) mavlink_heartbeat_t;
+
+#define MAVLINK_MSG_ID_HEARTBEAT_LEN 9
+#define MAVLINK_MSG_ID_HEARTBEAT_MIN_LEN 9
+#define MAVLINK_MSG_ID_0_LEN 9
+#define MAVLINK_MSG_ID_0_MIN_LEN 9
+#define MAVLINK_MSG_ID_HEARTBEAT_CRC 50
+#define MAVLINK_MSG_ID_0_CRC 50
+static_assert(sizeof(mavlink_heartbeat_t) == MAVLINK_MSG_ID_HEARTBEAT_LEN, "heartbeat wire size");
+
+static inline uint16_t mavlink_msg_heartbeat_pack(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg, uint8_t type, uint8_t autopilot, uint8_t base_mode, uint32_t custom_mode, uint8_t system_status)
+{
+    mavlink_heartbeat_t packet;
+    packet.type = type;
+    packet.autopilot = autopilot;
+    packet.base_mode = base_mode;
+    packet.custom_mode = custom_mode;
+    packet.system_status = system_status;
+    packet.mavlink_version = 3;
+    memcpy(_MAV_PAYLOAD_NON_CONST(msg), &packet, MAVLINK_MSG_ID_HEARTBEAT_LEN);
+    msg->msgid = MAVLINK_MSG_ID_HEARTBEAT;
+    return mavlink_finalize_message(msg, system_id, component_id, MAVLINK_MSG_ID_HEARTBEAT_MIN_LEN, MAVLINK_MSG_ID_HEARTBEAT_LEN, MAVLINK_MSG_ID_HEARTBEAT_CRC);
+}
+
+static inline uint16_t mavlink_msg_heartbeat_encode(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg, const mavlink_heartbeat_t* heartbeat)
+{
+    memcpy(_MAV_PAYLOAD_NON_CONST(msg), heartbeat, MAVLINK_MSG_ID_HEARTBEAT_LEN);
+    _mav_put_uint8_t(_MAV_PAYLOAD_NON_CONST(msg), 8, 3);
+    msg->msgid = MAVLINK_MSG_ID_HEARTBEAT;
+    return mavlink_finalize_message(msg, system_id, component_id, MAVLINK_MSG_ID_HEARTBEAT_MIN_LEN, MAVLINK_MSG_ID_HEARTBEAT_LEN, MAVLINK_MSG_ID_HEARTBEAT_CRC);
+}
+
+#ifdef MAVLINK_USE_CONVENIENCE_FUNCTIONS
+
+static inline void mavlink_msg_heartbeat_send(mavlink_channel_t chan, uint8_t type, uint8_t autopilot, uint8_t base_mode, uint32_t custom_mode, uint8_t system_status)
+{
+    mavlink_heartbeat_t packet;
+    packet.type = type;
+    packet.autopilot = autopilot;
+    packet.base_mode = base_mode;
+    packet.custom_mode = custom_mode;
+    packet.system_status = system_status;
+    packet.mavlink_version = 3;
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_HEARTBEAT, (const char *)&packet, MAVLINK_MSG_ID_HEARTBEAT_MIN_LEN, MAVLINK_MSG_ID_HEARTBEAT_LEN, MAVLINK_MSG_ID_HEARTBEAT_CRC);
+}
+
+static inline void mavlink_msg_heartbeat_send_struct(mavlink_channel_t chan, const mavlink_heartbeat_t* heartbeat)
+{
+    mavlink_heartbeat_t packet = *heartbeat;
+    packet.mavlink_version = 3;
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_HEARTBEAT, (const char *)&packet, MAVLINK_MSG_ID_HEARTBEAT_MIN_LEN, MAVLINK_MSG_ID_HEARTBEAT_LEN, MAVLINK_MSG_ID_HEARTBEAT_CRC);
+}
+
+#endif // MAVLINK_USE_CONVENIENCE_FUNCTIONS
+
+static inline uint8_t mavlink_msg_heartbeat_get_type(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 4);
+}
+
+static inline uint8_t mavlink_msg_heartbeat_get_autopilot(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 5);
+}
+
+static inline uint8_t mavlink_msg_heartbeat_get_base_mode(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 6);
+}
+
+static inline uint32_t mavlink_msg_heartbeat_get_custom_mode(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint32_t(msg, 0);
+}
+
+static inline uint8_t mavlink_msg_heartbeat_get_system_status(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 7);
+}
+
+static inline uint8_t mavlink_msg_heartbeat_get_mavlink_version(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 8);
+}
+
+static inline void mavlink_msg_heartbeat_decode(const mavlink_message_t* msg, mavlink_heartbeat_t* heartbeat)
+{
+    const uint8_t len = msg->len < MAVLINK_MSG_ID_HEARTBEAT_LEN ? msg->len : MAVLINK_MSG_ID_HEARTBEAT_LEN;
+    memset(heartbeat, 0, MAVLINK_MSG_ID_HEARTBEAT_LEN);
+    memcpy(heartbeat, _MAV_PAYLOAD(msg), len);
+}
+
+// MESSAGE PARAM_REQUEST_READ
+
 #define MAVLINK_MSG_ID_PARAM_REQUEST_READ 20
+
+MAVPACKED(
+typedef struct __mavlink_param_request_read_t {
+    int16_t param_index;
+    uint8_t target_system;
+    uint8_t target_component;
+    char param_id[16];
+}) mavlink_param_request_read_t;
+
+#define MAVLINK_MSG_ID_PARAM_REQUEST_READ_LEN 20
+#define MAVLINK_MSG_ID_PARAM_REQUEST_READ_MIN_LEN 20
+#define MAVLINK_MSG_ID_20_LEN 20
+#define MAVLINK_MSG_ID_20_MIN_LEN 20
+#define MAVLINK_MSG_ID_PARAM_REQUEST_READ_CRC 214
+#define MAVLINK_MSG_ID_20_CRC 214
+#define MAVLINK_MSG_PARAM_REQUEST_READ_FIELD_PARAM_ID_LEN 16
+static_assert(sizeof(mavlink_param_request_read_t) == MAVLINK_MSG_ID_PARAM_REQUEST_READ_LEN, "param_request_read wire size");
+
+static inline uint16_t mavlink_msg_param_request_read_pack(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg, uint8_t target_system, uint8_t target_component, const char *param_id, int16_t param_index)
+{
+    mavlink_param_request_read_t packet;
+    packet.target_system = target_system;
+    packet.target_component = target_component;
+    mav_array_assign_char(packet.param_id, param_id, 16);
+    packet.param_index = param_index;
+    memcpy(_MAV_PAYLOAD_NON_CONST(msg), &packet, MAVLINK_MSG_ID_PARAM_REQUEST_READ_LEN);
+    msg->msgid = MAVLINK_MSG_ID_PARAM_REQUEST_READ;
+    return mavlink_finalize_message(msg, system_id, component_id, MAVLINK_MSG_ID_PARAM_REQUEST_READ_MIN_LEN, MAVLINK_MSG_ID_PARAM_REQUEST_READ_LEN, MAVLINK_MSG_ID_PARAM_REQUEST_READ_CRC);
+}
+
+static inline uint16_t mavlink_msg_param_request_read_encode(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg, const mavlink_param_request_read_t* param_request_read)
+{
+    memcpy(_MAV_PAYLOAD_NON_CONST(msg), param_request_read, MAVLINK_MSG_ID_PARAM_REQUEST_READ_LEN);
+    msg->msgid = MAVLINK_MSG_ID_PARAM_REQUEST_READ;
+    return mavlink_finalize_message(msg, system_id, component_id, MAVLINK_MSG_ID_PARAM_REQUEST_READ_MIN_LEN, MAVLINK_MSG_ID_PARAM_REQUEST_READ_LEN, MAVLINK_MSG_ID_PARAM_REQUEST_READ_CRC);
+}
+
+#ifdef MAVLINK_USE_CONVENIENCE_FUNCTIONS
+
+static inline void mavlink_msg_param_request_read_send(mavlink_channel_t chan, uint8_t target_system, uint8_t target_component, const char *param_id, int16_t param_index)
+{
+    mavlink_param_request_read_t packet;
+    packet.target_system = target_system;
+    packet.target_component = target_component;
+    mav_array_assign_char(packet.param_id, param_id, 16);
+    packet.param_index = param_index;
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_PARAM_REQUEST_READ, (const char *)&packet, MAVLINK_MSG_ID_PARAM_REQUEST_READ_MIN_LEN, MAVLINK_MSG_ID_PARAM_REQUEST_READ_LEN, MAVLINK_MSG_ID_PARAM_REQUEST_READ_CRC);
+}
+
+static inline void mavlink_msg_param_request_read_send_struct(mavlink_channel_t chan, const mavlink_param_request_read_t* param_request_read)
+{
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_PARAM_REQUEST_READ, (const char *)param_request_read, MAVLINK_MSG_ID_PARAM_REQUEST_READ_MIN_LEN, MAVLINK_MSG_ID_PARAM_REQUEST_READ_LEN, MAVLINK_MSG_ID_PARAM_REQUEST_READ_CRC);
+}
+
+#endif // MAVLINK_USE_CONVENIENCE_FUNCTIONS
+
+static inline uint8_t mavlink_msg_param_request_read_get_target_system(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 2);
+}
+
+static inline uint8_t mavlink_msg_param_request_read_get_target_component(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 3);
+}
+
+static inline uint16_t mavlink_msg_param_request_read_get_param_id(const mavlink_message_t* msg, char *param_id)
+{
+    return _MAV_RETURN_char_array(msg, param_id, 16, 4);
+}
+
+static inline int16_t mavlink_msg_param_request_read_get_param_index(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_int16_t(msg, 0);
+}
+
+static inline void mavlink_msg_param_request_read_decode(const mavlink_message_t* msg, mavlink_param_request_read_t* param_request_read)
+{
+    const uint8_t len = msg->len < MAVLINK_MSG_ID_PARAM_REQUEST_READ_LEN ? msg->len : MAVLINK_MSG_ID_PARAM_REQUEST_READ_LEN;
+    memset(param_request_read, 0, MAVLINK_MSG_ID_PARAM_REQUEST_READ_LEN);
+    memcpy(param_request_read, _MAV_PAYLOAD(msg), len);
+}
+
+// MESSAGE PARAM_REQUEST_LIST
+
+#define MAVLINK_MSG_ID_PARAM_REQUEST_LIST 21
+
+MAVPACKED(
+typedef struct __mavlink_param_request_list_t {
+    uint8_t target_system;
+    uint8_t target_component;
+}) mavlink_param_request_list_t;
+
+#define MAVLINK_MSG_ID_PARAM_REQUEST_LIST_LEN 2
+#define MAVLINK_MSG_ID_PARAM_REQUEST_LIST_MIN_LEN 2
+#define MAVLINK_MSG_ID_21_LEN 2
+#define MAVLINK_MSG_ID_21_MIN_LEN 2
+#define MAVLINK_MSG_ID_PARAM_REQUEST_LIST_CRC 159
+#define MAVLINK_MSG_ID_21_CRC 159
+static_assert(sizeof(mavlink_param_request_list_t) == MAVLINK_MSG_ID_PARAM_REQUEST_LIST_LEN, "param_request_list wire size");
+
+static inline uint16_t mavlink_msg_param_request_list_pack(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg, uint8_t target_system, uint8_t target_component)
+{
+    mavlink_param_request_list_t packet;
+    packet.target_system = target_system;
+    packet.target_component = target_component;
+    memcpy(_MAV_PAYLOAD_NON_CONST(msg), &packet, MAVLINK_MSG_ID_PARAM_REQUEST_LIST_LEN);
+    msg->msgid = MAVLINK_MSG_ID_PARAM_REQUEST_LIST;
+    return mavlink_finalize_message(msg, system_id, component_id, MAVLINK_MSG_ID_PARAM_REQUEST_LIST_MIN_LEN, MAVLINK_MSG_ID_PARAM_REQUEST_LIST_LEN, MAVLINK_MSG_ID_PARAM_REQUEST_LIST_CRC);
+}
+
+static inline uint16_t mavlink_msg_param_request_list_encode(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg, const mavlink_param_request_list_t* param_request_list)
+{
+    memcpy(_MAV_PAYLOAD_NON_CONST(msg), param_request_list, MAVLINK_MSG_ID_PARAM_REQUEST_LIST_LEN);
+    msg->msgid = MAVLINK_MSG_ID_PARAM_REQUEST_LIST;
+    return mavlink_finalize_message(msg, system_id, component_id, MAVLINK_MSG_ID_PARAM_REQUEST_LIST_MIN_LEN, MAVLINK_MSG_ID_PARAM_REQUEST_LIST_LEN, MAVLINK_MSG_ID_PARAM_REQUEST_LIST_CRC);
+}
+
+#ifdef MAVLINK_USE_CONVENIENCE_FUNCTIONS
+
+static inline void mavlink_msg_param_request_list_send(mavlink_channel_t chan, uint8_t target_system, uint8_t target_component)
+{
+    mavlink_param_request_list_t packet;
+    packet.target_system = target_system;
+    packet.target_component = target_component;
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_PARAM_REQUEST_LIST, (const char *)&packet, MAVLINK_MSG_ID_PARAM_REQUEST_LIST_MIN_LEN, MAVLINK_MSG_ID_PARAM_REQUEST_LIST_LEN, MAVLINK_MSG_ID_PARAM_REQUEST_LIST_CRC);
+}
+
+static inline void mavlink_msg_param_request_list_send_struct(mavlink_channel_t chan, const mavlink_param_request_list_t* param_request_list)
+{
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_PARAM_REQUEST_LIST, (const char *)param_request_list, MAVLINK_MSG_ID_PARAM_REQUEST_LIST_MIN_LEN, MAVLINK_MSG_ID_PARAM_REQUEST_LIST_LEN, MAVLINK_MSG_ID_PARAM_REQUEST_LIST_CRC);
+}
+
+#endif // MAVLINK_USE_CONVENIENCE_FUNCTIONS
+
+static inline uint8_t mavlink_msg_param_request_list_get_target_system(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 0);
+}
+
+static inline uint8_t mavlink_msg_param_request_list_get_target_component(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 1);
+}
+
+static inline void mavlink_msg_param_request_list_decode(const mavlink_message_t* msg, mavlink_param_request_list_t* param_request_list)
+{
+    const uint8_t len = msg->len < MAVLINK_MSG_ID_PARAM_REQUEST_LIST_LEN ? msg->len : MAVLINK_MSG_ID_PARAM_REQUEST_LIST_LEN;
+    memset(param_request_list, 0, MAVLINK_MSG_ID_PARAM_REQUEST_LIST_LEN);
+    memcpy(param_request_list, _MAV_PAYLOAD(msg), len);
+}
+
+// MESSAGE PARAM_VALUE
+
 #define MAVLINK_MSG_ID_PARAM_VALUE 22
+
+MAVPACKED(
+typedef struct __mavlink_param_value_t {
+    float param_value;
+    uint16_t param_count;
+    uint16_t param_index;
+    char param_id[16];
+    uint8_t param_type;
+}) mavlink_param_value_t;
+
+#define MAVLINK_MSG_ID_PARAM_VALUE_LEN 25
+#define MAVLINK_MSG_ID_PARAM_VALUE_MIN_LEN 25
+#define MAVLINK_MSG_ID_22_LEN 25
+#define MAVLINK_MSG_ID_22_MIN_LEN 25
+#define MAVLINK_MSG_ID_PARAM_VALUE_CRC 220
+#define MAVLINK_MSG_ID_22_CRC 220
+#define MAVLINK_MSG_PARAM_VALUE_FIELD_PARAM_ID_LEN 16
+static_assert(sizeof(mavlink_param_value_t) == MAVLINK_MSG_ID_PARAM_VALUE_LEN, "param_value wire size");
+
+static inline uint16_t mavlink_msg_param_value_pack(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg, const char *param_id, float param_value, uint8_t param_type, uint16_t param_count, uint16_t param_index)
+{
+    mavlink_param_value_t packet;
+    mav_array_assign_char(packet.param_id, param_id, 16);
+    packet.param_value = param_value;
+    packet.param_type = param_type;
+    packet.param_count = param_count;
+    packet.param_index = param_index;
+    memcpy(_MAV_PAYLOAD_NON_CONST(msg), &packet, MAVLINK_MSG_ID_PARAM_VALUE_LEN);
+    msg->msgid = MAVLINK_MSG_ID_PARAM_VALUE;
+    return mavlink_finalize_message(msg, system_id, component_id, MAVLINK_MSG_ID_PARAM_VALUE_MIN_LEN, MAVLINK_MSG_ID_PARAM_VALUE_LEN, MAVLINK_MSG_ID_PARAM_VALUE_CRC);
+}
+
+static inline uint16_t mavlink_msg_param_value_encode(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg, const mavlink_param_value_t* param_value)
+{
+    memcpy(_MAV_PAYLOAD_NON_CONST(msg), param_value, MAVLINK_MSG_ID_PARAM_VALUE_LEN);
+    msg->msgid = MAVLINK_MSG_ID_PARAM_VALUE;
+    return mavlink_finalize_message(msg, system_id, component_id, MAVLINK_MSG_ID_PARAM_VALUE_MIN_LEN, MAVLINK_MSG_ID_PARAM_VALUE_LEN, MAVLINK_MSG_ID_PARAM_VALUE_CRC);
+}
+
+#ifdef MAVLINK_USE_CONVENIENCE_FUNCTIONS
+
+static inline void mavlink_msg_param_value_send(mavlink_channel_t chan, const char *param_id, float param_value, uint8_t param_type, uint16_t param_count, uint16_t param_index)
+{
+    mavlink_param_value_t packet;
+    mav_array_assign_char(packet.param_id, param_id, 16);
+    packet.param_value = param_value;
+    packet.param_type = param_type;
+    packet.param_count = param_count;
+    packet.param_index = param_index;
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_PARAM_VALUE, (const char *)&packet, MAVLINK_MSG_ID_PARAM_VALUE_MIN_LEN, MAVLINK_MSG_ID_PARAM_VALUE_LEN, MAVLINK_MSG_ID_PARAM_VALUE_CRC);
+}
+
+static inline void mavlink_msg_param_value_send_struct(mavlink_channel_t chan, const mavlink_param_value_t* param_value)
+{
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_PARAM_VALUE, (const char *)param_value, MAVLINK_MSG_ID_PARAM_VALUE_MIN_LEN, MAVLINK_MSG_ID_PARAM_VALUE_LEN, MAVLINK_MSG_ID_PARAM_VALUE_CRC);
+}
+
+#endif // MAVLINK_USE_CONVENIENCE_FUNCTIONS
+
+static inline uint16_t mavlink_msg_param_value_get_param_id(const mavlink_message_t* msg, char *param_id)
+{
+    return _MAV_RETURN_char_array(msg, param_id, 16, 8);
+}
+
+static inline float mavlink_msg_param_value_get_param_value(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_float(msg, 0);
+}
+
+static inline uint8_t mavlink_msg_param_value_get_param_type(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 24);
+}
+
+static inline uint16_t mavlink_msg_param_value_get_param_count(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint16_t(msg, 4);
+}
+
+static inline uint16_t mavlink_msg_param_value_get_param_index(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint16_t(msg, 6);
+}
+
+static inline void mavlink_msg_param_value_decode(const mavlink_message_t* msg, mavlink_param_value_t* param_value)
+{
+    const uint8_t len = msg->len < MAVLINK_MSG_ID_PARAM_VALUE_LEN ? msg->len : MAVLINK_MSG_ID_PARAM_VALUE_LEN;
+    memset(param_value, 0, MAVLINK_MSG_ID_PARAM_VALUE_LEN);
+    memcpy(param_value, _MAV_PAYLOAD(msg), len);
+}
+
+// MESSAGE PARAM_SET
+
 #define MAVLINK_MSG_ID_PARAM_SET 23
-#define MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_UPDATE 12919
-#define MAVLINK_MSG_ID_HEARTBEAT 0
+
+MAVPACKED(
+typedef struct __mavlink_param_set_t {
+    float param_value;
+    uint8_t target_system;
+    uint8_t target_component;
+    char param_id[16];
+    uint8_t param_type;
+}) mavlink_param_set_t;
+
+#define MAVLINK_MSG_ID_PARAM_SET_LEN 23
+#define MAVLINK_MSG_ID_PARAM_SET_MIN_LEN 23
+#define MAVLINK_MSG_ID_23_LEN 23
+#define MAVLINK_MSG_ID_23_MIN_LEN 23
+#define MAVLINK_MSG_ID_PARAM_SET_CRC 168
+#define MAVLINK_MSG_ID_23_CRC 168
+#define MAVLINK_MSG_PARAM_SET_FIELD_PARAM_ID_LEN 16
+static_assert(sizeof(mavlink_param_set_t) == MAVLINK_MSG_ID_PARAM_SET_LEN, "param_set wire size");
+
+static inline uint16_t mavlink_msg_param_set_pack(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg, uint8_t target_system, uint8_t target_component, const char *param_id, float param_value, uint8_t param_type)
+{
+    mavlink_param_set_t packet;
+    packet.target_system = target_system;
+    packet.target_component = target_component;
+    mav_array_assign_char(packet.param_id, param_id, 16);
+    packet.param_value = param_value;
+    packet.param_type = param_type;
+    memcpy(_MAV_PAYLOAD_NON_CONST(msg), &packet, MAVLINK_MSG_ID_PARAM_SET_LEN);
+    msg->msgid = MAVLINK_MSG_ID_PARAM_SET;
+    return mavlink_finalize_message(msg, system_id, component_id, MAVLINK_MSG_ID_PARAM_SET_MIN_LEN, MAVLINK_MSG_ID_PARAM_SET_LEN, MAVLINK_MSG_ID_PARAM_SET_CRC);
+}
+
+static inline uint16_t mavlink_msg_param_set_encode(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg, const mavlink_param_set_t* param_set)
+{
+    memcpy(_MAV_PAYLOAD_NON_CONST(msg), param_set, MAVLINK_MSG_ID_PARAM_SET_LEN);
+    msg->msgid = MAVLINK_MSG_ID_PARAM_SET;
+    return mavlink_finalize_message(msg, system_id, component_id, MAVLINK_MSG_ID_PARAM_SET_MIN_LEN, MAVLINK_MSG_ID_PARAM_SET_LEN, MAVLINK_MSG_ID_PARAM_SET_CRC);
+}
+
+#ifdef MAVLINK_USE_CONVENIENCE_FUNCTIONS
+
+static inline void mavlink_msg_param_set_send(mavlink_channel_t chan, uint8_t target_system, uint8_t target_component, const char *param_id, float param_value, uint8_t param_type)
+{
+    mavlink_param_set_t packet;
+    packet.target_system = target_system;
+    packet.target_component = target_component;
+    mav_array_assign_char(packet.param_id, param_id, 16);
+    packet.param_value = param_value;
+    packet.param_type = param_type;
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_PARAM_SET, (const char *)&packet, MAVLINK_MSG_ID_PARAM_SET_MIN_LEN, MAVLINK_MSG_ID_PARAM_SET_LEN, MAVLINK_MSG_ID_PARAM_SET_CRC);
+}
+
+static inline void mavlink_msg_param_set_send_struct(mavlink_channel_t chan, const mavlink_param_set_t* param_set)
+{
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_PARAM_SET, (const char *)param_set, MAVLINK_MSG_ID_PARAM_SET_MIN_LEN, MAVLINK_MSG_ID_PARAM_SET_LEN, MAVLINK_MSG_ID_PARAM_SET_CRC);
+}
+
+#endif // MAVLINK_USE_CONVENIENCE_FUNCTIONS
+
+static inline uint8_t mavlink_msg_param_set_get_target_system(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 4);
+}
+
+static inline uint8_t mavlink_msg_param_set_get_target_component(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 5);
+}
+
+static inline uint16_t mavlink_msg_param_set_get_param_id(const mavlink_message_t* msg, char *param_id)
+{
+    return _MAV_RETURN_char_array(msg, param_id, 16, 6);
+}
+
+static inline float mavlink_msg_param_set_get_param_value(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_float(msg, 0);
+}
+
+static inline uint8_t mavlink_msg_param_set_get_param_type(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 22);
+}
+
+static inline void mavlink_msg_param_set_decode(const mavlink_message_t* msg, mavlink_param_set_t* param_set)
+{
+    const uint8_t len = msg->len < MAVLINK_MSG_ID_PARAM_SET_LEN ? msg->len : MAVLINK_MSG_ID_PARAM_SET_LEN;
+    memset(param_set, 0, MAVLINK_MSG_ID_PARAM_SET_LEN);
+    memcpy(param_set, _MAV_PAYLOAD(msg), len);
+}
+
+// MESSAGE STATUSTEXT
+
+#define MAVLINK_MSG_ID_STATUSTEXT 253
+
+MAVPACKED(
+typedef struct __mavlink_statustext_t {
+    uint8_t severity;
+    char text[50];
+    uint16_t id;
+    uint8_t chunk_seq;
+}) mavlink_statustext_t;
+
+#define MAVLINK_MSG_ID_STATUSTEXT_LEN 54
+#define MAVLINK_MSG_ID_STATUSTEXT_MIN_LEN 51
+#define MAVLINK_MSG_ID_253_LEN 54
+#define MAVLINK_MSG_ID_253_MIN_LEN 51
+#define MAVLINK_MSG_ID_STATUSTEXT_CRC 83
+#define MAVLINK_MSG_ID_253_CRC 83
+#define MAVLINK_MSG_STATUSTEXT_FIELD_TEXT_LEN 50
+static_assert(sizeof(mavlink_statustext_t) == MAVLINK_MSG_ID_STATUSTEXT_LEN, "statustext wire size");
+
+static inline uint16_t mavlink_msg_statustext_pack(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg, uint8_t severity, const char *text, uint16_t id, uint8_t chunk_seq)
+{
+    mavlink_statustext_t packet;
+    packet.severity = severity;
+    mav_array_assign_char(packet.text, text, 50);
+    packet.id = id;
+    packet.chunk_seq = chunk_seq;
+    memcpy(_MAV_PAYLOAD_NON_CONST(msg), &packet, MAVLINK_MSG_ID_STATUSTEXT_LEN);
+    msg->msgid = MAVLINK_MSG_ID_STATUSTEXT;
+    return mavlink_finalize_message(msg, system_id, component_id, MAVLINK_MSG_ID_STATUSTEXT_MIN_LEN, MAVLINK_MSG_ID_STATUSTEXT_LEN, MAVLINK_MSG_ID_STATUSTEXT_CRC);
+}
+
+static inline uint16_t mavlink_msg_statustext_encode(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg, const mavlink_statustext_t* statustext)
+{
+    memcpy(_MAV_PAYLOAD_NON_CONST(msg), statustext, MAVLINK_MSG_ID_STATUSTEXT_LEN);
+    msg->msgid = MAVLINK_MSG_ID_STATUSTEXT;
+    return mavlink_finalize_message(msg, system_id, component_id, MAVLINK_MSG_ID_STATUSTEXT_MIN_LEN, MAVLINK_MSG_ID_STATUSTEXT_LEN, MAVLINK_MSG_ID_STATUSTEXT_CRC);
+}
+
+#ifdef MAVLINK_USE_CONVENIENCE_FUNCTIONS
+
+static inline void mavlink_msg_statustext_send(mavlink_channel_t chan, uint8_t severity, const char *text, uint16_t id, uint8_t chunk_seq)
+{
+    mavlink_statustext_t packet;
+    packet.severity = severity;
+    mav_array_assign_char(packet.text, text, 50);
+    packet.id = id;
+    packet.chunk_seq = chunk_seq;
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_STATUSTEXT, (const char *)&packet, MAVLINK_MSG_ID_STATUSTEXT_MIN_LEN, MAVLINK_MSG_ID_STATUSTEXT_LEN, MAVLINK_MSG_ID_STATUSTEXT_CRC);
+}
+
+static inline void mavlink_msg_statustext_send_struct(mavlink_channel_t chan, const mavlink_statustext_t* statustext)
+{
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_STATUSTEXT, (const char *)statustext, MAVLINK_MSG_ID_STATUSTEXT_MIN_LEN, MAVLINK_MSG_ID_STATUSTEXT_LEN, MAVLINK_MSG_ID_STATUSTEXT_CRC);
+}
+
+#endif // MAVLINK_USE_CONVENIENCE_FUNCTIONS
+
+static inline uint8_t mavlink_msg_statustext_get_severity(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 0);
+}
+
+static inline uint16_t mavlink_msg_statustext_get_text(const mavlink_message_t* msg, char *text)
+{
+    return _MAV_RETURN_char_array(msg, text, 50, 1);
+}
+
+static inline uint16_t mavlink_msg_statustext_get_id(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint16_t(msg, 51);
+}
+
+static inline uint8_t mavlink_msg_statustext_get_chunk_seq(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 53);
+}
+
+static inline void mavlink_msg_statustext_decode(const mavlink_message_t* msg, mavlink_statustext_t* statustext)
+{
+    const uint8_t len = msg->len < MAVLINK_MSG_ID_STATUSTEXT_LEN ? msg->len : MAVLINK_MSG_ID_STATUSTEXT_LEN;
+    memset(statustext, 0, MAVLINK_MSG_ID_STATUSTEXT_LEN);
+    memcpy(statustext, _MAV_PAYLOAD(msg), len);
+}
+
+// MESSAGE SECURE_COMMAND
+
+#define MAVLINK_MSG_ID_SECURE_COMMAND 11004
+
+MAVPACKED(
+typedef struct __mavlink_secure_command_t {
+    uint32_t sequence;
+    uint32_t operation;
+    uint8_t target_system;
+    uint8_t target_component;
+    uint8_t data_length;
+    uint8_t sig_length;
+    uint8_t data[220];
+}) mavlink_secure_command_t;
+
+#define MAVLINK_MSG_ID_SECURE_COMMAND_LEN 232
+#define MAVLINK_MSG_ID_SECURE_COMMAND_MIN_LEN 232
+#define MAVLINK_MSG_ID_11004_LEN 232
+#define MAVLINK_MSG_ID_11004_MIN_LEN 232
+#define MAVLINK_MSG_ID_SECURE_COMMAND_CRC 11
+#define MAVLINK_MSG_ID_11004_CRC 11
+#define MAVLINK_MSG_SECURE_COMMAND_FIELD_DATA_LEN 220
+static_assert(sizeof(mavlink_secure_command_t) == MAVLINK_MSG_ID_SECURE_COMMAND_LEN, "secure_command wire size");
+
+static inline uint16_t mavlink_msg_secure_command_pack(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg, uint8_t target_system, uint8_t target_component, uint32_t sequence, uint32_t operation, uint8_t data_length, uint8_t sig_length, const uint8_t *data)
+{
+    mavlink_secure_command_t packet;
+    packet.target_system = target_system;
+    packet.target_component = target_component;
+    packet.sequence = sequence;
+    packet.operation = operation;
+    packet.data_length = data_length;
+    packet.sig_length = sig_length;
+    mav_array_memcpy(packet.data, data, sizeof(uint8_t)*220);
+    memcpy(_MAV_PAYLOAD_NON_CONST(msg), &packet, MAVLINK_MSG_ID_SECURE_COMMAND_LEN);
+    msg->msgid = MAVLINK_MSG_ID_SECURE_COMMAND;
+    return mavlink_finalize_message(msg, system_id, component_id, MAVLINK_MSG_ID_SECURE_COMMAND_MIN_LEN, MAVLINK_MSG_ID_SECURE_COMMAND_LEN, MAVLINK_MSG_ID_SECURE_COMMAND_CRC);
+}
+
+static inline uint16_t mavlink_msg_secure_command_encode(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg, const mavlink_secure_command_t* secure_command)
+{
+    memcpy(_MAV_PAYLOAD_NON_CONST(msg), secure_command, MAVLINK_MSG_ID_SECURE_COMMAND_LEN);
+    msg->msgid = MAVLINK_MSG_ID_SECURE_COMMAND;
+    return mavlink_finalize_message(msg, system_id, component_id, MAVLINK_MSG_ID_SECURE_COMMAND_MIN_LEN, MAVLINK_MSG_ID_SECURE_COMMAND_LEN, MAVLINK_MSG_ID_SECURE_COMMAND_CRC);
+}
+
+#ifdef MAVLINK_USE_CONVENIENCE_FUNCTIONS
+
+static inline void mavlink_msg_secure_command_send(mavlink_channel_t chan, uint8_t target_system, uint8_t target_component, uint32_t sequence, uint32_t operation, uint8_t data_length, uint8_t sig_length, const uint8_t *data)
+{
+    mavlink_secure_command_t packet;
+    packet.target_system = target_system;
+    packet.target_component = target_component;
+    packet.sequence = sequence;
+    packet.operation = operation;
+    packet.data_length = data_length;
+    packet.sig_length = sig_length;
+    mav_array_memcpy(packet.data, data, sizeof(uint8_t)*220);
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_SECURE_COMMAND, (const char *)&packet, MAVLINK_MSG_ID_SECURE_COMMAND_MIN_LEN, MAVLINK_MSG_ID_SECURE_COMMAND_LEN, MAVLINK_MSG_ID_SECURE_COMMAND_CRC);
+}
+
+static inline void mavlink_msg_secure_command_send_struct(mavlink_channel_t chan, const mavlink_secure_command_t* secure_command)
+{
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_SECURE_COMMAND, (const char *)secure_command, MAVLINK_MSG_ID_SECURE_COMMAND_MIN_LEN, MAVLINK_MSG_ID_SECURE_COMMAND_LEN, MAVLINK_MSG_ID_SECURE_COMMAND_CRC);
+}
+
+#endif // MAVLINK_USE_CONVENIENCE_FUNCTIONS
+
+static inline uint8_t mavlink_msg_secure_command_get_target_system(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 8);
+}
+
+static inline uint8_t mavlink_msg_secure_command_get_target_component(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 9);
+}
+
+static inline uint32_t mavlink_msg_secure_command_get_sequence(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint32_t(msg, 0);
+}
+
+static inline uint32_t mavlink_msg_secure_command_get_operation(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint32_t(msg, 4);
+}
+
+static inline uint8_t mavlink_msg_secure_command_get_data_length(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 10);
+}
+
+static inline uint8_t mavlink_msg_secure_command_get_sig_length(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 11);
+}
+
+static inline uint16_t mavlink_msg_secure_command_get_data(const mavlink_message_t* msg, uint8_t *data)
+{
+    return _MAV_RETURN_uint8_t_array(msg, data, 220, 12);
+}
+
+static inline void mavlink_msg_secure_command_decode(const mavlink_message_t* msg, mavlink_secure_command_t* secure_command)
+{
+    const uint8_t len = msg->len < MAVLINK_MSG_ID_SECURE_COMMAND_LEN ? msg->len : MAVLINK_MSG_ID_SECURE_COMMAND_LEN;
+    memset(secure_command, 0, MAVLINK_MSG_ID_SECURE_COMMAND_LEN);
+    memcpy(secure_command, _MAV_PAYLOAD(msg), len);
+}
+
+// MESSAGE SECURE_COMMAND_REPLY
+
+#define MAVLINK_MSG_ID_SECURE_COMMAND_REPLY 11005
+
+MAVPACKED(
+typedef struct __mavlink_secure_command_reply_t {
+    uint32_t sequence;
+    uint32_t operation;
+    uint8_t result;
+    uint8_t data_length;
+    uint8_t data[220];
+}) mavlink_secure_command_reply_t;
+
+#define MAVLINK_MSG_ID_SECURE_COMMAND_REPLY_LEN 230
+#define MAVLINK_MSG_ID_SECURE_COMMAND_REPLY_MIN_LEN 230
+#define MAVLINK_MSG_ID_11005_LEN 230
+#define MAVLINK_MSG_ID_11005_MIN_LEN 230
+#define MAVLINK_MSG_ID_SECURE_COMMAND_REPLY_CRC 93
+#define MAVLINK_MSG_ID_11005_CRC 93
+#define MAVLINK_MSG_SECURE_COMMAND_REPLY_FIELD_DATA_LEN 220
+static_assert(sizeof(mavlink_secure_command_reply_t) == MAVLINK_MSG_ID_SECURE_COMMAND_REPLY_LEN, "secure_command_reply wire size");
+
+static inline uint16_t mavlink_msg_secure_command_reply_pack(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg, uint32_t sequence, uint32_t operation, uint8_t result, uint8_t data_length, const uint8_t *data)
+{
+    mavlink_secure_command_reply_t packet;
+    packet.sequence = sequence;
+    packet.operation = operation;
+    packet.result = result;
+    packet.data_length = data_length;
+    mav_array_memcpy(packet.data, data, sizeof(uint8_t)*220);
+    memcpy(_MAV_PAYLOAD_NON_CONST(msg), &packet, MAVLINK_MSG_ID_SECURE_COMMAND_REPLY_LEN);
+    msg->msgid = MAVLINK_MSG_ID_SECURE_COMMAND_REPLY;
+    return mavlink_finalize_message(msg, system_id, component_id, MAVLINK_MSG_ID_SECURE_COMMAND_REPLY_MIN_LEN, MAVLINK_MSG_ID_SECURE_COMMAND_REPLY_LEN, MAVLINK_MSG_ID_SECURE_COMMAND_REPLY_CRC);
+}
+
+static inline uint16_t mavlink_msg_secure_command_reply_encode(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg, const mavlink_secure_command_reply_t* secure_command_reply)
+{
+    memcpy(_MAV_PAYLOAD_NON_CONST(msg), secure_command_reply, MAVLINK_MSG_ID_SECURE_COMMAND_REPLY_LEN);
+    msg->msgid = MAVLINK_MSG_ID_SECURE_COMMAND_REPLY;
+    return mavlink_finalize_message(msg, system_id, component_id, MAVLINK_MSG_ID_SECURE_COMMAND_REPLY_MIN_LEN, MAVLINK_MSG_ID_SECURE_COMMAND_REPLY_LEN, MAVLINK_MSG_ID_SECURE_COMMAND_REPLY_CRC);
+}
+
+#ifdef MAVLINK_USE_CONVENIENCE_FUNCTIONS
+
+static inline void mavlink_msg_secure_command_reply_send(mavlink_channel_t chan, uint32_t sequence, uint32_t operation, uint8_t result, uint8_t data_length, const uint8_t *data)
+{
+    mavlink_secure_command_reply_t packet;
+    packet.sequence = sequence;
+    packet.operation = operation;
+    packet.result = result;
+    packet.data_length = data_length;
+    mav_array_memcpy(packet.data, data, sizeof(uint8_t)*220);
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_SECURE_COMMAND_REPLY, (const char *)&packet, MAVLINK_MSG_ID_SECURE_COMMAND_REPLY_MIN_LEN, MAVLINK_MSG_ID_SECURE_COMMAND_REPLY_LEN, MAVLINK_MSG_ID_SECURE_COMMAND_REPLY_CRC);
+}
+
+static inline void mavlink_msg_secure_command_reply_send_struct(mavlink_channel_t chan, const mavlink_secure_command_reply_t* secure_command_reply)
+{
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_SECURE_COMMAND_REPLY, (const char *)secure_command_reply, MAVLINK_MSG_ID_SECURE_COMMAND_REPLY_MIN_LEN, MAVLINK_MSG_ID_SECURE_COMMAND_REPLY_LEN, MAVLINK_MSG_ID_SECURE_COMMAND_REPLY_CRC);
+}
+
+#endif // MAVLINK_USE_CONVENIENCE_FUNCTIONS
+
+static inline uint32_t mavlink_msg_secure_command_reply_get_sequence(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint32_t(msg, 0);
+}
+
+static inline uint32_t mavlink_msg_secure_command_reply_get_operation(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint32_t(msg, 4);
+}
+
+static inline uint8_t mavlink_msg_secure_command_reply_get_result(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 8);
+}
+
+static inline uint8_t mavlink_msg_secure_command_reply_get_data_length(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 9);
+}
+
+static inline uint16_t mavlink_msg_secure_command_reply_get_data(const mavlink_message_t* msg, uint8_t *data)
+{
+    return _MAV_RETURN_uint8_t_array(msg, data, 220, 10);
+}
+
+static inline void mavlink_msg_secure_command_reply_decode(const mavlink_message_t* msg, mavlink_secure_command_reply_t* secure_command_reply)
+{
+    const uint8_t len = msg->len < MAVLINK_MSG_ID_SECURE_COMMAND_REPLY_LEN ? msg->len : MAVLINK_MSG_ID_SECURE_COMMAND_REPLY_LEN;
+    memset(secure_command_reply, 0, MAVLINK_MSG_ID_SECURE_COMMAND_REPLY_LEN);
+    memcpy(secure_command_reply, _MAV_PAYLOAD(msg), len);
+}
+
+// MESSAGE OPEN_DRONE_ID_BASIC_ID
+
 #define MAVLINK_MSG_ID_OPEN_DRONE_ID_BASIC_ID 12900
 
-// MAVLink types
-#define MAV_TYPE_GCS 6
-#define MAV_TYPE_ODID 18
+MAVPACKED(
+typedef struct __mavlink_open_drone_id_basic_id_t {
+    uint8_t target_system;
+    uint8_t target_component;
+    uint8_t id_or_mac[20];
+    uint8_t id_type;
+    uint8_t ua_type;
+    uint8_t uas_id[20];
+}) mavlink_open_drone_id_basic_id_t;
 
-// MAVLink autopilot types
-#define MAV_AUTOPILOT_INVALID 8
+#define MAVLINK_MSG_ID_OPEN_DRONE_ID_BASIC_ID_LEN 44
+#define MAVLINK_MSG_ID_OPEN_DRONE_ID_BASIC_ID_MIN_LEN 44
+#define MAVLINK_MSG_ID_12900_LEN 44
+#define MAVLINK_MSG_ID_12900_MIN_LEN 44
+#define MAVLINK_MSG_ID_OPEN_DRONE_ID_BASIC_ID_CRC 114
+#define MAVLINK_MSG_ID_12900_CRC 114
+#define MAVLINK_MSG_OPEN_DRONE_ID_BASIC_ID_FIELD_ID_OR_MAC_LEN 20
+#define MAVLINK_MSG_OPEN_DRONE_ID_BASIC_ID_FIELD_UAS_ID_LEN 20
+static_assert(sizeof(mavlink_open_drone_id_basic_id_t) == MAVLINK_MSG_ID_OPEN_DRONE_ID_BASIC_ID_LEN, "open_drone_id_basic_id wire size");
 
-// MAVLink component IDs
-#define MAV_COMP_ID_ODID_TXRX_1 236
+static inline uint16_t mavlink_msg_open_drone_id_basic_id_pack(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg, uint8_t target_system, uint8_t target_component, const uint8_t *id_or_mac, uint8_t id_type, uint8_t ua_type, const uint8_t *uas_id)
+{
+    mavlink_open_drone_id_basic_id_t packet;
+    packet.target_system = target_system;
+    packet.target_component = target_component;
+    mav_array_memcpy(packet.id_or_mac, id_or_mac, sizeof(uint8_t)*20);
+    packet.id_type = id_type;
+    packet.ua_type = ua_type;
+    mav_array_memcpy(packet.uas_id, uas_id, sizeof(uint8_t)*20);
+    memcpy(_MAV_PAYLOAD_NON_CONST(msg), &packet, MAVLINK_MSG_ID_OPEN_DRONE_ID_BASIC_ID_LEN);
+    msg->msgid = MAVLINK_MSG_ID_OPEN_DRONE_ID_BASIC_ID;
+    return mavlink_finalize_message(msg, system_id, component_id, MAVLINK_MSG_ID_OPEN_DRONE_ID_BASIC_ID_MIN_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_BASIC_ID_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_BASIC_ID_CRC);
+}
+
+static inline uint16_t mavlink_msg_open_drone_id_basic_id_encode(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg, const mavlink_open_drone_id_basic_id_t* open_drone_id_basic_id)
+{
+    memcpy(_MAV_PAYLOAD_NON_CONST(msg), open_drone_id_basic_id, MAVLINK_MSG_ID_OPEN_DRONE_ID_BASIC_ID_LEN);
+    msg->msgid = MAVLINK_MSG_ID_OPEN_DRONE_ID_BASIC_ID;
+    return mavlink_finalize_message(msg, system_id, component_id, MAVLINK_MSG_ID_OPEN_DRONE_ID_BASIC_ID_MIN_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_BASIC_ID_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_BASIC_ID_CRC);
+}
+
+#ifdef MAVLINK_USE_CONVENIENCE_FUNCTIONS
+
+static inline void mavlink_msg_open_drone_id_basic_id_send(mavlink_channel_t chan, uint8_t target_system, uint8_t target_component, const uint8_t *id_or_mac, uint8_t id_type, uint8_t ua_type, const uint8_t *uas_id)
+{
+    mavlink_open_drone_id_basic_id_t packet;
+    packet.target_system = target_system;
+    packet.target_component = target_component;
+    mav_array_memcpy(packet.id_or_mac, id_or_mac, sizeof(uint8_t)*20);
+    packet.id_type = id_type;
+    packet.ua_type = ua_type;
+    mav_array_memcpy(packet.uas_id, uas_id, sizeof(uint8_t)*20);
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_OPEN_DRONE_ID_BASIC_ID, (const char *)&packet, MAVLINK_MSG_ID_OPEN_DRONE_ID_BASIC_ID_MIN_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_BASIC_ID_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_BASIC_ID_CRC);
+}
+
+static inline void mavlink_msg_open_drone_id_basic_id_send_struct(mavlink_channel_t chan, const mavlink_open_drone_id_basic_id_t* open_drone_id_basic_id)
+{
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_OPEN_DRONE_ID_BASIC_ID, (const char *)open_drone_id_basic_id, MAVLINK_MSG_ID_OPEN_DRONE_ID_BASIC_ID_MIN_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_BASIC_ID_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_BASIC_ID_CRC);
+}
+
+#endif // MAVLINK_USE_CONVENIENCE_FUNCTIONS
+
+static inline uint8_t mavlink_msg_open_drone_id_basic_id_get_target_system(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 0);
+}
+
+static inline uint8_t mavlink_msg_open_drone_id_basic_id_get_target_component(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 1);
+}
+
+static inline uint16_t mavlink_msg_open_drone_id_basic_id_get_id_or_mac(const mavlink_message_t* msg, uint8_t *id_or_mac)
+{
+    return _MAV_RETURN_uint8_t_array(msg, id_or_mac, 20, 2);
+}
+
+static inline uint8_t mavlink_msg_open_drone_id_basic_id_get_id_type(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 22);
+}
+
+static inline uint8_t mavlink_msg_open_drone_id_basic_id_get_ua_type(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 23);
+}
+
+static inline uint16_t mavlink_msg_open_drone_id_basic_id_get_uas_id(const mavlink_message_t* msg, uint8_t *uas_id)
+{
+    return _MAV_RETURN_uint8_t_array(msg, uas_id, 20, 24);
+}
+
+static inline void mavlink_msg_open_drone_id_basic_id_decode(const mavlink_message_t* msg, mavlink_open_drone_id_basic_id_t* open_drone_id_basic_id)
+{
+    const uint8_t len = msg->len < MAVLINK_MSG_ID_OPEN_DRONE_ID_BASIC_ID_LEN ? msg->len : MAVLINK_MSG_ID_OPEN_DRONE_ID_BASIC_ID_LEN;
+    memset(open_drone_id_basic_id, 0, MAVLINK_MSG_ID_OPEN_DRONE_ID_BASIC_ID_LEN);
+    memcpy(open_drone_id_basic_id, _MAV_PAYLOAD(msg), len);
+}
+
+// MESSAGE OPEN_DRONE_ID_LOCATION
+
+#define MAVLINK_MSG_ID_OPEN_DRONE_ID_LOCATION 12901
+
+MAVPACKED(
+typedef struct __mavlink_open_drone_id_location_t {
+    int32_t latitude;
+    int32_t longitude;
+    float altitude_barometric;
+    float altitude_geodetic;
+    float height;
+    float timestamp;
+    uint16_t direction;
+    uint16_t speed_horizontal;
+    int16_t speed_vertical;
+    uint8_t target_system;
+    uint8_t target_component;
+    uint8_t id_or_mac[20];
+    uint8_t status;
+    uint8_t height_reference;
+    uint8_t horizontal_accuracy;
+    uint8_t vertical_accuracy;
+    uint8_t barometer_accuracy;
+    uint8_t speed_accuracy;
+    uint8_t timestamp_accuracy;
+}) mavlink_open_drone_id_location_t;
+
+#define MAVLINK_MSG_ID_OPEN_DRONE_ID_LOCATION_LEN 59
+#define MAVLINK_MSG_ID_OPEN_DRONE_ID_LOCATION_MIN_LEN 59
+#define MAVLINK_MSG_ID_12901_LEN 59
+#define MAVLINK_MSG_ID_12901_MIN_LEN 59
+#define MAVLINK_MSG_ID_OPEN_DRONE_ID_LOCATION_CRC 254
+#define MAVLINK_MSG_ID_12901_CRC 254
+#define MAVLINK_MSG_OPEN_DRONE_ID_LOCATION_FIELD_ID_OR_MAC_LEN 20
+static_assert(sizeof(mavlink_open_drone_id_location_t) == MAVLINK_MSG_ID_OPEN_DRONE_ID_LOCATION_LEN, "open_drone_id_location wire size");
+
+static inline uint16_t mavlink_msg_open_drone_id_location_pack(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg, uint8_t target_system, uint8_t target_component, const uint8_t *id_or_mac, uint8_t status, uint16_t direction, uint16_t speed_horizontal, int16_t speed_vertical, int32_t latitude, int32_t longitude, float altitude_barometric, float altitude_geodetic, uint8_t height_reference, float height, uint8_t horizontal_accuracy, uint8_t vertical_accuracy, uint8_t barometer_accuracy, uint8_t speed_accuracy, float timestamp, uint8_t timestamp_accuracy)
+{
+    mavlink_open_drone_id_location_t packet;
+    packet.target_system = target_system;
+    packet.target_component = target_component;
+    mav_array_memcpy(packet.id_or_mac, id_or_mac, sizeof(uint8_t)*20);
+    packet.status = status;
+    packet.direction = direction;
+    packet.speed_horizontal = speed_horizontal;
+    packet.speed_vertical = speed_vertical;
+    packet.latitude = latitude;
+    packet.longitude = longitude;
+    packet.altitude_barometric = altitude_barometric;
+    packet.altitude_geodetic = altitude_geodetic;
+    packet.height_reference = height_reference;
+    packet.height = height;
+    packet.horizontal_accuracy = horizontal_accuracy;
+    packet.vertical_accuracy = vertical_accuracy;
+    packet.barometer_accuracy = barometer_accuracy;
+    packet.speed_accuracy = speed_accuracy;
+    packet.timestamp = timestamp;
+    packet.timestamp_accuracy = timestamp_accuracy;
+    memcpy(_MAV_PAYLOAD_NON_CONST(msg), &packet, MAVLINK_MSG_ID_OPEN_DRONE_ID_LOCATION_LEN);
+    msg->msgid = MAVLINK_MSG_ID_OPEN_DRONE_ID_LOCATION;
+    return mavlink_finalize_message(msg, system_id, component_id, MAVLINK_MSG_ID_OPEN_DRONE_ID_LOCATION_MIN_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_LOCATION_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_LOCATION_CRC);
+}
+
+static inline uint16_t mavlink_msg_open_drone_id_location_encode(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg, const mavlink_open_drone_id_location_t* open_drone_id_location)
+{
+    memcpy(_MAV_PAYLOAD_NON_CONST(msg), open_drone_id_location, MAVLINK_MSG_ID_OPEN_DRONE_ID_LOCATION_LEN);
+    msg->msgid = MAVLINK_MSG_ID_OPEN_DRONE_ID_LOCATION;
+    return mavlink_finalize_message(msg, system_id, component_id, MAVLINK_MSG_ID_OPEN_DRONE_ID_LOCATION_MIN_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_LOCATION_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_LOCATION_CRC);
+}
+
+#ifdef MAVLINK_USE_CONVENIENCE_FUNCTIONS
+
+static inline void mavlink_msg_open_drone_id_location_send(mavlink_channel_t chan, uint8_t target_system, uint8_t target_component, const uint8_t *id_or_mac, uint8_t status, uint16_t direction, uint16_t speed_horizontal, int16_t speed_vertical, int32_t latitude, int32_t longitude, float altitude_barometric, float altitude_geodetic, uint8_t height_reference, float height, uint8_t horizontal_accuracy, uint8_t vertical_accuracy, uint8_t barometer_accuracy, uint8_t speed_accuracy, float timestamp, uint8_t timestamp_accuracy)
+{
+    mavlink_open_drone_id_location_t packet;
+    packet.target_system = target_system;
+    packet.target_component = target_component;
+    mav_array_memcpy(packet.id_or_mac, id_or_mac, sizeof(uint8_t)*20);
+    packet.status = status;
+    packet.direction = direction;
+    packet.speed_horizontal = speed_horizontal;
+    packet.speed_vertical = speed_vertical;
+    packet.latitude = latitude;
+    packet.longitude = longitude;
+    packet.altitude_barometric = altitude_barometric;
+    packet.altitude_geodetic = altitude_geodetic;
+    packet.height_reference = height_reference;
+    packet.height = height;
+    packet.horizontal_accuracy = horizontal_accuracy;
+    packet.vertical_accuracy = vertical_accuracy;
+    packet.barometer_accuracy = barometer_accuracy;
+    packet.speed_accuracy = speed_accuracy;
+    packet.timestamp = timestamp;
+    packet.timestamp_accuracy = timestamp_accuracy;
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_OPEN_DRONE_ID_LOCATION, (const char *)&packet, MAVLINK_MSG_ID_OPEN_DRONE_ID_LOCATION_MIN_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_LOCATION_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_LOCATION_CRC);
+}
+
+static inline void mavlink_msg_open_drone_id_location_send_struct(mavlink_channel_t chan, const mavlink_open_drone_id_location_t* open_drone_id_location)
+{
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_OPEN_DRONE_ID_LOCATION, (const char *)open_drone_id_location, MAVLINK_MSG_ID_OPEN_DRONE_ID_LOCATION_MIN_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_LOCATION_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_LOCATION_CRC);
+}
+
+#endif // MAVLINK_USE_CONVENIENCE_FUNCTIONS
+
+static inline uint8_t mavlink_msg_open_drone_id_location_get_target_system(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 30);
+}
+
+static inline uint8_t mavlink_msg_open_drone_id_location_get_target_component(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 31);
+}
+
+static inline uint16_t mavlink_msg_open_drone_id_location_get_id_or_mac(const mavlink_message_t* msg, uint8_t *id_or_mac)
+{
+    return _MAV_RETURN_uint8_t_array(msg, id_or_mac, 20, 32);
+}
+
+static inline uint8_t mavlink_msg_open_drone_id_location_get_status(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 52);
+}
+
+static inline uint16_t mavlink_msg_open_drone_id_location_get_direction(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint16_t(msg, 24);
+}
+
+static inline uint16_t mavlink_msg_open_drone_id_location_get_speed_horizontal(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint16_t(msg, 26);
+}
+
+static inline int16_t mavlink_msg_open_drone_id_location_get_speed_vertical(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_int16_t(msg, 28);
+}
+
+static inline int32_t mavlink_msg_open_drone_id_location_get_latitude(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_int32_t(msg, 0);
+}
+
+static inline int32_t mavlink_msg_open_drone_id_location_get_longitude(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_int32_t(msg, 4);
+}
+
+static inline float mavlink_msg_open_drone_id_location_get_altitude_barometric(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_float(msg, 8);
+}
+
+static inline float mavlink_msg_open_drone_id_location_get_altitude_geodetic(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_float(msg, 12);
+}
+
+static inline uint8_t mavlink_msg_open_drone_id_location_get_height_reference(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 53);
+}
+
+static inline float mavlink_msg_open_drone_id_location_get_height(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_float(msg, 16);
+}
+
+static inline uint8_t mavlink_msg_open_drone_id_location_get_horizontal_accuracy(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 54);
+}
+
+static inline uint8_t mavlink_msg_open_drone_id_location_get_vertical_accuracy(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 55);
+}
+
+static inline uint8_t mavlink_msg_open_drone_id_location_get_barometer_accuracy(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 56);
+}
+
+static inline uint8_t mavlink_msg_open_drone_id_location_get_speed_accuracy(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 57);
+}
+
+static inline float mavlink_msg_open_drone_id_location_get_timestamp(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_float(msg, 20);
+}
 
-// MAVLink message field lengths
-#define MAVLINK_MSG_STATUSTEXT_FIELD_TEXT_LEN 50
+static inline uint8_t mavlink_msg_open_drone_id_location_get_timestamp_accuracy(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 58);
+}
 
-// OpenDroneID ID types
-#define MAV_ODID_ID_TYPE_SPECIFIC_SESSION_ID 4
+static inline void mavlink_msg_open_drone_id_location_decode(const mavlink_message_t* msg, mavlink_open_drone_id_location_t* open_drone_id_location)
+{
+    const uint8_t len = msg->len < MAVLINK_MSG_ID_OPEN_DRONE_ID_LOCATION_LEN ? msg->len : MAVLINK_MSG_ID_OPEN_DRONE_ID_LOCATION_LEN;
+    memset(open_drone_id_location, 0, MAVLINK_MSG_ID_OPEN_DRONE_ID_LOCATION_LEN);
+    memcpy(open_drone_id_location, _MAV_PAYLOAD(msg), len);
+}
 
-// Channel type
-typedef enum {
-    MAVLINK_COMM_0 = 0,
-    MAVLINK_COMM_1 = 1,
-    MAVLINK_COMM_2 = 2,
-    MAVLINK_COMM_3 = 3
-} mavlink_channel_t;
+// MESSAGE OPEN_DRONE_ID_AUTHENTICATION
 
-// Message structures (stubs)
-typedef struct __mavlink_open_drone_id_location_t {
-    uint8_t target_system;
-    uint8_t target_component;
-    int32_t latitude;
-    int32_t longitude;
-    float altitude_barometric;
-    float altitude_geodetic;
-    uint16_t height;
-    uint16_t horizontal_accuracy;
-    uint16_t vertical_accuracy;
-    uint16_t barometer_accuracy;
-    uint16_t speed_accuracy;
-    uint64_t timestamp;
-    uint8_t direction;
-    uint8_t speed_horizontal;
-    int8_t speed_vertical;
-} mavlink_open_drone_id_location_t;
+#define MAVLINK_MSG_ID_OPEN_DRONE_ID_AUTHENTICATION 12902
 
+MAVPACKED(
 typedef struct __mavlink_open_drone_id_authentication_t {
+    uint32_t timestamp;
     uint8_t target_system;
     uint8_t target_component;
     uint8_t id_or_mac[20];
@@ -81,44 +1110,488 @@ typedef struct __mavlink_open_drone_id_authentication_t {
     uint8_t data_page;
     uint8_t last_page_index;
     uint8_t length;
-    uint32_t timestamp;
-    uint8_t authentication_data[17];
-} mavlink_open_drone_id_authentication_t;
+    uint8_t authentication_data[23];
+}) mavlink_open_drone_id_authentication_t;
+
+#define MAVLINK_MSG_ID_OPEN_DRONE_ID_AUTHENTICATION_LEN 53
+#define MAVLINK_MSG_ID_OPEN_DRONE_ID_AUTHENTICATION_MIN_LEN 53
+#define MAVLINK_MSG_ID_12902_LEN 53
+#define MAVLINK_MSG_ID_12902_MIN_LEN 53
+#define MAVLINK_MSG_ID_OPEN_DRONE_ID_AUTHENTICATION_CRC 140
+#define MAVLINK_MSG_ID_12902_CRC 140
+#define MAVLINK_MSG_OPEN_DRONE_ID_AUTHENTICATION_FIELD_ID_OR_MAC_LEN 20
+#define MAVLINK_MSG_OPEN_DRONE_ID_AUTHENTICATION_FIELD_AUTHENTICATION_DATA_LEN 23
+static_assert(sizeof(mavlink_open_drone_id_authentication_t) == MAVLINK_MSG_ID_OPEN_DRONE_ID_AUTHENTICATION_LEN, "open_drone_id_authentication wire size");
+
+static inline uint16_t mavlink_msg_open_drone_id_authentication_pack(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg, uint8_t target_system, uint8_t target_component, const uint8_t *id_or_mac, uint8_t authentication_type, uint8_t data_page, uint8_t last_page_index, uint8_t length, uint32_t timestamp, const uint8_t *authentication_data)
+{
+    mavlink_open_drone_id_authentication_t packet;
+    packet.target_system = target_system;
+    packet.target_component = target_component;
+    mav_array_memcpy(packet.id_or_mac, id_or_mac, sizeof(uint8_t)*20);
+    packet.authentication_type = authentication_type;
+    packet.data_page = data_page;
+    packet.last_page_index = last_page_index;
+    packet.length = length;
+    packet.timestamp = timestamp;
+    mav_array_memcpy(packet.authentication_data, authentication_data, sizeof(uint8_t)*23);
+    memcpy(_MAV_PAYLOAD_NON_CONST(msg), &packet, MAVLINK_MSG_ID_OPEN_DRONE_ID_AUTHENTICATION_LEN);
+    msg->msgid = MAVLINK_MSG_ID_OPEN_DRONE_ID_AUTHENTICATION;
+    return mavlink_finalize_message(msg, system_id, component_id, MAVLINK_MSG_ID_OPEN_DRONE_ID_AUTHENTICATION_MIN_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_AUTHENTICATION_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_AUTHENTICATION_CRC);
+}
+
+static inline uint16_t mavlink_msg_open_drone_id_authentication_encode(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg, const mavlink_open_drone_id_authentication_t* open_drone_id_authentication)
+{
+    memcpy(_MAV_PAYLOAD_NON_CONST(msg), open_drone_id_authentication, MAVLINK_MSG_ID_OPEN_DRONE_ID_AUTHENTICATION_LEN);
+    msg->msgid = MAVLINK_MSG_ID_OPEN_DRONE_ID_AUTHENTICATION;
+    return mavlink_finalize_message(msg, system_id, component_id, MAVLINK_MSG_ID_OPEN_DRONE_ID_AUTHENTICATION_MIN_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_AUTHENTICATION_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_AUTHENTICATION_CRC);
+}
+
+#ifdef MAVLINK_USE_CONVENIENCE_FUNCTIONS
+
+static inline void mavlink_msg_open_drone_id_authentication_send(mavlink_channel_t chan, uint8_t target_system, uint8_t target_component, const uint8_t *id_or_mac, uint8_t authentication_type, uint8_t data_page, uint8_t last_page_index, uint8_t length, uint32_t timestamp, const uint8_t *authentication_data)
+{
+    mavlink_open_drone_id_authentication_t packet;
+    packet.target_system = target_system;
+    packet.target_component = target_component;
+    mav_array_memcpy(packet.id_or_mac, id_or_mac, sizeof(uint8_t)*20);
+    packet.authentication_type = authentication_type;
+    packet.data_page = data_page;
+    packet.last_page_index = last_page_index;
+    packet.length = length;
+    packet.timestamp = timestamp;
+    mav_array_memcpy(packet.authentication_data, authentication_data, sizeof(uint8_t)*23);
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_OPEN_DRONE_ID_AUTHENTICATION, (const char *)&packet, MAVLINK_MSG_ID_OPEN_DRONE_ID_AUTHENTICATION_MIN_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_AUTHENTICATION_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_AUTHENTICATION_CRC);
+}
+
+static inline void mavlink_msg_open_drone_id_authentication_send_struct(mavlink_channel_t chan, const mavlink_open_drone_id_authentication_t* open_drone_id_authentication)
+{
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_OPEN_DRONE_ID_AUTHENTICATION, (const char *)open_drone_id_authentication, MAVLINK_MSG_ID_OPEN_DRONE_ID_AUTHENTICATION_MIN_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_AUTHENTICATION_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_AUTHENTICATION_CRC);
+}
+
+#endif // MAVLINK_USE_CONVENIENCE_FUNCTIONS
+
+static inline uint8_t mavlink_msg_open_drone_id_authentication_get_target_system(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 4);
+}
+
+static inline uint8_t mavlink_msg_open_drone_id_authentication_get_target_component(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 5);
+}
+
+static inline uint16_t mavlink_msg_open_drone_id_authentication_get_id_or_mac(const mavlink_message_t* msg, uint8_t *id_or_mac)
+{
+    return _MAV_RETURN_uint8_t_array(msg, id_or_mac, 20, 6);
+}
 
+static inline uint8_t mavlink_msg_open_drone_id_authentication_get_authentication_type(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 26);
+}
+
+static inline uint8_t mavlink_msg_open_drone_id_authentication_get_data_page(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 27);
+}
+
+static inline uint8_t mavlink_msg_open_drone_id_authentication_get_last_page_index(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 28);
+}
+
+static inline uint8_t mavlink_msg_open_drone_id_authentication_get_length(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 29);
+}
+
+static inline uint32_t mavlink_msg_open_drone_id_authentication_get_timestamp(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint32_t(msg, 0);
+}
+
+static inline uint16_t mavlink_msg_open_drone_id_authentication_get_authentication_data(const mavlink_message_t* msg, uint8_t *authentication_data)
+{
+    return _MAV_RETURN_uint8_t_array(msg, authentication_data, 23, 30);
+}
+
+static inline void mavlink_msg_open_drone_id_authentication_decode(const mavlink_message_t* msg, mavlink_open_drone_id_authentication_t* open_drone_id_authentication)
+{
+    const uint8_t len = msg->len < MAVLINK_MSG_ID_OPEN_DRONE_ID_AUTHENTICATION_LEN ? msg->len : MAVLINK_MSG_ID_OPEN_DRONE_ID_AUTHENTICATION_LEN;
+    memset(open_drone_id_authentication, 0, MAVLINK_MSG_ID_OPEN_DRONE_ID_AUTHENTICATION_LEN);
+    memcpy(open_drone_id_authentication, _MAV_PAYLOAD(msg), len);
+}
+
+// MESSAGE OPEN_DRONE_ID_SELF_ID
+
+#define MAVLINK_MSG_ID_OPEN_DRONE_ID_SELF_ID 12903
+
+MAVPACKED(
 typedef struct __mavlink_open_drone_id_self_id_t {
     uint8_t target_system;
     uint8_t target_component;
     uint8_t id_or_mac[20];
     uint8_t description_type;
     char description[23];
-} mavlink_open_drone_id_self_id_t;
+}) mavlink_open_drone_id_self_id_t;
+
+#define MAVLINK_MSG_ID_OPEN_DRONE_ID_SELF_ID_LEN 46
+#define MAVLINK_MSG_ID_OPEN_DRONE_ID_SELF_ID_MIN_LEN 46
+#define MAVLINK_MSG_ID_12903_LEN 46
+#define MAVLINK_MSG_ID_12903_MIN_LEN 46
+#define MAVLINK_MSG_ID_OPEN_DRONE_ID_SELF_ID_CRC 249
+#define MAVLINK_MSG_ID_12903_CRC 249
+#define MAVLINK_MSG_OPEN_DRONE_ID_SELF_ID_FIELD_ID_OR_MAC_LEN 20
+#define MAVLINK_MSG_OPEN_DRONE_ID_SELF_ID_FIELD_DESCRIPTION_LEN 23
+static_assert(sizeof(mavlink_open_drone_id_self_id_t) == MAVLINK_MSG_ID_OPEN_DRONE_ID_SELF_ID_LEN, "open_drone_id_self_id wire size");
+
+static inline uint16_t mavlink_msg_open_drone_id_self_id_pack(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg, uint8_t target_system, uint8_t target_component, const uint8_t *id_or_mac, uint8_t description_type, const char *description)
+{
+    mavlink_open_drone_id_self_id_t packet;
+    packet.target_system = target_system;
+    packet.target_component = target_component;
+    mav_array_memcpy(packet.id_or_mac, id_or_mac, sizeof(uint8_t)*20);
+    packet.description_type = description_type;
+    mav_array_assign_char(packet.description, description, 23);
+    memcpy(_MAV_PAYLOAD_NON_CONST(msg), &packet, MAVLINK_MSG_ID_OPEN_DRONE_ID_SELF_ID_LEN);
+    msg->msgid = MAVLINK_MSG_ID_OPEN_DRONE_ID_SELF_ID;
+    return mavlink_finalize_message(msg, system_id, component_id, MAVLINK_MSG_ID_OPEN_DRONE_ID_SELF_ID_MIN_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_SELF_ID_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_SELF_ID_CRC);
+}
+
+static inline uint16_t mavlink_msg_open_drone_id_self_id_encode(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg, const mavlink_open_drone_id_self_id_t* open_drone_id_self_id)
+{
+    memcpy(_MAV_PAYLOAD_NON_CONST(msg), open_drone_id_self_id, MAVLINK_MSG_ID_OPEN_DRONE_ID_SELF_ID_LEN);
+    msg->msgid = MAVLINK_MSG_ID_OPEN_DRONE_ID_SELF_ID;
+    return mavlink_finalize_message(msg, system_id, component_id, MAVLINK_MSG_ID_OPEN_DRONE_ID_SELF_ID_MIN_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_SELF_ID_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_SELF_ID_CRC);
+}
+
+#ifdef MAVLINK_USE_CONVENIENCE_FUNCTIONS
+
+static inline void mavlink_msg_open_drone_id_self_id_send(mavlink_channel_t chan, uint8_t target_system, uint8_t target_component, const uint8_t *id_or_mac, uint8_t description_type, const char *description)
+{
+    mavlink_open_drone_id_self_id_t packet;
+    packet.target_system = target_system;
+    packet.target_component = target_component;
+    mav_array_memcpy(packet.id_or_mac, id_or_mac, sizeof(uint8_t)*20);
+    packet.description_type = description_type;
+    mav_array_assign_char(packet.description, description, 23);
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_OPEN_DRONE_ID_SELF_ID, (const char *)&packet, MAVLINK_MSG_ID_OPEN_DRONE_ID_SELF_ID_MIN_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_SELF_ID_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_SELF_ID_CRC);
+}
+
+static inline void mavlink_msg_open_drone_id_self_id_send_struct(mavlink_channel_t chan, const mavlink_open_drone_id_self_id_t* open_drone_id_self_id)
+{
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_OPEN_DRONE_ID_SELF_ID, (const char *)open_drone_id_self_id, MAVLINK_MSG_ID_OPEN_DRONE_ID_SELF_ID_MIN_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_SELF_ID_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_SELF_ID_CRC);
+}
+
+#endif // MAVLINK_USE_CONVENIENCE_FUNCTIONS
+
+static inline uint8_t mavlink_msg_open_drone_id_self_id_get_target_system(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 0);
+}
+
+static inline uint8_t mavlink_msg_open_drone_id_self_id_get_target_component(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 1);
+}
 
+static inline uint16_t mavlink_msg_open_drone_id_self_id_get_id_or_mac(const mavlink_message_t* msg, uint8_t *id_or_mac)
+{
+    return _MAV_RETURN_uint8_t_array(msg, id_or_mac, 20, 2);
+}
+
+static inline uint8_t mavlink_msg_open_drone_id_self_id_get_description_type(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 22);
+}
+
+static inline uint16_t mavlink_msg_open_drone_id_self_id_get_description(const mavlink_message_t* msg, char *description)
+{
+    return _MAV_RETURN_char_array(msg, description, 23, 23);
+}
+
+static inline void mavlink_msg_open_drone_id_self_id_decode(const mavlink_message_t* msg, mavlink_open_drone_id_self_id_t* open_drone_id_self_id)
+{
+    const uint8_t len = msg->len < MAVLINK_MSG_ID_OPEN_DRONE_ID_SELF_ID_LEN ? msg->len : MAVLINK_MSG_ID_OPEN_DRONE_ID_SELF_ID_LEN;
+    memset(open_drone_id_self_id, 0, MAVLINK_MSG_ID_OPEN_DRONE_ID_SELF_ID_LEN);
+    memcpy(open_drone_id_self_id, _MAV_PAYLOAD(msg), len);
+}
+
+// MESSAGE OPEN_DRONE_ID_SYSTEM
+
+#define MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM 12904
+
+MAVPACKED(
 typedef struct __mavlink_open_drone_id_system_t {
+    int32_t operator_latitude;
+    int32_t operator_longitude;
+    float area_ceiling;
+    float area_floor;
+    float operator_altitude_geo;
+    uint32_t timestamp;
+    uint16_t area_count;
+    uint16_t area_radius;
     uint8_t target_system;
     uint8_t target_component;
     uint8_t id_or_mac[20];
     uint8_t operator_location_type;
     uint8_t classification_type;
-    int32_t operator_latitude;
-    int32_t operator_longitude;
-    uint16_t area_count;
-    uint16_t area_radius;
-    float area_ceiling;
-    float area_floor;
     uint8_t category_eu;
     uint8_t class_eu;
-    float operator_altitude_geo;
-    uint32_t timestamp;
-} mavlink_open_drone_id_system_t;
+}) mavlink_open_drone_id_system_t;
+
+#define MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_LEN 54
+#define MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_MIN_LEN 54
+#define MAVLINK_MSG_ID_12904_LEN 54
+#define MAVLINK_MSG_ID_12904_MIN_LEN 54
+#define MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_CRC 77
+#define MAVLINK_MSG_ID_12904_CRC 77
+#define MAVLINK_MSG_OPEN_DRONE_ID_SYSTEM_FIELD_ID_OR_MAC_LEN 20
+static_assert(sizeof(mavlink_open_drone_id_system_t) == MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_LEN, "open_drone_id_system wire size");
+
+static inline uint16_t mavlink_msg_open_drone_id_system_pack(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg, uint8_t target_system, uint8_t target_component, const uint8_t *id_or_mac, uint8_t operator_location_type, uint8_t classification_type, int32_t operator_latitude, int32_t operator_longitude, uint16_t area_count, uint16_t area_radius, float area_ceiling, float area_floor, uint8_t category_eu, uint8_t class_eu, float operator_altitude_geo, uint32_t timestamp)
+{
+    mavlink_open_drone_id_system_t packet;
+    packet.target_system = target_system;
+    packet.target_component = target_component;
+    mav_array_memcpy(packet.id_or_mac, id_or_mac, sizeof(uint8_t)*20);
+    packet.operator_location_type = operator_location_type;
+    packet.classification_type = classification_type;
+    packet.operator_latitude = operator_latitude;
+    packet.operator_longitude = operator_longitude;
+    packet.area_count = area_count;
+    packet.area_radius = area_radius;
+    packet.area_ceiling = area_ceiling;
+    packet.area_floor = area_floor;
+    packet.category_eu = category_eu;
+    packet.class_eu = class_eu;
+    packet.operator_altitude_geo = operator_altitude_geo;
+    packet.timestamp = timestamp;
+    memcpy(_MAV_PAYLOAD_NON_CONST(msg), &packet, MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_LEN);
+    msg->msgid = MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM;
+    return mavlink_finalize_message(msg, system_id, component_id, MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_MIN_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_CRC);
+}
+
+static inline uint16_t mavlink_msg_open_drone_id_system_encode(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg, const mavlink_open_drone_id_system_t* open_drone_id_system)
+{
+    memcpy(_MAV_PAYLOAD_NON_CONST(msg), open_drone_id_system, MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_LEN);
+    msg->msgid = MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM;
+    return mavlink_finalize_message(msg, system_id, component_id, MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_MIN_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_CRC);
+}
+
+#ifdef MAVLINK_USE_CONVENIENCE_FUNCTIONS
+
+static inline void mavlink_msg_open_drone_id_system_send(mavlink_channel_t chan, uint8_t target_system, uint8_t target_component, const uint8_t *id_or_mac, uint8_t operator_location_type, uint8_t classification_type, int32_t operator_latitude, int32_t operator_longitude, uint16_t area_count, uint16_t area_radius, float area_ceiling, float area_floor, uint8_t category_eu, uint8_t class_eu, float operator_altitude_geo, uint32_t timestamp)
+{
+    mavlink_open_drone_id_system_t packet;
+    packet.target_system = target_system;
+    packet.target_component = target_component;
+    mav_array_memcpy(packet.id_or_mac, id_or_mac, sizeof(uint8_t)*20);
+    packet.operator_location_type = operator_location_type;
+    packet.classification_type = classification_type;
+    packet.operator_latitude = operator_latitude;
+    packet.operator_longitude = operator_longitude;
+    packet.area_count = area_count;
+    packet.area_radius = area_radius;
+    packet.area_ceiling = area_ceiling;
+    packet.area_floor = area_floor;
+    packet.category_eu = category_eu;
+    packet.class_eu = class_eu;
+    packet.operator_altitude_geo = operator_altitude_geo;
+    packet.timestamp = timestamp;
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM, (const char *)&packet, MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_MIN_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_CRC);
+}
+
+static inline void mavlink_msg_open_drone_id_system_send_struct(mavlink_channel_t chan, const mavlink_open_drone_id_system_t* open_drone_id_system)
+{
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM, (const char *)open_drone_id_system, MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_MIN_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_CRC);
+}
+
+#endif // MAVLINK_USE_CONVENIENCE_FUNCTIONS
+
+static inline uint8_t mavlink_msg_open_drone_id_system_get_target_system(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 28);
+}
+
+static inline uint8_t mavlink_msg_open_drone_id_system_get_target_component(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 29);
+}
+
+static inline uint16_t mavlink_msg_open_drone_id_system_get_id_or_mac(const mavlink_message_t* msg, uint8_t *id_or_mac)
+{
+    return _MAV_RETURN_uint8_t_array(msg, id_or_mac, 20, 30);
+}
+
+static inline uint8_t mavlink_msg_open_drone_id_system_get_operator_location_type(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 50);
+}
+
+static inline uint8_t mavlink_msg_open_drone_id_system_get_classification_type(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 51);
+}
+
+static inline int32_t mavlink_msg_open_drone_id_system_get_operator_latitude(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_int32_t(msg, 0);
+}
+
+static inline int32_t mavlink_msg_open_drone_id_system_get_operator_longitude(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_int32_t(msg, 4);
+}
+
+static inline uint16_t mavlink_msg_open_drone_id_system_get_area_count(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint16_t(msg, 24);
+}
+
+static inline uint16_t mavlink_msg_open_drone_id_system_get_area_radius(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint16_t(msg, 26);
+}
+
+static inline float mavlink_msg_open_drone_id_system_get_area_ceiling(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_float(msg, 8);
+}
+
+static inline float mavlink_msg_open_drone_id_system_get_area_floor(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_float(msg, 12);
+}
+
+static inline uint8_t mavlink_msg_open_drone_id_system_get_category_eu(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 52);
+}
+
+static inline uint8_t mavlink_msg_open_drone_id_system_get_class_eu(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 53);
+}
 
+static inline float mavlink_msg_open_drone_id_system_get_operator_altitude_geo(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_float(msg, 16);
+}
+
+static inline uint32_t mavlink_msg_open_drone_id_system_get_timestamp(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint32_t(msg, 20);
+}
+
+static inline void mavlink_msg_open_drone_id_system_decode(const mavlink_message_t* msg, mavlink_open_drone_id_system_t* open_drone_id_system)
+{
+    const uint8_t len = msg->len < MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_LEN ? msg->len : MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_LEN;
+    memset(open_drone_id_system, 0, MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_LEN);
+    memcpy(open_drone_id_system, _MAV_PAYLOAD(msg), len);
+}
+
+// MESSAGE OPEN_DRONE_ID_OPERATOR_ID
+
+#define MAVLINK_MSG_ID_OPEN_DRONE_ID_OPERATOR_ID 12905
+
+MAVPACKED(
 typedef struct __mavlink_open_drone_id_operator_id_t {
     uint8_t target_system;
     uint8_t target_component;
     uint8_t id_or_mac[20];
     uint8_t operator_id_type;
     char operator_id[20];
-} mavlink_open_drone_id_operator_id_t;
+}) mavlink_open_drone_id_operator_id_t;
+
+#define MAVLINK_MSG_ID_OPEN_DRONE_ID_OPERATOR_ID_LEN 43
+#define MAVLINK_MSG_ID_OPEN_DRONE_ID_OPERATOR_ID_MIN_LEN 43
+#define MAVLINK_MSG_ID_12905_LEN 43
+#define MAVLINK_MSG_ID_12905_MIN_LEN 43
+#define MAVLINK_MSG_ID_OPEN_DRONE_ID_OPERATOR_ID_CRC 49
+#define MAVLINK_MSG_ID_12905_CRC 49
+#define MAVLINK_MSG_OPEN_DRONE_ID_OPERATOR_ID_FIELD_ID_OR_MAC_LEN 20
+#define MAVLINK_MSG_OPEN_DRONE_ID_OPERATOR_ID_FIELD_OPERATOR_ID_LEN 20
+static_assert(sizeof(mavlink_open_drone_id_operator_id_t) == MAVLINK_MSG_ID_OPEN_DRONE_ID_OPERATOR_ID_LEN, "open_drone_id_operator_id wire size");
+
+static inline uint16_t mavlink_msg_open_drone_id_operator_id_pack(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg, uint8_t target_system, uint8_t target_component, const uint8_t *id_or_mac, uint8_t operator_id_type, const char *operator_id)
+{
+    mavlink_open_drone_id_operator_id_t packet;
+    packet.target_system = target_system;
+    packet.target_component = target_component;
+    mav_array_memcpy(packet.id_or_mac, id_or_mac, sizeof(uint8_t)*20);
+    packet.operator_id_type = operator_id_type;
+    mav_array_assign_char(packet.operator_id, operator_id, 20);
+    memcpy(_MAV_PAYLOAD_NON_CONST(msg), &packet, MAVLINK_MSG_ID_OPEN_DRONE_ID_OPERATOR_ID_LEN);
+    msg->msgid = MAVLINK_MSG_ID_OPEN_DRONE_ID_OPERATOR_ID;
+    return mavlink_finalize_message(msg, system_id, component_id, MAVLINK_MSG_ID_OPEN_DRONE_ID_OPERATOR_ID_MIN_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_OPERATOR_ID_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_OPERATOR_ID_CRC);
+}
+
+static inline uint16_t mavlink_msg_open_drone_id_operator_id_encode(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg, const mavlink_open_drone_id_operator_id_t* open_drone_id_operator_id)
+{
+    memcpy(_MAV_PAYLOAD_NON_CONST(msg), open_drone_id_operator_id, MAVLINK_MSG_ID_OPEN_DRONE_ID_OPERATOR_ID_LEN);
+    msg->msgid = MAVLINK_MSG_ID_OPEN_DRONE_ID_OPERATOR_ID;
+    return mavlink_finalize_message(msg, system_id, component_id, MAVLINK_MSG_ID_OPEN_DRONE_ID_OPERATOR_ID_MIN_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_OPERATOR_ID_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_OPERATOR_ID_CRC);
+}
+
+#ifdef MAVLINK_USE_CONVENIENCE_FUNCTIONS
+
+static inline void mavlink_msg_open_drone_id_operator_id_send(mavlink_channel_t chan, uint8_t target_system, uint8_t target_component, const uint8_t *id_or_mac, uint8_t operator_id_type, const char *operator_id)
+{
+    mavlink_open_drone_id_operator_id_t packet;
+    packet.target_system = target_system;
+    packet.target_component = target_component;
+    mav_array_memcpy(packet.id_or_mac, id_or_mac, sizeof(uint8_t)*20);
+    packet.operator_id_type = operator_id_type;
+    mav_array_assign_char(packet.operator_id, operator_id, 20);
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_OPEN_DRONE_ID_OPERATOR_ID, (const char *)&packet, MAVLINK_MSG_ID_OPEN_DRONE_ID_OPERATOR_ID_MIN_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_OPERATOR_ID_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_OPERATOR_ID_CRC);
+}
+
+static inline void mavlink_msg_open_drone_id_operator_id_send_struct(mavlink_channel_t chan, const mavlink_open_drone_id_operator_id_t* open_drone_id_operator_id)
+{
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_OPEN_DRONE_ID_OPERATOR_ID, (const char *)open_drone_id_operator_id, MAVLINK_MSG_ID_OPEN_DRONE_ID_OPERATOR_ID_MIN_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_OPERATOR_ID_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_OPERATOR_ID_CRC);
+}
+
+#endif // MAVLINK_USE_CONVENIENCE_FUNCTIONS
+
+static inline uint8_t mavlink_msg_open_drone_id_operator_id_get_target_system(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 0);
+}
+
+static inline uint8_t mavlink_msg_open_drone_id_operator_id_get_target_component(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 1);
+}
+
+static inline uint16_t mavlink_msg_open_drone_id_operator_id_get_id_or_mac(const mavlink_message_t* msg, uint8_t *id_or_mac)
+{
+    return _MAV_RETURN_uint8_t_array(msg, id_or_mac, 20, 2);
+}
+
+static inline uint8_t mavlink_msg_open_drone_id_operator_id_get_operator_id_type(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 22);
+}
+
+static inline uint16_t mavlink_msg_open_drone_id_operator_id_get_operator_id(const mavlink_message_t* msg, char *operator_id)
+{
+    return _MAV_RETURN_char_array(msg, operator_id, 20, 23);
+}
+
+static inline void mavlink_msg_open_drone_id_operator_id_decode(const mavlink_message_t* msg, mavlink_open_drone_id_operator_id_t* open_drone_id_operator_id)
+{
+    const uint8_t len = msg->len < MAVLINK_MSG_ID_OPEN_DRONE_ID_OPERATOR_ID_LEN ? msg->len : MAVLINK_MSG_ID_OPEN_DRONE_ID_OPERATOR_ID_LEN;
+    memset(open_drone_id_operator_id, 0, MAVLINK_MSG_ID_OPEN_DRONE_ID_OPERATOR_ID_LEN);
+    memcpy(open_drone_id_operator_id, _MAV_PAYLOAD(msg), len);
+}
 
+// MESSAGE OPEN_DRONE_ID_MESSAGE_PACK
+
+#define MAVLINK_MSG_ID_OPEN_DRONE_ID_MESSAGE_PACK 12915
+
+MAVPACKED(
 typedef struct __mavlink_open_drone_id_message_pack_t {
     uint8_t target_system;
     uint8_t target_component;
@@ -126,203 +1599,264 @@ typedef struct __mavlink_open_drone_id_message_pack_t {
     uint8_t single_message_size;
     uint8_t msg_pack_size;
     uint8_t messages[225];
-} mavlink_open_drone_id_message_pack_t;
+}) mavlink_open_drone_id_message_pack_t;
 
-typedef struct __mavlink_open_drone_id_arm_status_t {
-    uint8_t status;
-    char error[50];
-} mavlink_open_drone_id_arm_status_t;
+#define MAVLINK_MSG_ID_OPEN_DRONE_ID_MESSAGE_PACK_LEN 249
+#define MAVLINK_MSG_ID_OPEN_DRONE_ID_MESSAGE_PACK_MIN_LEN 249
+#define MAVLINK_MSG_ID_12915_LEN 249
+#define MAVLINK_MSG_ID_12915_MIN_LEN 249
+#define MAVLINK_MSG_ID_OPEN_DRONE_ID_MESSAGE_PACK_CRC 94
+#define MAVLINK_MSG_ID_12915_CRC 94
+#define MAVLINK_MSG_OPEN_DRONE_ID_MESSAGE_PACK_FIELD_ID_OR_MAC_LEN 20
+#define MAVLINK_MSG_OPEN_DRONE_ID_MESSAGE_PACK_FIELD_MESSAGES_LEN 225
+static_assert(sizeof(mavlink_open_drone_id_message_pack_t) == MAVLINK_MSG_ID_OPEN_DRONE_ID_MESSAGE_PACK_LEN, "open_drone_id_message_pack wire size");
 
-typedef struct __mavlink_open_drone_id_basic_id_t {
-    uint8_t target_system;
-    uint8_t target_component;
-    uint8_t id_or_mac[20];
-    uint8_t id_type;
-    uint8_t ua_type;
-    char uas_id[20];
-} mavlink_open_drone_id_basic_id_t;
+static inline uint16_t mavlink_msg_open_drone_id_message_pack_pack(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg, uint8_t target_system, uint8_t target_component, const uint8_t *id_or_mac, uint8_t single_message_size, uint8_t msg_pack_size, const uint8_t *messages)
+{
+    mavlink_open_drone_id_message_pack_t packet;
+    packet.target_system = target_system;
+    packet.target_component = target_component;
+    mav_array_memcpy(packet.id_or_mac, id_or_mac, sizeof(uint8_t)*20);
+    packet.single_message_size = single_message_size;
+    packet.msg_pack_size = msg_pack_size;
+    mav_array_memcpy(packet.messages, messages, sizeof(uint8_t)*225);
+    memcpy(_MAV_PAYLOAD_NON_CONST(msg), &packet, MAVLINK_MSG_ID_OPEN_DRONE_ID_MESSAGE_PACK_LEN);
+    msg->msgid = MAVLINK_MSG_ID_OPEN_DRONE_ID_MESSAGE_PACK;
+    return mavlink_finalize_message(msg, system_id, component_id, MAVLINK_MSG_ID_OPEN_DRONE_ID_MESSAGE_PACK_MIN_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_MESSAGE_PACK_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_MESSAGE_PACK_CRC);
+}
 
-typedef struct __mavlink_open_drone_id_system_update_t {
-    uint8_t target_system;
-    uint8_t target_component;
-    uint8_t id_or_mac[20];
-    int32_t operator_latitude;
-    int32_t operator_longitude;
-    float operator_altitude_geo;
-    uint32_t timestamp;
-} mavlink_open_drone_id_system_update_t;
+static inline uint16_t mavlink_msg_open_drone_id_message_pack_encode(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg, const mavlink_open_drone_id_message_pack_t* open_drone_id_message_pack)
+{
+    memcpy(_MAV_PAYLOAD_NON_CONST(msg), open_drone_id_message_pack, MAVLINK_MSG_ID_OPEN_DRONE_ID_MESSAGE_PACK_LEN);
+    msg->msgid = MAVLINK_MSG_ID_OPEN_DRONE_ID_MESSAGE_PACK;
+    return mavlink_finalize_message(msg, system_id, component_id, MAVLINK_MSG_ID_OPEN_DRONE_ID_MESSAGE_PACK_MIN_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_MESSAGE_PACK_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_MESSAGE_PACK_CRC);
+}
 
-// Function stubs for all OpenDroneID messages
-static inline void mavlink_msg_open_drone_id_location_send(mavlink_channel_t chan, uint8_t target_system, uint8_t target_component, const uint8_t *id_or_mac, uint8_t status, uint16_t direction, uint16_t speed_horizontal, int16_t speed_vertical, int32_t latitude, int32_t longitude, float altitude_barometric, float altitude_geodetic, uint16_t height, uint16_t horizontal_accuracy, uint16_t vertical_accuracy, uint16_t barometer_accuracy, uint16_t speed_accuracy, uint64_t timestamp) {
-    // Stub implementation
+#ifdef MAVLINK_USE_CONVENIENCE_FUNCTIONS
+
+static inline void mavlink_msg_open_drone_id_message_pack_send(mavlink_channel_t chan, uint8_t target_system, uint8_t target_component, const uint8_t *id_or_mac, uint8_t single_message_size, uint8_t msg_pack_size, const uint8_t *messages)
+{
+    mavlink_open_drone_id_message_pack_t packet;
+    packet.target_system = target_system;
+    packet.target_component = target_component;
+    mav_array_memcpy(packet.id_or_mac, id_or_mac, sizeof(uint8_t)*20);
+    packet.single_message_size = single_message_size;
+    packet.msg_pack_size = msg_pack_size;
+    mav_array_memcpy(packet.messages, messages, sizeof(uint8_t)*225);
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_OPEN_DRONE_ID_MESSAGE_PACK, (const char *)&packet, MAVLINK_MSG_ID_OPEN_DRONE_ID_MESSAGE_PACK_MIN_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_MESSAGE_PACK_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_MESSAGE_PACK_CRC);
 }
 
-static inline void mavlink_msg_open_drone_id_authentication_send(mavlink_channel_t chan, uint8_t target_system, uint8_t target_component, const uint8_t *id_or_mac, uint8_t authentication_type, uint8_t data_page, uint8_t last_page_index, uint8_t length, uint32_t timestamp, const uint8_t *authentication_data) {
-    // Stub implementation
+static inline void mavlink_msg_open_drone_id_message_pack_send_struct(mavlink_channel_t chan, const mavlink_open_drone_id_message_pack_t* open_drone_id_message_pack)
+{
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_OPEN_DRONE_ID_MESSAGE_PACK, (const char *)open_drone_id_message_pack, MAVLINK_MSG_ID_OPEN_DRONE_ID_MESSAGE_PACK_MIN_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_MESSAGE_PACK_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_MESSAGE_PACK_CRC);
 }
 
-static inline void mavlink_msg_open_drone_id_self_id_send(mavlink_channel_t chan, uint8_t target_system, uint8_t target_component, const uint8_t *id_or_mac, uint8_t description_type, const char *description) {
-    // Stub implementation
+#endif // MAVLINK_USE_CONVENIENCE_FUNCTIONS
+
+static inline uint8_t mavlink_msg_open_drone_id_message_pack_get_target_system(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 0);
 }
 
-static inline void mavlink_msg_open_drone_id_system_send(mavlink_channel_t chan, uint8_t target_system, uint8_t target_component, const uint8_t *id_or_mac, uint8_t operator_location_type, uint8_t classification_type, int32_t operator_latitude, int32_t operator_longitude, uint16_t area_count, uint16_t area_radius, float area_ceiling, float area_floor, uint8_t category_eu, uint8_t class_eu, float operator_altitude_geo, uint32_t timestamp) {
-    // Stub implementation
+static inline uint8_t mavlink_msg_open_drone_id_message_pack_get_target_component(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 1);
 }
 
-static inline void mavlink_msg_open_drone_id_operator_id_send(mavlink_channel_t chan, uint8_t target_system, uint8_t target_component, const uint8_t *id_or_mac, uint8_t operator_id_type, const char *operator_id) {
-    // Stub implementation
+static inline uint16_t mavlink_msg_open_drone_id_message_pack_get_id_or_mac(const mavlink_message_t* msg, uint8_t *id_or_mac)
+{
+    return _MAV_RETURN_uint8_t_array(msg, id_or_mac, 20, 2);
 }
 
-static inline void mavlink_msg_open_drone_id_message_pack_send(mavlink_channel_t chan, uint8_t target_system, uint8_t target_component, const uint8_t *id_or_mac, uint8_t single_message_size, uint8_t msg_pack_size, const uint8_t *messages) {
-    // Stub implementation
+static inline uint8_t mavlink_msg_open_drone_id_message_pack_get_single_message_size(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 22);
 }
 
-static inline void mavlink_msg_open_drone_id_arm_status_send(mavlink_channel_t chan, uint8_t status, const char *error) {
-    // Stub implementation
+static inline uint8_t mavlink_msg_open_drone_id_message_pack_get_msg_pack_size(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 23);
 }
 
-// OpenDroneID decode functions (stubs)
-static inline void mavlink_msg_open_drone_id_location_decode(const mavlink_message_t* msg, mavlink_open_drone_id_location_t* location) {
-    // Stub implementation
+static inline uint16_t mavlink_msg_open_drone_id_message_pack_get_messages(const mavlink_message_t* msg, uint8_t *messages)
+{
+    return _MAV_RETURN_uint8_t_array(msg, messages, 225, 24);
 }
 
-static inline void mavlink_msg_open_drone_id_authentication_decode(const mavlink_message_t* msg, mavlink_open_drone_id_authentication_t* authentication) {
-    // Stub implementation
+static inline void mavlink_msg_open_drone_id_message_pack_decode(const mavlink_message_t* msg, mavlink_open_drone_id_message_pack_t* open_drone_id_message_pack)
+{
+    const uint8_t len = msg->len < MAVLINK_MSG_ID_OPEN_DRONE_ID_MESSAGE_PACK_LEN ? msg->len : MAVLINK_MSG_ID_OPEN_DRONE_ID_MESSAGE_PACK_LEN;
+    memset(open_drone_id_message_pack, 0, MAVLINK_MSG_ID_OPEN_DRONE_ID_MESSAGE_PACK_LEN);
+    memcpy(open_drone_id_message_pack, _MAV_PAYLOAD(msg), len);
 }
 
-static inline void mavlink_msg_open_drone_id_self_id_decode(const mavlink_message_t* msg, mavlink_open_drone_id_self_id_t* self_id) {
-    // Stub implementation
+// MESSAGE OPEN_DRONE_ID_ARM_STATUS
+
+#define MAVLINK_MSG_ID_OPEN_DRONE_ID_ARM_STATUS 12918
+
+MAVPACKED(
+typedef struct __mavlink_open_drone_id_arm_status_t {
+    uint8_t status;
+    char error[50];
+}) mavlink_open_drone_id_arm_status_t;
+
+#define MAVLINK_MSG_ID_OPEN_DRONE_ID_ARM_STATUS_LEN 51
+#define MAVLINK_MSG_ID_OPEN_DRONE_ID_ARM_STATUS_MIN_LEN 51
+#define MAVLINK_MSG_ID_12918_LEN 51
+#define MAVLINK_MSG_ID_12918_MIN_LEN 51
+#define MAVLINK_MSG_ID_OPEN_DRONE_ID_ARM_STATUS_CRC 139
+#define MAVLINK_MSG_ID_12918_CRC 139
+#define MAVLINK_MSG_OPEN_DRONE_ID_ARM_STATUS_FIELD_ERROR_LEN 50
+static_assert(sizeof(mavlink_open_drone_id_arm_status_t) == MAVLINK_MSG_ID_OPEN_DRONE_ID_ARM_STATUS_LEN, "open_drone_id_arm_status wire size");
+
+static inline uint16_t mavlink_msg_open_drone_id_arm_status_pack(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg, uint8_t status, const char *error)
+{
+    mavlink_open_drone_id_arm_status_t packet;
+    packet.status = status;
+    mav_array_assign_char(packet.error, error, 50);
+    memcpy(_MAV_PAYLOAD_NON_CONST(msg), &packet, MAVLINK_MSG_ID_OPEN_DRONE_ID_ARM_STATUS_LEN);
+    msg->msgid = MAVLINK_MSG_ID_OPEN_DRONE_ID_ARM_STATUS;
+    return mavlink_finalize_message(msg, system_id, component_id, MAVLINK_MSG_ID_OPEN_DRONE_ID_ARM_STATUS_MIN_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_ARM_STATUS_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_ARM_STATUS_CRC);
 }
 
-static inline void mavlink_msg_open_drone_id_system_decode(const mavlink_message_t* msg, mavlink_open_drone_id_system_t* system) {
-    // Stub implementation
+static inline uint16_t mavlink_msg_open_drone_id_arm_status_encode(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg, const mavlink_open_drone_id_arm_status_t* open_drone_id_arm_status)
+{
+    memcpy(_MAV_PAYLOAD_NON_CONST(msg), open_drone_id_arm_status, MAVLINK_MSG_ID_OPEN_DRONE_ID_ARM_STATUS_LEN);
+    msg->msgid = MAVLINK_MSG_ID_OPEN_DRONE_ID_ARM_STATUS;
+    return mavlink_finalize_message(msg, system_id, component_id, MAVLINK_MSG_ID_OPEN_DRONE_ID_ARM_STATUS_MIN_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_ARM_STATUS_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_ARM_STATUS_CRC);
 }
 
-static inline void mavlink_msg_open_drone_id_operator_id_decode(const mavlink_message_t* msg, mavlink_open_drone_id_operator_id_t* operator_id) {
-    // Stub implementation
+#ifdef MAVLINK_USE_CONVENIENCE_FUNCTIONS
+
+static inline void mavlink_msg_open_drone_id_arm_status_send(mavlink_channel_t chan, uint8_t status, const char *error)
+{
+    mavlink_open_drone_id_arm_status_t packet;
+    packet.status = status;
+    mav_array_assign_char(packet.error, error, 50);
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_OPEN_DRONE_ID_ARM_STATUS, (const char *)&packet, MAVLINK_MSG_ID_OPEN_DRONE_ID_ARM_STATUS_MIN_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_ARM_STATUS_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_ARM_STATUS_CRC);
 }
 
-static inline void mavlink_msg_open_drone_id_basic_id_decode(const mavlink_message_t* msg, mavlink_open_drone_id_basic_id_t* basic_id) {
-    // Stub implementation
+static inline void mavlink_msg_open_drone_id_arm_status_send_struct(mavlink_channel_t chan, const mavlink_open_drone_id_arm_status_t* open_drone_id_arm_status)
+{
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_OPEN_DRONE_ID_ARM_STATUS, (const char *)open_drone_id_arm_status, MAVLINK_MSG_ID_OPEN_DRONE_ID_ARM_STATUS_MIN_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_ARM_STATUS_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_ARM_STATUS_CRC);
 }
 
-static inline void mavlink_msg_open_drone_id_system_update_decode(const mavlink_message_t* msg, mavlink_open_drone_id_system_update_t* system_update) {
-    // Stub implementation
+#endif // MAVLINK_USE_CONVENIENCE_FUNCTIONS
+
+static inline uint8_t mavlink_msg_open_drone_id_arm_status_get_status(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 0);
 }
 
-// Secure command message structure
-typedef struct __mavlink_secure_command_t {
-    uint8_t target_system;
-    uint8_t target_component;
-    uint32_t sequence;
-    uint32_t command;
-    uint32_t operation;
-    uint8_t sig_length;
-    uint8_t data[220];
-    uint8_t data_length;
-} mavlink_secure_command_t;
+static inline uint16_t mavlink_msg_open_drone_id_arm_status_get_error(const mavlink_message_t* msg, char *error)
+{
+    return _MAV_RETURN_char_array(msg, error, 50, 1);
+}
 
-// Secure command reply structure
-typedef struct __mavlink_secure_command_reply_t {
-    uint32_t sequence;
-    uint32_t operation;
-    uint8_t result;
-    uint8_t data[220];
-    uint8_t data_length;
-} mavlink_secure_command_reply_t;
+static inline void mavlink_msg_open_drone_id_arm_status_decode(const mavlink_message_t* msg, mavlink_open_drone_id_arm_status_t* open_drone_id_arm_status)
+{
+    const uint8_t len = msg->len < MAVLINK_MSG_ID_OPEN_DRONE_ID_ARM_STATUS_LEN ? msg->len : MAVLINK_MSG_ID_OPEN_DRONE_ID_ARM_STATUS_LEN;
+    memset(open_drone_id_arm_status, 0, MAVLINK_MSG_ID_OPEN_DRONE_ID_ARM_STATUS_LEN);
+    memcpy(open_drone_id_arm_status, _MAV_PAYLOAD(msg), len);
+}
 
-// MAVLink result constants
-#define MAV_RESULT_ACCEPTED 0
-#define MAV_RESULT_FAILED 4
-#define MAV_RESULT_DENIED 6
-#define MAV_RESULT_UNSUPPORTED 3
+// MESSAGE OPEN_DRONE_ID_SYSTEM_UPDATE
 
-// MAVLink severity constants
-#define MAV_SEVERITY_INFO 6
-#define MAV_SEVERITY_ERROR 3
+#define MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_UPDATE 12919
 
-// MAVLink parameter types
-#define MAV_PARAM_TYPE_REAL32 9
+MAVPACKED(
+typedef struct __mavlink_open_drone_id_system_update_t {
+    int32_t operator_latitude;
+    int32_t operator_longitude;
+    float operator_altitude_geo;
+    uint32_t timestamp;
+    uint8_t target_system;
+    uint8_t target_component;
+}) mavlink_open_drone_id_system_update_t;
 
-// Secure command types
-#define SECURE_COMMAND_GET_PUBLIC_KEYS 1
-#define SECURE_COMMAND_SET_PUBLIC_KEYS 2
-#define SECURE_COMMAND_REMOVE_PUBLIC_KEYS 3
-#define SECURE_COMMAND_SET_REMOTEID_CONFIG 4
-#define SECURE_COMMAND_GET_SESSION_KEY 5
-#define SECURE_COMMAND_GET_REMOTEID_SESSION_KEY 6
+#define MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_UPDATE_LEN 18
+#define MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_UPDATE_MIN_LEN 18
+#define MAVLINK_MSG_ID_12919_LEN 18
+#define MAVLINK_MSG_ID_12919_MIN_LEN 18
+#define MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_UPDATE_CRC 7
+#define MAVLINK_MSG_ID_12919_CRC 7
+static_assert(sizeof(mavlink_open_drone_id_system_update_t) == MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_UPDATE_LEN, "open_drone_id_system_update wire size");
 
-// Secure command functions (stubs)
-static inline void mavlink_msg_secure_command_decode(const mavlink_message_t* msg, mavlink_secure_command_t* secure_command) {
-    // Stub implementation
+static inline uint16_t mavlink_msg_open_drone_id_system_update_pack(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg, uint8_t target_system, uint8_t target_component, int32_t operator_latitude, int32_t operator_longitude, float operator_altitude_geo, uint32_t timestamp)
+{
+    mavlink_open_drone_id_system_update_t packet;
+    packet.target_system = target_system;
+    packet.target_component = target_component;
+    packet.operator_latitude = operator_latitude;
+    packet.operator_longitude = operator_longitude;
+    packet.operator_altitude_geo = operator_altitude_geo;
+    packet.timestamp = timestamp;
+    memcpy(_MAV_PAYLOAD_NON_CONST(msg), &packet, MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_UPDATE_LEN);
+    msg->msgid = MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_UPDATE;
+    return mavlink_finalize_message(msg, system_id, component_id, MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_UPDATE_MIN_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_UPDATE_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_UPDATE_CRC);
 }
 
-static inline void mavlink_msg_secure_command_send(mavlink_channel_t chan, uint8_t target_system, uint8_t target_component, uint32_t sequence, uint32_t command, const uint8_t *data) {
-    // Stub implementation
+static inline uint16_t mavlink_msg_open_drone_id_system_update_encode(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg, const mavlink_open_drone_id_system_update_t* open_drone_id_system_update)
+{
+    memcpy(_MAV_PAYLOAD_NON_CONST(msg), open_drone_id_system_update, MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_UPDATE_LEN);
+    msg->msgid = MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_UPDATE;
+    return mavlink_finalize_message(msg, system_id, component_id, MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_UPDATE_MIN_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_UPDATE_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_UPDATE_CRC);
 }
 
-static inline void mavlink_msg_secure_command_reply_send_struct(mavlink_channel_t chan, const mavlink_secure_command_reply_t* reply) {
-    // Stub implementation
-}
+#ifdef MAVLINK_USE_CONVENIENCE_FUNCTIONS
 
-// Printf function stub
-static inline void mav_printf(uint8_t severity, const char* format, ...) {
-    // Stub implementation - could forward to Serial.printf in real implementation
+static inline void mavlink_msg_open_drone_id_system_update_send(mavlink_channel_t chan, uint8_t target_system, uint8_t target_component, int32_t operator_latitude, int32_t operator_longitude, float operator_altitude_geo, uint32_t timestamp)
+{
+    mavlink_open_drone_id_system_update_t packet;
+    packet.target_system = target_system;
+    packet.target_component = target_component;
+    packet.operator_latitude = operator_latitude;
+    packet.operator_longitude = operator_longitude;
+    packet.operator_altitude_geo = operator_altitude_geo;
+    packet.timestamp = timestamp;
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_UPDATE, (const char *)&packet, MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_UPDATE_MIN_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_UPDATE_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_UPDATE_CRC);
 }
 
-// Parameter value message
-static inline void mavlink_msg_param_value_send(mavlink_channel_t chan, const char* param_id, float param_value, uint8_t param_type, uint16_t param_count, uint16_t param_index) {
-    // Stub implementation
+static inline void mavlink_msg_open_drone_id_system_update_send_struct(mavlink_channel_t chan, const mavlink_open_drone_id_system_update_t* open_drone_id_system_update)
+{
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_UPDATE, (const char *)open_drone_id_system_update, MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_UPDATE_MIN_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_UPDATE_LEN, MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_UPDATE_CRC);
 }
 
-// Parameter set message structure
-typedef struct __mavlink_param_set_t {
-    uint8_t target_system;
-    uint8_t target_component;
-    char param_id[16];
-    float param_value;
-    uint8_t param_type;
-} mavlink_param_set_t;
+#endif // MAVLINK_USE_CONVENIENCE_FUNCTIONS
 
-// Parameter set decode function
-static inline void mavlink_msg_param_set_decode(const mavlink_message_t* msg, mavlink_param_set_t* param_set) {
-    // Stub implementation
+static inline uint8_t mavlink_msg_open_drone_id_system_update_get_target_system(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 16);
 }
 
-// Parameter request read message structure
-typedef struct __mavlink_param_request_read_t {
-    uint8_t target_system;
-    uint8_t target_component;
-    char param_id[16];
-    int16_t param_index;
-} mavlink_param_request_read_t;
+static inline uint8_t mavlink_msg_open_drone_id_system_update_get_target_component(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint8_t(msg, 17);
+}
 
-// Parameter request read decode function
-static inline void mavlink_msg_param_request_read_decode(const mavlink_message_t* msg, mavlink_param_request_read_t* param_request_read) {
-    // Stub implementation
+static inline int32_t mavlink_msg_open_drone_id_system_update_get_operator_latitude(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_int32_t(msg, 0);
 }
 
-// Heartbeat message structure
-typedef struct __mavlink_heartbeat_t {
-    uint8_t type;
-    uint8_t autopilot;
-    uint8_t base_mode;
-    uint32_t custom_mode;
-    uint8_t system_status;
-    uint8_t mavlink_version;
-} mavlink_heartbeat_t;
+static inline int32_t mavlink_msg_open_drone_id_system_update_get_operator_longitude(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_int32_t(msg, 4);
+}
 
-// Heartbeat decode function
-static inline void mavlink_msg_heartbeat_decode(const mavlink_message_t* msg, mavlink_heartbeat_t* heartbeat) {
-    // Stub implementation
+static inline float mavlink_msg_open_drone_id_system_update_get_operator_altitude_geo(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_float(msg, 8);
 }
 
-// Heartbeat send function
-static inline void mavlink_msg_heartbeat_send(mavlink_channel_t chan, uint8_t type, uint8_t autopilot, uint8_t base_mode, uint32_t custom_mode, uint8_t system_status) {
-    // Stub implementation
+static inline uint32_t mavlink_msg_open_drone_id_system_update_get_timestamp(const mavlink_message_t* msg)
+{
+    return _MAV_RETURN_uint32_t(msg, 12);
 }
 
-// Status text send function
-static inline void mavlink_msg_statustext_send(mavlink_channel_t chan, uint8_t severity, const char* text, uint16_t id, uint8_t chunk_seq) {
-    // Stub implementation - extended signature for compatibility
+static inline void mavlink_msg_open_drone_id_system_update_decode(const mavlink_message_t* msg, mavlink_open_drone_id_system_update_t* open_drone_id_system_update)
+{
+    const uint8_t len = msg->len < MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_UPDATE_LEN ? msg->len : MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_UPDATE_LEN;
+    memset(open_drone_id_system_update, 0, MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM_UPDATE_LEN);
+    memcpy(open_drone_id_system_update, _MAV_PAYLOAD(msg), len);
 }
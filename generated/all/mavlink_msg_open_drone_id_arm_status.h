@@ -1,39 +0,0 @@
-/*
- * MAVLink OpenDroneID Arm Status message for OndOcean RemoteID
- * Simplified version for compilation
- */
-
-#pragma once
-
-#include "../mavlink_types.h"
-#include "../mavlink_helpers.h"
-
-// OpenDroneID Arm Status message ID
-#define MAVLINK_MSG_ID_OPEN_DRONE_ID_ARM_STATUS 12918
-
-// Message structure (stub)
-typedef struct __mavlink_open_drone_id_arm_status_t {
-    uint8_t status;
-    char error[50];
-} mavlink_open_drone_id_arm_status_t;
-
-// Function stubs for compilation
-static inline uint16_t mavlink_msg_open_drone_id_arm_status_pack(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg, uint8_t status, const char* error) {
-    return 0; // Stub implementation
-}
-
-static inline uint16_t mavlink_msg_open_drone_id_arm_status_encode(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg, const mavlink_open_drone_id_arm_status_t* open_drone_id_arm_status) {
-    return 0; // Stub implementation
-}
-
-static inline void mavlink_msg_open_drone_id_arm_status_send(mavlink_channel_t chan, uint8_t status, const char* error) {
-    // Stub implementation
-}
-
-static inline uint8_t mavlink_msg_open_drone_id_arm_status_get_status(const mavlink_message_t* msg) {
-    return 0; // Stub implementation
-}
-
-static inline uint16_t mavlink_msg_open_drone_id_arm_status_get_error(const mavlink_message_t* msg, char* error) {
-    return 0; // Stub implementation
-}
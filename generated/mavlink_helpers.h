@@ -1,117 +1,810 @@
 /*
  * MAVLink helpers header for OndOcean RemoteID
- * Simplified version for compilation
+ *
+ * MAVLink 1 and 2 framing for the message set in generated/all:
+ * table driven X.25 CRC, CRC extra lookup, MAVLink 2 payload
+ * truncation and optional packet signing.
  */
 
 #pragma once
 
 #include "mavlink_types.h"
+#include "mavlink_sha256.h"
 #include <stdint.h>
 #include <string.h>
 
-// MAVLink helper functions (stubs for compilation)
-static inline uint16_t mavlink_finalize_message(mavlink_message_t* msg, uint8_t system_id, uint8_t component_id, uint8_t min_length, uint8_t length, uint8_t crc_extra) {
-    return 0; // Stub implementation
+#define X25_INIT_CRC 0xffff
+
+// X.25 (CRC-16/MCRF4XX) table, one lookup per byte
+static const uint16_t mavlink_crc_table[256] = {
+    0x0000, 0x1189, 0x2312, 0x329b, 0x4624, 0x57ad, 0x6536, 0x74bf,
+    0x8c48, 0x9dc1, 0xaf5a, 0xbed3, 0xca6c, 0xdbe5, 0xe97e, 0xf8f7,
+    0x1081, 0x0108, 0x3393, 0x221a, 0x56a5, 0x472c, 0x75b7, 0x643e,
+    0x9cc9, 0x8d40, 0xbfdb, 0xae52, 0xdaed, 0xcb64, 0xf9ff, 0xe876,
+    0x2102, 0x308b, 0x0210, 0x1399, 0x6726, 0x76af, 0x4434, 0x55bd,
+    0xad4a, 0xbcc3, 0x8e58, 0x9fd1, 0xeb6e, 0xfae7, 0xc87c, 0xd9f5,
+    0x3183, 0x200a, 0x1291, 0x0318, 0x77a7, 0x662e, 0x54b5, 0x453c,
+    0xbdcb, 0xac42, 0x9ed9, 0x8f50, 0xfbef, 0xea66, 0xd8fd, 0xc974,
+    0x4204, 0x538d, 0x6116, 0x709f, 0x0420, 0x15a9, 0x2732, 0x36bb,
+    0xce4c, 0xdfc5, 0xed5e, 0xfcd7, 0x8868, 0x99e1, 0xab7a, 0xbaf3,
+    0x5285, 0x430c, 0x7197, 0x601e, 0x14a1, 0x0528, 0x37b3, 0x263a,
+    0xdecd, 0xcf44, 0xfddf, 0xec56, 0x98e9, 0x8960, 0xbbfb, 0xaa72,
+    0x6306, 0x728f, 0x4014, 0x519d, 0x2522, 0x34ab, 0x0630, 0x17b9,
+    0xef4e, 0xfec7, 0xcc5c, 0xddd5, 0xa96a, 0xb8e3, 0x8a78, 0x9bf1,
+    0x7387, 0x620e, 0x5095, 0x411c, 0x35a3, 0x242a, 0x16b1, 0x0738,
+    0xffcf, 0xee46, 0xdcdd, 0xcd54, 0xb9eb, 0xa862, 0x9af9, 0x8b70,
+    0x8408, 0x9581, 0xa71a, 0xb693, 0xc22c, 0xd3a5, 0xe13e, 0xf0b7,
+    0x0840, 0x19c9, 0x2b52, 0x3adb, 0x4e64, 0x5fed, 0x6d76, 0x7cff,
+    0x9489, 0x8500, 0xb79b, 0xa612, 0xd2ad, 0xc324, 0xf1bf, 0xe036,
+    0x18c1, 0x0948, 0x3bd3, 0x2a5a, 0x5ee5, 0x4f6c, 0x7df7, 0x6c7e,
+    0xa50a, 0xb483, 0x8618, 0x9791, 0xe32e, 0xf2a7, 0xc03c, 0xd1b5,
+    0x2942, 0x38cb, 0x0a50, 0x1bd9, 0x6f66, 0x7eef, 0x4c74, 0x5dfd,
+    0xb58b, 0xa402, 0x9699, 0x8710, 0xf3af, 0xe226, 0xd0bd, 0xc134,
+    0x39c3, 0x284a, 0x1ad1, 0x0b58, 0x7fe7, 0x6e6e, 0x5cf5, 0x4d7c,
+    0xc60c, 0xd785, 0xe51e, 0xf497, 0x8028, 0x91a1, 0xa33a, 0xb2b3,
+    0x4a44, 0x5bcd, 0x6956, 0x78df, 0x0c60, 0x1de9, 0x2f72, 0x3efb,
+    0xd68d, 0xc704, 0xf59f, 0xe416, 0x90a9, 0x8120, 0xb3bb, 0xa232,
+    0x5ac5, 0x4b4c, 0x79d7, 0x685e, 0x1ce1, 0x0d68, 0x3ff3, 0x2e7a,
+    0xe70e, 0xf687, 0xc41c, 0xd595, 0xa12a, 0xb0a3, 0x8238, 0x93b1,
+    0x6b46, 0x7acf, 0x4854, 0x59dd, 0x2d62, 0x3ceb, 0x0e70, 0x1ff9,
+    0xf78f, 0xe606, 0xd49d, 0xc514, 0xb1ab, 0xa022, 0x92b9, 0x8330,
+    0x7bc7, 0x6a4e, 0x58d5, 0x495c, 0x3de3, 0x2c6a, 0x1ef1, 0x0f78,
+};
+
+static inline void crc_accumulate(uint8_t data, uint16_t *crcAccum) {
+    *crcAccum = (*crcAccum >> 8) ^ mavlink_crc_table[(*crcAccum ^ data) & 0xff];
 }
 
-static inline uint16_t mavlink_finalize_message_chan(mavlink_message_t* msg, uint8_t system_id, uint8_t component_id, uint8_t chan, uint8_t min_length, uint8_t length, uint8_t crc_extra) {
-    return 0; // Stub implementation
+static inline void crc_init(uint16_t *crcAccum) {
+    *crcAccum = X25_INIT_CRC;
 }
 
-static inline void mavlink_start_checksum(mavlink_message_t* msg) {
-    // Stub implementation
+static inline void crc_accumulate_buffer(uint16_t *crcAccum, const char *pBuffer, uint16_t length) {
+    const uint8_t *p = (const uint8_t *)pBuffer;
+    uint16_t crc = *crcAccum;
+    while (length--) {
+        crc = (crc >> 8) ^ mavlink_crc_table[(crc ^ *p++) & 0xff];
+    }
+    *crcAccum = crc;
 }
 
-static inline void mavlink_update_checksum(mavlink_message_t* msg, uint8_t c) {
-    // Stub implementation
+static inline uint16_t crc_calculate(const uint8_t *pBuffer, uint16_t length) {
+    uint16_t crcTmp;
+    crc_init(&crcTmp);
+    crc_accumulate_buffer(&crcTmp, (const char *)pBuffer, length);
+    return crcTmp;
 }
 
-static inline uint8_t mavlink_frame_char(uint8_t chan, uint8_t c, mavlink_message_t* r_message, mavlink_status_t* r_mavlink_status) {
-    return 0; // Stub implementation
+static constexpr mavlink_msg_entry_t mavlink_message_crcs[] = MAVLINK_MESSAGE_CRCS;
+static constexpr uint32_t mavlink_message_crcs_count = sizeof(mavlink_message_crcs)/sizeof(mavlink_message_crcs[0]);
+
+// the binary search below needs the table in msgid order
+static constexpr bool mavlink_message_crcs_sorted(uint32_t i = 1) {
+    return i >= mavlink_message_crcs_count ||
+           (mavlink_message_crcs[i-1].msgid < mavlink_message_crcs[i].msgid && mavlink_message_crcs_sorted(i+1));
+}
+static_assert(mavlink_message_crcs_sorted(), "MAVLINK_MESSAGE_CRCS must be sorted by msgid");
+
+/*
+  find the CRC extra and lengths of a message, NULL if unknown
+ */
+static inline const mavlink_msg_entry_t *mavlink_get_msg_entry(uint32_t msgid) {
+    uint32_t low = 0, high = mavlink_message_crcs_count - 1;
+    while (low < high) {
+        const uint32_t mid = (low+1+high)/2;
+        if (msgid < mavlink_message_crcs[mid].msgid) {
+            high = mid-1;
+            continue;
+        }
+        if (msgid > mavlink_message_crcs[mid].msgid) {
+            low = mid;
+            continue;
+        }
+        low = mid;
+        break;
+    }
+    if (mavlink_message_crcs[low].msgid != msgid) {
+        return NULL;
+    }
+    return &mavlink_message_crcs[low];
 }
 
-// Message packing functions (stubs)
-static inline uint16_t mavlink_msg_to_send_buffer(uint8_t *buffer, const mavlink_message_t *msg) {
-    return 0; // Stub implementation
+/*
+  per channel parser state and receive buffer. These are inline rather
+  than static so every translation unit shares one instance per channel
+ */
+inline mavlink_status_t *mavlink_get_channel_status(uint8_t chan) {
+    static mavlink_status_t m_mavlink_status[MAVLINK_COMM_NUM_BUFFERS];
+    return &m_mavlink_status[chan];
+}
+
+inline mavlink_message_t *mavlink_get_channel_buffer(uint8_t chan) {
+    static mavlink_message_t m_mavlink_buffer[MAVLINK_COMM_NUM_BUFFERS];
+    return &m_mavlink_buffer[chan];
+}
+
+static inline void mavlink_reset_channel_status(uint8_t chan) {
+    mavlink_get_channel_status(chan)->parse_state = MAVLINK_PARSE_STATE_IDLE;
+}
+
+/*
+  MAVLink 2 sends the payload without its trailing zero bytes, at
+  least one byte is always sent
+ */
+static inline uint8_t _mav_trim_payload(const char *payload, uint8_t length) {
+    while (length > 1 && payload[length-1] == 0) {
+        length--;
+    }
+    return length;
 }
 
-static inline void _mav_put_uint8_t(char *buf, uint8_t wire_offset, uint8_t b) {
-    // Stub implementation
+/*
+  the 13 byte signature block of a packet: link id, 48 bit timestamp
+  and the first 48 bits of SHA-256 over key, header, payload, CRC,
+  link id and timestamp. Returns the block length, 0 if not signing
+ */
+static inline uint8_t mavlink_sign_packet(mavlink_signing_t *signing,
+                                          uint8_t signature[MAVLINK_SIGNATURE_BLOCK_LEN],
+                                          const uint8_t *header, uint8_t header_len,
+                                          const uint8_t *packet, uint8_t packet_len,
+                                          const uint8_t crc[2]) {
+    if (signing == NULL || !(signing->flags & MAVLINK_SIGNING_FLAG_SIGN_OUTGOING)) {
+        return 0;
+    }
+    signature[0] = signing->link_id;
+    const uint64_t tstamp = signing->timestamp;
+    for (uint8_t i=0; i<6; i++) {
+        signature[1+i] = uint8_t(tstamp >> (8*i));
+    }
+    signing->timestamp++;
+
+    mavlink_sha256_ctx ctx;
+    mavlink_sha256_init(&ctx);
+    mavlink_sha256_update(&ctx, signing->secret_key, sizeof(signing->secret_key));
+    mavlink_sha256_update(&ctx, header, header_len);
+    mavlink_sha256_update(&ctx, packet, packet_len);
+    mavlink_sha256_update(&ctx, crc, 2);
+    mavlink_sha256_update(&ctx, signature, 7);
+    mavlink_sha256_final_48(&ctx, &signature[7]);
+    return MAVLINK_SIGNATURE_BLOCK_LEN;
 }
 
-static inline void _mav_put_uint16_t(char *buf, uint8_t wire_offset, uint16_t b) {
-    // Stub implementation
+/*
+  check the signature of a received signed packet, and that its
+  timestamp moves forward for its stream so a replayed packet fails
+ */
+static inline bool mavlink_signature_check(mavlink_signing_t *signing,
+                                           mavlink_signing_streams_t *signing_streams,
+                                           const mavlink_message_t *msg) {
+    if (signing == NULL) {
+        return true;
+    }
+    const uint8_t *p = (const uint8_t *)&msg->magic;
+    const uint8_t *psig = msg->signature;
+    uint8_t signature[6];
+
+    mavlink_sha256_ctx ctx;
+    mavlink_sha256_init(&ctx);
+    mavlink_sha256_update(&ctx, signing->secret_key, sizeof(signing->secret_key));
+    mavlink_sha256_update(&ctx, p, MAVLINK_NUM_HEADER_BYTES);
+    mavlink_sha256_update(&ctx, _MAV_PAYLOAD(msg), msg->len);
+    mavlink_sha256_update(&ctx, msg->ck, 2);
+    mavlink_sha256_update(&ctx, psig, 7);
+    mavlink_sha256_final_48(&ctx, signature);
+    if (memcmp(signature, &psig[7], 6) != 0) {
+        return false;
+    }
+
+    // now check the timestamp
+    uint64_t tstamp = 0;
+    for (uint8_t i=0; i<6; i++) {
+        tstamp |= uint64_t(psig[1+i]) << (8*i);
+    }
+    const uint8_t link_id = psig[0];
+    if (signing_streams == NULL) {
+        return false;
+    }
+    uint16_t i;
+    for (i=0; i<signing_streams->num_signing_streams; i++) {
+        if (msg->sysid == signing_streams->stream[i].sysid &&
+            msg->compid == signing_streams->stream[i].compid &&
+            link_id == signing_streams->stream[i].link_id) {
+            break;
+        }
+    }
+    if (i == signing_streams->num_signing_streams) {
+        if (signing_streams->num_signing_streams >= MAVLINK_MAX_SIGNING_STREAMS) {
+            // over max number of streams
+            return false;
+        }
+        // new stream. Only accept if timestamp is not more than 1 minute old
+        if (tstamp + 6000UL*1000UL < signing->timestamp) {
+            return false;
+        }
+        // add new stream
+        signing_streams->stream[i].sysid = msg->sysid;
+        signing_streams->stream[i].compid = msg->compid;
+        signing_streams->stream[i].link_id = link_id;
+        signing_streams->num_signing_streams++;
+    } else {
+        uint64_t last_tstamp = 0;
+        for (uint8_t j=0; j<6; j++) {
+            last_tstamp |= uint64_t(signing_streams->stream[i].timestamp_bytes[j]) << (8*j);
+        }
+        if (tstamp <= last_tstamp) {
+            // repeating old timestamp
+            return false;
+        }
+    }
+
+    // remember last timestamp
+    memcpy(signing_streams->stream[i].timestamp_bytes, &psig[1], 6);
+
+    // our next timestamp must be at least this timestamp
+    if (tstamp > signing->timestamp) {
+        signing->timestamp = tstamp;
+    }
+    return true;
 }
 
-static inline void _mav_put_uint32_t(char *buf, uint8_t wire_offset, uint32_t b) {
-    // Stub implementation
+/*
+  fill in the header and CRC of a message whose payload is already in
+  place, trimming the MAVLink 2 payload. Returns the packet length
+ */
+static inline uint16_t mavlink_finalize_message_buffer(mavlink_message_t* msg, uint8_t system_id, uint8_t component_id,
+                                                       mavlink_status_t* status, uint8_t min_length, uint8_t length, uint8_t crc_extra) {
+    const bool mavlink1 = (status->flags & MAVLINK_STATUS_FLAG_OUT_MAVLINK1) != 0;
+    const bool signing = !mavlink1 && status->signing && (status->signing->flags & MAVLINK_SIGNING_FLAG_SIGN_OUTGOING);
+    uint8_t header_len;
+    uint8_t buf[MAVLINK_CORE_HEADER_LEN+1];
+    if (mavlink1) {
+        msg->magic = MAVLINK_STX_MAVLINK1;
+        header_len = MAVLINK_CORE_HEADER_MAVLINK1_LEN+1;
+    } else {
+        msg->magic = MAVLINK_STX;
+        header_len = MAVLINK_CORE_HEADER_LEN+1;
+    }
+    msg->len = mavlink1 ? min_length : _mav_trim_payload(_MAV_PAYLOAD(msg), length);
+    msg->sysid = system_id;
+    msg->compid = component_id;
+    msg->incompat_flags = signing ? MAVLINK_IFLAG_SIGNED : 0;
+    msg->compat_flags = 0;
+    msg->seq = status->current_tx_seq;
+    status->current_tx_seq = status->current_tx_seq + 1;
+
+    // form the header as a byte array for the crc
+    buf[0] = msg->magic;
+    buf[1] = msg->len;
+    if (mavlink1) {
+        buf[2] = msg->seq;
+        buf[3] = msg->sysid;
+        buf[4] = msg->compid;
+        buf[5] = msg->msgid & 0xFF;
+    } else {
+        buf[2] = msg->incompat_flags;
+        buf[3] = msg->compat_flags;
+        buf[4] = msg->seq;
+        buf[5] = msg->sysid;
+        buf[6] = msg->compid;
+        buf[7] = msg->msgid & 0xFF;
+        buf[8] = (msg->msgid >> 8) & 0xFF;
+        buf[9] = (msg->msgid >> 16) & 0xFF;
+    }
+
+    uint16_t checksum = crc_calculate(&buf[1], header_len-1);
+    crc_accumulate_buffer(&checksum, _MAV_PAYLOAD(msg), msg->len);
+    crc_accumulate(crc_extra, &checksum);
+    uint8_t *ck = (uint8_t *)_MAV_PAYLOAD_NON_CONST(msg) + msg->len;
+    ck[0] = (uint8_t)(checksum & 0xFF);
+    ck[1] = (uint8_t)(checksum >> 8);
+    msg->checksum = checksum;
+    msg->ck[0] = ck[0];
+    msg->ck[1] = ck[1];
+
+    uint8_t signature_len = 0;
+    if (signing) {
+        signature_len = mavlink_sign_packet(status->signing, msg->signature,
+                                            buf, header_len,
+                                            (const uint8_t *)_MAV_PAYLOAD(msg), msg->len,
+                                            ck);
+    }
+    return msg->len + header_len + 2 + signature_len;
 }
 
-static inline void _mav_put_uint64_t(char *buf, uint8_t wire_offset, uint64_t b) {
-    // Stub implementation
+static inline uint16_t mavlink_finalize_message_chan(mavlink_message_t* msg, uint8_t system_id, uint8_t component_id,
+                                                     uint8_t chan, uint8_t min_length, uint8_t length, uint8_t crc_extra) {
+    mavlink_status_t *status = mavlink_get_channel_status(chan);
+    return mavlink_finalize_message_buffer(msg, system_id, component_id, status, min_length, length, crc_extra);
 }
 
-static inline void _mav_put_int8_t(char *buf, uint8_t wire_offset, int8_t b) {
-    // Stub implementation
+static inline uint16_t mavlink_finalize_message(mavlink_message_t* msg, uint8_t system_id, uint8_t component_id,
+                                                uint8_t min_length, uint8_t length, uint8_t crc_extra) {
+    return mavlink_finalize_message_chan(msg, system_id, component_id, MAVLINK_COMM_0, min_length, length, crc_extra);
 }
 
-static inline void _mav_put_int16_t(char *buf, uint8_t wire_offset, int16_t b) {
-    // Stub implementation
+#ifdef MAVLINK_USE_CONVENIENCE_FUNCTIONS
+/*
+  frame and send a packed payload straight from the caller's buffer:
+  header, payload and CRC go out as three writes, nothing is copied.
+  MAVLINK_START_UART_SEND and MAVLINK_END_UART_SEND, when defined,
+  bracket the writes of one frame
+ */
+static inline void _mav_finalize_message_chan_send(mavlink_channel_t chan, uint32_t msgid,
+                                                   const char *packet,
+                                                   uint8_t min_length, uint8_t length, uint8_t crc_extra) {
+    mavlink_status_t *status = mavlink_get_channel_status(chan);
+    const bool mavlink1 = (status->flags & MAVLINK_STATUS_FLAG_OUT_MAVLINK1) != 0;
+    const bool signing = !mavlink1 && status->signing && (status->signing->flags & MAVLINK_SIGNING_FLAG_SIGN_OUTGOING);
+    uint8_t buf[MAVLINK_NUM_HEADER_BYTES];
+    uint8_t ck[2];
+    uint8_t signature[MAVLINK_SIGNATURE_BLOCK_LEN];
+    uint8_t header_len;
+    uint8_t signature_len = 0;
+
+    if (mavlink1) {
+        length = min_length;
+        header_len = MAVLINK_CORE_HEADER_MAVLINK1_LEN + 1;
+        buf[0] = MAVLINK_STX_MAVLINK1;
+        buf[1] = length;
+        buf[2] = status->current_tx_seq;
+        buf[3] = mavlink_system.sysid;
+        buf[4] = mavlink_system.compid;
+        buf[5] = msgid & 0xFF;
+    } else {
+        length = _mav_trim_payload(packet, length);
+        header_len = MAVLINK_NUM_HEADER_BYTES;
+        buf[0] = MAVLINK_STX;
+        buf[1] = length;
+        buf[2] = signing ? MAVLINK_IFLAG_SIGNED : 0;
+        buf[3] = 0;
+        buf[4] = status->current_tx_seq;
+        buf[5] = mavlink_system.sysid;
+        buf[6] = mavlink_system.compid;
+        buf[7] = msgid & 0xFF;
+        buf[8] = (msgid >> 8) & 0xFF;
+        buf[9] = (msgid >> 16) & 0xFF;
+    }
+    status->current_tx_seq++;
+    uint16_t checksum = crc_calculate(&buf[1], header_len-1);
+    crc_accumulate_buffer(&checksum, packet, length);
+    crc_accumulate(crc_extra, &checksum);
+    ck[0] = (uint8_t)(checksum & 0xFF);
+    ck[1] = (uint8_t)(checksum >> 8);
+
+    if (signing) {
+        signature_len = mavlink_sign_packet(status->signing, signature, buf, header_len,
+                                            (const uint8_t *)packet, length, ck);
+    }
+
+#ifdef MAVLINK_START_UART_SEND
+    MAVLINK_START_UART_SEND(chan, header_len + length + 2 + signature_len);
+#endif
+    MAVLINK_SEND_UART_BYTES(chan, buf, header_len);
+    MAVLINK_SEND_UART_BYTES(chan, (const uint8_t *)packet, length);
+    MAVLINK_SEND_UART_BYTES(chan, ck, 2);
+    if (signature_len != 0) {
+        MAVLINK_SEND_UART_BYTES(chan, signature, signature_len);
+    }
+#ifdef MAVLINK_END_UART_SEND
+    MAVLINK_END_UART_SEND(chan, header_len + length + 2 + signature_len);
+#endif
 }
+#endif // MAVLINK_USE_CONVENIENCE_FUNCTIONS
 
-static inline void _mav_put_int32_t(char *buf, uint8_t wire_offset, int32_t b) {
-    // Stub implementation
+/*
+  copy a finalized message to a contiguous buffer, which must hold
+  MAVLINK_MAX_PACKET_LEN bytes. Returns the packet length
+ */
+static inline uint16_t mavlink_msg_to_send_buffer(uint8_t *buf, const mavlink_message_t *msg) {
+    uint8_t signature_len = 0;
+    uint8_t header_len;
+    uint8_t *ck;
+    uint8_t length = msg->len;
+
+    if (msg->magic == MAVLINK_STX_MAVLINK1) {
+        header_len = MAVLINK_CORE_HEADER_MAVLINK1_LEN + 1;
+        buf[0] = msg->magic;
+        buf[1] = length;
+        buf[2] = msg->seq;
+        buf[3] = msg->sysid;
+        buf[4] = msg->compid;
+        buf[5] = msg->msgid & 0xFF;
+    } else {
+        header_len = MAVLINK_NUM_HEADER_BYTES;
+        signature_len = (msg->incompat_flags & MAVLINK_IFLAG_SIGNED) ? MAVLINK_SIGNATURE_BLOCK_LEN : 0;
+        buf[0] = msg->magic;
+        buf[1] = length;
+        buf[2] = msg->incompat_flags;
+        buf[3] = msg->compat_flags;
+        buf[4] = msg->seq;
+        buf[5] = msg->sysid;
+        buf[6] = msg->compid;
+        buf[7] = msg->msgid & 0xFF;
+        buf[8] = (msg->msgid >> 8) & 0xFF;
+        buf[9] = (msg->msgid >> 16) & 0xFF;
+    }
+    memcpy(&buf[header_len], _MAV_PAYLOAD(msg), length);
+    ck = buf + header_len + length;
+    ck[0] = (uint8_t)(msg->checksum & 0xFF);
+    ck[1] = (uint8_t)(msg->checksum >> 8);
+    if (signature_len > 0) {
+        memcpy(&ck[2], msg->signature, signature_len);
+    }
+    return header_len + length + 2 + signature_len;
 }
 
-static inline void _mav_put_int64_t(char *buf, uint8_t wire_offset, int64_t b) {
-    // Stub implementation
+static inline void mavlink_start_checksum(mavlink_message_t* msg) {
+    uint16_t crcTmp = 0;
+    crc_init(&crcTmp);
+    msg->checksum = crcTmp;
 }
 
-static inline void _mav_put_float(char *buf, uint8_t wire_offset, float b) {
-    // Stub implementation
+static inline void mavlink_update_checksum(mavlink_message_t* msg, uint8_t c) {
+    uint16_t checksum = msg->checksum;
+    crc_accumulate(c, &checksum);
+    msg->checksum = checksum;
 }
 
-static inline void _mav_put_double(char *buf, uint8_t wire_offset, double b) {
-    // Stub implementation
+/*
+  byte at a time frame parser. rxmsg and status hold the state between
+  calls; a complete frame is copied to r_message and r_mavlink_status.
+  Returns MAVLINK_FRAMING_OK for a good frame, BAD_CRC or BAD_SIGNATURE
+  for a complete frame that failed its checks
+ */
+static inline uint8_t mavlink_frame_char_buffer(mavlink_message_t* rxmsg,
+                                                mavlink_status_t* status,
+                                                uint8_t c,
+                                                mavlink_message_t* r_message,
+                                                mavlink_status_t* r_mavlink_status) {
+    status->msg_received = MAVLINK_FRAMING_INCOMPLETE;
+
+    switch (status->parse_state) {
+    case MAVLINK_PARSE_STATE_UNINIT:
+    case MAVLINK_PARSE_STATE_IDLE:
+        if (c == MAVLINK_STX) {
+            status->parse_state = MAVLINK_PARSE_STATE_GOT_STX;
+            rxmsg->len = 0;
+            rxmsg->magic = c;
+            status->flags &= ~MAVLINK_STATUS_FLAG_IN_MAVLINK1;
+            mavlink_start_checksum(rxmsg);
+        } else if (c == MAVLINK_STX_MAVLINK1) {
+            status->parse_state = MAVLINK_PARSE_STATE_GOT_STX;
+            rxmsg->len = 0;
+            rxmsg->magic = c;
+            status->flags |= MAVLINK_STATUS_FLAG_IN_MAVLINK1;
+            mavlink_start_checksum(rxmsg);
+        }
+        break;
+
+    case MAVLINK_PARSE_STATE_GOT_STX:
+        if (status->msg_received
+/* Support shorter buffers than the default maximum packet size */
+#if (MAVLINK_MAX_PAYLOAD_LEN < 255)
+            || c > MAVLINK_MAX_PAYLOAD_LEN
+#endif
+            ) {
+            status->buffer_overrun++;
+            status->parse_error++;
+            status->msg_received = 0;
+            status->parse_state = MAVLINK_PARSE_STATE_IDLE;
+        } else {
+            // NOT counting STX, LENGTH, SEQ, SYSID, COMPID, MSGID, CRC1 and CRC2
+            rxmsg->len = c;
+            status->packet_idx = 0;
+            mavlink_update_checksum(rxmsg, c);
+            if (status->flags & MAVLINK_STATUS_FLAG_IN_MAVLINK1) {
+                rxmsg->incompat_flags = 0;
+                rxmsg->compat_flags = 0;
+                status->parse_state = MAVLINK_PARSE_STATE_GOT_COMPAT_FLAGS;
+            } else {
+                status->parse_state = MAVLINK_PARSE_STATE_GOT_LENGTH;
+            }
+        }
+        break;
+
+    case MAVLINK_PARSE_STATE_GOT_LENGTH:
+        rxmsg->incompat_flags = c;
+        if ((rxmsg->incompat_flags & ~MAVLINK_IFLAG_MASK) != 0) {
+            // message includes an incompatible feature flag
+            status->parse_error++;
+            status->msg_received = 0;
+            status->parse_state = MAVLINK_PARSE_STATE_IDLE;
+            break;
+        }
+        mavlink_update_checksum(rxmsg, c);
+        status->parse_state = MAVLINK_PARSE_STATE_GOT_INCOMPAT_FLAGS;
+        break;
+
+    case MAVLINK_PARSE_STATE_GOT_INCOMPAT_FLAGS:
+        rxmsg->compat_flags = c;
+        mavlink_update_checksum(rxmsg, c);
+        status->parse_state = MAVLINK_PARSE_STATE_GOT_COMPAT_FLAGS;
+        break;
+
+    case MAVLINK_PARSE_STATE_GOT_COMPAT_FLAGS:
+        rxmsg->seq = c;
+        mavlink_update_checksum(rxmsg, c);
+        status->parse_state = MAVLINK_PARSE_STATE_GOT_SEQ;
+        break;
+
+    case MAVLINK_PARSE_STATE_GOT_SEQ:
+        rxmsg->sysid = c;
+        mavlink_update_checksum(rxmsg, c);
+        status->parse_state = MAVLINK_PARSE_STATE_GOT_SYSID;
+        break;
+
+    case MAVLINK_PARSE_STATE_GOT_SYSID:
+        rxmsg->compid = c;
+        mavlink_update_checksum(rxmsg, c);
+        status->parse_state = MAVLINK_PARSE_STATE_GOT_COMPID;
+        break;
+
+    case MAVLINK_PARSE_STATE_GOT_COMPID:
+        rxmsg->msgid = c;
+        mavlink_update_checksum(rxmsg, c);
+        if (status->flags & MAVLINK_STATUS_FLAG_IN_MAVLINK1) {
+            status->parse_state = rxmsg->len > 0 ? MAVLINK_PARSE_STATE_GOT_MSGID3 : MAVLINK_PARSE_STATE_GOT_PAYLOAD;
+        } else {
+            status->parse_state = MAVLINK_PARSE_STATE_GOT_MSGID1;
+        }
+        break;
+
+    case MAVLINK_PARSE_STATE_GOT_MSGID1:
+        rxmsg->msgid |= c<<8;
+        mavlink_update_checksum(rxmsg, c);
+        status->parse_state = MAVLINK_PARSE_STATE_GOT_MSGID2;
+        break;
+
+    case MAVLINK_PARSE_STATE_GOT_MSGID2:
+        rxmsg->msgid |= ((uint32_t)c)<<16;
+        mavlink_update_checksum(rxmsg, c);
+        status->parse_state = rxmsg->len > 0 ? MAVLINK_PARSE_STATE_GOT_MSGID3 : MAVLINK_PARSE_STATE_GOT_PAYLOAD;
+        break;
+
+    case MAVLINK_PARSE_STATE_GOT_MSGID3:
+        _MAV_PAYLOAD_NON_CONST(rxmsg)[status->packet_idx++] = (char)c;
+        mavlink_update_checksum(rxmsg, c);
+        if (status->packet_idx == rxmsg->len) {
+            status->parse_state = MAVLINK_PARSE_STATE_GOT_PAYLOAD;
+        }
+        break;
+
+    case MAVLINK_PARSE_STATE_GOT_PAYLOAD: {
+        const mavlink_msg_entry_t *e = mavlink_get_msg_entry(rxmsg->msgid);
+        const uint8_t crc_extra = e ? e->crc_extra : 0;
+        mavlink_update_checksum(rxmsg, crc_extra);
+        if (c != (rxmsg->checksum & 0xFF)) {
+            status->parse_state = MAVLINK_PARSE_STATE_GOT_BAD_CRC1;
+        } else {
+            status->parse_state = MAVLINK_PARSE_STATE_GOT_CRC1;
+        }
+        rxmsg->ck[0] = c;
+
+        // zero-fill the packet to cope with short incoming packets
+        if (e && status->packet_idx < e->max_msg_len) {
+            memset(&_MAV_PAYLOAD_NON_CONST(rxmsg)[status->packet_idx], 0, e->max_msg_len - status->packet_idx);
+        }
+        break;
+    }
+
+    case MAVLINK_PARSE_STATE_GOT_CRC1:
+    case MAVLINK_PARSE_STATE_GOT_BAD_CRC1:
+        if (status->parse_state == MAVLINK_PARSE_STATE_GOT_BAD_CRC1 || c != (rxmsg->checksum >> 8)) {
+            // got a bad CRC message
+            status->msg_received = MAVLINK_FRAMING_BAD_CRC;
+        } else {
+            // Successfully got message
+            status->msg_received = MAVLINK_FRAMING_OK;
+        }
+        rxmsg->ck[1] = c;
+
+        if (rxmsg->incompat_flags & MAVLINK_IFLAG_SIGNED) {
+            status->parse_state = MAVLINK_PARSE_STATE_SIGNATURE_WAIT;
+            status->signature_wait = MAVLINK_SIGNATURE_BLOCK_LEN;
+
+            // If the CRC is already wrong, don't overwrite msg_received,
+            // otherwise we can end up with garbage flagged as valid.
+            if (status->msg_received != MAVLINK_FRAMING_BAD_CRC) {
+                status->msg_received = MAVLINK_FRAMING_INCOMPLETE;
+            }
+        } else {
+            if (status->signing &&
+                (status->signing->accept_unsigned_callback == NULL ||
+                 !status->signing->accept_unsigned_callback(status, rxmsg->msgid))) {
+                // don't accept this packet
+                if (status->msg_received != MAVLINK_FRAMING_BAD_CRC) {
+                    status->msg_received = MAVLINK_FRAMING_BAD_SIGNATURE;
+                }
+            }
+            status->parse_state = MAVLINK_PARSE_STATE_IDLE;
+            if (r_message != NULL) {
+                memcpy(r_message, rxmsg, sizeof(mavlink_message_t));
+            }
+        }
+        break;
+
+    case MAVLINK_PARSE_STATE_SIGNATURE_WAIT:
+        rxmsg->signature[MAVLINK_SIGNATURE_BLOCK_LEN-status->signature_wait] = c;
+        status->signature_wait--;
+        if (status->signature_wait == 0) {
+            // we have the whole signature, check it is OK
+            const bool sig_ok = mavlink_signature_check(status->signing, status->signing_streams, rxmsg);
+            if (!sig_ok &&
+                status->signing->accept_unsigned_callback &&
+                status->signing->accept_unsigned_callback(status, rxmsg->msgid)) {
+                // accepted via application level override
+                status->flags &= ~MAVLINK_STATUS_FLAG_IN_BADSIG;
+                status->msg_received = MAVLINK_FRAMING_OK;
+            } else {
+                if (status->msg_received != MAVLINK_FRAMING_BAD_CRC) {
+                    status->msg_received = sig_ok ? MAVLINK_FRAMING_OK : MAVLINK_FRAMING_BAD_SIGNATURE;
+                }
+                if (sig_ok) {
+                    status->flags = (status->flags & ~MAVLINK_STATUS_FLAG_IN_BADSIG) | MAVLINK_STATUS_FLAG_IN_SIGNED;
+                } else {
+                    status->flags |= MAVLINK_STATUS_FLAG_IN_BADSIG;
+                }
+            }
+            status->parse_state = MAVLINK_PARSE_STATE_IDLE;
+            if (r_message != NULL) {
+                memcpy(r_message, rxmsg, sizeof(mavlink_message_t));
+            }
+        }
+        break;
+    }
+
+    // If a message has been successfully decoded, check index
+    if (status->msg_received == MAVLINK_FRAMING_OK) {
+        status->current_rx_seq = rxmsg->seq;
+        // Initial condition: If no packet has been received so far, drop count is undefined
+        if (status->packet_rx_success_count == 0) {
+            status->packet_rx_drop_count = 0;
+        }
+        // Count this packet as received
+        status->packet_rx_success_count++;
+    }
+
+    if (r_mavlink_status != NULL) {
+        r_mavlink_status->current_rx_seq = status->current_rx_seq+1;
+        r_mavlink_status->packet_rx_success_count = status->packet_rx_success_count;
+        r_mavlink_status->packet_rx_drop_count = status->parse_error;
+        r_mavlink_status->flags = status->flags;
+    }
+    status->parse_error = 0;
+
+    if (status->msg_received == MAVLINK_FRAMING_BAD_CRC) {
+        /*
+          the CRC came out wrong. We now need to overwrite the msg CRC
+          with the one on the wire so that if the caller decides to
+          forward the message anyway that mavlink_msg_to_send_buffer()
+          won't overwrite the checksum
+         */
+        if (r_message != NULL) {
+            r_message->checksum = rxmsg->ck[0] | (rxmsg->ck[1]<<8);
+        }
+    }
+
+    return status->msg_received;
 }
 
-// Message extraction functions (stubs)
-static inline uint8_t _MAV_RETURN_uint8_t(const mavlink_message_t *msg, uint8_t wire_offset) {
-    return 0; // Stub implementation
+static inline uint8_t mavlink_frame_char(uint8_t chan, uint8_t c, mavlink_message_t* r_message, mavlink_status_t* r_mavlink_status) {
+    return mavlink_frame_char_buffer(mavlink_get_channel_buffer(chan),
+                                     mavlink_get_channel_status(chan),
+                                     c,
+                                     r_message,
+                                     r_mavlink_status);
 }
 
-static inline uint16_t _MAV_RETURN_uint16_t(const mavlink_message_t *msg, uint8_t wire_offset) {
-    return 0; // Stub implementation
+/*
+  like mavlink_frame_char() but only reports good frames, returning 1
+  when r_message holds one
+ */
+static inline uint8_t mavlink_parse_char(uint8_t chan, uint8_t c, mavlink_message_t* r_message, mavlink_status_t* r_mavlink_status) {
+    const uint8_t msg_received = mavlink_frame_char(chan, c, r_message, r_mavlink_status);
+    if (msg_received == MAVLINK_FRAMING_BAD_CRC ||
+        msg_received == MAVLINK_FRAMING_BAD_SIGNATURE) {
+        // we got a bad CRC. Treat as a parse failure
+        mavlink_message_t* rxmsg = mavlink_get_channel_buffer(chan);
+        mavlink_status_t* status = mavlink_get_channel_status(chan);
+        status->parse_error++;
+        status->msg_received = MAVLINK_FRAMING_INCOMPLETE;
+        status->parse_state = MAVLINK_PARSE_STATE_IDLE;
+        if (c == MAVLINK_STX) {
+            status->parse_state = MAVLINK_PARSE_STATE_GOT_STX;
+            rxmsg->len = 0;
+            mavlink_start_checksum(rxmsg);
+        }
+        return 0;
+    }
+    return msg_received;
 }
 
-static inline uint32_t _MAV_RETURN_uint32_t(const mavlink_message_t *msg, uint8_t wire_offset) {
-    return 0; // Stub implementation
+/*
+  payload field access. Both the ESP32 and MAVLink are little endian,
+  so fields are copied as they are; memcpy copes with the unaligned
+  offsets of the packed wire format
+ */
+#define _MAV_PUT_FIELD(TYPE) \
+static inline void _mav_put_ ## TYPE(char *buf, uint8_t wire_offset, TYPE b) { \
+    memcpy(&buf[wire_offset], &b, sizeof(TYPE)); \
 }
 
-static inline uint64_t _MAV_RETURN_uint64_t(const mavlink_message_t *msg, uint8_t wire_offset) {
-    return 0; // Stub implementation
+_MAV_PUT_FIELD(uint8_t)
+_MAV_PUT_FIELD(int8_t)
+_MAV_PUT_FIELD(char)
+_MAV_PUT_FIELD(uint16_t)
+_MAV_PUT_FIELD(int16_t)
+_MAV_PUT_FIELD(uint32_t)
+_MAV_PUT_FIELD(int32_t)
+_MAV_PUT_FIELD(uint64_t)
+_MAV_PUT_FIELD(int64_t)
+_MAV_PUT_FIELD(float)
+_MAV_PUT_FIELD(double)
+
+/*
+  put a char array. A string shorter than the field is zero padded,
+  a NULL pointer gives an all zero field
+ */
+static inline void _mav_put_char_array(char *buf, uint8_t wire_offset, const char *b, uint8_t array_length) {
+    if (b == NULL) {
+        memset(&buf[wire_offset], 0, array_length);
+    } else {
+        strncpy(&buf[wire_offset], b, array_length);
+    }
 }
 
-static inline int8_t _MAV_RETURN_int8_t(const mavlink_message_t *msg, uint8_t wire_offset) {
-    return 0; // Stub implementation
+static inline void _mav_put_uint8_t_array(char *buf, uint8_t wire_offset, const uint8_t *b, uint8_t array_length) {
+    if (b == NULL) {
+        memset(&buf[wire_offset], 0, array_length);
+    } else {
+        memcpy(&buf[wire_offset], b, array_length);
+    }
 }
 
-static inline int16_t _MAV_RETURN_int16_t(const mavlink_message_t *msg, uint8_t wire_offset) {
-    return 0; // Stub implementation
+// array copies for the generated pack functions, same NULL handling
+static inline void mav_array_memcpy(void *dest, const void *src, size_t n) {
+    if (src == NULL) {
+        memset(dest, 0, n);
+    } else {
+        memcpy(dest, src, n);
+    }
 }
 
-static inline int32_t _MAV_RETURN_int32_t(const mavlink_message_t *msg, uint8_t wire_offset) {
-    return 0; // Stub implementation
+static inline void mav_array_assign_char(char *dest, const char *src, size_t n) {
+    if (src == NULL) {
+        memset(dest, 0, n);
+    } else {
+        strncpy(dest, src, n);
+    }
 }
 
-static inline int64_t _MAV_RETURN_int64_t(const mavlink_message_t *msg, uint8_t wire_offset) {
-    return 0; // Stub implementation
+#define _MAV_RETURN_FIELD(TYPE) \
+static inline TYPE _MAV_RETURN_ ## TYPE(const mavlink_message_t *msg, uint8_t wire_offset) { \
+    TYPE r; \
+    memcpy(&r, &_MAV_PAYLOAD(msg)[wire_offset], sizeof(TYPE)); \
+    return r; \
 }
 
-static inline float _MAV_RETURN_float(const mavlink_message_t *msg, uint8_t wire_offset) {
-    return 0.0f; // Stub implementation
+_MAV_RETURN_FIELD(uint8_t)
+_MAV_RETURN_FIELD(int8_t)
+_MAV_RETURN_FIELD(char)
+_MAV_RETURN_FIELD(uint16_t)
+_MAV_RETURN_FIELD(int16_t)
+_MAV_RETURN_FIELD(uint32_t)
+_MAV_RETURN_FIELD(int32_t)
+_MAV_RETURN_FIELD(uint64_t)
+_MAV_RETURN_FIELD(int64_t)
+_MAV_RETURN_FIELD(float)
+_MAV_RETURN_FIELD(double)
+
+static inline uint16_t _MAV_RETURN_char_array(const mavlink_message_t *msg, char *value,
+                                              uint8_t array_length, uint8_t wire_offset) {
+    memcpy(value, &_MAV_PAYLOAD(msg)[wire_offset], array_length);
+    return array_length;
 }
 
-static inline double _MAV_RETURN_double(const mavlink_message_t *msg, uint8_t wire_offset) {
-    return 0.0; // Stub implementation
+static inline uint16_t _MAV_RETURN_uint8_t_array(const mavlink_message_t *msg, uint8_t *value,
+                                                 uint8_t array_length, uint8_t wire_offset) {
+    memcpy(value, &_MAV_PAYLOAD(msg)[wire_offset], array_length);
+    return array_length;
 }
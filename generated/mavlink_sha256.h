@@ -0,0 +1,118 @@
+/*
+ * SHA-256 for MAVLink 2 packet signing
+ *
+ * Only what signing needs: the signature is the first 48 bits of
+ * SHA-256(secret_key + header + payload + CRC + link_id + timestamp)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+typedef struct {
+    uint32_t state[8];
+    uint64_t count;     // bytes hashed
+    uint8_t block[64];
+} mavlink_sha256_ctx;
+
+static const uint32_t mavlink_sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+#define MAVLINK_SHA256_ROR(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+static inline void mavlink_sha256_init(mavlink_sha256_ctx *ctx)
+{
+    static const uint32_t h0[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+    };
+    memcpy(ctx->state, h0, sizeof(h0));
+    ctx->count = 0;
+}
+
+static inline void mavlink_sha256_block(mavlink_sha256_ctx *ctx)
+{
+    uint32_t w[64];
+    for (uint8_t i=0; i<16; i++) {
+        const uint8_t *b = &ctx->block[i*4];
+        w[i] = (uint32_t(b[0])<<24) | (uint32_t(b[1])<<16) | (uint32_t(b[2])<<8) | b[3];
+    }
+    for (uint8_t i=16; i<64; i++) {
+        const uint32_t s0 = MAVLINK_SHA256_ROR(w[i-15], 7) ^ MAVLINK_SHA256_ROR(w[i-15], 18) ^ (w[i-15] >> 3);
+        const uint32_t s1 = MAVLINK_SHA256_ROR(w[i-2], 17) ^ MAVLINK_SHA256_ROR(w[i-2], 19) ^ (w[i-2] >> 10);
+        w[i] = w[i-16] + s0 + w[i-7] + s1;
+    }
+    uint32_t a = ctx->state[0], b = ctx->state[1], c = ctx->state[2], d = ctx->state[3];
+    uint32_t e = ctx->state[4], f = ctx->state[5], g = ctx->state[6], h = ctx->state[7];
+    for (uint8_t i=0; i<64; i++) {
+        const uint32_t S1 = MAVLINK_SHA256_ROR(e, 6) ^ MAVLINK_SHA256_ROR(e, 11) ^ MAVLINK_SHA256_ROR(e, 25);
+        const uint32_t ch = (e & f) ^ (~e & g);
+        const uint32_t t1 = h + S1 + ch + mavlink_sha256_k[i] + w[i];
+        const uint32_t S0 = MAVLINK_SHA256_ROR(a, 2) ^ MAVLINK_SHA256_ROR(a, 13) ^ MAVLINK_SHA256_ROR(a, 22);
+        const uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+        const uint32_t t2 = S0 + maj;
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+    ctx->state[0] += a;
+    ctx->state[1] += b;
+    ctx->state[2] += c;
+    ctx->state[3] += d;
+    ctx->state[4] += e;
+    ctx->state[5] += f;
+    ctx->state[6] += g;
+    ctx->state[7] += h;
+}
+
+static inline void mavlink_sha256_update(mavlink_sha256_ctx *ctx, const void *data, uint32_t len)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    while (len > 0) {
+        const uint32_t ofs = ctx->count & 63;
+        uint32_t n = 64 - ofs;
+        if (n > len) {
+            n = len;
+        }
+        memcpy(&ctx->block[ofs], p, n);
+        ctx->count += n;
+        p += n;
+        len -= n;
+        if ((ctx->count & 63) == 0) {
+            mavlink_sha256_block(ctx);
+        }
+    }
+}
+
+// finish the hash, giving its first 6 bytes
+static inline void mavlink_sha256_final_48(mavlink_sha256_ctx *ctx, uint8_t result[6])
+{
+    const uint64_t bits = ctx->count * 8;
+    const uint8_t pad = 0x80;
+    const uint8_t zero = 0;
+    mavlink_sha256_update(ctx, &pad, 1);
+    while ((ctx->count & 63) != 56) {
+        mavlink_sha256_update(ctx, &zero, 1);
+    }
+    uint8_t len_be[8];
+    for (uint8_t i=0; i<8; i++) {
+        len_be[i] = uint8_t(bits >> (56 - 8*i));
+    }
+    mavlink_sha256_update(ctx, len_be, 8);
+    for (uint8_t i=0; i<6; i++) {
+        result[i] = uint8_t(ctx->state[i/4] >> (24 - 8*(i%4)));
+    }
+}
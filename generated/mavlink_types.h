@@ -1,6 +1,5 @@
 /*
  * MAVLink types header for OndOcean RemoteID
- * Simplified version for compilation
  */
 
 #pragma once
@@ -9,18 +8,53 @@
 #include <stdbool.h>
 
 // MAVLink constants
+#ifndef MAVLINK_MAX_PAYLOAD_LEN
 #define MAVLINK_MAX_PAYLOAD_LEN 255
+#endif
 #define MAVLINK_CORE_HEADER_LEN 9
 #define MAVLINK_CORE_HEADER_MAVLINK1_LEN 5
 #define MAVLINK_NUM_HEADER_BYTES (MAVLINK_CORE_HEADER_LEN + 1)
 #define MAVLINK_NUM_CHECKSUM_BYTES 2
 #define MAVLINK_NUM_NON_PAYLOAD_BYTES (MAVLINK_NUM_HEADER_BYTES + MAVLINK_NUM_CHECKSUM_BYTES)
 #define MAVLINK_SIGNATURE_BLOCK_LEN 13
+#define MAVLINK_MAX_PACKET_LEN (MAVLINK_MAX_PAYLOAD_LEN + MAVLINK_NUM_NON_PAYLOAD_BYTES + MAVLINK_SIGNATURE_BLOCK_LEN)
 
 #define MAVLINK_STX 0xFD
 #define MAVLINK_STX_MAVLINK1 0xFE
 
-// Parse states (must be defined first)
+#define MAVLINK_IFLAG_SIGNED 0x01
+#define MAVLINK_IFLAG_MASK   0x01
+
+#define MAV_MSG_ENTRY_FLAG_HAVE_TARGET_SYSTEM    1
+#define MAV_MSG_ENTRY_FLAG_HAVE_TARGET_COMPONENT 2
+
+#ifndef MAVLINK_COMM_NUM_BUFFERS
+#define MAVLINK_COMM_NUM_BUFFERS 4
+#endif
+
+// wire structures have no padding
+#define MAVPACKED( __Declaration__ ) __Declaration__ __attribute__((packed))
+
+// per message CRC extra and lengths, sorted by msgid
+typedef struct __mavlink_msg_entry {
+    uint32_t msgid;
+    uint8_t crc_extra;
+    uint8_t min_msg_len;          // length without extensions
+    uint8_t max_msg_len;          // length including extensions
+    uint8_t flags;                // MAV_MSG_ENTRY_FLAG_*
+    uint8_t target_system_ofs;    // payload offset to target_system, or 0
+    uint8_t target_component_ofs; // payload offset to target_component, or 0
+} mavlink_msg_entry_t;
+
+// Channel type
+typedef enum {
+    MAVLINK_COMM_0 = 0,
+    MAVLINK_COMM_1 = 1,
+    MAVLINK_COMM_2 = 2,
+    MAVLINK_COMM_3 = 3
+} mavlink_channel_t;
+
+// Parse states
 typedef enum {
     MAVLINK_PARSE_STATE_UNINIT=0,
     MAVLINK_PARSE_STATE_IDLE,
@@ -40,7 +74,16 @@ typedef enum {
     MAVLINK_PARSE_STATE_SIGNATURE_WAIT
 } mavlink_parse_state_t;
 
+// result of feeding one byte to the frame parser
+typedef enum {
+    MAVLINK_FRAMING_INCOMPLETE=0,
+    MAVLINK_FRAMING_OK=1,
+    MAVLINK_FRAMING_BAD_CRC=2,
+    MAVLINK_FRAMING_BAD_SIGNATURE=3
+} mavlink_framing_t;
+
 // MAVLink message structure
+MAVPACKED(
 typedef struct __mavlink_message {
     uint16_t checksum;      // sent at end of packet
     uint8_t magic;          // protocol magic marker
@@ -54,7 +97,45 @@ typedef struct __mavlink_message {
     uint64_t payload64[(MAVLINK_MAX_PAYLOAD_LEN+MAVLINK_NUM_CHECKSUM_BYTES+7)/8];
     uint8_t ck[2];          // incoming checksum bytes
     uint8_t signature[MAVLINK_SIGNATURE_BLOCK_LEN];
-} mavlink_message_t;
+}) mavlink_message_t;
+
+#define _MAV_PAYLOAD(msg) ((const char *)(&((msg)->payload64[0])))
+#define _MAV_PAYLOAD_NON_CONST(msg) ((char *)(&((msg)->payload64[0])))
+
+// signing state of a link, the timestamp is in 10us units since 1/1/2015
+#define MAVLINK_SIGNING_FLAG_SIGN_OUTGOING 1
+
+typedef bool (*mavlink_accept_unsigned_t)(const struct __mavlink_status *status, uint32_t msgid);
+
+typedef struct __mavlink_signing {
+    uint8_t flags;                  // MAVLINK_SIGNING_FLAG_*
+    uint8_t link_id;
+    uint64_t timestamp;
+    uint8_t secret_key[32];
+    mavlink_accept_unsigned_t accept_unsigned_callback;
+} mavlink_signing_t;
+
+// last timestamp seen from each (sysid, compid, link) stream, for
+// replay protection
+#ifndef MAVLINK_MAX_SIGNING_STREAMS
+#define MAVLINK_MAX_SIGNING_STREAMS 16
+#endif
+
+MAVPACKED(
+typedef struct __mavlink_signing_streams {
+    uint16_t num_signing_streams;
+    struct __mavlink_signing_stream {
+        uint8_t link_id;
+        uint8_t sysid;
+        uint8_t compid;
+        uint8_t timestamp_bytes[6];
+    } stream[MAVLINK_MAX_SIGNING_STREAMS];
+}) mavlink_signing_streams_t;
+
+#define MAVLINK_STATUS_FLAG_IN_MAVLINK1  1 // last incoming packet was MAVLink 1
+#define MAVLINK_STATUS_FLAG_OUT_MAVLINK1 2 // send MAVLink 1 packets
+#define MAVLINK_STATUS_FLAG_IN_SIGNED    4 // last incoming packet was signed and validated
+#define MAVLINK_STATUS_FLAG_IN_BADSIG    8 // last incoming packet had a bad signature
 
 // MAVLink status structure
 typedef struct __mavlink_status {
@@ -67,6 +148,10 @@ typedef struct __mavlink_status {
     uint8_t current_tx_seq;             // Sequence number of last packet sent
     uint16_t packet_rx_success_count;   // Received packets
     uint16_t packet_rx_drop_count;      // Number of packet drops
+    uint8_t flags;                      // MAVLINK_STATUS_FLAG_*
+    uint8_t signature_wait;             // Number of signature bytes left to receive
+    mavlink_signing_t *signing;         // signing state, NULL for no signing
+    mavlink_signing_streams_t *signing_streams; // shared by all signed channels
 } mavlink_status_t;
 
 // MAVLink system structure
@@ -0,0 +1,26 @@
+/*
+  navigation data shared by the GNSS protocol parsers
+ */
+#pragma once
+
+#include <stdint.h>
+
+// latest navigation data decoded from the GNSS stream, NMEA or UBX
+struct GNSS_Fix {
+    double latitude;        // degrees
+    double longitude;       // degrees
+    float altitude_msl;     // m, GGA or NAV-PVT hMSL
+    float geoid_sep;        // m, GGA
+    float ground_speed;     // m/s, RMC, VTG or NAV-PVT
+    float course;           // degrees true, RMC, VTG or NAV-PVT
+    float hdop;             // GGA or GSA
+    float vdop;             // GSA
+    float horiz_accuracy;   // m, GST sigma or NAV-PVT hAcc, 0 if unknown
+    float vert_accuracy;    // m, GST sigma or NAV-PVT vAcc, 0 if unknown
+    uint32_t time_ms;       // UTC time of day
+    uint32_t date;          // ddmmyy, RMC or NAV-PVT
+    uint8_t fix_quality;    // GGA: 0 none, 1 GPS, 2 DGPS, 4 RTK fixed, 5 RTK float
+    uint8_t fix_type;       // GSA or NAV-PVT: 1 none, 2 2D, 3 3D
+    uint8_t num_sats;       // GGA or NAV-PVT
+    bool valid;             // last RMC status A, GGA quality > 0 or gnssFixOK
+};
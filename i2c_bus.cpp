@@ -0,0 +1,155 @@
+/*
+  asynchronous I2C transaction queue
+
+  Arduino Wire transfers block until the bus is done, 250us or more
+  for a burst read at 400kHz, longer when a chip stretches the clock
+  or doesn't answer. Drivers instead queue each transaction, a
+  register burst read or a register write, and the bus task carries
+  them out in order and hands the result back to the driver. The task
+  calling a driver never waits on the bus, and a missing sensor costs
+  the bus task a timeout rather than the sensor tick.
+ */
+
+#include "i2c_bus.h"
+#include <string.h>
+
+I2C_Device::I2C_Device(I2C_Bus &_bus, uint8_t _address) :
+    bus(_bus),
+    address(_address)
+{
+    list_next = bus.devices;
+    bus.devices = this;
+}
+
+bool I2C_Device::read_registers(uint8_t reg, uint8_t len, uint8_t tag)
+{
+    return bus.submit(*this, tag, &reg, 1, len);
+}
+
+bool I2C_Device::write_register(uint8_t reg, uint8_t value, uint8_t tag)
+{
+    const uint8_t data[2] { reg, value };
+    return bus.submit(*this, tag, data, sizeof(data), 0);
+}
+
+I2C_Bus::I2C_Bus(TwoWire &_wire) :
+    wire(_wire)
+{
+}
+
+void I2C_Bus::start(RID_Task &_task)
+{
+    task = &_task;
+}
+
+void IRAM_ATTR I2C_Bus::notify_from_isr(void)
+{
+    if (task != nullptr) {
+        task->notify_from_isr();
+    }
+}
+
+bool I2C_Bus::submit(I2C_Device &dev, uint8_t tag, const uint8_t *data, uint8_t write_len, uint8_t read_len)
+{
+    if (write_len > I2C_MAX_WRITE || read_len > I2C_MAX_READ) {
+        return false;
+    }
+    {
+        WITH_SEMAPHORE(sem);
+        if (count == QUEUE_LEN) {
+            dropped++;
+            return false;
+        }
+        Transfer &t = queue[(head + count) % QUEUE_LEN];
+        t.dev = &dev;
+        t.queued_us = micros();
+        t.tag = tag;
+        t.write_len = write_len;
+        t.read_len = read_len;
+        memcpy(t.data, data, write_len);
+        count++;
+    }
+    if (task != nullptr) {
+        task->notify();
+    }
+    return true;
+}
+
+bool I2C_Bus::pop(Transfer &t)
+{
+    WITH_SEMAPHORE(sem);
+    if (count == 0) {
+        return false;
+    }
+    t = queue[head];
+    head = (head + 1) % QUEUE_LEN;
+    count--;
+    return true;
+}
+
+/*
+  one transaction: the write, then for a read a repeated start and
+  the read
+ */
+bool I2C_Bus::transfer(const Transfer &t, uint8_t *buf)
+{
+    wire.beginTransmission(t.dev->address);
+    wire.write(t.data, t.write_len);
+    if (t.read_len == 0) {
+        return wire.endTransmission() == 0;
+    }
+    if (wire.endTransmission(false) != 0) {
+        return false;
+    }
+    if (wire.requestFrom(t.dev->address, size_t(t.read_len)) != t.read_len) {
+        return false;
+    }
+    return wire.readBytes(buf, t.read_len) == t.read_len;
+}
+
+void I2C_Bus::run(void)
+{
+    for (I2C_Device *d = devices; d != nullptr; d = d->list_next) {
+        d->poll();
+    }
+
+    Transfer t;
+    while (pop(t)) {
+        uint8_t buf[I2C_MAX_READ];
+        const uint32_t start_us = micros();
+        const bool ok = transfer(t, buf);
+        const uint32_t end_us = micros();
+
+        busy_us += end_us - start_us;
+        t.dev->busy_us += end_us - start_us;
+        transfers++;
+        const uint32_t latency_us = end_us - t.queued_us;
+        latency_sum_us += latency_us;
+        if (latency_us > latency_window_max_us) {
+            latency_window_max_us = latency_us;
+        }
+        if (!ok) {
+            errors++;
+        }
+
+        t.dev->transfer_done(t.tag, ok, buf, ok ? t.read_len : 0);
+    }
+    update_stats(micros());
+}
+
+void I2C_Bus::update_stats(uint32_t now_us)
+{
+    const uint32_t dt_us = now_us - window_start_us;
+    if (dt_us < 1000000U) {
+        return;
+    }
+    busy_percent = busy_us * 100.0f / dt_us;
+    transfers_per_second = transfers * 1000000ULL / dt_us;
+    latency_avg_us = transfers > 0 ? latency_sum_us / transfers : 0;
+    latency_max_us = latency_window_max_us;
+    busy_us = 0;
+    transfers = 0;
+    latency_sum_us = 0;
+    latency_window_max_us = 0;
+    window_start_us = now_us;
+}
@@ -0,0 +1,141 @@
+/*
+  asynchronous I2C transaction queue
+ */
+#pragma once
+
+#include <Arduino.h>
+#include <Wire.h>
+#include "semaphore.h"
+#include "rid_task.h"
+
+// longest write (register plus value) and read of one transaction. The
+// read limit is the Arduino Wire buffer
+#define I2C_MAX_WRITE 4
+#define I2C_MAX_READ  128
+
+class I2C_Bus;
+
+/*
+  a chip on the bus. Drivers queue register reads and writes and get
+  the result back in transfer_done(), called from the bus task, with
+  the tag they queued it with
+ */
+class I2C_Device {
+public:
+    I2C_Device(I2C_Bus &_bus, uint8_t _address);
+
+    uint8_t get_address(void) const {
+        return address;
+    }
+    // bus time spent on this device's transfers since boot
+    uint32_t get_busy_us(void) const {
+        return busy_us;
+    }
+
+protected:
+    friend class I2C_Bus;
+
+    I2C_Bus &bus;
+    const uint8_t address;
+    I2C_Device *list_next;
+    // written by the bus task only
+    uint32_t busy_us;
+
+    // burst read of len registers from reg
+    bool read_registers(uint8_t reg, uint8_t len, uint8_t tag);
+    bool write_register(uint8_t reg, uint8_t value, uint8_t tag);
+
+    // data is len bytes read, len is 0 on a failed transfer or a write
+    virtual void transfer_done(uint8_t tag, bool ok, const uint8_t *data, uint8_t len) = 0;
+
+    // called on the bus task each run, to queue work an interrupt
+    // asked for
+    virtual void poll(void) {}
+};
+
+/*
+  transactions are queued by any task and carried out in order by the
+  bus task, so a sensor read never blocks the caller on the bus. A
+  transaction that doesn't fit the queue is refused and counted
+ */
+class I2C_Bus {
+public:
+    I2C_Bus(TwoWire &_wire);
+
+    // wake task when a transaction is queued, task calls run()
+    void start(RID_Task &_task);
+
+    bool submit(I2C_Device &dev, uint8_t tag, const uint8_t *data, uint8_t write_len, uint8_t read_len);
+
+    // carry out queued transactions, from the bus task only
+    void run(void);
+
+    // wake the bus task from a device interrupt, in IRAM
+    void notify_from_isr(void);
+
+    // share of time the bus was busy over the last full second
+    float get_busy_percent(void) const {
+        return busy_percent;
+    }
+    uint16_t get_transfers_per_second(void) const {
+        return transfers_per_second;
+    }
+    // time from submit() to completion over the last full second
+    uint32_t get_latency_avg_us(void) const {
+        return latency_avg_us;
+    }
+    uint32_t get_latency_max_us(void) const {
+        return latency_max_us;
+    }
+    // failed transfers and transactions refused by a full queue
+    uint32_t get_errors(void) const {
+        return errors;
+    }
+    uint32_t get_dropped(void) const {
+        return dropped;
+    }
+
+private:
+    friend class I2C_Device;
+
+    // the most queued at once is when all three probes answer together:
+    // 10 for the LSM6DS3 FIFO set up, 5 for the BME280 config burst and
+    // calibration reads and 6 for the LIS3MDL, 21 in all, with room for
+    // the sample reads of any sensor already running
+    static constexpr uint8_t QUEUE_LEN = 32;
+
+    struct Transfer {
+        I2C_Device *dev;
+        uint32_t queued_us;
+        uint8_t tag;
+        uint8_t write_len;
+        uint8_t read_len;
+        uint8_t data[I2C_MAX_WRITE];
+    };
+
+    TwoWire &wire;
+    RID_Task *task;
+    I2C_Device *devices;
+    // queue, and dropped, under sem
+    Semaphore sem;
+    Transfer queue[QUEUE_LEN];
+    uint8_t head;
+    uint8_t count;
+    uint32_t dropped;
+
+    // written by the bus task only
+    uint32_t errors;
+    uint32_t window_start_us;
+    uint32_t busy_us;
+    uint16_t transfers;
+    uint32_t latency_sum_us;
+    uint32_t latency_window_max_us;
+    float busy_percent;
+    uint16_t transfers_per_second;
+    uint32_t latency_avg_us;
+    uint32_t latency_max_us;
+
+    bool pop(Transfer &t);
+    bool transfer(const Transfer &t, uint8_t *buf);
+    void update_stats(uint32_t now_us);
+};
@@ -0,0 +1,113 @@
+/*
+  LIS3MDL magnetometer
+
+  Continuous conversion at 80Hz in ultra-high performance mode, +-4
+  gauss. Over I2C the LIS3MDL only increments the register address in
+  a burst when its top bit is set, so the sample read and the read
+  back of the configuration use reg | 0x80.
+ */
+
+#include "lis3mdl.h"
+
+#define LIS3MDL_REG_WHO_AM_I  0x0F
+#define LIS3MDL_REG_CTRL_REG1 0x20
+#define LIS3MDL_REG_CTRL_REG2 0x21
+#define LIS3MDL_REG_CTRL_REG3 0x22
+#define LIS3MDL_REG_CTRL_REG4 0x23
+#define LIS3MDL_REG_CTRL_REG5 0x24
+#define LIS3MDL_REG_OUT_X_L   0x28
+#define LIS3MDL_AUTO_INCREMENT 0x80
+
+#define LIS3MDL_DATA_LEN      6     // x, y, z
+
+#define LIS3MDL_WHO_AM_I      0x3D
+
+#define LIS3MDL_CTRL_REG1     0x7C  // X/Y ultra-high performance, 80Hz
+#define LIS3MDL_CTRL_REG2     0x00  // +-4 gauss
+#define LIS3MDL_CTRL_REG3     0x00  // continuous conversion
+#define LIS3MDL_CTRL_REG4     0x0C  // Z ultra-high performance
+#define LIS3MDL_CTRL_REG5     0x40  // block data update
+
+#define LIS3MDL_SCALE         (1.0f / 6842)     // gauss per LSB at +-4 gauss
+
+void LIS3MDL::init(void)
+{
+    state = State::PROBING;
+    read_registers(LIS3MDL_REG_WHO_AM_I, 1, TAG_ID);
+}
+
+void LIS3MDL::update(void)
+{
+    if (state != State::RUNNING || reading) {
+        return;
+    }
+    // set first, the result can arrive before submit returns
+    reading = true;
+    if (!read_registers(LIS3MDL_REG_OUT_X_L | LIS3MDL_AUTO_INCREMENT, LIS3MDL_DATA_LEN, TAG_DATA)) {
+        reading = false;
+    }
+}
+
+bool LIS3MDL::get_sample(Sample &s) const
+{
+    WITH_SEMAPHORE(sem);
+    s = sample;
+    return have_sample;
+}
+
+void LIS3MDL::transfer_done(uint8_t tag, bool ok, const uint8_t *data, uint8_t len)
+{
+    switch (tag) {
+    case TAG_ID:
+        if (!ok || len != 1 || data[0] != LIS3MDL_WHO_AM_I) {
+            state = State::ABSENT;
+            break;
+        }
+        state = State::CONFIGURING;
+        write_register(LIS3MDL_REG_CTRL_REG1, LIS3MDL_CTRL_REG1, TAG_CONFIG);
+        write_register(LIS3MDL_REG_CTRL_REG2, LIS3MDL_CTRL_REG2, TAG_CONFIG);
+        write_register(LIS3MDL_REG_CTRL_REG4, LIS3MDL_CTRL_REG4, TAG_CONFIG);
+        write_register(LIS3MDL_REG_CTRL_REG5, LIS3MDL_CTRL_REG5, TAG_CONFIG);
+        write_register(LIS3MDL_REG_CTRL_REG3, LIS3MDL_CTRL_REG3, TAG_CONFIG);
+        read_registers(LIS3MDL_REG_CTRL_REG1 | LIS3MDL_AUTO_INCREMENT, 5, TAG_VERIFY);
+        break;
+
+    case TAG_CONFIG:
+        if (!ok) {
+            state = State::ABSENT;
+        }
+        break;
+
+    case TAG_VERIFY: {
+        const uint8_t expected[5] { LIS3MDL_CTRL_REG1, LIS3MDL_CTRL_REG2, LIS3MDL_CTRL_REG3,
+                                    LIS3MDL_CTRL_REG4, LIS3MDL_CTRL_REG5 };
+        if (!ok || len != sizeof(expected) || state != State::CONFIGURING ||
+            memcmp(data, expected, sizeof(expected)) != 0) {
+            state = State::ABSENT;
+            break;
+        }
+        state = State::RUNNING;
+        break;
+    }
+
+    case TAG_DATA: {
+        if (ok && len == LIS3MDL_DATA_LEN) {
+            Sample s;
+            decode(data, s);
+            s.timestamp_ms = millis();
+            WITH_SEMAPHORE(sem);
+            sample = s;
+            have_sample = true;
+        }
+        reading = false;
+        break;
+    }
+    }
+}
+
+void LIS3MDL::decode(const uint8_t raw[6], Sample &s)
+{
+    for (uint8_t i=0; i<3; i++) {
+        s.mag[i] = int16_t(raw[2*i] | (raw[2*i+1] << 8)) * LIS3MDL_SCALE;
+    }
+}
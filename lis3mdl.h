@@ -0,0 +1,56 @@
+/*
+  LIS3MDL magnetometer on the async I2C bus
+ */
+#pragma once
+
+#include "i2c_bus.h"
+
+class LIS3MDL : public I2C_Device {
+public:
+    using I2C_Device::I2C_Device;
+
+    struct Sample {
+        float mag[3];       // gauss
+        uint32_t timestamp_ms;
+    };
+
+    // queue the probe and configuration
+    void init(void);
+
+    // queue a read of the next sample unless one is in flight
+    void update(void);
+
+    bool healthy(void) const {
+        return state == State::RUNNING;
+    }
+    // latest sample, false if there is none yet
+    bool get_sample(Sample &s) const;
+
+    // decode the 6 output registers from OUT_X_L
+    static void decode(const uint8_t raw[6], Sample &s);
+
+private:
+    enum class State : uint8_t {
+        NONE,
+        PROBING,
+        CONFIGURING,
+        RUNNING,
+        ABSENT,
+    };
+
+    enum Tag : uint8_t {
+        TAG_ID,
+        TAG_CONFIG,
+        TAG_VERIFY,
+        TAG_DATA,
+    };
+
+    volatile State state;
+    volatile bool reading;
+
+    mutable Semaphore sem;
+    Sample sample;
+    bool have_sample;
+
+    void transfer_done(uint8_t tag, bool ok, const uint8_t *data, uint8_t len) override;
+};
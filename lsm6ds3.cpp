@@ -0,0 +1,250 @@
+/*
+  LSM6DS3 accelerometer and gyro
+
+  Both run at 208Hz into the chip's FIFO in continuous mode, so the
+  samples are kept however late the firmware is to read them. When the
+  FIFO holds WATERMARK_SETS samples the INT1 watermark interrupt wakes
+  the bus task, which reads the FIFO status and then the samples in
+  one burst read, repeating until the FIFO is drained. Each sample is
+  timestamped from its place in the FIFO at the status read. The batch
+  goes to a ring for motion processing, and its mean becomes the
+  sample seen by the sensor tick.
+
+  A FIFO sample is six words, gyro xyz then accel xyz. After an overrun
+  the FIFO pattern says which word comes next, and words up to the
+  next whole sample are read and discarded.
+ */
+
+#include "lsm6ds3.h"
+#include "util.h"
+
+#define LSM6DS3_REG_FIFO_CTRL1   0x06
+#define LSM6DS3_REG_FIFO_CTRL2   0x07
+#define LSM6DS3_REG_FIFO_CTRL3   0x08
+#define LSM6DS3_REG_FIFO_CTRL5   0x0A
+#define LSM6DS3_REG_INT1_CTRL    0x0D
+#define LSM6DS3_REG_WHO_AM_I     0x0F
+#define LSM6DS3_REG_CTRL1_XL     0x10
+#define LSM6DS3_REG_CTRL2_G      0x11
+#define LSM6DS3_REG_CTRL3_C      0x12
+#define LSM6DS3_REG_FIFO_STATUS1 0x3A   // 4 bytes, fill level and pattern
+#define LSM6DS3_REG_FIFO_DATA    0x3E
+
+// LSM6DS3, and the LSM6DS3TR-C which is register compatible here
+#define LSM6DS3_WHO_AM_I         0x69
+#define LSM6DS3TRC_WHO_AM_I      0x6A
+
+#define LSM6DS3_CTRL1_XL         0x58   // 208Hz, +-4g
+#define LSM6DS3_CTRL2_G          0x54   // 208Hz, 500dps
+#define LSM6DS3_CTRL3_C          0x44   // block data update, auto-increment
+#define LSM6DS3_FIFO_CTRL3       0x09   // gyro and accel, no decimation
+#define LSM6DS3_FIFO_BYPASS      0x00
+#define LSM6DS3_FIFO_CTRL5       0x2E   // 208Hz, continuous mode
+#define LSM6DS3_INT1_FTH         0x08
+
+#define FIFO_STATUS2_OVER_RUN    0x40
+#define FIFO_STATUS2_EMPTY       0x10
+#define FIFO_STATUS2_DIFF_HIGH   0x0F
+
+#define FIFO_WORDS    4096
+#define SAMPLE_WORDS  6
+#define SAMPLE_BYTES  (SAMPLE_WORDS * 2)
+
+#define FIFO_STATUS_LEN 4
+#define VERIFY_LEN      3   // CTRL1_XL to CTRL3_C
+
+// interrupt every 8 samples, about 26Hz
+#define WATERMARK_SETS 8
+
+// longest read, whole samples plus the words skipped to realign
+#define MAX_READ_SETS ((I2C_MAX_READ/2 - (SAMPLE_WORDS-1)) / SAMPLE_WORDS)
+
+static constexpr uint32_t SAMPLE_PERIOD_US = 1000000U / LSM6DS3::ODR_HZ;
+
+// drain anyway if no interrupt comes, for a board without INT1 wired
+// or a missed edge
+static constexpr uint32_t POLL_TIMEOUT_US = 2 * WATERMARK_SETS * SAMPLE_PERIOD_US;
+
+void IRAM_ATTR LSM6DS3::irq_handler(void *arg)
+{
+    LSM6DS3 *imu = (LSM6DS3 *)arg;
+    imu->irq_pending = true;
+    imu->bus.notify_from_isr();
+}
+
+void LSM6DS3::init(int8_t int1_pin)
+{
+    if (int1_pin >= 0) {
+        pinMode(int1_pin, INPUT);
+        attachInterruptArg(int1_pin, irq_handler, this, RISING);
+    }
+    state = State::PROBING;
+    read_registers(LSM6DS3_REG_WHO_AM_I, 1, TAG_ID);
+}
+
+bool LSM6DS3::get_sample(Sample &s) const
+{
+    WITH_SEMAPHORE(sem);
+    s = sample;
+    return have_sample;
+}
+
+uint16_t LSM6DS3::read_batch(Raw_Sample *out, uint16_t max)
+{
+    const uint32_t n = MIN(uint32_t(max), batch.available() / sizeof(Raw_Sample));
+    return batch.read((uint8_t *)out, n * sizeof(Raw_Sample)) / sizeof(Raw_Sample);
+}
+
+void LSM6DS3::poll(void)
+{
+    if (state != State::RUNNING || draining) {
+        return;
+    }
+    if (irq_pending || micros() - last_drain_us > POLL_TIMEOUT_US) {
+        irq_pending = false;
+        read_status();
+    }
+}
+
+bool LSM6DS3::read_status(void)
+{
+    draining = read_registers(LSM6DS3_REG_FIFO_STATUS1, FIFO_STATUS_LEN, TAG_FIFO_STATUS);
+    return draining;
+}
+
+void LSM6DS3::transfer_done(uint8_t tag, bool ok, const uint8_t *data, uint8_t len)
+{
+    switch (tag) {
+    case TAG_ID:
+        if (!ok || len != 1 || (data[0] != LSM6DS3_WHO_AM_I && data[0] != LSM6DS3TRC_WHO_AM_I)) {
+            state = State::ABSENT;
+            break;
+        }
+        state = State::CONFIGURING;
+        write_register(LSM6DS3_REG_CTRL3_C, LSM6DS3_CTRL3_C, TAG_CONFIG);
+        write_register(LSM6DS3_REG_CTRL1_XL, LSM6DS3_CTRL1_XL, TAG_CONFIG);
+        write_register(LSM6DS3_REG_CTRL2_G, LSM6DS3_CTRL2_G, TAG_CONFIG);
+        write_register(LSM6DS3_REG_FIFO_CTRL5, LSM6DS3_FIFO_BYPASS, TAG_CONFIG);
+        write_register(LSM6DS3_REG_FIFO_CTRL1, WATERMARK_SETS * SAMPLE_WORDS, TAG_CONFIG);
+        write_register(LSM6DS3_REG_FIFO_CTRL2, 0, TAG_CONFIG);
+        write_register(LSM6DS3_REG_FIFO_CTRL3, LSM6DS3_FIFO_CTRL3, TAG_CONFIG);
+        write_register(LSM6DS3_REG_FIFO_CTRL5, LSM6DS3_FIFO_CTRL5, TAG_CONFIG);
+        write_register(LSM6DS3_REG_INT1_CTRL, LSM6DS3_INT1_FTH, TAG_CONFIG);
+        read_registers(LSM6DS3_REG_CTRL1_XL, VERIFY_LEN, TAG_VERIFY);
+        break;
+
+    case TAG_CONFIG:
+        if (!ok) {
+            state = State::ABSENT;
+        }
+        break;
+
+    case TAG_VERIFY:
+        if (!ok || len != VERIFY_LEN || state != State::CONFIGURING ||
+            data[0] != LSM6DS3_CTRL1_XL || data[1] != LSM6DS3_CTRL2_G ||
+            (data[2] & LSM6DS3_CTRL3_C) != LSM6DS3_CTRL3_C) {
+            state = State::ABSENT;
+            break;
+        }
+        last_drain_us = micros();
+        state = State::RUNNING;
+        break;
+
+    case TAG_FIFO_STATUS:
+        if (!ok || len != FIFO_STATUS_LEN) {
+            draining = false;
+            break;
+        }
+        fifo_status(data);
+        break;
+
+    case TAG_FIFO_DATA:
+        if (!ok || len != read_len) {
+            draining = false;
+            break;
+        }
+        fifo_data(data);
+        break;
+    }
+}
+
+/*
+  from the fill level and pattern, read the whole samples that fit
+  one transfer
+ */
+void LSM6DS3::fifo_status(const uint8_t *data)
+{
+    status_us = micros();
+    last_drain_us = status_us;
+    uint16_t words = data[0] | ((data[1] & FIFO_STATUS2_DIFF_HIGH) << 8);
+    if (words == 0 && !(data[1] & FIFO_STATUS2_EMPTY)) {
+        // the 12 bit fill level wraps to 0 when the FIFO is full
+        words = FIFO_WORDS;
+    }
+    const uint16_t pattern = data[2] | ((data[3] & 0x03) << 8);
+    if (data[1] & FIFO_STATUS2_OVER_RUN) {
+        overruns++;
+    }
+    read_skip = (SAMPLE_WORDS - pattern % SAMPLE_WORDS) % SAMPLE_WORDS;
+    if (words < read_skip + SAMPLE_WORDS) {
+        draining = false;
+        return;
+    }
+    fifo_sets = (words - read_skip) / SAMPLE_WORDS;
+    read_sets = MIN(fifo_sets, uint16_t(MAX_READ_SETS));
+    read_len = (read_skip + read_sets * SAMPLE_WORDS) * 2;
+    if (!read_registers(LSM6DS3_REG_FIFO_DATA, read_len, TAG_FIFO_DATA)) {
+        draining = false;
+    }
+}
+
+void LSM6DS3::fifo_data(const uint8_t *data)
+{
+    discarded += read_skip;
+    data += read_skip * 2;
+
+    int32_t sum[6] {};
+    Raw_Sample s;
+    for (uint8_t i=0; i<read_sets; i++) {
+        decode(&data[i * SAMPLE_BYTES], s);
+        // the newest sample in the FIFO was taken about at the status read
+        s.timestamp_us = status_us - (fifo_sets - 1 - i) * SAMPLE_PERIOD_US;
+        for (uint8_t j=0; j<3; j++) {
+            sum[j] += s.gyro[j];
+            sum[3+j] += s.accel[j];
+        }
+        if (batch.space() < sizeof(s)) {
+            batch_dropped++;
+        } else {
+            batch.write((const uint8_t *)&s, sizeof(s));
+        }
+    }
+    samples += read_sets;
+
+    Sample mean;
+    for (uint8_t j=0; j<3; j++) {
+        mean.gyro[j] = sum[j] * GYRO_SCALE / read_sets;
+        mean.accel[j] = sum[3+j] * ACCEL_SCALE / read_sets;
+    }
+    mean.timestamp_ms = millis() - (micros() - s.timestamp_us) / 1000;
+    {
+        WITH_SEMAPHORE(sem);
+        sample = mean;
+        have_sample = true;
+    }
+
+    // keep going until the FIFO is down to less than a sample
+    if (read_sets < fifo_sets) {
+        read_status();
+    } else {
+        draining = false;
+    }
+}
+
+void LSM6DS3::decode(const uint8_t raw[12], Raw_Sample &s)
+{
+    for (uint8_t i=0; i<3; i++) {
+        s.gyro[i] = int16_t(raw[2*i] | (raw[2*i+1] << 8));
+        s.accel[i] = int16_t(raw[6+2*i] | (raw[6+2*i+1] << 8));
+    }
+}
@@ -0,0 +1,114 @@
+/*
+  LSM6DS3 accelerometer and gyro on the async I2C bus
+ */
+#pragma once
+
+#include "i2c_bus.h"
+#include "ring_buffer.h"
+
+class LSM6DS3 : public I2C_Device {
+public:
+    using I2C_Device::I2C_Device;
+
+    // mean of the last FIFO batch
+    struct Sample {
+        float accel[3];     // m/s/s
+        float gyro[3];      // rad/s
+        uint32_t timestamp_ms;
+    };
+
+    // one FIFO sample as read, scale with ACCEL_SCALE and GYRO_SCALE
+    struct Raw_Sample {
+        int16_t gyro[3];
+        int16_t accel[3];
+        uint32_t timestamp_us;
+    };
+
+    static constexpr uint16_t ODR_HZ = 208;
+    static constexpr float ACCEL_SCALE = 0.122e-3f * 9.80665f;             // m/s/s per LSB, +-4g
+    static constexpr float GYRO_SCALE = 17.5e-3f * 3.14159265f / 180.0f;   // rad/s per LSB, 500dps
+
+    /*
+      queue the probe and configuration. With int1_pin the FIFO
+      watermark interrupt starts each drain, otherwise the bus task
+      polls the FIFO
+     */
+    void init(int8_t int1_pin=-1);
+
+    bool healthy(void) const {
+        return state == State::RUNNING;
+    }
+    // latest batch mean, false if there is none yet
+    bool get_sample(Sample &s) const;
+
+    // raw samples since the last call, oldest first, single consumer
+    uint16_t read_batch(Raw_Sample *samples, uint16_t max);
+
+    // samples read, FIFO overruns, words discarded to realign on a
+    // sample and samples lost to a full batch ring
+    uint32_t get_samples(void) const {
+        return samples;
+    }
+    uint32_t get_overruns(void) const {
+        return overruns;
+    }
+    uint32_t get_discarded(void) const {
+        return discarded;
+    }
+    uint32_t get_batch_dropped(void) const {
+        return batch_dropped;
+    }
+
+    // decode one 12 byte FIFO sample, gyro then accel
+    static void decode(const uint8_t raw[12], Raw_Sample &s);
+
+private:
+    enum class State : uint8_t {
+        NONE,
+        PROBING,
+        CONFIGURING,
+        RUNNING,
+        ABSENT,
+    };
+
+    enum Tag : uint8_t {
+        TAG_ID,
+        TAG_CONFIG,
+        TAG_VERIFY,
+        TAG_FIFO_STATUS,
+        TAG_FIFO_DATA,
+    };
+
+    volatile State state;
+    volatile bool irq_pending;
+
+    // drain in progress, written by the bus task only
+    bool draining;
+    uint32_t last_drain_us;
+    uint32_t status_us;
+    uint16_t fifo_sets;         // whole samples in the FIFO at the status read
+    uint8_t read_skip;          // words before the first whole sample
+    uint8_t read_sets;          // whole samples in the data read
+    uint8_t read_len;           // bytes in the data read
+
+    uint32_t samples;
+    uint32_t overruns;
+    uint32_t discarded;
+    uint32_t batch_dropped;
+
+    // about 0.6s of samples for motion processing
+    Ring_Buffer<2048> batch;
+
+    mutable Semaphore sem;
+    Sample sample;
+    bool have_sample;
+
+    void transfer_done(uint8_t tag, bool ok, const uint8_t *data, uint8_t len) override;
+    void poll(void) override;
+
+    bool read_status(void);
+    void fifo_status(const uint8_t *data);
+    void fifo_data(const uint8_t *data);
+
+    static void irq_handler(void *arg);
+};
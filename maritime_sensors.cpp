@@ -7,12 +7,16 @@
 #include "board_config_maritime.h"
 #include "data_validation.h"
 #include "ondocean_logger.h"
+#include "sensor_manager.h"
 #include <Wire.h>
 
-// Global sensor data
-static MaritimeSensorData current_sensor_data;
 static bool sensors_initialized = false;
 
+I2C_Bus sensor_bus{Wire};
+BME280 env_sensor{sensor_bus, BME280_I2C_ADDR};
+LSM6DS3 imu_sensor{sensor_bus, LSM6DS3_I2C_ADDR};
+LIS3MDL mag_sensor{sensor_bus, LIS3MDL_I2C_ADDR};
+
 void setup_maritime_sensors() {
     LOG_SENSOR_INFO("Initializing maritime sensors...");
     
@@ -20,25 +24,20 @@ void setup_maritime_sensors() {
     
     // Initialize I2C with default pins
     Wire.begin();  // Use default I2C pins for ESP32-S3
-    Wire.setClock(400000);  // 400kHz I2C speed
+    Wire.setClock(I2C_FREQUENCY);
     LOG_SENSOR_INFO("I2C initialized at 400kHz (default pins)");
     
-    // Initialize environmental sensor (BME280)
-    // TODO: Add actual BME280 initialization
-    LOG_SENSOR_INFO("BME280 environmental sensor initialization - TODO");
-    
-    // Initialize IMU (LSM6DS3)
-    // TODO: Add actual LSM6DS3 initialization
-    LOG_SENSOR_INFO("LSM6DS3 IMU sensor initialization - TODO");
-    
-    // Initialize magnetometer (LIS3MDL)
-    // TODO: Add actual LIS3MDL initialization
-    LOG_SENSOR_INFO("LIS3MDL magnetometer initialization - TODO");
+    // Probe and configure the sensors. This only queues the
+    // transactions, they run once the I2C task starts
+    env_sensor.init();
+    imu_sensor.init(PIN_IMU_INT1);
+    mag_sensor.init();
+    LOG_SENSOR_INFO("BME280, LSM6DS3 and LIS3MDL set up queued");
     
-    // Initialize GPIO pins (using placeholder values)
-    // pinMode(PIN_CASE_DETECT, INPUT_PULLUP);     // TODO: Define actual pins
-    // pinMode(PIN_BATTERY_MONITOR, INPUT);        // TODO: Define actual pins
-    LOG_SENSOR_INFO("GPIO pins configuration - TODO (define actual pins)");
+    // Case switch interrupt, first battery reading and the rate of
+    // each source
+    sensor_manager.init();
+    LOG_SENSOR_INFO("Sensor manager started");
     
     // Initialize status LED (using built-in LED)
     pinMode(LED_BUILTIN, OUTPUT);
@@ -58,40 +57,8 @@ bool read_maritime_sensors(MaritimeSensorData* data) {
         return false;
     }
     
-    // Clear data structure
-    memset(data, 0, sizeof(MaritimeSensorData));
-    
-    // Read timestamp
-    data->timestamp_ms = millis();
-    
-    // Read case integrity (mock for now)
-    data->case_tamper_detected = false;  // Mock: case closed
-    
-    // Read battery voltage
-    data->battery_voltage = read_battery_voltage();
-    
-    // Read environmental data (mock values for now)
-    data->temperature_c = 25.0f;  // Mock temperature
-    data->humidity_pct = 65.0f;   // Mock humidity
-    data->pressure_hpa = 1013.25f; // Mock pressure
-    
-    // Read IMU data
-    // TODO: Implement actual sensor reading
-    data->accel_x = 0.0;
-    data->accel_y = 0.0;
-    data->accel_z = 9.81;  // 1g downward
-    
-    data->gyro_x = 0.0;
-    data->gyro_y = 0.0;
-    data->gyro_z = 0.0;
-    
-    // Read magnetometer
-    data->mag_x = 0.0;
-    data->mag_y = 0.0;
-    data->mag_z = 1.0;  // North pointing
-    
-    // Set timestamp
-    data->timestamp_ms = millis();
+    // Latest value of every source, nominal until it reports
+    sensor_manager.get(*data);
     
     // VALIDATION: Validate sensor data before returning
     ValidationResult validation_result = validate_maritime_sensor_data(data);
@@ -8,6 +8,10 @@
 
 #include <Arduino.h>
 #include <Wire.h>
+#include "i2c_bus.h"
+#include "bme280.h"
+#include "lsm6ds3.h"
+#include "lis3mdl.h"
 
 // Sensor I2C addresses
 #define BME280_I2C_ADDR     0x76  // Environmental sensor
@@ -26,16 +30,29 @@ struct MaritimeSensorData {
     float temperature_c;
     float humidity_pct;
     float pressure_hpa;
-    float accel_x, accel_y, accel_z;
-    float gyro_x, gyro_y, gyro_z;
-    float mag_x, mag_y, mag_z;
+    float accel_x, accel_y, accel_z;    // m/s/s
+    float gyro_x, gyro_y, gyro_z;       // rad/s
+    float mag_x, mag_y, mag_z;          // gauss
+    float heading_deg;                  // magnetic, clockwise from north
+    float pitch_deg, roll_deg;          // bow up, starboard down
+    bool attitude_valid;                // AHRS running on the IMU
+    bool heading_valid;                 // with a current magnetometer sample
     bool case_tamper_detected;
     float battery_voltage;
     uint32_t timestamp_ms;
 };
 
+// I2C bus of the BME280, LSM6DS3 and LIS3MDL, run by its own task
+extern I2C_Bus sensor_bus;
+// the sensors, read through the sensor manager. The IMU FIFO batches
+// are read from imu_sensor directly
+extern BME280 env_sensor;
+extern LSM6DS3 imu_sensor;
+extern LIS3MDL mag_sensor;
+
 // Function declarations
 void setup_maritime_sensors();
+// latest samples from the sensor manager, validated
 bool read_maritime_sensors(MaritimeSensorData* data);
 bool validate_maritime_environment(const MaritimeSensorData* data);
 void maritime_sensor_calibration();
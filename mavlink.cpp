@@ -6,25 +6,40 @@
 #include "board_config.h"
 #include "version.h"
 #include "parameters.h"
+#include "odid_snapshot.h"
+#include "util.h"
 
 #define SERIAL_BAUD 115200
 
-static HardwareSerial *serial_ports[MAVLINK_COMM_NUM_BUFFERS];
-
 #include <generated/mavlink_helpers.h>
 
 mavlink_system_t mavlink_system = {0, MAV_COMP_ID_ODID_TXRX_1};
 
 /*
-  send a buffer out a MAVLink channel
+  send a frame out a MAVLink channel through its TX queue
  */
+void comm_start_frame(mavlink_channel_t chan, uint16_t len)
+{
+    auto *q = MAVLink_TX_Queue::for_channel(uint8_t(chan));
+    if (q != nullptr) {
+        q->start_frame(len);
+    }
+}
+
 void comm_send_buffer(mavlink_channel_t chan, const uint8_t *buf, uint8_t len)
 {
-    if (chan >= MAVLINK_COMM_NUM_BUFFERS || serial_ports[uint8_t(chan)] == nullptr) {
-        return;
+    auto *q = MAVLink_TX_Queue::for_channel(uint8_t(chan));
+    if (q != nullptr) {
+        q->append(buf, len);
+    }
+}
+
+void comm_end_frame(mavlink_channel_t chan)
+{
+    auto *q = MAVLink_TX_Queue::for_channel(uint8_t(chan));
+    if (q != nullptr) {
+        q->end_frame();
     }
-    auto &serial = *serial_ports[uint8_t(chan)];
-    serial.write(buf, len);
 }
 
 /*
@@ -32,9 +47,9 @@ void comm_send_buffer(mavlink_channel_t chan, const uint8_t *buf, uint8_t len)
  */
 MAVLinkSerial::MAVLinkSerial(HardwareSerial &_serial, mavlink_channel_t _chan) :
     serial(_serial),
+    tx_queue(_serial, uint8_t(_chan - MAVLINK_COMM_0)),
     chan(_chan)
 {
-    serial_ports[uint8_t(_chan - MAVLINK_COMM_0)] = &serial;
 }
 
 void MAVLinkSerial::init(void)
@@ -49,11 +64,14 @@ void MAVLinkSerial::update(void)
 {
     const uint32_t now_ms = millis();
 
+    // carry on writing frames queued by the last update
+    tx_queue.drain();
+
     if (mavlink_system.sysid != 0) {
         update_send();
     } else if (g.mavlink_sysid != 0) {
         mavlink_system.sysid = g.mavlink_sysid;
-    } else if (now_ms - last_hb_warn_ms >= 2000) {
+    } else if (now_ms - last_hb_warn_ms >= 2000 && !tx_queue.mid_frame()) {
         last_hb_warn_ms = millis();
         serial.printf("Waiting for heartbeat\n");
     }
@@ -97,19 +115,24 @@ void MAVLinkSerial::update_send(void)
 
 void MAVLinkSerial::update_receive(void)
 {
-    // receive new packets
+    // receive in blocks straight into the scanner and pull out whole
+    // frames, instead of parsing byte by byte
     mavlink_message_t msg;
-    mavlink_status_t status;
-    status.packet_rx_drop_count = 0;
-
-    const uint16_t nbytes = serial.available();
-    for (uint16_t i=0; i<nbytes; i++) {
-        const uint8_t c = (uint8_t)serial.read();
-        // Try to get a new message
-        if (mavlink_parse_char(chan, c, &msg, &status)) {
-            process_packet(status, msg);
+    uint16_t space;
+    uint32_t nbytes;
+    do {
+        uint8_t *buf = scanner.write_ptr();
+        space = scanner.write_space();
+        if (ingest != nullptr) {
+            nbytes = ingest->read(buf, space);
+        } else {
+            nbytes = serial.read(buf, MIN(size_t(serial.available()), size_t(space)));
         }
-    }
+        scanner.written(nbytes);
+        while (scanner.next(msg)) {
+            process_packet(scanner.get_status(), msg);
+        }
+    } while (nbytes == space);
 }
 
 /*
@@ -128,6 +151,20 @@ void MAVLinkSerial::mav_printf(uint8_t severity, const char *fmt, ...)
                                 0, 0);
 }
 
+/*
+  store a received OpenDroneID message, marking the snapshot slots
+  dirty only if the content actually changed
+ */
+template <typename T>
+static void store_if_changed(T &dst, const T &src, ODID_Snapshot::Slot slot)
+{
+    if (memcmp(&dst, &src, sizeof(T)) != 0) {
+        WITH_SEMAPHORE(odid_snapshot.get_semaphore());
+        dst = src;
+        odid_snapshot.mark_dirty(ODID_Snapshot::slot_bit(slot));
+    }
+}
+
 void MAVLinkSerial::process_packet(mavlink_status_t &status, mavlink_message_t &msg)
 {
     const uint32_t now_ms = millis();
@@ -143,7 +180,9 @@ void MAVLinkSerial::process_packet(mavlink_status_t &status, mavlink_message_t &
         break;
     }
     case MAVLINK_MSG_ID_OPEN_DRONE_ID_LOCATION: {
-        mavlink_msg_open_drone_id_location_decode(&msg, &location);
+        mavlink_open_drone_id_location_t location_tmp;
+        mavlink_msg_open_drone_id_location_decode(&msg, &location_tmp);
+        store_if_changed(location, location_tmp, ODID_Snapshot::Slot::LOCATION);
         if (g.options & OPTIONS_PRINT_RID_MAVLINK) {
             Serial.printf("MAVLink: got Location\n");
         }
@@ -163,7 +202,7 @@ void MAVLinkSerial::process_packet(mavlink_status_t &status, mavlink_message_t &
         mavlink_msg_open_drone_id_basic_id_decode(&msg, &basic_id_tmp);
         if ((strlen((const char*) basic_id_tmp.uas_id) > 0) && (basic_id_tmp.id_type > 0) && (basic_id_tmp.id_type <= MAV_ODID_ID_TYPE_SPECIFIC_SESSION_ID)) {
             //only update if we receive valid data
-            basic_id = basic_id_tmp;
+            store_if_changed(basic_id, basic_id_tmp, ODID_Snapshot::Slot::BASIC_ID);
             last_basic_id_ms = now_ms;
         }
         break;
@@ -176,7 +215,9 @@ void MAVLinkSerial::process_packet(mavlink_status_t &status, mavlink_message_t &
         break;
     }
     case MAVLINK_MSG_ID_OPEN_DRONE_ID_SELF_ID: {
-        mavlink_msg_open_drone_id_self_id_decode(&msg, &self_id);
+        mavlink_open_drone_id_self_id_t self_id_tmp;
+        mavlink_msg_open_drone_id_self_id_decode(&msg, &self_id_tmp);
+        store_if_changed(self_id, self_id_tmp, ODID_Snapshot::Slot::SELF_ID);
         if (g.options & OPTIONS_PRINT_RID_MAVLINK) {
             Serial.printf("MAVLink: got SelfID\n");
         }
@@ -184,7 +225,9 @@ void MAVLinkSerial::process_packet(mavlink_status_t &status, mavlink_message_t &
         break;
     }
     case MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM: {
-        mavlink_msg_open_drone_id_system_decode(&msg, &system);
+        mavlink_open_drone_id_system_t system_tmp;
+        mavlink_msg_open_drone_id_system_decode(&msg, &system_tmp);
+        store_if_changed(system, system_tmp, ODID_Snapshot::Slot::SYSTEM);
         if (g.options & OPTIONS_PRINT_RID_MAVLINK) {
             Serial.printf("MAVLink: got System\n");
         }
@@ -201,10 +244,12 @@ void MAVLinkSerial::process_packet(mavlink_status_t &status, mavlink_message_t &
         }
         mavlink_open_drone_id_system_update_t pkt_system_update;
         mavlink_msg_open_drone_id_system_update_decode(&msg, &pkt_system_update);
-        system.operator_latitude = pkt_system_update.operator_latitude;
-        system.operator_longitude = pkt_system_update.operator_longitude;
-        system.operator_altitude_geo = pkt_system_update.operator_altitude_geo;
-        system.timestamp = pkt_system_update.timestamp;
+        mavlink_open_drone_id_system_t system_tmp = system;
+        system_tmp.operator_latitude = pkt_system_update.operator_latitude;
+        system_tmp.operator_longitude = pkt_system_update.operator_longitude;
+        system_tmp.operator_altitude_geo = pkt_system_update.operator_altitude_geo;
+        system_tmp.timestamp = pkt_system_update.timestamp;
+        store_if_changed(system, system_tmp, ODID_Snapshot::Slot::SYSTEM);
         if (last_system_ms != 0) {
             // we can only mark system as updated if we have the other
             // information already
@@ -218,7 +263,9 @@ void MAVLinkSerial::process_packet(mavlink_status_t &status, mavlink_message_t &
         break;
     }
     case MAVLINK_MSG_ID_OPEN_DRONE_ID_OPERATOR_ID: {
-        mavlink_msg_open_drone_id_operator_id_decode(&msg, &operator_id);
+        mavlink_open_drone_id_operator_id_t operator_id_tmp;
+        mavlink_msg_open_drone_id_operator_id_decode(&msg, &operator_id_tmp);
+        store_if_changed(operator_id, operator_id_tmp, ODID_Snapshot::Slot::OPERATOR_ID);
         if (g.options & OPTIONS_PRINT_RID_MAVLINK) {
             Serial.printf("MAVLink: got OperatorID\n");
         }
@@ -4,6 +4,9 @@
 #pragma once
 #include "transport.h"
 #include "parameters.h"
+#include "uart_ingest.h"
+#include "mavlink_scanner.h"
+#include "mavlink_tx_queue.h"
 
 /*
   abstraction for MAVLink on a serial port
@@ -15,8 +18,16 @@ public:
     void init(void) override;
     void update(void) override;
 
+    // receive from a ring filled by UART events instead of the driver
+    void set_ingest(UART_Ingest &_ingest) {
+        ingest = &_ingest;
+    }
+
 private:
     HardwareSerial &serial;
+    UART_Ingest *ingest;
+    MAVLink_Scanner scanner;
+    MAVLink_TX_Queue tx_queue;
     mavlink_channel_t chan;
     uint32_t last_hb_ms;
     uint32_t last_hb_warn_ms;
@@ -1,3 +1,2 @@
 #include "generated/all/version.h"
-#include "generated/all/mavlink.h"
 #include "generated/mavlink_types.h"
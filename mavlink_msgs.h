@@ -9,6 +9,8 @@
 #define MAVLINK_NO_CONVERSION_HELPERS
 
 #define MAVLINK_SEND_UART_BYTES(chan, buf, len) comm_send_buffer(chan, buf, len)
+#define MAVLINK_START_UART_SEND(chan, len) comm_start_frame(chan, len)
+#define MAVLINK_END_UART_SEND(chan, len) comm_end_frame(chan)
 
 // two buffers, one for USB, one for UART. This makes for easier testing with SITL
 #define MAVLINK_COMM_NUM_BUFFERS 2
@@ -20,7 +22,9 @@
 /// MAVLink system definition
 extern mavlink_system_t mavlink_system;
 
+void comm_start_frame(mavlink_channel_t chan, uint16_t len);
 void comm_send_buffer(mavlink_channel_t chan, const uint8_t *buf, uint8_t len);
+void comm_end_frame(mavlink_channel_t chan);
 
 #define MAVLINK_USE_CONVENIENCE_FUNCTIONS
 #include <generated/all/mavlink.h>
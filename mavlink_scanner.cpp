@@ -0,0 +1,149 @@
+/*
+  bulk MAVLink frame scanner
+
+  mavlink_parse_char() walks a state machine for every byte received.
+  Here bytes are read in blocks and only the frame boundaries are
+  inspected: find an STX, read the length from the header, and once
+  the whole frame is in the buffer check its CRC in one pass. A bad
+  CRC resumes the search one byte after the false STX, a frame with an
+  unknown msgid is skipped whole as the byte parser would. When the
+  status has signing set up, frames are checked as the parser does.
+ */
+
+#include "mavlink_scanner.h"
+#include <string.h>
+
+void MAVLink_Scanner::compact(void)
+{
+    if (tail == 0) {
+        return;
+    }
+    memmove(&buf[0], &buf[tail], head - tail);
+    head -= tail;
+    tail = 0;
+}
+
+/*
+  with signing enabled a frame must carry a good signature with a new
+  timestamp, unless the accept_unsigned callback lets it through
+ */
+bool MAVLink_Scanner::signature_ok(const mavlink_message_t &msg, bool signed_frame)
+{
+    if (signed_frame && mavlink_signature_check(status.signing, status.signing_streams, &msg)) {
+        return true;
+    }
+    return status.signing->accept_unsigned_callback != nullptr &&
+           status.signing->accept_unsigned_callback(&status, msg.msgid);
+}
+
+bool MAVLink_Scanner::next(mavlink_message_t &msg)
+{
+    while (true) {
+        // jump to the next STX
+        uint16_t i = tail;
+        while (i < head && buf[i] != MAVLINK_STX && buf[i] != MAVLINK_STX_MAVLINK1) {
+            i++;
+        }
+        skipped += i - tail;
+        tail = i;
+        if (tail == head) {
+            head = tail = 0;
+            return false;
+        }
+
+        const uint8_t *p = &buf[tail];
+        const uint16_t avail = head - tail;
+        const bool v2 = p[0] == MAVLINK_STX;
+        const uint8_t header_len = v2 ? MAVLINK_NUM_HEADER_BYTES : MAVLINK_CORE_HEADER_MAVLINK1_LEN + 1;
+        if (avail < header_len) {
+            compact();
+            return false;
+        }
+        const uint8_t len = p[1];
+        if (v2 && (p[2] & ~MAVLINK_IFLAG_MASK) != 0) {
+            // incompatible flags we don't understand, not a frame
+            tail++;
+            continue;
+        }
+        const bool signed_frame = v2 && (p[2] & MAVLINK_IFLAG_SIGNED);
+        const uint16_t frame_len = header_len + len + MAVLINK_NUM_CHECKSUM_BYTES +
+                                   (signed_frame ? MAVLINK_SIGNATURE_BLOCK_LEN : 0);
+        const uint32_t msgid = v2 ? (p[7] | (p[8]<<8) | (uint32_t(p[9])<<16)) : p[5];
+
+        const mavlink_msg_entry_t *entry = mavlink_get_msg_entry(msgid);
+        if (entry != nullptr && len > entry->max_msg_len) {
+            tail++;
+            continue;
+        }
+        if (avail < frame_len) {
+            compact();
+            return false;
+        }
+        if (entry == nullptr) {
+            unknown++;
+            tail += frame_len;
+            continue;
+        }
+
+        uint16_t crc = crc_calculate(&p[1], header_len - 1 + len);
+        crc_accumulate(entry->crc_extra, &crc);
+        const uint8_t *ck = &p[header_len + len];
+        if (ck[0] != (crc & 0xFF) || ck[1] != (crc >> 8)) {
+            crc_errors++;
+            status.parse_error++;
+            tail++;
+            continue;
+        }
+
+        msg.magic = p[0];
+        msg.len = len;
+        if (v2) {
+            msg.incompat_flags = p[2];
+            msg.compat_flags = p[3];
+            msg.seq = p[4];
+            msg.sysid = p[5];
+            msg.compid = p[6];
+        } else {
+            msg.incompat_flags = 0;
+            msg.compat_flags = 0;
+            msg.seq = p[2];
+            msg.sysid = p[3];
+            msg.compid = p[4];
+        }
+        msg.msgid = msgid;
+        uint8_t *payload = (uint8_t *)msg.payload64;
+        memcpy(payload, &p[header_len], len);
+        if (len < entry->max_msg_len) {
+            // MAVLink 2 drops trailing zeros of the payload
+            memset(&payload[len], 0, entry->max_msg_len - len);
+        }
+        msg.checksum = crc;
+        msg.ck[0] = ck[0];
+        msg.ck[1] = ck[1];
+        if (signed_frame) {
+            memcpy(msg.signature, &ck[2], MAVLINK_SIGNATURE_BLOCK_LEN);
+        }
+        tail += frame_len;
+
+        if (status.signing != nullptr && !signature_ok(msg, signed_frame)) {
+            signature_errors++;
+            status.flags |= MAVLINK_STATUS_FLAG_IN_BADSIG;
+            continue;
+        }
+        if (signed_frame && status.signing != nullptr) {
+            status.flags = (status.flags & ~MAVLINK_STATUS_FLAG_IN_BADSIG) | MAVLINK_STATUS_FLAG_IN_SIGNED;
+        } else {
+            status.flags &= ~(MAVLINK_STATUS_FLAG_IN_SIGNED | MAVLINK_STATUS_FLAG_IN_BADSIG);
+        }
+
+        // count gaps in the sequence as drops, like the byte parser
+        const uint8_t expected_seq = status.current_rx_seq + 1;
+        if (status.packet_rx_success_count != 0 && msg.seq != expected_seq) {
+            status.packet_rx_drop_count += uint8_t(msg.seq - expected_seq);
+        }
+        status.current_rx_seq = msg.seq;
+        status.packet_rx_success_count++;
+        status.msg_received = 1;
+        return true;
+    }
+}
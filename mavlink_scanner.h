@@ -0,0 +1,68 @@
+/*
+  bulk MAVLink frame scanner
+ */
+#pragma once
+
+#include "mavlink_msgs.h"
+
+/*
+  receive bytes straight into the scanner buffer, then pull complete
+  frames. The scanner jumps from one STX to the next and checks the
+  CRC of a whole frame in place, so the per byte cost is a compare
+  instead of a parser state transition
+ */
+class MAVLink_Scanner {
+public:
+    // free space to receive into, and the number of bytes put there
+    uint8_t *write_ptr(void) {
+        return &buf[head];
+    }
+    uint16_t write_space(void) const {
+        return BUF_SIZE - head;
+    }
+    void written(uint16_t n) {
+        head += n;
+    }
+
+    /*
+      the next frame with a good CRC, false once the buffer holds no
+      complete frame. Truncated MAVLink 2 payloads are zero filled
+     */
+    bool next(mavlink_message_t &msg);
+
+    mavlink_status_t &get_status(void) {
+        return status;
+    }
+    uint32_t get_crc_errors(void) const {
+        return crc_errors;
+    }
+    // frames dropped for a bad or missing signature while signing
+    uint32_t get_signature_errors(void) const {
+        return signature_errors;
+    }
+    // frames with a msgid we have no CRC extra for, skipped whole
+    uint32_t get_unknown(void) const {
+        return unknown;
+    }
+    // bytes discarded while looking for an STX
+    uint32_t get_skipped(void) const {
+        return skipped;
+    }
+
+private:
+    // holds a partial frame of up to 280 bytes plus a read
+    static constexpr uint16_t BUF_SIZE = 512;
+    uint8_t buf[BUF_SIZE];
+    uint16_t head;
+    uint16_t tail;
+
+    mavlink_status_t status;
+    uint32_t crc_errors;
+    uint32_t unknown;
+    uint32_t skipped;
+    uint32_t signature_errors;
+
+    // move a partial frame to the start of the buffer
+    void compact(void);
+    bool signature_ok(const mavlink_message_t &msg, bool signed_frame);
+};
@@ -0,0 +1,125 @@
+/*
+  non-blocking MAVLink transmit queue
+
+  HardwareSerial::write() blocks until the frame fits in the UART TX
+  FIFO. At 57600 baud a param list or a burst of STATUSTEXT holds the
+  ingest task for tens of milliseconds, delaying RemoteID updates.
+  Instead each frame is put in one of three byte queues, prefixed by
+  its length, and drain() writes from the highest priority queue no
+  more than availableForWrite() bytes at a time. A frame, once
+  started, is finished before switching queue so frames never
+  interleave on the wire.
+ */
+
+#include "mavlink_tx_queue.h"
+#include "mavlink_msgs.h"
+
+static MAVLink_TX_Queue *queues[MAVLINK_COMM_NUM_BUFFERS];
+
+MAVLink_TX_Queue::MAVLink_TX_Queue(HardwareSerial &_serial, uint8_t chan) :
+    serial(_serial)
+{
+    queues[chan] = this;
+}
+
+MAVLink_TX_Queue *MAVLink_TX_Queue::for_channel(uint8_t chan)
+{
+    return chan < MAVLINK_COMM_NUM_BUFFERS ? queues[chan] : nullptr;
+}
+
+/*
+  priority of a frame from the msgid in its header
+ */
+MAVLink_TX_Queue::Priority MAVLink_TX_Queue::classify(const uint8_t *header, uint16_t len)
+{
+    uint32_t msgid;
+    if (header[0] == MAVLINK_STX && len >= MAVLINK_NUM_HEADER_BYTES) {
+        msgid = header[7] | (header[8]<<8) | (uint32_t(header[9])<<16);
+    } else if (header[0] == MAVLINK_STX_MAVLINK1 && len >= MAVLINK_CORE_HEADER_MAVLINK1_LEN + 1) {
+        msgid = header[5];
+    } else {
+        return Priority::TEXT;
+    }
+    switch (msgid) {
+    case MAVLINK_MSG_ID_HEARTBEAT:
+    case MAVLINK_MSG_ID_OPEN_DRONE_ID_ARM_STATUS:
+        return Priority::STATUS;
+    case MAVLINK_MSG_ID_PARAM_VALUE:
+    case MAVLINK_MSG_ID_SECURE_COMMAND_REPLY:
+        return Priority::PARAM;
+    default:
+        return Priority::TEXT;
+    }
+}
+
+void MAVLink_TX_Queue::start_frame(uint16_t len)
+{
+    frame_len = len;
+    frame_started = false;
+    dropping = false;
+}
+
+void MAVLink_TX_Queue::append(const uint8_t *buf, uint16_t len)
+{
+    if (!frame_started) {
+        // the header comes first and tells us where the frame goes
+        frame_started = true;
+        frame_priority = classify(buf, len);
+        auto &q = queue[uint8_t(frame_priority)];
+        if (q.space() < frame_len + 2U) {
+            dropping = true;
+            dropped[uint8_t(frame_priority)]++;
+            return;
+        }
+        const uint8_t prefix[2] { uint8_t(frame_len & 0xFF), uint8_t(frame_len >> 8) };
+        q.write(prefix, sizeof(prefix));
+    }
+    if (!dropping) {
+        queue[uint8_t(frame_priority)].write(buf, len);
+    }
+}
+
+void MAVLink_TX_Queue::end_frame(void)
+{
+    frame_started = false;
+    drain();
+}
+
+void MAVLink_TX_Queue::drain(void)
+{
+    while (true) {
+        const int room = serial.availableForWrite();
+        if (room <= 0) {
+            return;
+        }
+        if (out_left == 0) {
+            // pick the next frame, highest priority first
+            uint8_t p = 0;
+            while (p < NUM_PRIORITIES && queue[p].available() == 0) {
+                p++;
+            }
+            if (p == NUM_PRIORITIES) {
+                return;
+            }
+            uint8_t prefix[2];
+            queue[p].read(prefix, sizeof(prefix));
+            out_priority = Priority(p);
+            out_left = prefix[0] | (prefix[1]<<8);
+        }
+        uint8_t buf[64];
+        uint16_t n = out_left;
+        if (n > sizeof(buf)) {
+            n = sizeof(buf);
+        }
+        if (n > uint16_t(room)) {
+            n = room;
+        }
+        n = queue[uint8_t(out_priority)].read(buf, n);
+        serial.write(buf, n);
+        out_left -= n;
+        if (out_left == 0) {
+            // counted once it is on the wire, not when queued
+            sent[uint8_t(out_priority)]++;
+        }
+    }
+}
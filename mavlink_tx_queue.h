@@ -0,0 +1,75 @@
+/*
+  non-blocking MAVLink transmit queue
+ */
+#pragma once
+
+#include <Arduino.h>
+#include "ring_buffer.h"
+
+/*
+  frames sent on a channel are queued by priority and written only as
+  fast as the UART takes them, so a slow link never blocks the caller.
+  A frame that doesn't fit its queue is dropped whole and counted
+ */
+class MAVLink_TX_Queue {
+public:
+    enum class Priority : uint8_t {
+        STATUS = 0,     // heartbeat and arm status
+        PARAM,          // parameter and secure command replies
+        TEXT,           // STATUSTEXT and anything else
+        COUNT
+    };
+
+    MAVLink_TX_Queue(HardwareSerial &_serial, uint8_t chan);
+
+    /*
+      called by the generated send functions: start_frame() with the
+      frame length, then the frame in pieces, header first, then
+      end_frame()
+     */
+    void start_frame(uint16_t len);
+    void append(const uint8_t *buf, uint16_t len);
+    void end_frame(void);
+
+    // write queued bytes while the UART has room for them
+    void drain(void);
+
+    // part of a frame is still to be written
+    bool mid_frame(void) const {
+        return out_left != 0;
+    }
+
+    // frames written out whole, and frames dropped when queued
+    uint32_t get_sent(Priority p) const {
+        return sent[uint8_t(p)];
+    }
+    uint32_t get_dropped(Priority p) const {
+        return dropped[uint8_t(p)];
+    }
+
+    static MAVLink_TX_Queue *for_channel(uint8_t chan);
+
+private:
+    // each holds several frames of its kind, a secure command reply
+    // being the largest at 242 bytes
+    static constexpr uint32_t QUEUE_SIZE = 512;
+    static constexpr uint8_t NUM_PRIORITIES = uint8_t(Priority::COUNT);
+
+    HardwareSerial &serial;
+    Ring_Buffer<QUEUE_SIZE> queue[NUM_PRIORITIES];
+    uint32_t sent[NUM_PRIORITIES];
+    uint32_t dropped[NUM_PRIORITIES];
+
+    // frame being queued, its length and where it goes; dropping is
+    // set when it didn't fit
+    uint16_t frame_len;
+    Priority frame_priority;
+    bool frame_started;
+    bool dropping;
+
+    // frame being written out, bytes left of it
+    Priority out_priority;
+    uint16_t out_left;
+
+    static Priority classify(const uint8_t *header, uint16_t len);
+};
@@ -0,0 +1,270 @@
+/*
+  streaming NMEA 0183 parser
+
+  A byte at a time state machine in the style of the ArduPilot NMEA
+  driver: each comma separated term is collected in a small buffer and
+  decoded as soon as it ends, into a pending copy of the fix. When the
+  checksum at the end of the sentence matches, the pending fix becomes
+  the current one. Nothing is allocated and unknown sentences are
+  skipped after their first term, so the cost per byte is a few
+  compares.
+
+  Supported sentences from any talker (GP, GN, GL, GA, GB):
+  GGA, RMC, GSA, VTG and GST.
+ */
+
+#include "nmea.h"
+#include <string.h>
+#include <math.h>
+
+#define KNOTS_TO_MS 0.514444f
+#define KMH_TO_MS   (1.0f/3.6f)
+
+// true if s is a non-empty decimal number
+static bool is_number(const char *s)
+{
+    if (*s == '-') {
+        s++;
+    }
+    return (*s >= '0' && *s <= '9') || (*s == '.' && s[1] >= '0' && s[1] <= '9');
+}
+
+/*
+  parse a decimal number without strtod. NMEA numbers have at most a
+  handful of fractional digits
+ */
+static double parse_decimal(const char *s)
+{
+    bool negative = false;
+    if (*s == '-') {
+        negative = true;
+        s++;
+    }
+    uint32_t ipart = 0;
+    while (*s >= '0' && *s <= '9') {
+        ipart = ipart*10 + (*s++ - '0');
+    }
+    uint32_t fpart = 0;
+    uint32_t scale = 1;
+    if (*s == '.') {
+        s++;
+        while (*s >= '0' && *s <= '9' && scale < 1000000000U) {
+            fpart = fpart*10 + (*s++ - '0');
+            scale *= 10;
+        }
+    }
+    const double v = ipart + double(fpart) / scale;
+    return negative ? -v : v;
+}
+
+static uint8_t hex_digit(char c)
+{
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    return 0xFF;
+}
+
+// ddmm.mmmm or dddmm.mmmm to degrees
+static double parse_angle(const char *s)
+{
+    const double v = parse_decimal(s);
+    const int deg = int(v / 100);
+    return deg + (v - deg*100) / 60.0;
+}
+
+// hhmmss.ss to ms of day
+static uint32_t parse_time(const char *s)
+{
+    const double v = parse_decimal(s);
+    const uint32_t hhmmss = uint32_t(v);
+    const uint32_t h = hhmmss / 10000;
+    const uint32_t m = (hhmmss / 100) % 100;
+    const uint32_t sec = hhmmss % 100;
+    return ((h*60 + m)*60 + sec)*1000 + uint32_t((v - hhmmss) * 1000 + 0.5);
+}
+
+void NMEA_Parser::start_sentence(void)
+{
+    in_sentence = true;
+    in_checksum = false;
+    checksum = 0;
+    term_len = 0;
+    term_number = 0;
+    sentence = 0;
+    pending = fix;
+}
+
+bool NMEA_Parser::feed(char c)
+{
+    if (c == '$') {
+        start_sentence();
+        return false;
+    }
+    if (!in_sentence) {
+        return false;
+    }
+
+    switch (c) {
+    case ',':
+        if (in_checksum) {
+            in_sentence = false;
+            return false;
+        }
+        checksum ^= c;
+        end_term();
+        return false;
+
+    case '*':
+        if (in_checksum) {
+            in_sentence = false;
+            return false;
+        }
+        end_term();
+        in_checksum = true;
+        return false;
+
+    case '\r':
+    case '\n': {
+        in_sentence = false;
+        if (!in_checksum || term_len != 2) {
+            return false;
+        }
+        const uint8_t hi = hex_digit(term[0]);
+        const uint8_t lo = hex_digit(term[1]);
+        if (hi > 0xF || lo > 0xF || uint8_t((hi<<4) | lo) != checksum) {
+            checksum_errors++;
+            return false;
+        }
+        end_sentence();
+        return true;
+    }
+
+    default:
+        if (!in_checksum) {
+            checksum ^= c;
+        }
+        if (term_len >= TERM_SIZE-1) {
+            // no term we decode is this long, drop the sentence
+            in_sentence = false;
+            return false;
+        }
+        term[term_len++] = c;
+        return false;
+    }
+}
+
+void NMEA_Parser::end_term(void)
+{
+    term[term_len] = 0;
+    if (term_number == 0) {
+        // talker and sentence id, the talker is ignored
+        const char *id = term_len == 5 ? &term[2] : "";
+        if (strcmp(id, "GGA") == 0) {
+            sentence = GGA;
+        } else if (strcmp(id, "RMC") == 0) {
+            sentence = RMC;
+        } else if (strcmp(id, "GSA") == 0) {
+            sentence = GSA;
+        } else if (strcmp(id, "VTG") == 0) {
+            sentence = VTG;
+        } else if (strcmp(id, "GST") == 0) {
+            sentence = GST;
+        } else {
+            // not one of ours, skip the rest
+            in_sentence = false;
+        }
+    } else {
+        decode_term();
+    }
+    term_number++;
+    term_len = 0;
+}
+
+/*
+  decode the term just ended into the pending fix. Empty terms keep
+  the previous value
+ */
+void NMEA_Parser::decode_term(void)
+{
+    const bool number = is_number(term);
+    switch (sentence) {
+    case GGA:
+        switch (term_number) {
+        case 1: if (number) pending.time_ms = parse_time(term); break;
+        case 2: if (number) pending.latitude = parse_angle(term); break;
+        case 3: if (term[0] == 'S') pending.latitude = -fabs(pending.latitude); break;
+        case 4: if (number) pending.longitude = parse_angle(term); break;
+        case 5: if (term[0] == 'W') pending.longitude = -fabs(pending.longitude); break;
+        case 6:
+            pending.fix_quality = number ? uint8_t(parse_decimal(term)) : 0;
+            pending.valid = pending.fix_quality > 0;
+            break;
+        case 7: if (number) pending.num_sats = uint8_t(parse_decimal(term)); break;
+        case 8: if (number) pending.hdop = parse_decimal(term); break;
+        case 9: if (number) pending.altitude_msl = parse_decimal(term); break;
+        case 11: if (number) pending.geoid_sep = parse_decimal(term); break;
+        }
+        break;
+
+    case RMC:
+        switch (term_number) {
+        case 1: if (number) pending.time_ms = parse_time(term); break;
+        case 2: pending.valid = term[0] == 'A'; break;
+        case 3: if (number) pending.latitude = parse_angle(term); break;
+        case 4: if (term[0] == 'S') pending.latitude = -fabs(pending.latitude); break;
+        case 5: if (number) pending.longitude = parse_angle(term); break;
+        case 6: if (term[0] == 'W') pending.longitude = -fabs(pending.longitude); break;
+        case 7: if (number) pending.ground_speed = parse_decimal(term) * KNOTS_TO_MS; break;
+        case 8: if (number) pending.course = parse_decimal(term); break;
+        case 9: if (number) pending.date = uint32_t(parse_decimal(term)); break;
+        }
+        break;
+
+    case GSA:
+        switch (term_number) {
+        case 2: if (number) pending.fix_type = uint8_t(parse_decimal(term)); break;
+        case 16: if (number) pending.hdop = parse_decimal(term); break;
+        case 17: if (number) pending.vdop = parse_decimal(term); break;
+        }
+        break;
+
+    case VTG:
+        switch (term_number) {
+        case 1: if (number) pending.course = parse_decimal(term); break;
+        case 7: if (number) pending.ground_speed = parse_decimal(term) * KMH_TO_MS; break;
+        }
+        break;
+
+    case GST:
+        switch (term_number) {
+        // latitude sigma, combined with the longitude sigma next
+        case 6: pending.horiz_accuracy = number ? parse_decimal(term) : 0; break;
+        case 7:
+            if (number) {
+                const float lon_sd = parse_decimal(term);
+                const float lat_sd = pending.horiz_accuracy;
+                pending.horiz_accuracy = sqrtf(lat_sd*lat_sd + lon_sd*lon_sd);
+            }
+            break;
+        case 8: if (number) pending.vert_accuracy = parse_decimal(term); break;
+        }
+        break;
+    }
+}
+
+void NMEA_Parser::end_sentence(void)
+{
+    if (sentence == 0) {
+        return;
+    }
+    fix = pending;
+    updated |= sentence;
+    sentences++;
+}
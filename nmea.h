@@ -0,0 +1,67 @@
+/*
+  streaming NMEA 0183 parser for the GNSS receiver
+ */
+#pragma once
+
+#include <stdint.h>
+#include "gnss.h"
+
+class NMEA_Parser {
+public:
+    // sentences the parser understands, as bits of get_updated()
+    enum Sentence : uint8_t {
+        GGA = 1U<<0,
+        RMC = 1U<<1,
+        GSA = 1U<<2,
+        VTG = 1U<<3,
+        GST = 1U<<4,
+    };
+
+    /*
+      feed one byte of the stream. Fields are decoded as they arrive
+      and committed to the fix only when the sentence checksum
+      matches. Returns true when a supported sentence completed
+     */
+    bool feed(char c);
+
+    const GNSS_Fix &get_fix(void) const {
+        return fix;
+    }
+
+    // sentences completed since the last call, clearing them
+    uint8_t get_updated(void) {
+        const uint8_t ret = updated;
+        updated = 0;
+        return ret;
+    }
+
+    uint32_t get_sentences(void) const {
+        return sentences;
+    }
+    uint32_t get_checksum_errors(void) const {
+        return checksum_errors;
+    }
+
+private:
+    GNSS_Fix fix;
+    // fields of the sentence in progress, committed on a good checksum
+    GNSS_Fix pending;
+
+    static constexpr uint8_t TERM_SIZE = 16;
+    char term[TERM_SIZE];
+    uint8_t term_len;
+    uint8_t term_number;
+    uint8_t sentence;
+    uint8_t checksum;
+    bool in_sentence;
+    bool in_checksum;
+    uint8_t updated;
+
+    uint32_t sentences;
+    uint32_t checksum_errors;
+
+    void start_sentence(void);
+    void end_term(void);
+    void end_sentence(void);
+    void decode_term(void);
+};
@@ -0,0 +1,118 @@
+/*
+  per-tick encoded OpenDroneID snapshot
+
+  The WiFi beacon, WiFi NAN and both BLE transmitters send the same
+  messages. Encoding them here once per tick means each transmitter
+  only copies already encoded bytes into its frame.
+
+  Each slot keeps its encoding until its source marks it dirty, so in
+  steady state only the Location message (whose timestamp moves every
+  tick) is re-encoded and the pack is only rebuilt when a slot changed.
+ */
+
+#include <Arduino.h>
+#include "odid_snapshot.h"
+
+ODID_Snapshot odid_snapshot;
+
+/*
+  re-encode one slot if it is dirty or its valid flag changed. Returns
+  true if the encoded bytes or the slot validity changed
+ */
+bool ODID_Snapshot::encode(Slot slot, uint8_t valid, void *data)
+{
+    const uint8_t bit = slot_bit(slot);
+    if (!valid) {
+        const bool was_valid = (valid_mask & bit) != 0;
+        valid_mask &= ~bit;
+        return was_valid;
+    }
+    if ((valid_mask & bit) && !(dirty_mask & bit)) {
+        // cached encoding is still current
+        return false;
+    }
+
+    uint8_t *msg = messages[uint8_t(slot)];
+    int ret = ODID_FAIL;
+    switch (slot) {
+    case Slot::BASIC_ID:
+    case Slot::BASIC_ID_2:
+        ret = encodeBasicIDMessage((ODID_BasicID_encoded *)msg, (ODID_BasicID_data *)data);
+        break;
+    case Slot::LOCATION:
+        ret = encodeLocationMessage((ODID_Location_encoded *)msg, (ODID_Location_data *)data);
+        break;
+    case Slot::SELF_ID:
+        ret = encodeSelfIDMessage((ODID_SelfID_encoded *)msg, (ODID_SelfID_data *)data);
+        break;
+    case Slot::SYSTEM:
+        ret = encodeSystemMessage((ODID_System_encoded *)msg, (ODID_System_data *)data);
+        break;
+    case Slot::OPERATOR_ID:
+        ret = encodeOperatorIDMessage((ODID_OperatorID_encoded *)msg, (ODID_OperatorID_data *)data);
+        break;
+    case Slot::COUNT:
+        break;
+    }
+    encode_count++;
+    bytes_last_tick += ODID_MESSAGE_SIZE;
+
+    if (ret == ODID_SUCCESS) {
+        valid_mask |= bit;
+    } else {
+        valid_mask &= ~bit;
+    }
+    return true;
+}
+
+void ODID_Snapshot::update(ODID_UAS_Data &UAS_data)
+{
+    bytes_last_tick = 0;
+    bool changed = false;
+
+    changed |= encode(Slot::BASIC_ID, UAS_data.BasicIDValid[0], &UAS_data.BasicID[0]);
+    changed |= encode(Slot::BASIC_ID_2, UAS_data.BasicIDValid[1], &UAS_data.BasicID[1]);
+    changed |= encode(Slot::LOCATION, UAS_data.LocationValid, &UAS_data.Location);
+    changed |= encode(Slot::SELF_ID, UAS_data.SelfIDValid, &UAS_data.SelfID);
+    changed |= encode(Slot::SYSTEM, UAS_data.SystemValid, &UAS_data.System);
+    changed |= encode(Slot::OPERATOR_ID, UAS_data.OperatorIDValid, &UAS_data.OperatorID);
+
+    if (dirty_mask & slot_bit(Slot::BASIC_ID)) {
+        memset(uas_id, 0, sizeof(uas_id));
+        strncpy(uas_id, UAS_data.BasicID[0].UASID, ODID_ID_SIZE);
+    }
+    dirty_mask = 0;
+
+    if (changed) {
+        build_pack();
+        bytes_last_tick += pack_length;
+        sequence++;
+    }
+
+    const uint32_t now_ms = millis();
+    if (now_ms - encode_window_start_ms >= 1000) {
+        encodes_per_second = encode_count;
+        encode_count = 0;
+        encode_window_start_ms = now_ms;
+    }
+}
+
+/*
+  build the message pack from the encoded slots. Layout is the same as
+  ODID_MessagePack_encoded: a 3 byte header followed by the messages
+ */
+void ODID_Snapshot::build_pack(void)
+{
+    uint8_t count = 0;
+    for (uint8_t i=0; i<uint8_t(Slot::COUNT); i++) {
+        if (!(valid_mask & (1U<<i))) {
+            continue;
+        }
+        memcpy(&pack[3 + count*ODID_MESSAGE_SIZE], messages[i], ODID_MESSAGE_SIZE);
+        count++;
+    }
+    pack[0] = (ODID_MESSAGETYPE_PACKED << 4) | ODID_PROTOCOL_VERSION;
+    pack[1] = ODID_MESSAGE_SIZE;
+    pack[2] = count;
+    pack_length = count > 0 ? 3 + count*ODID_MESSAGE_SIZE : 0;
+}
@@ -0,0 +1,113 @@
+/*
+  per-tick encoded OpenDroneID snapshot, shared by all transmitters
+ */
+#pragma once
+
+#include <stdint.h>
+#include <opendroneid.h>
+#include "semaphore.h"
+
+// size of an encoded message pack holding ODID_PACK_MAX_MESSAGES messages
+#define ODID_PACK_BUFFER_SIZE (3 + ODID_PACK_MAX_MESSAGES*ODID_MESSAGE_SIZE)
+
+class ODID_Snapshot {
+public:
+    // message slots held in the snapshot, in message pack order
+    enum class Slot : uint8_t {
+        BASIC_ID = 0,
+        BASIC_ID_2,
+        LOCATION,
+        SELF_ID,
+        SYSTEM,
+        OPERATOR_ID,
+        COUNT
+    };
+
+    static constexpr uint8_t slot_bit(Slot slot) {
+        return uint8_t(1U<<uint8_t(slot));
+    }
+    static constexpr uint8_t ALL_SLOTS = (1U<<uint8_t(Slot::COUNT))-1;
+
+    /*
+      handoff between tasks: producers hold this semaphore while they
+      write UAS_data and mark slots dirty, the TX task holds it while
+      update() encodes. The encoded messages and pack are then only
+      read by the TX task, so transmitting needs no lock
+     */
+    Semaphore &get_semaphore(void) {
+        return sem;
+    }
+
+    /*
+      mark slots whose source data changed. Only dirty slots are
+      re-encoded on the next update()
+     */
+    void mark_dirty(uint8_t mask) {
+        dirty_mask |= mask;
+    }
+    bool is_dirty(Slot slot) const {
+        return (dirty_mask & slot_bit(slot)) != 0;
+    }
+    bool any_dirty(void) const {
+        return dirty_mask != 0;
+    }
+
+    /*
+      encode the dirty valid messages in UAS_data and rebuild the
+      message pack if anything changed. Called once per tick, the
+      transmitters only read the result
+     */
+    void update(ODID_UAS_Data &UAS_data);
+
+    // encoded 25 byte message for a slot, or nullptr if not valid
+    const uint8_t *get_message(Slot slot) const {
+        const uint8_t i = uint8_t(slot);
+        return (valid_mask & (1U<<i)) ? messages[i] : nullptr;
+    }
+
+    const uint8_t *get_pack(void) const {
+        return pack;
+    }
+    uint8_t get_pack_length(void) const {
+        return pack_length;
+    }
+
+    const char *get_uas_id(void) const {
+        return uas_id;
+    }
+
+    // incremented whenever the pack changes, lets transmitters spot new data
+    uint32_t get_sequence(void) const {
+        return sequence;
+    }
+
+    // number of single message encodes over the last full second
+    uint16_t get_encodes_per_second(void) const {
+        return encodes_per_second;
+    }
+
+    // bytes encoded or copied by the last update
+    uint16_t get_bytes_last_tick(void) const {
+        return bytes_last_tick;
+    }
+
+private:
+    Semaphore sem;
+    uint8_t messages[uint8_t(Slot::COUNT)][ODID_MESSAGE_SIZE];
+    uint8_t valid_mask;
+    uint8_t dirty_mask = ALL_SLOTS;
+    uint8_t pack[ODID_PACK_BUFFER_SIZE];
+    uint8_t pack_length;
+    char uas_id[ODID_ID_SIZE+1];
+    uint32_t sequence;
+
+    uint16_t encode_count;
+    uint16_t encodes_per_second;
+    uint32_t encode_window_start_ms;
+    uint16_t bytes_last_tick;
+
+    bool encode(Slot slot, uint8_t valid, void *data);
+    void build_pack(void);
+};
+
+extern ODID_Snapshot odid_snapshot;
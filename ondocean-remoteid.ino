@@ -17,6 +17,15 @@
 #endif
 #include "WiFi_TX.h"
 #include "BLE_TX.h"
+#include "odid_snapshot.h"
+#include "tx_scheduler.h"
+#include "rid_task.h"
+#include "stage_timing.h"
+#include "power.h"
+#include "nmea.h"
+#include "ubx.h"
+#include "uart_ingest.h"
+#include "util.h"
 #include <esp_wifi.h>
 #include <WiFi.h>
 #include "parameters.h"
@@ -25,6 +34,7 @@
 #include <esp_ota_ops.h>
 #include "efuse.h"
 #include "led.h"
+#include "pattern.h"
 #include <ArduinoJson.h>
 #include <PubSubClient.h>
 #include <HardwareSerial.h>
@@ -32,6 +42,7 @@
 // OndOcean Maritime specific includes
 #include "board_config_maritime.h"
 #include "maritime_sensors.h"
+#include "sensor_manager.h"
 #include "ondocean_mqtt.h"
 #include "data_validation.h"
 #include "ondocean_logger.h"
@@ -45,14 +56,16 @@ static DroneCAN dronecan;
 #if AP_MAVLINK_ENABLED
 static MAVLinkSerial mavlink1{Serial1, MAVLINK_COMM_0};
 static MAVLinkSerial mavlink2{Serial,  MAVLINK_COMM_1};
+static UART_Ingest mavlink_rx{"mavlink", Serial1};
 #endif
 
-static WiFi_TX wifi;
+WiFi_TX wifi;
 static BLE_TX ble;
 static Parameters parameters;
 
 // OndOcean Maritime components
 static HardwareSerial gnssSerial(1);  // UART1 for GNSS
+static UART_Ingest gnss_rx{"gnss", gnssSerial};
 static WiFiClient wifiClient;
 static PubSubClient mqttClient(wifiClient);
 static WebInterface webif;
@@ -67,6 +80,27 @@ extern mavlink_system_t mavlink_system;
 String status_reason;
 static uint32_t last_location_ms;
 static uint32_t last_mqtt_publish_ms;
+static uint32_t last_mqtt_diagnostics_ms;
+
+/*
+  one task per subsystem. Radio TX gets the highest priority on core 1,
+  GNSS and MAVLink ingestion is woken by the UART receive callbacks and
+  the sensor/ODID data tick runs at 10Hz below it. MQTT, the web
+  interface and monitoring run on core 0 so a slow reconnect or web
+  request can't delay RemoteID emission, and the sensor I2C transfers
+  run there too, woken when the data tick queues them
+ */
+static void tx_task_run(void);
+static void ingest_task_run(void);
+static void data_task_run(void);
+static void services_task_run(void);
+static void i2c_task_run(void);
+
+static RID_Task task_tx{"tx", tx_task_run, 1, 1, 20, 4096};
+static RID_Task task_ingest{"ingest", ingest_task_run, 10, 1, 15, 6144};
+static RID_Task task_data{"data", data_task_run, 100, 1, 10, 4096};
+static RID_Task task_services{"services", services_task_run, 10, 0, 5, 8192};
+static RID_Task task_i2c{"i2c", i2c_task_run, 100, 0, 8, 4096};
 
 // Maritime configuration
 struct MaritimeConfig {
@@ -83,8 +117,18 @@ struct MaritimeConfig {
     double longitude = 0.0;
     float altitude = 0.0;
     float accuracy = 0.0;
+    float ground_speed = 0.0;
+    float course = 0.0;
+    uint8_t satellites = 0;
     bool position_valid = false;
     
+    // Vessel attitude from the AHRS, heading magnetic
+    float heading = 0.0;
+    float pitch = 0.0;
+    float roll = 0.0;
+    bool attitude_valid = false;
+    bool heading_valid = false;
+    
     // Environmental sensors
     float temperature = 0.0;
     float humidity = 0.0;
@@ -129,6 +173,10 @@ void setup() {
     
     // Load maritime configuration
     load_maritime_config();
+    odid_initUasData(&UAS_data);
+    
+    // Initialize parameters system, GNSS setup depends on GNSS_TYPE
+    parameters.init();
     
     // Initialize GNSS
     if (maritime_config.gnss_required) {
@@ -138,9 +186,6 @@ void setup() {
     // Initialize environmental sensors
     setup_maritime_sensors();
     
-    // Initialize parameters system
-    parameters.init();
-    
     // Initialize LED system
     led_init();
     led_set_color(LED_COLOR_BLUE);  // Maritime mode indicator
@@ -171,9 +216,28 @@ void setup() {
     
     // Maritime startup sequence
     maritime_startup_sequence();
-    
+
+    // UART receive events fill the rings and wake ingestion instead of
+    // polling the drivers
+    gnss_rx.start(task_ingest);
+#if AP_MAVLINK_ENABLED
+    mavlink_rx.start(task_ingest);
+    mavlink1.set_ingest(mavlink_rx);
+#endif
+
+    sensor_bus.start(task_i2c);
+
+    // fill UAS_data before the TX task takes its first snapshot
+    update_remoteid_data();
+
+    task_tx.start();
+    task_ingest.start();
+    task_data.start();
+    task_services.start();
+    task_i2c.start();
+
+    // the startup pattern leaves the LED green
     Serial.println("OndOcean RemoteID Maritime - Ready");
-    led_set_color(LED_COLOR_GREEN);
 }
 
 void setup_maritime_hardware() {
@@ -201,14 +265,59 @@ void setup_maritime_hardware() {
     Serial.println("Maritime hardware initialized");
 }
 
+static NMEA_Parser nmea;
+static UBX_Parser ubx;
+static bool gnss_ubx;
+
+/*
+  switch the u-blox to UBX NAV-PVT output at GNSS_UBX_BAUDRATE. The
+  receiver may be at its factory speed or already configured, so the
+  configuration goes out at each likely rate, then is repeated at the
+  new rate and must be acknowledged there
+ */
+static bool configure_ubx() {
+    uint8_t frame[80];
+    const size_t len = UBX_Parser::build_config(frame, sizeof(frame), GNSS_UBX_BAUDRATE, GNSS_RATE_HZ);
+    static const uint32_t baudrates[] = { 9600, 38400, GNSS_UBX_BAUDRATE };
+    for (const uint32_t baudrate : baudrates) {
+        gnssSerial.updateBaudRate(baudrate);
+        gnssSerial.write(frame, len);
+        gnssSerial.flush();
+        delay(50);
+    }
+
+    gnssSerial.updateBaudRate(GNSS_UBX_BAUDRATE);
+    const size_t len2 = UBX_Parser::build_config(frame, sizeof(frame), 0, GNSS_RATE_HZ);
+    for (uint8_t attempt=0; attempt<3; attempt++) {
+        gnssSerial.write(frame, len2);
+        const uint32_t start_ms = millis();
+        while (millis() - start_ms < 300) {
+            bool acked;
+            while (gnssSerial.available()) {
+                ubx.feed(gnssSerial.read());
+            }
+            if (ubx.get_ack(UBX_Parser::CLASS_CFG, UBX_Parser::MSG_CFG_VALSET, acked)) {
+                return acked;
+            }
+            delay(5);
+        }
+    }
+    return false;
+}
+
 void setup_gnss() {
     gnssSerial.begin(9600, SERIAL_8N1, PIN_GNSS_RX, PIN_GNSS_TX);
     
-    // Configure u-blox for maritime use
-    // Send UBX configuration commands for optimal maritime performance
-    delay(1000);
+    // Configure u-blox for maritime use: NAV-PVT only, sea dynamic model
+    if (g.gnss_type == 1) {
+        gnss_ubx = configure_ubx();
+        if (!gnss_ubx) {
+            Serial.println("GNSS: no UBX acknowledgement, using NMEA at 9600");
+            gnssSerial.updateBaudRate(9600);
+        }
+    }
     
-    Serial.println("GNSS initialized for maritime use");
+    Serial.printf("GNSS initialized for maritime use (%s)\n", gnss_ubx ? "UBX" : "NMEA");
 }
 
 void setup_wifi() {
@@ -227,10 +336,13 @@ void setup_wifi() {
 void setup_mqtt() {
     mqttClient.setServer(maritime_config.mqtt_broker.c_str(), maritime_config.mqtt_port);
     mqttClient.setCallback(mqtt_callback);
+    // room for the data and diagnostics JSON, the default is 256 bytes
+    mqttClient.setBufferSize(2048);
     
     // Generate device ID from MAC
     maritime_config.device_id = "ONRID-" + WiFi.macAddress();
     maritime_config.device_id.replace(":", "");
+    odid_snapshot.mark_dirty(ODID_Snapshot::slot_bit(ODID_Snapshot::Slot::BASIC_ID));
     
     Serial.println("MQTT configured: " + maritime_config.mqtt_broker);
 }
@@ -259,22 +371,23 @@ void process_maritime_command(String command) {
     } else if (doc["action"] == "low_power") {
         maritime_config.low_power_mode = doc["enabled"];
     } else if (doc["action"] == "update_position") {
-        maritime_config.latitude = doc["lat"];
-        maritime_config.longitude = doc["lon"];
+        const double lat = doc["lat"];
+        const double lon = doc["lon"];
+        WITH_SEMAPHORE(odid_snapshot.get_semaphore());
+        if (lat != maritime_config.latitude || lon != maritime_config.longitude) {
+            // operator position in the System message follows the vessel
+            odid_snapshot.mark_dirty(ODID_Snapshot::slot_bit(ODID_Snapshot::Slot::LOCATION) |
+                                     ODID_Snapshot::slot_bit(ODID_Snapshot::Slot::SYSTEM));
+        }
+        maritime_config.latitude = lat;
+        maritime_config.longitude = lon;
         maritime_config.position_valid = true;
     }
 }
 
 void activate_emergency_beacon() {
-    // Maritime emergency beacon
-    led_set_color(LED_COLOR_RED);
-    
-    for (int i = 0; i < 5; i++) {
-        digitalWrite(PIN_BUZZER, HIGH);
-        delay(200);
-        digitalWrite(PIN_BUZZER, LOW);
-        delay(200);
-    }
+    // Maritime emergency beacon, red LED and five buzzer pulses
+    pattern_player.play(PATTERN_EMERGENCY);
     
     // Increase transmission power and frequency
     // TODO: Implement emergency mode for WiFi and BLE transmitters
@@ -288,154 +401,360 @@ void maritime_startup_sequence() {
     Serial.println("Maritime startup sequence...");
     
     // Check case integrity
-    maritime_config.case_closed = !digitalRead(PIN_CASE_DETECT);
+    MaritimeSensorData data;
+    sensor_manager.get(data);
+    maritime_config.case_closed = !data.case_tamper_detected;
     maritime_config.waterproof_sealed = maritime_config.case_closed;
     
-    // LED startup pattern
-    for (int i = 0; i < 3; i++) {
-        led_set_color(LED_COLOR_BLUE);
-        delay(200);
-        led_set_color(LED_COLOR_OFF);
-        delay(200);
-    }
-    
-    // Buzzer confirmation
-    digitalWrite(PIN_BUZZER, HIGH);
-    delay(100);
-    digitalWrite(PIN_BUZZER, LOW);
-    
+    // LED startup pattern and buzzer confirmation, played by the TX
+    // task once it runs
+    pattern_player.play(PATTERN_STARTUP);
+
     Serial.println("Maritime startup sequence completed");
 }
 
 void loop() {
-    static uint32_t last_update_ms = 0;
-    uint32_t now_ms = millis();
-    
-    // Update at 10Hz
-    if (now_ms - last_update_ms >= 100) {
-        last_update_ms = now_ms;
-        
-        // Read maritime sensors
-        update_maritime_sensors();
-        
-        // Read GNSS data
-        if (maritime_config.gnss_required) {
-            update_gnss_data();
+    // all work runs in the subsystem tasks started by setup()
+    vTaskDelete(nullptr);
+}
+
+/*
+  radio TX task: encode the slots the producers marked dirty, then send
+  whatever transmitters are due
+ */
+static void tx_task_run(void) {
+    {
+        WITH_SEMAPHORE(odid_snapshot.get_semaphore());
+        if (odid_snapshot.any_dirty()) {
+            STAGE_TIME("odid_encode");
+            odid_snapshot.update(UAS_data);
         }
-        
-        // Update RemoteID data structure
-        update_remoteid_data();
-        
-        // Transmit RemoteID
+    }
+
+    // Transmit RemoteID, each radio at its own configured rate
+    {
+        STAGE_TIME("transmit_remoteid");
         transmit_remoteid();
-        
-        // MQTT publishing (1Hz)
-        if (maritime_config.mqtt_enabled && (now_ms - last_mqtt_publish_ms >= 1000)) {
-            publish_mqtt_data();
-            last_mqtt_publish_ms = now_ms;
-        }
-        
-        // Update status LED
-        update_status_led();
     }
-    
+
+    // buzzer and LED patterns never hold up transmission
+    const uint32_t now_ms = millis();
+    pattern_player.update(now_ms);
+
+    // sleep until the next TX slot, or the next pattern step tick.
+    // The data task notifies us when new data arrives
+    const uint32_t due_ms[] {
+        tx_scheduler.ms_until_due(now_ms),
+        pattern_player.active() ? 10U : UINT32_MAX,
+    };
+    const uint32_t wait_ms = Power_Manager::next_wake_ms(due_ms, ARRAY_SIZE(due_ms), 100);
+    task_tx.set_period_ms(wait_ms > 0 ? wait_ms : 1);
+}
+
+/*
+  GNSS and MAVLink ingestion, woken by the UART receive callbacks
+ */
+static void ingest_task_run(void) {
+    // Read GNSS data
+    if (maritime_config.gnss_required) {
+        STAGE_TIME("update_gnss_data");
+        update_gnss_data();
+    }
+
+    // Handle transport protocols
+#if AP_DRONECAN_ENABLED
+    dronecan.update();
+#endif
+
+#if AP_MAVLINK_ENABLED
+    {
+        STAGE_TIME("mavlink1_update");
+        mavlink1.update();
+    }
+    {
+        STAGE_TIME("mavlink2_update");
+        mavlink2.update();
+    }
+#endif
+}
+
+/*
+  10Hz sensor and ODID data tick
+ */
+static void data_task_run(void) {
+    // Read maritime sensors
+    {
+        STAGE_TIME("update_maritime_sensors");
+        update_maritime_sensors();
+    }
+
+    // Update RemoteID data structure and hand it to the TX task
+    {
+        STAGE_TIME("update_remoteid_data");
+        update_remoteid_data();
+    }
+    task_tx.notify();
+
+    // Update status LED
+    update_status_led();
+}
+
+/*
+  MQTT, web interface and monitoring, off the radio core
+ */
+static void services_task_run(void) {
+    const uint32_t now_ms = millis();
+
     // Handle MQTT
     if (maritime_config.mqtt_enabled) {
         if (!mqttClient.connected()) {
+            STAGE_TIME("reconnect_mqtt");
             reconnect_mqtt();
         }
         mqttClient.loop();
+
+        // MQTT publishing (1Hz)
+        if (now_ms - last_mqtt_publish_ms >= 1000) {
+            STAGE_TIME("publish_mqtt_data");
+            publish_mqtt_data();
+            last_mqtt_publish_ms = now_ms;
+        }
+
+#if AP_STAGE_TIMING_ENABLED
+        // stage timing diagnostics, once per timing window
+        if (now_ms - last_mqtt_diagnostics_ms >= 10000) {
+            publish_mqtt_diagnostics();
+            last_mqtt_diagnostics_ms = now_ms;
+        }
+#endif
     }
-    
+
     // Handle web interface
-    webif.update();
-    
-    // Handle transport protocols
-#if AP_DRONECAN_ENABLED
-    dronecan.update();
-#endif
+    {
+        STAGE_TIME("webif_update");
+        webif.update();
+    }
+
+    // store batched parameter sets
+    {
+        STAGE_TIME("param_update");
+        g.update();
+    }
 
-#if AP_MAVLINK_ENABLED
-    mavlink1.update();
-    mavlink2.update();
-#endif
-    
     // Maritime-specific monitoring
     monitor_maritime_systems();
-    
+
     // Power management
-    if (maritime_config.low_power_mode) {
-        handle_low_power_mode();
-    }
+    handle_low_power_mode();
+}
+
+/*
+  sensor I2C transfers queued by the data tick
+ */
+static void i2c_task_run(void) {
+    sensor_bus.run();
 }
 
 void update_maritime_sensors() {
-    // Read environmental sensors
-    maritime_config.temperature = read_temperature();
-    maritime_config.humidity = read_humidity();
-    maritime_config.pressure = read_pressure();
-    
-    // Read battery voltage
-    maritime_config.battery_voltage = read_battery_voltage();
-    
-    // Check case status
-    maritime_config.case_closed = !digitalRead(PIN_CASE_DETECT);
+    // Start the sensor reads that are due and take the latest of each.
+    // The case switch is left to monitor_maritime_systems(), which
+    // alarms when it opens
+    sensor_manager.update(millis());
+    MaritimeSensorData data;
+    sensor_manager.get(data);
+    maritime_config.temperature = data.temperature_c;
+    maritime_config.humidity = data.humidity_pct;
+    maritime_config.pressure = data.pressure_hpa;
+    maritime_config.battery_voltage = data.battery_voltage;
+    maritime_config.heading = data.heading_deg;
+    maritime_config.pitch = data.pitch_deg;
+    maritime_config.roll = data.roll_deg;
+    maritime_config.attitude_valid = data.attitude_valid;
+    maritime_config.heading_valid = data.attitude_valid && data.heading_valid;
+}
+
+// 95% horizontal error from the GST sigma or NAV-PVT estimate, or from
+// HDOP when the receiver sends neither
+static float gnss_accuracy(const GNSS_Fix &fix) {
+    if (fix.horiz_accuracy > 0) {
+        return 2 * fix.horiz_accuracy;
+    }
+    return fix.hdop > 0 ? fix.hdop * 5 : 0;
 }
 
 void update_gnss_data() {
-    while (gnssSerial.available()) {
-        char c = gnssSerial.read();
-        // Process NMEA sentences
-        // Parse GPS data and update position
-        // This would use a proper NMEA parser in production
+    uint8_t buf[128];
+    uint32_t n;
+    while ((n = gnss_rx.read(buf, sizeof(buf))) > 0) {
+        for (uint32_t i=0; i<n; i++) {
+            if (gnss_ubx) {
+                ubx.feed(buf[i]);
+            } else {
+                nmea.feed(buf[i]);
+            }
+        }
+    }
+    const bool updated = gnss_ubx ? ubx.get_updated() : nmea.get_updated() != 0;
+    if (!updated) {
+        return;
+    }
+
+    const GNSS_Fix &fix = gnss_ubx ? ubx.get_fix() : nmea.get_fix();
+    WITH_SEMAPHORE(odid_snapshot.get_semaphore());
+    uint8_t dirty = ODID_Snapshot::slot_bit(ODID_Snapshot::Slot::LOCATION);
+    if (fix.latitude != maritime_config.latitude || fix.longitude != maritime_config.longitude) {
+        // operator position in the System message follows the vessel
+        dirty |= ODID_Snapshot::slot_bit(ODID_Snapshot::Slot::SYSTEM);
+    }
+    maritime_config.latitude = fix.latitude;
+    maritime_config.longitude = fix.longitude;
+    maritime_config.altitude = fix.altitude_msl;
+    maritime_config.accuracy = gnss_accuracy(fix);
+    maritime_config.ground_speed = fix.ground_speed;
+    maritime_config.course = fix.course;
+    maritime_config.satellites = fix.num_sats;
+    maritime_config.position_valid = fix.valid;
+    odid_snapshot.mark_dirty(dirty);
+}
+
+/*
+  set a valid flag of UAS_data, marking the slot dirty when it changes
+  so the TX task picks the change up
+ */
+static void set_valid(uint8_t &valid, bool v, ODID_Snapshot::Slot slot) {
+    if (valid != uint8_t(v)) {
+        valid = v;
+        odid_snapshot.mark_dirty(ODID_Snapshot::slot_bit(slot));
     }
 }
 
+// below this the GNSS course is mostly noise
+#define COURSE_MIN_SPEED_MS 1.0f
+
+// true minus magnetic heading, learnt while under way
+static float heading_offset_deg;
+static bool heading_offset_valid;
+
+/*
+  ODID direction: the GNSS course when under way, otherwise the way
+  the bow points. While under way the AHRS heading is slowly matched
+  to the course, which turns the magnetic heading to true and takes
+  out the yaw of the board in the hull
+ */
+static float odid_direction() {
+    if (!maritime_config.heading_valid) {
+        return maritime_config.course;
+    }
+    if (maritime_config.ground_speed >= COURSE_MIN_SPEED_MS) {
+        const float offset = wrap_180(maritime_config.course - maritime_config.heading);
+        if (heading_offset_valid) {
+            heading_offset_deg = wrap_180(heading_offset_deg + 0.01f * wrap_180(offset - heading_offset_deg));
+        } else {
+            heading_offset_deg = offset;
+            heading_offset_valid = true;
+        }
+        return maritime_config.course;
+    }
+    return wrap_360(maritime_config.heading + heading_offset_deg);
+}
+
 void update_remoteid_data() {
-    // Update OpenDroneID data structure with maritime information
-    UAS_data.BasicID[0].UAType = ODID_UATYPE_HELICOPTER_OR_MULTIROTOR;
-    UAS_data.BasicID[0].IDType = ODID_IDTYPE_SERIAL_NUMBER;
-    
-    // Use maritime device ID
-    strncpy((char*)UAS_data.BasicID[0].UASID, maritime_config.device_id.c_str(), 
-            sizeof(UAS_data.BasicID[0].UASID));
+    // UAS_data is shared with the TX task, which encodes it
+    WITH_SEMAPHORE(odid_snapshot.get_semaphore());
+
+    // Only sections whose source changed are rewritten, the snapshot
+    // keeps the previous encoding of everything else. A section that
+    // isn't valid yet is always written: the TX task can take the
+    // initial dirty bits before the first call here, and set_valid()
+    // then has to find the section filled in
+    if (odid_snapshot.is_dirty(ODID_Snapshot::Slot::BASIC_ID) || !UAS_data.BasicIDValid[0]) {
+        UAS_data.BasicID[0].UAType = ODID_UATYPE_HELICOPTER_OR_MULTIROTOR;
+        UAS_data.BasicID[0].IDType = ODID_IDTYPE_SERIAL_NUMBER;
+
+        // Use maritime device ID
+        strncpy((char*)UAS_data.BasicID[0].UASID, maritime_config.device_id.c_str(),
+                sizeof(UAS_data.BasicID[0].UASID));
+    }
+    set_valid(UAS_data.BasicIDValid[0], maritime_config.device_id.length() > 0, ODID_Snapshot::Slot::BASIC_ID);
     
-    // Location data
+    // Location data, the timestamp moves every tick
     if (maritime_config.position_valid) {
         UAS_data.Location.Status = ODID_STATUS_AIRBORNE;  // Maritime equivalent
         UAS_data.Location.Latitude = maritime_config.latitude;
         UAS_data.Location.Longitude = maritime_config.longitude;
         UAS_data.Location.AltitudeBaro = maritime_config.altitude;
         UAS_data.Location.Height = 0;  // Sea level reference
-        UAS_data.Location.HorizAccuracy = ODID_HOR_ACC_3_METER;
+        UAS_data.Location.SpeedHorizontal = maritime_config.ground_speed;
+        UAS_data.Location.Direction = odid_direction();
+        UAS_data.Location.HorizAccuracy = maritime_config.accuracy > 0 ?
+            createEnumHorizontalAccuracy(maritime_config.accuracy) : ODID_HOR_ACC_3_METER;
         UAS_data.Location.VertAccuracy = ODID_VER_ACC_3_METER;
         UAS_data.Location.TimeStamp = (millis() / 100) % 3600;  // Deciseconds in hour
+        odid_snapshot.mark_dirty(ODID_Snapshot::slot_bit(ODID_Snapshot::Slot::LOCATION));
     }
+    set_valid(UAS_data.LocationValid, maritime_config.position_valid, ODID_Snapshot::Slot::LOCATION);
     
     // System data with maritime info
-    UAS_data.System.OperatorLatitude = maritime_config.latitude;
-    UAS_data.System.OperatorLongitude = maritime_config.longitude;
-    UAS_data.System.AreaCount = 1;
-    UAS_data.System.AreaRadius = 100;  // 100m maritime operation area
-    UAS_data.System.AreaCeiling = 50;   // 50m max altitude for maritime
-    UAS_data.System.AreaFloor = 0;
-    UAS_data.System.CategoryEU = ODID_CATEGORY_EU_OPEN;
-    UAS_data.System.ClassEU = ODID_CLASS_EU_CLASS_1;
+    if (odid_snapshot.is_dirty(ODID_Snapshot::Slot::SYSTEM) || !UAS_data.SystemValid) {
+        UAS_data.System.OperatorLatitude = maritime_config.latitude;
+        UAS_data.System.OperatorLongitude = maritime_config.longitude;
+        UAS_data.System.AreaCount = 1;
+        UAS_data.System.AreaRadius = 100;  // 100m maritime operation area
+        UAS_data.System.AreaCeiling = 50;   // 50m max altitude for maritime
+        UAS_data.System.AreaFloor = 0;
+        UAS_data.System.CategoryEU = ODID_CATEGORY_EU_OPEN;
+        UAS_data.System.ClassEU = ODID_CLASS_EU_CLASS_1;
+    }
+    set_valid(UAS_data.SystemValid, true, ODID_Snapshot::Slot::SYSTEM);
 }
 
 void transmit_remoteid() {
+    const uint32_t now_ms = millis();
+    
     // Transmit via WiFi
-    wifi.transmit_beacon(UAS_data);
-    wifi.transmit_nan(UAS_data);
+    if (tx_scheduler.due(TX_Scheduler::Channel::WIFI_BEACON,
+                         TX_Scheduler::interval_ms(g.wifi_beacon_rate), now_ms)) {
+        if (wifi.transmit_beacon(odid_snapshot)) {
+            tx_scheduler.sent(TX_Scheduler::Channel::WIFI_BEACON, now_ms);
+        }
+    }
+    if (tx_scheduler.due(TX_Scheduler::Channel::WIFI_NAN,
+                         TX_Scheduler::interval_ms(g.wifi_nan_rate), now_ms)) {
+        if (wifi.transmit_nan(odid_snapshot)) {
+            tx_scheduler.sent(TX_Scheduler::Channel::WIFI_NAN, now_ms);
+        }
+    }
     
-    // Transmit via BLE
-    ble.transmit_legacy(UAS_data);
-    ble.transmit_longrange(UAS_data);
+    // Transmit via BLE, BT4_RATE is per full legacy rotation
+    if (tx_scheduler.due(TX_Scheduler::Channel::BT4,
+                         TX_Scheduler::interval_ms(g.bt4_rate, ble.legacy_states(odid_snapshot)), now_ms)) {
+        if (ble.transmit_legacy(odid_snapshot)) {
+            tx_scheduler.sent(TX_Scheduler::Channel::BT4, now_ms);
+        }
+    }
+    if (tx_scheduler.due(TX_Scheduler::Channel::BT5,
+                         TX_Scheduler::interval_ms(g.bt5_rate), now_ms)) {
+        if (ble.transmit_longrange(odid_snapshot)) {
+            tx_scheduler.sent(TX_Scheduler::Channel::BT5, now_ms);
+        }
+    }
 }
 
 void publish_mqtt_data() {
     if (!mqttClient.connected()) return;
     
+    // position is written by other tasks, take a consistent copy
+    double latitude, longitude;
+    float altitude;
+    bool position_valid;
+    {
+        WITH_SEMAPHORE(odid_snapshot.get_semaphore());
+        latitude = maritime_config.latitude;
+        longitude = maritime_config.longitude;
+        altitude = maritime_config.altitude;
+        position_valid = maritime_config.position_valid;
+    }
+
     DynamicJsonDocument doc(2048);
     
     // Header according to OndOcean schema
@@ -444,10 +763,10 @@ void publish_mqtt_data() {
     doc["header"]["device_type"] = "remoteid";
     doc["header"]["firmware_version"] = "1.0.0-maritime";
     
-    if (maritime_config.position_valid) {
-        doc["header"]["location"]["latitude"] = maritime_config.latitude;
-        doc["header"]["location"]["longitude"] = maritime_config.longitude;
-        doc["header"]["location"]["altitude_m"] = maritime_config.altitude;
+    if (position_valid) {
+        doc["header"]["location"]["latitude"] = latitude;
+        doc["header"]["location"]["longitude"] = longitude;
+        doc["header"]["location"]["altitude_m"] = altitude;
         doc["header"]["location"]["accuracy_m"] = maritime_config.accuracy;
         doc["header"]["location"]["source"] = "gnss";
     }
@@ -458,15 +777,15 @@ void publish_mqtt_data() {
     doc["data"]["transmission_method"] = "wifi_beacon";
     doc["data"]["maritime_mode"] = true;
     
-    if (maritime_config.position_valid) {
-        doc["data"]["aircraft_location"]["latitude"] = maritime_config.latitude;
-        doc["data"]["aircraft_location"]["longitude"] = maritime_config.longitude;
-        doc["data"]["aircraft_location"]["altitude_m"] = maritime_config.altitude;
+    if (position_valid) {
+        doc["data"]["aircraft_location"]["latitude"] = latitude;
+        doc["data"]["aircraft_location"]["longitude"] = longitude;
+        doc["data"]["aircraft_location"]["altitude_m"] = altitude;
     }
     
     // Quality metrics
     doc["quality"]["signal_strength_dbm"] = -30;  // Strong signal
-    doc["quality"]["confidence"] = maritime_config.position_valid ? 0.95 : 0.5;
+    doc["quality"]["confidence"] = position_valid ? 0.95 : 0.5;
     
     // Maritime sensors
     doc["maritime"]["temperature_c"] = maritime_config.temperature;
@@ -474,6 +793,13 @@ void publish_mqtt_data() {
     doc["maritime"]["pressure_hpa"] = maritime_config.pressure;
     doc["maritime"]["battery_voltage"] = maritime_config.battery_voltage;
     doc["maritime"]["case_sealed"] = maritime_config.waterproof_sealed;
+    if (maritime_config.attitude_valid) {
+        doc["maritime"]["pitch_deg"] = maritime_config.pitch;
+        doc["maritime"]["roll_deg"] = maritime_config.roll;
+    }
+    if (maritime_config.heading_valid) {
+        doc["maritime"]["heading_deg"] = maritime_config.heading;
+    }
     
     String payload;
     serializeJson(doc, payload);
@@ -484,6 +810,33 @@ void publish_mqtt_data() {
     Serial.println("MQTT published: " + String(payload.length()) + " bytes");
 }
 
+#if AP_STAGE_TIMING_ENABLED
+/*
+  publish the stage timing histograms on the diagnostics topic, times
+  in microseconds
+ */
+void publish_mqtt_diagnostics() {
+    if (!mqttClient.connected()) return;
+
+    DynamicJsonDocument doc(2048);
+    doc["device_id"] = maritime_config.device_id;
+    doc["timestamp"] = get_iso_timestamp();
+    for (const Stage_Timer *t = Stage_Timer::first(); t != nullptr; t = t->next()) {
+        JsonObject stage = doc["stages"].createNestedObject(t->get_name());
+        stage["p50"] = t->get_p50_us();
+        stage["p99"] = t->get_p99_us();
+        stage["max"] = t->get_max_us();
+        stage["n"] = t->get_count();
+    }
+
+    String payload;
+    serializeJson(doc, payload);
+
+    String topic = maritime_config.mqtt_topic_prefix + "/diagnostics";
+    mqttClient.publish(topic.c_str(), payload.c_str());
+}
+#endif
+
 void reconnect_mqtt() {
     if (mqttClient.connect(maritime_config.device_id.c_str())) {
         Serial.println("MQTT reconnected");
@@ -502,6 +855,11 @@ void update_status_led() {
     static uint32_t last_blink = 0;
     static bool blink_state = false;
     
+    if (pattern_player.active()) {
+        // an alarm or startup pattern owns the LED
+        return;
+    }
+
     if (millis() - last_blink > 1000) {
         last_blink = millis();
         blink_state = !blink_state;
@@ -520,42 +878,47 @@ void update_status_led() {
 }
 
 void monitor_maritime_systems() {
-    // Monitor battery level
-    if (maritime_config.battery_voltage < 3.3) {
+    // Both from the sensor table: this runs before the first data tick
+    // copies it into maritime_config
+    MaritimeSensorData data;
+    sensor_manager.get(data);
+
+    // Monitor battery level, once there is a reading
+    if (sensor_manager.get_sample_ms(Sensor_Manager::Source::BATTERY) != 0 &&
+        data.battery_voltage < 3.3) {
         maritime_config.low_power_mode = true;
         Serial.println("Low battery - Low power mode activated");
     }
     
-    // Monitor case integrity
-    bool case_open = digitalRead(PIN_CASE_DETECT);
+    // Monitor case integrity, the switch interrupt keeps the table current
+    bool case_open = data.case_tamper_detected;
     if (case_open && maritime_config.case_closed) {
         Serial.println("ALERT: Case open!");
         maritime_config.waterproof_sealed = false;
         
         // Sound alarm
-        for (int i = 0; i < 3; i++) {
-            digitalWrite(PIN_BUZZER, HIGH);
-            delay(100);
-            digitalWrite(PIN_BUZZER, LOW);
-            delay(100);
-        }
+        pattern_player.play(PATTERN_CASE_OPEN);
     }
     maritime_config.case_closed = !case_open;
 }
 
+/*
+  switch low power mode on or off. In low power mode the tasks that
+  poll slow down, everything else already blocks until its next
+  deadline, so the chip light sleeps in between
+ */
 void handle_low_power_mode() {
-    // Reduce transmission frequency
-    static uint32_t last_low_power_action = 0;
-    
-    if (millis() - last_low_power_action > 5000) {  // Every 5 seconds in low power
-        last_low_power_action = millis();
-        
-        // Reduce WiFi power
-        esp_wifi_set_max_tx_power(10);  // Reduce to 2.5dBm
-        
-        // Sleep between transmissions
-        delay(100);
+    const bool low_power = maritime_config.low_power_mode;
+    if (low_power != power_manager.low_power()) {
+        power_manager.set_low_power(low_power);
+
+        // 2.5dBm WiFi in low power
+        wifi.set_tx_power(low_power ? 2.5 : g.wifi_power);
+
+        task_services.set_period_ms(low_power ? 100 : 10);
+        task_ingest.set_period_ms(low_power ? 100 : 10);
     }
+    power_manager.update(millis());
 }
 
 // Utility functions
@@ -570,19 +933,6 @@ String get_iso_timestamp() {
     return String(buffer);
 }
 
-float read_temperature() {
-    // Read from maritime sensor (BME280, SHT30, etc.)
-    return 20.0;  // Placeholder
-}
-
-float read_humidity() {
-    return 65.0;  // Placeholder
-}
-
-float read_pressure() {
-    return 1013.25;  // Placeholder
-}
-
 // read_battery_voltage is defined in maritime_sensors.cpp
 
 void load_maritime_config() {
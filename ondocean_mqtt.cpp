@@ -5,6 +5,7 @@
 
 #include "ondocean_mqtt.h"
 #include "board_config_maritime.h"
+#include "parameters.h"
 #include <WiFi.h>
 
 // Global MQTT client and configuration
@@ -215,6 +216,13 @@ bool mqtt_publish_telemetry(const MaritimeSensorData& sensors) {
     doc["imu"]["mag_x"] = sensors.mag_x;
     doc["imu"]["mag_y"] = sensors.mag_y;
     doc["imu"]["mag_z"] = sensors.mag_z;
+    if (sensors.attitude_valid) {
+        doc["imu"]["pitch_deg"] = sensors.pitch_deg;
+        doc["imu"]["roll_deg"] = sensors.roll_deg;
+    }
+    if (sensors.heading_valid) {
+        doc["imu"]["heading_deg"] = sensors.heading_deg;
+    }
     
     String message;
     serializeJson(doc, message);
@@ -263,6 +271,7 @@ void mqtt_handle_command(const String& topic, const JsonDocument& payload) {
     
     if (command_type == "reboot") {
         Serial.println("Reboot command received");
+        g.flush();
         delay(1000);
         ESP.restart();
     }
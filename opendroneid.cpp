@@ -0,0 +1,856 @@
+/*
+  OpenDroneID message encoder and decoder (ASTM F3411 / ASD-STAN prEN 4709-002)
+
+  Messages are encoded straight into the caller's 25 byte buffers and
+  the message pack is assembled in place, so a complete pack never goes
+  through an intermediate ODID_MessagePack_data copy. Nothing on the
+  encode path logs.
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include "opendroneid.h"
+
+#define ARRAY_SIZE(x) (sizeof(x)/sizeof((x)[0]))
+
+/*
+  quantisation steps, see the ASTM F3411 Location and System message
+  field definitions
+ */
+static constexpr float SPEED_DIV[2] = { 0.25f, 0.75f };    // horizontal speed, indexed by SpeedMult
+static constexpr float SPEED_MULT_THRESHOLD = UINT8_MAX * SPEED_DIV[0]; // 63.75 m/s
+static constexpr float VSPEED_DIV = 0.5f;
+static constexpr int32_t LATLON_MULT = 10000000;
+static constexpr float ALT_DIV = 0.5f;
+static constexpr int ALT_ADDER = 1000;
+static constexpr uint8_t AREA_RADIUS_DIV = 10;
+
+/*
+  accuracy tables. Entry i is the upper bound in metres (or m/s) of
+  enum value i+1, so the tables are ordered coarse to fine
+ */
+static constexpr float HOR_ACC_LIMITS[] = {
+    18520, 7408, 3704, 1852, 926, 555.6f, 185.2f, 92.6f, 30, 10, 3, 1
+};
+static constexpr float VER_ACC_LIMITS[] = {
+    150, 45, 25, 10, 3, 1
+};
+static constexpr float SPEED_ACC_LIMITS[] = {
+    10, 3, 1, 0.3f
+};
+static_assert(ARRAY_SIZE(HOR_ACC_LIMITS) == ODID_HOR_ACC_1_METER, "horizontal accuracy table size");
+static_assert(ARRAY_SIZE(VER_ACC_LIMITS) == ODID_VER_ACC_1_METER, "vertical accuracy table size");
+static_assert(ARRAY_SIZE(SPEED_ACC_LIMITS) == ODID_SPEED_ACC_0_3_METERS_PER_SECOND, "speed accuracy table size");
+
+static_assert(sizeof(ODID_BasicID_encoded) == ODID_MESSAGE_SIZE, "BasicID size");
+static_assert(sizeof(ODID_Location_encoded) == ODID_MESSAGE_SIZE, "Location size");
+static_assert(sizeof(ODID_Auth_encoded) == ODID_MESSAGE_SIZE, "Auth size");
+static_assert(sizeof(ODID_SelfID_encoded) == ODID_MESSAGE_SIZE, "SelfID size");
+static_assert(sizeof(ODID_System_encoded) == ODID_MESSAGE_SIZE, "System size");
+static_assert(sizeof(ODID_OperatorID_encoded) == ODID_MESSAGE_SIZE, "OperatorID size");
+
+static int intRangeMax(int64_t inValue, int startRange, int endRange)
+{
+    if (inValue < startRange) {
+        return startRange;
+    }
+    if (inValue > endRange) {
+        return endRange;
+    }
+    return (int)inValue;
+}
+
+static bool intInRange(int inValue, int startRange, int endRange)
+{
+    return inValue >= startRange && inValue <= endRange;
+}
+
+/*
+  copy a fixed size field into a null terminated string, filling the
+  rest with zeros
+ */
+static void safe_dec_copyfill(char *dstStr, const char *srcStr, size_t dstSize)
+{
+    memset(dstStr, 0, dstSize);
+    strncpy(dstStr, srcStr, dstSize-1);
+}
+
+/*
+  map an accuracy value onto the finest enum whose upper bound it is
+  below. Returns 0 (unknown) for values out of range
+ */
+static uint8_t accuracy_to_enum(float accuracy, const float *limits, uint8_t n)
+{
+    if (!(accuracy > 0)) {
+        return 0;
+    }
+    for (int8_t i = n-1; i >= 0; i--) {
+        if (accuracy < limits[i]) {
+            return i+1;
+        }
+    }
+    return 0;
+}
+
+// the unknown enum decodes to the coarsest bound
+static float enum_to_accuracy(uint8_t e, const float *limits, uint8_t n)
+{
+    if (e == 0 || e > n) {
+        return limits[0];
+    }
+    return limits[e-1];
+}
+
+static uint8_t encodeDirection(float Direction, uint8_t *EWDirection)
+{
+    unsigned int direction_int = (unsigned int)roundf(Direction);
+    if (direction_int < 180) {
+        *EWDirection = 0;
+    } else {
+        *EWDirection = 1;
+        direction_int -= 180;
+    }
+    return (uint8_t)intRangeMax(direction_int, 0, UINT8_MAX);
+}
+
+static uint8_t encodeSpeedHorizontal(float Speed_data, uint8_t *mult)
+{
+    if (Speed_data <= SPEED_MULT_THRESHOLD) {
+        *mult = 0;
+        return (uint8_t)(Speed_data / SPEED_DIV[0]);
+    }
+    *mult = 1;
+    const int big_value = (int)((Speed_data - SPEED_MULT_THRESHOLD) / SPEED_DIV[1]);
+    return (uint8_t)intRangeMax(big_value, 0, UINT8_MAX);
+}
+
+static int8_t encodeSpeedVertical(float SpeedVertical_data)
+{
+    return (int8_t)intRangeMax((int)(SpeedVertical_data / VSPEED_DIV), INT8_MIN, INT8_MAX);
+}
+
+static int32_t encodeLatLon(double LatLon_data)
+{
+    return (int32_t)intRangeMax((int64_t)(LatLon_data * LATLON_MULT), -180 * LATLON_MULT, 180 * LATLON_MULT);
+}
+
+static uint16_t encodeAltitude(float Alt_data)
+{
+    return (uint16_t)intRangeMax((int)((Alt_data + (float)ALT_ADDER) / ALT_DIV), 0, UINT16_MAX);
+}
+
+static uint16_t encodeTimeStamp(float Seconds_data)
+{
+    if (Seconds_data == INV_TIMESTAMP) {
+        return INV_TIMESTAMP;
+    }
+    return (uint16_t)intRangeMax((int64_t)roundf(Seconds_data*10), 0, MAX_TIMESTAMP * 10);
+}
+
+static uint8_t encodeAreaRadius(uint16_t Radius)
+{
+    return (uint8_t)intRangeMax(Radius / AREA_RADIUS_DIV, 0, UINT8_MAX);
+}
+
+static float decodeDirection(uint8_t Direction_enc, uint8_t EWDirection)
+{
+    return EWDirection ? (float)Direction_enc + 180 : (float)Direction_enc;
+}
+
+static float decodeSpeedHorizontal(uint8_t Speed_enc, uint8_t mult)
+{
+    if (mult) {
+        return ((float)Speed_enc * SPEED_DIV[1]) + SPEED_MULT_THRESHOLD;
+    }
+    return (float)Speed_enc * SPEED_DIV[0];
+}
+
+static float decodeSpeedVertical(int8_t SpeedVertical_enc)
+{
+    return (float)SpeedVertical_enc * VSPEED_DIV;
+}
+
+static double decodeLatLon(int32_t LatLon_enc)
+{
+    return (double)LatLon_enc / LATLON_MULT;
+}
+
+static float decodeAltitude(uint16_t Alt_enc)
+{
+    return (float)Alt_enc * ALT_DIV - (float)ALT_ADDER;
+}
+
+static float decodeTimeStamp(uint16_t Seconds_enc)
+{
+    if (Seconds_enc == INV_TIMESTAMP) {
+        return INV_TIMESTAMP;
+    }
+    return (float)Seconds_enc / 10;
+}
+
+static uint16_t decodeAreaRadius(uint8_t Radius_enc)
+{
+    return (uint16_t)(Radius_enc * AREA_RADIUS_DIV);
+}
+
+void odid_initBasicIDData(ODID_BasicID_data *data)
+{
+    if (!data) {
+        return;
+    }
+    memset(data, 0, sizeof(*data));
+}
+
+void odid_initLocationData(ODID_Location_data *data)
+{
+    if (!data) {
+        return;
+    }
+    memset(data, 0, sizeof(*data));
+    data->Direction = INV_DIR;
+    data->SpeedHorizontal = INV_SPEED_H;
+    data->SpeedVertical = INV_SPEED_V;
+    data->AltitudeBaro = INV_ALT;
+    data->AltitudeGeo = INV_ALT;
+    data->Height = INV_ALT;
+}
+
+void odid_initAuthData(ODID_Auth_data *data)
+{
+    if (!data) {
+        return;
+    }
+    memset(data, 0, sizeof(*data));
+}
+
+void odid_initSelfIDData(ODID_SelfID_data *data)
+{
+    if (!data) {
+        return;
+    }
+    memset(data, 0, sizeof(*data));
+}
+
+void odid_initSystemData(ODID_System_data *data)
+{
+    if (!data) {
+        return;
+    }
+    memset(data, 0, sizeof(*data));
+    data->AreaCount = 1;
+    data->AreaCeiling = INV_ALT;
+    data->AreaFloor = INV_ALT;
+    data->OperatorAltitudeGeo = INV_ALT;
+}
+
+void odid_initOperatorIDData(ODID_OperatorID_data *data)
+{
+    if (!data) {
+        return;
+    }
+    memset(data, 0, sizeof(*data));
+}
+
+void odid_initMessagePackData(ODID_MessagePack_data *data)
+{
+    if (!data) {
+        return;
+    }
+    memset(data, 0, sizeof(*data));
+    data->SingleMessageSize = ODID_MESSAGE_SIZE;
+}
+
+void odid_initUasData(ODID_UAS_Data *data)
+{
+    if (!data) {
+        return;
+    }
+    for (int i = 0; i < ODID_BASIC_ID_MAX_MESSAGES; i++) {
+        data->BasicIDValid[i] = 0;
+        odid_initBasicIDData(&data->BasicID[i]);
+    }
+    data->LocationValid = 0;
+    odid_initLocationData(&data->Location);
+    for (int i = 0; i < ODID_AUTH_MAX_PAGES; i++) {
+        data->AuthValid[i] = 0;
+        odid_initAuthData(&data->Auth[i]);
+    }
+    data->SelfIDValid = 0;
+    odid_initSelfIDData(&data->SelfID);
+    data->SystemValid = 0;
+    odid_initSystemData(&data->System);
+    data->OperatorIDValid = 0;
+    odid_initOperatorIDData(&data->OperatorID);
+}
+
+int encodeBasicIDMessage(ODID_BasicID_encoded *outEncoded, ODID_BasicID_data *inData)
+{
+    if (!outEncoded || !inData ||
+        !intInRange(inData->IDType, 0, 15) ||
+        !intInRange(inData->UAType, 0, 15)) {
+        return ODID_FAIL;
+    }
+
+    outEncoded->MessageType = ODID_MESSAGETYPE_BASIC_ID;
+    outEncoded->ProtoVersion = ODID_PROTOCOL_VERSION;
+    outEncoded->IDType = inData->IDType;
+    outEncoded->UAType = inData->UAType;
+    strncpy(outEncoded->UASID, inData->UASID, sizeof(outEncoded->UASID));
+    memset(outEncoded->Reserved, 0, sizeof(outEncoded->Reserved));
+    return ODID_SUCCESS;
+}
+
+int encodeLocationMessage(ODID_Location_encoded *outEncoded, ODID_Location_data *inData)
+{
+    if (!outEncoded || !inData ||
+        !intInRange(inData->Status, 0, 15) ||
+        !intInRange(inData->HeightType, 0, 1) ||
+        !intInRange(inData->HorizAccuracy, 0, 15) ||
+        !intInRange(inData->VertAccuracy, 0, 15) ||
+        !intInRange(inData->BaroAccuracy, 0, 15) ||
+        !intInRange(inData->SpeedAccuracy, 0, 15) ||
+        !intInRange(inData->TSAccuracy, 0, 15)) {
+        return ODID_FAIL;
+    }
+
+    if (inData->Direction < MIN_DIR || inData->Direction > INV_DIR ||
+        (inData->Direction > MAX_DIR && inData->Direction < INV_DIR)) {
+        return ODID_FAIL;
+    }
+    if (inData->SpeedHorizontal < MIN_SPEED_H || inData->SpeedHorizontal > INV_SPEED_H ||
+        (inData->SpeedHorizontal > MAX_SPEED_H && inData->SpeedHorizontal < INV_SPEED_H)) {
+        return ODID_FAIL;
+    }
+    if (inData->SpeedVertical < MIN_SPEED_V || inData->SpeedVertical > INV_SPEED_V ||
+        (inData->SpeedVertical > MAX_SPEED_V && inData->SpeedVertical < INV_SPEED_V)) {
+        return ODID_FAIL;
+    }
+    if (inData->Latitude < MIN_LAT || inData->Latitude > MAX_LAT ||
+        inData->Longitude < MIN_LON || inData->Longitude > MAX_LON) {
+        return ODID_FAIL;
+    }
+    if (inData->AltitudeBaro < MIN_ALT || inData->AltitudeBaro > MAX_ALT ||
+        inData->AltitudeGeo < MIN_ALT || inData->AltitudeGeo > MAX_ALT ||
+        inData->Height < MIN_ALT || inData->Height > MAX_ALT) {
+        return ODID_FAIL;
+    }
+    if ((inData->TimeStamp < 0 || inData->TimeStamp > MAX_TIMESTAMP) &&
+        inData->TimeStamp != INV_TIMESTAMP) {
+        return ODID_FAIL;
+    }
+
+    uint8_t bitflag;
+    outEncoded->MessageType = ODID_MESSAGETYPE_LOCATION;
+    outEncoded->ProtoVersion = ODID_PROTOCOL_VERSION;
+    outEncoded->Status = inData->Status;
+    outEncoded->Reserved = 0;
+    outEncoded->Direction = encodeDirection(inData->Direction, &bitflag);
+    outEncoded->EWDirection = bitflag;
+    outEncoded->SpeedHorizontal = encodeSpeedHorizontal(inData->SpeedHorizontal, &bitflag);
+    outEncoded->SpeedMult = bitflag;
+    outEncoded->SpeedVertical = encodeSpeedVertical(inData->SpeedVertical);
+    outEncoded->Latitude = encodeLatLon(inData->Latitude);
+    outEncoded->Longitude = encodeLatLon(inData->Longitude);
+    outEncoded->AltitudeBaro = encodeAltitude(inData->AltitudeBaro);
+    outEncoded->AltitudeGeo = encodeAltitude(inData->AltitudeGeo);
+    outEncoded->HeightType = inData->HeightType;
+    outEncoded->Height = encodeAltitude(inData->Height);
+    outEncoded->HorizAccuracy = inData->HorizAccuracy;
+    outEncoded->VertAccuracy = inData->VertAccuracy;
+    outEncoded->BaroAccuracy = inData->BaroAccuracy;
+    outEncoded->SpeedAccuracy = inData->SpeedAccuracy;
+    outEncoded->TSAccuracy = inData->TSAccuracy;
+    outEncoded->Reserved2 = 0;
+    outEncoded->TimeStamp = encodeTimeStamp(inData->TimeStamp);
+    outEncoded->Reserved3 = 0;
+    return ODID_SUCCESS;
+}
+
+int encodeAuthMessage(ODID_Auth_encoded *outEncoded, ODID_Auth_data *inData)
+{
+    if (!outEncoded || !inData ||
+        !intInRange(inData->AuthType, 0, 15) ||
+        inData->DataPage >= ODID_AUTH_MAX_PAGES) {
+        return ODID_FAIL;
+    }
+    if (inData->DataPage == 0 &&
+        (inData->LastPageIndex >= ODID_AUTH_MAX_PAGES || inData->Length > MAX_AUTH_LENGTH)) {
+        return ODID_FAIL;
+    }
+
+    outEncoded->page_zero.MessageType = ODID_MESSAGETYPE_AUTH;
+    outEncoded->page_zero.ProtoVersion = ODID_PROTOCOL_VERSION;
+    outEncoded->page_zero.AuthType = inData->AuthType;
+    outEncoded->page_zero.DataPage = inData->DataPage;
+    if (inData->DataPage == 0) {
+        outEncoded->page_zero.LastPageIndex = inData->LastPageIndex;
+        outEncoded->page_zero.Length = inData->Length;
+        outEncoded->page_zero.Timestamp = inData->Timestamp;
+        memcpy(outEncoded->page_zero.AuthData, inData->AuthData, sizeof(outEncoded->page_zero.AuthData));
+    } else {
+        memcpy(outEncoded->page_non_zero.AuthData, inData->AuthData, sizeof(outEncoded->page_non_zero.AuthData));
+    }
+    return ODID_SUCCESS;
+}
+
+int encodeSelfIDMessage(ODID_SelfID_encoded *outEncoded, ODID_SelfID_data *inData)
+{
+    if (!outEncoded || !inData || !intInRange(inData->DescType, 0, 255)) {
+        return ODID_FAIL;
+    }
+
+    outEncoded->MessageType = ODID_MESSAGETYPE_SELF_ID;
+    outEncoded->ProtoVersion = ODID_PROTOCOL_VERSION;
+    outEncoded->DescType = inData->DescType;
+    strncpy(outEncoded->Desc, inData->Desc, sizeof(outEncoded->Desc));
+    return ODID_SUCCESS;
+}
+
+int encodeSystemMessage(ODID_System_encoded *outEncoded, ODID_System_data *inData)
+{
+    if (!outEncoded || !inData ||
+        !intInRange(inData->OperatorLocationType, 0, 3) ||
+        !intInRange(inData->ClassificationType, 0, 7) ||
+        !intInRange(inData->CategoryEU, 0, 15) ||
+        !intInRange(inData->ClassEU, 0, 15)) {
+        return ODID_FAIL;
+    }
+    if (inData->OperatorLatitude < MIN_LAT || inData->OperatorLatitude > MAX_LAT ||
+        inData->OperatorLongitude < MIN_LON || inData->OperatorLongitude > MAX_LON) {
+        return ODID_FAIL;
+    }
+    if (inData->AreaRadius > MAX_AREA_RADIUS) {
+        return ODID_FAIL;
+    }
+    if (inData->AreaCeiling < MIN_ALT || inData->AreaCeiling > MAX_ALT ||
+        inData->AreaFloor < MIN_ALT || inData->AreaFloor > MAX_ALT ||
+        inData->OperatorAltitudeGeo < MIN_ALT || inData->OperatorAltitudeGeo > MAX_ALT) {
+        return ODID_FAIL;
+    }
+
+    outEncoded->MessageType = ODID_MESSAGETYPE_SYSTEM;
+    outEncoded->ProtoVersion = ODID_PROTOCOL_VERSION;
+    outEncoded->Reserved = 0;
+    outEncoded->OperatorLocationType = inData->OperatorLocationType;
+    outEncoded->ClassificationType = inData->ClassificationType;
+    outEncoded->OperatorLatitude = encodeLatLon(inData->OperatorLatitude);
+    outEncoded->OperatorLongitude = encodeLatLon(inData->OperatorLongitude);
+    outEncoded->AreaCount = inData->AreaCount;
+    outEncoded->AreaRadius = encodeAreaRadius(inData->AreaRadius);
+    outEncoded->AreaCeiling = encodeAltitude(inData->AreaCeiling);
+    outEncoded->AreaFloor = encodeAltitude(inData->AreaFloor);
+    outEncoded->CategoryEU = inData->CategoryEU;
+    outEncoded->ClassEU = inData->ClassEU;
+    outEncoded->OperatorAltitudeGeo = encodeAltitude(inData->OperatorAltitudeGeo);
+    outEncoded->Timestamp = inData->Timestamp;
+    outEncoded->Reserved2 = 0;
+    return ODID_SUCCESS;
+}
+
+int encodeOperatorIDMessage(ODID_OperatorID_encoded *outEncoded, ODID_OperatorID_data *inData)
+{
+    if (!outEncoded || !inData || !intInRange(inData->OperatorIdType, 0, 255)) {
+        return ODID_FAIL;
+    }
+
+    outEncoded->MessageType = ODID_MESSAGETYPE_OPERATOR_ID;
+    outEncoded->ProtoVersion = ODID_PROTOCOL_VERSION;
+    outEncoded->OperatorIdType = inData->OperatorIdType;
+    strncpy(outEncoded->OperatorId, inData->OperatorId, sizeof(outEncoded->OperatorId));
+    memset(outEncoded->Reserved, 0, sizeof(outEncoded->Reserved));
+    return ODID_SUCCESS;
+}
+
+/*
+  a pack may hold at most one of each message type, except BasicID and
+  Auth. Packs inside packs are rejected
+ */
+static int checkPackContent(const ODID_Message_encoded *msgs, int amount)
+{
+    if (amount <= 0 || amount > ODID_PACK_MAX_MESSAGES) {
+        return ODID_FAIL;
+    }
+    static constexpr uint8_t max_count[] = {
+        ODID_BASIC_ID_MAX_MESSAGES, // BASIC_ID
+        1,                          // LOCATION
+        ODID_AUTH_MAX_PAGES,        // AUTH
+        1,                          // SELF_ID
+        1,                          // SYSTEM
+        1,                          // OPERATOR_ID
+    };
+    uint8_t count[ARRAY_SIZE(max_count)] {};
+    for (int i = 0; i < amount; i++) {
+        const uint8_t type = decodeMessageType(msgs[i].rawData[0]);
+        if (type >= ARRAY_SIZE(max_count) || ++count[type] > max_count[type]) {
+            return ODID_FAIL;
+        }
+    }
+    return ODID_SUCCESS;
+}
+
+int encodeMessagePack(ODID_MessagePack_encoded *outEncoded, ODID_MessagePack_data *inData)
+{
+    if (!outEncoded || !inData || inData->SingleMessageSize != ODID_MESSAGE_SIZE) {
+        return ODID_FAIL;
+    }
+    if (checkPackContent(inData->Messages, inData->MsgPackSize) != ODID_SUCCESS) {
+        return ODID_FAIL;
+    }
+
+    outEncoded->MessageType = ODID_MESSAGETYPE_PACKED;
+    outEncoded->ProtoVersion = ODID_PROTOCOL_VERSION;
+    outEncoded->SingleMessageSize = inData->SingleMessageSize;
+    outEncoded->MsgPackSize = inData->MsgPackSize;
+    memcpy(outEncoded->Messages, inData->Messages, inData->MsgPackSize * ODID_MESSAGE_SIZE);
+    return ODID_SUCCESS;
+}
+
+int decodeBasicIDMessage(ODID_BasicID_data *outData, ODID_BasicID_encoded *inEncoded)
+{
+    if (!outData || !inEncoded ||
+        inEncoded->MessageType != ODID_MESSAGETYPE_BASIC_ID) {
+        return ODID_FAIL;
+    }
+
+    outData->IDType = (ODID_idtype_t)inEncoded->IDType;
+    outData->UAType = (ODID_uatype_t)inEncoded->UAType;
+    safe_dec_copyfill(outData->UASID, inEncoded->UASID, sizeof(outData->UASID));
+    return ODID_SUCCESS;
+}
+
+int decodeLocationMessage(ODID_Location_data *outData, ODID_Location_encoded *inEncoded)
+{
+    if (!outData || !inEncoded ||
+        inEncoded->MessageType != ODID_MESSAGETYPE_LOCATION) {
+        return ODID_FAIL;
+    }
+
+    outData->Status = (ODID_status_t)inEncoded->Status;
+    outData->Direction = decodeDirection(inEncoded->Direction, inEncoded->EWDirection);
+    outData->SpeedHorizontal = decodeSpeedHorizontal(inEncoded->SpeedHorizontal, inEncoded->SpeedMult);
+    outData->SpeedVertical = decodeSpeedVertical(inEncoded->SpeedVertical);
+    outData->Latitude = decodeLatLon(inEncoded->Latitude);
+    outData->Longitude = decodeLatLon(inEncoded->Longitude);
+    outData->AltitudeBaro = decodeAltitude(inEncoded->AltitudeBaro);
+    outData->AltitudeGeo = decodeAltitude(inEncoded->AltitudeGeo);
+    outData->HeightType = (ODID_Height_reference_t)inEncoded->HeightType;
+    outData->Height = decodeAltitude(inEncoded->Height);
+    outData->HorizAccuracy = (ODID_Horizontal_accuracy_t)inEncoded->HorizAccuracy;
+    outData->VertAccuracy = (ODID_Vertical_accuracy_t)inEncoded->VertAccuracy;
+    outData->BaroAccuracy = (ODID_Vertical_accuracy_t)inEncoded->BaroAccuracy;
+    outData->SpeedAccuracy = (ODID_Speed_accuracy_t)inEncoded->SpeedAccuracy;
+    outData->TSAccuracy = (ODID_Timestamp_accuracy_t)inEncoded->TSAccuracy;
+    outData->TimeStamp = decodeTimeStamp(inEncoded->TimeStamp);
+    return ODID_SUCCESS;
+}
+
+int getAuthPageNum(ODID_Auth_encoded *inEncoded, int *pageNum)
+{
+    if (!inEncoded || !pageNum ||
+        inEncoded->page_zero.MessageType != ODID_MESSAGETYPE_AUTH ||
+        inEncoded->page_zero.DataPage >= ODID_AUTH_MAX_PAGES) {
+        return ODID_FAIL;
+    }
+    *pageNum = inEncoded->page_zero.DataPage;
+    return ODID_SUCCESS;
+}
+
+int decodeAuthMessage(ODID_Auth_data *outData, ODID_Auth_encoded *inEncoded)
+{
+    if (!outData || !inEncoded ||
+        inEncoded->page_zero.MessageType != ODID_MESSAGETYPE_AUTH ||
+        inEncoded->page_zero.DataPage >= ODID_AUTH_MAX_PAGES) {
+        return ODID_FAIL;
+    }
+    if (inEncoded->page_zero.DataPage == 0 &&
+        (inEncoded->page_zero.LastPageIndex >= ODID_AUTH_MAX_PAGES ||
+         inEncoded->page_zero.Length > MAX_AUTH_LENGTH)) {
+        return ODID_FAIL;
+    }
+
+    outData->AuthType = (ODID_authtype_t)inEncoded->page_zero.AuthType;
+    outData->DataPage = inEncoded->page_zero.DataPage;
+    memset(outData->AuthData, 0, sizeof(outData->AuthData));
+    if (inEncoded->page_zero.DataPage == 0) {
+        outData->LastPageIndex = inEncoded->page_zero.LastPageIndex;
+        outData->Length = inEncoded->page_zero.Length;
+        outData->Timestamp = inEncoded->page_zero.Timestamp;
+        memcpy(outData->AuthData, inEncoded->page_zero.AuthData, sizeof(inEncoded->page_zero.AuthData));
+    } else {
+        memcpy(outData->AuthData, inEncoded->page_non_zero.AuthData, sizeof(inEncoded->page_non_zero.AuthData));
+    }
+    return ODID_SUCCESS;
+}
+
+int decodeSelfIDMessage(ODID_SelfID_data *outData, ODID_SelfID_encoded *inEncoded)
+{
+    if (!outData || !inEncoded ||
+        inEncoded->MessageType != ODID_MESSAGETYPE_SELF_ID) {
+        return ODID_FAIL;
+    }
+
+    outData->DescType = (ODID_desctype_t)inEncoded->DescType;
+    safe_dec_copyfill(outData->Desc, inEncoded->Desc, sizeof(outData->Desc));
+    return ODID_SUCCESS;
+}
+
+int decodeSystemMessage(ODID_System_data *outData, ODID_System_encoded *inEncoded)
+{
+    if (!outData || !inEncoded ||
+        inEncoded->MessageType != ODID_MESSAGETYPE_SYSTEM) {
+        return ODID_FAIL;
+    }
+
+    outData->OperatorLocationType = (ODID_operator_location_type_t)inEncoded->OperatorLocationType;
+    outData->ClassificationType = (ODID_classification_type_t)inEncoded->ClassificationType;
+    outData->OperatorLatitude = decodeLatLon(inEncoded->OperatorLatitude);
+    outData->OperatorLongitude = decodeLatLon(inEncoded->OperatorLongitude);
+    outData->AreaCount = inEncoded->AreaCount;
+    outData->AreaRadius = decodeAreaRadius(inEncoded->AreaRadius);
+    outData->AreaCeiling = decodeAltitude(inEncoded->AreaCeiling);
+    outData->AreaFloor = decodeAltitude(inEncoded->AreaFloor);
+    outData->CategoryEU = (ODID_category_EU_t)inEncoded->CategoryEU;
+    outData->ClassEU = (ODID_class_EU_t)inEncoded->ClassEU;
+    outData->OperatorAltitudeGeo = decodeAltitude(inEncoded->OperatorAltitudeGeo);
+    outData->Timestamp = inEncoded->Timestamp;
+    return ODID_SUCCESS;
+}
+
+int decodeOperatorIDMessage(ODID_OperatorID_data *outData, ODID_OperatorID_encoded *inEncoded)
+{
+    if (!outData || !inEncoded ||
+        inEncoded->MessageType != ODID_MESSAGETYPE_OPERATOR_ID) {
+        return ODID_FAIL;
+    }
+
+    outData->OperatorIdType = (ODID_operatorIdType_t)inEncoded->OperatorIdType;
+    safe_dec_copyfill(outData->OperatorId, inEncoded->OperatorId, sizeof(outData->OperatorId));
+    return ODID_SUCCESS;
+}
+
+int decodeMessagePack(ODID_UAS_Data *uasData, ODID_MessagePack_encoded *pack)
+{
+    if (!uasData || !pack ||
+        pack->MessageType != ODID_MESSAGETYPE_PACKED ||
+        pack->SingleMessageSize != ODID_MESSAGE_SIZE) {
+        return ODID_FAIL;
+    }
+    if (checkPackContent(pack->Messages, pack->MsgPackSize) != ODID_SUCCESS) {
+        return ODID_FAIL;
+    }
+
+    for (int i = 0; i < pack->MsgPackSize; i++) {
+        decodeOpenDroneID(uasData, pack->Messages[i].rawData);
+    }
+    return ODID_SUCCESS;
+}
+
+int getBasicIDType(ODID_BasicID_encoded *inEncoded, enum ODID_idtype *idType)
+{
+    if (!inEncoded || !idType ||
+        inEncoded->MessageType != ODID_MESSAGETYPE_BASIC_ID) {
+        return ODID_FAIL;
+    }
+    *idType = (enum ODID_idtype)inEncoded->IDType;
+    return ODID_SUCCESS;
+}
+
+ODID_messagetype_t decodeMessageType(uint8_t byte)
+{
+    switch (byte >> 4) {
+    case ODID_MESSAGETYPE_BASIC_ID:
+    case ODID_MESSAGETYPE_LOCATION:
+    case ODID_MESSAGETYPE_AUTH:
+    case ODID_MESSAGETYPE_SELF_ID:
+    case ODID_MESSAGETYPE_SYSTEM:
+    case ODID_MESSAGETYPE_OPERATOR_ID:
+    case ODID_MESSAGETYPE_PACKED:
+        return (ODID_messagetype_t)(byte >> 4);
+    default:
+        return ODID_MESSAGETYPE_INVALID;
+    }
+}
+
+/*
+  decode a single message into uas_data, marking the matching entry
+  valid. Returns the message type, or ODID_MESSAGETYPE_INVALID
+ */
+ODID_messagetype_t decodeOpenDroneID(ODID_UAS_Data *uas_data, uint8_t *msg_data)
+{
+    if (!uas_data || !msg_data) {
+        return ODID_MESSAGETYPE_INVALID;
+    }
+
+    switch (decodeMessageType(msg_data[0])) {
+    case ODID_MESSAGETYPE_BASIC_ID: {
+        ODID_BasicID_encoded *basic_id = (ODID_BasicID_encoded *)msg_data;
+        enum ODID_idtype id_type;
+        if (getBasicIDType(basic_id, &id_type) != ODID_SUCCESS) {
+            break;
+        }
+        // reuse the slot holding the same ID type, or the first free one
+        for (int i = 0; i < ODID_BASIC_ID_MAX_MESSAGES; i++) {
+            const enum ODID_idtype stored = uas_data->BasicID[i].IDType;
+            if ((stored == ODID_IDTYPE_NONE || stored == id_type) &&
+                decodeBasicIDMessage(&uas_data->BasicID[i], basic_id) == ODID_SUCCESS) {
+                uas_data->BasicIDValid[i] = 1;
+                return ODID_MESSAGETYPE_BASIC_ID;
+            }
+        }
+        break;
+    }
+    case ODID_MESSAGETYPE_LOCATION:
+        if (decodeLocationMessage(&uas_data->Location, (ODID_Location_encoded *)msg_data) == ODID_SUCCESS) {
+            uas_data->LocationValid = 1;
+            return ODID_MESSAGETYPE_LOCATION;
+        }
+        break;
+    case ODID_MESSAGETYPE_AUTH: {
+        ODID_Auth_encoded *auth = (ODID_Auth_encoded *)msg_data;
+        int page;
+        if (getAuthPageNum(auth, &page) == ODID_SUCCESS &&
+            decodeAuthMessage(&uas_data->Auth[page], auth) == ODID_SUCCESS) {
+            uas_data->AuthValid[page] = 1;
+            return ODID_MESSAGETYPE_AUTH;
+        }
+        break;
+    }
+    case ODID_MESSAGETYPE_SELF_ID:
+        if (decodeSelfIDMessage(&uas_data->SelfID, (ODID_SelfID_encoded *)msg_data) == ODID_SUCCESS) {
+            uas_data->SelfIDValid = 1;
+            return ODID_MESSAGETYPE_SELF_ID;
+        }
+        break;
+    case ODID_MESSAGETYPE_SYSTEM:
+        if (decodeSystemMessage(&uas_data->System, (ODID_System_encoded *)msg_data) == ODID_SUCCESS) {
+            uas_data->SystemValid = 1;
+            return ODID_MESSAGETYPE_SYSTEM;
+        }
+        break;
+    case ODID_MESSAGETYPE_OPERATOR_ID:
+        if (decodeOperatorIDMessage(&uas_data->OperatorID, (ODID_OperatorID_encoded *)msg_data) == ODID_SUCCESS) {
+            uas_data->OperatorIDValid = 1;
+            return ODID_MESSAGETYPE_OPERATOR_ID;
+        }
+        break;
+    case ODID_MESSAGETYPE_PACKED:
+        if (decodeMessagePack(uas_data, (ODID_MessagePack_encoded *)msg_data) == ODID_SUCCESS) {
+            return ODID_MESSAGETYPE_PACKED;
+        }
+        break;
+    default:
+        break;
+    }
+    return ODID_MESSAGETYPE_INVALID;
+}
+
+ODID_Horizontal_accuracy_t createEnumHorizontalAccuracy(float Accuracy)
+{
+    return (ODID_Horizontal_accuracy_t)accuracy_to_enum(Accuracy, HOR_ACC_LIMITS, ARRAY_SIZE(HOR_ACC_LIMITS));
+}
+
+ODID_Vertical_accuracy_t createEnumVerticalAccuracy(float Accuracy)
+{
+    return (ODID_Vertical_accuracy_t)accuracy_to_enum(Accuracy, VER_ACC_LIMITS, ARRAY_SIZE(VER_ACC_LIMITS));
+}
+
+ODID_Speed_accuracy_t createEnumSpeedAccuracy(float Accuracy)
+{
+    return (ODID_Speed_accuracy_t)accuracy_to_enum(Accuracy, SPEED_ACC_LIMITS, ARRAY_SIZE(SPEED_ACC_LIMITS));
+}
+
+// timestamp accuracy is in steps of 0.1s up to 1.5s
+ODID_Timestamp_accuracy_t createEnumTimestampAccuracy(float Accuracy)
+{
+    if (!(Accuracy > 0) || Accuracy > 1.5f) {
+        return ODID_TIME_ACC_UNKNOWN;
+    }
+    return (ODID_Timestamp_accuracy_t)intRangeMax((int64_t)ceilf(Accuracy * 10 - 0.001f), 1, ODID_TIME_ACC_1_5_SECOND);
+}
+
+float decodeHorizontalAccuracy(ODID_Horizontal_accuracy_t Accuracy)
+{
+    return enum_to_accuracy(Accuracy, HOR_ACC_LIMITS, ARRAY_SIZE(HOR_ACC_LIMITS));
+}
+
+float decodeVerticalAccuracy(ODID_Vertical_accuracy_t Accuracy)
+{
+    return enum_to_accuracy(Accuracy, VER_ACC_LIMITS, ARRAY_SIZE(VER_ACC_LIMITS));
+}
+
+float decodeSpeedAccuracy(ODID_Speed_accuracy_t Accuracy)
+{
+    return enum_to_accuracy(Accuracy, SPEED_ACC_LIMITS, ARRAY_SIZE(SPEED_ACC_LIMITS));
+}
+
+float decodeTimestampAccuracy(ODID_Timestamp_accuracy_t Accuracy)
+{
+    return Accuracy <= ODID_TIME_ACC_1_5_SECOND ? Accuracy * 0.1f : 0;
+}
+
+/*
+  encode all valid messages of UAS_Data directly into pack. Layout is
+  ODID_MessagePack_encoded truncated to the number of messages.
+  Returns the pack length, or < 0 on failure
+ */
+int odid_message_build_pack(ODID_UAS_Data *UAS_Data, void *pack, size_t buflen)
+{
+    if (!UAS_Data || !pack) {
+        return -1;
+    }
+    ODID_MessagePack_encoded *enc = (ODID_MessagePack_encoded *)pack;
+    uint8_t count = 0;
+
+    // encode one message into the next free slot of the pack
+#define PACK_ENCODE(valid, encoder, type, data)                              \
+    if (valid) {                                                             \
+        if (count >= ODID_PACK_MAX_MESSAGES ||                               \
+            3 + (count+1U)*ODID_MESSAGE_SIZE > buflen) {                     \
+            return -1;                                                       \
+        }                                                                    \
+        if (encoder((type *)&enc->Messages[count], data) == ODID_SUCCESS) {  \
+            count++;                                                         \
+        }                                                                    \
+    }
+
+    for (int i = 0; i < ODID_BASIC_ID_MAX_MESSAGES; i++) {
+        PACK_ENCODE(UAS_Data->BasicIDValid[i], encodeBasicIDMessage, ODID_BasicID_encoded, &UAS_Data->BasicID[i]);
+    }
+    PACK_ENCODE(UAS_Data->LocationValid, encodeLocationMessage, ODID_Location_encoded, &UAS_Data->Location);
+    for (int i = 0; i < ODID_AUTH_MAX_PAGES; i++) {
+        PACK_ENCODE(UAS_Data->AuthValid[i], encodeAuthMessage, ODID_Auth_encoded, &UAS_Data->Auth[i]);
+    }
+    PACK_ENCODE(UAS_Data->SelfIDValid, encodeSelfIDMessage, ODID_SelfID_encoded, &UAS_Data->SelfID);
+    PACK_ENCODE(UAS_Data->SystemValid, encodeSystemMessage, ODID_System_encoded, &UAS_Data->System);
+    PACK_ENCODE(UAS_Data->OperatorIDValid, encodeOperatorIDMessage, ODID_OperatorID_encoded, &UAS_Data->OperatorID);
+#undef PACK_ENCODE
+
+    if (count == 0) {
+        return -1;
+    }
+
+    enc->MessageType = ODID_MESSAGETYPE_PACKED;
+    enc->ProtoVersion = ODID_PROTOCOL_VERSION;
+    enc->SingleMessageSize = ODID_MESSAGE_SIZE;
+    enc->MsgPackSize = count;
+    return 3 + count*ODID_MESSAGE_SIZE;
+}
+
+/*
+  decode a message pack received over the air
+ */
+int odid_message_process_pack(ODID_UAS_Data *UAS_Data, uint8_t *pack, size_t buflen)
+{
+    if (!UAS_Data || !pack || buflen < 3) {
+        return -1;
+    }
+    ODID_MessagePack_encoded *enc = (ODID_MessagePack_encoded *)pack;
+    if (3U + enc->MsgPackSize * ODID_MESSAGE_SIZE > buflen) {
+        return -1;
+    }
+    if (decodeMessagePack(UAS_Data, enc) != ODID_SUCCESS) {
+        return -1;
+    }
+    return 0;
+}
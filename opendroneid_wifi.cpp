@@ -0,0 +1,445 @@
+/*
+ * OpenDroneID WiFi frames for OndOcean RemoteID
+ *
+ * Beacon frames follow ASTM F3411 / ASD-STAN prEN 4709-002: the message
+ * pack is carried in a vendor specific IE (OUI FA:0B:BC, type 0x0D).
+ * NAN frames follow the Neighbor Awareness Networking specification v3.1
+ * with the Remote ID service id and the fixed cluster id from F3411.
+ *
+ * All multi-byte fields are little endian, as on the ESP32.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <esp_timer.h>
+#include "opendroneid_wifi.h"
+
+#define IEEE80211_FTYPE_MGMT        0x0000
+#define IEEE80211_STYPE_ACTION      0x00D0
+#define IEEE80211_STYPE_BEACON      0x0080
+
+#define IEEE80211_CAPINFO_SHORT_SLOTTIME 0x0400
+
+#define IEEE80211_ELEMID_SSID       0x00
+#define IEEE80211_ELEMID_RATES      0x01
+#define IEEE80211_ELEMID_VENDOR     0xDD
+
+struct __attribute__((__packed__)) ieee80211_mgmt {
+    uint16_t frame_control;
+    uint16_t duration;
+    uint8_t da[6];
+    uint8_t sa[6];
+    uint8_t bssid[6];
+    uint16_t seq_ctrl;
+};
+
+struct __attribute__((__packed__)) ieee80211_beacon {
+    uint64_t timestamp;
+    uint16_t beacon_interval;
+    uint16_t capability;
+};
+
+struct __attribute__((__packed__)) ieee80211_ssid {
+    uint8_t element_id;
+    uint8_t length;
+};
+
+struct __attribute__((__packed__)) ieee80211_supported_rates {
+    uint8_t element_id;
+    uint8_t length;
+    uint8_t supported_rates;
+};
+
+struct __attribute__((__packed__)) ieee80211_vendor_specific {
+    uint8_t element_id;
+    uint8_t length;
+    uint8_t oui[3];
+    uint8_t oui_type;
+};
+
+struct __attribute__((__packed__)) nan_attribute_header {
+    uint8_t attribute_id;
+    uint16_t length;
+};
+
+struct __attribute__((__packed__)) nan_master_indication_attribute {
+    nan_attribute_header header;
+    uint8_t master_preference;
+    uint8_t random_factor;
+};
+
+struct __attribute__((__packed__)) nan_cluster_attribute {
+    nan_attribute_header header;
+    uint8_t device_mac[6];
+    uint8_t random_factor;
+    uint8_t master_preference;
+    uint8_t hop_count_to_anchor_master;
+    uint8_t anchor_master_beacon_transmission_time[4];
+};
+
+struct __attribute__((__packed__)) nan_service_id_list_attribute {
+    nan_attribute_header header;
+    uint8_t service_id[6];
+};
+
+struct __attribute__((__packed__)) nan_service_discovery {
+    uint8_t category;
+    uint8_t action_code;
+    uint8_t oui[3];
+    uint8_t oui_type;
+};
+
+struct __attribute__((__packed__)) nan_service_descriptor_attribute {
+    nan_attribute_header header;
+    uint8_t service_id[6];
+    uint8_t instance_id;
+    uint8_t requestor_instance_id;
+    uint8_t service_control;
+    uint8_t service_info_length;
+};
+
+struct __attribute__((__packed__)) nan_service_descriptor_extension_attribute {
+    nan_attribute_header header;
+    uint8_t instance_id;
+    uint16_t control;
+    uint8_t service_update_indicator;
+};
+
+struct __attribute__((__packed__)) ODID_service_info {
+    uint8_t message_counter;
+};
+
+// NAN broadcast address
+static const uint8_t nan_target_addr[6] = { 0x51, 0x6F, 0x9A, 0x01, 0x00, 0x00 };
+// the F3411 Remote ID NAN cluster id is fixed
+static const uint8_t nan_cluster_id[6] = { 0x50, 0x6F, 0x9A, 0x01, 0x00, 0xFF };
+static const uint8_t wifi_alliance_oui[3] = { 0x50, 0x6F, 0x9A };
+// hash of "org.opendroneid.remoteid"
+static const uint8_t nan_service_id[6] = { 0x88, 0x69, 0x19, 0x9D, 0x92, 0x09 };
+static const uint8_t asd_stan_oui[3] = { 0xFA, 0x0B, 0xBC };
+
+/*
+  reserve a struct at the end of the frame, returning nullptr if it
+  does not fit
+ */
+template <typename T>
+static T *frame_append(uint8_t *buf, size_t &len, size_t buf_size, size_t extra=0)
+{
+    if (len + sizeof(T) + extra > buf_size) {
+        return nullptr;
+    }
+    T *ret = (T *)(buf + len);
+    memset(ret, 0, sizeof(T));
+    len += sizeof(T);
+    return ret;
+}
+
+static int fill_ieee80211_mgmt(uint8_t *buf, size_t &len, size_t buf_size,
+                               uint16_t subtype,
+                               const uint8_t *dst_addr,
+                               const uint8_t *src_addr,
+                               const uint8_t *bssid)
+{
+    auto *mgmt = frame_append<ieee80211_mgmt>(buf, len, buf_size);
+    if (mgmt == nullptr) {
+        return -ENOMEM;
+    }
+    mgmt->frame_control = IEEE80211_FTYPE_MGMT | subtype;
+    memcpy(mgmt->da, dst_addr, sizeof(mgmt->da));
+    memcpy(mgmt->sa, src_addr, sizeof(mgmt->sa));
+    memcpy(mgmt->bssid, bssid, sizeof(mgmt->bssid));
+    return 0;
+}
+
+static int fill_ieee80211_beacon(uint8_t *buf, size_t &len, size_t buf_size, uint16_t interval_tu)
+{
+    auto *bcn = frame_append<ieee80211_beacon>(buf, len, buf_size);
+    if (bcn == nullptr) {
+        return -ENOMEM;
+    }
+    bcn->timestamp = (uint64_t)esp_timer_get_time();
+    bcn->beacon_interval = interval_tu;
+    bcn->capability = IEEE80211_CAPINFO_SHORT_SLOTTIME;
+    return 0;
+}
+
+static bool pack_valid(const uint8_t *pack, size_t pack_len)
+{
+    return pack != nullptr &&
+           pack_len >= 3 + ODID_MESSAGE_SIZE &&
+           pack_len <= 255 - sizeof(ODID_service_info) - 4 &&
+           pack_len == 3U + pack[2] * ODID_MESSAGE_SIZE;
+}
+
+int odid_wifi_build_nan_sync_beacon_frame(char *mac, uint8_t *buf, size_t buf_size)
+{
+    if (mac == nullptr || buf == nullptr) {
+        return -EINVAL;
+    }
+    size_t len = 0;
+    int ret = fill_ieee80211_mgmt(buf, len, buf_size, IEEE80211_STYPE_BEACON,
+                                  nan_target_addr, (const uint8_t *)mac, nan_cluster_id);
+    if (ret < 0) {
+        return ret;
+    }
+    ret = fill_ieee80211_beacon(buf, len, buf_size, 0x0200);
+    if (ret < 0) {
+        return ret;
+    }
+
+    auto *vendor = frame_append<ieee80211_vendor_specific>(buf, len, buf_size);
+    auto *master = frame_append<nan_master_indication_attribute>(buf, len, buf_size);
+    auto *cluster = frame_append<nan_cluster_attribute>(buf, len, buf_size);
+    auto *nsila = frame_append<nan_service_id_list_attribute>(buf, len, buf_size);
+    if (vendor == nullptr || master == nullptr || cluster == nullptr || nsila == nullptr) {
+        return -ENOMEM;
+    }
+
+    vendor->element_id = IEEE80211_ELEMID_VENDOR;
+    vendor->length = sizeof(*vendor) - 2 + sizeof(*master) + sizeof(*cluster) + sizeof(*nsila);
+    memcpy(vendor->oui, wifi_alliance_oui, sizeof(vendor->oui));
+    vendor->oui_type = 0x13;
+
+    master->header.attribute_id = 0x00;
+    master->header.length = sizeof(*master) - sizeof(master->header);
+    master->master_preference = 0xFE;
+    // random factor recommended by the European standard
+    master->random_factor = 0xEA;
+
+    cluster->header.attribute_id = 0x01;
+    cluster->header.length = sizeof(*cluster) - sizeof(cluster->header);
+    memcpy(cluster->device_mac, mac, sizeof(cluster->device_mac));
+    cluster->random_factor = 0xEA;
+    cluster->master_preference = 0xFE;
+
+    nsila->header.attribute_id = 0x02;
+    nsila->header.length = sizeof(*nsila) - sizeof(nsila->header);
+    memcpy(nsila->service_id, nan_service_id, sizeof(nsila->service_id));
+
+    return (int)len;
+}
+
+int odid_wifi_build_nan_action_frame_template(char *mac, uint8_t *buf, size_t buf_size)
+{
+    if (mac == nullptr || buf == nullptr) {
+        return -EINVAL;
+    }
+    size_t len = 0;
+    const int ret = fill_ieee80211_mgmt(buf, len, buf_size, IEEE80211_STYPE_ACTION,
+                                        nan_target_addr, (const uint8_t *)mac, nan_cluster_id);
+    if (ret < 0) {
+        return ret;
+    }
+
+    auto *nsd = frame_append<nan_service_discovery>(buf, len, buf_size);
+    auto *nsda = frame_append<nan_service_descriptor_attribute>(buf, len, buf_size);
+    auto *si = frame_append<ODID_service_info>(buf, len, buf_size);
+    if (nsd == nullptr || nsda == nullptr || si == nullptr) {
+        return -ENOMEM;
+    }
+
+    nsd->category = 0x04;     // IEEE 802.11 Public Action frame
+    nsd->action_code = 0x09;  // Vendor Specific
+    memcpy(nsd->oui, wifi_alliance_oui, sizeof(nsd->oui));
+    nsd->oui_type = 0x13;     // NAN
+
+    nsda->header.attribute_id = 0x03;
+    memcpy(nsda->service_id, nan_service_id, sizeof(nsda->service_id));
+    nsda->instance_id = 0x01;
+    nsda->requestor_instance_id = 0x00;
+    nsda->service_control = 0x10; // follow up
+
+    return (int)len;
+}
+
+int odid_wifi_patch_nan_action_frame(uint8_t *buf, size_t buf_size, size_t pack_offset,
+                                     const uint8_t *pack, size_t pack_len,
+                                     uint8_t send_counter)
+{
+    if (!pack_valid(pack, pack_len) || buf == nullptr ||
+        pack_offset < sizeof(nan_service_descriptor_attribute) + sizeof(ODID_service_info)) {
+        return -EINVAL;
+    }
+    size_t len = pack_offset;
+    if (len + pack_len > buf_size) {
+        return -ENOMEM;
+    }
+    memcpy(buf + len, pack, pack_len);
+    len += pack_len;
+    auto *nsdea = frame_append<nan_service_descriptor_extension_attribute>(buf, len, buf_size);
+    if (nsdea == nullptr) {
+        return -ENOMEM;
+    }
+
+    auto *si = (ODID_service_info *)(buf + pack_offset - sizeof(ODID_service_info));
+    auto *nsda = (nan_service_descriptor_attribute *)((uint8_t *)si - sizeof(nan_service_descriptor_attribute));
+    si->message_counter = send_counter;
+    nsda->service_info_length = sizeof(*si) + pack_len;
+    nsda->header.length = sizeof(*nsda) - sizeof(nsda->header) + nsda->service_info_length;
+
+    nsdea->header.attribute_id = 0x0E;
+    nsdea->header.length = sizeof(*nsdea) - sizeof(nsdea->header);
+    nsdea->instance_id = 0x01;
+    nsdea->control = 0x0200;
+    nsdea->service_update_indicator = send_counter;
+
+    return (int)len;
+}
+
+int odid_wifi_build_message_pack_nan_action_frame_from_pack(const uint8_t *pack,
+                                                             size_t pack_len,
+                                                             char *mac,
+                                                             uint8_t send_counter,
+                                                             uint8_t *buf,
+                                                             size_t buf_size)
+{
+    const int pack_offset = odid_wifi_build_nan_action_frame_template(mac, buf, buf_size);
+    if (pack_offset < 0) {
+        return pack_offset;
+    }
+    return odid_wifi_patch_nan_action_frame(buf, buf_size, pack_offset, pack, pack_len, send_counter);
+}
+
+void odid_wifi_update_beacon_timestamp(uint8_t *buf, size_t len)
+{
+    if (buf == nullptr || len < sizeof(ieee80211_mgmt) + sizeof(ieee80211_beacon)) {
+        return;
+    }
+    auto *bcn = (ieee80211_beacon *)(buf + sizeof(ieee80211_mgmt));
+    bcn->timestamp = (uint64_t)esp_timer_get_time();
+}
+
+int odid_wifi_build_message_pack_beacon_frame_from_pack(const uint8_t *pack,
+                                                         size_t pack_len,
+                                                         char *mac,
+                                                         const char *SSID,
+                                                         size_t SSID_len,
+                                                         uint16_t interval_tu,
+                                                         uint8_t send_counter,
+                                                         uint8_t *buf,
+                                                         size_t buf_size)
+{
+    static const uint8_t broadcast_addr[6] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+
+    if (!pack_valid(pack, pack_len) || mac == nullptr || buf == nullptr) {
+        return -EINVAL;
+    }
+    if (SSID == nullptr || SSID_len == 0 || SSID_len > 32) {
+        return -EINVAL;
+    }
+    size_t len = 0;
+    int ret = fill_ieee80211_mgmt(buf, len, buf_size, IEEE80211_STYPE_BEACON,
+                                  broadcast_addr, (const uint8_t *)mac, (const uint8_t *)mac);
+    if (ret < 0) {
+        return ret;
+    }
+    ret = fill_ieee80211_beacon(buf, len, buf_size, interval_tu);
+    if (ret < 0) {
+        return ret;
+    }
+
+    auto *ssid = frame_append<ieee80211_ssid>(buf, len, buf_size, SSID_len);
+    if (ssid == nullptr) {
+        return -ENOMEM;
+    }
+    ssid->element_id = IEEE80211_ELEMID_SSID;
+    ssid->length = (uint8_t)SSID_len;
+    memcpy(buf + len, SSID, SSID_len);
+    len += SSID_len;
+
+    auto *rates = frame_append<ieee80211_supported_rates>(buf, len, buf_size);
+    auto *vendor = frame_append<ieee80211_vendor_specific>(buf, len, buf_size);
+    auto *si = frame_append<ODID_service_info>(buf, len, buf_size, pack_len);
+    if (rates == nullptr || vendor == nullptr || si == nullptr) {
+        return -ENOMEM;
+    }
+    memcpy(buf + len, pack, pack_len);
+    len += pack_len;
+
+    rates->element_id = IEEE80211_ELEMID_RATES;
+    rates->length = 1;
+    rates->supported_rates = 0x8C; // 6 Mbps
+
+    vendor->element_id = IEEE80211_ELEMID_VENDOR;
+    vendor->length = sizeof(vendor->oui) + sizeof(vendor->oui_type) + sizeof(*si) + pack_len;
+    memcpy(vendor->oui, asd_stan_oui, sizeof(vendor->oui));
+    vendor->oui_type = 0x0D;
+
+    si->message_counter = send_counter;
+
+    return (int)len;
+}
+
+int odid_wifi_build_message_pack_nan_action_frame(ODID_UAS_Data *UAS_Data, char *mac,
+                                                  uint8_t send_counter,
+                                                  uint8_t *buf, size_t buf_size)
+{
+    ODID_MessagePack_encoded pack;
+    const int pack_len = odid_message_build_pack(UAS_Data, &pack, sizeof(pack));
+    if (pack_len < 0) {
+        return pack_len;
+    }
+    return odid_wifi_build_message_pack_nan_action_frame_from_pack((const uint8_t *)&pack, pack_len,
+                                                                   mac, send_counter, buf, buf_size);
+}
+
+int odid_wifi_build_message_pack_beacon_frame(ODID_UAS_Data *UAS_Data, char *mac,
+                                              const char *SSID, size_t SSID_len,
+                                              uint16_t interval_tu, uint8_t send_counter,
+                                              uint8_t *buf, size_t buf_size)
+{
+    ODID_MessagePack_encoded pack;
+    const int pack_len = odid_message_build_pack(UAS_Data, &pack, sizeof(pack));
+    if (pack_len < 0) {
+        return pack_len;
+    }
+    return odid_wifi_build_message_pack_beacon_frame_from_pack((const uint8_t *)&pack, pack_len,
+                                                               mac, SSID, SSID_len, interval_tu,
+                                                               send_counter, buf, buf_size);
+}
+
+/*
+  extract the message pack from a received NAN action frame
+ */
+int odid_wifi_receive_message_pack_nan_action_frame(ODID_UAS_Data *UAS_Data,
+                                                    char *mac, uint8_t *buf, size_t buf_size)
+{
+    if (UAS_Data == nullptr || mac == nullptr || buf == nullptr) {
+        return -EINVAL;
+    }
+    size_t len = 0;
+    const size_t min_len = sizeof(ieee80211_mgmt) + sizeof(nan_service_discovery) +
+                           sizeof(nan_service_descriptor_attribute) + sizeof(ODID_service_info);
+    if (buf_size < min_len) {
+        return -EINVAL;
+    }
+
+    const auto *mgmt = (const ieee80211_mgmt *)buf;
+    if ((mgmt->frame_control & 0x00FC) != (IEEE80211_FTYPE_MGMT | IEEE80211_STYPE_ACTION)) {
+        return -EINVAL;
+    }
+    memcpy(mac, mgmt->sa, sizeof(mgmt->sa));
+    len += sizeof(*mgmt);
+
+    const auto *nsd = (const nan_service_discovery *)(buf + len);
+    if (nsd->category != 0x04 || nsd->action_code != 0x09 ||
+        memcmp(nsd->oui, wifi_alliance_oui, sizeof(nsd->oui)) != 0 ||
+        nsd->oui_type != 0x13) {
+        return -EINVAL;
+    }
+    len += sizeof(*nsd);
+
+    const auto *nsda = (const nan_service_descriptor_attribute *)(buf + len);
+    if (nsda->header.attribute_id != 0x03 ||
+        memcmp(nsda->service_id, nan_service_id, sizeof(nsda->service_id)) != 0 ||
+        nsda->service_info_length < sizeof(ODID_service_info) + 3) {
+        return -EINVAL;
+    }
+    len += sizeof(*nsda) + sizeof(ODID_service_info);
+
+    const size_t pack_len = nsda->service_info_length - sizeof(ODID_service_info);
+    if (len + pack_len > buf_size) {
+        return -EINVAL;
+    }
+    return odid_message_process_pack(UAS_Data, buf + len, pack_len);
+}
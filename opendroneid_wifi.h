@@ -0,0 +1,57 @@
+/*
+ * OpenDroneID WiFi frames for OndOcean RemoteID
+ *
+ * 802.11 Beacon and NAN frame builders. The builders taking UAS_Data are
+ * declared in opendroneid.h
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "opendroneid.h"
+
+// buffer sizes for the persistent NAN frames
+#define ODID_WIFI_NAN_SYNC_FRAME_SIZE   80
+#define ODID_WIFI_NAN_ACTION_FRAME_SIZE (64 + 3 + ODID_PACK_MAX_MESSAGES*ODID_MESSAGE_SIZE)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Frame builders taking an already encoded message pack, so the pack
+// can be built once per tick and shared between transmitters.
+// Return the frame length, or < 0 on error
+int odid_wifi_build_message_pack_beacon_frame_from_pack(const uint8_t *pack,
+                                                         size_t pack_len,
+                                                         char *mac,
+                                                         const char *SSID,
+                                                         size_t SSID_len,
+                                                         uint16_t interval_tu,
+                                                         uint8_t send_counter,
+                                                         uint8_t *buf,
+                                                         size_t buf_size);
+
+int odid_wifi_build_message_pack_nan_action_frame_from_pack(const uint8_t *pack,
+                                                             size_t pack_len,
+                                                             char *mac,
+                                                             uint8_t send_counter,
+                                                             uint8_t *buf,
+                                                             size_t buf_size);
+
+// Persistent NAN action frame. The template holds everything up to the
+// message counter and returns the offset where the message pack goes.
+// The patch fills in counter, pack and the trailing attribute in place
+// and returns the frame length. Both return < 0 on error
+int odid_wifi_build_nan_action_frame_template(char *mac, uint8_t *buf, size_t buf_size);
+
+int odid_wifi_patch_nan_action_frame(uint8_t *buf, size_t buf_size, size_t pack_offset,
+                                     const uint8_t *pack, size_t pack_len,
+                                     uint8_t send_counter);
+
+// refresh the TSF timestamp of a prebuilt beacon frame
+void odid_wifi_update_beacon_timestamp(uint8_t *buf, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
@@ -11,3 +11,8 @@
 
 // do we support MAVLink connnection to flight controller?
 #define AP_MAVLINK_ENABLED 1
+
+// record per-stage execution time histograms (status page and MQTT diagnostics)
+#ifndef AP_STAGE_TIMING_ENABLED
+#define AP_STAGE_TIMING_ENABLED 1
+#endif
@@ -6,11 +6,12 @@
 #include <string.h>
 #include "romfs.h"
 #include "util.h"
+#include "semaphore.h"
 
 Parameters g;
 static nvs_handle handle;
 
-const Parameters::Param Parameters::params[] = {
+constexpr Parameters::Param Parameters::params[] = {
     { "LOCK_LEVEL",        Parameters::ParamType::INT8,  (const void*)&g.lock_level,       0, -1, 2 },
     { "CAN_NODE",          Parameters::ParamType::UINT8,  (const void*)&g.can_node,         0, 0, 127 },
 #if defined(PIN_CAN_TERM)
@@ -28,6 +29,7 @@ const Parameters::Param Parameters::params[] = {
     { "WIFI_POWER",        Parameters::ParamType::FLOAT,  (const void*)&g.wifi_power,       20, 2, 20 },
     { "BT4_RATE",          Parameters::ParamType::FLOAT,  (const void*)&g.bt4_rate,         1, 0, 5 },
     { "BT4_POWER",         Parameters::ParamType::FLOAT,  (const void*)&g.bt4_power,        18, -27, 18 },
+    { "BT4_LOC_WEIGHT",    Parameters::ParamType::UINT8,  (const void*)&g.bt4_loc_weight,   5, 1, 20 }, // Location slots per BT4 rotation, other messages get 1
     { "BT5_RATE",          Parameters::ParamType::FLOAT,  (const void*)&g.bt5_rate,         1, 0, 5 },
     { "BT5_POWER",         Parameters::ParamType::FLOAT,  (const void*)&g.bt5_power,        18, -27, 18 },
     { "WEBSERVER_EN",      Parameters::ParamType::UINT8,  (const void*)&g.webserver_enable, 1, 0, 1 },
@@ -41,6 +43,7 @@ const Parameters::Param Parameters::params[] = {
     { "PUBLIC_KEY4",       Parameters::ParamType::CHAR64, (const void*)&g.public_keys[3], },
     { "PUBLIC_KEY5",       Parameters::ParamType::CHAR64, (const void*)&g.public_keys[4], },
     { "MAVLINK_SYSID",     Parameters::ParamType::UINT8,  (const void*)&g.mavlink_sysid,    0, 0, 254 },
+    { "GNSS_TYPE",         Parameters::ParamType::UINT8,  (const void*)&g.gnss_type,        1, 0, 1 }, // 0: NMEA, 1: u-blox UBX NAV-PVT
     { "OPTIONS",           Parameters::ParamType::UINT8,  (const void*)&g.options,          0, 0, 254 },
     { "TO_DEFAULTS",     Parameters::ParamType::UINT8,  (const void*)&g.to_factory_defaults,    0, 0, 1 }, //if set to 1, reset to factory defaults and make 0.
     { "DONE_INIT",         Parameters::ParamType::UINT8,  (const void*)&g.done_init,        0, 0, 0, PARAM_FLAG_HIDDEN},
@@ -48,26 +51,149 @@ const Parameters::Param Parameters::params[] = {
 };
 
 /*
-  get count of parameters capable of being converted to load
+  name lookup and float index tables, built at compile time from
+  params[]. Names go through a two level perfect hash: the first hash
+  picks a bucket, and each bucket has a seed, found here, that sends
+  its names to slots no other name uses. find() is then two hashes and
+  one strcmp however long the table grows
  */
-uint16_t Parameters::param_count_float(void)
+static constexpr uint16_t NUM_PARAMS = ARRAY_SIZE(Parameters::params);
+static_assert(NUM_PARAMS < 255, "param lookup uses 8 bit indexes");
+
+static constexpr uint16_t pow2_at_least(uint16_t n)
 {
-    uint16_t count = 0;
-    for (const auto &p : params) {
-        if (p.flags & PARAM_FLAG_HIDDEN) {
-            continue;
+    uint16_t v = 1;
+    while (v < n) {
+        v <<= 1;
+    }
+    return v;
+}
+
+// about two names per bucket, slots at most half full
+static constexpr uint16_t PARAM_BUCKETS = pow2_at_least((NUM_PARAMS+1)/2);
+static constexpr uint16_t PARAM_SLOTS = pow2_at_least(NUM_PARAMS*2);
+static constexpr uint8_t PARAM_EMPTY = 0xFF;
+
+// FNV-1a, seeded
+static constexpr uint32_t param_hash(const char *name, uint32_t seed)
+{
+    uint32_t h = 2166136261U ^ (seed * 0x9E3779B9U);
+    while (*name) {
+        h = (h ^ uint8_t(*name++)) * 16777619U;
+    }
+    return h;
+}
+
+static constexpr uint16_t param_bucket(const char *name)
+{
+    return param_hash(name, 0) & (PARAM_BUCKETS-1);
+}
+
+static constexpr uint16_t param_slot(const char *name, uint8_t seed)
+{
+    return param_hash(name, uint32_t(seed)+1) & (PARAM_SLOTS-1);
+}
+
+static constexpr bool float_capable(const Parameters::Param &p)
+{
+    if (p.flags & PARAM_FLAG_HIDDEN) {
+        return false;
+    }
+    switch (p.ptype) {
+    case Parameters::ParamType::UINT8:
+    case Parameters::ParamType::INT8:
+    case Parameters::ParamType::UINT32:
+    case Parameters::ParamType::FLOAT:
+        return true;
+    default:
+        return false;
+    }
+}
+
+struct Param_Lookup {
+    bool ok;
+    uint8_t seed[PARAM_BUCKETS];
+    uint8_t slot[PARAM_SLOTS];              // index into params[]
+    int16_t float_index[NUM_PARAMS];        // -1 if not float capable
+    uint8_t by_float_index[NUM_PARAMS];
+    uint16_t count_float;
+};
+
+static constexpr Param_Lookup build_param_lookup(void)
+{
+    Param_Lookup lk {};
+    for (uint16_t i=0; i<PARAM_SLOTS; i++) {
+        lk.slot[i] = PARAM_EMPTY;
+    }
+
+    // place the fullest buckets first, while most slots are free
+    uint8_t bucket_size[PARAM_BUCKETS] {};
+    uint8_t max_size = 0;
+    for (uint16_t i=0; i<NUM_PARAMS; i++) {
+        const uint8_t n = ++bucket_size[param_bucket(Parameters::params[i].name)];
+        if (n > max_size) {
+            max_size = n;
         }
-        switch (p.ptype) {
-        case ParamType::UINT8:
-        case ParamType::INT8:
-        case ParamType::UINT32:
-        case ParamType::FLOAT:
-            count++;
-            break;
+    }
+    for (uint8_t size=max_size; size>0; size--) {
+        for (uint16_t b=0; b<PARAM_BUCKETS; b++) {
+            if (bucket_size[b] != size) {
+                continue;
+            }
+            bool placed = false;
+            for (uint16_t seed=0; seed<PARAM_EMPTY && !placed; seed++) {
+                // try the seed, undoing a partial placement on a clash
+                placed = true;
+                for (uint16_t i=0; i<NUM_PARAMS; i++) {
+                    const char *name = Parameters::params[i].name;
+                    if (param_bucket(name) != b) {
+                        continue;
+                    }
+                    const uint16_t s = param_slot(name, seed);
+                    if (lk.slot[s] != PARAM_EMPTY) {
+                        placed = false;
+                        for (uint16_t j=0; j<i; j++) {
+                            const char *name2 = Parameters::params[j].name;
+                            if (param_bucket(name2) == b) {
+                                lk.slot[param_slot(name2, seed)] = PARAM_EMPTY;
+                            }
+                        }
+                        break;
+                    }
+                    lk.slot[s] = i;
+                }
+                if (placed) {
+                    lk.seed[b] = seed;
+                }
+            }
+            if (!placed) {
+                return lk;
+            }
+        }
+    }
+
+    for (uint16_t i=0; i<NUM_PARAMS; i++) {
+        if (float_capable(Parameters::params[i])) {
+            lk.float_index[i] = lk.count_float;
+            lk.by_float_index[lk.count_float++] = i;
+        } else {
+            lk.float_index[i] = -1;
         }
     }
+    lk.ok = true;
+    return lk;
+}
+
+static constexpr Param_Lookup param_lookup = build_param_lookup();
+static_assert(param_lookup.ok, "no perfect hash found for parameter names");
+
+/*
+  get count of parameters capable of being converted to load
+ */
+uint16_t Parameters::param_count_float(void)
+{
     // remove 1 for DONE_INIT
-    return count-1;
+    return param_lookup.count_float-1;
 }
 
 /*
@@ -75,24 +201,10 @@ uint16_t Parameters::param_count_float(void)
  */
 int16_t Parameters::param_index_float(const Parameters::Param *f)
 {
-    uint16_t count = 0;
-    for (const auto &p : params) {
-        if (p.flags & PARAM_FLAG_HIDDEN) {
-            continue;
-        }
-        switch (p.ptype) {
-        case ParamType::UINT8:
-        case ParamType::INT8:
-        case ParamType::UINT32:
-        case ParamType::FLOAT:
-            if (&p == f) {
-                return count;
-            }
-            count++;
-            break;
-        }
+    if (f < &params[0] || f >= &params[NUM_PARAMS]) {
+        return -1;
     }
-    return -1;
+    return param_lookup.float_index[f - &params[0]];
 }
 
 /*
@@ -100,12 +212,12 @@ int16_t Parameters::param_index_float(const Parameters::Param *f)
  */
 const Parameters::Param *Parameters::find(const char *name)
 {
-    for (const auto &p : params) {
-        if (strcmp(name, p.name) == 0) {
-            return &p;
-        }
+    const uint8_t seed = param_lookup.seed[param_bucket(name)];
+    const uint8_t i = param_lookup.slot[param_slot(name, seed)];
+    if (i == PARAM_EMPTY || strcmp(name, params[i].name) != 0) {
+        return nullptr;
     }
-    return nullptr;
+    return &params[i];
 }
 
 /*
@@ -124,63 +236,300 @@ const Parameters::Param *Parameters::find_by_index(uint16_t index)
  */
 const Parameters::Param *Parameters::find_by_index_float(uint16_t index)
 {
-    uint16_t count = 0;
-    for (const auto &p : params) {
-        if (p.flags & PARAM_FLAG_HIDDEN) {
-            continue;
+    if (index >= param_lookup.count_float) {
+        return nullptr;
+    }
+    return &params[param_lookup.by_float_index[index]];
+}
+
+/*
+  boot snapshot. Besides a key per parameter, each flush stores all
+  values in one blob, so init() loads them with a single NVS read
+  instead of a lookup per key. The blob carries a hash of the table
+  layout, defaults and ranges, and a CRC of the values; if either
+  doesn't match, init() falls back to the per-key values and a new
+  snapshot is written
+ */
+#define PARAM_SNAPSHOT_KEY "PARAM_SNAP"
+#define PARAM_SNAPSHOT_VERSION 1
+
+static constexpr uint8_t param_value_size(Parameters::ParamType ptype)
+{
+    switch (ptype) {
+    case Parameters::ParamType::UINT8:
+    case Parameters::ParamType::INT8:
+        return 1;
+    case Parameters::ParamType::UINT32:
+    case Parameters::ParamType::FLOAT:
+        return 4;
+    case Parameters::ParamType::CHAR20:
+        return 21;
+    case Parameters::ParamType::CHAR64:
+        // the size of a public key slot
+        return sizeof(Parameters::public_keys[0]);
+    default:
+        return 0;
+    }
+}
+
+static constexpr uint16_t snapshot_data_len(void)
+{
+    uint16_t len = 0;
+    for (const auto &p : Parameters::params) {
+        len += param_value_size(p.ptype);
+    }
+    return len;
+}
+
+/*
+  changes whenever a parameter is added, removed, renamed or retyped,
+  or its default or range changes. The snapshot holds the default of
+  every parameter never set, so a snapshot from a firmware with other
+  defaults must not load
+ */
+uint32_t Parameters::snapshot_layout(const Param *table)
+{
+    uint32_t h = PARAM_SNAPSHOT_VERSION;
+    for (const Param *p = table; p->ptype != ParamType::NONE; p++) {
+        h = (h ^ param_hash(p->name, uint32_t(p->ptype))) * 16777619U;
+        for (const float v : { p->default_value, p->min_value, p->max_value }) {
+            uint32_t bits;
+            memcpy(&bits, &v, sizeof(bits));
+            h = (h ^ bits) * 16777619U;
         }
-        switch (p.ptype) {
-        case ParamType::UINT8:
-        case ParamType::INT8:
-        case ParamType::UINT32:
-        case ParamType::FLOAT:
-            if (index == count) {
-                return &p;
-            }
-            count++;
-            break;
+    }
+    return h;
+}
+
+static struct {
+    uint32_t layout;
+    uint32_t crc;
+    uint8_t data[snapshot_data_len()];
+} snapshot;
+
+static bool snapshot_stale;
+static bool snapshot_loaded;
+static uint32_t load_us;
+
+/*
+  load all values from the snapshot, false if it is missing or
+  doesn't match this firmware
+ */
+static bool snapshot_load(void)
+{
+    size_t len = sizeof(snapshot);
+    if (nvs_get_blob(handle, PARAM_SNAPSHOT_KEY, &snapshot, &len) != ESP_OK ||
+        len != sizeof(snapshot) ||
+        snapshot.layout != Parameters::snapshot_layout(Parameters::params) ||
+        snapshot.crc != crc_crc32(0, snapshot.data, sizeof(snapshot.data))) {
+        return false;
+    }
+    const uint8_t *d = snapshot.data;
+    for (const auto &p : Parameters::params) {
+        const uint8_t n = param_value_size(p.ptype);
+        if (n > 0) {
+            memcpy((void *)p.ptr, d, n);
+            d += n;
+        }
+    }
+    return true;
+}
+
+static void snapshot_write(void)
+{
+    uint8_t *d = snapshot.data;
+    for (const auto &p : Parameters::params) {
+        const uint8_t n = param_value_size(p.ptype);
+        if (n > 0) {
+            memcpy(d, p.ptr, n);
+            d += n;
+        }
+    }
+    snapshot.layout = Parameters::snapshot_layout(Parameters::params);
+    snapshot.crc = crc_crc32(0, snapshot.data, sizeof(snapshot.data));
+    nvs_set_blob(handle, PARAM_SNAPSHOT_KEY, &snapshot, sizeof(snapshot));
+}
+
+/*
+  write-behind storage. A set changes the value in RAM and queues the
+  parameter; update() writes the queue to NVS once sets have been
+  quiet for a while, in the order parameters were first set, and
+  commits once per batch. A bulk upload of many parameters, or many
+  sets of one, then costs one batch instead of a flash write each
+ */
+#define PARAM_FLUSH_QUIET_MS 1000
+#define PARAM_FLUSH_MAX_MS   5000   // flush even if sets keep coming
+
+static Semaphore dirty_sem;
+static Semaphore flush_sem;
+static uint8_t dirty_list[NUM_PARAMS];
+static bool dirty[NUM_PARAMS];
+static uint8_t dirty_count;
+static uint32_t first_dirty_ms;
+static uint32_t last_set_ms;
+static uint32_t stat_sets;
+static uint32_t stat_writes;
+static uint32_t stat_commits;
+
+static void mark_dirty(const Parameters::Param *p)
+{
+    const uint8_t i = p - &Parameters::params[0];
+    WITH_SEMAPHORE(dirty_sem);
+    stat_sets++;
+    last_set_ms = millis();
+    if (!dirty[i]) {
+        dirty[i] = true;
+        if (dirty_count == 0) {
+            first_dirty_ms = last_set_ms;
+        }
+        dirty_list[dirty_count++] = i;
+    }
+}
+
+/*
+  write the RAM value of a parameter to NVS
+ */
+static void nvs_write(const Parameters::Param &p)
+{
+    switch (p.ptype) {
+    case Parameters::ParamType::UINT8:
+        nvs_set_u8(handle, p.name, p.get_uint8());
+        break;
+    case Parameters::ParamType::INT8:
+        nvs_set_i8(handle, p.name, p.get_int8());
+        break;
+    case Parameters::ParamType::UINT32:
+        nvs_set_u32(handle, p.name, p.get_uint32());
+        break;
+    case Parameters::ParamType::FLOAT: {
+        union {
+            float f;
+            uint32_t u32;
+        } u;
+        u.f = p.get_float();
+        nvs_set_u32(handle, p.name, u.u32);
+        break;
+    }
+    case Parameters::ParamType::CHAR20:
+    case Parameters::ParamType::CHAR64:
+        nvs_set_str(handle, p.name, (const char *)p.ptr);
+        break;
+    default:
+        break;
+    }
+}
+
+/*
+  write all pending parameters to NVS now. A parameter set while this
+  runs is queued again, so the next flush stores its final value
+ */
+void Parameters::flush(void)
+{
+    // the snapshot buffer is shared, one flush at a time
+    WITH_SEMAPHORE(flush_sem);
+    uint8_t list[NUM_PARAMS];
+    uint8_t count;
+    {
+        WITH_SEMAPHORE(dirty_sem);
+        if (dirty_count == 0 && !snapshot_stale) {
+            return;
+        }
+        count = dirty_count;
+        memcpy(list, dirty_list, count);
+        for (uint8_t i=0; i<count; i++) {
+            dirty[list[i]] = false;
         }
+        dirty_count = 0;
+        snapshot_stale = false;
     }
-    return nullptr;
+    for (uint8_t i=0; i<count; i++) {
+        nvs_write(params[list[i]]);
+    }
+    snapshot_write();
+    nvs_commit(handle);
+    WITH_SEMAPHORE(dirty_sem);
+    stat_writes += count + 1;
+    stat_commits++;
+}
+
+/*
+  flush once sets have gone quiet, or straight away if the snapshot
+  didn't load
+ */
+void Parameters::update(void)
+{
+    const uint32_t now_ms = millis();
+    bool due;
+    {
+        WITH_SEMAPHORE(dirty_sem);
+        due = snapshot_stale ||
+              (dirty_count > 0 &&
+               (now_ms - last_set_ms >= PARAM_FLUSH_QUIET_MS ||
+                now_ms - first_dirty_ms >= PARAM_FLUSH_MAX_MS));
+    }
+    if (due) {
+        flush();
+    }
+}
+
+uint32_t Parameters::get_sets(void)
+{
+    return stat_sets;
+}
+
+uint32_t Parameters::get_flash_writes(void)
+{
+    return stat_writes;
+}
+
+uint32_t Parameters::get_commits(void)
+{
+    return stat_commits;
+}
+
+uint32_t Parameters::get_load_us(void)
+{
+    return load_us;
+}
+
+bool Parameters::get_loaded_snapshot(void)
+{
+    return snapshot_loaded;
 }
 
 void Parameters::Param::set_uint8(uint8_t v) const
 {
     auto *p = (uint8_t *)ptr;
     *p = v;
-    nvs_set_u8(handle, name, *p);
     if (strcmp(name, "TO_DEFAULTS") == 0) {
         if (v == 1) {
+            // pending sets go too
             nvs_flash_erase();
             esp_restart();
         }
     }
+    mark_dirty(this);
 }
 
 void Parameters::Param::set_int8(int8_t v) const
 {
     auto *p = (int8_t *)ptr;
     *p = v;
-    nvs_set_i8(handle, name, *p);
+    mark_dirty(this);
 }
 
 void Parameters::Param::set_uint32(uint32_t v) const
 {
     auto *p = (uint32_t *)ptr;
     *p = v;
-    nvs_set_u32(handle, name, *p);
+    mark_dirty(this);
 }
 
 void Parameters::Param::set_float(float v) const
 {
     auto *p = (float *)ptr;
     *p = v;
-    union {
-        float f;
-        uint32_t u32;
-    } u;
-    u.f = v;
-    nvs_set_u32(handle, name, u.u32);
+    mark_dirty(this);
 }
 
 void Parameters::Param::set_char20(const char *v) const
@@ -190,7 +539,7 @@ void Parameters::Param::set_char20(const char *v) const
     }
     memset((void*)ptr, 0, 21);
     strncpy((char *)ptr, v, 20);
-    nvs_set_str(handle, name, v);
+    mark_dirty(this);
 }
 
 void Parameters::Param::set_char64(const char *v) const
@@ -200,7 +549,7 @@ void Parameters::Param::set_char64(const char *v) const
     }
     memset((void*)ptr, 0, 65);
     strncpy((char *)ptr, v, 64);
-    nvs_set_str(handle, name, v);
+    mark_dirty(this);
 }
 
 uint8_t Parameters::Param::get_uint8() const
@@ -316,33 +665,39 @@ void Parameters::init(void)
         nvs_open("storage", NVS_READWRITE, &handle) != ESP_OK) {
         Serial.printf("NVS init failed\n");
     }
-    // load values from NVS
-    for (const auto &p : params) {
-        switch (p.ptype) {
-        case ParamType::UINT8:
-            nvs_get_u8(handle, p.name, (uint8_t *)p.ptr);
-            break;
-        case ParamType::INT8:
-            nvs_get_i8(handle, p.name, (int8_t *)p.ptr);
-            break;
-        case ParamType::UINT32:
-            nvs_get_u32(handle, p.name, (uint32_t *)p.ptr);
-            break;
-        case ParamType::FLOAT:
-            nvs_get_u32(handle, p.name, (uint32_t *)p.ptr);
-            break;
-        case ParamType::CHAR20: {
-            size_t len = 21;
-            nvs_get_str(handle, p.name, (char *)p.ptr, &len);
-            break;
-        }
-        case ParamType::CHAR64: {
-            size_t len = 65;
-            nvs_get_str(handle, p.name, (char *)p.ptr, &len);
-            break;
-        }
+    // load values from NVS, with one read if the snapshot is good
+    const uint32_t start_us = micros();
+    snapshot_loaded = snapshot_load();
+    if (!snapshot_loaded) {
+        for (const auto &p : params) {
+            switch (p.ptype) {
+            case ParamType::UINT8:
+                nvs_get_u8(handle, p.name, (uint8_t *)p.ptr);
+                break;
+            case ParamType::INT8:
+                nvs_get_i8(handle, p.name, (int8_t *)p.ptr);
+                break;
+            case ParamType::UINT32:
+                nvs_get_u32(handle, p.name, (uint32_t *)p.ptr);
+                break;
+            case ParamType::FLOAT:
+                nvs_get_u32(handle, p.name, (uint32_t *)p.ptr);
+                break;
+            case ParamType::CHAR20: {
+                size_t len = 21;
+                nvs_get_str(handle, p.name, (char *)p.ptr, &len);
+                break;
+            }
+            case ParamType::CHAR64: {
+                size_t len = 65;
+                nvs_get_str(handle, p.name, (char *)p.ptr, &len);
+                break;
+            }
+            }
         }
+        snapshot_stale = true;
     }
+    load_us = micros() - start_us;
 
     if (strlen(g.wifi_ssid) == 0) {
         uint8_t mac[6] {};
@@ -360,7 +715,6 @@ void Parameters::init(void)
     }
 
     if (g.done_init == 0) {
-        set_by_name_uint8("DONE_INIT", 1);
         // setup public keys
         set_by_name_char64("PUBLIC_KEY1", ROMFS::find_string("public_keys/ArduPilot_public_key1.dat"));
         set_by_name_char64("PUBLIC_KEY2", ROMFS::find_string("public_keys/ArduPilot_public_key2.dat"));
@@ -371,7 +725,9 @@ void Parameters::init(void)
 #else
         set_by_name_char64("PUBLIC_KEY3", ROMFS::find_string("public_keys/ArduPilot_public_key3.dat"));
 #endif
-
+        // stored after the keys, so a first boot cut short runs again
+        set_by_name_uint8("DONE_INIT", 1);
+        flush();
     }
 }
 
@@ -411,7 +767,8 @@ bool Parameters::set_by_name_int8(const char *name, int8_t v)
 bool Parameters::set_by_name_char64(const char *name, const char *s)
 {
     const auto *f = find(name);
-    if (!f) {
+    // s is null for a public key missing from ROMFS
+    if (!f || s == nullptr) {
         return false;
     }
     f->set_char64(s);
@@ -31,6 +31,7 @@ public:
     float wifi_power;
     float bt4_rate;
     float bt4_power;
+    uint8_t bt4_loc_weight;
     float bt5_rate;
     float bt5_power;
     uint8_t done_init;
@@ -41,6 +42,7 @@ public:
     uint8_t wifi_channel = 6;
     uint8_t to_factory_defaults = 0;
     uint8_t options;
+    uint8_t gnss_type;
     struct {
         char b64_key[64];
     } public_keys[MAX_PUBLIC_KEYS];
@@ -106,6 +108,24 @@ public:
     static uint16_t param_count_float(void);
     static int16_t param_index_float(const Param *p);
 
+    /*
+      sets are stored to NVS in batches by update(). flush() stores
+      pending sets now, call it before a reboot
+     */
+    void update(void);
+    static void flush(void);
+
+    // parameter sets, NVS writes and NVS commits since boot
+    static uint32_t get_sets(void);
+    static uint32_t get_flash_writes(void);
+    static uint32_t get_commits(void);
+
+    // time init() took to load values, and whether the snapshot was used
+    static uint32_t get_load_us(void);
+    static bool get_loaded_snapshot(void);
+    // hash of a parameter table stored with the snapshot, up to the NONE entry
+    static uint32_t snapshot_layout(const Param *table);
+
 private:
     void load_defaults(void);
 };
@@ -0,0 +1,95 @@
+/*
+  timed buzzer and LED patterns
+
+  Alarms and the startup sequence used to toggle the buzzer and LED
+  with delay() in between, stalling whatever called them. A pattern is
+  a list of steps played by update() from the TX task tick, so it only
+  costs a time compare per tick and an output write per step.
+ */
+
+#include <Arduino.h>
+#include "pattern.h"
+#include "led.h"
+#include "util.h"
+#include "board_config_maritime.h"
+
+Pattern_Player pattern_player;
+
+static const PatternStep startup_steps[] {
+    { LED_COLOR_BLUE, false, 200 },
+    { LED_COLOR_OFF,  false, 200 },
+    { LED_COLOR_BLUE, false, 200 },
+    { LED_COLOR_OFF,  false, 200 },
+    { LED_COLOR_BLUE, false, 200 },
+    { LED_COLOR_OFF,  false, 200 },
+    { PATTERN_LED_KEEP, true, 100 },
+    { LED_COLOR_GREEN, false, 0 },
+};
+const Pattern PATTERN_STARTUP { startup_steps, ARRAY_SIZE(startup_steps), 0 };
+
+static const PatternStep case_open_steps[] {
+    { PATTERN_LED_KEEP, true,  100 },
+    { PATTERN_LED_KEEP, false, 100 },
+    { PATTERN_LED_KEEP, true,  100 },
+    { PATTERN_LED_KEEP, false, 100 },
+    { PATTERN_LED_KEEP, true,  100 },
+    { PATTERN_LED_KEEP, false, 0 },
+};
+const Pattern PATTERN_CASE_OPEN { case_open_steps, ARRAY_SIZE(case_open_steps), 1 };
+
+static const PatternStep emergency_steps[] {
+    { LED_COLOR_RED, true,  200 },
+    { LED_COLOR_RED, false, 200 },
+    { LED_COLOR_RED, true,  200 },
+    { LED_COLOR_RED, false, 200 },
+    { LED_COLOR_RED, true,  200 },
+    { LED_COLOR_RED, false, 200 },
+    { LED_COLOR_RED, true,  200 },
+    { LED_COLOR_RED, false, 200 },
+    { LED_COLOR_RED, true,  200 },
+    { LED_COLOR_RED, false, 0 },
+};
+const Pattern PATTERN_EMERGENCY { emergency_steps, ARRAY_SIZE(emergency_steps), 2 };
+
+void Pattern_Player::play(const Pattern &pattern)
+{
+    requested.store(&pattern);
+}
+
+void Pattern_Player::apply(const PatternStep &s)
+{
+    if (s.color != PATTERN_LED_KEEP) {
+        led_set_color(s.color);
+    }
+    digitalWrite(PIN_BUZZER, s.buzzer ? HIGH : LOW);
+}
+
+void Pattern_Player::update(uint32_t now_ms)
+{
+    const Pattern *req = requested.exchange(nullptr);
+    if (req != nullptr && (current == nullptr || req->priority >= current->priority)) {
+        current = req;
+        step = 0;
+        step_start_ms = now_ms;
+        apply(current->steps[0]);
+    }
+    if (current == nullptr) {
+        return;
+    }
+
+    // catch up on steps we passed, as the tick may be late
+    while (true) {
+        const PatternStep &s = current->steps[step];
+        if (s.duration_ms == 0 || step+1 >= current->count) {
+            // final state reached
+            current = nullptr;
+            return;
+        }
+        if (now_ms - step_start_ms < s.duration_ms) {
+            return;
+        }
+        step_start_ms += s.duration_ms;
+        step++;
+        apply(current->steps[step]);
+    }
+}
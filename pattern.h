@@ -0,0 +1,54 @@
+/*
+  timed buzzer and LED patterns, played without blocking
+ */
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+
+// step colour that leaves the LED as it is
+#define PATTERN_LED_KEEP 0xFFFFFFFFU
+
+struct PatternStep {
+    uint32_t color;        // led_set_color() value or PATTERN_LED_KEEP
+    bool buzzer;
+    uint16_t duration_ms;  // 0 ends the pattern in this state
+};
+
+struct Pattern {
+    const PatternStep *steps;
+    uint8_t count;
+    // a playing pattern is only replaced by one of equal or higher priority
+    uint8_t priority;
+};
+
+class Pattern_Player {
+public:
+    /*
+      start a pattern. Safe to call from any task, the pattern starts
+      on the next update()
+     */
+    void play(const Pattern &pattern);
+
+    // advance the playing pattern, called from the TX task tick
+    void update(uint32_t now_ms);
+
+    bool active(void) const {
+        return current != nullptr || requested.load() != nullptr;
+    }
+
+private:
+    std::atomic<const Pattern *> requested {nullptr};
+    const Pattern *current;
+    uint8_t step;
+    uint32_t step_start_ms;
+
+    void apply(const PatternStep &s);
+};
+
+extern Pattern_Player pattern_player;
+
+// patterns used by the firmware
+extern const Pattern PATTERN_STARTUP;
+extern const Pattern PATTERN_CASE_OPEN;
+extern const Pattern PATTERN_EMERGENCY;
@@ -0,0 +1,122 @@
+/*
+  low power mode
+
+  All periodic work runs in tasks that block until their next deadline
+  (TX slot, sensor sample, MQTT service), so once every task is blocked
+  the FreeRTOS tickless idle hook can put the chip in light sleep until
+  the earliest timeout. esp_pm does the sleeping and frequency scaling,
+  we configure it, set up UART wakeup and count the time slept.
+
+  Light sleep needs CONFIG_PM_ENABLE and CONFIG_FREERTOS_USE_TICKLESS_IDLE
+  in the sdkconfig. While the WiFi access point is up the WiFi driver
+  holds a power lock and the chip only scales its clock.
+ */
+
+#include <Arduino.h>
+#include <esp_pm.h>
+#include <esp_sleep.h>
+#include <driver/gpio.h>
+#include "power.h"
+#include "board_config_maritime.h"
+
+Power_Manager power_manager;
+
+// clock range in low power mode, 80MHz keeps the radios running
+#define POWER_MAX_FREQ_MHZ 240
+#define POWER_MIN_FREQ_MHZ 80
+
+uint32_t Power_Manager::next_wake_ms(const uint32_t *due_ms, uint8_t n, uint32_t max_ms)
+{
+    uint32_t wait_ms = max_ms;
+    for (uint8_t i=0; i<n; i++) {
+        if (due_ms[i] < wait_ms) {
+            wait_ms = due_ms[i];
+        }
+    }
+    return wait_ms;
+}
+
+#if CONFIG_PM_LIGHT_SLEEP_CALLBACKS
+static esp_err_t sleep_exit_cb(int64_t sleep_time_us, void *arg)
+{
+    ((Power_Manager *)arg)->add_sleep_us(uint32_t(sleep_time_us));
+    return ESP_OK;
+}
+#endif
+
+void Power_Manager::add_sleep_us(uint32_t sleep_us)
+{
+    portENTER_CRITICAL(&lock);
+    window_sleep_us += sleep_us;
+    window_sleeps++;
+    portEXIT_CRITICAL(&lock);
+}
+
+bool Power_Manager::configure_pm(bool light_sleep)
+{
+#if CONFIG_PM_ENABLE
+    esp_pm_config_t config {};
+    config.max_freq_mhz = POWER_MAX_FREQ_MHZ;
+    config.min_freq_mhz = light_sleep ? POWER_MIN_FREQ_MHZ : POWER_MAX_FREQ_MHZ;
+    config.light_sleep_enable = light_sleep;
+    const esp_err_t err = esp_pm_configure(&config);
+    if (err != ESP_OK) {
+        Serial.printf("esp_pm_configure failed: %d\n", int(err));
+        return false;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+/*
+  wake from light sleep on the start bit of GNSS or MAVLink data. The
+  RX lines idle high, so a low level means a byte is arriving
+ */
+void Power_Manager::configure_wakeup(void)
+{
+    gpio_wakeup_enable(gpio_num_t(PIN_GNSS_RX), GPIO_INTR_LOW_LEVEL);
+    gpio_wakeup_enable(gpio_num_t(PIN_UART_RX), GPIO_INTR_LOW_LEVEL);
+    esp_sleep_enable_gpio_wakeup();
+
+#if CONFIG_PM_LIGHT_SLEEP_CALLBACKS
+    if (!hooks_registered) {
+        esp_pm_sleep_cbs_register_config_t cbs {};
+        cbs.exit_cb = sleep_exit_cb;
+        cbs.exit_cb_user_arg = this;
+        hooks_registered = esp_pm_light_sleep_register_cbs(&cbs) == ESP_OK;
+    }
+#endif
+}
+
+void Power_Manager::set_low_power(bool enable)
+{
+    if (enable == enabled) {
+        return;
+    }
+    if (enable) {
+        configure_wakeup();
+    }
+    configure_pm(enable);
+    enabled = enable;
+    Serial.printf("Low power mode %s\n", enable ? "on" : "off");
+}
+
+void Power_Manager::update(uint32_t now_ms)
+{
+    const uint32_t elapsed_ms = now_ms - window_start_ms;
+    if (elapsed_ms < 60000) {
+        return;
+    }
+    portENTER_CRITICAL(&lock);
+    const uint32_t slept_ms = uint32_t(window_sleep_us / 1000);
+    sleeps = window_sleeps;
+    window_sleep_us = 0;
+    window_sleeps = 0;
+    portEXIT_CRITICAL(&lock);
+
+    asleep_ms = slept_ms < elapsed_ms ? slept_ms : elapsed_ms;
+    awake_ms = elapsed_ms - asleep_ms;
+    window_start_ms = now_ms;
+}
@@ -0,0 +1,64 @@
+/*
+  low power mode: automatic light sleep between deadlines
+ */
+#pragma once
+
+#include <stdint.h>
+#include <freertos/FreeRTOS.h>
+
+class Power_Manager {
+public:
+    /*
+      enable or disable low power mode. In low power mode esp_pm
+      scales the CPU clock and the idle task enters light sleep
+      whenever every task is blocked until its next deadline. GNSS and
+      MAVLink UART activity wakes the chip
+     */
+    void set_low_power(bool enable);
+    bool low_power(void) const {
+        return enabled;
+    }
+
+    /*
+      how long a task may block before its next deadline. Takes the
+      time until each due event, returns the earliest, limited to
+      max_ms so periodic work keeps running
+     */
+    static uint32_t next_wake_ms(const uint32_t *due_ms, uint8_t n, uint32_t max_ms);
+
+    // account the time spent in light sleep, from the sleep exit hook
+    void add_sleep_us(uint32_t sleep_us);
+
+    // roll the duty cycle window, called from a periodic task
+    void update(uint32_t now_ms);
+
+    // time asleep and number of sleeps over the last full minute
+    uint32_t get_asleep_ms(void) const {
+        return asleep_ms;
+    }
+    uint32_t get_awake_ms(void) const {
+        return awake_ms;
+    }
+    uint32_t get_sleeps(void) const {
+        return sleeps;
+    }
+
+private:
+    bool enabled;
+    bool hooks_registered;
+
+    // the sleep hook runs on whichever core slept
+    portMUX_TYPE lock = portMUX_INITIALIZER_UNLOCKED;
+    uint64_t window_sleep_us;
+    uint32_t window_sleeps;
+    uint32_t window_start_ms;
+
+    uint32_t asleep_ms;
+    uint32_t awake_ms;
+    uint32_t sleeps;
+
+    bool configure_pm(bool light_sleep);
+    void configure_wakeup(void);
+};
+
+extern Power_Manager power_manager;
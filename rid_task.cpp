@@ -0,0 +1,100 @@
+/*
+  FreeRTOS task running one firmware subsystem
+
+  Each task blocks on its notification with the period as timeout, so
+  periodic work and event driven work (a UART receive callback, new
+  data for the transmitters) share the same loop. The time spent in the
+  task function is accumulated to give a CPU share per task without
+  needing FreeRTOS run time stats.
+ */
+
+#include <Arduino.h>
+#include <string.h>
+#include <esp_timer.h>
+#include "rid_task.h"
+
+RID_Task *RID_Task::list_head;
+
+RID_Task::RID_Task(const char *_name, run_fn_t _fn, uint32_t _period_ms,
+                   BaseType_t _core, UBaseType_t _priority, uint32_t _stack_size) :
+    name(_name),
+    fn(_fn),
+    period_ms(_period_ms),
+    core(_core),
+    priority(_priority),
+    stack_size(_stack_size)
+{
+    list_next = list_head;
+    list_head = this;
+}
+
+bool RID_Task::start(void)
+{
+    if (handle != nullptr) {
+        return true;
+    }
+    return xTaskCreatePinnedToCore(trampoline, name, stack_size, this, priority, &handle, core) == pdPASS;
+}
+
+void RID_Task::notify(void)
+{
+    if (handle != nullptr) {
+        xTaskNotifyGive(handle);
+    }
+}
+
+void IRAM_ATTR RID_Task::notify_from_isr(void)
+{
+    if (handle != nullptr) {
+        BaseType_t woken = pdFALSE;
+        vTaskNotifyGiveFromISR(handle, &woken);
+        portYIELD_FROM_ISR(woken);
+    }
+}
+
+uint32_t RID_Task::get_stack_free(void) const
+{
+    if (handle == nullptr) {
+        return 0;
+    }
+    // ESP-IDF reports the high water mark in bytes
+    return uxTaskGetStackHighWaterMark(handle);
+}
+
+RID_Task *RID_Task::find(const char *name)
+{
+    for (RID_Task *t = list_head; t != nullptr; t = t->list_next) {
+        if (strcmp(t->name, name) == 0) {
+            return t;
+        }
+    }
+    return nullptr;
+}
+
+void RID_Task::trampoline(void *arg)
+{
+    ((RID_Task *)arg)->run();
+}
+
+void RID_Task::run(void)
+{
+    window_start_us = esp_timer_get_time();
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(period_ms));
+
+        const uint64_t start_us = esp_timer_get_time();
+        fn();
+        const uint64_t now_us = esp_timer_get_time();
+        busy_us += now_us - start_us;
+        runs++;
+
+        const uint64_t window_us = now_us - window_start_us;
+        if (window_us >= 1000000) {
+            cpu_percent = busy_us * 100.0f / window_us;
+            runs_per_second = runs * 1000000ULL / window_us;
+            busy_us = 0;
+            runs = 0;
+            window_start_us = now_us;
+        }
+    }
+}
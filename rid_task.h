@@ -0,0 +1,75 @@
+/*
+  FreeRTOS task running one firmware subsystem
+ */
+#pragma once
+
+#include <stdint.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+class RID_Task {
+public:
+    typedef void (*run_fn_t)(void);
+
+    /*
+      run fn every period_ms, or earlier when notified. Tasks are
+      pinned to core and linked into a list for the status report
+     */
+    RID_Task(const char *_name, run_fn_t _fn, uint32_t _period_ms,
+             BaseType_t _core, UBaseType_t _priority, uint32_t _stack_size);
+
+    bool start(void);
+
+    // change the period, from the next wait on
+    void set_period_ms(uint32_t _period_ms) {
+        period_ms = _period_ms;
+    }
+
+    // wake the task before its period ends
+    void notify(void);
+    // IRAM, called from interrupt handlers
+    void notify_from_isr(void);
+
+    const char *get_name(void) const {
+        return name;
+    }
+    // share of one core spent in fn over the last full second
+    float get_cpu_percent(void) const {
+        return cpu_percent;
+    }
+    // runs of fn over the last full second
+    uint16_t get_runs_per_second(void) const {
+        return runs_per_second;
+    }
+    // least free stack seen, in bytes
+    uint32_t get_stack_free(void) const;
+
+    static RID_Task *first(void) {
+        return list_head;
+    }
+    RID_Task *next(void) const {
+        return list_next;
+    }
+    static RID_Task *find(const char *name);
+
+private:
+    const char *name;
+    run_fn_t fn;
+    volatile uint32_t period_ms;
+    BaseType_t core;
+    UBaseType_t priority;
+    uint32_t stack_size;
+    TaskHandle_t handle;
+
+    uint64_t busy_us;
+    uint16_t runs;
+    uint64_t window_start_us;
+    float cpu_percent;
+    uint16_t runs_per_second;
+
+    RID_Task *list_next;
+    static RID_Task *list_head;
+
+    static void trampoline(void *arg);
+    void run(void);
+};
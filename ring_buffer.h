@@ -0,0 +1,64 @@
+/*
+  lock-free single producer, single consumer byte ring
+ */
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+
+/*
+  SIZE must be a power of two. head and tail run freely and wrap, the
+  producer only writes head and the consumer only writes tail, so one
+  writer and one reader on different cores need no lock
+ */
+template <uint32_t SIZE>
+class Ring_Buffer {
+    static_assert((SIZE & (SIZE-1)) == 0, "ring size must be a power of two");
+
+public:
+    uint32_t available(void) const {
+        return head.load(std::memory_order_acquire) - tail.load(std::memory_order_relaxed);
+    }
+    uint32_t space(void) const {
+        return SIZE - (head.load(std::memory_order_relaxed) - tail.load(std::memory_order_acquire));
+    }
+    static constexpr uint32_t size(void) {
+        return SIZE;
+    }
+
+    // producer side, returns the number of bytes that fit
+    uint32_t write(const uint8_t *data, uint32_t len) {
+        const uint32_t h = head.load(std::memory_order_relaxed);
+        const uint32_t free = SIZE - (h - tail.load(std::memory_order_acquire));
+        if (len > free) {
+            len = free;
+        }
+        const uint32_t ofs = h & (SIZE-1);
+        const uint32_t first = len < SIZE - ofs ? len : SIZE - ofs;
+        memcpy(&buf[ofs], data, first);
+        memcpy(&buf[0], data + first, len - first);
+        head.store(h + len, std::memory_order_release);
+        return len;
+    }
+
+    // consumer side, returns the number of bytes read
+    uint32_t read(uint8_t *data, uint32_t len) {
+        const uint32_t t = tail.load(std::memory_order_relaxed);
+        const uint32_t used = head.load(std::memory_order_acquire) - t;
+        if (len > used) {
+            len = used;
+        }
+        const uint32_t ofs = t & (SIZE-1);
+        const uint32_t first = len < SIZE - ofs ? len : SIZE - ofs;
+        memcpy(data, &buf[ofs], first);
+        memcpy(data + first, &buf[0], len - first);
+        tail.store(t + len, std::memory_order_release);
+        return len;
+    }
+
+private:
+    uint8_t buf[SIZE];
+    std::atomic<uint32_t> head{0};
+    std::atomic<uint32_t> tail{0};
+};
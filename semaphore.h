@@ -0,0 +1,43 @@
+/*
+  mutex shared between tasks, with a scoped holder
+ */
+#pragma once
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+class Semaphore {
+public:
+    // FreeRTOS mutexes have priority inheritance, so a low priority
+    // holder is boosted while the TX task waits
+    Semaphore() : handle(xSemaphoreCreateMutex()) {}
+
+    void take(void) {
+        xSemaphoreTake(handle, portMAX_DELAY);
+    }
+    void give(void) {
+        xSemaphoreGive(handle);
+    }
+
+private:
+    SemaphoreHandle_t handle;
+};
+
+class WithSemaphore {
+public:
+    WithSemaphore(Semaphore &_sem) : sem(_sem) {
+        sem.take();
+    }
+    ~WithSemaphore() {
+        sem.give();
+    }
+
+private:
+    Semaphore &sem;
+};
+
+#define _WITH_SEM_NAME2(line) _with_sem_ ## line
+#define _WITH_SEM_NAME(line) _WITH_SEM_NAME2(line)
+
+// hold sem until the end of the enclosing scope
+#define WITH_SEMAPHORE(sem) WithSemaphore _WITH_SEM_NAME(__LINE__)(sem)
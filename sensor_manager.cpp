@@ -0,0 +1,279 @@
+/*
+  maritime sensor scheduling
+
+  Each source is read at its own rate: the environment once a second,
+  the magnetometer at 10Hz, the battery ADC at 2Hz. The IMU runs on its
+  FIFO watermark interrupt and the case switch on a pin change
+  interrupt, so neither is polled. The data tick starts the reads that
+  are due and copies finished samples into one table with the time of
+  each, and every consumer (the data tick, monitoring, diagnostics,
+  MQTT) reads the table rather than a sensor.
+
+  Each IMU sample from the FIFO batch also goes through the AHRS, with
+  the latest magnetometer sample, for heading, pitch and roll.
+
+  Once a second the samples and I2C, ADC or filter time of each source
+  are turned into rates for the status page.
+ */
+
+#include "sensor_manager.h"
+#include "board_config_maritime.h"
+#include "bme280.h"
+#include "lsm6ds3.h"
+#include "lis3mdl.h"
+#include "util.h"
+
+Sensor_Manager sensor_manager;
+
+// sample period of each source, 0 for a source driven by an interrupt
+static const uint16_t source_period_ms[] {
+    1000,   // ENVIRONMENT
+    0,      // IMU, FIFO watermark
+    100,    // MAG
+    500,    // BATTERY
+    0,      // CASE, pin change
+    0,      // ATTITUDE, every IMU sample
+};
+static_assert(ARRAY_SIZE(source_period_ms) == uint8_t(Sensor_Manager::Source::COUNT), "source periods");
+
+// a magnetometer sample older than this leaves the heading alone
+#define MAG_TIMEOUT_MS 1000
+
+// reads start on the 10Hz data tick, so a source is due up to half a
+// tick early rather than a whole tick late
+#define DUE_SLACK_MS 50
+
+void IRAM_ATTR Sensor_Manager::case_irq_handler(void *arg)
+{
+    Sensor_Manager *sm = (Sensor_Manager *)arg;
+    sm->case_open = digitalRead(PIN_CASE_DETECT);
+    sm->case_ms = millis();
+    sm->case_edges++;
+}
+
+void Sensor_Manager::init(void)
+{
+    // nominal values for a sensor that hasn't reported
+    table.temperature_c = 25.0f;
+    table.humidity_pct = 65.0f;
+    table.pressure_hpa = 1013.25f;
+    table.accel_z = 9.81f;  // 1g downward
+    table.mag_z = 1.0f;     // North pointing
+
+    pinMode(PIN_CASE_DETECT, INPUT_PULLUP);
+    case_open = digitalRead(PIN_CASE_DETECT);
+    case_ms = millis();
+    attachInterruptArg(PIN_CASE_DETECT, case_irq_handler, this, CHANGE);
+
+    window_start_ms = millis();
+    update(window_start_ms);
+}
+
+bool Sensor_Manager::due(Source src, uint32_t now_ms)
+{
+    Source_State &s = state(src);
+    const uint16_t period_ms = source_period_ms[uint8_t(src)];
+    // every tick until the first sample arrives
+    if (s.samples == 0) {
+        s.last_start_ms = now_ms;
+        return true;
+    }
+    // a start up to the slack early leaves the phase ahead of now
+    const int32_t since_ms = int32_t(now_ms - s.last_start_ms);
+    if (since_ms + DUE_SLACK_MS < period_ms) {
+        return false;
+    }
+    // keep the phase so tick jitter doesn't stretch the period, unless
+    // a whole period was missed
+    s.last_start_ms += period_ms;
+    if (since_ms >= 2*period_ms) {
+        s.last_start_ms = now_ms;
+    }
+    return true;
+}
+
+void Sensor_Manager::update(uint32_t now_ms)
+{
+    // queue the I2C reads that are due, they finish on the bus task
+    // and are collected on a later tick
+    if (due(Source::ENVIRONMENT, now_ms)) {
+        env_sensor.update();
+    }
+    if (due(Source::MAG, now_ms)) {
+        mag_sensor.update();
+    }
+
+    float battery_voltage = 0;
+    uint32_t adc_us = 0;
+    const bool battery_due = due(Source::BATTERY, now_ms);
+    if (battery_due) {
+        const uint32_t start_us = micros();
+        battery_voltage = read_battery_voltage();
+        adc_us = micros() - start_us;
+    }
+
+    BME280::Sample env;
+    const bool have_env = env_sensor.get_sample(env);
+    LSM6DS3::Sample imu;
+    const bool have_imu = imu_sensor.get_sample(imu);
+    LIS3MDL::Sample mag;
+    const bool have_mag = mag_sensor.get_sample(mag);
+
+    const bool heading_valid = have_mag && now_ms - mag.timestamp_ms < MAG_TIMEOUT_MS;
+    const float no_mag[3] {};
+    const uint32_t ahrs_start_us = micros();
+    const uint32_t ahrs_samples = update_attitude(heading_valid ? mag.mag : no_mag);
+    const uint32_t ahrs_us = micros() - ahrs_start_us;
+
+    WITH_SEMAPHORE(sem);
+
+    Source_State &env_state = state(Source::ENVIRONMENT);
+    if (have_env && env.timestamp_ms != env_state.sample_ms) {
+        table.temperature_c = env.temperature_cdeg * 0.01f;
+        table.humidity_pct = env.humidity_q22_10 * (1.0f / 1024);
+        table.pressure_hpa = env.pressure_q24_8 * (1.0f / 25600);
+        env_state.sample_ms = env.timestamp_ms;
+        env_state.samples++;
+    }
+    env_state.bus_us = env_sensor.get_busy_us();
+
+    // the batch mean, counted in FIFO samples
+    Source_State &imu_state = state(Source::IMU);
+    if (have_imu && imu.timestamp_ms != imu_state.sample_ms) {
+        table.accel_x = imu.accel[0];
+        table.accel_y = imu.accel[1];
+        table.accel_z = imu.accel[2];
+        table.gyro_x = imu.gyro[0];
+        table.gyro_y = imu.gyro[1];
+        table.gyro_z = imu.gyro[2];
+        imu_state.sample_ms = imu.timestamp_ms;
+    }
+    imu_state.samples = imu_sensor.get_samples();
+    imu_state.bus_us = imu_sensor.get_busy_us();
+
+    Source_State &mag_state = state(Source::MAG);
+    if (have_mag && mag.timestamp_ms != mag_state.sample_ms) {
+        table.mag_x = mag.mag[0];
+        table.mag_y = mag.mag[1];
+        table.mag_z = mag.mag[2];
+        mag_state.sample_ms = mag.timestamp_ms;
+        mag_state.samples++;
+    }
+    mag_state.bus_us = mag_sensor.get_busy_us();
+
+    if (battery_due) {
+        Source_State &battery_state = state(Source::BATTERY);
+        table.battery_voltage = battery_voltage;
+        battery_state.sample_ms = now_ms;
+        battery_state.samples++;
+        battery_state.bus_us += adc_us;
+    }
+
+    if (ahrs_samples > 0) {
+        Source_State &attitude_state = state(Source::ATTITUDE);
+        ahrs.get_euler_deg(table.heading_deg, table.pitch_deg, table.roll_deg);
+        table.attitude_valid = ahrs.have_attitude();
+        table.heading_valid = heading_valid;
+        attitude_state.sample_ms = now_ms;
+        attitude_state.samples += ahrs_samples;
+        attitude_state.bus_us += ahrs_us;
+    }
+
+    Source_State &case_state = state(Source::CASE);
+    table.case_tamper_detected = case_open;
+    case_state.sample_ms = case_ms;
+    case_state.samples = case_edges;
+
+    table.timestamp_ms = now_ms;
+
+    update_rates(now_ms);
+}
+
+/*
+  run the AHRS over the IMU samples since the last tick, returning how
+  many
+ */
+uint32_t Sensor_Manager::update_attitude(const float mag[3])
+{
+    static constexpr uint32_t SAMPLE_PERIOD_US = 1000000U / LSM6DS3::ODR_HZ;
+    LSM6DS3::Raw_Sample batch[16];
+    uint32_t count = 0;
+    uint16_t n;
+    while ((n = imu_sensor.read_batch(batch, ARRAY_SIZE(batch))) > 0) {
+        for (uint16_t i=0; i<n; i++) {
+            const LSM6DS3::Raw_Sample &s = batch[i];
+            uint32_t dt_us = s.timestamp_us - last_imu_us;
+            // the first sample, or the first after samples were lost
+            if (dt_us == 0 || dt_us > 4 * SAMPLE_PERIOD_US) {
+                dt_us = SAMPLE_PERIOD_US;
+            }
+            last_imu_us = s.timestamp_us;
+            const float gyro[3] { s.gyro[0] * LSM6DS3::GYRO_SCALE, s.gyro[1] * LSM6DS3::GYRO_SCALE, s.gyro[2] * LSM6DS3::GYRO_SCALE };
+            const float accel[3] { s.accel[0] * LSM6DS3::ACCEL_SCALE, s.accel[1] * LSM6DS3::ACCEL_SCALE, s.accel[2] * LSM6DS3::ACCEL_SCALE };
+            ahrs.update(gyro, accel, mag, dt_us * 1.0e-6f);
+        }
+        count += n;
+    }
+    return count;
+}
+
+void Sensor_Manager::update_rates(uint32_t now_ms)
+{
+    const uint32_t dt_ms = now_ms - window_start_ms;
+    if (dt_ms < 1000) {
+        return;
+    }
+    for (Source_State &s : sources) {
+        s.rate_hz = (s.samples - s.window_samples) * 1000.0f / dt_ms;
+        s.rate_bus_us = uint64_t(s.bus_us - s.window_bus_us) * 1000 / dt_ms;
+        s.window_samples = s.samples;
+        s.window_bus_us = s.bus_us;
+    }
+    window_start_ms = now_ms;
+
+    // pick up a case switch edge the interrupt missed
+    case_open = digitalRead(PIN_CASE_DETECT);
+}
+
+void Sensor_Manager::get(MaritimeSensorData &data) const
+{
+    WITH_SEMAPHORE(sem);
+    data = table;
+}
+
+uint32_t Sensor_Manager::get_sample_ms(Source src) const
+{
+    WITH_SEMAPHORE(sem);
+    return sources[uint8_t(src)].sample_ms;
+}
+
+float Sensor_Manager::get_rate_hz(Source src) const
+{
+    return sources[uint8_t(src)].rate_hz;
+}
+
+uint32_t Sensor_Manager::get_bus_us(Source src) const
+{
+    return sources[uint8_t(src)].rate_bus_us;
+}
+
+const char *Sensor_Manager::source_name(Source src)
+{
+    switch (src) {
+    case Source::ENVIRONMENT:
+        return "ENV";
+    case Source::IMU:
+        return "IMU";
+    case Source::MAG:
+        return "MAG";
+    case Source::BATTERY:
+        return "BATT";
+    case Source::CASE:
+        return "CASE";
+    case Source::ATTITUDE:
+        return "AHRS";
+    case Source::COUNT:
+        break;
+    }
+    return "?";
+}
@@ -0,0 +1,87 @@
+/*
+  maritime sensor scheduling and latest sample table
+ */
+#pragma once
+
+#include <Arduino.h>
+#include "semaphore.h"
+#include "maritime_sensors.h"
+#include "ahrs.h"
+
+class Sensor_Manager {
+public:
+    enum class Source : uint8_t {
+        ENVIRONMENT,
+        IMU,
+        MAG,
+        BATTERY,
+        CASE,
+        ATTITUDE,
+        COUNT,
+    };
+
+    // nominal values in the table, case interrupt on, first battery read
+    void init(void);
+
+    /*
+      start the sensor reads that are due and take the results of
+      finished ones into the table, from the data tick
+     */
+    void update(uint32_t now_ms);
+
+    // latest value of every source, without touching a sensor
+    void get(MaritimeSensorData &data) const;
+    // time of the latest sample of a source, 0 if there is none yet
+    uint32_t get_sample_ms(Source src) const;
+
+    // samples per second, and I2C, ADC or filter time per second,
+    // over the last full second
+    float get_rate_hz(Source src) const;
+    uint32_t get_bus_us(Source src) const;
+
+    static const char *source_name(Source src);
+
+private:
+    // AHRS gains, from replayed vessel motion traces
+    static constexpr float AHRS_KP = 1.0f;
+    static constexpr float AHRS_KI = 0.05f;
+
+    struct Source_State {
+        uint32_t last_start_ms;
+        uint32_t sample_ms;
+        // totals since boot, and at the start of the rate window
+        uint32_t samples;
+        uint32_t bus_us;
+        uint32_t window_samples;
+        uint32_t window_bus_us;
+        float rate_hz;
+        uint32_t rate_bus_us;
+    };
+
+    Source_State sources[uint8_t(Source::COUNT)];
+    uint32_t window_start_ms;
+
+    // table, and sources, under sem
+    mutable Semaphore sem;
+    MaritimeSensorData table;
+
+    // run on every IMU sample, by the data tick only
+    AHRS ahrs{AHRS_KP, AHRS_KI};
+    uint32_t last_imu_us;
+
+    // written by the case pin interrupt
+    volatile bool case_open;
+    volatile uint32_t case_ms;
+    volatile uint32_t case_edges;
+
+    Source_State &state(Source src) {
+        return sources[uint8_t(src)];
+    }
+    bool due(Source src, uint32_t now_ms);
+    void update_rates(uint32_t now_ms);
+    uint32_t update_attitude(const float mag[3]);
+
+    static void case_irq_handler(void *arg);
+};
+
+extern Sensor_Manager sensor_manager;
@@ -0,0 +1,91 @@
+/*
+  per-stage execution time histograms
+
+  Each stage fills a fixed bucket histogram for a 10 second window,
+  then the p50, p99 and max of that window are published and the
+  histogram starts over. Recording is a bucket index computation and
+  an increment, the percentiles are only computed at window end.
+ */
+
+#include "stage_timing.h"
+#include <string.h>
+
+Stage_Timer *Stage_Timer::list_head;
+
+Stage_Timer::Stage_Timer(const char *_name) :
+    name(_name)
+{
+    list_next = list_head;
+    list_head = this;
+}
+
+uint8_t Stage_Timer::bucket_index(uint32_t us)
+{
+    if (us < 8) {
+        return us;
+    }
+    const uint8_t msb = 31 - __builtin_clz(us);
+    if (msb > 23) {
+        return NUM_BUCKETS - 1;
+    }
+    const uint8_t sub = (us >> (msb - 2)) & 3;
+    return 8 + (msb - 3)*4 + sub;
+}
+
+uint32_t Stage_Timer::bucket_upper_us(uint8_t idx)
+{
+    if (idx < 8) {
+        return idx;
+    }
+    const uint8_t msb = 3 + (idx - 8) / 4;
+    const uint8_t sub = (idx - 8) % 4;
+    const uint32_t lower = uint32_t(4 + sub) << (msb - 2);
+    return lower + (1U << (msb - 2)) - 1;
+}
+
+void Stage_Timer::record(uint32_t us)
+{
+    const uint64_t now_us = esp_timer_get_time();
+    if (now_us - window_start_us >= WINDOW_US) {
+        end_window(now_us);
+    }
+    uint16_t &b = buckets[bucket_index(us)];
+    if (b < UINT16_MAX) {
+        b++;
+    }
+    window_count++;
+    if (us > window_max_us) {
+        window_max_us = us;
+    }
+}
+
+/*
+  upper edge of the bucket holding the pct percentile, capped at the
+  window max
+ */
+uint32_t Stage_Timer::percentile_us(uint8_t pct) const
+{
+    const uint32_t target = (uint64_t(window_count) * pct + 99) / 100;
+    uint32_t seen = 0;
+    for (uint8_t i=0; i<NUM_BUCKETS; i++) {
+        seen += buckets[i];
+        if (seen >= target) {
+            const uint32_t upper = bucket_upper_us(i);
+            return upper < window_max_us ? upper : window_max_us;
+        }
+    }
+    return window_max_us;
+}
+
+void Stage_Timer::end_window(uint64_t now_us)
+{
+    p50_us = percentile_us(50);
+    p99_us = percentile_us(99);
+    max_us = window_max_us;
+    count = window_count;
+
+    memset(buckets, 0, sizeof(buckets));
+    window_count = 0;
+    window_max_us = 0;
+    window_start_us = now_us;
+}
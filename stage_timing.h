@@ -0,0 +1,94 @@
+/*
+  per-stage execution time histograms
+
+  STAGE_TIME("name") times the rest of the enclosing scope in
+  microseconds. Scopes nest, each stage records its own inclusive
+  time. With AP_STAGE_TIMING_ENABLED set to 0 the macro compiles to
+  nothing.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <esp_timer.h>
+#include "options.h"
+
+class Stage_Timer {
+public:
+    Stage_Timer(const char *_name);
+
+    void record(uint32_t us);
+
+    const char *get_name(void) const {
+        return name;
+    }
+    // results over the last complete window, in microseconds
+    uint32_t get_p50_us(void) const {
+        return p50_us;
+    }
+    uint32_t get_p99_us(void) const {
+        return p99_us;
+    }
+    uint32_t get_max_us(void) const {
+        return max_us;
+    }
+    uint32_t get_count(void) const {
+        return count;
+    }
+
+    static Stage_Timer *first(void) {
+        return list_head;
+    }
+    Stage_Timer *next(void) const {
+        return list_next;
+    }
+
+private:
+    // exact below 8us, then 4 buckets per power of two up to 2^24us
+    static constexpr uint8_t NUM_BUCKETS = 8 + 21*4;
+    static constexpr uint32_t WINDOW_US = 10000000;
+
+    const char *name;
+    uint16_t buckets[NUM_BUCKETS];
+    uint32_t window_count;
+    uint32_t window_max_us;
+    uint64_t window_start_us;
+
+    uint32_t p50_us;
+    uint32_t p99_us;
+    uint32_t max_us;
+    uint32_t count;
+
+    Stage_Timer *list_next;
+    static Stage_Timer *list_head;
+
+    static uint8_t bucket_index(uint32_t us);
+    static uint32_t bucket_upper_us(uint8_t idx);
+    uint32_t percentile_us(uint8_t pct) const;
+    void end_window(uint64_t now_us);
+};
+
+class Stage_Scope {
+public:
+    Stage_Scope(Stage_Timer &_timer) :
+        timer(_timer),
+        start_us(esp_timer_get_time()) {}
+
+    ~Stage_Scope() {
+        timer.record(uint32_t(esp_timer_get_time() - start_us));
+    }
+
+private:
+    Stage_Timer &timer;
+    const uint64_t start_us;
+};
+
+#define _STAGE_NAME2(prefix, line) prefix ## line
+#define _STAGE_NAME(prefix, line) _STAGE_NAME2(prefix, line)
+
+#if AP_STAGE_TIMING_ENABLED
+#define STAGE_TIME(name) \
+    static Stage_Timer _STAGE_NAME(_stage_timer_, __LINE__){name}; \
+    Stage_Scope _STAGE_NAME(_stage_scope_, __LINE__){_STAGE_NAME(_stage_timer_, __LINE__)}
+#else
+#define STAGE_TIME(name)
+#endif
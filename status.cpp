@@ -7,8 +7,20 @@
 #include <opendroneid.h>
 #include "status.h"
 #include "util.h"
+#include "odid_snapshot.h"
+#include "WiFi_TX.h"
+#include "tx_scheduler.h"
+#include "rid_task.h"
+#include "stage_timing.h"
+#include "power.h"
+#include "uart_ingest.h"
+#include "mavlink_tx_queue.h"
+#include "parameters.h"
+#include "maritime_sensors.h"
+#include "sensor_manager.h"
 
 extern ODID_UAS_Data UAS_data;
+extern WiFi_TX wifi;
 extern String status_reason;
 
 typedef struct {
@@ -40,6 +52,22 @@ static String json_format(const json_table_t *table, uint8_t n)
     return s;
 }
 
+/*
+  append one TIMING:<stage> entry per timed stage to a json object
+ */
+static void json_append_timing(String &s)
+{
+#if AP_STAGE_TIMING_ENABLED
+    s.remove(s.length()-1);
+    for (const Stage_Timer *t = Stage_Timer::first(); t != nullptr; t = t->next()) {
+        s += ",\"TIMING:" + String(t->get_name()) + "\" : \"";
+        s += "p50 " + String(t->get_p50_us()) + "us p99 " + String(t->get_p99_us()) +
+             "us max " + String(t->get_max_us()) + "us n " + String(t->get_count()) + "\"";
+    }
+    s += "}";
+#endif
+}
+
 typedef struct {
     int v;
     String s;
@@ -218,6 +246,109 @@ static String AltString(float alt)
     return String(alt,2);
 }
 
+/*
+  achieved rate and worst lateness of a transmit channel
+ */
+static String tx_rate_string(TX_Scheduler::Channel ch)
+{
+    return String(tx_scheduler.get_rate(ch), 2) + "Hz jitter " + String(tx_scheduler.get_jitter_ms(ch)) + "ms";
+}
+
+/*
+  CPU share, run rate and stack headroom of a task
+ */
+static String task_string(const char *name)
+{
+    const RID_Task *t = RID_Task::find(name);
+    if (t == nullptr) {
+        return "";
+    }
+    return String(t->get_cpu_percent(), 1) + "% " + String(t->get_runs_per_second()) + "Hz stack free " + String(t->get_stack_free());
+}
+
+/*
+  bytes received, bytes lost and peak ring use of a UART
+ */
+static String uart_string(const char *name)
+{
+    const UART_Ingest *u = UART_Ingest::find(name);
+    if (u == nullptr) {
+        return "";
+    }
+    return String(u->get_bytes()) + " bytes " + String(u->get_overruns()) + " overruns ring max " + String(u->get_max_used()) + "/" + String(u->get_size());
+}
+
+/*
+  sensor I2C bus load and transaction latency
+ */
+static String i2c_string(void)
+{
+    return String(sensor_bus.get_busy_percent(), 1) + "% busy " + String(sensor_bus.get_transfers_per_second()) + "/s latency " +
+           String(sensor_bus.get_latency_avg_us()) + "us avg " + String(sensor_bus.get_latency_max_us()) + "us max " +
+           String(sensor_bus.get_errors()) + " errors " + String(sensor_bus.get_dropped()) + " dropped";
+}
+
+/*
+  sample rate and I2C or ADC time per second of each sensor source
+ */
+static String sensor_rates_string(void)
+{
+    String s;
+    for (uint8_t i=0; i<uint8_t(Sensor_Manager::Source::COUNT); i++) {
+        const auto src = Sensor_Manager::Source(i);
+        if (i > 0) {
+            s += " ";
+        }
+        s += String(Sensor_Manager::source_name(src)) + " " + String(sensor_manager.get_rate_hz(src), 1) + "Hz " +
+             String(sensor_manager.get_bus_us(src)) + "us/s";
+    }
+    return s;
+}
+
+/*
+  IMU FIFO samples and losses
+ */
+static String imu_fifo_string(void)
+{
+    return String(imu_sensor.get_samples()) + " samples " + String(imu_sensor.get_overruns()) + " overruns " +
+           String(imu_sensor.get_discarded()) + " words discarded " + String(imu_sensor.get_batch_dropped()) + " batch dropped";
+}
+
+/*
+  parameter load time and time from boot to the first RemoteID frame
+ */
+static String boot_string(void)
+{
+    const uint32_t first_tx_ms = tx_scheduler.get_first_tx_ms();
+    return "params " + String(Parameters::get_load_us()) + "us from " +
+           (Parameters::get_loaded_snapshot() ? "snapshot" : "keys") +
+           ", first TX " + (first_tx_ms ? String(first_tx_ms) + "ms" : String("none"));
+}
+
+/*
+  frames sent and dropped per priority of a MAVLink TX queue
+ */
+static String tx_queue_string(uint8_t chan)
+{
+    const MAVLink_TX_Queue *q = MAVLink_TX_Queue::for_channel(chan);
+    if (q == nullptr) {
+        return "";
+    }
+    using P = MAVLink_TX_Queue::Priority;
+    String s;
+    const struct {
+        const char *name;
+        P p;
+    } prios[] = { { "status", P::STATUS }, { "param", P::PARAM }, { "text", P::TEXT } };
+    for (const auto &pr : prios) {
+        if (s.length() > 0) {
+            s += " ";
+        }
+        s += String(pr.name) + " " + String(q->get_sent(pr.p)) + " sent " + String(q->get_dropped(pr.p)) + " dropped";
+    }
+    return s;
+}
+
 #define ENUM_MAP(ename, v) enum_string(enum_ ## ename, ARRAY_SIZE(enum_ ## ename), int(v))
 
 String status_json(void)
@@ -239,6 +370,30 @@ String status_json(void)
         { "STATUS:BOARD_ID", String(BOARD_ID)},
         { "STATUS:UPTIME", String(hr) + ":" + String(minsec_str) },
         { "STATUS:FREEMEM", String(ESP.getFreeHeap()) },
+        { "STATUS:ODID_ENCODES_PER_SEC", String(odid_snapshot.get_encodes_per_second()) },
+        { "STATUS:ODID_BYTES_PER_TICK", String(odid_snapshot.get_bytes_last_tick()) },
+        { "STATUS:WIFI_IE_UPDATES", String(wifi.get_ie_updates()) },
+        { "STATUS:WIFI_IE_SKIPPED", String(wifi.get_ie_skipped()) },
+        { "TX:NAN_RATE", tx_rate_string(TX_Scheduler::Channel::WIFI_NAN) },
+        { "TX:BEACON_RATE", tx_rate_string(TX_Scheduler::Channel::WIFI_BEACON) },
+        { "TX:BT4_RATE", tx_rate_string(TX_Scheduler::Channel::BT4) },
+        { "TX:BT5_RATE", tx_rate_string(TX_Scheduler::Channel::BT5) },
+        { "POWER:LOW_POWER", String(power_manager.low_power() ? "on" : "off") },
+        { "POWER:DUTY_CYCLE", String(power_manager.get_awake_ms()) + "ms awake " + String(power_manager.get_asleep_ms()) + "ms asleep " + String(power_manager.get_sleeps()) + " sleeps" },
+        { "TASK:TX", task_string("tx") },
+        { "TASK:INGEST", task_string("ingest") },
+        { "TASK:DATA", task_string("data") },
+        { "TASK:SERVICES", task_string("services") },
+        { "TASK:I2C", task_string("i2c") },
+        { "UART:GNSS", uart_string("gnss") },
+        { "UART:MAVLINK", uart_string("mavlink") },
+        { "I2C:SENSORS", i2c_string() },
+        { "IMU:FIFO", imu_fifo_string() },
+        { "SENSORS:RATES", sensor_rates_string() },
+        { "STATUS:BOOT", boot_string() },
+        { "PARAM:STORAGE", String(Parameters::get_sets()) + " sets " + String(Parameters::get_flash_writes()) + " writes " + String(Parameters::get_commits()) + " commits" },
+        { "MAVLINK:TX_QUEUE", tx_queue_string(0) },
+        { "MAVLINK:TX_QUEUE_USB", tx_queue_string(1) },
         { "BASICID:UAType", ENUM_MAP(uatype, UAS_data.BasicID[0].UAType) },
         { "BASICID:IDType", ENUM_MAP(idtype, UAS_data.BasicID[0].IDType) },
         { "BASICID:UASID", String(UAS_data.BasicID[0].UASID) },
@@ -279,5 +434,7 @@ String status_json(void)
         { "LOCATION:TSAccuracy", ENUM_MAP(tsacc, UAS_data.Location.TSAccuracy) },
         { "LOCATION:TimeStamp", String(UAS_data.Location.TimeStamp) },
     };
-    return json_format(table, ARRAY_SIZE(table));
+    String s = json_format(table, ARRAY_SIZE(table));
+    json_append_timing(s);
+    return s;
 }
@@ -0,0 +1,85 @@
+/*
+  AHRS cost per 9 axis IMU sample over the rough sea trace, the share
+  of a core the 208Hz LSM6DS3 FIFO rate takes, and the heading and
+  pitch/roll error of each vessel trace against its truth after the
+  first minute
+
+  bench_ahrs [passes]
+ */
+
+#include "test.h"
+#include "ahrs.h"
+#include "imu_traces.h"
+
+#define KP 1.0f
+#define KI 0.05f
+#define TRACE_SECONDS 600
+
+static double wrap_180(double d)
+{
+    while (d > 180) {
+        d -= 360;
+    }
+    while (d < -180) {
+        d += 360;
+    }
+    return d;
+}
+
+int main(int argc, char **argv)
+{
+    const uint32_t passes = bench_iterations(argc, argv, 20);
+    const struct {
+        const char *name;
+        const IMU_Trace_Config &config;
+    } vessels[] {
+        { "moored", imu_moored },
+        { "underway turning", imu_underway_turning },
+        { "rough", imu_rough },
+    };
+    bool good = true;
+    std::vector<IMU_Sample> trace;
+    for (const auto &v : vessels) {
+        trace = imu_trace(v.config, TRACE_SECONDS);
+        AHRS ahrs(KP, KI);
+        double heading_sq = 0, attitude_sq = 0, heading_max = 0, attitude_max = 0;
+        uint32_t n = 0;
+        for (const IMU_Sample &s : trace) {
+            ahrs.update(s.gyro, s.accel, s.mag, 1.0f / IMU_TRACE_RATE_HZ);
+            if (s.t <= 60) {
+                continue;
+            }
+            float h, p, r;
+            ahrs.get_euler_deg(h, p, r);
+            const double eh = wrap_180(h - s.heading), ep = p - s.pitch, er = r - s.roll;
+            heading_sq += eh*eh;
+            attitude_sq += ep*ep + er*er;
+            heading_max = fmax(heading_max, fabs(eh));
+            attitude_max = fmax(attitude_max, fmax(fabs(ep), fabs(er)));
+            n++;
+        }
+        const double heading_rms = sqrt(heading_sq / n), attitude_rms = sqrt(attitude_sq / (2*n));
+        printf("%-40s heading RMS %.2f max %.2f, pitch/roll RMS %.2f max %.2f deg\n", v.name,
+               heading_rms, heading_max, attitude_rms, attitude_max);
+        good &= heading_rms < 1 && attitude_rms < 1;
+    }
+
+    // the rough trace is the last one made
+    AHRS ahrs(KP, KI);
+    const double pass_ns = bench_ns("rough trace per pass", passes, [&](uint32_t) {
+        ahrs.reset();
+        for (const IMU_Sample &s : trace) {
+            ahrs.update(s.gyro, s.accel, s.mag, 1.0f / IMU_TRACE_RATE_HZ);
+        }
+        bench_keep(ahrs.get_quaternion()[0]);
+    });
+    const double sample_ns = pass_ns / trace.size();
+    printf("%-40s %10.1f ns\n", "9 axis update", sample_ns);
+    printf("%-40s %10.4f %% of a core\n", "208Hz", sample_ns * IMU_TRACE_RATE_HZ / 1e7);
+
+    if (!good) {
+        printf("attitude error over 1 degree RMS\n");
+        return 1;
+    }
+    return 0;
+}
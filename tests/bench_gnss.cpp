@@ -0,0 +1,62 @@
+/*
+  CPU per GNSS fix: a NAV-PVT frame through UBX_Parser against the
+  GGA/RMC/GSA/VTG/GST epoch through NMEA_Parser, over the same run of
+  10Hz epochs
+
+  bench_gnss [fixes]
+ */
+
+#include "test.h"
+#include "nmea.h"
+#include "ubx.h"
+#include "gnss_streams.h"
+
+// distinct epochs the run cycles through
+#define EPOCHS 1000
+
+static NMEA_Parser nmea;
+static UBX_Parser ubx;
+
+int main(int argc, char **argv)
+{
+    const uint32_t n = bench_iterations(argc, argv, 20000);
+    std::vector<std::string> nmea_epochs;
+    std::vector<std::vector<uint8_t>> ubx_epochs;
+    size_t nmea_bytes = 0, ubx_bytes = 0;
+    for (uint32_t i=0; i<EPOCHS; i++) {
+        // the GSV set is configured off in both modes
+        nmea_epochs.push_back(nmea_epoch(i*10 + 1));
+        ubx_epochs.push_back(nav_pvt(i*10 + 1));
+        nmea_bytes += nmea_epochs.back().size();
+        ubx_bytes += ubx_epochs.back().size();
+    }
+
+    uint32_t nmea_fixes = 0;
+    const double nmea_ns = bench_ns("NMEA epoch per fix", n, [&](uint32_t i) {
+        for (const char c : nmea_epochs[i % EPOCHS]) {
+            nmea.feed(c);
+        }
+        nmea_fixes += (nmea.get_updated() & NMEA_Parser::GST) != 0;
+    });
+    uint32_t ubx_fixes = 0;
+    const double ubx_ns = bench_ns("UBX NAV-PVT per fix", n, [&](uint32_t i) {
+        for (const uint8_t b : ubx_epochs[i % EPOCHS]) {
+            ubx_fixes += ubx.feed(b);
+        }
+    });
+    printf("%-40s %10.1f B/fix\n", "NMEA", double(nmea_bytes) / EPOCHS);
+    printf("%-40s %10.1f B/fix\n", "UBX", double(ubx_bytes) / EPOCHS);
+    printf("%-40s %10.2fx CPU, %.2fx bytes\n", "NMEA / UBX", nmea_ns / ubx_ns, double(nmea_bytes) / ubx_bytes);
+
+    if (nmea_fixes != n || ubx_fixes != n || nmea.get_checksum_errors() != 0 || ubx.get_checksum_errors() != 0) {
+        printf("NMEA %u and UBX %u fixes of %u\n", unsigned(nmea_fixes), unsigned(ubx_fixes), unsigned(n));
+        return 1;
+    }
+    // both parsers end on the same position
+    const double dlat = nmea.get_fix().latitude - ubx.get_fix().latitude;
+    if (dlat > 1e-7 || dlat < -1e-7) {
+        printf("NMEA %.7f and UBX %.7f latitude\n", nmea.get_fix().latitude, ubx.get_fix().latitude);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,60 @@
+/*
+  MAVLink 2 pack and parse throughput: OPEN_DRONE_ID_LOCATION frames
+  packed into a send buffer, then fed through the byte parser and the
+  bulk scanner
+
+  bench_mavlink [iterations]
+ */
+
+#include "test.h"
+#include "mavlink_msgs.h"
+#include "mavlink_scanner.h"
+
+static MAVLink_Scanner scanner;
+
+int main(int argc, char **argv)
+{
+    const uint32_t n = bench_iterations(argc, argv, 20000);
+    const uint8_t id_or_mac[20] {1, 2, 3};
+    mavlink_message_t msg, rx;
+    mavlink_status_t status;
+    uint8_t buf[MAVLINK_MAX_PACKET_LEN];
+
+    bench_ns("pack + to_send_buffer", n, [&](uint32_t i) {
+        mavlink_msg_open_drone_id_location_pack(3, 4, &msg, 0, 0, id_or_mac, 2, i % 36000, 150, -20,
+                                                515000000 + i, -1000000, 10.5, 20.25, 1, 3.5, 10, 4, 3, 2, 1234.5, 0);
+        bench_keep(mavlink_msg_to_send_buffer(buf, &msg));
+    });
+
+    const uint16_t len = mavlink_msg_to_send_buffer(buf, &msg);
+    uint32_t frames = 0;
+    const double parse_ns = bench_ns("mavlink_parse_char per frame", n, [&](uint32_t) {
+        for (uint16_t j=0; j<len; j++) {
+            frames += mavlink_parse_char(MAVLINK_COMM_1, buf[j], &rx, &status);
+        }
+    });
+    printf("%-40s %10.1f MB/s\n", "mavlink_parse_char", len / parse_ns * 1e3);
+    if (frames != n) {
+        printf("parsed %u of %u frames\n", unsigned(frames), unsigned(n));
+        return 1;
+    }
+
+    // as many whole frames as fit the scanner buffer per fill
+    const uint16_t per_fill = scanner.write_space() / len;
+    frames = 0;
+    const double scan_ns = bench_ns("scanner per buffer fill", n / per_fill, [&](uint32_t) {
+        for (uint16_t j=0; j<per_fill; j++) {
+            memcpy(scanner.write_ptr(), buf, len);
+            scanner.written(len);
+        }
+        while (scanner.next(rx)) {
+            frames++;
+        }
+    }) / per_fill;
+    printf("%-40s %10.1f ns/frame, %.1f MB/s\n", "scanner", scan_ns, len / scan_ns * 1e3);
+    if (frames != (n / per_fill) * per_fill) {
+        printf("scanned %u frames\n", unsigned(frames));
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,65 @@
+/*
+  NMEA parser throughput over a multi-MB log: bytes and sentences a
+  second, and the share of a core a 10Hz u-blox at 115200 baud takes.
+  Without a log an 8MB one of 10Hz epochs is generated
+
+  bench_nmea [passes] [log file]
+ */
+
+#include "test.h"
+#include "nmea.h"
+#include "gnss_streams.h"
+#include <fstream>
+#include <sstream>
+
+#define LOG_SIZE (8U<<20)
+
+static NMEA_Parser parser;
+
+int main(int argc, char **argv)
+{
+    const uint32_t passes = bench_iterations(argc, argv, 1);
+    std::string log;
+    uint32_t expected = 0;
+    if (argc > 2) {
+        std::ifstream f(argv[2], std::ios::binary);
+        if (!f) {
+            printf("can't read %s\n", argv[2]);
+            return 1;
+        }
+        std::stringstream ss;
+        ss << f.rdbuf();
+        log = ss.str();
+    } else {
+        for (uint32_t n=0; log.size() < LOG_SIZE; n++) {
+            log += nmea_epoch(n);
+            expected += NMEA_EPOCH_SENTENCES;
+        }
+    }
+
+    uint32_t sentences = 0;
+    const double pass_ns = bench_ns("NMEA_Parser::feed per pass", passes, [&](uint32_t) {
+        for (const char c : log) {
+            sentences += parser.feed(c);
+        }
+    });
+    const double bytes_per_s = log.size() / pass_ns * 1e9;
+    printf("%-40s %10.1f MB/s\n", "bytes", bytes_per_s / 1e6);
+    printf("%-40s %10.2f M/s (%u per pass)\n", "sentences", sentences / passes / pass_ns * 1e3,
+           unsigned(sentences / passes));
+
+    // 10Hz epochs, one with the GSV set, against the UART
+    std::string second;
+    for (uint32_t n=0; n<10; n++) {
+        second += nmea_epoch(n);
+    }
+    printf("%-40s %10zu B/s of 11520 B/s at 115200 baud\n", "10Hz u-blox", second.size());
+    printf("%-40s %10.3f %% of a core\n", "10Hz u-blox parse", second.size() / bytes_per_s * 100);
+
+    if (parser.get_checksum_errors() != 0 || (expected != 0 && sentences != expected * passes)) {
+        printf("parsed %u sentences, %u checksum errors\n", unsigned(sentences),
+               unsigned(parser.get_checksum_errors()));
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,85 @@
+/*
+  ODID snapshot encoding per 10Hz tick of a mission in steady state:
+  every message re-encoded each tick, as before the dirty bits, against
+  only the changed Location. Reports the time, the encodes a second
+  and the bytes touched per tick of each, and checks both build the
+  same pack
+
+  bench_opendroneid [ticks]
+ */
+
+#include "test.h"
+#include "odid_snapshot.h"
+
+static ODID_UAS_Data uas;
+
+// all six messages of a maritime survey
+static void fill_uas(void)
+{
+    odid_initUasData(&uas);
+    uas.BasicID[0].UAType = ODID_UATYPE_OTHER;
+    uas.BasicID[0].IDType = ODID_IDTYPE_SERIAL_NUMBER;
+    strcpy(uas.BasicID[0].UASID, "ONRID-240AC4000001");
+    uas.BasicID[1] = uas.BasicID[0];
+    uas.BasicID[1].IDType = ODID_IDTYPE_CAA_REGISTRATION_ID;
+    strcpy(uas.BasicID[1].UASID, "FIN87astrdge12k8");
+    uas.BasicIDValid[0] = 1;
+    uas.BasicIDValid[1] = 1;
+    uas.Location.Status = ODID_STATUS_AIRBORNE;
+    uas.Location.Latitude = 51.4545;
+    uas.Location.Longitude = -2.5879;
+    uas.Location.SpeedHorizontal = 2.8;
+    uas.LocationValid = 1;
+    strcpy(uas.SelfID.Desc, "Maritime survey");
+    uas.SelfIDValid = 1;
+    uas.System.OperatorLatitude = 51.4545;
+    uas.System.OperatorLongitude = -2.5879;
+    uas.System.AreaCount = 1;
+    uas.SystemValid = 1;
+    strcpy(uas.OperatorID.OperatorId, "FIN87astrdge12k8");
+    uas.OperatorIDValid = 1;
+}
+
+// one tick: the boat moves on and Location is marked dirty
+static void tick(ODID_Snapshot &snapshot, uint32_t i, uint8_t dirty)
+{
+    uas.Location.TimeStamp = (i % 36000) * 0.1f;
+    uas.Location.Latitude = 51.4545 + (i % 1000) * 2.5e-6;
+    snapshot.mark_dirty(dirty);
+    snapshot.update(uas);
+    host_advance_us(100000);
+}
+
+int main(int argc, char **argv)
+{
+    const uint32_t n = bench_iterations(argc, argv, 100000);
+    static ODID_Snapshot all, changed;
+    fill_uas();
+    tick(all, 0, ODID_Snapshot::ALL_SLOTS);
+    tick(changed, 0, ODID_Snapshot::ALL_SLOTS);
+
+    const uint8_t location = ODID_Snapshot::slot_bit(ODID_Snapshot::Slot::LOCATION);
+    const double all_ns = bench_ns("every message each tick", n, [&](uint32_t i) {
+        tick(all, i, ODID_Snapshot::ALL_SLOTS);
+    });
+    printf("%-40s %10u encodes/s, %u bytes/tick\n", "", unsigned(all.get_encodes_per_second()),
+           unsigned(all.get_bytes_last_tick()));
+    const double changed_ns = bench_ns("changed messages only", n, [&](uint32_t i) {
+        tick(changed, i, location);
+    });
+    printf("%-40s %10u encodes/s, %u bytes/tick\n", "", unsigned(changed.get_encodes_per_second()),
+           unsigned(changed.get_bytes_last_tick()));
+    printf("%-40s %10.2fx\n", "speedup", all_ns / changed_ns);
+
+    // both end on the same tick with the same pack
+    if (all.get_pack_length() != changed.get_pack_length() ||
+        memcmp(all.get_pack(), changed.get_pack(), all.get_pack_length()) != 0) {
+        printf("packs differ\n");
+        return 1;
+    }
+    if (changed.get_encodes_per_second() != 10 || all.get_encodes_per_second() != 60) {
+        printf("encodes per second\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,166 @@
+/*
+  parameter lookup through the perfect hash against the linear scans
+  it replaced: find by name, the float index and count, and a full
+  PARAM_REQUEST_LIST walk. Both give the same results for every
+  parameter, checked before timing
+
+  bench_parameters [iterations]
+ */
+
+#include "test.h"
+#include "parameters.h"
+
+typedef Parameters::Param Param;
+typedef Parameters::ParamType ParamType;
+
+// the linear scans of the table, as parameters.cpp had them
+static bool float_capable(const Param &p)
+{
+    if (p.flags & PARAM_FLAG_HIDDEN) {
+        return false;
+    }
+    switch (p.ptype) {
+    case ParamType::UINT8:
+    case ParamType::INT8:
+    case ParamType::UINT32:
+    case ParamType::FLOAT:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static const Param *linear_find(const char *name)
+{
+    for (const Param *p = &Parameters::params[0]; ; p++) {
+        if (strcmp(name, p->name) == 0) {
+            return p;
+        }
+        if (p->ptype == ParamType::NONE) {
+            return nullptr;
+        }
+    }
+}
+
+static uint16_t linear_count_float(void)
+{
+    uint16_t count = 0;
+    for (const Param *p = &Parameters::params[0]; p->ptype != ParamType::NONE; p++) {
+        count += float_capable(*p);
+    }
+    // remove 1 for DONE_INIT
+    return count-1;
+}
+
+static int16_t linear_index_float(const Param *f)
+{
+    int16_t count = 0;
+    for (const Param *p = &Parameters::params[0]; p->ptype != ParamType::NONE; p++) {
+        if (!float_capable(*p)) {
+            continue;
+        }
+        if (p == f) {
+            return count;
+        }
+        count++;
+    }
+    return -1;
+}
+
+static const Param *linear_by_index_float(uint16_t index)
+{
+    uint16_t count = 0;
+    for (const Param *p = &Parameters::params[0]; p->ptype != ParamType::NONE; p++) {
+        if (!float_capable(*p)) {
+            continue;
+        }
+        if (count++ == index) {
+            return p;
+        }
+    }
+    return nullptr;
+}
+
+static bool check_equal(uint16_t n)
+{
+    for (uint16_t i=0; i<n; i++) {
+        const Param *p = &Parameters::params[i];
+        if (Parameters::find(p->name) != p) {
+            printf("find %s\n", p->name);
+            return false;
+        }
+        if (Parameters::param_index_float(p) != linear_index_float(p)) {
+            printf("float index of %s\n", p->name);
+            return false;
+        }
+    }
+    for (uint16_t i=0; i<n+2; i++) {
+        if (Parameters::find_by_index_float(i) != linear_by_index_float(i)) {
+            printf("param at float index %u\n", unsigned(i));
+            return false;
+        }
+    }
+    // the empty name finds the end of the table in both
+    const char *unknown[] { "", "NOPE", "LOCK_LEVE", "LOCK_LEVELX", "uas_id", "BT4_RATE " };
+    for (const char *name : unknown) {
+        if (Parameters::find(name) != linear_find(name)) {
+            printf("found '%s'\n", name);
+            return false;
+        }
+    }
+    if (Parameters::param_count_float() != linear_count_float()) {
+        printf("float count\n");
+        return false;
+    }
+    return true;
+}
+
+/*
+  PARAM_REQUEST_LIST as mavlink.cpp streams it: every float capable
+  parameter with the count and its index
+ */
+template <typename Count, typename Index>
+static uint32_t param_list(Count count, Index index)
+{
+    uint32_t sum = 0;
+    for (const Param *p = &Parameters::params[0]; p->ptype != ParamType::NONE; p++) {
+        float v;
+        if (p->get_as_float(v)) {
+            sum += count() + index(p);
+        }
+    }
+    return sum;
+}
+
+int main(int argc, char **argv)
+{
+    const uint32_t iterations = bench_iterations(argc, argv, 20000);
+    uint16_t n = 0;
+    while (Parameters::params[n].ptype != ParamType::NONE) {
+        n++;
+    }
+    if (!check_equal(n)) {
+        return 1;
+    }
+
+    bench_ns("linear find by name", iterations, [&](uint32_t i) {
+        bench_keep(linear_find(Parameters::params[i % n].name));
+    });
+    bench_ns("hash find by name", iterations, [&](uint32_t i) {
+        bench_keep(Parameters::find(Parameters::params[i % n].name));
+    });
+    bench_ns("linear index + count", iterations, [&](uint32_t i) {
+        bench_keep(linear_index_float(&Parameters::params[i % n]) + linear_count_float());
+    });
+    bench_ns("table index + count", iterations, [&](uint32_t i) {
+        bench_keep(Parameters::param_index_float(&Parameters::params[i % n]) + Parameters::param_count_float());
+    });
+    bench_ns("linear full param list", iterations / n + 1, [&](uint32_t) {
+        bench_keep(param_list(linear_count_float, linear_index_float));
+    });
+    bench_ns("table full param list", iterations / n + 1, [&](uint32_t) {
+        bench_keep(param_list(Parameters::param_count_float, Parameters::param_index_float));
+    });
+    printf("%-40s %10u\n", "parameters", unsigned(n));
+    return 0;
+}
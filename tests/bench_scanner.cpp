@@ -0,0 +1,80 @@
+/*
+  MAVLink receive throughput on a 16MB stream of the messages an
+  autopilot sends a RemoteID module: MAVLink_Scanner on 128 byte UART
+  reads against mavlink_parse_char, and the share of a core a 921600
+  baud link takes
+
+  bench_scanner [passes]
+ */
+
+#include "test.h"
+#include "mavlink_scanner.h"
+#include "mavlink_frames.h"
+
+#define STREAM_SIZE (16U<<20)
+#define READ_SIZE 128
+
+static MAVLink_Scanner scanner;
+
+int main(int argc, char **argv)
+{
+    const uint32_t passes = bench_iterations(argc, argv, 1);
+    static const struct {
+        uint32_t msgid;
+        uint8_t len;
+    } mix[] {
+        { MAVLINK_MSG_ID_HEARTBEAT, 9 },
+        { MAVLINK_MSG_ID_OPEN_DRONE_ID_LOCATION, 59 },
+        { MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM, 54 },
+        { MAVLINK_MSG_ID_OPEN_DRONE_ID_BASIC_ID, 44 },
+        { MAVLINK_MSG_ID_OPEN_DRONE_ID_SELF_ID, 46 },
+        { MAVLINK_MSG_ID_OPEN_DRONE_ID_OPERATOR_ID, 43 },
+        { MAVLINK_MSG_ID_PARAM_VALUE, 25 },
+    };
+    std::vector<uint8_t> stream;
+    uint32_t messages = 0;
+    for (uint8_t seq=0; stream.size() < STREAM_SIZE; ) {
+        for (const auto &m : mix) {
+            const std::vector<uint8_t> f = mavlink2_frame(m.msgid, m.len, seq++);
+            stream.insert(stream.end(), f.begin(), f.end());
+            messages++;
+        }
+    }
+
+    mavlink_message_t rx;
+    uint32_t frames = 0;
+    const double scan_ns = bench_ns("scanner per pass", passes, [&](uint32_t) {
+        for (size_t i=0; i<stream.size(); ) {
+            const size_t n = std::min<size_t>(std::min<size_t>(READ_SIZE, scanner.write_space()), stream.size() - i);
+            memcpy(scanner.write_ptr(), &stream[i], n);
+            scanner.written(n);
+            i += n;
+            while (scanner.next(rx)) {
+                frames++;
+            }
+        }
+    });
+    const double bytes_per_s = stream.size() / scan_ns * 1e9;
+    printf("%-40s %10.1f MB/s\n", "scanner", bytes_per_s / 1e6);
+    printf("%-40s %10.2f M/s, %.0f ns/message\n", "scanner messages", messages / scan_ns * 1e3, scan_ns / messages);
+
+    mavlink_status_t status;
+    uint32_t parsed = 0;
+    const double parse_ns = bench_ns("mavlink_parse_char per pass", passes, [&](uint32_t) {
+        for (const uint8_t b : stream) {
+            parsed += mavlink_parse_char(MAVLINK_COMM_1, b, &rx, &status);
+        }
+    });
+    printf("%-40s %10.1f MB/s, scanner %.1fx\n", "mavlink_parse_char", stream.size() / parse_ns * 1e3,
+           parse_ns / scan_ns);
+
+    // 10 bits per byte on the UART
+    printf("%-40s %10.3f %% of a core\n", "921600 baud scanned", 92160 / bytes_per_s * 100);
+
+    if (frames != messages * passes || parsed != messages * passes) {
+        printf("scanned %u, parsed %u of %u messages\n", unsigned(frames), unsigned(parsed),
+               unsigned(messages * passes));
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,111 @@
+/*
+  WiFi frames per second: the NAN action frame built whole into a
+  cleared buffer for every transmit, as before the templates, against
+  the counter and pack patched into the template, and the beacon frame
+  built to take its vendor element against filling the element alone.
+  The frames are checked equal before timing
+
+  bench_wifi_tx [frames]
+ */
+
+#include "test.h"
+#include "opendroneid_wifi.h"
+
+#define FRAME_BUFFER_SIZE 1024
+
+static char mac[6] { 0x02, 0x11, 0x22, 0x33, 0x44, 0x55 };
+static uint8_t pack[sizeof(ODID_MessagePack_encoded)];
+static int pack_len;
+
+static void fill_pack(void)
+{
+    static ODID_UAS_Data uas;
+    odid_initUasData(&uas);
+    uas.BasicID[0].UAType = ODID_UATYPE_OTHER;
+    uas.BasicID[0].IDType = ODID_IDTYPE_SERIAL_NUMBER;
+    strcpy(uas.BasicID[0].UASID, "ONRID-240AC4000001");
+    uas.BasicIDValid[0] = 1;
+    uas.Location.Status = ODID_STATUS_AIRBORNE;
+    uas.Location.Latitude = 51.4545;
+    uas.Location.Longitude = -2.5879;
+    uas.LocationValid = 1;
+    strcpy(uas.SelfID.Desc, "Maritime survey");
+    uas.SelfIDValid = 1;
+    uas.System.OperatorLatitude = 51.4545;
+    uas.System.OperatorLongitude = -2.5879;
+    uas.System.AreaCount = 1;
+    uas.SystemValid = 1;
+    strcpy(uas.OperatorID.OperatorId, "FIN87astrdge12k8");
+    uas.OperatorIDValid = 1;
+    pack_len = odid_message_build_pack(&uas, pack, sizeof(pack));
+}
+
+static int build_nan(uint8_t *buf, uint8_t counter)
+{
+    memset(buf, 0, FRAME_BUFFER_SIZE);
+    return odid_wifi_build_message_pack_nan_action_frame_from_pack(pack, pack_len, mac, counter,
+                                                                   buf, FRAME_BUFFER_SIZE);
+}
+
+// the beacon frame built to copy the vendor element out of it
+static int build_beacon_ie(uint8_t *buf, uint8_t *ie, uint8_t counter)
+{
+    memset(buf, 0, FRAME_BUFFER_SIZE);
+    const int len = odid_wifi_build_message_pack_beacon_frame_from_pack(pack, pack_len, mac, "RID", 3, 100,
+                                                                        counter, buf, FRAME_BUFFER_SIZE);
+    const int ie_ofs = len - (7 + pack_len);
+    memcpy(ie, &buf[ie_ofs], len - ie_ofs);
+    return len - ie_ofs;
+}
+
+static int fill_beacon_ie(uint8_t *ie, uint8_t counter)
+{
+    ie[6] = counter;
+    memcpy(&ie[7], pack, pack_len);
+    ie[1] = 5 + pack_len;
+    return 7 + pack_len;
+}
+
+int main(int argc, char **argv)
+{
+    const uint32_t n = bench_iterations(argc, argv, 1000000);
+    fill_pack();
+
+    static uint8_t built[FRAME_BUFFER_SIZE];
+    static uint8_t frame[ODID_WIFI_NAN_ACTION_FRAME_SIZE];
+    const int ofs = odid_wifi_build_nan_action_frame_template(mac, frame, sizeof(frame));
+    uint8_t built_ie[2 + 255], ie[2 + 255] { 0xDD, 0, 0xFA, 0x0B, 0xBC, 0x0D };
+    for (uint16_t counter=0; counter<256; counter++) {
+        const int len = build_nan(built, counter);
+        if (len <= 0 || odid_wifi_patch_nan_action_frame(frame, sizeof(frame), ofs, pack, pack_len, counter) != len ||
+            memcmp(built, frame, len) != 0) {
+            printf("NAN action frames differ at counter %u\n", unsigned(counter));
+            return 1;
+        }
+        const int ie_len = build_beacon_ie(built, built_ie, counter);
+        if (fill_beacon_ie(ie, counter) != ie_len || memcmp(built_ie, ie, ie_len) != 0) {
+            printf("beacon elements differ at counter %u\n", unsigned(counter));
+            return 1;
+        }
+    }
+
+    const double built_ns = bench_ns("NAN action frame built", n, [&](uint32_t i) {
+        bench_keep(build_nan(built, i));
+    });
+    const double patched_ns = bench_ns("NAN action frame patched", n, [&](uint32_t i) {
+        bench_keep(odid_wifi_patch_nan_action_frame(frame, sizeof(frame), ofs, pack, pack_len, i));
+    });
+    printf("%-40s %10.0f frames/s built, %.0f patched, %.1fx\n", "NAN action", 1e9 / built_ns,
+           1e9 / patched_ns, built_ns / patched_ns);
+
+    const double beacon_ns = bench_ns("beacon IE from a built frame", n, [&](uint32_t i) {
+        bench_keep(build_beacon_ie(built, built_ie, i));
+    });
+    const double ie_ns = bench_ns("beacon IE filled", n, [&](uint32_t i) {
+        bench_keep(fill_beacon_ie(ie, i));
+    });
+    printf("%-40s %10.0f updates/s built, %.0f filled, %.1fx\n", "beacon IE", 1e9 / beacon_ns,
+           1e9 / ie_ns, beacon_ns / ie_ns);
+    printf("%-40s %10d bytes\n", "message pack", pack_len);
+    return 0;
+}
@@ -0,0 +1,63 @@
+/*
+  BLE_Backend recording what BLE_TX hands the GAP, per advertising set
+ */
+#pragma once
+
+#include "BLE_Backend.h"
+#include <string.h>
+#include <vector>
+
+class Fake_BLE_Backend : public BLE_Backend {
+public:
+    struct Set_State {
+        SetConfig config;
+        bool configured;
+        bool started;
+        uint32_t data_sets;
+        std::vector<uint8_t> data;
+    };
+
+    uint8_t mac[6];
+    bool initialised;
+    // with fail_data set, set_data() is refused as a full GAP queue would
+    bool fail_data;
+
+    bool init(const uint8_t _mac[6]) override {
+        memcpy(mac, _mac, sizeof(mac));
+        initialised = true;
+        return true;
+    }
+
+    bool configure(Set set, const SetConfig &config) override {
+        Set_State &s = state(set);
+        s.config = config;
+        s.configured = true;
+        return true;
+    }
+
+    bool set_data(Set set, const uint8_t *data, uint8_t len) override {
+        if (fail_data) {
+            return false;
+        }
+        Set_State &s = state(set);
+        s.data.assign(data, data + len);
+        s.data_sets++;
+        return true;
+    }
+
+    bool start(Set set) override {
+        Set_State &s = state(set);
+        if (!s.configured || s.data.empty()) {
+            return false;
+        }
+        s.started = true;
+        return true;
+    }
+
+    Set_State &state(Set set) {
+        return sets[uint8_t(set)];
+    }
+
+private:
+    Set_State sets[uint8_t(Set::COUNT)];
+};
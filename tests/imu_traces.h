@@ -0,0 +1,148 @@
+/*
+  208Hz IMU samples of a vessel for the AHRS test and benchmark: a
+  heading that turns, roll and pitch in a swell, heave and surge, with
+  the LSM6DS3 and LIS3MDL resolution, noise and a gyro bias. Each
+  sample carries the attitude it was made from
+ */
+#pragma once
+
+#include <stdint.h>
+#include <math.h>
+#include <random>
+#include <vector>
+
+#define IMU_TRACE_RATE_HZ 208
+#define DEG_TO_RAD_D (M_PI/180)
+
+struct IMU_Sample {
+    double t;
+    float gyro[3];
+    float accel[3];
+    float mag[3];
+    // truth in degrees: clockwise from north, bow up, starboard down
+    double heading;
+    double pitch;
+    double roll;
+};
+
+struct IMU_Trace_Config {
+    uint32_t seed;
+    double turn_dps;
+    double roll_amp_deg;
+    double gyro_bias;
+    // a 40 degree heading swing, and a second swell
+    bool rough;
+};
+
+typedef double IMU_M3[3][3];
+
+static inline void imu_mul(const IMU_M3 a, const IMU_M3 b, IMU_M3 r)
+{
+    for (uint8_t i=0; i<3; i++) {
+        for (uint8_t j=0; j<3; j++) {
+            r[i][j] = 0;
+            for (uint8_t k=0; k<3; k++) {
+                r[i][j] += a[i][k] * b[k][j];
+            }
+        }
+    }
+}
+
+/*
+  board (x bow, y port, z up) to earth (north, west, up) for a heading,
+  pitch and roll in radians
+ */
+static inline void imu_rotation(double heading, double pitch, double roll, IMU_M3 R)
+{
+    const IMU_M3 z { { cos(-heading), -sin(-heading), 0 }, { sin(-heading), cos(-heading), 0 }, { 0, 0, 1 } };
+    const IMU_M3 y { { cos(-pitch), 0, sin(-pitch) }, { 0, 1, 0 }, { -sin(-pitch), 0, cos(-pitch) } };
+    const IMU_M3 x { { 1, 0, 0 }, { 0, cos(roll), -sin(roll) }, { 0, sin(roll), cos(roll) } };
+    IMU_M3 zy;
+    imu_mul(z, y, zy);
+    imu_mul(zy, x, R);
+}
+
+// accel and mag a board at rest in this attitude reads, for the given field
+static inline void imu_static(double heading_deg, double pitch_deg, double roll_deg,
+                              const double field[3], float accel[3], float mag[3])
+{
+    IMU_M3 R;
+    imu_rotation(heading_deg * DEG_TO_RAD_D, pitch_deg * DEG_TO_RAD_D, roll_deg * DEG_TO_RAD_D, R);
+    for (uint8_t i=0; i<3; i++) {
+        accel[i] = R[2][i] * 9.8;
+        mag[i] = R[0][i]*field[0] + R[1][i]*field[1] + R[2][i]*field[2];
+    }
+}
+
+static inline std::vector<IMU_Sample> imu_trace(const IMU_Trace_Config &c, double seconds)
+{
+    std::mt19937 rng(c.seed);
+    std::normal_distribution<double> noise(0, 1);
+    const double dt = 1.0 / IMU_TRACE_RATE_HZ, g0 = 9.80665, D = DEG_TO_RAD_D;
+    // 0.48 gauss at 65 degrees inclination, north and down
+    const double field[3] { 0.48*cos(65*D), 0, -0.48*sin(65*D) };
+    const double heading0 = 37*D;
+    auto attitude = [&](double t, double &h, double &p, double &r) {
+        h = heading0 + c.turn_dps*D*t + (c.rough ? 40*D*sin(2*M_PI*t/60) : 0);
+        p = 4*D*sin(2*M_PI*0.2*t + 1) + (c.rough ? 3*D*sin(2*M_PI*0.45*t) : 0);
+        r = c.roll_amp_deg*D*sin(2*M_PI*0.12*t) + (c.rough ? 5*D*sin(2*M_PI*0.31*t + 2) : 0);
+    };
+
+    std::vector<IMU_Sample> trace;
+    // the LIS3MDL runs at a tenth of the rate, its sample is held
+    float mag_hold[3] {};
+    for (uint32_t i=0; i < seconds/dt; i++) {
+        const double t = i*dt;
+        double h, p, r;
+        attitude(t, h, p, r);
+        IMU_M3 R, R_next, R_prev;
+        imu_rotation(h, p, r, R);
+
+        // body rate from R^T dR/dt
+        attitude(t + 1e-4, h, p, r);
+        imu_rotation(h, p, r, R_next);
+        attitude(t - 1e-4, h, p, r);
+        imu_rotation(h, p, r, R_prev);
+        IMU_M3 Rt, dR, W;
+        for (uint8_t a=0; a<3; a++) {
+            for (uint8_t b=0; b<3; b++) {
+                dR[a][b] = (R_next[a][b] - R_prev[a][b]) / 2e-4;
+                Rt[a][b] = R[b][a];
+            }
+        }
+        imu_mul(Rt, dR, W);
+        const double w[3] { W[2][1], W[0][2], W[1][0] };
+
+        // 1g up, surge and sway, heave
+        const double force[3] { 0.3*sin(2*M_PI*0.15*t), 0.2*cos(2*M_PI*0.1*t), g0 + 1.5*sin(2*M_PI*0.13*t) };
+
+        IMU_Sample s;
+        s.t = t;
+        attitude(t, h, p, r);
+        s.heading = fmod(h/D + 3600, 360);
+        s.pitch = p/D;
+        s.roll = r/D;
+        for (uint8_t a=0; a<3; a++) {
+            double fb = 0, mb = 0;
+            for (uint8_t b=0; b<3; b++) {
+                fb += R[b][a] * force[b];
+                mb += R[b][a] * field[b];
+            }
+            // 17.5mdps, 0.122mg and 1/6842 gauss a count
+            const double bias = c.gyro_bias * (a == 2 ? 1 : -0.5);
+            s.gyro[a] = round((w[a] + bias + 0.004*noise(rng)) / (17.5e-3*D)) * 17.5e-3*D;
+            s.accel[a] = round((fb + 0.03*noise(rng)) / (0.122e-3*g0)) * 0.122e-3*g0;
+            if (i % 21 == 0) {
+                mag_hold[a] = round((mb + 0.002*noise(rng)) * 6842) / 6842;
+            }
+            s.mag[a] = mag_hold[a];
+        }
+        trace.push_back(s);
+    }
+    return trace;
+}
+
+// the vessels of the test and benchmark
+static const IMU_Trace_Config imu_moored { 1, 0.0, 6, 0.01, false };
+static const IMU_Trace_Config imu_underway_turning { 2, 3.0, 12, 0.02, false };
+static const IMU_Trace_Config imu_rough { 3, 1.0, 20, 0.03, true };
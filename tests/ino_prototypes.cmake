@@ -0,0 +1,31 @@
+# turn the sketch into a C++ file the way the Arduino builder does: a
+# prototype for each function goes before the first function definition
+#
+# cmake -DINO=<sketch> -DOUT=<cpp> -P ino_prototypes.cmake
+
+file(READ ${INO} sketch)
+
+set(def_regex "\n([A-Za-z_][A-Za-z0-9_ :*&<>]*[ *&][A-Za-z_][A-Za-z0-9_]*\\([^;{}]*\\))[ \t]*{")
+string(REGEX MATCHALL "${def_regex}" defs "${sketch}")
+
+set(prototypes "")
+foreach(def ${defs})
+    string(REGEX REPLACE "${def_regex}" "\\1" signature "${def}")
+    if(NOT signature MATCHES "^(else|return|case|do) ")
+        string(APPEND prototypes "${signature};\n")
+    endif()
+endforeach()
+
+list(GET defs 0 first_def)
+string(FIND "${sketch}" "${first_def}" first_pos)
+math(EXPR first_pos "${first_pos} + 1")
+string(SUBSTRING "${sketch}" 0 ${first_pos} head)
+string(SUBSTRING "${sketch}" ${first_pos} -1 tail)
+string(REGEX MATCHALL "\n" head_lines "${head}")
+list(LENGTH head_lines first_line)
+math(EXPR first_line "${first_line} + 1")
+
+file(WRITE ${OUT}.tmp
+    "#include <Arduino.h>\n#line 1 \"${INO}\"\n${head}${prototypes}#line ${first_line} \"${INO}\"\n${tail}")
+execute_process(COMMAND ${CMAKE_COMMAND} -E copy_if_different ${OUT}.tmp ${OUT})
+file(REMOVE ${OUT}.tmp)
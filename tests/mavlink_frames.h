@@ -0,0 +1,47 @@
+/*
+  raw MAVLink frames for the scanner test and benchmark, built from the
+  wire format with the CRC extra of the message table
+ */
+#pragma once
+
+#include "mavlink_msgs.h"
+#include <vector>
+
+/*
+  MAVLink 2 frame of msgid with a len byte payload of a counting
+  pattern. Shorter than the message, it is a truncated payload. A
+  signed frame carries a dummy signature
+ */
+static inline std::vector<uint8_t> mavlink2_frame(uint32_t msgid, uint8_t len, uint8_t seq, bool sign=false)
+{
+    const mavlink_msg_entry_t *e = mavlink_get_msg_entry(msgid);
+    std::vector<uint8_t> f { MAVLINK_STX, len, uint8_t(sign ? MAVLINK_IFLAG_SIGNED : 0), 0, seq, 1, 1,
+                             uint8_t(msgid), uint8_t(msgid >> 8), uint8_t(msgid >> 16) };
+    for (uint8_t i=0; i<len; i++) {
+        f.push_back(uint8_t(i*7 + 1));
+    }
+    uint16_t crc = crc_calculate(&f[1], f.size() - 1);
+    crc_accumulate(e != nullptr ? e->crc_extra : 0, &crc);
+    f.push_back(crc & 0xFF);
+    f.push_back(crc >> 8);
+    if (sign) {
+        for (uint8_t i=0; i<MAVLINK_SIGNATURE_BLOCK_LEN; i++) {
+            f.push_back(i);
+        }
+    }
+    return f;
+}
+
+// MAVLink 1 frame, for msgids below 256
+static inline std::vector<uint8_t> mavlink1_frame(uint8_t msgid, uint8_t len, uint8_t seq)
+{
+    std::vector<uint8_t> f { MAVLINK_STX_MAVLINK1, len, seq, 1, 1, msgid };
+    for (uint8_t i=0; i<len; i++) {
+        f.push_back(uint8_t(i + 3));
+    }
+    uint16_t crc = crc_calculate(&f[1], f.size() - 1);
+    crc_accumulate(mavlink_get_msg_entry(msgid)->crc_extra, &crc);
+    f.push_back(crc & 0xFF);
+    f.push_back(crc >> 8);
+    return f;
+}
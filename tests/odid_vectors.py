@@ -0,0 +1,133 @@
+#!/usr/bin/env python3
+'''
+golden OpenDroneID messages for test_opendroneid.cpp
+
+A standalone Python transcription of the encode functions of the
+opendroneid-core-c reference library (protocol version 2), so the
+vectors don't come from the encoder under test. Run it and paste the
+output into test_opendroneid.cpp when a case is added.
+'''
+
+import math
+import struct
+
+PROTOCOL_VERSION = 2
+LATLON_MULT = 10000000
+SPEED_DIV = (0.25, 0.75)
+
+
+def clamp(v, lo, hi):
+    return max(lo, min(hi, v))
+
+
+def header(msg_type):
+    return (msg_type << 4) | PROTOCOL_VERSION
+
+
+def c_round(v):
+    # roundf(), halves away from zero
+    return int(math.floor(abs(v) + 0.5)) * (1 if v >= 0 else -1)
+
+
+def enc_direction(d):
+    d = c_round(d)
+    if d < 180:
+        return 0, clamp(d, 0, 255)
+    return 1, clamp(d - 180, 0, 255)
+
+
+def enc_speed_h(s):
+    if s <= 255 * SPEED_DIV[0]:
+        return 0, int(s / SPEED_DIV[0])
+    return 1, clamp(int((s - 255 * SPEED_DIV[0]) / SPEED_DIV[1]), 0, 255)
+
+
+def enc_speed_v(s):
+    return clamp(int(s / 0.5), -128, 127)
+
+
+def enc_latlon(v):
+    return clamp(int(v * LATLON_MULT), -180 * LATLON_MULT, 180 * LATLON_MULT)
+
+
+def enc_alt(a):
+    return clamp(int((a + 1000) / 0.5), 0, 65535)
+
+
+def enc_timestamp(t):
+    if t == 0xFFFF:
+        return 0xFFFF
+    return clamp(c_round(t * 10), 0, 36000)
+
+
+def fixed(s, n):
+    b = s.encode()[:n]
+    return b + bytes(n - len(b))
+
+
+def basic_id(id_type, ua_type, uas_id):
+    return bytes([header(0), (id_type << 4) | ua_type]) + fixed(uas_id, 20) + bytes(3)
+
+
+def location(status, direction, speed_h, speed_v, lat, lon, alt_baro, alt_geo,
+             height_type, height, horiz_acc, vert_acc, baro_acc, speed_acc,
+             timestamp, ts_acc):
+    ew, dir_enc = enc_direction(direction)
+    mult, speed_enc = enc_speed_h(speed_h)
+    flags = (status << 4) | (height_type << 2) | (ew << 1) | mult
+    return struct.pack('<BBBBbiiHHHBBHBB',
+                       header(1), flags, dir_enc, speed_enc, enc_speed_v(speed_v),
+                       enc_latlon(lat), enc_latlon(lon),
+                       enc_alt(alt_baro), enc_alt(alt_geo), enc_alt(height),
+                       (vert_acc << 4) | horiz_acc, (baro_acc << 4) | speed_acc,
+                       enc_timestamp(timestamp), ts_acc, 0)
+
+
+def self_id(desc_type, desc):
+    return bytes([header(3), desc_type]) + fixed(desc, 23)
+
+
+def system(op_loc_type, class_type, op_lat, op_lon, area_count, area_radius,
+           area_ceiling, area_floor, category_eu, class_eu, op_alt_geo, timestamp):
+    return struct.pack('<BBiiHBHHBHIB',
+                       header(4), (class_type << 2) | op_loc_type,
+                       enc_latlon(op_lat), enc_latlon(op_lon), area_count,
+                       clamp(area_radius // 10, 0, 255),
+                       enc_alt(area_ceiling), enc_alt(area_floor),
+                       (category_eu << 4) | class_eu, enc_alt(op_alt_geo),
+                       timestamp, 0)
+
+
+def operator_id(op_id_type, op_id):
+    return bytes([header(5), op_id_type]) + fixed(op_id, 20) + bytes(3)
+
+
+def pack(*msgs):
+    return bytes([header(0xF), 25, len(msgs)]) + b''.join(msgs)
+
+
+def c_array(name, data):
+    lines = []
+    for i in range(0, len(data), 12):
+        lines.append('    ' + ', '.join('0x%02X' % b for b in data[i:i+12]) + ',')
+    return 'static const uint8_t %s[] {\n%s\n};' % (name, '\n'.join(lines))
+
+
+# the same cases as test_opendroneid.cpp fills in
+BASIC_ID = basic_id(1, 2, 'ONRID-240AC4000001')
+LOCATION = location(2, 215.4, 12.3, -1.7, 59.9138688, 10.7522454, 12.5, 15.0,
+                    0, 3.5, 11, 5, 4, 3, 1234.5, 3)
+LOCATION_FAST = location(2, 90, 100, 62, -33.8567844, 151.2152967, 31767.5, -1000,
+                         1, -1000, 0, 0, 0, 0, 0xFFFF, 0)
+SELF_ID = self_id(0, 'Maritime survey')
+SYSTEM = system(0, 1, 59.9127, 10.7461, 1, 100, 50, 0, 1, 2, 5.0, 123456789)
+OPERATOR_ID = operator_id(0, 'FIN87astrdge12k8')
+
+if __name__ == '__main__':
+    print(c_array('golden_basic_id', BASIC_ID))
+    print(c_array('golden_location', LOCATION))
+    print(c_array('golden_location_fast', LOCATION_FAST))
+    print(c_array('golden_self_id', SELF_ID))
+    print(c_array('golden_system', SYSTEM))
+    print(c_array('golden_operator_id', OPERATOR_ID))
+    print(c_array('golden_pack', pack(BASIC_ID, LOCATION, SYSTEM)))
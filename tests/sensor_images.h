@@ -0,0 +1,190 @@
+/*
+  register images of the maritime sensors for the fake Wire bus, and a
+  model of the LSM6DS3 FIFO
+ */
+#pragma once
+
+#include <Wire.h>
+#include <deque>
+
+#define BME280_ADDR   0x76
+#define LSM6DS3_ADDR  0x6A
+#define LIS3MDL_ADDR  0x1C
+
+static inline void put_le16(uint8_t *r, int v)
+{
+    r[0] = v & 0xFF;
+    r[1] = (v >> 8) & 0xFF;
+}
+
+/*
+  BME280 with the trimming of the Bosch datasheet example, so adc_T
+  519888 reads 25.08 degC and adc_P 415148 reads 100653 Pa
+ */
+struct BME280_Trim {
+    int T1=27504, T2=26435, T3=-1000;
+    int P1=36477, P2=-10685, P3=3024, P4=2855, P5=140, P6=-7, P7=15500, P8=-14600, P9=6000;
+    int H1=75, H2=362, H3=0, H4=313, H5=50, H6=30;
+};
+
+static inline void bme280_image(Fake_Chip &c, const BME280_Trim &t=BME280_Trim())
+{
+    memset(c.regs, 0, sizeof(c.regs));
+    c.regs[0xD0] = 0x60;
+    const int tp[12] { t.T1, t.T2, t.T3, t.P1, t.P2, t.P3, t.P4, t.P5, t.P6, t.P7, t.P8, t.P9 };
+    for (int i=0; i<12; i++) {
+        put_le16(&c.regs[0x88 + 2*i], tp[i]);
+    }
+    c.regs[0xA1] = t.H1;
+    put_le16(&c.regs[0xE1], t.H2);
+    c.regs[0xE3] = t.H3;
+    // H4 and H5 are 12 bit, sharing the nibbles of 0xE5
+    c.regs[0xE4] = t.H4 >> 4;
+    c.regs[0xE5] = (t.H4 & 0x0F) | ((t.H5 & 0x0F) << 4);
+    c.regs[0xE6] = t.H5 >> 4;
+    c.regs[0xE7] = uint8_t(int8_t(t.H6));
+}
+
+// the 8 data registers from 0xF7 for raw ADC values
+static inline void bme280_raw(uint8_t *r, int32_t adc_P, int32_t adc_T, int32_t adc_H)
+{
+    r[0] = adc_P >> 12;
+    r[1] = adc_P >> 4;
+    r[2] = (adc_P & 0x0F) << 4;
+    r[3] = adc_T >> 12;
+    r[4] = adc_T >> 4;
+    r[5] = (adc_T & 0x0F) << 4;
+    r[6] = adc_H >> 8;
+    r[7] = adc_H;
+}
+
+// output registers hold gyro then accel, in LSB
+static inline void lsm6ds3_image(Fake_Chip &c, const int16_t gyro[3], const int16_t accel[3], uint8_t who_am_i=0x69)
+{
+    memset(c.regs, 0, sizeof(c.regs));
+    c.regs[0x0F] = who_am_i;
+    // CTRL3_C resets with auto-increment on
+    c.regs[0x12] = 0x04;
+    for (int i=0; i<3; i++) {
+        put_le16(&c.regs[0x22 + 2*i], gyro[i]);
+        put_le16(&c.regs[0x28 + 2*i], accel[i]);
+    }
+}
+
+// register address bit 7 selects auto-increment on the LIS3MDL
+static inline void lis3mdl_image(Fake_Chip &c, const int16_t mag[3])
+{
+    memset(c.regs, 0, sizeof(c.regs));
+    c.autoinc_msb = true;
+    c.regs[0x0F] = 0x3D;
+    for (int i=0; i<3; i++) {
+        put_le16(&c.regs[0x28 + 2*i], mag[i]);
+    }
+}
+
+/*
+  the LSM6DS3 FIFO: from start_us a sample of gyro xyz then accel xyz
+  every period, numbered k so a reader can check order and alignment.
+  Holds 4096 words, dropping the oldest on overrun. INT1 follows the
+  watermark and is driven on int1_pin, so the driver's interrupt
+  handler runs on the rising edge. Call fill() as time moves on
+ */
+class LSM6DS3_FIFO_Model {
+public:
+    static constexpr uint32_t PERIOD_US = 1000000 / 208;
+    static constexpr uint16_t WORDS = 4096;
+
+    uint64_t start_us;
+    int int1_pin = -1;
+    uint16_t watermark_words = 48;
+
+    void attach(Fake_Chip &chip) {
+        chip.read_hook = [this](uint8_t reg, size_t n, std::vector<uint8_t> &out) {
+            return read(reg, n, out);
+        };
+    }
+
+    void reset(uint64_t _start_us) {
+        fifo.clear();
+        front_word = 0;
+        next_k = 0;
+        overrun = false;
+        start_us = _start_us;
+        fill();
+    }
+
+    // the words sample k is made of
+    static void sample_words(uint32_t k, int16_t w[6]) {
+        const int16_t v = int16_t(k);
+        w[0] = v;
+        w[1] = int16_t(-v);
+        w[2] = int16_t(2*v);
+        w[3] = int16_t(1000 + v);
+        w[4] = int16_t(2000 + v);
+        w[5] = int16_t(3000 + v);
+    }
+
+    // time sample k was taken
+    uint64_t sample_us(uint32_t k) const {
+        return start_us + uint64_t(k) * PERIOD_US;
+    }
+
+    void fill(void) {
+        while (sample_us(next_k) <= host_time_us()) {
+            int16_t w[6];
+            sample_words(next_k, w);
+            for (auto v : w) {
+                fifo.push_back(v);
+                if (fifo.size() > WORDS) {
+                    fifo.pop_front();
+                    front_word++;
+                    overrun = true;
+                }
+            }
+            next_k++;
+        }
+        if (int1_pin >= 0) {
+            host_set_pin(int1_pin, fifo.size() >= watermark_words);
+        }
+    }
+
+    size_t words(void) const {
+        return fifo.size();
+    }
+
+private:
+    std::deque<int16_t> fifo;
+    uint64_t front_word;
+    uint32_t next_k;
+    bool overrun;
+
+    bool read(uint8_t reg, size_t n, std::vector<uint8_t> &out) {
+        fill();
+        if (reg == 0x3A) {
+            // FIFO_STATUS1..4: level, flags, pattern of the next word
+            const uint16_t level = fifo.size() == WORDS ? 0 : fifo.size();
+            const uint16_t pattern = front_word % 6;
+            out = { uint8_t(level),
+                    uint8_t(((level >> 8) & 0x0F) | (overrun ? 0x40 : 0) |
+                            (fifo.empty() ? 0x10 : 0) | (fifo.size() >= watermark_words ? 0x80 : 0)),
+                    uint8_t(pattern), uint8_t(pattern >> 8) };
+            overrun = false;
+            return true;
+        }
+        if (reg == 0x3E) {
+            for (size_t i=0; i<n/2; i++) {
+                int16_t v = 0;
+                if (!fifo.empty()) {
+                    v = fifo.front();
+                    fifo.pop_front();
+                    front_word++;
+                }
+                out.push_back(v & 0xFF);
+                out.push_back(v >> 8);
+            }
+            fill();
+            return true;
+        }
+        return false;
+    }
+};
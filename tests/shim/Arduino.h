@@ -0,0 +1,297 @@
+/*
+  host build of the Arduino core: the parts of the ESP32 Arduino API the
+  firmware uses, on a simulated clock and simulated pins
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <math.h>
+#include <functional>
+#include <string>
+
+#include "freertos/FreeRTOS.h"
+
+typedef uint8_t byte;
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_FAIL -1
+
+#define IRAM_ATTR
+
+class String {
+public:
+    String(const char *s="") : s(s != nullptr ? s : "") {}
+    String(const std::string &_s) : s(_s) {}
+    String(char c) : s(1, c) {}
+    String(int v) : s(std::to_string(v)) {}
+    String(unsigned v) : s(std::to_string(v)) {}
+    String(long v) : s(std::to_string(v)) {}
+    String(unsigned long v) : s(std::to_string(v)) {}
+    String(long long v) : s(std::to_string(v)) {}
+    String(unsigned long long v) : s(std::to_string(v)) {}
+    String(float v, int decimals=2) : String(double(v), decimals) {}
+    String(double v, int decimals=2) {
+        char buf[64];
+        snprintf(buf, sizeof(buf), "%.*f", decimals, v);
+        s = buf;
+    }
+
+    const char *c_str() const { return s.c_str(); }
+    unsigned length() const { return s.length(); }
+    bool isEmpty() const { return s.empty(); }
+    char operator[](unsigned i) const { return i < s.length() ? s[i] : 0; }
+
+    String operator+(const String &o) const { return String(s + o.s); }
+    String &operator+=(const String &o) { s += o.s; return *this; }
+    String &operator+=(const char *o) { s += o; return *this; }
+    String &operator+=(char c) { s += c; return *this; }
+    bool operator==(const String &o) const { return s == o.s; }
+    bool operator==(const char *o) const { return s == o; }
+    bool operator!=(const String &o) const { return s != o.s; }
+    bool operator!=(const char *o) const { return s != o; }
+
+    bool startsWith(const String &p) const { return s.compare(0, p.s.length(), p.s) == 0; }
+    bool endsWith(const String &p) const {
+        return s.length() >= p.s.length() && s.compare(s.length() - p.s.length(), p.s.length(), p.s) == 0;
+    }
+    int indexOf(char c) const { const auto i = s.find(c); return i == std::string::npos ? -1 : int(i); }
+    int lastIndexOf(char c) const { const auto i = s.rfind(c); return i == std::string::npos ? -1 : int(i); }
+    String substring(unsigned from) const { return from < s.length() ? String(s.substr(from)) : String(); }
+    String substring(unsigned from, unsigned to) const {
+        return from < to && from < s.length() ? String(s.substr(from, to - from)) : String();
+    }
+    void remove(unsigned from) { if (from < s.length()) s.erase(from); }
+    void remove(unsigned from, unsigned n) { if (from < s.length()) s.erase(from, n); }
+    void replace(const String &from, const String &to) {
+        if (from.s.empty()) {
+            return;
+        }
+        for (size_t i = s.find(from.s); i != std::string::npos; i = s.find(from.s, i + to.s.length())) {
+            s.replace(i, from.s.length(), to.s);
+        }
+    }
+    long toInt() const { return strtol(s.c_str(), nullptr, 10); }
+    float toFloat() const { return strtof(s.c_str(), nullptr); }
+
+private:
+    std::string s;
+};
+
+inline String operator+(const char *a, const String &b)
+{
+    return String(a) + b;
+}
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t) = 0;
+    virtual size_t write(const uint8_t *b, size_t n) {
+        for (size_t i=0; i<n; i++) {
+            write(b[i]);
+        }
+        return n;
+    }
+    size_t write(const char *s) { return write((const uint8_t *)s, strlen(s)); }
+    size_t print(const String &s) { return write(s.c_str()); }
+    size_t print(const char *s) { return write(s); }
+    size_t print(char c) { return write(uint8_t(c)); }
+    size_t print(int v) { return print(String(v)); }
+    size_t print(unsigned v) { return print(String(v)); }
+    size_t print(long v) { return print(String(v)); }
+    size_t print(unsigned long v) { return print(String(v)); }
+    size_t print(double v, int decimals=2) { return print(String(v, decimals)); }
+    template <typename T> size_t println(const T &v) { return print(v) + println(); }
+    size_t println(const char *s) { return print(s) + println(); }
+    size_t println(double v, int decimals) { return print(v, decimals) + println(); }
+    size_t println(void) { return write("\r\n"); }
+    size_t printf(const char *fmt, ...) __attribute__((format(printf, 2, 3))) {
+        char buf[512];
+        va_list ap;
+        va_start(ap, fmt);
+        vsnprintf(buf, sizeof(buf), fmt, ap);
+        va_end(ap);
+        return write(buf);
+    }
+    virtual int availableForWrite() { return 0; }
+    virtual void flush() {}
+};
+
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+    virtual size_t readBytes(char *b, size_t n) {
+        size_t i = 0;
+        for (; i<n; i++) {
+            const int c = read();
+            if (c < 0) {
+                break;
+            }
+            b[i] = c;
+        }
+        return i;
+    }
+    size_t readBytes(uint8_t *b, size_t n) { return readBytes((char *)b, n); }
+    void setTimeout(unsigned long) {}
+};
+
+#define SERIAL_8N1 0x800001c
+typedef enum {
+    UART_NO_ERROR,
+    UART_BREAK_ERROR,
+    UART_BUFFER_FULL_ERROR,
+    UART_FIFO_OVF_ERROR,
+    UART_FRAME_ERROR,
+    UART_PARITY_ERROR
+} hardwareSerial_error_t;
+
+/*
+  a UART: bytes written by the firmware collect in tx, tests queue
+  received bytes in rx and call the receive callback with receive()
+ */
+class HardwareSerial : public Stream {
+public:
+    HardwareSerial(int _num=0) : num(_num) {}
+    void begin(unsigned long baud, uint32_t=SERIAL_8N1, int8_t=-1, int8_t=-1) { baudrate = baud; }
+    void end(void) {}
+    void updateBaudRate(unsigned long baud) { baudrate = baud; }
+    unsigned long baudRate(void) const { return baudrate; }
+    size_t write(uint8_t b) override { return write(&b, 1); }
+    size_t write(const uint8_t *b, size_t n) override {
+        tx.append((const char *)b, n);
+        trim_tx();
+        if (tx_room >= 0) {
+            tx_room -= n;
+        }
+        return n;
+    }
+    using Print::write;
+    int available() override { return rx.length() - rx_pos; }
+    int read() override { return rx_pos < rx.length() ? uint8_t(rx[rx_pos++]) : -1; }
+    size_t read(uint8_t *b, size_t n) {
+        size_t i = 0;
+        for (; i<n && rx_pos<rx.length(); i++) {
+            b[i] = rx[rx_pos++];
+        }
+        return i;
+    }
+    int peek() override { return rx_pos < rx.length() ? uint8_t(rx[rx_pos]) : -1; }
+    int availableForWrite() override { return tx_room >= 0 ? tx_room : 128; }
+    size_t setRxBufferSize(size_t n) { return n; }
+    void onReceive(std::function<void(void)> cb, bool=false) { on_receive = cb; }
+    void onReceiveError(std::function<void(hardwareSerial_error_t)> cb) { on_error = cb; }
+    bool setRxFIFOFull(uint8_t) { return true; }
+    bool setRxTimeout(uint8_t) { return true; }
+    operator bool() const { return true; }
+
+    // host side: deliver bytes as a receive interrupt would
+    void receive(const void *data, size_t n) {
+        rx.append((const char *)data, n);
+        if (on_receive) {
+            on_receive();
+        }
+    }
+
+    std::string tx;
+
+    // room left in the TX FIFO, set by a test to model a slow link;
+    // negative for a UART that always has room
+    int tx_room = -1;
+
+private:
+    int num;
+    unsigned long baudrate = 0;
+    std::string rx;
+    size_t rx_pos = 0;
+    std::function<void(void)> on_receive;
+    std::function<void(hardwareSerial_error_t)> on_error;
+
+    // only the tail of the output is kept
+    void trim_tx(void) {
+        if (tx.length() > 65536) {
+            tx.erase(0, tx.length() - 32768);
+        }
+    }
+};
+
+extern HardwareSerial Serial, Serial1, Serial2;
+
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield(void);
+
+long random(long max);
+long random(long min, long max);
+void randomSeed(unsigned long seed);
+
+#define LED_BUILTIN 48
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define PULLUP 0x04
+#define INPUT_PULLUP 0x05
+#define RISING 0x01
+#define FALLING 0x02
+#define CHANGE 0x03
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+uint16_t analogRead(uint8_t pin);
+uint32_t analogReadMilliVolts(uint8_t pin);
+void analogReadResolution(uint8_t bits);
+void attachInterrupt(uint8_t pin, void (*fn)(void), int mode);
+void attachInterruptArg(uint8_t pin, void (*fn)(void *), void *arg, int mode);
+void detachInterrupt(uint8_t pin);
+int digitalPinToInterrupt(uint8_t pin);
+
+class EspClass {
+public:
+    uint32_t getFreeHeap(void) { return 200000; }
+    uint32_t getMinFreeHeap(void) { return 180000; }
+    uint32_t getHeapSize(void) { return 320000; }
+    void restart(void);
+    uint64_t getEfuseMac(void) { return 0x0100C40A24ULL; }
+    uint32_t getFlashChipSize(void) { return 8*1024*1024; }
+    uint32_t getCpuFreqMHz(void) { return 240; }
+    const char *getChipModel(void) { return "ESP32-S3"; }
+    uint32_t getSketchSize(void) { return 1200000; }
+    uint32_t getFreeSketchSpace(void) { return 1800000; }
+};
+extern EspClass ESP;
+
+#if !defined(__GLIBC__) || !__GLIBC_PREREQ(2, 38)
+// in newlib on the target, and glibc only from 2.38
+size_t strlcpy(char *dst, const char *src, size_t size);
+size_t strlcat(char *dst, const char *src, size_t size);
+#endif
+
+template <typename T> T constrain(T v, T lo, T hi)
+{
+    return v < lo ? lo : (v > hi ? hi : v);
+}
+
+typedef enum {
+    GPIO_NUM_0 = 0, GPIO_NUM_1, GPIO_NUM_2, GPIO_NUM_3, GPIO_NUM_4, GPIO_NUM_5,
+    GPIO_NUM_6, GPIO_NUM_7, GPIO_NUM_8, GPIO_NUM_9, GPIO_NUM_10, GPIO_NUM_11,
+    GPIO_NUM_12, GPIO_NUM_13, GPIO_NUM_14, GPIO_NUM_15, GPIO_NUM_16, GPIO_NUM_17,
+    GPIO_NUM_18, GPIO_NUM_19, GPIO_NUM_20, GPIO_NUM_21, GPIO_NUM_22, GPIO_NUM_23,
+    GPIO_NUM_24, GPIO_NUM_25, GPIO_NUM_26, GPIO_NUM_27, GPIO_NUM_28, GPIO_NUM_29,
+    GPIO_NUM_30, GPIO_NUM_31, GPIO_NUM_32, GPIO_NUM_33, GPIO_NUM_34, GPIO_NUM_35,
+    GPIO_NUM_36, GPIO_NUM_37, GPIO_NUM_38, GPIO_NUM_39, GPIO_NUM_40, GPIO_NUM_41,
+    GPIO_NUM_42, GPIO_NUM_43, GPIO_NUM_44, GPIO_NUM_45, GPIO_NUM_46, GPIO_NUM_47,
+    GPIO_NUM_48,
+} gpio_num_t;
+
+#include "host.h"
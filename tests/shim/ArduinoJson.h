@@ -0,0 +1,46 @@
+/*
+  host build of ArduinoJson: documents hold nothing, only the MQTT
+  paths use them and there is no broker on the host
+ */
+#pragma once
+
+#include <Arduino.h>
+
+class JsonVariant {
+public:
+    template <typename T> JsonVariant &operator=(const T &) { return *this; }
+    JsonVariant operator[](const char *) const { return JsonVariant(); }
+    template <typename T> operator T() const { return T(); }
+    template <typename T> bool operator==(const T &) const { return false; }
+    template <typename T> T as() const { return T(); }
+    JsonVariant createNestedObject(const char *) const { return JsonVariant(); }
+};
+typedef JsonVariant JsonObject;
+
+class JsonDocument {
+public:
+    JsonVariant operator[](const char *) const { return JsonVariant(); }
+};
+
+class DynamicJsonDocument : public JsonDocument {
+public:
+    DynamicJsonDocument(size_t) {}
+};
+
+class DeserializationError {
+public:
+    enum Code {
+        Ok,
+        InvalidInput,
+    };
+    bool operator==(Code c) const { return c == InvalidInput; }
+};
+
+template <typename D, typename S> DeserializationError deserializeJson(D &, const S &)
+{
+    return DeserializationError();
+}
+template <typename D, typename S> size_t serializeJson(const D &, S &)
+{
+    return 0;
+}
@@ -0,0 +1,12 @@
+/*
+  host build of the Arduino BLEDevice class
+ */
+#pragma once
+
+#include "esp_gap_ble_api.h"
+
+class BLEDevice {
+public:
+    static void init(const char *name);
+    static void setCustomGapHandler(void (*handler)(esp_gap_ble_cb_event_t, esp_ble_gap_cb_param_t *));
+};
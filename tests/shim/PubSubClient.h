@@ -0,0 +1,24 @@
+/*
+  host build of PubSubClient: there is no broker, it never connects
+ */
+#pragma once
+
+#include <Arduino.h>
+#include <WiFi.h>
+
+class PubSubClient {
+public:
+    PubSubClient(WiFiClient &) {}
+    void setServer(const char *, uint16_t) {}
+    template <typename F> void setCallback(F) {}
+    void setBufferSize(uint16_t) {}
+    void setKeepAlive(uint16_t) {}
+    bool connected(void) { return false; }
+    bool connect(const char *) { return false; }
+    bool connect(const char *, const char *, uint8_t, bool, const char *) { return false; }
+    bool connect(const char *, const char *, const char *, const char *, uint8_t, bool, const char *) { return false; }
+    bool publish(const char *, const char *, bool = false) { return false; }
+    bool subscribe(const char *, uint8_t = 0) { return false; }
+    bool loop(void) { return false; }
+    int state(void) { return -1; }
+};
@@ -0,0 +1,48 @@
+/*
+  host build of the Arduino WiFi class
+ */
+#pragma once
+
+#include <Arduino.h>
+
+class IPAddress {
+public:
+    IPAddress(uint8_t a=0, uint8_t b=0, uint8_t c=0, uint8_t d=0) : addr{a, b, c, d} {}
+    String toString(void) const {
+        return String(int(addr[0])) + "." + String(int(addr[1])) + "." + String(int(addr[2])) + "." + String(int(addr[3]));
+    }
+
+private:
+    uint8_t addr[4];
+};
+
+#define WIFI_OFF 0
+#define WIFI_STA 1
+#define WIFI_AP 2
+#define WIFI_AP_STA 3
+#define WL_CONNECTED 3
+#define WL_DISCONNECTED 6
+
+class WiFiClass {
+public:
+    String macAddress(void) { return String("24:0A:C4:00:00:01"); }
+    bool softAP(const char *, const char * = nullptr, int = 1, int = 0, int = 4) { return true; }
+    bool softAPConfig(IPAddress, IPAddress, IPAddress) { return true; }
+    bool mode(int) { return true; }
+    IPAddress softAPIP(void) { return IPAddress(192, 168, 4, 1); }
+    int status(void) { return WL_DISCONNECTED; }
+    String SSID(void) { return String(); }
+    int RSSI(void) { return 0; }
+    IPAddress localIP(void) { return IPAddress(); }
+};
+extern WiFiClass WiFi;
+
+class WiFiClient : public Stream {
+public:
+    size_t write(uint8_t) override { return 1; }
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+    bool connected(void) { return false; }
+    void stop(void) {}
+};
@@ -0,0 +1,59 @@
+/*
+  host build of the Arduino Wire class: a fake I2C bus of register
+  image chips. Each chip is 256 registers addressed by the first byte
+  written; reads and writes advance the register pointer as the chip
+  would. A read hook lets a test model registers with side effects,
+  such as a FIFO. Transfers advance the simulated clock by their time
+  on a 400kHz bus
+ */
+#pragma once
+
+#include <Arduino.h>
+#include <map>
+#include <vector>
+#include <functional>
+
+struct Fake_Chip {
+    uint8_t regs[256];
+    // the register pointer only increments when bit 7 of the register
+    // address is set, as on the ST sensors
+    bool autoinc_msb;
+    uint32_t reads;
+    uint32_t writes;
+    /*
+      read n bytes at reg into out instead of from regs, returning
+      false to fall back to regs
+     */
+    std::function<bool(uint8_t reg, size_t n, std::vector<uint8_t> &out)> read_hook;
+};
+
+class TwoWire : public Stream {
+public:
+    // microseconds a byte takes on the bus, 9 bits at 400kHz
+    static constexpr uint32_t BYTE_US = 23;
+
+    std::map<uint8_t, Fake_Chip> chips;
+    uint32_t transactions;
+    uint32_t errors;
+
+    bool begin(int sda=-1, int scl=-1, uint32_t frequency=0);
+    void setClock(uint32_t) {}
+    void beginTransmission(uint8_t address);
+    size_t write(uint8_t b) override;
+    size_t write(const uint8_t *b, size_t n) override;
+    uint8_t endTransmission(bool stop=true);
+    size_t requestFrom(uint8_t address, size_t n, bool stop=true);
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t readBytes(uint8_t *b, size_t n);
+
+private:
+    uint8_t address;
+    uint8_t reg;
+    bool have_reg;
+    std::vector<uint8_t> rx;
+    size_t rx_pos;
+};
+
+extern TwoWire Wire;
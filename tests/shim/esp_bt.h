@@ -0,0 +1,36 @@
+/*
+  host build of the ESP-IDF Bluetooth controller API
+ */
+#pragma once
+
+#include <stdint.h>
+
+typedef int esp_err_t;
+#ifndef ESP_OK
+#define ESP_OK 0
+#endif
+
+typedef enum {
+    ESP_PWR_LVL_N24 = 0,
+    ESP_PWR_LVL_N21,
+    ESP_PWR_LVL_N18,
+    ESP_PWR_LVL_N15,
+    ESP_PWR_LVL_N12,
+    ESP_PWR_LVL_N9,
+    ESP_PWR_LVL_N6,
+    ESP_PWR_LVL_N3,
+    ESP_PWR_LVL_N0,
+    ESP_PWR_LVL_P3,
+    ESP_PWR_LVL_P6,
+    ESP_PWR_LVL_P9,
+    ESP_PWR_LVL_P12,
+    ESP_PWR_LVL_P15,
+    ESP_PWR_LVL_P18,
+    ESP_PWR_LVL_P21,
+} esp_power_level_t;
+
+typedef enum {
+    ESP_BLE_PWR_TYPE_ADV = 9,
+} esp_ble_power_type_t;
+
+esp_err_t esp_ble_tx_power_set(esp_ble_power_type_t type, esp_power_level_t level);
@@ -0,0 +1,80 @@
+/*
+  host build of the ESP-IDF GAP extended advertising API. Each call
+  completes at once, running the registered GAP callback before it
+  returns, and advertising data is recorded in host_radio
+ */
+#pragma once
+
+#include <stdint.h>
+#include "esp_bt.h"
+
+typedef enum {
+    ESP_BT_STATUS_SUCCESS = 0,
+    ESP_BT_STATUS_FAIL,
+} esp_bt_status_t;
+
+typedef enum {
+    ESP_GAP_BLE_EXT_ADV_SET_PARAMS_COMPLETE_EVT,
+    ESP_GAP_BLE_EXT_ADV_SET_RAND_ADDR_COMPLETE_EVT,
+    ESP_GAP_BLE_EXT_ADV_DATA_SET_COMPLETE_EVT,
+    ESP_GAP_BLE_EXT_ADV_START_COMPLETE_EVT,
+} esp_gap_ble_cb_event_t;
+
+struct ble_adv_status_param {
+    esp_bt_status_t status;
+    uint8_t instance;
+};
+
+typedef union {
+    ble_adv_status_param ext_adv_set_params;
+    ble_adv_status_param ext_adv_set_rand_addr;
+    ble_adv_status_param ext_adv_data_set;
+    ble_adv_status_param ext_adv_start;
+} esp_ble_gap_cb_param_t;
+
+#define ESP_BLE_GAP_SET_EXT_ADV_PROP_NONCONN_NONSCANNABLE_UNDIRECTED 0x0000
+#define ESP_BLE_GAP_SET_EXT_ADV_PROP_LEGACY 0x0010
+#define ESP_BLE_GAP_SET_EXT_ADV_PROP_LEGACY_NONCONN 0x0010
+#define ESP_BLE_GAP_PHY_1M 1
+#define ESP_BLE_GAP_PHY_CODED 3
+
+typedef enum {
+    ADV_CHNL_ALL = 7,
+} esp_ble_adv_channel_t;
+
+typedef enum {
+    BLE_ADDR_TYPE_PUBLIC = 0,
+    BLE_ADDR_TYPE_RANDOM = 1,
+} esp_ble_addr_type_t;
+
+typedef enum {
+    ADV_FILTER_ALLOW_SCAN_ANY_CON_ANY = 0,
+} esp_ble_adv_filter_t;
+
+typedef struct {
+    uint16_t type;
+    uint32_t interval_min;
+    uint32_t interval_max;
+    esp_ble_adv_channel_t channel_map;
+    esp_ble_addr_type_t own_addr_type;
+    esp_ble_addr_type_t peer_addr_type;
+    uint8_t peer_addr[6];
+    esp_ble_adv_filter_t filter_policy;
+    int8_t tx_power;
+    uint8_t primary_phy;
+    uint8_t max_skip;
+    uint8_t secondary_phy;
+    uint8_t sid;
+    bool scan_req_notif;
+} esp_ble_gap_ext_adv_params_t;
+
+typedef struct {
+    uint8_t instance;
+    int duration;
+    int max_events;
+} esp_ble_gap_ext_adv_t;
+
+esp_err_t esp_ble_gap_ext_adv_set_params(uint8_t instance, const esp_ble_gap_ext_adv_params_t *params);
+esp_err_t esp_ble_gap_ext_adv_set_rand_addr(uint8_t instance, const uint8_t *rand_addr);
+esp_err_t esp_ble_gap_config_ext_adv_data_raw(uint8_t instance, uint16_t length, const uint8_t *data);
+esp_err_t esp_ble_gap_ext_adv_start(uint8_t num_adv, const esp_ble_gap_ext_adv_t *ext_adv);
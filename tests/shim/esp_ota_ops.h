@@ -0,0 +1,13 @@
+/*
+  host build of the OTA API: only the partition type, the firmware
+  check and updater are not built on the host
+ */
+#pragma once
+
+#include <Arduino.h>
+
+typedef struct {
+    uint32_t address;
+    uint32_t size;
+    char label[17];
+} esp_partition_t;
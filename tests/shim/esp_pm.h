@@ -0,0 +1,29 @@
+/*
+  host build of the ESP-IDF power management API
+ */
+#pragma once
+
+#include <Arduino.h>
+
+#define CONFIG_PM_ENABLE 1
+#define CONFIG_PM_LIGHT_SLEEP_CALLBACKS 1
+
+typedef struct {
+    int max_freq_mhz;
+    int min_freq_mhz;
+    bool light_sleep_enable;
+} esp_pm_config_t;
+
+typedef esp_err_t (*esp_pm_light_sleep_cb_t)(int64_t sleep_time_us, void *arg);
+
+typedef struct {
+    esp_pm_light_sleep_cb_t enter_cb;
+    esp_pm_light_sleep_cb_t exit_cb;
+    void *enter_cb_user_arg;
+    void *exit_cb_user_arg;
+    uint32_t enter_cb_prior;
+    uint32_t exit_cb_prior;
+} esp_pm_sleep_cbs_register_config_t;
+
+esp_err_t esp_pm_configure(const void *config);
+esp_err_t esp_pm_light_sleep_register_cbs(esp_pm_sleep_cbs_register_config_t *cbs);
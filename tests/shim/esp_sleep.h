@@ -0,0 +1,5 @@
+#pragma once
+
+#include <Arduino.h>
+
+esp_err_t esp_sleep_enable_gpio_wakeup(void);
@@ -0,0 +1,55 @@
+/*
+  host build of the FreeRTOS API used by the firmware, see host.h for
+  how tasks are simulated
+ */
+#pragma once
+
+#include <stdint.h>
+
+typedef void *TaskHandle_t;
+typedef void *SemaphoreHandle_t;
+typedef void *QueueHandle_t;
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned UBaseType_t;
+
+#define pdMS_TO_TICKS(ms) (ms)
+#define portTICK_PERIOD_MS 1
+#define portMAX_DELAY 0xffffffffU
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS 1
+#define pdFAIL 0
+#define configMAX_PRIORITIES 25
+#define tskNO_AFFINITY 0x7fffffff
+
+// one task runs at a time, so critical sections have nothing to do
+typedef struct {
+    int unused;
+} portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED {0}
+#define portENTER_CRITICAL(mux) do { (void)(mux); } while (0)
+#define portEXIT_CRITICAL(mux) do { (void)(mux); } while (0)
+#define portENTER_CRITICAL_ISR(mux) do { (void)(mux); } while (0)
+#define portEXIT_CRITICAL_ISR(mux) do { (void)(mux); } while (0)
+#define taskENTER_CRITICAL(mux) do { (void)(mux); } while (0)
+#define taskEXIT_CRITICAL(mux) do { (void)(mux); } while (0)
+#define portYIELD_FROM_ISR(woken) do { (void)(woken); } while (0)
+
+BaseType_t xTaskCreatePinnedToCore(void (*fn)(void *), const char *name, uint32_t stack_size,
+                                   void *arg, UBaseType_t priority, TaskHandle_t *handle, BaseType_t core);
+void vTaskDelete(TaskHandle_t handle);
+void vTaskDelay(TickType_t ticks);
+TickType_t xTaskGetTickCount(void);
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t handle);
+
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t ticks);
+BaseType_t xTaskNotifyGive(TaskHandle_t handle);
+void vTaskNotifyGiveFromISR(TaskHandle_t handle, BaseType_t *woken);
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void);
+SemaphoreHandle_t xSemaphoreCreateBinary(void);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem);
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t sem, BaseType_t *woken);
@@ -0,0 +1,106 @@
+/*
+  test side controls of the host build: the simulated clock, pins, NVS
+  and the FreeRTOS task simulation
+ */
+#pragma once
+
+#include <stdint.h>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+/*
+  simulated time. It only moves when a test advances it, when the
+  firmware calls delay(), or when the task simulation runs to the next
+  task wake up
+ */
+uint64_t host_time_us(void);
+void host_set_time_us(uint64_t us);
+void host_advance_us(uint64_t us);
+
+// drive an input pin, running its interrupt handler on a matching edge.
+// A pull-up leaves a driven pin at its level
+void host_set_pin(uint8_t pin, int level);
+int host_get_pin(uint8_t pin);
+// voltage seen by analogRead() and analogReadMilliVolts() on a pin
+void host_set_analog_mv(uint8_t pin, uint32_t mv);
+
+/*
+  NVS held in memory, in the order keys were written, with counters
+  and a log of each write and commit so tests can check durability
+  ordering. With fail_writes set every set and commit fails. on_write
+  runs after each write and commit with its log entry, so a test can
+  set parameters mid-flush or keep the NVS contents at each step to
+  boot from after a power cut
+ */
+struct Host_NVS {
+    std::map<std::string, std::vector<uint8_t>> keys;
+    std::vector<std::string> log;
+    uint32_t writes;
+    uint32_t commits;
+    uint32_t reads;
+    bool fail_writes;
+    std::function<void(const std::string &entry)> on_write;
+
+    void clear(void) {
+        keys.clear();
+        log.clear();
+        writes = commits = reads = 0;
+        fail_writes = false;
+        on_write = nullptr;
+    }
+};
+extern Host_NVS host_nvs;
+
+/*
+  FreeRTOS task simulation. Tasks are threads, but only one of the
+  test and the tasks runs at a time: the highest priority task that is
+  ready, and the clock moves to the next wake up when none is. A task
+  runs until it blocks, so its function is never preempted. The
+  caller of xTaskCreatePinnedToCore() or xTaskNotifyGive() outside a
+  task is the Arduino loop task at priority 1, and higher priority
+  tasks made ready by it run straight away, as on the target.
+ */
+void host_run_us(uint64_t us);
+static inline void host_run_ms(uint32_t ms)
+{
+    host_run_us(uint64_t(ms) * 1000);
+}
+// number of times each task has run its loop since it was created
+uint32_t host_task_runs(const char *name);
+/*
+  called with each stretch the clock jumps over because every task is
+  blocked, where the tickless idle of the target would light sleep
+ */
+extern std::function<void(uint64_t us)> host_idle_hook;
+
+/*
+  WiFi and BLE output of the firmware. GAP completion events run
+  inside the GAP call unless ble_defer_events is set, then they wait
+  for host_ble_events()
+ */
+struct Host_Radio {
+    uint32_t wifi_frames;
+    std::vector<uint8_t> wifi_last_frame;
+    uint32_t vendor_ie_sets;
+    uint32_t vendor_ie_removes;
+    // vendor IE per type and id, empty while the slot is free
+    std::vector<uint8_t> vendor_ie[3][2];
+    // most vendor IEs of one type installed at the same time
+    uint8_t vendor_ie_max_installed;
+    // removes that left a type with no vendor IE after it had one
+    uint32_t vendor_ie_gaps;
+    // vendor IE calls made, and the one to fail counted from 1, 0 for none
+    uint32_t vendor_ie_calls;
+    uint32_t vendor_ie_fail_call;
+
+    bool ble_defer_events;
+    uint32_t ble_adv_data_sets[2];
+    std::vector<uint8_t> ble_adv_data[2];
+    bool ble_started[2];
+};
+extern Host_Radio host_radio;
+
+// run the GAP completion events held back by ble_defer_events
+void host_ble_events(void);
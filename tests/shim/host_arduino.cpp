@@ -0,0 +1,212 @@
+/*
+  host build of the Arduino core: the simulated clock, pins and UARTs
+ */
+
+#include <Arduino.h>
+#include <esp_timer.h>
+
+HardwareSerial Serial(0);
+HardwareSerial Serial1(1);
+HardwareSerial Serial2(2);
+EspClass ESP;
+
+static uint64_t now_us;
+
+uint64_t host_time_us(void)
+{
+    return now_us;
+}
+
+void host_set_time_us(uint64_t us)
+{
+    now_us = us;
+}
+
+void host_advance_us(uint64_t us)
+{
+    now_us += us;
+}
+
+unsigned long millis(void)
+{
+    return now_us / 1000;
+}
+
+unsigned long micros(void)
+{
+    return now_us;
+}
+
+int64_t esp_timer_get_time(void)
+{
+    return now_us;
+}
+
+// in host_freertos.cpp
+void host_delay_us(uint64_t us);
+
+void delay(unsigned long ms)
+{
+    host_delay_us(uint64_t(ms) * 1000);
+}
+
+void delayMicroseconds(unsigned int us)
+{
+    now_us += us;
+}
+
+void yield(void)
+{
+}
+
+// xorshift, so runs repeat
+static uint32_t random_state = 0x2545F491;
+
+long random(long max)
+{
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return max > 0 ? long(random_state % uint32_t(max)) : 0;
+}
+
+long random(long min, long max)
+{
+    return max > min ? min + random(max - min) : min;
+}
+
+void randomSeed(unsigned long seed)
+{
+    random_state = seed != 0 ? seed : 0x2545F491;
+}
+
+struct Host_Pin {
+    int level;
+    uint32_t mv;
+    void (*isr)(void);
+    void (*isr_arg)(void *);
+    void *arg;
+    int mode;
+    // set by the test, a pull-up no longer changes the level
+    bool driven;
+};
+static Host_Pin pins[64];
+
+void host_set_pin(uint8_t pin, int level)
+{
+    Host_Pin &p = pins[pin];
+    p.driven = true;
+    const int old = p.level;
+    p.level = level ? HIGH : LOW;
+    if (p.level == old) {
+        return;
+    }
+    const bool edge = p.mode == CHANGE ||
+                      (p.mode == RISING && p.level == HIGH) ||
+                      (p.mode == FALLING && p.level == LOW);
+    if (!edge) {
+        return;
+    }
+    if (p.isr_arg != nullptr) {
+        p.isr_arg(p.arg);
+    } else if (p.isr != nullptr) {
+        p.isr();
+    }
+}
+
+int host_get_pin(uint8_t pin)
+{
+    return pins[pin].level;
+}
+
+void host_set_analog_mv(uint8_t pin, uint32_t mv)
+{
+    pins[pin].mv = mv;
+}
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    if (mode == INPUT_PULLUP && !pins[pin].driven) {
+        pins[pin].level = HIGH;
+    }
+}
+
+void digitalWrite(uint8_t pin, uint8_t val)
+{
+    pins[pin].level = val ? HIGH : LOW;
+}
+
+int digitalRead(uint8_t pin)
+{
+    return pins[pin].level;
+}
+
+uint16_t analogRead(uint8_t pin)
+{
+    // 12 bit, 3.3V full scale
+    const uint32_t raw = pins[pin].mv * 4095 / 3300;
+    return raw > 4095 ? 4095 : raw;
+}
+
+uint32_t analogReadMilliVolts(uint8_t pin)
+{
+    return pins[pin].mv;
+}
+
+void analogReadResolution(uint8_t)
+{
+}
+
+void attachInterrupt(uint8_t pin, void (*fn)(void), int mode)
+{
+    pins[pin].isr = fn;
+    pins[pin].isr_arg = nullptr;
+    pins[pin].mode = mode;
+}
+
+void attachInterruptArg(uint8_t pin, void (*fn)(void *), void *arg, int mode)
+{
+    pins[pin].isr = nullptr;
+    pins[pin].isr_arg = fn;
+    pins[pin].arg = arg;
+    pins[pin].mode = mode;
+}
+
+void detachInterrupt(uint8_t pin)
+{
+    pins[pin].isr = nullptr;
+    pins[pin].isr_arg = nullptr;
+}
+
+int digitalPinToInterrupt(uint8_t pin)
+{
+    return pin;
+}
+
+void EspClass::restart(void)
+{
+    fprintf(stderr, "ESP.restart() on the host\n");
+    abort();
+}
+
+#if !defined(__GLIBC__) || !__GLIBC_PREREQ(2, 38)
+size_t strlcpy(char *dst, const char *src, size_t size)
+{
+    const size_t len = strlen(src);
+    if (size > 0) {
+        const size_t n = len < size - 1 ? len : size - 1;
+        memcpy(dst, src, n);
+        dst[n] = 0;
+    }
+    return len;
+}
+
+size_t strlcat(char *dst, const char *src, size_t size)
+{
+    const size_t dlen = strnlen(dst, size);
+    if (dlen == size) {
+        return size + strlen(src);
+    }
+    return dlen + strlcpy(dst + dlen, src, size - dlen);
+}
+#endif
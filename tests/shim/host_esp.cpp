@@ -0,0 +1,171 @@
+/*
+  host build of the ESP-IDF WiFi, Bluetooth and power calls
+ */
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <esp_wifi.h>
+#include <esp_pm.h>
+#include <esp_sleep.h>
+#include <driver/gpio.h>
+#include <BLEDevice.h>
+#include <deque>
+
+Host_Radio host_radio;
+WiFiClass WiFi;
+
+esp_err_t esp_wifi_set_mac(wifi_interface_t, const uint8_t *)
+{
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_set_bandwidth(wifi_interface_t, wifi_bandwidth_t)
+{
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_set_max_tx_power(int8_t)
+{
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_80211_tx(wifi_interface_t, const void *buffer, int len, bool)
+{
+    const uint8_t *p = (const uint8_t *)buffer;
+    host_radio.wifi_frames++;
+    host_radio.wifi_last_frame.assign(p, p + len);
+    return ESP_OK;
+}
+
+/*
+  the driver holds one element per type and id: setting an id in use
+  is an error, as is removing a free one. A call can be made to fail
+ */
+esp_err_t esp_wifi_set_vendor_ie(bool enable, wifi_vendor_ie_type_t type, wifi_vendor_ie_id_t idx, const void *vnd_ie)
+{
+    auto &slots = host_radio.vendor_ie[type];
+    if (++host_radio.vendor_ie_calls == host_radio.vendor_ie_fail_call) {
+        return ESP_FAIL;
+    }
+    if (!enable) {
+        if (slots[idx].empty()) {
+            return ESP_ERR_INVALID_ARG;
+        }
+        slots[idx].clear();
+        host_radio.vendor_ie_removes++;
+        if (slots[0].empty() && slots[1].empty()) {
+            host_radio.vendor_ie_gaps++;
+        }
+        return ESP_OK;
+    }
+    if (!slots[idx].empty() || vnd_ie == nullptr) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    const vendor_ie_data_t *ie = (const vendor_ie_data_t *)vnd_ie;
+    const uint8_t *p = (const uint8_t *)vnd_ie;
+    slots[idx].assign(p, p + 2 + ie->length);
+    host_radio.vendor_ie_sets++;
+    const uint8_t installed = !slots[0].empty() + !slots[1].empty();
+    if (installed > host_radio.vendor_ie_max_installed) {
+        host_radio.vendor_ie_max_installed = installed;
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_pm_configure(const void *)
+{
+    return ESP_OK;
+}
+
+esp_err_t esp_pm_light_sleep_register_cbs(esp_pm_sleep_cbs_register_config_t *)
+{
+    return ESP_OK;
+}
+
+esp_err_t esp_sleep_enable_gpio_wakeup(void)
+{
+    return ESP_OK;
+}
+
+esp_err_t gpio_wakeup_enable(gpio_num_t, gpio_int_type_t)
+{
+    return ESP_OK;
+}
+
+static void (*gap_handler)(esp_gap_ble_cb_event_t, esp_ble_gap_cb_param_t *);
+
+struct Gap_Event {
+    esp_gap_ble_cb_event_t event;
+    esp_ble_gap_cb_param_t param;
+};
+static std::deque<Gap_Event> gap_events;
+
+static void gap_event(esp_gap_ble_cb_event_t event, uint8_t instance)
+{
+    Gap_Event e {};
+    e.event = event;
+    e.param.ext_adv_data_set.status = ESP_BT_STATUS_SUCCESS;
+    e.param.ext_adv_data_set.instance = instance;
+    gap_events.push_back(e);
+    if (!host_radio.ble_defer_events) {
+        host_ble_events();
+    }
+}
+
+void host_ble_events(void)
+{
+    while (!gap_events.empty()) {
+        Gap_Event e = gap_events.front();
+        gap_events.pop_front();
+        if (gap_handler != nullptr) {
+            gap_handler(e.event, &e.param);
+        }
+    }
+}
+
+void BLEDevice::init(const char *)
+{
+}
+
+void BLEDevice::setCustomGapHandler(void (*handler)(esp_gap_ble_cb_event_t, esp_ble_gap_cb_param_t *))
+{
+    gap_handler = handler;
+}
+
+esp_err_t esp_ble_tx_power_set(esp_ble_power_type_t, esp_power_level_t)
+{
+    return ESP_OK;
+}
+
+esp_err_t esp_ble_gap_ext_adv_set_params(uint8_t instance, const esp_ble_gap_ext_adv_params_t *)
+{
+    gap_event(ESP_GAP_BLE_EXT_ADV_SET_PARAMS_COMPLETE_EVT, instance);
+    return ESP_OK;
+}
+
+esp_err_t esp_ble_gap_ext_adv_set_rand_addr(uint8_t instance, const uint8_t *)
+{
+    gap_event(ESP_GAP_BLE_EXT_ADV_SET_RAND_ADDR_COMPLETE_EVT, instance);
+    return ESP_OK;
+}
+
+esp_err_t esp_ble_gap_config_ext_adv_data_raw(uint8_t instance, uint16_t length, const uint8_t *data)
+{
+    if (instance >= 2) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    host_radio.ble_adv_data_sets[instance]++;
+    host_radio.ble_adv_data[instance].assign(data, data + length);
+    gap_event(ESP_GAP_BLE_EXT_ADV_DATA_SET_COMPLETE_EVT, instance);
+    return ESP_OK;
+}
+
+esp_err_t esp_ble_gap_ext_adv_start(uint8_t num_adv, const esp_ble_gap_ext_adv_t *ext_adv)
+{
+    for (uint8_t i=0; i<num_adv; i++) {
+        if (ext_adv[i].instance < 2) {
+            host_radio.ble_started[ext_adv[i].instance] = true;
+        }
+    }
+    return ESP_OK;
+}
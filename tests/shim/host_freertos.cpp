@@ -0,0 +1,339 @@
+/*
+  FreeRTOS task simulation on the simulated clock
+
+  Each task is a thread, but a thread only runs while it holds the
+  baton: the test thread (standing in for the Arduino loop task) hands
+  it to the highest priority ready task and waits until that task
+  blocks again. With no task ready the clock jumps to the earliest
+  wake up. Runs are deterministic and take no real time, and task
+  functions are never preempted, which a non-blocking task function
+  can't tell apart from the target.
+
+  Shared state lives on the heap and is never freed, so task threads
+  still blocked when a test exits don't outlive what they wait on.
+ */
+
+#include <Arduino.h>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+struct Host_Sem;
+
+struct Host_Task {
+    std::string name;
+    void (*fn)(void *);
+    void *arg;
+    UBaseType_t priority;
+    uint32_t stack_size;
+    uint32_t notify;
+    bool blocked;
+    bool wait_notify;
+    Host_Sem *wait_sem;
+    uint64_t wake_us;
+    uint64_t last_run_us;
+    uint32_t runs;
+    bool deleted;
+    std::condition_variable cv;
+};
+
+struct Host_Sem {
+    bool mutex;
+    uint32_t count;
+};
+
+// priority of the Arduino loop task, which the test thread stands in for
+#define LOOP_TASK_PRIORITY 1
+
+static std::mutex &lock = *new std::mutex;
+static std::condition_variable &loop_cv = *new std::condition_variable;
+static std::vector<Host_Task *> &tasks = *new std::vector<Host_Task *>;
+static Host_Task *running;
+static bool dispatching;
+static thread_local Host_Task *self;
+
+std::function<void(uint64_t us)> host_idle_hook;
+
+static bool ready(const Host_Task *t, uint64_t now_us)
+{
+    if (t->deleted) {
+        return false;
+    }
+    if (!t->blocked) {
+        return true;
+    }
+    return (t->wait_notify && t->notify > 0) ||
+           (t->wait_sem != nullptr && t->wait_sem->count > 0) ||
+           t->wake_us <= now_us;
+}
+
+// hand the baton to a task and wait for it to come back
+static void switch_to(std::unique_lock<std::mutex> &l, Host_Task *t)
+{
+    t->blocked = false;
+    t->last_run_us = host_time_us();
+    t->runs++;
+    running = t;
+    t->cv.notify_one();
+    loop_cv.wait(l, [] { return running == nullptr; });
+}
+
+// give the baton back from a task and wait to be run again
+static void block(std::unique_lock<std::mutex> &l, uint64_t wake_us)
+{
+    Host_Task *t = self;
+    t->blocked = true;
+    t->wake_us = wake_us;
+    running = nullptr;
+    loop_cv.notify_one();
+    t->cv.wait(l, [t] { return running == t; });
+    t->wait_notify = false;
+    t->wait_sem = nullptr;
+}
+
+/*
+  run ready tasks above min_priority. With advance the clock moves to
+  each next wake up until until_us, otherwise only tasks ready now run.
+  Returns when stop() is true, checked between task runs
+ */
+template <typename F>
+static void dispatch(std::unique_lock<std::mutex> &l, UBaseType_t min_priority, bool advance,
+                     uint64_t until_us, F stop)
+{
+    if (dispatching || self != nullptr) {
+        // a task made another ready, it runs when this one blocks
+        return;
+    }
+    dispatching = true;
+    while (!stop()) {
+        const uint64_t now_us = host_time_us();
+        Host_Task *best = nullptr;
+        for (Host_Task *t : tasks) {
+            if (t->priority <= min_priority || !ready(t, now_us)) {
+                continue;
+            }
+            // round robin between equal priorities
+            if (best == nullptr || t->priority > best->priority ||
+                (t->priority == best->priority && t->last_run_us < best->last_run_us)) {
+                best = t;
+            }
+        }
+        if (best != nullptr) {
+            switch_to(l, best);
+            continue;
+        }
+        if (!advance) {
+            break;
+        }
+        uint64_t next_us = until_us;
+        for (const Host_Task *t : tasks) {
+            if (!t->deleted && t->wake_us < next_us) {
+                next_us = t->wake_us;
+            }
+        }
+        if (next_us <= now_us) {
+            break;
+        }
+        if (host_idle_hook) {
+            host_idle_hook(next_us - now_us);
+        }
+        host_set_time_us(next_us);
+    }
+    dispatching = false;
+}
+
+// a task made ready by the loop task preempts it if it has higher priority
+static void preempt(std::unique_lock<std::mutex> &l)
+{
+    dispatch(l, LOOP_TASK_PRIORITY, false, 0, [] { return false; });
+}
+
+void host_run_us(uint64_t us)
+{
+    std::unique_lock<std::mutex> l(lock);
+    const uint64_t until_us = host_time_us() + us;
+    dispatch(l, 0, true, until_us, [until_us] { return host_time_us() >= until_us; });
+    host_set_time_us(until_us);
+}
+
+uint32_t host_task_runs(const char *name)
+{
+    std::unique_lock<std::mutex> l(lock);
+    for (const Host_Task *t : tasks) {
+        if (t->name == name) {
+            return t->runs;
+        }
+    }
+    return 0;
+}
+
+// delay() and vTaskDelay(): a task blocks, the loop task lets tasks run
+void host_delay_us(uint64_t us)
+{
+    if (self == nullptr) {
+        host_run_us(us);
+        return;
+    }
+    std::unique_lock<std::mutex> l(lock);
+    block(l, host_time_us() + us);
+}
+
+static void task_thread(Host_Task *t)
+{
+    std::unique_lock<std::mutex> l(lock);
+    self = t;
+    t->cv.wait(l, [t] { return running == t; });
+    l.unlock();
+    t->fn(t->arg);
+    l.lock();
+    t->deleted = true;
+    running = nullptr;
+    loop_cv.notify_one();
+}
+
+BaseType_t xTaskCreatePinnedToCore(void (*fn)(void *), const char *name, uint32_t stack_size,
+                                   void *arg, UBaseType_t priority, TaskHandle_t *handle, BaseType_t core)
+{
+    std::unique_lock<std::mutex> l(lock);
+    Host_Task *t = new Host_Task();
+    t->name = name;
+    t->fn = fn;
+    t->arg = arg;
+    t->priority = priority;
+    t->stack_size = stack_size;
+    t->last_run_us = host_time_us();
+    tasks.push_back(t);
+    if (handle != nullptr) {
+        *handle = t;
+    }
+    std::thread(task_thread, t).detach();
+    preempt(l);
+    return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t handle)
+{
+    std::unique_lock<std::mutex> l(lock);
+    Host_Task *t = handle != nullptr ? (Host_Task *)handle : self;
+    if (t != nullptr) {
+        t->deleted = true;
+    }
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    host_delay_us(uint64_t(ticks) * 1000);
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    return host_time_us() / 1000;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+    return self;
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t handle)
+{
+    // no stack use to measure on the host
+    return handle != nullptr ? ((Host_Task *)handle)->stack_size / 2 : 0;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t ticks)
+{
+    std::unique_lock<std::mutex> l(lock);
+    Host_Task *t = self;
+    if (t == nullptr) {
+        return 0;
+    }
+    if (t->notify == 0 && ticks != 0) {
+        t->wait_notify = true;
+        block(l, ticks == portMAX_DELAY ? UINT64_MAX : host_time_us() + uint64_t(ticks) * 1000);
+    }
+    const uint32_t count = t->notify;
+    if (count > 0) {
+        t->notify = clear ? 0 : count - 1;
+    }
+    return count;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t handle)
+{
+    std::unique_lock<std::mutex> l(lock);
+    ((Host_Task *)handle)->notify++;
+    preempt(l);
+    return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t handle, BaseType_t *woken)
+{
+    xTaskNotifyGive(handle);
+    if (woken != nullptr) {
+        *woken = pdFALSE;
+    }
+}
+
+static SemaphoreHandle_t create_sem(bool mutex, uint32_t count)
+{
+    Host_Sem *s = new Host_Sem();
+    s->mutex = mutex;
+    s->count = count;
+    return s;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+    return create_sem(true, 1);
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+    return create_sem(false, 0);
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks)
+{
+    std::unique_lock<std::mutex> l(lock);
+    Host_Sem *s = (Host_Sem *)sem;
+    const uint64_t deadline_us = ticks == portMAX_DELAY ? UINT64_MAX : host_time_us() + uint64_t(ticks) * 1000;
+    if (s->count == 0 && ticks != 0) {
+        if (self != nullptr) {
+            self->wait_sem = s;
+            block(l, deadline_us);
+        } else {
+            // the loop task waits by letting the tasks run
+            dispatch(l, 0, true, deadline_us, [s, deadline_us] {
+                return s->count > 0 || host_time_us() >= deadline_us;
+            });
+        }
+    }
+    if (s->count == 0) {
+        return pdFALSE;
+    }
+    s->count--;
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem)
+{
+    std::unique_lock<std::mutex> l(lock);
+    Host_Sem *s = (Host_Sem *)sem;
+    if (s->count > 0) {
+        return pdFALSE;
+    }
+    s->count = 1;
+    if (!s->mutex) {
+        preempt(l);
+    }
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t sem, BaseType_t *woken)
+{
+    if (woken != nullptr) {
+        *woken = pdFALSE;
+    }
+    return xSemaphoreGive(sem);
+}
@@ -0,0 +1,131 @@
+/*
+  NVS held in memory
+ */
+
+#include <nvs_flash.h>
+
+Host_NVS host_nvs;
+
+esp_err_t nvs_flash_init(void)
+{
+    return ESP_OK;
+}
+
+esp_err_t nvs_flash_erase(void)
+{
+    host_nvs.keys.clear();
+    host_nvs.log.push_back("ERASE");
+    return ESP_OK;
+}
+
+esp_err_t nvs_open(const char *, nvs_open_mode, nvs_handle *handle)
+{
+    *handle = 1;
+    return ESP_OK;
+}
+
+esp_err_t nvs_commit(nvs_handle)
+{
+    if (host_nvs.fail_writes) {
+        return ESP_FAIL;
+    }
+    host_nvs.commits++;
+    host_nvs.log.push_back("COMMIT");
+    if (host_nvs.on_write) {
+        host_nvs.on_write("COMMIT");
+    }
+    return ESP_OK;
+}
+
+static esp_err_t put(const char *key, const void *v, size_t len)
+{
+    if (host_nvs.fail_writes) {
+        return ESP_FAIL;
+    }
+    host_nvs.writes++;
+    host_nvs.log.push_back(key);
+    const uint8_t *p = (const uint8_t *)v;
+    host_nvs.keys[key] = std::vector<uint8_t>(p, p + len);
+    if (host_nvs.on_write) {
+        host_nvs.on_write(key);
+    }
+    return ESP_OK;
+}
+
+static esp_err_t get(const char *key, void *v, size_t *len, bool exact)
+{
+    host_nvs.reads++;
+    const auto it = host_nvs.keys.find(key);
+    if (it == host_nvs.keys.end()) {
+        return ESP_ERR_NVS_NOT_FOUND;
+    }
+    const size_t n = it->second.size();
+    if (v == nullptr) {
+        *len = n;
+        return ESP_OK;
+    }
+    if (exact ? n != *len : n > *len) {
+        return ESP_FAIL;
+    }
+    memcpy(v, it->second.data(), n);
+    *len = n;
+    return ESP_OK;
+}
+
+esp_err_t nvs_set_u8(nvs_handle, const char *key, uint8_t v)
+{
+    return put(key, &v, sizeof(v));
+}
+
+esp_err_t nvs_set_i8(nvs_handle, const char *key, int8_t v)
+{
+    return put(key, &v, sizeof(v));
+}
+
+esp_err_t nvs_set_u32(nvs_handle, const char *key, uint32_t v)
+{
+    return put(key, &v, sizeof(v));
+}
+
+esp_err_t nvs_set_str(nvs_handle, const char *key, const char *v)
+{
+    return put(key, v, strlen(v) + 1);
+}
+
+esp_err_t nvs_set_blob(nvs_handle, const char *key, const void *v, size_t len)
+{
+    return put(key, v, len);
+}
+
+esp_err_t nvs_get_u8(nvs_handle, const char *key, uint8_t *v)
+{
+    size_t len = sizeof(*v);
+    return get(key, v, &len, true);
+}
+
+esp_err_t nvs_get_i8(nvs_handle, const char *key, int8_t *v)
+{
+    size_t len = sizeof(*v);
+    return get(key, v, &len, true);
+}
+
+esp_err_t nvs_get_u32(nvs_handle, const char *key, uint32_t *v)
+{
+    size_t len = sizeof(*v);
+    return get(key, v, &len, true);
+}
+
+esp_err_t nvs_get_str(nvs_handle, const char *key, char *v, size_t *len)
+{
+    return get(key, v, len, false);
+}
+
+esp_err_t nvs_get_blob(nvs_handle, const char *key, void *v, size_t *len)
+{
+    return get(key, v, len, false);
+}
+
+void esp_restart(void)
+{
+    ESP.restart();
+}
@@ -0,0 +1,114 @@
+/*
+  fake I2C bus of register image chips
+ */
+
+#include <Wire.h>
+
+TwoWire Wire;
+
+bool TwoWire::begin(int, int, uint32_t)
+{
+    return true;
+}
+
+void TwoWire::beginTransmission(uint8_t _address)
+{
+    // start and address byte
+    host_advance_us(2*BYTE_US);
+    address = _address;
+    have_reg = false;
+}
+
+size_t TwoWire::write(uint8_t b)
+{
+    host_advance_us(BYTE_US);
+    const auto it = chips.find(address);
+    if (it == chips.end()) {
+        return 1;
+    }
+    Fake_Chip &chip = it->second;
+    if (!have_reg) {
+        reg = b;
+        have_reg = true;
+        return 1;
+    }
+    chip.regs[chip.autoinc_msb ? (reg & 0x7F) : reg] = b;
+    chip.writes++;
+    if (!chip.autoinc_msb || (reg & 0x80)) {
+        reg = chip.autoinc_msb ? (((reg & 0x7F) + 1) | 0x80) : reg + 1;
+    }
+    return 1;
+}
+
+size_t TwoWire::write(const uint8_t *b, size_t n)
+{
+    for (size_t i=0; i<n; i++) {
+        write(b[i]);
+    }
+    return n;
+}
+
+uint8_t TwoWire::endTransmission(bool stop)
+{
+    transactions++;
+    if (stop) {
+        host_advance_us(BYTE_US/2);
+    }
+    if (chips.count(address) == 0) {
+        // address not acknowledged
+        errors++;
+        return 2;
+    }
+    return 0;
+}
+
+size_t TwoWire::requestFrom(uint8_t _address, size_t n, bool)
+{
+    host_advance_us((n + 1) * BYTE_US + BYTE_US/2);
+    rx.clear();
+    rx_pos = 0;
+    const auto it = chips.find(_address);
+    if (it == chips.end()) {
+        errors++;
+        return 0;
+    }
+    Fake_Chip &chip = it->second;
+    chip.reads++;
+    if (chip.read_hook && chip.read_hook(reg, n, rx)) {
+        rx.resize(n);
+        return n;
+    }
+    uint8_t r = chip.autoinc_msb ? (reg & 0x7F) : reg;
+    const bool increment = !chip.autoinc_msb || (reg & 0x80);
+    for (size_t i=0; i<n; i++) {
+        rx.push_back(chip.regs[r]);
+        if (increment) {
+            r++;
+        }
+    }
+    return n;
+}
+
+int TwoWire::available()
+{
+    return rx.size() - rx_pos;
+}
+
+int TwoWire::read()
+{
+    return rx_pos < rx.size() ? rx[rx_pos++] : -1;
+}
+
+int TwoWire::peek()
+{
+    return rx_pos < rx.size() ? rx[rx_pos] : -1;
+}
+
+size_t TwoWire::readBytes(uint8_t *b, size_t n)
+{
+    size_t i = 0;
+    for (; i<n && rx_pos<rx.size(); i++) {
+        b[i] = rx[rx_pos++];
+    }
+    return i;
+}
@@ -0,0 +1,32 @@
+/*
+  host build of the ESP-IDF NVS API, held in memory, see host.h
+ */
+#pragma once
+
+#include <Arduino.h>
+
+typedef uint32_t nvs_handle;
+typedef uint32_t nvs_handle_t;
+typedef enum {
+    NVS_READONLY,
+    NVS_READWRITE
+} nvs_open_mode;
+
+#define ESP_ERR_NVS_NOT_FOUND 0x1102
+
+esp_err_t nvs_flash_init(void);
+esp_err_t nvs_flash_erase(void);
+esp_err_t nvs_open(const char *name, nvs_open_mode mode, nvs_handle *handle);
+esp_err_t nvs_commit(nvs_handle handle);
+esp_err_t nvs_set_u8(nvs_handle handle, const char *key, uint8_t v);
+esp_err_t nvs_set_i8(nvs_handle handle, const char *key, int8_t v);
+esp_err_t nvs_set_u32(nvs_handle handle, const char *key, uint32_t v);
+esp_err_t nvs_set_str(nvs_handle handle, const char *key, const char *v);
+esp_err_t nvs_set_blob(nvs_handle handle, const char *key, const void *v, size_t len);
+esp_err_t nvs_get_u8(nvs_handle handle, const char *key, uint8_t *v);
+esp_err_t nvs_get_i8(nvs_handle handle, const char *key, int8_t *v);
+esp_err_t nvs_get_u32(nvs_handle handle, const char *key, uint32_t *v);
+esp_err_t nvs_get_str(nvs_handle handle, const char *key, char *v, size_t *len);
+esp_err_t nvs_get_blob(nvs_handle handle, const char *key, void *v, size_t *len);
+
+void esp_restart(void);
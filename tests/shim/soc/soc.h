@@ -0,0 +1,3 @@
+#pragma once
+
+#define WRITE_PERI_REG(addr, val) do { (void)(addr); (void)(val); } while (0)
@@ -0,0 +1,117 @@
+/*
+  host test framework: the assertions of unit_tests.h, reporting to
+  stderr so each test program is one ctest case
+ */
+#pragma once
+
+#include <Arduino.h>
+#include <chrono>
+
+inline const char *test_current;
+inline uint32_t test_failures;
+inline uint32_t test_count;
+
+inline void test_fail_current(const char *file, int line, const char *reason)
+{
+    fprintf(stderr, "FAIL %s: %s:%d: %s\n", test_current, file, line, reason);
+}
+
+#define TEST_ASSERT(condition, message) do { \
+    if (!(condition)) { \
+        test_fail_current(__FILE__, __LINE__, message); \
+        return false; \
+    } \
+} while(0)
+
+#define TEST_ASSERT_EQUAL(expected, actual, message) do { \
+    const long long _e = (long long)(expected), _a = (long long)(actual); \
+    if (_e != _a) { \
+        char fail_msg[160]; \
+        snprintf(fail_msg, sizeof(fail_msg), "%s: expected %lld, got %lld", message, _e, _a); \
+        test_fail_current(__FILE__, __LINE__, fail_msg); \
+        return false; \
+    } \
+} while(0)
+
+#define TEST_ASSERT_FLOAT_EQUAL(expected, actual, tolerance, message) do { \
+    const double _e = (expected), _a = (actual); \
+    if (!(fabs(_e - _a) <= (tolerance))) { \
+        char fail_msg[160]; \
+        snprintf(fail_msg, sizeof(fail_msg), "%s: expected %.6f, got %.6f", message, _e, _a); \
+        test_fail_current(__FILE__, __LINE__, fail_msg); \
+        return false; \
+    } \
+} while(0)
+
+#define TEST_ASSERT_STRING_EQUAL(expected, actual, message) do { \
+    if (strcmp((expected), (actual)) != 0) { \
+        char fail_msg[160]; \
+        snprintf(fail_msg, sizeof(fail_msg), "%s: expected '%s', got '%s'", message, (expected), (actual)); \
+        test_fail_current(__FILE__, __LINE__, fail_msg); \
+        return false; \
+    } \
+} while(0)
+
+#define TEST_ASSERT_BYTES_EQUAL(expected, actual, len, message) do { \
+    const uint8_t *_e = (const uint8_t *)(expected), *_a = (const uint8_t *)(actual); \
+    for (size_t _i=0; _i<(size_t)(len); _i++) { \
+        if (_e[_i] != _a[_i]) { \
+            char fail_msg[160]; \
+            snprintf(fail_msg, sizeof(fail_msg), "%s: byte %u expected 0x%02x, got 0x%02x", \
+                     message, unsigned(_i), _e[_i], _a[_i]); \
+            test_fail_current(__FILE__, __LINE__, fail_msg); \
+            return false; \
+        } \
+    } \
+} while(0)
+
+inline bool test_run_single(const char *test_name, bool (*test_func)())
+{
+    test_current = test_name;
+    test_count++;
+    const bool passed = test_func();
+    if (!passed) {
+        test_failures++;
+    }
+    printf("%s %s\n", passed ? "ok  " : "FAIL", test_name);
+    return passed;
+}
+
+#define TEST_RUN(fn) test_run_single(#fn, fn)
+
+// exit status of a test program
+inline int test_result(void)
+{
+    printf("%u/%u passed\n", unsigned(test_count - test_failures), unsigned(test_count));
+    return test_failures == 0 ? 0 : 1;
+}
+
+/*
+  benchmarks: time fn over iterations and print the mean per call.
+  Benchmarks are ctest cases too, with a short default run, so they
+  stay buildable; pass an iteration count to measure
+ */
+template <typename F>
+double bench_ns(const char *name, uint32_t iterations, F fn)
+{
+    const auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t i=0; i<iterations; i++) {
+        fn(i);
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+    const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / iterations;
+    printf("%-40s %10.1f ns/call (%u calls)\n", name, ns, unsigned(iterations));
+    return ns;
+}
+
+// keep the compiler from dropping a benchmarked result
+template <typename T>
+inline void bench_keep(const T &v)
+{
+    asm volatile("" : : "g"(&v) : "memory");
+}
+
+inline uint32_t bench_iterations(int argc, char **argv, uint32_t dflt)
+{
+    return argc > 1 ? strtoul(argv[1], nullptr, 0) : dflt;
+}
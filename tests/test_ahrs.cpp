@@ -0,0 +1,229 @@
+/*
+  Mahony AHRS on vessel traces: the single precision filter against a
+  double precision reference written from the paper form, the attitude
+  against the truth of the traces, the sign conventions on static
+  attitudes, and running without the magnetometer
+ */
+
+#include "test.h"
+#include "ahrs.h"
+#include "imu_traces.h"
+
+#define KP 1.0f
+#define KI 0.05f
+
+static double wrap_180(double d)
+{
+    while (d > 180) {
+        d -= 360;
+    }
+    while (d < -180) {
+        d += 360;
+    }
+    return d;
+}
+
+/*
+  the same filter in double precision with the full vectors:
+  e = v_hat x v + m_hat x m, w' = w + Kp e + Ki int e. ahrs.cpp works
+  on half vectors and doubles its gains, so the gains are the same.
+  Started from accel and mag with TRIAD
+ */
+class Reference {
+public:
+    void update(const float *g, const float *a, const float *m, double dt) {
+        const double an = sqrt(double(a[0])*a[0] + double(a[1])*a[1] + double(a[2])*a[2]);
+        const double mn = sqrt(double(m[0])*m[0] + double(m[1])*m[1] + double(m[2])*m[2]);
+        const double A[3] { a[0]/an, a[1]/an, a[2]/an };
+        const double M[3] { m[0]/mn, m[1]/mn, m[2]/mn };
+        if (!initialised) {
+            init(A, M);
+            return;
+        }
+        double R[3][3];
+        rotation(R);
+        // up in the board frame
+        const double v[3] { R[2][0], R[2][1], R[2][2] };
+        // the measured field in the earth frame with its horizontal part
+        // turned to north, back in the board frame
+        double h[3];
+        for (uint8_t i=0; i<3; i++) {
+            h[i] = R[i][0]*M[0] + R[i][1]*M[1] + R[i][2]*M[2];
+        }
+        const double b[3] { sqrt(h[0]*h[0] + h[1]*h[1]), 0, h[2] };
+        double mh[3];
+        for (uint8_t i=0; i<3; i++) {
+            mh[i] = R[0][i]*b[0] + R[2][i]*b[2];
+        }
+        const double e[3] {
+            A[1]*v[2] - A[2]*v[1] + M[1]*mh[2] - M[2]*mh[1],
+            A[2]*v[0] - A[0]*v[2] + M[2]*mh[0] - M[0]*mh[2],
+            A[0]*v[1] - A[1]*v[0] + M[0]*mh[1] - M[1]*mh[0],
+        };
+        double w[3];
+        for (uint8_t i=0; i<3; i++) {
+            integral[i] += KI * e[i] * dt;
+            w[i] = g[i] + integral[i] + KP * e[i];
+        }
+        const double dq[4] {
+            -q[1]*w[0] - q[2]*w[1] - q[3]*w[2],
+            q[0]*w[0] + q[2]*w[2] - q[3]*w[1],
+            q[0]*w[1] - q[1]*w[2] + q[3]*w[0],
+            q[0]*w[2] + q[1]*w[1] - q[2]*w[0],
+        };
+        double n = 0;
+        for (uint8_t i=0; i<4; i++) {
+            q[i] += 0.5 * dt * dq[i];
+            n += q[i]*q[i];
+        }
+        for (double &x : q) {
+            x /= sqrt(n);
+        }
+    }
+
+    void euler_deg(double &heading, double &pitch, double &roll) const {
+        double R[3][3];
+        rotation(R);
+        heading = -atan2(R[1][0], R[0][0]) / DEG_TO_RAD_D;
+        if (heading < 0) {
+            heading += 360;
+        }
+        pitch = asin(R[2][0]) / DEG_TO_RAD_D;
+        roll = atan2(R[2][1], R[2][2]) / DEG_TO_RAD_D;
+    }
+
+private:
+    double q[4] { 1, 0, 0, 0 };
+    double integral[3] {};
+    bool initialised = false;
+
+    void rotation(double R[3][3]) const {
+        const double w = q[0], x = q[1], y = q[2], z = q[3];
+        const double r[3][3] {
+            { 1 - 2*(y*y + z*z), 2*(x*y - w*z), 2*(x*z + w*y) },
+            { 2*(x*y + w*z), 1 - 2*(x*x + z*z), 2*(y*z - w*x) },
+            { 2*(x*z - w*y), 2*(y*z + w*x), 1 - 2*(x*x + y*y) },
+        };
+        memcpy(R, r, sizeof(r));
+    }
+
+    // the traces start with a positive trace of the rotation
+    void init(const double A[3], const double M[3]) {
+        const double mu = M[0]*A[0] + M[1]*A[1] + M[2]*A[2];
+        double N[3] { M[0] - mu*A[0], M[1] - mu*A[1], M[2] - mu*A[2] };
+        const double nn = sqrt(N[0]*N[0] + N[1]*N[1] + N[2]*N[2]);
+        for (double &x : N) {
+            x /= nn;
+        }
+        const double W[3] { A[1]*N[2] - A[2]*N[1], A[2]*N[0] - A[0]*N[2], A[0]*N[1] - A[1]*N[0] };
+        const double s = 0.5 / sqrt(N[0] + W[1] + A[2] + 1);
+        q[0] = 0.25 / s;
+        q[1] = (A[1] - W[2]) * s;
+        q[2] = (N[2] - A[0]) * s;
+        q[3] = (W[0] - N[1]) * s;
+        initialised = true;
+    }
+};
+
+/*
+  10 minutes of each vessel: the float filter stays within 0.05
+  degrees of the reference, and within 1 degree RMS of the truth once
+  the gyro bias is learned
+ */
+static bool test_traces()
+{
+    for (const IMU_Trace_Config *c : { &imu_moored, &imu_underway_turning, &imu_rough }) {
+        const std::vector<IMU_Sample> trace = imu_trace(*c, 600);
+        AHRS ahrs(KP, KI);
+        Reference ref {};
+        double max_ref = 0, heading_sq = 0, attitude_sq = 0;
+        uint32_t n = 0;
+        for (const IMU_Sample &s : trace) {
+            ahrs.update(s.gyro, s.accel, s.mag, 1.0f / IMU_TRACE_RATE_HZ);
+            ref.update(s.gyro, s.accel, s.mag, 1.0 / IMU_TRACE_RATE_HZ);
+            float h, p, r;
+            ahrs.get_euler_deg(h, p, r);
+            double rh, rp, rr;
+            ref.euler_deg(rh, rp, rr);
+            max_ref = fmax(max_ref, fmax(fabs(wrap_180(h - rh)), fmax(fabs(p - rp), fabs(r - rr))));
+            if (s.t > 60) {
+                const double eh = wrap_180(h - s.heading), ep = p - s.pitch, er = r - s.roll;
+                heading_sq += eh*eh;
+                attitude_sq += ep*ep + er*er;
+                n++;
+            }
+        }
+        TEST_ASSERT(max_ref < 0.05, "float against the double reference");
+        TEST_ASSERT(sqrt(heading_sq / n) < 1, "heading RMS");
+        TEST_ASSERT(sqrt(attitude_sq / (2*n)) < 1, "pitch and roll RMS");
+    }
+    return true;
+}
+
+// a board at rest reads its attitude back, which checks the signs
+static bool test_static()
+{
+    const double field[3] { 0.2, 0, -0.4 };
+    const double attitudes[][3] {
+        { 0, 0, 0 }, { 90, 0, 0 }, { 200, 0, 0 }, { 30, 10, 0 }, { 30, 0, 15 }, { 300, -20, -25 },
+        // the other branches of the quaternion from the rotation
+        { 180, 0, 170 }, { 0, 60, 179 }, { 170, -10, 120 },
+    };
+    const float gyro[3] {};
+    for (const auto &a : attitudes) {
+        float accel[3], mag[3];
+        imu_static(a[0], a[1], a[2], field, accel, mag);
+        AHRS ahrs(KP, KI);
+        TEST_ASSERT(!ahrs.have_attitude(), "no attitude before a sample");
+        for (uint8_t i=0; i<100; i++) {
+            ahrs.update(gyro, accel, mag, 0.005f);
+        }
+        TEST_ASSERT(ahrs.have_attitude(), "attitude");
+        float h, p, r;
+        ahrs.get_euler_deg(h, p, r);
+        TEST_ASSERT_FLOAT_EQUAL(0, wrap_180(h - a[0]), 0.05, "heading");
+        TEST_ASSERT_FLOAT_EQUAL(a[1], p, 0.05, "pitch");
+        TEST_ASSERT_FLOAT_EQUAL(0, wrap_180(r - a[2]), 0.05, "roll");
+    }
+    return true;
+}
+
+/*
+  without a mag sample the filter starts bow north and keeps the
+  heading it has while levelling on the accel
+ */
+static bool test_no_mag()
+{
+    const double field[3] { 0.2, 0, -0.4 };
+    const float gyro[3] {}, none[3] {};
+    float accel[3], mag[3];
+    AHRS ahrs(KP, KI);
+    imu_static(0, 5, -8, field, accel, mag);
+    ahrs.update(gyro, accel, none, 0.005f);
+    float h, p, r;
+    ahrs.get_euler_deg(h, p, r);
+    TEST_ASSERT_FLOAT_EQUAL(0, wrap_180(h), 0.05, "bow north");
+    TEST_ASSERT_FLOAT_EQUAL(5, p, 0.05, "pitch");
+    TEST_ASSERT_FLOAT_EQUAL(-8, r, 0.05, "roll");
+
+    ahrs.reset();
+    TEST_ASSERT(!ahrs.have_attitude(), "reset");
+    imu_static(120, 0, 0, field, accel, mag);
+    ahrs.update(gyro, accel, mag, 0.005f);
+    imu_static(120, 10, 0, field, accel, mag);
+    for (uint16_t i=0; i<12000; i++) {
+        ahrs.update(gyro, accel, none, 0.005f);
+    }
+    ahrs.get_euler_deg(h, p, r);
+    TEST_ASSERT_FLOAT_EQUAL(120, h, 0.5, "heading held");
+    TEST_ASSERT_FLOAT_EQUAL(10, p, 0.05, "levelled on the accel");
+    return true;
+}
+
+int main(void)
+{
+    TEST_RUN(test_traces);
+    TEST_RUN(test_static);
+    TEST_RUN(test_no_mag);
+    return test_result();
+}
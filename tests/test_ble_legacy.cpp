@@ -0,0 +1,212 @@
+/*
+  BLE legacy advertising rotation: the slot sequence of the smooth
+  weighted round robin, and the freshness override
+ */
+
+#include "test.h"
+#include "BLE_TX.h"
+#include "parameters.h"
+#include "fake_ble_backend.h"
+
+static ODID_UAS_Data uas;
+static ODID_Snapshot snapshot;
+
+// all six messages valid, the two BasicIDs told apart by their UAS ID
+static void fill_uas(void)
+{
+    odid_initUasData(&uas);
+    uas.BasicID[0].UAType = ODID_UATYPE_OTHER;
+    uas.BasicID[0].IDType = ODID_IDTYPE_SERIAL_NUMBER;
+    strcpy(uas.BasicID[0].UASID, "BOAT1");
+    uas.BasicID[1] = uas.BasicID[0];
+    strcpy(uas.BasicID[1].UASID, "BOAT2");
+    uas.BasicIDValid[0] = 1;
+    uas.BasicIDValid[1] = 1;
+    uas.Location.TimeStamp = 0;
+    uas.LocationValid = 1;
+    strcpy(uas.SelfID.Desc, "survey");
+    uas.SelfIDValid = 1;
+    uas.SystemValid = 1;
+    strcpy(uas.OperatorID.OperatorId, "OP1");
+    uas.OperatorIDValid = 1;
+    snapshot.mark_dirty(ODID_Snapshot::ALL_SLOTS);
+    snapshot.update(uas);
+}
+
+/*
+  entry of a legacy advertisement: L location, B and b the first and
+  second BasicID, S self ID, Y system, O operator ID, N the name
+ */
+static char entry_of(const std::vector<uint8_t> &d)
+{
+    if (d.size() > 2 && d[0] == 0x02 && d[1] == 0x01) {
+        return 'N';
+    }
+    switch (d[6] >> 4) {
+    case ODID_MESSAGETYPE_BASIC_ID:
+        return d[12] == '2' ? 'b' : 'B';
+    case ODID_MESSAGETYPE_LOCATION:
+        return 'L';
+    case ODID_MESSAGETYPE_SELF_ID:
+        return 'S';
+    case ODID_MESSAGETYPE_SYSTEM:
+        return 'Y';
+    case ODID_MESSAGETYPE_OPERATOR_ID:
+        return 'O';
+    }
+    return '?';
+}
+
+// n legacy slots, the Location timestamp moving each tick as in flight
+static std::string run_slots(BLE_TX &ble, Fake_BLE_Backend &backend, uint32_t n)
+{
+    std::string seq;
+    for (uint32_t i=0; i<n; i++) {
+        uas.Location.TimeStamp = fmodf(uas.Location.TimeStamp + 0.1f, 3600);
+        snapshot.mark_dirty(ODID_Snapshot::slot_bit(ODID_Snapshot::Slot::LOCATION));
+        snapshot.update(uas);
+        if (!ble.transmit_legacy(snapshot)) {
+            return seq + '!';
+        }
+        seq += entry_of(backend.state(BLE_Backend::Set::LEGACY).data);
+    }
+    return seq;
+}
+
+static uint32_t count(const std::string &seq, char e)
+{
+    return std::count(seq.begin(), seq.end(), e);
+}
+
+// most slots between two sends of an entry
+static uint32_t max_gap(const std::string &seq, char e)
+{
+    uint32_t gap = 0;
+    size_t last = seq.find(e);
+    for (size_t i=last+1; i<seq.size(); i++) {
+        if (seq[i] == e) {
+            gap = std::max(gap, uint32_t(i - last));
+            last = i;
+        }
+    }
+    return gap;
+}
+
+/*
+  BT4_LOC_WEIGHT 5: a rotation of 11 slots with Location in 5 of them
+  spread evenly, every other entry once
+ */
+static bool test_weighted_rotation()
+{
+    static Fake_BLE_Backend backend;
+    static BLE_TX ble(backend);
+    g.bt4_loc_weight = 5;
+    fill_uas();
+    TEST_ASSERT_EQUAL(11, ble.legacy_states(snapshot), "rotation length");
+
+    // new content goes first: each message once in the first slots
+    const std::string first = run_slots(ble, backend, 6);
+    for (const char e : std::string("LBbSYO")) {
+        TEST_ASSERT_EQUAL(1, count(first, e), "every message in the first slots");
+    }
+
+    run_slots(ble, backend, 16);
+    const std::string seq = run_slots(ble, backend, 110);
+    for (size_t i=0; i+11<seq.size(); i++) {
+        TEST_ASSERT_EQUAL(seq[i], seq[i+11], "rotation repeats every 11 slots");
+    }
+    const std::string rotation = seq.substr(0, 11);
+    TEST_ASSERT_EQUAL(5, count(rotation, 'L'), "Location slots");
+    for (const char e : std::string("BbSYON")) {
+        TEST_ASSERT_EQUAL(1, count(rotation, e), "one slot each");
+        TEST_ASSERT_EQUAL(11, max_gap(seq, e), "refreshed every rotation");
+    }
+    // 5 of 11 slots never bunch up
+    TEST_ASSERT(max_gap(seq, 'L') <= 3, "Location refreshed every 3 slots");
+    TEST_ASSERT(seq.find("LLL") == std::string::npos, "Location spread out");
+    return true;
+}
+
+/*
+  BT4_LOC_WEIGHT 1 is plain round robin. Location changes at every
+  send, so it never counts as fresh and keeps to its one slot
+ */
+static bool test_round_robin()
+{
+    static Fake_BLE_Backend backend;
+    static BLE_TX ble(backend);
+    g.bt4_loc_weight = 1;
+    fill_uas();
+    TEST_ASSERT_EQUAL(7, ble.legacy_states(snapshot), "rotation length");
+    run_slots(ble, backend, 14);
+    const std::string seq = run_slots(ble, backend, 70);
+    for (const char e : std::string("LBbSYON")) {
+        TEST_ASSERT_EQUAL(10, count(seq, e), "one slot per rotation");
+        TEST_ASSERT_EQUAL(7, max_gap(seq, e), "every 7 slots");
+    }
+    return true;
+}
+
+/*
+  a message whose content changes after being stable goes out in the
+  next slot, then the rotation carries on at its weights
+ */
+static bool test_freshness_override()
+{
+    static Fake_BLE_Backend backend;
+    static BLE_TX ble(backend);
+    g.bt4_loc_weight = 5;
+    fill_uas();
+    run_slots(ble, backend, 33);
+
+    for (uint32_t offset=0; offset<11; offset++) {
+        strcpy(uas.OperatorID.OperatorId, offset % 2 ? "OP1" : "OP2");
+        snapshot.mark_dirty(ODID_Snapshot::slot_bit(ODID_Snapshot::Slot::OPERATOR_ID));
+        TEST_ASSERT_STRING_EQUAL("O", run_slots(ble, backend, 1).c_str(), "new operator ID next");
+        // stable again after its next regular slot, and the next change
+        // lands elsewhere in the rotation
+        run_slots(ble, backend, 22 + offset);
+    }
+
+    // two changes at once both go ahead of the rotation
+    uas.System.AreaCount = 2;
+    strcpy(uas.SelfID.Desc, "transit");
+    snapshot.mark_dirty(ODID_Snapshot::slot_bit(ODID_Snapshot::Slot::SYSTEM) |
+                        ODID_Snapshot::slot_bit(ODID_Snapshot::Slot::SELF_ID));
+    const std::string next = run_slots(ble, backend, 2);
+    TEST_ASSERT(next == "SY" || next == "YS", "System and SelfID next");
+
+    const std::string seq = run_slots(ble, backend, 110);
+    TEST_ASSERT(count(seq, 'L') >= 49 && count(seq, 'L') <= 51, "Location keeps its weight");
+    for (const char e : std::string("BbSYON")) {
+        TEST_ASSERT(count(seq, e) >= 9 && count(seq, e) <= 11, "others keep theirs");
+    }
+    return true;
+}
+
+// a message that isn't valid has no slots
+static bool test_invalid_message()
+{
+    static Fake_BLE_Backend backend;
+    static BLE_TX ble(backend);
+    g.bt4_loc_weight = 5;
+    fill_uas();
+    run_slots(ble, backend, 22);
+    uas.BasicIDValid[1] = 0;
+    snapshot.mark_dirty(ODID_Snapshot::slot_bit(ODID_Snapshot::Slot::BASIC_ID_2));
+    snapshot.update(uas);
+    TEST_ASSERT_EQUAL(10, ble.legacy_states(snapshot), "rotation length");
+    const std::string seq = run_slots(ble, backend, 100);
+    TEST_ASSERT_EQUAL(0, count(seq, 'b'), "no slot for the second BasicID");
+    TEST_ASSERT_EQUAL(50, count(seq, 'L'), "Location slots");
+    return true;
+}
+
+int main(void)
+{
+    TEST_RUN(test_weighted_rotation);
+    TEST_RUN(test_round_robin);
+    TEST_RUN(test_freshness_override);
+    TEST_RUN(test_invalid_message);
+    return test_result();
+}
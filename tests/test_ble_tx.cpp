@@ -0,0 +1,221 @@
+/*
+  BLE_TX payloads and advertising set setup on a fake GAP, and the
+  ESP-IDF backend's double buffered data updates on the shim GAP
+ */
+
+#include "test.h"
+#include "BLE_TX.h"
+#include "parameters.h"
+#include "fake_ble_backend.h"
+#include <esp_bt.h>
+
+static ODID_UAS_Data uas;
+static ODID_Snapshot snapshot;
+
+// BasicID, Location and System valid
+static void fill_uas(void)
+{
+    odid_initUasData(&uas);
+    uas.BasicID[0].UAType = ODID_UATYPE_OTHER;
+    uas.BasicID[0].IDType = ODID_IDTYPE_SERIAL_NUMBER;
+    strcpy(uas.BasicID[0].UASID, "BOAT1234");
+    uas.BasicIDValid[0] = 1;
+    uas.LocationValid = 1;
+    uas.SystemValid = 1;
+    snapshot.mark_dirty(ODID_Snapshot::ALL_SLOTS);
+    snapshot.update(uas);
+}
+
+static void set_params(void)
+{
+    g.bt4_rate = 1;
+    g.bt4_power = 10;
+    g.bt4_loc_weight = 5;
+    g.bt5_rate = 1;
+    g.bt5_power = -30;
+}
+
+/*
+  the intervals cover one update per slot: 11 legacy slots a second at
+  BT4_LOC_WEIGHT 5, one long range pack a second. Power rounds down to
+  a controller level and is limited to its range
+ */
+static bool test_config()
+{
+    static Fake_BLE_Backend backend;
+    static BLE_TX ble(backend);
+    set_params();
+    TEST_ASSERT(ble.init(), "init");
+    TEST_ASSERT(backend.initialised, "backend up");
+    TEST_ASSERT_EQUAL(0xc0, backend.mac[0] & 0xc0, "random static address");
+
+    const auto &legacy = backend.state(BLE_Backend::Set::LEGACY).config;
+    TEST_ASSERT_EQUAL(1000 / 11 * 8 / 5, legacy.interval_max, "legacy interval");
+    TEST_ASSERT_EQUAL(legacy.interval_max * 3 / 4, legacy.interval_min, "legacy interval");
+    TEST_ASSERT_EQUAL(10, legacy.tx_power_dBm, "legacy dBm");
+    TEST_ASSERT_EQUAL(ESP_PWR_LVL_P9, legacy.power_level, "rounded down");
+
+    const auto &longrange = backend.state(BLE_Backend::Set::LONGRANGE).config;
+    TEST_ASSERT_EQUAL(1600, longrange.interval_max, "1s");
+    TEST_ASSERT_EQUAL(1200, longrange.interval_min, "0.75s");
+    TEST_ASSERT_EQUAL(-24, longrange.tx_power_dBm, "lowest dBm");
+    TEST_ASSERT_EQUAL(ESP_PWR_LVL_N24, longrange.power_level, "lowest level");
+
+    // no set advertises before it has data
+    TEST_ASSERT(!backend.state(BLE_Backend::Set::LEGACY).started, "legacy not started");
+    TEST_ASSERT(!backend.state(BLE_Backend::Set::LONGRANGE).started, "longrange not started");
+    return true;
+}
+
+/*
+  legacy advertisements: the ASTM service data header, the counter of
+  the message type, then the encoded message. The name advertisement
+  ends in the last four characters of the UAS ID
+ */
+static bool test_legacy_payload()
+{
+    static Fake_BLE_Backend backend;
+    static BLE_TX ble(backend);
+    set_params();
+    fill_uas();
+    const auto &s = backend.state(BLE_Backend::Set::LEGACY);
+    const uint8_t header[] { 0x1e, 0x16, 0xfa, 0xff, 0x0d };
+
+    uint8_t counter[16] {};
+    bool name = false;
+    for (uint32_t i=0; i<2*ble.legacy_states(snapshot); i++) {
+        TEST_ASSERT(ble.transmit_legacy(snapshot), "sent");
+        TEST_ASSERT(s.started, "started with its first data");
+        TEST_ASSERT_EQUAL(i + 1, s.data_sets, "one update per slot");
+        const std::vector<uint8_t> &d = s.data;
+        if (d[0] == 0x02) {
+            const char expected[] = "\x02\x01\x06\x12\x08" "ArduRemoteID_1234";
+            TEST_ASSERT_EQUAL(sizeof(expected), d.size(), "name length");
+            TEST_ASSERT_BYTES_EQUAL(expected, d.data(), sizeof(expected), "name");
+            name = true;
+            continue;
+        }
+        TEST_ASSERT_EQUAL(31, d.size(), "legacy length");
+        TEST_ASSERT_BYTES_EQUAL(header, d.data(), sizeof(header), "header");
+        const uint8_t type = d[6] >> 4;
+        ODID_Snapshot::Slot slot;
+        switch (type) {
+        case ODID_MESSAGETYPE_BASIC_ID:
+            slot = ODID_Snapshot::Slot::BASIC_ID;
+            break;
+        case ODID_MESSAGETYPE_LOCATION:
+            slot = ODID_Snapshot::Slot::LOCATION;
+            break;
+        case ODID_MESSAGETYPE_SYSTEM:
+            slot = ODID_Snapshot::Slot::SYSTEM;
+            break;
+        default:
+            TEST_ASSERT(false, "only valid messages");
+        }
+        TEST_ASSERT_EQUAL(counter[type]++, d[5], "counter per message type");
+        TEST_ASSERT_BYTES_EQUAL(snapshot.get_message(slot), &d[6], ODID_MESSAGE_SIZE, "message");
+    }
+    TEST_ASSERT(name, "name sent");
+    TEST_ASSERT(counter[ODID_MESSAGETYPE_LOCATION] > counter[ODID_MESSAGETYPE_BASIC_ID], "Location weighted");
+    TEST_ASSERT_EQUAL(0, backend.state(BLE_Backend::Set::LONGRANGE).data_sets, "longrange untouched");
+    return true;
+}
+
+// the long range pack behind its header and counter
+static bool test_longrange_payload()
+{
+    static Fake_BLE_Backend backend;
+    static BLE_TX ble(backend);
+    set_params();
+    fill_uas();
+    const auto &s = backend.state(BLE_Backend::Set::LONGRANGE);
+    const uint8_t len = snapshot.get_pack_length();
+    TEST_ASSERT(len > 0, "pack");
+    for (uint8_t i=0; i<3; i++) {
+        TEST_ASSERT(ble.transmit_longrange(snapshot), "sent");
+        const uint8_t header[] { uint8_t(len + 5), 0x16, 0xfa, 0xff, 0x0d, i };
+        TEST_ASSERT_EQUAL(sizeof(header) + len, s.data.size(), "length");
+        TEST_ASSERT_BYTES_EQUAL(header, s.data.data(), sizeof(header), "header and counter");
+        TEST_ASSERT_BYTES_EQUAL(snapshot.get_pack(), &s.data[sizeof(header)], len, "pack");
+    }
+    TEST_ASSERT(s.started, "started");
+    return true;
+}
+
+// data the GAP refuses is reported, and the set waits for data it took
+static bool test_data_refused()
+{
+    static Fake_BLE_Backend backend;
+    static BLE_TX ble(backend);
+    set_params();
+    fill_uas();
+    backend.fail_data = true;
+    TEST_ASSERT(!ble.transmit_longrange(snapshot), "refused");
+    TEST_ASSERT(!backend.state(BLE_Backend::Set::LONGRANGE).started, "not started");
+    backend.fail_data = false;
+    TEST_ASSERT(ble.transmit_longrange(snapshot), "taken");
+    TEST_ASSERT(backend.state(BLE_Backend::Set::LONGRANGE).started, "started");
+
+    // no pack, nothing to send
+    ODID_Snapshot empty;
+    TEST_ASSERT(!ble.transmit_longrange(empty), "empty pack");
+    return true;
+}
+
+/*
+  the ESP-IDF backend on the shim GAP: one data update in flight per
+  set, the newest data waiting behind it, and the set never stopped
+ */
+static bool test_esp_backend()
+{
+    BLE_Backend &backend = ble_backend_esp();
+    const uint8_t mac[6] { 0xc1, 2, 3, 4, 5, 6 };
+    TEST_ASSERT(backend.init(mac), "init");
+    const BLE_Backend::SetConfig config { 0x20, 0x20, 0, ESP_PWR_LVL_N0 };
+    TEST_ASSERT(backend.configure(BLE_Backend::Set::LONGRANGE, config), "configure");
+
+    const uint8_t a[] { 1, 2, 3 };
+    const uint8_t b[] { 4, 5 };
+    const uint8_t c[] { 6, 7, 8, 9 };
+    host_radio.ble_defer_events = true;
+    const uint32_t sets = host_radio.ble_adv_data_sets[1];
+    TEST_ASSERT(backend.set_data(BLE_Backend::Set::LONGRANGE, a, sizeof(a)), "first data");
+    TEST_ASSERT(backend.start(BLE_Backend::Set::LONGRANGE), "start");
+    TEST_ASSERT(host_radio.ble_started[1], "advertising");
+    TEST_ASSERT_EQUAL(sets + 1, host_radio.ble_adv_data_sets[1], "first update in flight");
+
+    // while it is in flight, the newest data replaces the waiting data
+    TEST_ASSERT(backend.set_data(BLE_Backend::Set::LONGRANGE, b, sizeof(b)), "queued");
+    TEST_ASSERT(backend.set_data(BLE_Backend::Set::LONGRANGE, c, sizeof(c)), "replaced");
+    TEST_ASSERT_EQUAL(sets + 1, host_radio.ble_adv_data_sets[1], "one update in flight");
+    TEST_ASSERT_BYTES_EQUAL(a, host_radio.ble_adv_data[1].data(), sizeof(a), "first data on air");
+
+    // its completion sends the newest data, whose own completion ends it
+    host_ble_events();
+    TEST_ASSERT_EQUAL(sets + 2, host_radio.ble_adv_data_sets[1], "waiting data sent");
+    TEST_ASSERT_EQUAL(sizeof(c), host_radio.ble_adv_data[1].size(), "newest data");
+    TEST_ASSERT_BYTES_EQUAL(c, host_radio.ble_adv_data[1].data(), sizeof(c), "newest data");
+    host_ble_events();
+    TEST_ASSERT_EQUAL(sets + 2, host_radio.ble_adv_data_sets[1], "nothing waiting");
+
+    // idle again, the next data goes straight out
+    TEST_ASSERT(backend.set_data(BLE_Backend::Set::LONGRANGE, b, sizeof(b)), "data");
+    TEST_ASSERT_EQUAL(sets + 3, host_radio.ble_adv_data_sets[1], "sent at once");
+    TEST_ASSERT(host_radio.ble_started[1], "never stopped");
+    host_radio.ble_defer_events = false;
+    host_ble_events();
+
+    // the other set's buffers are its own
+    TEST_ASSERT_EQUAL(0, host_radio.ble_adv_data_sets[0], "legacy untouched");
+    return true;
+}
+
+int main(void)
+{
+    TEST_RUN(test_config);
+    TEST_RUN(test_legacy_payload);
+    TEST_RUN(test_longrange_payload);
+    TEST_RUN(test_data_refused);
+    TEST_RUN(test_esp_backend);
+    return test_result();
+}
@@ -0,0 +1,186 @@
+/*
+  BME280 driver on the fake I2C bus, and its integer compensation
+  against the double precision formulas of the Bosch datasheet
+ */
+
+#include "test.h"
+#include "bme280.h"
+#include "sensor_images.h"
+
+static I2C_Bus bus(Wire);
+static BME280 bme(bus, BME280_ADDR);
+
+// datasheet section 8.1, floating point compensation
+static void reference(const BME280_Trim &c, int32_t adc_P, int32_t adc_T, int32_t adc_H,
+                      double &T, double &P, double &H)
+{
+    double v1 = (adc_T/16384.0 - c.T1/1024.0) * c.T2;
+    double v2 = (adc_T/131072.0 - c.T1/8192.0) * (adc_T/131072.0 - c.T1/8192.0) * c.T3;
+    const double t_fine = v1 + v2;
+    T = t_fine / 5120.0;
+
+    v1 = t_fine/2.0 - 64000.0;
+    v2 = v1 * v1 * c.P6 / 32768.0;
+    v2 = v2 + v1 * c.P5 * 2.0;
+    v2 = v2/4.0 + c.P4 * 65536.0;
+    v1 = (c.P3 * v1 * v1 / 524288.0 + c.P2 * v1) / 524288.0;
+    v1 = (1.0 + v1/32768.0) * c.P1;
+    double p = 1048576.0 - adc_P;
+    p = (p - v2/4096.0) * 6250.0 / v1;
+    v1 = c.P9 * p * p / 2147483648.0;
+    v2 = p * c.P8 / 32768.0;
+    P = p + (v1 + v2 + c.P7) / 16.0;
+
+    double h = t_fine - 76800.0;
+    h = (adc_H - (c.H4 * 64.0 + c.H5 / 16384.0 * h)) *
+        (c.H2 / 65536.0 * (1.0 + c.H6 / 67108864.0 * h * (1.0 + c.H3 / 67108864.0 * h)));
+    h = h * (1.0 - c.H1 * h / 524288.0);
+    H = constrain(h, 0.0, 100.0);
+}
+
+static void calibration(const BME280_Trim &trim, BME280::Calibration &cal)
+{
+    static Fake_Chip chip;
+    bme280_image(chip, trim);
+    BME280::parse_calibration(&chip.regs[0x88], &chip.regs[0xE1], cal);
+}
+
+// the 12 bit H4 and H5 share a register, and negative values sign extend
+static bool test_parse_calibration()
+{
+    BME280_Trim trim;
+    BME280::Calibration cal;
+    calibration(trim, cal);
+    TEST_ASSERT_EQUAL(trim.T1, cal.T1, "T1");
+    TEST_ASSERT_EQUAL(trim.T3, cal.T3, "T3");
+    TEST_ASSERT_EQUAL(trim.P8, cal.P8, "P8");
+    TEST_ASSERT_EQUAL(trim.P9, cal.P9, "P9");
+    TEST_ASSERT_EQUAL(trim.H1, cal.H1, "H1");
+    TEST_ASSERT_EQUAL(trim.H2, cal.H2, "H2");
+    TEST_ASSERT_EQUAL(trim.H4, cal.H4, "H4");
+    TEST_ASSERT_EQUAL(trim.H5, cal.H5, "H5");
+    TEST_ASSERT_EQUAL(trim.H6, cal.H6, "H6");
+
+    trim.H4 = -300;
+    trim.H5 = -45;
+    trim.H6 = -20;
+    calibration(trim, cal);
+    TEST_ASSERT_EQUAL(-300, cal.H4, "negative H4");
+    TEST_ASSERT_EQUAL(-45, cal.H5, "negative H5");
+    TEST_ASSERT_EQUAL(-20, cal.H6, "negative H6");
+    return true;
+}
+
+// over the sensor range, within the resolution of the integer formats
+static bool test_compensate_reference()
+{
+    const BME280_Trim trim;
+    BME280::Calibration cal;
+    calibration(trim, cal);
+
+    double max_t = 0, max_p = 0, max_h = 0;
+    for (int32_t adc_T = 380000; adc_T <= 640000; adc_T += 6500) {
+        for (int32_t adc_P = 250000; adc_P <= 500000; adc_P += 12500) {
+            for (int32_t adc_H = 20000; adc_H <= 40000; adc_H += 2500) {
+                uint8_t raw[8];
+                bme280_raw(raw, adc_P, adc_T, adc_H);
+                BME280::Sample s;
+                TEST_ASSERT(BME280::compensate(cal, raw, s), "compensate");
+                double T, P, H;
+                reference(trim, adc_P, adc_T, adc_H, T, P, H);
+                if (P < 30000 || P > 110000) {
+                    // outside the rated range
+                    continue;
+                }
+                max_t = fmax(max_t, fabs(s.temperature_cdeg / 100.0 - T));
+                max_p = fmax(max_p, fabs(s.pressure_q24_8 / 256.0 - P));
+                max_h = fmax(max_h, fabs(s.humidity_q22_10 / 1024.0 - H));
+            }
+        }
+    }
+    TEST_ASSERT(max_t <= 0.01, "temperature within 0.01 degC");
+    TEST_ASSERT(max_p < 1.0, "pressure within 1 Pa");
+    TEST_ASSERT(max_h < 0.05, "humidity within 0.05 %RH");
+    return true;
+}
+
+static bool test_compensate_datasheet()
+{
+    BME280::Calibration cal;
+    calibration(BME280_Trim(), cal);
+    uint8_t raw[8];
+    BME280::Sample s;
+    bme280_raw(raw, 415148, 519888, 30000);
+    TEST_ASSERT(BME280::compensate(cal, raw, s), "compensate");
+    TEST_ASSERT_EQUAL(2508, s.temperature_cdeg, "temperature");
+    TEST_ASSERT_FLOAT_EQUAL(100653.27, s.pressure_q24_8 / 256.0, 1, "pressure");
+
+    // a skipped measurement reads 0x80000
+    bme280_raw(raw, 0x80000, 0x80000, 0x8000);
+    TEST_ASSERT(!BME280::compensate(cal, raw, s), "skipped measurement");
+    return true;
+}
+
+static bool test_driver()
+{
+    Fake_Chip &chip = Wire.chips[BME280_ADDR];
+    bme280_image(chip);
+    bme280_raw(&chip.regs[0xF7], 415148, 519888, 30000);
+
+    bme.init();
+    TEST_ASSERT(!bme.healthy(), "not healthy before the probe");
+    BME280::Sample s;
+    TEST_ASSERT(!bme.get_sample(s), "no sample yet");
+    bus.run();
+    TEST_ASSERT(bme.healthy(), "healthy after the probe and calibration");
+    TEST_ASSERT_EQUAL(0x01, chip.regs[0xF2], "ctrl_hum");
+    TEST_ASSERT_EQUAL(0xA0, chip.regs[0xF5], "config");
+    TEST_ASSERT_EQUAL(0x27, chip.regs[0xF4], "ctrl_meas");
+
+    // one read in flight at a time
+    const uint32_t reads = chip.reads;
+    bme.update();
+    bme.update();
+    bus.run();
+    TEST_ASSERT_EQUAL(reads + 1, chip.reads, "one data read");
+    TEST_ASSERT(bme.get_sample(s), "sample");
+    TEST_ASSERT_EQUAL(2508, s.temperature_cdeg, "temperature");
+    TEST_ASSERT_FLOAT_EQUAL(100653.27, s.pressure_q24_8 / 256.0, 1, "pressure");
+    TEST_ASSERT_EQUAL(millis(), s.timestamp_ms, "timestamp");
+
+    // a skipped measurement keeps the last sample
+    bme280_raw(&chip.regs[0xF7], 0x80000, 0x80000, 0x8000);
+    bme.update();
+    bus.run();
+    TEST_ASSERT(bme.get_sample(s), "sample kept");
+    TEST_ASSERT_EQUAL(2508, s.temperature_cdeg, "temperature kept");
+    return true;
+}
+
+static bool test_absent()
+{
+    static I2C_Bus other_bus(Wire);
+    static BME280 missing(other_bus, 0x77);
+    static BME280 wrong_id(other_bus, 0x40);
+    Wire.chips[0x40].regs[0xD0] = 0x58;   // a BMP280
+    missing.init();
+    wrong_id.init();
+    other_bus.run();
+    TEST_ASSERT(!missing.healthy(), "no chip");
+    TEST_ASSERT(!wrong_id.healthy(), "wrong chip id");
+    TEST_ASSERT_EQUAL(1, other_bus.get_errors(), "one failed probe");
+    missing.update();
+    other_bus.run();
+    TEST_ASSERT_EQUAL(1, other_bus.get_errors(), "no reads of an absent chip");
+    return true;
+}
+
+int main(void)
+{
+    TEST_RUN(test_parse_calibration);
+    TEST_RUN(test_compensate_reference);
+    TEST_RUN(test_compensate_datasheet);
+    TEST_RUN(test_driver);
+    TEST_RUN(test_absent);
+    return test_result();
+}
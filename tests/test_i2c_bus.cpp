@@ -0,0 +1,141 @@
+/*
+  asynchronous I2C transaction queue on the fake bus
+ */
+
+#include "test.h"
+#include "i2c_bus.h"
+#include "sensor_images.h"
+#include <vector>
+
+// records each completed transfer
+class Test_Device : public I2C_Device {
+public:
+    using I2C_Device::I2C_Device;
+
+    struct Done {
+        uint8_t tag;
+        bool ok;
+        std::vector<uint8_t> data;
+    };
+    std::vector<Done> done;
+
+    bool read(uint8_t reg, uint8_t len, uint8_t tag) {
+        return read_registers(reg, len, tag);
+    }
+    bool write(uint8_t reg, uint8_t value, uint8_t tag) {
+        return write_register(reg, value, tag);
+    }
+
+private:
+    void transfer_done(uint8_t tag, bool ok, const uint8_t *data, uint8_t len) override {
+        done.push_back({tag, ok, std::vector<uint8_t>(data, data+len)});
+    }
+};
+
+static I2C_Bus bus(Wire);
+static Test_Device dev(bus, 0x50);
+static Test_Device missing(bus, 0x51);
+
+// nothing happens on the bus until the bus task runs, then in order
+static bool test_order()
+{
+    Fake_Chip &chip = Wire.chips[0x50];
+    for (int i=0; i<256; i++) {
+        chip.regs[i] = i ^ 0xA5;
+    }
+    dev.done.clear();
+    const uint32_t transactions = Wire.transactions;
+    TEST_ASSERT(dev.write(0x10, 0x42, 1), "queue write");
+    TEST_ASSERT(dev.read(0x10, 3, 2), "queue read");
+    TEST_ASSERT(dev.read(0x80, I2C_MAX_READ, 3), "queue longest read");
+    TEST_ASSERT_EQUAL(transactions, Wire.transactions, "no bus traffic before run");
+    TEST_ASSERT_EQUAL(0, dev.done.size(), "nothing done before run");
+
+    bus.run();
+    TEST_ASSERT_EQUAL(3, dev.done.size(), "all done");
+    TEST_ASSERT_EQUAL(1, dev.done[0].tag, "write first");
+    TEST_ASSERT(dev.done[0].ok && dev.done[0].data.empty(), "write has no data");
+    TEST_ASSERT_EQUAL(2, dev.done[1].tag, "then the read");
+    TEST_ASSERT_EQUAL(3, dev.done[1].data.size(), "read length");
+    // the read sees the write queued before it
+    TEST_ASSERT_EQUAL(0x42, dev.done[1].data[0], "written value");
+    TEST_ASSERT_EQUAL(0x11 ^ 0xA5, dev.done[1].data[1], "burst read");
+    TEST_ASSERT_EQUAL(I2C_MAX_READ, dev.done[2].data.size(), "longest read");
+    TEST_ASSERT_EQUAL(0xFF ^ 0xA5, dev.done[2].data[0x7F], "last byte of the longest read");
+    return true;
+}
+
+static bool test_limits()
+{
+    TEST_ASSERT(!dev.read(0, I2C_MAX_READ + 1, 0), "read longer than the Wire buffer refused");
+    return true;
+}
+
+// a missing chip fails its transfers without holding up the others
+static bool test_missing()
+{
+    dev.done.clear();
+    missing.done.clear();
+    const uint32_t errors = bus.get_errors();
+    missing.read(0x00, 2, 7);
+    dev.read(0x00, 1, 8);
+    bus.run();
+    TEST_ASSERT_EQUAL(1, missing.done.size(), "missing chip completes");
+    TEST_ASSERT(!missing.done[0].ok && missing.done[0].data.empty(), "failed with no data");
+    TEST_ASSERT(dev.done.size() == 1 && dev.done[0].ok, "other chip unaffected");
+    TEST_ASSERT_EQUAL(errors + 1, bus.get_errors(), "error counted");
+    return true;
+}
+
+// a full queue refuses and counts, it never blocks
+static bool test_full()
+{
+    const uint32_t dropped = bus.get_dropped();
+    uint32_t queued = 0;
+    for (int i=0; i<40; i++) {
+        queued += dev.read(0, 1, 0);
+    }
+    TEST_ASSERT_EQUAL(32, queued, "queue length");
+    TEST_ASSERT_EQUAL(dropped + 8, bus.get_dropped(), "dropped");
+    bus.run();
+    TEST_ASSERT(dev.read(0, 1, 0), "room again after run");
+    bus.run();
+    return true;
+}
+
+// busy time, rate and latency over each full second
+static bool test_stats()
+{
+    // start a window
+    bus.run();
+    host_advance_us(1000000);
+    bus.run();
+    const uint64_t start_us = host_time_us();
+    for (int tick=0; tick<10; tick++) {
+        dev.read(0, 8, 0);
+        // queued 1ms before the bus task gets to it
+        host_advance_us(1000);
+        bus.run();
+        host_advance_us(90000);
+    }
+    host_set_time_us(start_us + 1000000);
+    bus.run();
+    TEST_ASSERT_EQUAL(10, bus.get_transfers_per_second(), "transfers per second");
+    // address, register, address, 8 bytes and the stops: 12.5 bytes
+    const uint32_t transfer_us = 2*TwoWire::BYTE_US + TwoWire::BYTE_US + (8 + 1)*TwoWire::BYTE_US + TwoWire::BYTE_US/2;
+    TEST_ASSERT_EQUAL(1000 + transfer_us, bus.get_latency_avg_us(), "latency");
+    TEST_ASSERT_EQUAL(1000 + transfer_us, bus.get_latency_max_us(), "latency max");
+    TEST_ASSERT_FLOAT_EQUAL(10 * transfer_us / 1e4, bus.get_busy_percent(), 0.01, "busy");
+    TEST_ASSERT(dev.get_busy_us() >= 10 * transfer_us, "busy time per device");
+    return true;
+}
+
+int main(void)
+{
+    TEST_RUN(test_order);
+    TEST_RUN(test_limits);
+    TEST_RUN(test_missing);
+    TEST_RUN(test_full);
+    TEST_RUN(test_stats);
+    return test_result();
+}
@@ -0,0 +1,82 @@
+/*
+  LIS3MDL driver on the fake I2C bus
+ */
+
+#include "test.h"
+#include "lis3mdl.h"
+#include "sensor_images.h"
+
+static I2C_Bus bus(Wire);
+static LIS3MDL mag(bus, LIS3MDL_ADDR);
+
+static bool test_decode()
+{
+    uint8_t raw[6];
+    put_le16(&raw[0], 6842);
+    put_le16(&raw[2], -6842);
+    put_le16(&raw[4], 0);
+    LIS3MDL::Sample s;
+    LIS3MDL::decode(raw, s);
+    TEST_ASSERT_FLOAT_EQUAL(1.0, s.mag[0], 1e-6, "x, 6842 LSB/gauss at +-4 gauss");
+    TEST_ASSERT_FLOAT_EQUAL(-1.0, s.mag[1], 1e-6, "y");
+    TEST_ASSERT_FLOAT_EQUAL(0, s.mag[2], 1e-6, "z");
+    return true;
+}
+
+static bool test_driver()
+{
+    const int16_t field[3] { 6842/2, -6842/4, 6842 };
+    Fake_Chip &chip = Wire.chips[LIS3MDL_ADDR];
+    lis3mdl_image(chip, field);
+
+    mag.init();
+    bus.run();
+    TEST_ASSERT(mag.healthy(), "healthy after the probe and verify");
+    TEST_ASSERT_EQUAL(0x7C, chip.regs[0x20], "CTRL_REG1");
+    TEST_ASSERT_EQUAL(0x00, chip.regs[0x21], "CTRL_REG2");
+    TEST_ASSERT_EQUAL(0x00, chip.regs[0x22], "CTRL_REG3");
+    TEST_ASSERT_EQUAL(0x0C, chip.regs[0x23], "CTRL_REG4");
+    TEST_ASSERT_EQUAL(0x40, chip.regs[0x24], "CTRL_REG5");
+
+    const uint32_t reads = chip.reads;
+    mag.update();
+    mag.update();
+    bus.run();
+    TEST_ASSERT_EQUAL(reads + 1, chip.reads, "one data read");
+    LIS3MDL::Sample s;
+    TEST_ASSERT(mag.get_sample(s), "sample");
+    // a burst read without the auto-increment bit would read OUT_X_L three times
+    TEST_ASSERT_FLOAT_EQUAL(0.5, s.mag[0], 1e-4, "x");
+    TEST_ASSERT_FLOAT_EQUAL(-0.25, s.mag[1], 1e-4, "y");
+    TEST_ASSERT_FLOAT_EQUAL(1.0, s.mag[2], 1e-4, "z");
+    return true;
+}
+
+// a chip that doesn't keep its configuration isn't used
+static bool test_verify_fails()
+{
+    static I2C_Bus other_bus(Wire);
+    static LIS3MDL stuck(other_bus, 0x1E);
+    Fake_Chip &chip = Wire.chips[0x1E];
+    const int16_t field[3] {};
+    lis3mdl_image(chip, field);
+    chip.read_hook = [](uint8_t reg, size_t n, std::vector<uint8_t> &out) {
+        if ((reg & 0x7F) != 0x20) {
+            return false;
+        }
+        out.assign(n, 0);
+        return true;
+    };
+    stuck.init();
+    other_bus.run();
+    TEST_ASSERT(!stuck.healthy(), "configuration not verified");
+    return true;
+}
+
+int main(void)
+{
+    TEST_RUN(test_decode);
+    TEST_RUN(test_driver);
+    TEST_RUN(test_verify_fails);
+    return test_result();
+}
@@ -0,0 +1,185 @@
+/*
+  LSM6DS3 driver on the fake I2C bus, draining a model of its FIFO
+ */
+
+#include "test.h"
+#include "lsm6ds3.h"
+#include "sensor_images.h"
+
+#define INT1_PIN 7
+
+static LSM6DS3_FIFO_Model fifo;
+
+// bus task runs every step_us, the consumer takes the batch after each
+static void run_for(I2C_Bus &bus, uint32_t us, uint32_t step_us,
+                    LSM6DS3 *imu, std::vector<LSM6DS3::Raw_Sample> *out)
+{
+    const uint64_t end_us = host_time_us() + us;
+    while (host_time_us() < end_us) {
+        host_advance_us(step_us);
+        fifo.fill();
+        bus.run();
+        if (imu == nullptr) {
+            continue;
+        }
+        LSM6DS3::Raw_Sample b[64];
+        uint16_t n;
+        while ((n = imu->read_batch(b, 64)) > 0) {
+            out->insert(out->end(), b, b+n);
+        }
+    }
+}
+
+// samples whole and in order, each timestamped within a period
+static bool check_stream(const std::vector<LSM6DS3::Raw_Sample> &v)
+{
+    TEST_ASSERT(!v.empty(), "samples");
+    for (size_t i=0; i<v.size(); i++) {
+        const LSM6DS3::Raw_Sample &s = v[i];
+        const uint16_t k = s.gyro[0];
+        int16_t w[6];
+        LSM6DS3_FIFO_Model::sample_words(k, w);
+        TEST_ASSERT(memcmp(s.gyro, &w[0], 6) == 0 && memcmp(s.accel, &w[3], 6) == 0, "whole sample");
+        if (i > 0) {
+            TEST_ASSERT_EQUAL(uint16_t(v[i-1].gyro[0] + 1), k, "next sample");
+        }
+        const int32_t err = int32_t(s.timestamp_us - uint32_t(fifo.sample_us(k)));
+        TEST_ASSERT(abs(err) < int32_t(LSM6DS3_FIFO_Model::PERIOD_US), "timestamp");
+    }
+    return true;
+}
+
+static bool test_decode()
+{
+    const uint8_t raw[12] { 0xE8, 0x03, 0x18, 0xFC, 0, 0, 0, 0, 0, 0, 0x05, 0x20 };
+    LSM6DS3::Raw_Sample s;
+    LSM6DS3::decode(raw, s);
+    TEST_ASSERT_EQUAL(1000, s.gyro[0], "gyro x");
+    TEST_ASSERT_EQUAL(-1000, s.gyro[1], "gyro y");
+    TEST_ASSERT_EQUAL(8197, s.accel[2], "accel z");
+    TEST_ASSERT_FLOAT_EQUAL(9.80665, 8197 * LSM6DS3::ACCEL_SCALE, 0.01, "1g");
+    TEST_ASSERT_FLOAT_EQUAL(1000 * 17.5e-3 * M_PI / 180, 1000 * LSM6DS3::GYRO_SCALE, 1e-6, "gyro scale");
+    return true;
+}
+
+/*
+  woken by the watermark interrupt: every sample arrives once, whole
+  and in order, in about one read per watermark
+ */
+static bool test_fifo_interrupt()
+{
+    static I2C_Bus bus(Wire);
+    static LSM6DS3 imu(bus, LSM6DS3_ADDR);
+    Wire.chips.clear();
+    Fake_Chip &chip = Wire.chips[LSM6DS3_ADDR];
+    const int16_t zero[3] {};
+    lsm6ds3_image(chip, zero, zero);
+    fifo.attach(chip);
+    fifo.int1_pin = -1;
+
+    host_advance_us(1000);
+    imu.init(INT1_PIN);
+    bus.run();
+    TEST_ASSERT(imu.healthy(), "healthy after the probe and verify");
+    TEST_ASSERT_EQUAL(0x58, chip.regs[0x10], "CTRL1_XL");
+    TEST_ASSERT_EQUAL(0x54, chip.regs[0x11], "CTRL2_G");
+    TEST_ASSERT_EQUAL(0x44, chip.regs[0x12], "CTRL3_C");
+    TEST_ASSERT_EQUAL(48, chip.regs[0x06], "FIFO_CTRL1 watermark");
+    TEST_ASSERT_EQUAL(0x09, chip.regs[0x08], "FIFO_CTRL3");
+    TEST_ASSERT_EQUAL(0x2E, chip.regs[0x0A], "FIFO_CTRL5 continuous");
+    TEST_ASSERT_EQUAL(0x08, chip.regs[0x0D], "INT1 on the watermark");
+
+    fifo.int1_pin = INT1_PIN;
+    fifo.reset(host_time_us());
+    std::vector<LSM6DS3::Raw_Sample> v;
+    const uint32_t reads = chip.reads;
+    run_for(bus, 10000000, 1000, &imu, &v);
+    if (!check_stream(v)) {
+        return false;
+    }
+    TEST_ASSERT(v.size() >= 2070 && v.size() <= 2080, "208Hz for 10s");
+    TEST_ASSERT_EQUAL(v.size(), imu.get_samples(), "samples counted");
+    // a status and a data read per watermark of 8 samples
+    TEST_ASSERT((chip.reads - reads) * 8.0 / v.size() < 2.2, "reads per watermark");
+    TEST_ASSERT_EQUAL(0, imu.get_overruns(), "overruns");
+    TEST_ASSERT_EQUAL(0, imu.get_discarded(), "discarded");
+    TEST_ASSERT_EQUAL(0, imu.get_batch_dropped(), "batch dropped");
+
+    LSM6DS3::Sample mean;
+    TEST_ASSERT(imu.get_sample(mean), "batch mean");
+    // accel x is gyro x + 1000 in every sample, so in the mean too
+    const float mean_k = mean.gyro[0] / LSM6DS3::GYRO_SCALE;
+    TEST_ASSERT_FLOAT_EQUAL((mean_k + 1000) * LSM6DS3::ACCEL_SCALE, mean.accel[0], 1e-3, "batch mean");
+
+    /*
+      the bus task stalls for 30s: the FIFO overruns and the batch ring
+      fills. After it the driver realigns on a whole sample
+     */
+    host_advance_us(30000000);
+    fifo.fill();
+    run_for(bus, 2000000, 1000, nullptr, nullptr);
+    TEST_ASSERT(imu.get_overruns() >= 1 && imu.get_overruns() <= 2, "overrun counted");
+    TEST_ASSERT(imu.get_discarded() > 0 && imu.get_discarded() < 6, "words discarded to realign");
+    TEST_ASSERT(imu.get_batch_dropped() > 0, "batch ring full");
+
+    LSM6DS3::Raw_Sample b[256];
+    const uint16_t n = imu.read_batch(b, 256);
+    TEST_ASSERT_EQUAL(2048 / sizeof(LSM6DS3::Raw_Sample), n, "full batch ring");
+    v.assign(b, b+n);
+    if (!check_stream(v)) {
+        return false;
+    }
+    v.clear();
+    run_for(bus, 2000000, 1000, &imu, &v);
+    return check_stream(v);
+}
+
+// without INT1 wired the bus task polls the FIFO and loses nothing
+static bool test_fifo_polled()
+{
+    static I2C_Bus bus(Wire);
+    static LSM6DS3 imu(bus, LSM6DS3_ADDR);
+    Wire.chips.clear();
+    Fake_Chip &chip = Wire.chips[LSM6DS3_ADDR];
+    const int16_t zero[3] {};
+    // the LSM6DS3TR-C
+    lsm6ds3_image(chip, zero, zero, 0x6A);
+    fifo.attach(chip);
+    fifo.int1_pin = -1;
+
+    imu.init();
+    bus.run();
+    TEST_ASSERT(imu.healthy(), "healthy");
+    fifo.reset(host_time_us());
+    std::vector<LSM6DS3::Raw_Sample> v;
+    run_for(bus, 10000000, 100000, &imu, &v);
+    if (!check_stream(v)) {
+        return false;
+    }
+    TEST_ASSERT(v.size() >= 2060, "208Hz for 10s");
+    TEST_ASSERT_EQUAL(0, imu.get_overruns(), "overruns");
+    TEST_ASSERT_EQUAL(0, imu.get_batch_dropped(), "batch dropped");
+    return true;
+}
+
+static bool test_absent()
+{
+    static I2C_Bus bus(Wire);
+    static LSM6DS3 imu(bus, LSM6DS3_ADDR);
+    Wire.chips.clear();
+    const int16_t zero[3] {};
+    lsm6ds3_image(Wire.chips[LSM6DS3_ADDR], zero, zero, 0x6C);
+    imu.init();
+    bus.run();
+    TEST_ASSERT(!imu.healthy(), "unknown WHO_AM_I");
+    return true;
+}
+
+int main(void)
+{
+    TEST_RUN(test_decode);
+    TEST_RUN(test_fifo_interrupt);
+    TEST_RUN(test_fifo_polled);
+    TEST_RUN(test_absent);
+    return test_result();
+}
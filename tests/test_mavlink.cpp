@@ -0,0 +1,373 @@
+/*
+  MAVLink 2 framing: CRC, packing, parsing and signing
+
+  The golden frames come from mavlink_vectors.py, which builds them
+  from the wire format spec without the generated headers
+ */
+
+#include "test.h"
+#include "mavlink_msgs.h"
+#include "mavlink_scanner.h"
+#include "mavlink_tx_queue.h"
+#include "mavlink_frames.h"
+#include <string>
+#include <vector>
+
+static const char golden_heartbeat[] = "fd0900000001ec00000000000000120800000349b3";
+static const char golden_param_value[] = "fd1900000101ec1600000000c03f0a0003004c4f434b5f4c4556454c00000000000009b12c";
+static const char golden_statustext_signed[] = "fd0601000201ecfd00000668656c6c6fcddc0715cd5b07000014c89b99bb83";
+
+static MAVLink_TX_Queue tx_queue(Serial1, MAVLINK_COMM_0);
+
+static mavlink_signing_t tx_signing;
+
+static std::string hex(const uint8_t *b, size_t n)
+{
+    std::string s;
+    char h[3];
+    for (size_t i=0; i<n; i++) {
+        snprintf(h, sizeof(h), "%02x", b[i]);
+        s += h;
+    }
+    return s;
+}
+
+static std::vector<uint8_t> unhex(const char *s)
+{
+    std::vector<uint8_t> v;
+    for (; s[0] && s[1]; s += 2) {
+        v.push_back(strtoul(std::string(s, 2).c_str(), nullptr, 16));
+    }
+    return v;
+}
+
+// everything sent on channel 0 since the last call
+static std::string sent(void)
+{
+    for (int i=0; i<8; i++) {
+        tx_queue.drain();
+    }
+    const std::string s = hex((const uint8_t *)Serial1.tx.data(), Serial1.tx.length());
+    Serial1.tx.clear();
+    return s;
+}
+
+static void reset_channels(void)
+{
+    mavlink_reset_channel_status(MAVLINK_COMM_0);
+    mavlink_reset_channel_status(MAVLINK_COMM_1);
+    mavlink_get_channel_status(MAVLINK_COMM_0)->current_tx_seq = 0;
+    mavlink_get_channel_status(MAVLINK_COMM_0)->signing = nullptr;
+    mavlink_get_channel_status(MAVLINK_COMM_1)->signing = nullptr;
+    mavlink_get_channel_status(MAVLINK_COMM_1)->signing_streams = nullptr;
+}
+
+static void set_signing_key(mavlink_signing_t &s)
+{
+    for (uint8_t i=0; i<32; i++) {
+        s.secret_key[i] = i;
+    }
+}
+
+static bool reject_unsigned(const mavlink_status_t *, uint32_t)
+{
+    return false;
+}
+
+// the table driven CRC against the bit by bit X.25 definition
+static bool test_crc()
+{
+    uint8_t data[1000];
+    for (auto &b : data) {
+        b = random(256);
+    }
+    for (uint16_t n=0; n<sizeof(data); n+=7) {
+        uint16_t crc = 0xffff;
+        for (uint16_t i=0; i<n; i++) {
+            uint8_t tmp = data[i] ^ uint8_t(crc & 0xff);
+            tmp ^= tmp << 4;
+            crc = (crc >> 8) ^ (tmp << 8) ^ (tmp << 3) ^ (tmp >> 4);
+        }
+        TEST_ASSERT_EQUAL(crc, crc_calculate(data, n), "crc_calculate");
+    }
+    return true;
+}
+
+static bool test_send_unsigned()
+{
+    reset_channels();
+    sent();
+    mavlink_msg_heartbeat_send(MAVLINK_COMM_0, MAV_TYPE_ODID, MAV_AUTOPILOT_INVALID, 0, 0, 0);
+    TEST_ASSERT_STRING_EQUAL(golden_heartbeat, sent().c_str(), "HEARTBEAT");
+    mavlink_msg_param_value_send(MAVLINK_COMM_0, "LOCK_LEVEL", 1.5, MAV_PARAM_TYPE_REAL32, 10, 3);
+    TEST_ASSERT_STRING_EQUAL(golden_param_value, sent().c_str(), "PARAM_VALUE");
+    return true;
+}
+
+// pack then to_send_buffer gives the same frame as the send path
+static bool test_pack()
+{
+    reset_channels();
+    mavlink_message_t msg;
+    uint8_t buf[MAVLINK_MAX_PACKET_LEN];
+    const uint16_t n = mavlink_msg_heartbeat_pack(1, MAV_COMP_ID_ODID_TXRX_1, &msg,
+                                                  MAV_TYPE_ODID, MAV_AUTOPILOT_INVALID, 0, 0, 0);
+    TEST_ASSERT_EQUAL(21, n, "frame length");
+    TEST_ASSERT_EQUAL(21, mavlink_msg_to_send_buffer(buf, &msg), "to_send_buffer length");
+    TEST_ASSERT_STRING_EQUAL(golden_heartbeat, hex(buf, n).c_str(), "HEARTBEAT");
+    return true;
+}
+
+static bool test_send_signed()
+{
+    reset_channels();
+    sent();
+    tx_signing = {};
+    tx_signing.flags = MAVLINK_SIGNING_FLAG_SIGN_OUTGOING;
+    tx_signing.link_id = 7;
+    tx_signing.timestamp = 123456789;
+    set_signing_key(tx_signing);
+    mavlink_get_channel_status(MAVLINK_COMM_0)->signing = &tx_signing;
+    mavlink_get_channel_status(MAVLINK_COMM_0)->current_tx_seq = 2;
+    mavlink_msg_statustext_send(MAVLINK_COMM_0, MAV_SEVERITY_INFO, "hello", 0, 0);
+    mavlink_get_channel_status(MAVLINK_COMM_0)->signing = nullptr;
+    TEST_ASSERT_STRING_EQUAL(golden_statustext_signed, sent().c_str(), "signed STATUSTEXT");
+    TEST_ASSERT_EQUAL(123456790, tx_signing.timestamp, "timestamp moves on per frame");
+    return true;
+}
+
+// a frame through the byte parser, with its zero tail truncated on the wire
+static bool test_parse_location()
+{
+    reset_channels();
+    mavlink_message_t msg, rx;
+    mavlink_status_t status;
+    uint8_t buf[MAVLINK_MAX_PACKET_LEN];
+    const uint8_t id_or_mac[20] {1, 2, 3};
+    mavlink_msg_open_drone_id_location_pack(3, 4, &msg, 0, 0, id_or_mac, 2, 9000, 150, -20,
+                                            515000000, -1000000, 10.5, 20.25, 1, 3.5, 10, 4, 3, 2, 1234.5, 0);
+    TEST_ASSERT(msg.len < MAVLINK_MSG_ID_OPEN_DRONE_ID_LOCATION_LEN, "payload truncated");
+    const uint16_t n = mavlink_msg_to_send_buffer(buf, &msg);
+
+    int frames = 0;
+    for (uint16_t i=0; i<n; i++) {
+        frames += mavlink_parse_char(MAVLINK_COMM_1, buf[i], &rx, &status);
+    }
+    TEST_ASSERT_EQUAL(1, frames, "frames parsed");
+    mavlink_open_drone_id_location_t loc;
+    mavlink_msg_open_drone_id_location_decode(&rx, &loc);
+    TEST_ASSERT_EQUAL(515000000, loc.latitude, "latitude");
+    TEST_ASSERT_EQUAL(-1000000, loc.longitude, "longitude");
+    TEST_ASSERT_EQUAL(9000, loc.direction, "direction");
+    TEST_ASSERT_EQUAL(-20, loc.speed_vertical, "speed_vertical");
+    TEST_ASSERT_FLOAT_EQUAL(1234.5, loc.timestamp, 0, "timestamp");
+    TEST_ASSERT_EQUAL(0, loc.timestamp_accuracy, "truncated field is zero");
+    TEST_ASSERT_EQUAL(3, loc.id_or_mac[2], "id_or_mac");
+    TEST_ASSERT_FLOAT_EQUAL(20.25, mavlink_msg_open_drone_id_location_get_altitude_geodetic(&rx), 0, "altitude_geodetic");
+
+    // one flipped bit fails the CRC
+    buf[12] ^= 1;
+    frames = 0;
+    for (uint16_t i=0; i<n; i++) {
+        frames += mavlink_parse_char(MAVLINK_COMM_1, buf[i], &rx, &status);
+    }
+    TEST_ASSERT_EQUAL(0, frames, "corrupted frame");
+    return true;
+}
+
+// the parser takes a signed frame once and refuses its replay
+static bool test_parse_signed()
+{
+    reset_channels();
+    static mavlink_signing_t rx_signing;
+    static mavlink_signing_streams_t streams;
+    rx_signing = {};
+    streams = {};
+    set_signing_key(rx_signing);
+    rx_signing.accept_unsigned_callback = reject_unsigned;
+    mavlink_status_t *chan = mavlink_get_channel_status(MAVLINK_COMM_1);
+    chan->signing = &rx_signing;
+    chan->signing_streams = &streams;
+
+    const std::vector<uint8_t> frame = unhex(golden_statustext_signed);
+    mavlink_message_t rx;
+    mavlink_status_t status;
+    uint8_t res = 0;
+    for (auto c : frame) {
+        res = mavlink_frame_char(MAVLINK_COMM_1, c, &rx, &status);
+    }
+    TEST_ASSERT_EQUAL(MAVLINK_FRAMING_OK, res, "signed frame");
+    TEST_ASSERT_EQUAL(MAVLINK_MSG_ID_STATUSTEXT, rx.msgid, "msgid");
+    for (auto c : frame) {
+        res = mavlink_frame_char(MAVLINK_COMM_1, c, &rx, &status);
+    }
+    TEST_ASSERT_EQUAL(MAVLINK_FRAMING_BAD_SIGNATURE, res, "replay");
+    reset_channels();
+    return true;
+}
+
+// the scanner drops a tampered frame, a replay and an unsigned frame
+static bool test_scanner_signed()
+{
+    static MAVLink_Scanner scanner;
+    static mavlink_signing_t rx_signing;
+    static mavlink_signing_streams_t streams;
+    set_signing_key(rx_signing);
+    scanner.get_status().signing = &rx_signing;
+    scanner.get_status().signing_streams = &streams;
+
+    const std::vector<uint8_t> frame = unhex(golden_statustext_signed);
+    std::vector<uint8_t> tampered = frame;
+    tampered.back() ^= 0x55;
+    const std::vector<uint8_t> heartbeat = unhex(golden_heartbeat);
+
+    std::vector<uint8_t> stream;
+    stream.insert(stream.end(), tampered.begin(), tampered.end());
+    stream.insert(stream.end(), frame.begin(), frame.end());
+    stream.insert(stream.end(), frame.begin(), frame.end());
+    stream.insert(stream.end(), heartbeat.begin(), heartbeat.end());
+    memcpy(scanner.write_ptr(), stream.data(), stream.size());
+    scanner.written(stream.size());
+
+    mavlink_message_t rx;
+    int frames = 0;
+    while (scanner.next(rx)) {
+        TEST_ASSERT_EQUAL(MAVLINK_MSG_ID_STATUSTEXT, rx.msgid, "only the good signed frame");
+        frames++;
+    }
+    TEST_ASSERT_EQUAL(1, frames, "frames accepted");
+    TEST_ASSERT_EQUAL(3, scanner.get_signature_errors(), "signature errors");
+    return true;
+}
+
+/*
+  a stream with a false STX, a corrupted frame, an unknown msgid, a
+  truncated payload and a signed frame, received in chunks of every
+  size up to a UART read: only the good frames come out, whole
+ */
+static bool test_scanner_stream()
+{
+    std::vector<uint8_t> stream { MAVLINK_STX, 3 };
+    uint8_t seq = 0;
+    const auto add = [&](const std::vector<uint8_t> &f) {
+        stream.insert(stream.end(), f.begin(), f.end());
+    };
+    add(mavlink2_frame(MAVLINK_MSG_ID_OPEN_DRONE_ID_LOCATION, 59, seq++));
+    add(mavlink1_frame(MAVLINK_MSG_ID_HEARTBEAT, 9, seq++));
+    std::vector<uint8_t> bad = mavlink2_frame(MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM, 54, seq++);
+    bad[20] ^= 0xFF;
+    add(bad);
+    add(mavlink2_frame(12345, 30, seq++));
+    add(mavlink2_frame(MAVLINK_MSG_ID_OPEN_DRONE_ID_BASIC_ID, 20, seq++));
+    add(mavlink2_frame(MAVLINK_MSG_ID_STATUSTEXT, 54, seq++, true));
+
+    const uint32_t expected[] {
+        MAVLINK_MSG_ID_OPEN_DRONE_ID_LOCATION,
+        MAVLINK_MSG_ID_HEARTBEAT,
+        MAVLINK_MSG_ID_OPEN_DRONE_ID_BASIC_ID,
+        MAVLINK_MSG_ID_STATUSTEXT,
+    };
+    for (uint16_t chunk=1; chunk<=128; chunk++) {
+        MAVLink_Scanner scanner {};
+        mavlink_message_t rx;
+        uint32_t frames = 0;
+        for (size_t i=0; i<stream.size(); ) {
+            const uint16_t n = std::min<size_t>(std::min<size_t>(chunk, scanner.write_space()), stream.size() - i);
+            memcpy(scanner.write_ptr(), &stream[i], n);
+            scanner.written(n);
+            i += n;
+            while (scanner.next(rx)) {
+                TEST_ASSERT(frames < 4, "no extra frames");
+                TEST_ASSERT_EQUAL(expected[frames], rx.msgid, "good frames in order");
+                if (rx.msgid == MAVLINK_MSG_ID_OPEN_DRONE_ID_BASIC_ID) {
+                    const uint8_t *p = (const uint8_t *)rx.payload64;
+                    TEST_ASSERT_EQUAL(19*7 + 1, p[19], "payload kept");
+                    TEST_ASSERT(p[20] == 0 && p[43] == 0, "truncated payload zero filled");
+                }
+                frames++;
+            }
+        }
+        TEST_ASSERT_EQUAL(4, frames, "good frames");
+        TEST_ASSERT_EQUAL(1, scanner.get_crc_errors(), "corrupted frame");
+        TEST_ASSERT_EQUAL(1, scanner.get_unknown(), "unknown msgid skipped");
+    }
+    return true;
+}
+
+/*
+  a UART taking 16 bytes a poll, stalled while a burst of STATUSTEXT,
+  a param list and a heartbeat are queued in that order: the heartbeat
+  goes out first, then the params, then the text, and only the text
+  queue overflows. A frame counts as sent once its last byte is written
+ */
+static bool test_tx_priority()
+{
+    using P = MAVLink_TX_Queue::Priority;
+    reset_channels();
+    sent();
+    const uint32_t sent_before[] { tx_queue.get_sent(P::STATUS), tx_queue.get_sent(P::PARAM), tx_queue.get_sent(P::TEXT) };
+    Serial1.tx_room = 0;
+    for (uint8_t i=0; i<20; i++) {
+        mavlink_msg_statustext_send(MAVLINK_COMM_0, MAV_SEVERITY_INFO,
+                                    "a long status message of forty chars...", 0, 0);
+    }
+    for (uint8_t i=0; i<6; i++) {
+        mavlink_msg_param_value_send(MAVLINK_COMM_0, "LOCK_LEVEL", i, MAV_PARAM_TYPE_REAL32, 6, i);
+    }
+    mavlink_msg_heartbeat_send(MAVLINK_COMM_0, MAV_TYPE_ODID, MAV_AUTOPILOT_INVALID, 0, 0, 0);
+    TEST_ASSERT_EQUAL(0, Serial1.tx.length(), "nothing written to a full FIFO");
+    TEST_ASSERT_EQUAL(sent_before[0], tx_queue.get_sent(P::STATUS), "queued is not sent");
+    TEST_ASSERT_EQUAL(0, tx_queue.get_dropped(P::STATUS), "heartbeat not dropped");
+    TEST_ASSERT_EQUAL(0, tx_queue.get_dropped(P::PARAM), "params not dropped");
+    const uint32_t text_dropped = tx_queue.get_dropped(P::TEXT);
+    TEST_ASSERT(text_dropped > 0 && text_dropped < 20, "text dropped when its queue is full");
+
+    std::vector<uint32_t> order;
+    mavlink_message_t rx;
+    mavlink_status_t status;
+    for (uint16_t poll=0; poll<1000; poll++) {
+        Serial1.tx_room = 16;
+        tx_queue.drain();
+        for (const char c : Serial1.tx) {
+            if (mavlink_parse_char(MAVLINK_COMM_1, uint8_t(c), &rx, &status)) {
+                order.push_back(rx.msgid);
+            }
+        }
+        Serial1.tx.clear();
+        uint32_t frames = 0;
+        for (uint8_t p=0; p<3; p++) {
+            frames += tx_queue.get_sent(P(p)) - sent_before[p];
+        }
+        TEST_ASSERT_EQUAL(order.size(), frames, "sent counted as each frame completes");
+    }
+    Serial1.tx_room = -1;
+
+    const uint32_t texts = 20 - text_dropped;
+    TEST_ASSERT_EQUAL(1 + 6 + texts, order.size(), "frames written");
+    TEST_ASSERT_EQUAL(MAVLINK_MSG_ID_HEARTBEAT, order[0], "heartbeat first");
+    for (uint8_t i=1; i<order.size(); i++) {
+        TEST_ASSERT_EQUAL(i <= 6 ? MAVLINK_MSG_ID_PARAM_VALUE : MAVLINK_MSG_ID_STATUSTEXT, order[i],
+                          "params then text");
+    }
+    TEST_ASSERT_EQUAL(sent_before[0] + 1, tx_queue.get_sent(P::STATUS), "heartbeat sent");
+    TEST_ASSERT_EQUAL(sent_before[1] + 6, tx_queue.get_sent(P::PARAM), "params sent");
+    TEST_ASSERT_EQUAL(sent_before[2] + texts, tx_queue.get_sent(P::TEXT), "text sent");
+    TEST_ASSERT(!tx_queue.mid_frame(), "drained");
+    reset_channels();
+    return true;
+}
+
+int main(void)
+{
+    mavlink_system.sysid = 1;
+    TEST_RUN(test_crc);
+    TEST_RUN(test_send_unsigned);
+    TEST_RUN(test_pack);
+    TEST_RUN(test_send_signed);
+    TEST_RUN(test_tx_priority);
+    TEST_RUN(test_parse_location);
+    TEST_RUN(test_parse_signed);
+    TEST_RUN(test_scanner_signed);
+    TEST_RUN(test_scanner_stream);
+    return test_result();
+}
@@ -0,0 +1,205 @@
+/*
+  NMEA parser on the sentences a receiver sends: every field of an
+  epoch, the hemispheres and empty terms, the fix validity, and
+  sentences that are corrupted or too long to decode
+ */
+
+#include "test.h"
+#include "nmea.h"
+#include "gnss_streams.h"
+
+static uint32_t feed(NMEA_Parser &parser, const std::string &s)
+{
+    uint32_t sentences = 0;
+    for (const char c : s) {
+        sentences += parser.feed(c);
+    }
+    return sentences;
+}
+
+static double angle(int deg, double min)
+{
+    return deg + min / 60;
+}
+
+// every field of the fix from one epoch, the GSV set skipped
+static bool test_epoch()
+{
+    static NMEA_Parser parser;
+    TEST_ASSERT_EQUAL(NMEA_EPOCH_SENTENCES, feed(parser, nmea_epoch(10)), "supported sentences");
+    TEST_ASSERT_EQUAL(NMEA_Parser::GGA | NMEA_Parser::RMC | NMEA_Parser::GSA | NMEA_Parser::VTG | NMEA_Parser::GST,
+                      parser.get_updated(), "updated");
+    TEST_ASSERT_EQUAL(0, parser.get_updated(), "cleared when read");
+
+    const GNSS_Fix &f = parser.get_fix();
+    TEST_ASSERT(f.valid, "valid");
+    TEST_ASSERT_FLOAT_EQUAL(gnss_epoch(10).lat, f.latitude, 1e-7, "latitude");
+    TEST_ASSERT_FLOAT_EQUAL(gnss_epoch(10).lon, f.longitude, 1e-7, "longitude west");
+    TEST_ASSERT_EQUAL(gnss_epoch(10).time_ms, f.time_ms, "UTC time of day");
+    TEST_ASSERT_EQUAL(171026, f.date, "ddmmyy");
+    TEST_ASSERT_EQUAL(1, f.fix_quality, "GGA quality");
+    TEST_ASSERT_EQUAL(12, f.num_sats, "satellites");
+    TEST_ASSERT_FLOAT_EQUAL(545.4, f.altitude_msl, 1e-3, "altitude");
+    TEST_ASSERT_FLOAT_EQUAL(46.9, f.geoid_sep, 1e-3, "geoid separation");
+
+    // GSA after GGA
+    TEST_ASSERT_EQUAL(3, f.fix_type, "GSA 3D");
+    TEST_ASSERT_FLOAT_EQUAL(1.3, f.hdop, 1e-6, "GSA HDOP over the GGA one");
+    TEST_ASSERT_FLOAT_EQUAL(2.1, f.vdop, 1e-6, "VDOP");
+
+    // VTG after RMC, in km/h
+    TEST_ASSERT_FLOAT_EQUAL(84.4, f.course, 1e-4, "course");
+    TEST_ASSERT_FLOAT_EQUAL(10.2 / 3.6, f.ground_speed, 1e-5, "VTG speed");
+
+    // GST latitude and longitude sigmas of 0.5 and 0.7
+    TEST_ASSERT_FLOAT_EQUAL(sqrt(0.5*0.5 + 0.7*0.7), f.horiz_accuracy, 1e-6, "root sum square");
+    TEST_ASSERT_FLOAT_EQUAL(1.1, f.vert_accuracy, 1e-6, "altitude sigma");
+
+    TEST_ASSERT_EQUAL(NMEA_EPOCH_SENTENCES, parser.get_sentences(), "sentences");
+    TEST_ASSERT_EQUAL(0, parser.get_checksum_errors(), "checksum errors");
+    return true;
+}
+
+/*
+  S and W make the angle negative, N and E leave it positive, in both
+  GGA and RMC. An empty term keeps the value before it
+ */
+static bool test_hemispheres()
+{
+    static NMEA_Parser parser;
+    feed(parser, nmea_sentence("GPGGA,123519,4807.038,S,01131.000,W,1,08,0.9,545.4,M,46.9,M,,"));
+    TEST_ASSERT_FLOAT_EQUAL(-angle(48, 7.038), parser.get_fix().latitude, 1e-9, "south");
+    TEST_ASSERT_FLOAT_EQUAL(-angle(11, 31.0), parser.get_fix().longitude, 1e-9, "west");
+
+    feed(parser, nmea_sentence("GPRMC,123520,A,3351.500,N,15112.750,E,0.1,,230394,,"));
+    TEST_ASSERT_FLOAT_EQUAL(angle(33, 51.5), parser.get_fix().latitude, 1e-9, "north");
+    TEST_ASSERT_FLOAT_EQUAL(angle(151, 12.75), parser.get_fix().longitude, 1e-9, "east");
+    TEST_ASSERT_FLOAT_EQUAL(0.1 * 0.514444, parser.get_fix().ground_speed, 1e-6, "knots");
+
+    feed(parser, nmea_sentence("GPRMC,123521,A,3351.500,S,15112.750,W,0.1,,230394,,"));
+    TEST_ASSERT_FLOAT_EQUAL(-angle(33, 51.5), parser.get_fix().latitude, 1e-9, "RMC south");
+    TEST_ASSERT_FLOAT_EQUAL(-angle(151, 12.75), parser.get_fix().longitude, 1e-9, "RMC west");
+
+    // the position, altitude, satellites and course terms empty
+    feed(parser, nmea_sentence("GPGGA,123522,,,,,1,,,,M,,M,,"));
+    const GNSS_Fix &f = parser.get_fix();
+    TEST_ASSERT_FLOAT_EQUAL(-angle(33, 51.5), f.latitude, 1e-9, "latitude kept");
+    TEST_ASSERT_FLOAT_EQUAL(-angle(151, 12.75), f.longitude, 1e-9, "longitude kept");
+    TEST_ASSERT_FLOAT_EQUAL(545.4, f.altitude_msl, 1e-3, "altitude kept");
+    TEST_ASSERT_EQUAL(8, f.num_sats, "satellites kept");
+    TEST_ASSERT_EQUAL(((12*60 + 35)*60 + 22)*1000, f.time_ms, "time");
+    TEST_ASSERT(f.valid, "valid");
+    feed(parser, nmea_sentence("GPRMC,123523,A,,,,,,,230394,,"));
+    TEST_ASSERT_FLOAT_EQUAL(0.1 * 0.514444, parser.get_fix().ground_speed, 1e-6, "speed kept");
+    TEST_ASSERT_EQUAL(230394, parser.get_fix().date, "date");
+    return true;
+}
+
+// RMC status V and GGA quality 0, or an empty one, make the fix invalid
+static bool test_validity()
+{
+    static NMEA_Parser parser;
+    const struct {
+        const char *body;
+        bool valid;
+        uint8_t quality;
+    } cases[] {
+        { "GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,", true, 1 },
+        { "GPRMC,123519,V,4807.038,N,01131.000,E,,,230394,,", false, 1 },
+        { "GPRMC,123520,A,4807.038,N,01131.000,E,,,230394,,", true, 1 },
+        { "GPGGA,123520,4807.038,N,01131.000,E,0,00,,,M,,M,,", false, 0 },
+        { "GPGGA,123521,4807.038,N,01131.000,E,4,12,0.6,545.4,M,46.9,M,1.0,0000", true, 4 },
+        { "GPGGA,123522,4807.038,N,01131.000,E,,08,0.9,545.4,M,46.9,M,,", false, 0 },
+        { "GPGGA,123523,4807.038,N,01131.000,E,2,08,0.9,545.4,M,46.9,M,,", true, 2 },
+    };
+    for (const auto &c : cases) {
+        TEST_ASSERT_EQUAL(1, feed(parser, nmea_sentence(c.body)), "sentence");
+        TEST_ASSERT_EQUAL(c.valid, parser.get_fix().valid, "valid");
+        TEST_ASSERT_EQUAL(c.quality, parser.get_fix().fix_quality, "quality");
+    }
+    return true;
+}
+
+/*
+  a sentence with a wrong checksum leaves the fix as it was, though its
+  terms were decoded as they arrived. A missing or malformed checksum
+  drops the sentence without counting an error
+ */
+static bool test_checksum()
+{
+    static NMEA_Parser parser;
+    feed(parser, nmea_epoch(0));
+    parser.get_updated();
+    const GNSS_Fix before = parser.get_fix();
+    const uint32_t sentences = parser.get_sentences();
+
+    std::string bad = nmea_sentence("GNGGA,123600.00,4807.038,S,01131.000,E,1,12,0.9,12.0,M,46.9,M,,");
+    bad[bad.size() - 3] ^= 0x01;
+    TEST_ASSERT_EQUAL(0, feed(parser, bad), "rejected");
+    TEST_ASSERT_EQUAL(1, parser.get_checksum_errors(), "counted");
+    TEST_ASSERT(memcmp(&before, &parser.get_fix(), sizeof(before)) == 0, "fix unchanged");
+    TEST_ASSERT_EQUAL(0, parser.get_updated(), "nothing updated");
+
+    // a corrupted field rather than checksum
+    bad = nmea_sentence("GNGST,123600.00,1.2,0.8,0.6,45.0,0.5,0.7,1.1");
+    bad[30] = '9';
+    TEST_ASSERT_EQUAL(0, feed(parser, bad), "corrupted term");
+    TEST_ASSERT_EQUAL(2, parser.get_checksum_errors(), "counted");
+    TEST_ASSERT(memcmp(&before, &parser.get_fix(), sizeof(before)) == 0, "fix unchanged");
+
+    feed(parser, "$GNRMC,123600.00,V,,,,,,,171026,,,N\r\n");
+    feed(parser, "$GNRMC,123600.00,V,,,,,,,171026,,,N*4G\r\n");
+    feed(parser, "$GNRMC,123600.00,V,,,,,,,171026,,,N*4\r\n");
+    TEST_ASSERT_EQUAL(3, parser.get_checksum_errors(), "non-hex digit counted");
+    TEST_ASSERT(memcmp(&before, &parser.get_fix(), sizeof(before)) == 0, "fix unchanged");
+    TEST_ASSERT_EQUAL(sentences, parser.get_sentences(), "no sentences");
+
+    // lower case hex is accepted
+    std::string lower = nmea_sentence("GNVTG,12.5,T,,M,1.0,N,1.9,K,A");
+    for (size_t i=lower.size() - 4; i<lower.size(); i++) {
+        lower[i] = tolower(lower[i]);
+    }
+    TEST_ASSERT_EQUAL(1, feed(parser, lower), "lower case checksum");
+    TEST_ASSERT_FLOAT_EQUAL(12.5, parser.get_fix().course, 1e-4, "decoded");
+    return true;
+}
+
+/*
+  a term longer than TERM_SIZE holds drops its sentence before the
+  buffer overflows, and the next sentence decodes. A term one shorter
+  fits
+ */
+static bool test_long_term()
+{
+    static NMEA_Parser parser;
+    feed(parser, nmea_sentence("GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,"));
+    const GNSS_Fix before = parser.get_fix();
+
+    // 15 characters, the most a term holds with its terminator
+    TEST_ASSERT_EQUAL(1, feed(parser, nmea_sentence("GPGGA,123520,4807.0380000000,S,01131.000,E,1,08,0.9,1.0,M,46.9,M,,")),
+                      "longest term");
+    TEST_ASSERT_FLOAT_EQUAL(-angle(48, 7.038), parser.get_fix().latitude, 1e-9, "decoded");
+
+    TEST_ASSERT_EQUAL(0, feed(parser, nmea_sentence("GPGGA,123521,4807.03800000000,N,01131.000,E,1,08,0.9,2.0,M,46.9,M,,")),
+                      "16 character term");
+    TEST_ASSERT_EQUAL(0, feed(parser, "$GPGGA,123521," + std::string(200, '1') + ",N*00\r\n"), "200 character term");
+    TEST_ASSERT_FLOAT_EQUAL(1.0, parser.get_fix().altitude_msl, 1e-6, "fix unchanged");
+    TEST_ASSERT_EQUAL(0, parser.get_checksum_errors(), "not a checksum error");
+    TEST_ASSERT_EQUAL(2, parser.get_sentences(), "sentences");
+
+    TEST_ASSERT_EQUAL(1, feed(parser, nmea_sentence("GPGGA,123522,4807.038,N,01131.000,E,1,08,0.9,3.0,M,46.9,M,,")),
+                      "next sentence");
+    TEST_ASSERT_FLOAT_EQUAL(3.0, parser.get_fix().altitude_msl, 1e-6, "decoded");
+    TEST_ASSERT_FLOAT_EQUAL(before.latitude, parser.get_fix().latitude, 1e-9, "north again");
+    return true;
+}
+
+int main(void)
+{
+    TEST_RUN(test_epoch);
+    TEST_RUN(test_hemispheres);
+    TEST_RUN(test_validity);
+    TEST_RUN(test_checksum);
+    TEST_RUN(test_long_term);
+    return test_result();
+}
@@ -0,0 +1,446 @@
+/*
+  OpenDroneID encoder and decoder
+
+  The golden messages come from odid_vectors.py, a transcription of
+  the opendroneid-core-c encoders, so a change in the byte layout or
+  the rounding of a field shows up here before a receiver sees it
+ */
+
+#include "test.h"
+#include <opendroneid.h>
+#include <random>
+
+static const uint8_t golden_basic_id[] {
+    0x02, 0x12, 0x4F, 0x4E, 0x52, 0x49, 0x44, 0x2D, 0x32, 0x34, 0x30, 0x41,
+    0x43, 0x34, 0x30, 0x30, 0x30, 0x30, 0x30, 0x31, 0x00, 0x00, 0x00, 0x00,
+    0x00,
+};
+static const uint8_t golden_location[] {
+    0x12, 0x22, 0x23, 0x31, 0xFD, 0x80, 0x21, 0xB6, 0x23, 0x96, 0xA9, 0x68,
+    0x06, 0xE9, 0x07, 0xEE, 0x07, 0xD7, 0x07, 0x5B, 0x43, 0x39, 0x30, 0x03,
+    0x00,
+};
+static const uint8_t golden_location_fast[] {
+    0x12, 0x25, 0x5A, 0x30, 0x7C, 0x5C, 0xDD, 0xD1, 0xEB, 0x87, 0x9F, 0x21,
+    0x5A, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0x00,
+    0x00,
+};
+static const uint8_t golden_self_id[] {
+    0x32, 0x00, 0x4D, 0x61, 0x72, 0x69, 0x74, 0x69, 0x6D, 0x65, 0x20, 0x73,
+    0x75, 0x72, 0x76, 0x65, 0x79, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00,
+};
+static const uint8_t golden_system[] {
+    0x42, 0x04, 0xD8, 0xF3, 0xB5, 0x23, 0x88, 0xB9, 0x67, 0x06, 0x01, 0x00,
+    0x0A, 0x34, 0x08, 0xD0, 0x07, 0x12, 0xDA, 0x07, 0x15, 0xCD, 0x5B, 0x07,
+    0x00,
+};
+static const uint8_t golden_operator_id[] {
+    0x52, 0x00, 0x46, 0x49, 0x4E, 0x38, 0x37, 0x61, 0x73, 0x74, 0x72, 0x64,
+    0x67, 0x65, 0x31, 0x32, 0x6B, 0x38, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00,
+};
+static const uint8_t golden_pack[] {
+    0xF2, 0x19, 0x03, 0x02, 0x12, 0x4F, 0x4E, 0x52, 0x49, 0x44, 0x2D, 0x32,
+    0x34, 0x30, 0x41, 0x43, 0x34, 0x30, 0x30, 0x30, 0x30, 0x30, 0x31, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x12, 0x22, 0x23, 0x31, 0xFD, 0x80, 0x21, 0xB6,
+    0x23, 0x96, 0xA9, 0x68, 0x06, 0xE9, 0x07, 0xEE, 0x07, 0xD7, 0x07, 0x5B,
+    0x43, 0x39, 0x30, 0x03, 0x00, 0x42, 0x04, 0xD8, 0xF3, 0xB5, 0x23, 0x88,
+    0xB9, 0x67, 0x06, 0x01, 0x00, 0x0A, 0x34, 0x08, 0xD0, 0x07, 0x12, 0xDA,
+    0x07, 0x15, 0xCD, 0x5B, 0x07, 0x00,
+};
+
+// the cases of odid_vectors.py
+static void fill_basic_id(ODID_BasicID_data &d)
+{
+    odid_initBasicIDData(&d);
+    d.IDType = ODID_IDTYPE_SERIAL_NUMBER;
+    d.UAType = ODID_UATYPE_HELICOPTER_OR_MULTIROTOR;
+    strcpy(d.UASID, "ONRID-240AC4000001");
+}
+
+static void fill_location(ODID_Location_data &d)
+{
+    odid_initLocationData(&d);
+    d.Status = ODID_STATUS_AIRBORNE;
+    d.Direction = 215.4;
+    d.SpeedHorizontal = 12.3;
+    d.SpeedVertical = -1.7;
+    d.Latitude = 59.9138688;
+    d.Longitude = 10.7522454;
+    d.AltitudeBaro = 12.5;
+    d.AltitudeGeo = 15.0;
+    d.HeightType = ODID_HEIGHT_REF_OVER_TAKEOFF;
+    d.Height = 3.5;
+    d.HorizAccuracy = ODID_HOR_ACC_3_METER;
+    d.VertAccuracy = ODID_VER_ACC_3_METER;
+    d.BaroAccuracy = ODID_VER_ACC_10_METER;
+    d.SpeedAccuracy = ODID_SPEED_ACC_1_METERS_PER_SECOND;
+    d.TimeStamp = 1234.5;
+    d.TSAccuracy = ODID_TIME_ACC_0_3_SECOND;
+}
+
+// the limits: speed multiplier, top altitude, invalid height and time
+static void fill_location_fast(ODID_Location_data &d)
+{
+    odid_initLocationData(&d);
+    d.Status = ODID_STATUS_AIRBORNE;
+    d.Direction = 90;
+    d.SpeedHorizontal = 100;
+    d.SpeedVertical = 62;
+    d.Latitude = -33.8567844;
+    d.Longitude = 151.2152967;
+    d.AltitudeBaro = 31767.5;
+    d.AltitudeGeo = -1000;
+    d.HeightType = ODID_HEIGHT_REF_OVER_GROUND;
+    d.Height = -1000;
+    d.HorizAccuracy = ODID_HOR_ACC_UNKNOWN;
+    d.VertAccuracy = ODID_VER_ACC_UNKNOWN;
+    d.BaroAccuracy = ODID_VER_ACC_UNKNOWN;
+    d.SpeedAccuracy = ODID_SPEED_ACC_UNKNOWN;
+    d.TimeStamp = INV_TIMESTAMP;
+    d.TSAccuracy = ODID_TIME_ACC_UNKNOWN;
+}
+
+static void fill_self_id(ODID_SelfID_data &d)
+{
+    odid_initSelfIDData(&d);
+    d.DescType = ODID_DESC_TYPE_TEXT;
+    strcpy(d.Desc, "Maritime survey");
+}
+
+static void fill_system(ODID_System_data &d)
+{
+    odid_initSystemData(&d);
+    d.OperatorLocationType = ODID_OPERATOR_LOCATION_TYPE_TAKEOFF;
+    d.ClassificationType = ODID_CLASSIFICATION_TYPE_EU;
+    d.OperatorLatitude = 59.9127;
+    d.OperatorLongitude = 10.7461;
+    d.AreaCount = 1;
+    d.AreaRadius = 100;
+    d.AreaCeiling = 50;
+    d.AreaFloor = 0;
+    d.CategoryEU = ODID_CATEGORY_EU_OPEN;
+    d.ClassEU = ODID_CLASS_EU_CLASS_1;
+    d.OperatorAltitudeGeo = 5.0;
+    d.Timestamp = 123456789;
+}
+
+static void fill_operator_id(ODID_OperatorID_data &d)
+{
+    odid_initOperatorIDData(&d);
+    d.OperatorIdType = ODID_OPERATOR_ID;
+    strcpy(d.OperatorId, "FIN87astrdge12k8");
+}
+
+static bool test_golden_basic_id()
+{
+    ODID_BasicID_data d;
+    ODID_BasicID_encoded enc;
+    fill_basic_id(d);
+    TEST_ASSERT_EQUAL(ODID_SUCCESS, encodeBasicIDMessage(&enc, &d), "encode");
+    TEST_ASSERT_BYTES_EQUAL(golden_basic_id, &enc, ODID_MESSAGE_SIZE, "BasicID");
+    return true;
+}
+
+static bool test_golden_location()
+{
+    ODID_Location_data d;
+    ODID_Location_encoded enc;
+    fill_location(d);
+    TEST_ASSERT_EQUAL(ODID_SUCCESS, encodeLocationMessage(&enc, &d), "encode");
+    TEST_ASSERT_BYTES_EQUAL(golden_location, &enc, ODID_MESSAGE_SIZE, "Location");
+    fill_location_fast(d);
+    TEST_ASSERT_EQUAL(ODID_SUCCESS, encodeLocationMessage(&enc, &d), "encode fast");
+    TEST_ASSERT_BYTES_EQUAL(golden_location_fast, &enc, ODID_MESSAGE_SIZE, "Location fast");
+    return true;
+}
+
+static bool test_golden_self_id()
+{
+    ODID_SelfID_data d;
+    ODID_SelfID_encoded enc;
+    fill_self_id(d);
+    TEST_ASSERT_EQUAL(ODID_SUCCESS, encodeSelfIDMessage(&enc, &d), "encode");
+    TEST_ASSERT_BYTES_EQUAL(golden_self_id, &enc, ODID_MESSAGE_SIZE, "SelfID");
+    return true;
+}
+
+static bool test_golden_system()
+{
+    ODID_System_data d;
+    ODID_System_encoded enc;
+    fill_system(d);
+    TEST_ASSERT_EQUAL(ODID_SUCCESS, encodeSystemMessage(&enc, &d), "encode");
+    TEST_ASSERT_BYTES_EQUAL(golden_system, &enc, ODID_MESSAGE_SIZE, "System");
+    return true;
+}
+
+static bool test_golden_operator_id()
+{
+    ODID_OperatorID_data d;
+    ODID_OperatorID_encoded enc;
+    fill_operator_id(d);
+    TEST_ASSERT_EQUAL(ODID_SUCCESS, encodeOperatorIDMessage(&enc, &d), "encode");
+    TEST_ASSERT_BYTES_EQUAL(golden_operator_id, &enc, ODID_MESSAGE_SIZE, "OperatorID");
+    return true;
+}
+
+static bool test_golden_pack()
+{
+    static ODID_UAS_Data uas;
+    odid_initUasData(&uas);
+    fill_basic_id(uas.BasicID[0]);
+    fill_location(uas.Location);
+    fill_system(uas.System);
+    uas.BasicIDValid[0] = 1;
+    uas.LocationValid = 1;
+    uas.SystemValid = 1;
+
+    uint8_t pack[sizeof(ODID_MessagePack_encoded)];
+    const int len = odid_message_build_pack(&uas, pack, sizeof(pack));
+    TEST_ASSERT_EQUAL(sizeof(golden_pack), len, "pack length");
+    TEST_ASSERT_BYTES_EQUAL(golden_pack, pack, sizeof(golden_pack), "pack");
+    return true;
+}
+
+// decoding the reference bytes gives the source values back to the field resolution
+static bool test_decode_golden()
+{
+    static ODID_UAS_Data uas;
+    odid_initUasData(&uas);
+    uint8_t pack[sizeof(golden_pack)];
+    memcpy(pack, golden_pack, sizeof(pack));
+    TEST_ASSERT_EQUAL(ODID_SUCCESS, decodeMessagePack(&uas, (ODID_MessagePack_encoded *)pack), "decode pack");
+    TEST_ASSERT(uas.BasicIDValid[0] && uas.LocationValid && uas.SystemValid, "valid flags");
+    TEST_ASSERT(!uas.SelfIDValid && !uas.OperatorIDValid, "absent messages stay invalid");
+
+    TEST_ASSERT_STRING_EQUAL("ONRID-240AC4000001", uas.BasicID[0].UASID, "UASID");
+    TEST_ASSERT_EQUAL(ODID_UATYPE_HELICOPTER_OR_MULTIROTOR, uas.BasicID[0].UAType, "UAType");
+
+    const ODID_Location_data &loc = uas.Location;
+    TEST_ASSERT_FLOAT_EQUAL(215, loc.Direction, 0.001, "Direction");
+    TEST_ASSERT_FLOAT_EQUAL(12.25, loc.SpeedHorizontal, 0.001, "SpeedHorizontal");
+    TEST_ASSERT_FLOAT_EQUAL(-1.5, loc.SpeedVertical, 0.001, "SpeedVertical");
+    TEST_ASSERT_FLOAT_EQUAL(59.9138688, loc.Latitude, 1e-7, "Latitude");
+    TEST_ASSERT_FLOAT_EQUAL(10.7522454, loc.Longitude, 1e-7, "Longitude");
+    TEST_ASSERT_FLOAT_EQUAL(12.5, loc.AltitudeBaro, 0.001, "AltitudeBaro");
+    TEST_ASSERT_FLOAT_EQUAL(15.0, loc.AltitudeGeo, 0.001, "AltitudeGeo");
+    TEST_ASSERT_FLOAT_EQUAL(3.5, loc.Height, 0.001, "Height");
+    TEST_ASSERT_FLOAT_EQUAL(1234.5, loc.TimeStamp, 0.001, "TimeStamp");
+    TEST_ASSERT_EQUAL(ODID_HOR_ACC_3_METER, loc.HorizAccuracy, "HorizAccuracy");
+    TEST_ASSERT_EQUAL(ODID_VER_ACC_10_METER, loc.BaroAccuracy, "BaroAccuracy");
+
+    const ODID_System_data &sys = uas.System;
+    TEST_ASSERT_FLOAT_EQUAL(59.9127, sys.OperatorLatitude, 1e-7, "OperatorLatitude");
+    TEST_ASSERT_EQUAL(100, sys.AreaRadius, "AreaRadius");
+    TEST_ASSERT_FLOAT_EQUAL(50, sys.AreaCeiling, 0.001, "AreaCeiling");
+    TEST_ASSERT_EQUAL(ODID_CLASS_EU_CLASS_1, sys.ClassEU, "ClassEU");
+    TEST_ASSERT_EQUAL(123456789, sys.Timestamp, "Timestamp");
+    return true;
+}
+
+static bool test_decode_limits()
+{
+    ODID_Location_data d;
+    ODID_Location_encoded enc;
+    memcpy(&enc, golden_location_fast, sizeof(enc));
+    TEST_ASSERT_EQUAL(ODID_SUCCESS, decodeLocationMessage(&d, &enc), "decode");
+    TEST_ASSERT_FLOAT_EQUAL(90, d.Direction, 0.001, "Direction");
+    // multiplier 1: 63.75 + 48*0.75
+    TEST_ASSERT_FLOAT_EQUAL(99.75, d.SpeedHorizontal, 0.001, "SpeedHorizontal");
+    TEST_ASSERT_FLOAT_EQUAL(62, d.SpeedVertical, 0.001, "SpeedVertical");
+    TEST_ASSERT_FLOAT_EQUAL(31767.5, d.AltitudeBaro, 0.001, "AltitudeBaro");
+    TEST_ASSERT_FLOAT_EQUAL(-1000, d.Height, 0.001, "Height");
+    TEST_ASSERT_FLOAT_EQUAL(INV_TIMESTAMP, d.TimeStamp, 0.001, "TimeStamp");
+    return true;
+}
+
+// out of range inputs are refused, as core-c does, rather than clamped
+static bool test_encode_rejects()
+{
+    ODID_Location_data d;
+    ODID_Location_encoded enc;
+    fill_location(d);
+    d.Direction = 360.5;
+    TEST_ASSERT_EQUAL(ODID_FAIL, encodeLocationMessage(&enc, &d), "Direction between max and invalid");
+    fill_location(d);
+    d.SpeedHorizontal = 254.5;
+    TEST_ASSERT_EQUAL(ODID_FAIL, encodeLocationMessage(&enc, &d), "SpeedHorizontal between max and invalid");
+    fill_location(d);
+    d.Latitude = 90.5;
+    TEST_ASSERT_EQUAL(ODID_FAIL, encodeLocationMessage(&enc, &d), "Latitude");
+    fill_location(d);
+    d.TimeStamp = 3600.5;
+    TEST_ASSERT_EQUAL(ODID_FAIL, encodeLocationMessage(&enc, &d), "TimeStamp");
+    fill_location(d);
+    d.Direction = INV_DIR;
+    d.SpeedHorizontal = INV_SPEED_H;
+    d.SpeedVertical = INV_SPEED_V;
+    TEST_ASSERT_EQUAL(ODID_SUCCESS, encodeLocationMessage(&enc, &d), "invalid markers are accepted");
+    return true;
+}
+
+/*
+  random data in range: decode(encode(x)) is within the resolution of
+  each field, and encoding the decoded data gives the same bytes
+ */
+static bool test_round_trip_random()
+{
+    std::mt19937 rng(1234);
+    auto uniform = [&rng](double lo, double hi) {
+        return std::uniform_real_distribution<double>(lo, hi)(rng);
+    };
+    auto pick = [&rng](int lo, int hi) {
+        return std::uniform_int_distribution<int>(lo, hi)(rng);
+    };
+
+    for (int i=0; i<20000; i++) {
+        ODID_Location_data in, out, again;
+        ODID_Location_encoded enc, enc2;
+        odid_initLocationData(&in);
+        in.Status = (ODID_status_t)pick(0, 4);
+        in.Direction = uniform(0, 359.4);
+        in.SpeedHorizontal = uniform(0, MAX_SPEED_H);
+        in.SpeedVertical = uniform(MIN_SPEED_V, MAX_SPEED_V);
+        in.Latitude = uniform(MIN_LAT, MAX_LAT);
+        in.Longitude = uniform(MIN_LON, MAX_LON);
+        in.AltitudeBaro = uniform(MIN_ALT, MAX_ALT);
+        in.AltitudeGeo = uniform(MIN_ALT, MAX_ALT);
+        in.HeightType = (ODID_Height_reference_t)pick(0, 1);
+        in.Height = uniform(MIN_ALT, MAX_ALT);
+        in.HorizAccuracy = (ODID_Horizontal_accuracy_t)pick(0, 12);
+        in.VertAccuracy = (ODID_Vertical_accuracy_t)pick(0, 6);
+        in.BaroAccuracy = (ODID_Vertical_accuracy_t)pick(0, 6);
+        in.SpeedAccuracy = (ODID_Speed_accuracy_t)pick(0, 4);
+        in.TimeStamp = uniform(0, MAX_TIMESTAMP);
+        in.TSAccuracy = (ODID_Timestamp_accuracy_t)pick(0, 15);
+
+        TEST_ASSERT_EQUAL(ODID_SUCCESS, encodeLocationMessage(&enc, &in), "encode");
+        TEST_ASSERT_EQUAL(ODID_SUCCESS, decodeLocationMessage(&out, &enc), "decode");
+        TEST_ASSERT_EQUAL(in.Status, out.Status, "Status");
+        TEST_ASSERT_FLOAT_EQUAL(in.Direction, out.Direction, 0.5001, "Direction");
+        TEST_ASSERT_FLOAT_EQUAL(in.SpeedHorizontal, out.SpeedHorizontal,
+                                in.SpeedHorizontal <= 63.75 ? 0.25 : 0.75, "SpeedHorizontal");
+        TEST_ASSERT_FLOAT_EQUAL(in.SpeedVertical, out.SpeedVertical, 0.5, "SpeedVertical");
+        TEST_ASSERT_FLOAT_EQUAL(in.Latitude, out.Latitude, 1e-7, "Latitude");
+        TEST_ASSERT_FLOAT_EQUAL(in.Longitude, out.Longitude, 1e-7, "Longitude");
+        TEST_ASSERT_FLOAT_EQUAL(in.AltitudeBaro, out.AltitudeBaro, 0.5, "AltitudeBaro");
+        TEST_ASSERT_FLOAT_EQUAL(in.AltitudeGeo, out.AltitudeGeo, 0.5, "AltitudeGeo");
+        TEST_ASSERT_FLOAT_EQUAL(in.Height, out.Height, 0.5, "Height");
+        TEST_ASSERT_FLOAT_EQUAL(in.TimeStamp, out.TimeStamp, 0.051, "TimeStamp");
+        TEST_ASSERT_EQUAL(in.HeightType, out.HeightType, "HeightType");
+        TEST_ASSERT_EQUAL(in.HorizAccuracy, out.HorizAccuracy, "HorizAccuracy");
+        TEST_ASSERT_EQUAL(in.VertAccuracy, out.VertAccuracy, "VertAccuracy");
+        TEST_ASSERT_EQUAL(in.BaroAccuracy, out.BaroAccuracy, "BaroAccuracy");
+        TEST_ASSERT_EQUAL(in.SpeedAccuracy, out.SpeedAccuracy, "SpeedAccuracy");
+        TEST_ASSERT_EQUAL(in.TSAccuracy, out.TSAccuracy, "TSAccuracy");
+
+        /*
+          decoded data encodes to the same values, though not always the
+          same bytes: lat/lon truncate, as core-c does, so n/1e7*1e7 may
+          land one below n, and 63.75m/s has two speed encodings
+         */
+        TEST_ASSERT_EQUAL(ODID_SUCCESS, encodeLocationMessage(&enc2, &out), "re-encode");
+        TEST_ASSERT_EQUAL(ODID_SUCCESS, decodeLocationMessage(&again, &enc2), "decode again");
+        TEST_ASSERT(again.Direction == out.Direction, "stable Direction");
+        TEST_ASSERT(again.SpeedHorizontal == out.SpeedHorizontal, "stable SpeedHorizontal");
+        TEST_ASSERT(again.SpeedVertical == out.SpeedVertical, "stable SpeedVertical");
+        TEST_ASSERT_FLOAT_EQUAL(out.Latitude, again.Latitude, 1.01e-7, "stable Latitude");
+        TEST_ASSERT_FLOAT_EQUAL(out.Longitude, again.Longitude, 1.01e-7, "stable Longitude");
+        TEST_ASSERT(again.AltitudeBaro == out.AltitudeBaro, "stable AltitudeBaro");
+        TEST_ASSERT(again.AltitudeGeo == out.AltitudeGeo, "stable AltitudeGeo");
+        TEST_ASSERT(again.Height == out.Height, "stable Height");
+        TEST_ASSERT(again.TimeStamp == out.TimeStamp, "stable TimeStamp");
+    }
+
+    for (int i=0; i<5000; i++) {
+        ODID_System_data in, out;
+        ODID_System_encoded enc, enc2;
+        odid_initSystemData(&in);
+        in.OperatorLocationType = (ODID_operator_location_type_t)pick(0, 2);
+        in.ClassificationType = (ODID_classification_type_t)pick(0, 1);
+        in.OperatorLatitude = uniform(MIN_LAT, MAX_LAT);
+        in.OperatorLongitude = uniform(MIN_LON, MAX_LON);
+        in.AreaCount = pick(1, 65535);
+        in.AreaRadius = pick(0, 255) * 10;
+        in.AreaCeiling = uniform(MIN_ALT, MAX_ALT);
+        in.AreaFloor = uniform(MIN_ALT, MAX_ALT);
+        in.CategoryEU = (ODID_category_EU_t)pick(0, 3);
+        in.ClassEU = (ODID_class_EU_t)pick(0, 7);
+        in.OperatorAltitudeGeo = uniform(MIN_ALT, MAX_ALT);
+        in.Timestamp = rng();
+
+        TEST_ASSERT_EQUAL(ODID_SUCCESS, encodeSystemMessage(&enc, &in), "encode");
+        TEST_ASSERT_EQUAL(ODID_SUCCESS, decodeSystemMessage(&out, &enc), "decode");
+        TEST_ASSERT_FLOAT_EQUAL(in.OperatorLatitude, out.OperatorLatitude, 1e-7, "OperatorLatitude");
+        TEST_ASSERT_FLOAT_EQUAL(in.OperatorLongitude, out.OperatorLongitude, 1e-7, "OperatorLongitude");
+        TEST_ASSERT_EQUAL(in.AreaCount, out.AreaCount, "AreaCount");
+        TEST_ASSERT_EQUAL(in.AreaRadius, out.AreaRadius, "AreaRadius");
+        TEST_ASSERT_FLOAT_EQUAL(in.AreaCeiling, out.AreaCeiling, 0.5, "AreaCeiling");
+        TEST_ASSERT_FLOAT_EQUAL(in.AreaFloor, out.AreaFloor, 0.5, "AreaFloor");
+        TEST_ASSERT_FLOAT_EQUAL(in.OperatorAltitudeGeo, out.OperatorAltitudeGeo, 0.5, "OperatorAltitudeGeo");
+        TEST_ASSERT_EQUAL(in.Timestamp, out.Timestamp, "Timestamp");
+        TEST_ASSERT_EQUAL(ODID_SUCCESS, encodeSystemMessage(&enc2, &out), "re-encode");
+        TEST_ASSERT(abs(enc.OperatorLatitude - enc2.OperatorLatitude) <= 1, "re-encoded OperatorLatitude");
+        TEST_ASSERT(abs(enc.OperatorLongitude - enc2.OperatorLongitude) <= 1, "re-encoded OperatorLongitude");
+        enc2.OperatorLatitude = enc.OperatorLatitude;
+        enc2.OperatorLongitude = enc.OperatorLongitude;
+        TEST_ASSERT_BYTES_EQUAL(&enc, &enc2, sizeof(enc), "re-encoded System");
+    }
+    return true;
+}
+
+// the text fields fill the message and are NUL terminated when decoded
+static bool test_round_trip_text()
+{
+    ODID_BasicID_data bid, bid_out;
+    ODID_BasicID_encoded bid_enc;
+    odid_initBasicIDData(&bid);
+    memset(bid.UASID, 'A', ODID_ID_SIZE);
+    TEST_ASSERT_EQUAL(ODID_SUCCESS, encodeBasicIDMessage(&bid_enc, &bid), "encode BasicID");
+    TEST_ASSERT_EQUAL(ODID_SUCCESS, decodeBasicIDMessage(&bid_out, &bid_enc), "decode BasicID");
+    TEST_ASSERT_EQUAL(ODID_ID_SIZE, strlen(bid_out.UASID), "full UASID");
+
+    ODID_SelfID_data sid, sid_out;
+    ODID_SelfID_encoded sid_enc;
+    fill_self_id(sid);
+    TEST_ASSERT_EQUAL(ODID_SUCCESS, encodeSelfIDMessage(&sid_enc, &sid), "encode SelfID");
+    TEST_ASSERT_EQUAL(ODID_SUCCESS, decodeSelfIDMessage(&sid_out, &sid_enc), "decode SelfID");
+    TEST_ASSERT_STRING_EQUAL(sid.Desc, sid_out.Desc, "Desc");
+
+    ODID_OperatorID_data oid, oid_out;
+    ODID_OperatorID_encoded oid_enc;
+    fill_operator_id(oid);
+    TEST_ASSERT_EQUAL(ODID_SUCCESS, encodeOperatorIDMessage(&oid_enc, &oid), "encode OperatorID");
+    TEST_ASSERT_EQUAL(ODID_SUCCESS, decodeOperatorIDMessage(&oid_out, &oid_enc), "decode OperatorID");
+    TEST_ASSERT_STRING_EQUAL(oid.OperatorId, oid_out.OperatorId, "OperatorId");
+    return true;
+}
+
+// a decoder refuses a message of another type
+static bool test_decode_wrong_type()
+{
+    ODID_Location_data d;
+    ODID_Location_encoded enc;
+    memcpy(&enc, golden_basic_id, sizeof(enc));
+    TEST_ASSERT_EQUAL(ODID_FAIL, decodeLocationMessage(&d, &enc), "BasicID bytes as Location");
+    return true;
+}
+
+int main(void)
+{
+    TEST_RUN(test_golden_basic_id);
+    TEST_RUN(test_golden_location);
+    TEST_RUN(test_golden_self_id);
+    TEST_RUN(test_golden_system);
+    TEST_RUN(test_golden_operator_id);
+    TEST_RUN(test_golden_pack);
+    TEST_RUN(test_decode_golden);
+    TEST_RUN(test_decode_limits);
+    TEST_RUN(test_encode_rejects);
+    TEST_RUN(test_round_trip_random);
+    TEST_RUN(test_round_trip_text);
+    TEST_RUN(test_decode_wrong_type);
+    return test_result();
+}
@@ -0,0 +1,347 @@
+/*
+  parameter storage on the simulated NVS: the write-behind batching,
+  a set made while a flush runs, the boot snapshot, and what a boot
+  finds after power is cut at each step of a flush
+ */
+
+#include "test.h"
+#include "parameters.h"
+#include <host.h>
+
+typedef std::map<std::string, std::vector<uint8_t>> NVS_Keys;
+
+// NVS contents after each write and commit, with its log entry
+struct NVS_Step {
+    std::string entry;
+    NVS_Keys keys;
+};
+
+static std::string nvs_log(void)
+{
+    std::string s;
+    for (const auto &e : host_nvs.log) {
+        s += s.empty() ? e : " " + e;
+    }
+    return s;
+}
+
+static void record_steps(std::vector<NVS_Step> &steps)
+{
+    host_nvs.on_write = [&steps](const std::string &entry) {
+        steps.push_back({entry, host_nvs.keys});
+    };
+}
+
+/*
+  boot with the given NVS contents. The statics of parameters.cpp
+  outlive g, so sets pending from the previous boot are flushed into
+  the NVS being replaced first
+ */
+static void reboot(const NVS_Keys &keys)
+{
+    host_nvs.on_write = nullptr;
+    Parameters::flush();
+    host_nvs.keys = keys;
+    host_nvs.log.clear();
+    host_nvs.reads = 0;
+    g = Parameters();
+    g.init();
+}
+
+static void run_ms(uint32_t ms)
+{
+    host_advance_us(ms * 1000ULL);
+    g.update();
+}
+
+// first boot stores the keys, then DONE_INIT, then the snapshot, in one commit
+static bool test_first_boot()
+{
+    host_nvs.clear();
+    reboot(NVS_Keys());
+    TEST_ASSERT_EQUAL(1, host_nvs.commits, "one commit");
+    // the public keys ROMFS holds go before DONE_INIT
+    const std::string log = nvs_log();
+    TEST_ASSERT(log.size() >= 27 && log.compare(log.size() - 27, 27, "DONE_INIT PARAM_SNAP COMMIT") == 0,
+                "DONE_INIT after the keys, snapshot last");
+    TEST_ASSERT_EQUAL(1, g.done_init, "done");
+
+    reboot(host_nvs.keys);
+    TEST_ASSERT(Parameters::get_loaded_snapshot(), "second boot loads the snapshot");
+    TEST_ASSERT_EQUAL(1, host_nvs.reads, "with one read");
+    TEST_ASSERT(host_nvs.log.empty(), "and writes nothing");
+    return true;
+}
+
+// power cut at any step of the first boot: the next boot finishes it
+static bool test_first_boot_cut()
+{
+    host_nvs.clear();
+    g = Parameters();
+    std::vector<NVS_Step> first;
+    record_steps(first);
+    g.init();
+    host_nvs.on_write = nullptr;
+    TEST_ASSERT(first.size() >= 3, "steps recorded");
+    const std::string key1 = g.public_keys[0].b64_key;
+    for (const auto &s : first) {
+        reboot(s.keys);
+        TEST_ASSERT_EQUAL(1, g.done_init, "done after the next boot");
+        TEST_ASSERT_STRING_EQUAL(key1.c_str(), g.public_keys[0].b64_key, "public key installed");
+        reboot(host_nvs.keys);
+        TEST_ASSERT(Parameters::get_loaded_snapshot(), "snapshot good after the next boot");
+        TEST_ASSERT_EQUAL(1, g.done_init, "done from the snapshot");
+    }
+    return true;
+}
+
+/*
+  sets reach NVS once they have been quiet for a second, in the order
+  parameters were first set, as one batch and one commit
+ */
+static bool test_write_behind_quiet()
+{
+    host_nvs.clear();
+    reboot(NVS_Keys());
+    host_nvs.log.clear();
+    host_nvs.writes = host_nvs.commits = 0;
+
+    // 2s of a bulk upload to three parameters
+    for (int i=0; i<200; i++) {
+        g.set_by_name_string("BT4_RATE", "2");
+        g.set_by_name_uint8("WIFI_CHANNEL", 1 + i % 13);
+        if (i == 50) {
+            g.set_by_name_string("UAS_ID", "BOAT1");
+        }
+        run_ms(10);
+    }
+    TEST_ASSERT_EQUAL(0, host_nvs.writes, "nothing stored while sets keep coming");
+    run_ms(989);
+    TEST_ASSERT_EQUAL(0, host_nvs.writes, "nothing stored before a second of quiet");
+    run_ms(1);
+    TEST_ASSERT_STRING_EQUAL("BT4_RATE WIFI_CHANNEL UAS_ID PARAM_SNAP COMMIT", nvs_log().c_str(), "one batch");
+    TEST_ASSERT_EQUAL(1 + 199 % 13, host_nvs.keys["WIFI_CHANNEL"][0], "last value stored");
+    TEST_ASSERT_STRING_EQUAL("BOAT1", (const char *)host_nvs.keys["UAS_ID"].data(), "string stored");
+
+    // nothing pending, nothing stored
+    run_ms(5000);
+    Parameters::flush();
+    TEST_ASSERT_EQUAL(1, host_nvs.commits, "no empty batches");
+    return true;
+}
+
+// sets that never go quiet are still stored every 5s
+static bool test_write_behind_max_delay()
+{
+    host_nvs.clear();
+    reboot(NVS_Keys());
+    host_nvs.commits = 0;
+    std::vector<uint64_t> commit_ms;
+    host_nvs.on_write = [&commit_ms](const std::string &entry) {
+        if (entry == "COMMIT") {
+            commit_ms.push_back(host_time_us() / 1000);
+        }
+    };
+    const uint64_t start_ms = host_time_us() / 1000;
+    for (int i=0; i<1000; i++) {
+        g.set_by_name_uint8("WIFI_CHANNEL", 3);
+        run_ms(10);
+    }
+    TEST_ASSERT_EQUAL(2, commit_ms.size(), "a batch every 5s");
+    TEST_ASSERT_EQUAL(start_ms + 5000, commit_ms[0], "first batch at 5s");
+    TEST_ASSERT_EQUAL(start_ms + 10000, commit_ms[1], "second batch at 10s");
+    return true;
+}
+
+/*
+  a parameter set while a flush runs is queued again: the flush
+  stores the value it started with, the next one the final value
+ */
+static bool test_set_during_flush()
+{
+    host_nvs.clear();
+    reboot(NVS_Keys());
+    host_nvs.log.clear();
+    g.set_by_name_uint8("WIFI_CHANNEL", 5);
+    g.set_by_name_string("BT5_RATE", "2");
+    bool set = false;
+    host_nvs.on_write = [&set](const std::string &entry) {
+        if (entry == "WIFI_CHANNEL" && !set) {
+            set = true;
+            g.set_by_name_uint8("WIFI_CHANNEL", 7);
+        }
+    };
+    Parameters::flush();
+    TEST_ASSERT(set, "set during the flush");
+    TEST_ASSERT_STRING_EQUAL("WIFI_CHANNEL BT5_RATE PARAM_SNAP COMMIT", nvs_log().c_str(), "first batch");
+    TEST_ASSERT_EQUAL(5, host_nvs.keys["WIFI_CHANNEL"][0], "value the flush started with");
+
+    host_nvs.log.clear();
+    run_ms(999);
+    TEST_ASSERT(host_nvs.log.empty(), "queued again, waiting for quiet");
+    run_ms(1);
+    TEST_ASSERT_STRING_EQUAL("WIFI_CHANNEL PARAM_SNAP COMMIT", nvs_log().c_str(), "second batch");
+    TEST_ASSERT_EQUAL(7, host_nvs.keys["WIFI_CHANNEL"][0], "final value");
+
+    // the per-key values agree with the snapshot
+    NVS_Keys keys = host_nvs.keys;
+    keys.erase("PARAM_SNAP");
+    reboot(keys);
+    TEST_ASSERT(!Parameters::get_loaded_snapshot(), "keys only");
+    TEST_ASSERT_EQUAL(7, g.wifi_channel, "final value from the keys");
+    TEST_ASSERT_FLOAT_EQUAL(2, g.bt5_rate, 0, "from the keys");
+    return true;
+}
+
+/*
+  power cut at each step of a flush. The snapshot is written after
+  the keys and loaded first, so a boot sees all of the batch or none
+  of it
+ */
+static bool test_flush_cut()
+{
+    host_nvs.clear();
+    reboot(NVS_Keys());
+    g.set_by_name_string("UAS_ID", "OLD");
+    g.set_by_name_uint8("WIFI_CHANNEL", 2);
+    g.set_by_name_string("BT4_POWER", "1.5");
+    Parameters::flush();
+
+    g.set_by_name_string("UAS_ID", "BOAT42");
+    g.set_by_name_uint8("WIFI_CHANNEL", 9);
+    g.set_by_name_string("BT4_POWER", "-3.5");
+    std::vector<NVS_Step> batch;
+    record_steps(batch);
+    Parameters::flush();
+    TEST_ASSERT_EQUAL(5, batch.size(), "three keys, snapshot, commit");
+
+    bool snapshot_written = false;
+    for (const auto &s : batch) {
+        snapshot_written |= s.entry == "PARAM_SNAP";
+        reboot(s.keys);
+        TEST_ASSERT(Parameters::get_loaded_snapshot(), "a good snapshot at every step");
+        if (snapshot_written) {
+            TEST_ASSERT_STRING_EQUAL("BOAT42", g.uas_id, "new batch");
+            TEST_ASSERT_EQUAL(9, g.wifi_channel, "new batch");
+            TEST_ASSERT_FLOAT_EQUAL(-3.5, g.bt4_power, 0, "new batch");
+        } else {
+            TEST_ASSERT_STRING_EQUAL("OLD", g.uas_id, "old batch");
+            TEST_ASSERT_EQUAL(2, g.wifi_channel, "old batch");
+            TEST_ASSERT_FLOAT_EQUAL(1.5, g.bt4_power, 0, "old batch");
+        }
+    }
+    return true;
+}
+
+/*
+  a snapshot that doesn't match falls back to the keys, and update()
+  writes a new one straight away, along with any pending sets
+ */
+static bool test_snapshot_fallback()
+{
+    host_nvs.clear();
+    reboot(NVS_Keys());
+    g.set_by_name_string("UAS_ID", "BOAT42");
+    g.set_by_name_uint8("WIFI_CHANNEL", 9);
+    Parameters::flush();
+    const NVS_Keys good = host_nvs.keys;
+
+    // a value byte flipped
+    NVS_Keys keys = good;
+    keys["PARAM_SNAP"][20] ^= 0x55;
+    reboot(keys);
+    TEST_ASSERT(!Parameters::get_loaded_snapshot(), "bad CRC");
+    TEST_ASSERT(host_nvs.reads > 1, "loaded per key");
+    TEST_ASSERT_STRING_EQUAL("BOAT42", g.uas_id, "from the keys");
+    TEST_ASSERT_EQUAL(9, g.wifi_channel, "from the keys");
+    g.set_by_name_uint8("WIFI_CHANNEL", 4);
+    g.update();
+    TEST_ASSERT_STRING_EQUAL("WIFI_CHANNEL PARAM_SNAP COMMIT", nvs_log().c_str(),
+                             "rewritten at once, with the pending set");
+    reboot(host_nvs.keys);
+    TEST_ASSERT(Parameters::get_loaded_snapshot(), "rewritten");
+    TEST_ASSERT_EQUAL(4, g.wifi_channel, "from the snapshot");
+
+    // an older firmware's layout
+    keys = good;
+    keys["PARAM_SNAP"][0] ^= 1;
+    reboot(keys);
+    TEST_ASSERT(!Parameters::get_loaded_snapshot(), "other layout");
+    TEST_ASSERT_EQUAL(9, g.wifi_channel, "from the keys");
+    g.update();
+    TEST_ASSERT_STRING_EQUAL("PARAM_SNAP COMMIT", nvs_log().c_str(), "rewritten at once");
+
+    // truncated
+    keys = good;
+    keys["PARAM_SNAP"].resize(40);
+    reboot(keys);
+    TEST_ASSERT(!Parameters::get_loaded_snapshot(), "truncated");
+    TEST_ASSERT_EQUAL(9, g.wifi_channel, "from the keys");
+
+    // missing
+    keys = good;
+    keys.erase("PARAM_SNAP");
+    reboot(keys);
+    TEST_ASSERT(!Parameters::get_loaded_snapshot(), "missing");
+    TEST_ASSERT_STRING_EQUAL("BOAT42", g.uas_id, "from the keys");
+    return true;
+}
+
+/*
+  a firmware update that changes the default of a parameter never set:
+  the old firmware's snapshot holds its old default, and its layout
+  differs, so the boot takes the new default and keeps the sets
+ */
+static bool test_snapshot_default_changed()
+{
+    // the old firmware's table, WIFI_CHANNEL defaulting to 11
+    std::vector<Parameters::Param> old_table;
+    for (uint16_t i=0; Parameters::params[i].ptype != Parameters::ParamType::NONE; i++) {
+        old_table.push_back(Parameters::params[i]);
+    }
+    old_table.push_back(Parameters::Param {});
+    const int16_t channel = Parameters::find("WIFI_CHANNEL") - Parameters::params;
+    old_table[channel].default_value = 11;
+    const uint32_t old_layout = Parameters::snapshot_layout(old_table.data());
+    TEST_ASSERT(old_layout != Parameters::snapshot_layout(Parameters::params), "default in the layout");
+    old_table[channel].default_value = Parameters::params[channel].default_value;
+    TEST_ASSERT_EQUAL(Parameters::snapshot_layout(Parameters::params), Parameters::snapshot_layout(old_table.data()),
+                      "same table");
+    old_table[channel].max_value = 14;
+    TEST_ASSERT(Parameters::snapshot_layout(old_table.data()) != Parameters::snapshot_layout(Parameters::params),
+                "range in the layout");
+
+    // what the old firmware stored: UAS_ID set, WIFI_CHANNEL at its default
+    host_nvs.clear();
+    reboot(NVS_Keys());
+    g.set_by_name_string("UAS_ID", "BOAT42");
+    g.set_by_name_uint8("WIFI_CHANNEL", 11);
+    Parameters::flush();
+    NVS_Keys keys = host_nvs.keys;
+    keys.erase("WIFI_CHANNEL");
+    memcpy(keys["PARAM_SNAP"].data(), &old_layout, sizeof(old_layout));
+
+    reboot(keys);
+    TEST_ASSERT(!Parameters::get_loaded_snapshot(), "old firmware's snapshot");
+    TEST_ASSERT_EQUAL(6, g.wifi_channel, "new default");
+    TEST_ASSERT_STRING_EQUAL("BOAT42", g.uas_id, "set kept");
+    g.update();
+    reboot(host_nvs.keys);
+    TEST_ASSERT(Parameters::get_loaded_snapshot(), "rewritten");
+    TEST_ASSERT_EQUAL(6, g.wifi_channel, "new default from the snapshot");
+    TEST_ASSERT_STRING_EQUAL("BOAT42", g.uas_id, "set from the snapshot");
+    return true;
+}
+
+int main(void)
+{
+    TEST_RUN(test_first_boot);
+    TEST_RUN(test_first_boot_cut);
+    TEST_RUN(test_write_behind_quiet);
+    TEST_RUN(test_write_behind_max_delay);
+    TEST_RUN(test_set_during_flush);
+    TEST_RUN(test_flush_cut);
+    TEST_RUN(test_snapshot_fallback);
+    TEST_RUN(test_snapshot_default_changed);
+    return test_result();
+}
@@ -0,0 +1,87 @@
+/*
+  the UART ingest ring: partial writes when full, reads across the
+  wrap, and a producer and a consumer thread as the UART event task
+  and the ingest task
+ */
+
+#include "test.h"
+#include "ring_buffer.h"
+#include <thread>
+
+static bool test_full_and_wrap()
+{
+    static Ring_Buffer<16> ring;
+    uint8_t in[32], out[32];
+    for (uint8_t i=0; i<sizeof(in); i++) {
+        in[i] = i;
+    }
+    TEST_ASSERT_EQUAL(0, ring.read(out, sizeof(out)), "empty");
+    TEST_ASSERT_EQUAL(16, ring.write(in, sizeof(in)), "only what fits");
+    TEST_ASSERT_EQUAL(0, ring.space(), "full");
+    TEST_ASSERT_EQUAL(0, ring.write(in, 1), "nothing more");
+
+    // the next 12 bytes go round the end of the buffer
+    TEST_ASSERT_EQUAL(10, ring.read(out, 10), "partial read");
+    TEST_ASSERT_BYTES_EQUAL(in, out, 10, "first bytes");
+    TEST_ASSERT_EQUAL(10, ring.write(&in[16], 12), "into the space freed");
+    TEST_ASSERT_EQUAL(16, ring.available(), "full again");
+    TEST_ASSERT_EQUAL(16, ring.read(out, sizeof(out)), "read across the wrap");
+    TEST_ASSERT_BYTES_EQUAL(&in[10], out, 16, "in order");
+    return true;
+}
+
+/*
+  4M bytes through a 1k ring in bursts of odd sizes, each byte the
+  low bits of its position, so a lost, doubled or reordered byte shows
+ */
+static bool test_threads()
+{
+    static Ring_Buffer<1024> ring;
+    const uint32_t total = 4*1024*1024;
+    std::thread producer([&] {
+        uint8_t burst[97];
+        uint32_t sent = 0, len = 1;
+        while (sent < total) {
+            len = (len * 7 + 3) % sizeof(burst) + 1;
+            if (len > total - sent) {
+                len = total - sent;
+            }
+            for (uint32_t i=0; i<len; i++) {
+                burst[i] = uint8_t((sent + i) * 131);
+            }
+            uint32_t done = 0;
+            while (done < len) {
+                const uint32_t n = ring.write(&burst[done], len - done);
+                if (n == 0) {
+                    std::this_thread::yield();
+                }
+                done += n;
+            }
+            sent += len;
+        }
+    });
+    uint8_t block[128];
+    uint32_t received = 0;
+    bool in_order = true;
+    while (received < total) {
+        const uint32_t n = ring.read(block, sizeof(block));
+        if (n == 0) {
+            std::this_thread::yield();
+        }
+        for (uint32_t i=0; i<n; i++) {
+            in_order &= block[i] == uint8_t((received + i) * 131);
+        }
+        received += n;
+    }
+    producer.join();
+    TEST_ASSERT(in_order, "bytes in order");
+    TEST_ASSERT_EQUAL(0, ring.available(), "drained");
+    return true;
+}
+
+int main(void)
+{
+    TEST_RUN(test_full_and_wrap);
+    TEST_RUN(test_threads);
+    return test_result();
+}
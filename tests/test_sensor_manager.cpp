@@ -0,0 +1,140 @@
+/*
+  the sensor manager over the drivers on the fake I2C bus: each source
+  at its own rate, the AHRS on every IMU sample, readers of the table never touching a sensor, and
+  the case switch interrupt
+ */
+
+#include "test.h"
+#include "sensor_manager.h"
+#include "board_config_maritime.h"
+#include "sensor_images.h"
+
+static LSM6DS3_FIFO_Model fifo;
+
+/*
+  data ticks with the bus task run every millisecond between them. The
+  fake bus takes time, so a tick waits for its deadline
+ */
+static void run_ticks(uint32_t ticks, uint32_t tick_ms=100)
+{
+    for (uint32_t t=0; t<ticks; t++) {
+        const uint32_t deadline_ms = millis() + tick_ms;
+        while (millis() < deadline_ms) {
+            host_advance_us(1000);
+            fifo.fill();
+            sensor_bus.run();
+        }
+        sensor_manager.update(millis());
+    }
+}
+
+static bool test_setup()
+{
+    BME280_Trim trim;
+    bme280_image(Wire.chips[BME280_ADDR], trim);
+    const int16_t zero[3] {}, mag[3] { 1000, -500, 2000 };
+    Fake_Chip &imu_chip = Wire.chips[LSM6DS3_ADDR];
+    lsm6ds3_image(imu_chip, zero, zero);
+    fifo.attach(imu_chip);
+    fifo.int1_pin = PIN_IMU_INT1;
+    lis3mdl_image(Wire.chips[LIS3MDL_ADDR], mag);
+    host_set_analog_mv(PIN_BATTERY_MONITOR, 1900);
+    host_set_pin(PIN_CASE_DETECT, LOW);
+
+    setup_maritime_sensors();
+    sensor_bus.run();
+    TEST_ASSERT(env_sensor.healthy() && imu_sensor.healthy() && mag_sensor.healthy(), "all set up");
+    fifo.reset(host_time_us());
+    return true;
+}
+
+/*
+  20s of data ticks: the environment at 1Hz, the magnetometer at
+  10Hz, the battery at 2Hz and the IMU at its FIFO rate
+ */
+static bool test_rates()
+{
+    typedef Sensor_Manager::Source Source;
+    // a source is read every tick until its first sample arrives
+    run_ticks(10);
+    const uint32_t env_reads = Wire.chips[BME280_ADDR].reads;
+    const uint32_t mag_reads = Wire.chips[LIS3MDL_ADDR].reads;
+    run_ticks(200);
+    TEST_ASSERT_FLOAT_EQUAL(1, sensor_manager.get_rate_hz(Source::ENVIRONMENT), 0.02, "environment");
+    TEST_ASSERT_FLOAT_EQUAL(10, sensor_manager.get_rate_hz(Source::MAG), 0.2, "mag");
+    TEST_ASSERT_FLOAT_EQUAL(2, sensor_manager.get_rate_hz(Source::BATTERY), 0.05, "battery");
+    TEST_ASSERT_FLOAT_EQUAL(208, sensor_manager.get_rate_hz(Source::IMU), 10, "imu");
+    TEST_ASSERT_FLOAT_EQUAL(208, sensor_manager.get_rate_hz(Source::ATTITUDE), 10, "AHRS on every IMU sample");
+    TEST_ASSERT_EQUAL(20, Wire.chips[BME280_ADDR].reads - env_reads, "one BME280 read a second");
+    TEST_ASSERT_EQUAL(200, Wire.chips[LIS3MDL_ADDR].reads - mag_reads, "one LIS3MDL read a tick");
+    TEST_ASSERT(sensor_manager.get_bus_us(Source::ENVIRONMENT) > 0, "environment bus time");
+    TEST_ASSERT(sensor_manager.get_bus_us(Source::MAG) > sensor_manager.get_bus_us(Source::ENVIRONMENT),
+                "mag bus time");
+
+    MaritimeSensorData data;
+    sensor_manager.get(data);
+    // 1.9V on the pin behind the 2:1 divider
+    TEST_ASSERT_FLOAT_EQUAL(3.8, data.battery_voltage, 0.01, "battery voltage");
+    TEST_ASSERT_EQUAL(millis(), data.timestamp_ms, "table time");
+    TEST_ASSERT(data.attitude_valid && data.heading_valid, "attitude and heading");
+    return true;
+}
+
+/*
+  ticks 4ms short land within the slack before a period ends: the read
+  starts then but the period keeps its phase, so 48s of ticks make 48
+  environment and 480 magnetometer reads
+ */
+static bool test_short_ticks()
+{
+    const uint32_t env_reads = Wire.chips[BME280_ADDR].reads;
+    const uint32_t mag_reads = Wire.chips[LIS3MDL_ADDR].reads;
+    run_ticks(500, 96);
+    TEST_ASSERT(abs(int32_t(Wire.chips[BME280_ADDR].reads - env_reads) - 48) <= 1, "BME280");
+    TEST_ASSERT(abs(int32_t(Wire.chips[LIS3MDL_ADDR].reads - mag_reads) - 480) <= 1, "LIS3MDL");
+    return true;
+}
+
+// a reader of the table causes no bus traffic and no ADC read
+static bool test_readers()
+{
+    const uint32_t transactions = Wire.transactions;
+    const uint32_t battery_ms = sensor_manager.get_sample_ms(Sensor_Manager::Source::BATTERY);
+    MaritimeSensorData data;
+    for (uint16_t i=0; i<100; i++) {
+        host_advance_us(10000);
+        sensor_manager.get(data);
+    }
+    TEST_ASSERT_EQUAL(transactions, Wire.transactions, "no I2C");
+    TEST_ASSERT_EQUAL(battery_ms, sensor_manager.get_sample_ms(Sensor_Manager::Source::BATTERY), "no ADC");
+    return true;
+}
+
+// a case open edge reaches the table with its time on the next tick
+static bool test_case()
+{
+    host_advance_us(20000);
+    const uint32_t open_ms = millis();
+    host_set_pin(PIN_CASE_DETECT, HIGH);
+    run_ticks(1);
+    MaritimeSensorData data;
+    sensor_manager.get(data);
+    TEST_ASSERT(data.case_tamper_detected, "case open");
+    TEST_ASSERT_EQUAL(open_ms, sensor_manager.get_sample_ms(Sensor_Manager::Source::CASE), "edge time");
+
+    host_set_pin(PIN_CASE_DETECT, LOW);
+    run_ticks(1);
+    sensor_manager.get(data);
+    TEST_ASSERT(!data.case_tamper_detected, "case closed");
+    return true;
+}
+
+int main(void)
+{
+    TEST_RUN(test_setup);
+    TEST_RUN(test_rates);
+    TEST_RUN(test_short_ticks);
+    TEST_RUN(test_readers);
+    TEST_RUN(test_case);
+    return test_result();
+}
@@ -0,0 +1,107 @@
+/*
+  stage timing histograms: exact buckets below 8us, the quarter power
+  of two buckets above with their upper edge capped at the window max,
+  the 10s window and nested scopes
+ */
+
+#include "test.h"
+#include "stage_timing.h"
+
+#define WINDOW_US 10000000ULL
+
+/*
+  records only land in the results once the next window starts, and
+  the 0us record that starts it counts in that window
+ */
+static void end_window(Stage_Timer &t)
+{
+    host_advance_us(WINDOW_US);
+    t.record(0);
+}
+
+static bool test_exact()
+{
+    static Stage_Timer t("exact");
+    end_window(t);
+    for (uint32_t us=0; us<8; us++) {
+        for (uint32_t i=0; i<10; i++) {
+            t.record(us);
+        }
+    }
+    TEST_ASSERT_EQUAL(0, t.get_count(), "nothing before the window ends");
+    end_window(t);
+    TEST_ASSERT_EQUAL(81, t.get_count(), "count");
+    TEST_ASSERT_EQUAL(3, t.get_p50_us(), "p50");
+    TEST_ASSERT_EQUAL(7, t.get_p99_us(), "p99");
+    TEST_ASSERT_EQUAL(7, t.get_max_us(), "max");
+    return true;
+}
+
+/*
+  1..1000us once each: p50 is 500us in the 448-511 bucket and p99 is
+  990us in the 896-1023 bucket, capped at the 1000us max
+ */
+static bool test_buckets()
+{
+    static Stage_Timer t("buckets");
+    end_window(t);
+    for (uint32_t us=1; us<=1000; us++) {
+        t.record(us);
+    }
+    end_window(t);
+    TEST_ASSERT_EQUAL(1001, t.get_count(), "count");
+    TEST_ASSERT_EQUAL(511, t.get_p50_us(), "p50");
+    TEST_ASSERT_EQUAL(1000, t.get_p99_us(), "p99");
+    TEST_ASSERT_EQUAL(1000, t.get_max_us(), "max");
+
+    // a bucket is never more than a quarter over the times it holds
+    for (uint32_t us : { 8U, 9U, 100U, 4095U, 4096U, 123456U, 16000000U }) {
+        end_window(t);
+        t.record(us);
+        t.record(us + 1000000000);
+        end_window(t);
+        TEST_ASSERT(t.get_p50_us() >= us && t.get_p50_us() <= us + us/4, "bucket edge");
+    }
+
+    // the next window starts empty
+    end_window(t);
+    TEST_ASSERT_EQUAL(1, t.get_count(), "the record that ended the window");
+    TEST_ASSERT_EQUAL(0, t.get_max_us(), "max");
+    return true;
+}
+
+static bool test_scopes()
+{
+    static Stage_Timer outer("outer"), inner("inner");
+    end_window(outer);
+    end_window(inner);
+    {
+        Stage_Scope o(outer);
+        host_advance_us(150);
+        {
+            Stage_Scope i(inner);
+            host_advance_us(100);
+        }
+        host_advance_us(50);
+    }
+    end_window(outer);
+    end_window(inner);
+    TEST_ASSERT_EQUAL(300, outer.get_max_us(), "outer inclusive");
+    TEST_ASSERT_EQUAL(100, inner.get_max_us(), "inner");
+
+    bool found_outer = false, found_inner = false;
+    for (const Stage_Timer *t = Stage_Timer::first(); t != nullptr; t = t->next()) {
+        found_outer |= t == &outer;
+        found_inner |= t == &inner;
+    }
+    TEST_ASSERT(found_outer && found_inner, "listed");
+    return true;
+}
+
+int main(void)
+{
+    TEST_RUN(test_exact);
+    TEST_RUN(test_buckets);
+    TEST_RUN(test_scopes);
+    return test_result();
+}
@@ -0,0 +1,258 @@
+/*
+  the sketch's task graph on the FreeRTOS shim: setup(), then the
+  tasks from their first runs, in the order the priorities and periods
+  give them on the board. The sketch is one translation unit, as the
+  Arduino builder makes it, so it is included here
+ */
+
+#include "test.h"
+#include "ondocean-remoteid.ino.cpp"
+
+// webinterface.cpp needs the WebServer library of the target
+void WebInterface::init(void)
+{
+}
+
+void WebInterface::update(void)
+{
+}
+
+// a 3.9V battery on the 2:1 divider
+#define BATTERY_OK_MV  1950
+#define BATTERY_LOW_MV 1500
+
+// UAS ID of the encoded BasicID, empty if there is none yet
+static std::string sent_uas_id(void)
+{
+    const uint8_t *msg = odid_snapshot.get_message(ODID_Snapshot::Slot::BASIC_ID);
+    if (msg == nullptr) {
+        return "";
+    }
+    ODID_BasicID_data basic_id;
+    if (decodeBasicIDMessage(&basic_id, (ODID_BasicID_encoded *)msg) != ODID_SUCCESS) {
+        return "";
+    }
+    return std::string(basic_id.UASID, strnlen(basic_id.UASID, sizeof(basic_id.UASID)));
+}
+
+/*
+  from the first TX run on, the BasicID carries the device ID. The TX
+  task runs before the first data tick, and used to clear the dirty
+  bits of sections not filled in yet, so an empty UAS ID went out
+ */
+static bool test_startup_basic_id()
+{
+    const std::string device_id = maritime_config.device_id.c_str();
+    TEST_ASSERT(device_id.size() > 6, "device ID from the MAC");
+    uint32_t sequence = odid_snapshot.get_sequence();
+    uint32_t packs = 0;
+    for (uint32_t ms=0; ms<300; ms++) {
+        host_run_ms(1);
+        if (odid_snapshot.get_sequence() == sequence) {
+            continue;
+        }
+        sequence = odid_snapshot.get_sequence();
+        packs++;
+        TEST_ASSERT_STRING_EQUAL(device_id.c_str(), sent_uas_id().c_str(), "BasicID in every pack");
+    }
+    TEST_ASSERT(packs >= 1, "pack built");
+    TEST_ASSERT(host_task_runs("data") >= 2, "data ticks ran");
+    TEST_ASSERT_STRING_EQUAL(device_id.c_str(), odid_snapshot.get_uas_id(), "snapshot UAS ID");
+    TEST_ASSERT(host_radio.ble_adv_data_sets[0] > 0, "BLE sent");
+    return true;
+}
+
+/*
+  each task runs at its period: ingest and services at 100Hz, or 10Hz
+  in low power mode, and data at 10Hz. tx blocks until its next radio
+  deadline rather than waking every ms. The data tick marks the
+  snapshot dirty and notifies tx, which encodes it, so there is at
+  most one pack a data tick
+ */
+static bool test_task_rates()
+{
+    const uint32_t data_runs = host_task_runs("data");
+    const uint32_t tx_runs = host_task_runs("tx");
+    const uint32_t ingest_runs = host_task_runs("ingest");
+    const uint32_t services_runs = host_task_runs("services");
+    const uint32_t sequence = odid_snapshot.get_sequence();
+    host_run_ms(1000);
+    const uint32_t data = host_task_runs("data") - data_runs;
+    const uint32_t tx = host_task_runs("tx") - tx_runs;
+    TEST_ASSERT(data >= 9 && data <= 11, "data at 10Hz");
+    TEST_ASSERT(tx >= data && tx < 500, "tx on its deadlines");
+    TEST_ASSERT(host_task_runs("ingest") - ingest_runs >= 90, "ingest at 100Hz");
+    TEST_ASSERT(host_task_runs("services") - services_runs >= 90, "services at 100Hz");
+
+    TEST_ASSERT(odid_snapshot.get_sequence() - sequence <= data, "no more than one pack a data tick");
+    TEST_ASSERT(host_radio.ble_adv_data_sets[0] > 0, "BLE sent");
+    return true;
+}
+
+// WiFi NAN sends and buzzer pulses seen over a run, sampled every ms
+struct TX_Trace {
+    uint32_t sends;
+    uint32_t max_gap_ms;
+    uint32_t buzzer_pulses;
+};
+
+static TX_Trace trace_ms(uint32_t ms)
+{
+    TX_Trace t {};
+    uint32_t frames = host_radio.wifi_frames;
+    uint32_t last_send = 0;
+    int buzzer = host_get_pin(PIN_BUZZER);
+    for (uint32_t i=1; i<=ms; i++) {
+        host_run_ms(1);
+        if (host_radio.wifi_frames != frames) {
+            frames = host_radio.wifi_frames;
+            if (t.sends > 0) {
+                t.max_gap_ms = std::max(t.max_gap_ms, i - last_send);
+            }
+            last_send = i;
+            t.sends++;
+        }
+        if (host_get_pin(PIN_BUZZER) == HIGH && buzzer == LOW) {
+            t.buzzer_pulses++;
+        }
+        buzzer = host_get_pin(PIN_BUZZER);
+    }
+    return t;
+}
+
+/*
+  the emergency pattern plays from the TX task tick without holding up
+  transmission: WiFi NAN keeps its rate through the 1.8s of buzzer
+  pulses. The pattern used to be a 2s run of delay() calls
+ */
+static bool test_pattern_tx_rate()
+{
+    g.wifi_nan_rate = 5;
+    // the 1.3s startup pattern from the first TX run
+    for (uint32_t ms=0; ms<2000 && pattern_player.active(); ms++) {
+        host_run_ms(1);
+    }
+    TEST_ASSERT(!pattern_player.active(), "startup pattern done");
+
+    const TX_Trace idle = trace_ms(2000);
+    TEST_ASSERT(idle.sends >= 9 && idle.sends <= 11, "5Hz NAN");
+    TEST_ASSERT_EQUAL(0, idle.buzzer_pulses, "quiet");
+
+    activate_emergency_beacon();
+    const TX_Trace alarm = trace_ms(2000);
+    TEST_ASSERT_EQUAL(5, alarm.buzzer_pulses, "five buzzer pulses");
+    TEST_ASSERT(!pattern_player.active(), "pattern done");
+    TEST_ASSERT_EQUAL(LOW, host_get_pin(PIN_BUZZER), "buzzer off at the end");
+    TEST_ASSERT(alarm.sends >= idle.sends - 1 && alarm.sends <= idle.sends + 1, "NAN rate kept");
+    TEST_ASSERT(alarm.max_gap_ms <= 201, "no NAN slot missed");
+    g.wifi_nan_rate = 0;
+    return true;
+}
+
+// the earliest due event, capped so periodic work keeps running
+static bool test_next_wake_ms()
+{
+    const uint32_t due_ms[] { 250, 40, UINT32_MAX, 70 };
+    TEST_ASSERT_EQUAL(40, Power_Manager::next_wake_ms(due_ms, 4, 100), "earliest");
+    TEST_ASSERT_EQUAL(100, Power_Manager::next_wake_ms(due_ms, 1, 100), "capped");
+    TEST_ASSERT_EQUAL(100, Power_Manager::next_wake_ms(&due_ms[2], 1, 100), "nothing due");
+    TEST_ASSERT_EQUAL(100, Power_Manager::next_wake_ms(nullptr, 0, 100), "no events");
+    const uint32_t now_ms[] { 5, 0 };
+    TEST_ASSERT_EQUAL(0, Power_Manager::next_wake_ms(now_ms, 2, 100), "due now");
+    return true;
+}
+
+/*
+  the services task first runs before the data tick copies a battery
+  reading into maritime_config, which used to latch low power mode at
+  every boot from its 0V default
+ */
+static bool test_startup_power()
+{
+    const uint32_t services_runs = host_task_runs("services");
+    host_run_ms(2000);
+    TEST_ASSERT(!maritime_config.low_power_mode, "no low power mode on a good battery");
+    TEST_ASSERT(host_task_runs("services") - services_runs >= 180, "services at 100Hz");
+    TEST_ASSERT(!power_manager.low_power(), "power manager at full power");
+
+    // a low battery still switches it on, within a battery period
+    host_set_analog_mv(PIN_BATTERY_MONITOR, BATTERY_LOW_MV);
+    host_run_ms(700);
+    TEST_ASSERT(maritime_config.low_power_mode, "low power mode on a low battery");
+    TEST_ASSERT(power_manager.low_power(), "power manager in low power");
+    return true;
+}
+
+/*
+  the wake schedule in low power mode. The chip sleeps whenever every
+  task is blocked, which the shim reports as the time it skips, until
+  the earliest task deadline. Radio TX keeps its rate, each sleep lands
+  in the duty cycle of its minute, and GNSS data ends a sleep early
+ */
+static bool test_low_power_schedule()
+{
+    TEST_ASSERT(power_manager.low_power(), "low power mode");
+
+    // duty cycle accounting of its own, so the window lines up with the run
+    static Power_Manager minute;
+    while (millis() < 60000) {
+        host_run_ms(1000);
+    }
+    minute.update(millis());
+
+    uint32_t sleeps = 0;
+    uint64_t longest_us = 0;
+    uint32_t bt5_sets = host_radio.ble_adv_data_sets[1];
+    std::vector<uint64_t> bt5_us;
+    host_idle_hook = [&](uint64_t us) {
+        // as the light sleep exit callback does
+        minute.add_sleep_us(us);
+        sleeps++;
+        longest_us = std::max(longest_us, us);
+        // the tasks that ran before this sleep sent
+        if (host_radio.ble_adv_data_sets[1] != bt5_sets) {
+            bt5_sets = host_radio.ble_adv_data_sets[1];
+            bt5_us.push_back(host_time_us());
+        }
+    };
+    host_run_ms(60000);
+    minute.update(millis());
+    TEST_ASSERT_EQUAL(sleeps, minute.get_sleeps(), "every sleep counted");
+    // task runs take no simulated time
+    TEST_ASSERT_EQUAL(60000, minute.get_asleep_ms(), "asleep while every task blocks");
+    TEST_ASSERT_EQUAL(0, minute.get_awake_ms(), "awake");
+    TEST_ASSERT(longest_us <= 100000, "never past the 100ms polling period");
+
+    // BT5 keeps 1Hz through the sleeps, within a tick and without drift
+    TEST_ASSERT(bt5_us.size() >= 59 && bt5_us.size() <= 61, "BT5 rate in low power mode");
+    for (size_t i=1; i<bt5_us.size(); i++) {
+        TEST_ASSERT(llabs(int64_t(bt5_us[i] - bt5_us[i-1]) - 1000000) <= 1000, "BT5 send on its slot");
+    }
+    TEST_ASSERT_EQUAL((bt5_us.size() - 1) * 1000000ULL, bt5_us.back() - bt5_us.front(), "BT5 slots don't drift");
+
+    // GNSS data ends a sleep: ingestion runs at once, not at its timeout
+    host_run_ms(50);
+    const uint32_t ingest_runs = host_task_runs("ingest");
+    const uint64_t now_us = host_time_us();
+    const char sentence[] = "$GPGGA,,,,,,0,00,,,M,,M,,*66\r\n";
+    gnssSerial.receive(sentence, strlen(sentence));
+    TEST_ASSERT_EQUAL(ingest_runs + 1, host_task_runs("ingest"), "ingest woken");
+    TEST_ASSERT_EQUAL(now_us, host_time_us(), "straight away");
+    host_idle_hook = nullptr;
+    return true;
+}
+
+int main(void)
+{
+    host_set_analog_mv(PIN_BATTERY_MONITOR, BATTERY_OK_MV);
+    // the closed case holds the switch input low
+    host_set_pin(PIN_CASE_DETECT, LOW);
+    setup();
+    TEST_RUN(test_startup_basic_id);
+    TEST_RUN(test_task_rates);
+    TEST_RUN(test_pattern_tx_rate);
+    TEST_RUN(test_startup_power);
+    TEST_RUN(test_next_wake_ms);
+    TEST_RUN(test_low_power_schedule);
+    return test_result();
+}
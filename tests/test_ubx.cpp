@@ -0,0 +1,214 @@
+/*
+  UBX parser on the streams the receiver sends: NAV-PVT decoding, the
+  switch over from NMEA with ACKs and frames it skips, corrupted
+  frames, and the CFG-VALSET configuration frame
+ */
+
+#include "test.h"
+#include "ubx.h"
+#include "gnss_streams.h"
+
+static uint32_t feed(UBX_Parser &parser, const std::vector<uint8_t> &bytes)
+{
+    uint32_t fixes = 0;
+    for (const uint8_t b : bytes) {
+        fixes += parser.feed(b);
+    }
+    return fixes;
+}
+
+static void append(std::vector<uint8_t> &stream, const std::vector<uint8_t> &bytes)
+{
+    stream.insert(stream.end(), bytes.begin(), bytes.end());
+}
+
+static void append(std::vector<uint8_t> &stream, const std::string &s)
+{
+    stream.insert(stream.end(), s.begin(), s.end());
+}
+
+// every field of the fix from one NAV-PVT
+static bool test_nav_pvt()
+{
+    static UBX_Parser parser;
+    TEST_ASSERT_EQUAL(1, feed(parser, nav_pvt(3)), "one fix");
+    TEST_ASSERT(parser.get_updated(), "updated");
+    TEST_ASSERT(!parser.get_updated(), "cleared when read");
+
+    const GNSS_Fix &f = parser.get_fix();
+    TEST_ASSERT(f.valid, "valid");
+    TEST_ASSERT_EQUAL(3, f.fix_type, "3D");
+    TEST_ASSERT_EQUAL(1, f.fix_quality, "GPS");
+    TEST_ASSERT_EQUAL(21, f.num_sats, "satellites");
+    TEST_ASSERT_FLOAT_EQUAL(48.1173021 + 3 * 2.5e-8, f.latitude, 1e-7, "latitude");
+    TEST_ASSERT_FLOAT_EQUAL(-11.5166743 + 3 * 3.8e-7, f.longitude, 1e-7, "longitude");
+    TEST_ASSERT_FLOAT_EQUAL(545.4, f.altitude_msl, 1e-3, "hMSL");
+    TEST_ASSERT_FLOAT_EQUAL(46.9, f.geoid_sep, 1e-3, "height above the ellipsoid less hMSL");
+    TEST_ASSERT_FLOAT_EQUAL(1.2, f.horiz_accuracy, 1e-6, "hAcc");
+    TEST_ASSERT_FLOAT_EQUAL(1.5, f.vert_accuracy, 1e-6, "vAcc");
+    TEST_ASSERT_FLOAT_EQUAL(2.833, f.ground_speed, 1e-6, "gSpeed");
+    TEST_ASSERT_FLOAT_EQUAL(84.4, f.course, 1e-4, "headMot");
+    TEST_ASSERT_EQUAL(((12*60 + 35)*60 + 19)*1000 + 300, f.time_ms, "UTC time of day");
+    TEST_ASSERT_EQUAL(171026, f.date, "ddmmyy");
+    TEST_ASSERT_EQUAL(1, parser.get_frames(), "frames");
+    TEST_ASSERT_EQUAL(0, parser.get_checksum_errors(), "checksum errors");
+    return true;
+}
+
+// the flags and fix type map to the NMEA fix quality and type
+static bool test_fix_quality()
+{
+    static UBX_Parser parser;
+    const struct {
+        uint8_t fix_type;
+        uint8_t flags;
+        bool valid;
+        uint8_t quality;
+        uint8_t type;
+    } cases[] {
+        { 3, 0x01, true, 1, 3 },
+        { 3, 0x03, true, 2, 3 },    // differential
+        { 3, 0x43, true, 5, 3 },    // RTK float
+        { 3, 0x83, true, 4, 3 },    // RTK fixed
+        { 4, 0x01, true, 1, 3 },    // GNSS and dead reckoning
+        { 2, 0x01, true, 1, 2 },
+        { 3, 0x00, false, 0, 3 },   // gnssFixOK clear
+        { 0, 0x00, false, 0, 1 },
+        { 5, 0x01, false, 0, 1 },   // time only
+    };
+    for (const auto &c : cases) {
+        std::vector<uint8_t> p = nav_pvt_payload(0);
+        p[20] = c.fix_type;
+        p[21] = c.flags;
+        TEST_ASSERT_EQUAL(1, feed(parser, ubx_frame(0x01, 0x07, p)), "fix");
+        const GNSS_Fix &f = parser.get_fix();
+        TEST_ASSERT_EQUAL(c.valid, f.valid, "valid");
+        TEST_ASSERT_EQUAL(c.quality, f.fix_quality, "quality");
+        TEST_ASSERT_EQUAL(c.type, f.fix_type, "type");
+    }
+
+    // a heading below zero is reported in 0..360
+    std::vector<uint8_t> p = nav_pvt_payload(0);
+    ubx_put<int32_t>(p, 64, -1000000);
+    feed(parser, ubx_frame(0x01, 0x07, p));
+    TEST_ASSERT_FLOAT_EQUAL(350, parser.get_fix().course, 1e-4, "course wrapped");
+
+    // date and time are kept until they are valid again
+    p = nav_pvt_payload(20);
+    p[11] = 0;
+    feed(parser, ubx_frame(0x01, 0x07, p));
+    TEST_ASSERT_EQUAL(((12*60 + 35)*60 + 19)*1000, parser.get_fix().time_ms, "time kept");
+    TEST_ASSERT_EQUAL(171026, parser.get_fix().date, "date kept");
+    return true;
+}
+
+/*
+  the stream around the switch to UBX: NMEA sent before the
+  configuration took, a stray sync byte, a NAV-SAT longer than the
+  payload buffer, the ACK of the CFG-VALSET and then 10Hz NAV-PVT,
+  with a corrupted and a truncated frame among them. The truncated
+  frame takes its length in bytes of the next one with it
+ */
+static bool test_stream()
+{
+    static UBX_Parser parser;
+    std::vector<uint8_t> stream;
+    append(stream, nmea_epoch(0));
+    append(stream, std::string("$GNGGA,1235\xb5\xb5"));
+    append(stream, ubx_frame(0x01, 0x35, std::vector<uint8_t>(8 + 12*40, 0x5a)));
+    append(stream, ubx_frame(0x05, 0x01, { 0x06, 0x8A }));
+    append(stream, nav_pvt(1));
+    std::vector<uint8_t> bad = nav_pvt(2);
+    bad[6 + 28] ^= 0x01;
+    append(stream, bad);
+    std::vector<uint8_t> cut = nav_pvt(3);
+    cut.resize(50);
+    append(stream, cut);
+    append(stream, nav_pvt(4));
+    // NAV-PVT of a different length, as older protocol versions sent
+    append(stream, ubx_frame(0x01, 0x07, std::vector<uint8_t>(84)));
+    append(stream, nav_pvt(5));
+
+    TEST_ASSERT_EQUAL(2, feed(parser, stream), "good NAV-PVTs");
+    TEST_ASSERT_EQUAL(2, parser.get_checksum_errors(), "corrupted and truncated frame");
+    TEST_ASSERT_EQUAL(5, parser.get_frames(), "NAV-SAT, ACK, 2 NAV-PVT, the short one");
+    TEST_ASSERT_FLOAT_EQUAL(gnss_epoch(5).lat, parser.get_fix().latitude, 1e-7, "last good fix");
+
+    bool acked = false;
+    TEST_ASSERT(!parser.get_ack(0x06, 0x8B, acked), "ACK of another message");
+    TEST_ASSERT(parser.get_ack(0x06, 0x8A, acked), "ACK of the CFG-VALSET");
+    TEST_ASSERT(acked, "ACK-ACK");
+    TEST_ASSERT(!parser.get_ack(0x06, 0x8A, acked), "cleared when read");
+
+    feed(parser, ubx_frame(0x05, 0x00, { 0x06, 0x8A }));
+    TEST_ASSERT(parser.get_ack(0x06, 0x8A, acked), "ACK-NAK");
+    TEST_ASSERT(!acked, "refused");
+    return true;
+}
+
+/*
+  a bad frame loses only itself: the parser resyncs on the next one.
+  A flipped high length byte makes a frame kilobytes long, which
+  swallows the frames after it instead
+ */
+static bool test_corrupt_every_byte()
+{
+    const std::vector<uint8_t> good = nav_pvt(7);
+    for (size_t i=0; i<good.size(); i++) {
+        UBX_Parser parser {};
+        std::vector<uint8_t> stream = nav_pvt(6);
+        std::vector<uint8_t> bad = good;
+        bad[i] ^= 0x10;
+        append(stream, bad);
+        append(stream, nav_pvt(8));
+        const uint32_t fixes = feed(parser, stream);
+        if (i == 5) {
+            TEST_ASSERT_EQUAL(1, fixes, "frames after it swallowed");
+            continue;
+        }
+        TEST_ASSERT_EQUAL(2, fixes, "only the corrupted frame lost");
+        TEST_ASSERT_FLOAT_EQUAL(gnss_epoch(8).lat, parser.get_fix().latitude, 1e-7, "next frame decoded");
+    }
+    return true;
+}
+
+// CFG-VALSET: a well formed frame of the keys, the baudrate last
+static bool test_build_config()
+{
+    uint8_t buf[80];
+    const size_t len = UBX_Parser::build_config(buf, sizeof(buf), 115200, 10);
+    const uint8_t expected[] {
+        0xB5, 0x62, 0x06, 0x8A, 0x2C, 0x00,
+        0x00, 0x03, 0x00, 0x00,
+        0x01, 0x00, 0x74, 0x10, 0x01,                   // CFG-UART1OUTPROT-UBX 1
+        0x02, 0x00, 0x74, 0x10, 0x00,                   // CFG-UART1OUTPROT-NMEA 0
+        0x07, 0x00, 0x91, 0x20, 0x01,                   // CFG-MSGOUT-UBX_NAV_PVT_UART1 1
+        0x21, 0x00, 0x11, 0x20, 0x05,                   // CFG-NAVSPG-DYNMODEL sea
+        0x01, 0x00, 0x21, 0x30, 0x64, 0x00,             // CFG-RATE-MEAS 100ms
+        0x02, 0x00, 0x21, 0x30, 0x01, 0x00,             // CFG-RATE-NAV 1
+        0x01, 0x00, 0x52, 0x40, 0x00, 0xC2, 0x01, 0x00, // CFG-UART1-BAUDRATE 115200
+    };
+    TEST_ASSERT_EQUAL(sizeof(expected) + 2, len, "frame length");
+    TEST_ASSERT_BYTES_EQUAL(expected, buf, sizeof(expected), "frame");
+    UBX_Parser parser {};
+    for (size_t i=0; i<len; i++) {
+        parser.feed(buf[i]);
+    }
+    TEST_ASSERT_EQUAL(1, parser.get_frames(), "checksum good");
+
+    // no baudrate key when the speed is left alone
+    TEST_ASSERT_EQUAL(len - 8, UBX_Parser::build_config(buf, sizeof(buf), 0, 10), "without the baudrate");
+    TEST_ASSERT_EQUAL(0, UBX_Parser::build_config(buf, 60, 115200, 10), "buffer too small");
+    TEST_ASSERT_EQUAL(0, UBX_Parser::build_config(buf, sizeof(buf), 115200, 0), "no rate");
+    return true;
+}
+
+int main(void)
+{
+    TEST_RUN(test_nav_pvt);
+    TEST_RUN(test_fix_quality);
+    TEST_RUN(test_stream);
+    TEST_RUN(test_corrupt_every_byte);
+    TEST_RUN(test_build_config);
+    return test_result();
+}
@@ -0,0 +1,279 @@
+/*
+  WiFi NAN and beacon frames against the bytes the frame builders made
+  before the persistent templates, for the same MAC, pack and counter:
+  the action frame template with every counter patched in, the NAN
+  sync beacon, and WiFi_TX end to end through the shim with the swap
+  of the beacon vendor element
+ */
+
+#include "test.h"
+#include "WiFi_TX.h"
+
+static char mac[6] { 0x02, 0x11, 0x22, 0x33, 0x44, 0x55 };
+
+// the reference pack of test_opendroneid: Basic ID, Location and System
+static const uint8_t golden_pack[] {
+    0xF2, 0x19, 0x03, 0x02, 0x12, 0x4F, 0x4E, 0x52, 0x49, 0x44, 0x2D, 0x32,
+    0x34, 0x30, 0x41, 0x43, 0x34, 0x30, 0x30, 0x30, 0x30, 0x30, 0x31, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x12, 0x22, 0x23, 0x31, 0xFD, 0x80, 0x21, 0xB6,
+    0x23, 0x96, 0xA9, 0x68, 0x06, 0xE9, 0x07, 0xEE, 0x07, 0xD7, 0x07, 0x5B,
+    0x43, 0x39, 0x30, 0x03, 0x00, 0x42, 0x04, 0xD8, 0xF3, 0xB5, 0x23, 0x88,
+    0xB9, 0x67, 0x06, 0x01, 0x00, 0x0A, 0x34, 0x08, 0xD0, 0x07, 0x12, 0xDA,
+    0x07, 0x15, 0xCD, 0x5B, 0x07, 0x00,
+};
+
+// NAN action frame of golden_pack, counter 0x2A
+#define NAN_COUNTER_OFS 43
+#define NAN_PACK_OFS    44
+#define NAN_TRAILER_COUNTER_OFS 128
+static const uint8_t golden_nan_action[] {
+    0xD0, 0x00, 0x00, 0x00, 0x51, 0x6F, 0x9A, 0x01, 0x00, 0x00, 0x02, 0x11,
+    0x22, 0x33, 0x44, 0x55, 0x50, 0x6F, 0x9A, 0x01, 0x00, 0xFF, 0x00, 0x00,
+    0x04, 0x09, 0x50, 0x6F, 0x9A, 0x13, 0x03, 0x59, 0x00, 0x88, 0x69, 0x19,
+    0x9D, 0x92, 0x09, 0x01, 0x00, 0x10, 0x4F, 0x2A, 0xF2, 0x19, 0x03, 0x02,
+    0x12, 0x4F, 0x4E, 0x52, 0x49, 0x44, 0x2D, 0x32, 0x34, 0x30, 0x41, 0x43,
+    0x34, 0x30, 0x30, 0x30, 0x30, 0x30, 0x31, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x12, 0x22, 0x23, 0x31, 0xFD, 0x80, 0x21, 0xB6, 0x23, 0x96, 0xA9, 0x68,
+    0x06, 0xE9, 0x07, 0xEE, 0x07, 0xD7, 0x07, 0x5B, 0x43, 0x39, 0x30, 0x03,
+    0x00, 0x42, 0x04, 0xD8, 0xF3, 0xB5, 0x23, 0x88, 0xB9, 0x67, 0x06, 0x01,
+    0x00, 0x0A, 0x34, 0x08, 0xD0, 0x07, 0x12, 0xDA, 0x07, 0x15, 0xCD, 0x5B,
+    0x07, 0x00, 0x0E, 0x04, 0x00, 0x01, 0x00, 0x02, 0x2A,
+};
+
+// NAN sync beacon with a zero TSF timestamp
+#define SYNC_TSF_OFS 24
+static const uint8_t golden_nan_sync[] {
+    0x80, 0x00, 0x00, 0x00, 0x51, 0x6F, 0x9A, 0x01, 0x00, 0x00, 0x02, 0x11,
+    0x22, 0x33, 0x44, 0x55, 0x50, 0x6F, 0x9A, 0x01, 0x00, 0xFF, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x04,
+    0xDD, 0x22, 0x50, 0x6F, 0x9A, 0x13, 0x00, 0x02, 0x00, 0xFE, 0xEA, 0x01,
+    0x0D, 0x00, 0x02, 0x11, 0x22, 0x33, 0x44, 0x55, 0xEA, 0xFE, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x02, 0x06, 0x00, 0x88, 0x69, 0x19, 0x9D, 0x92, 0x09,
+};
+
+// vendor element of the beacon frame of golden_pack, counter 0x2A
+#define IE_COUNTER_OFS 6
+static const uint8_t golden_beacon_ie[] {
+    0xDD, 0x53, 0xFA, 0x0B, 0xBC, 0x0D, 0x2A,
+};
+
+// the template patched with each counter is the frame the builder made
+static bool test_nan_action_template()
+{
+    uint8_t frame[ODID_WIFI_NAN_ACTION_FRAME_SIZE];
+    const int ofs = odid_wifi_build_nan_action_frame_template(mac, frame, sizeof(frame));
+    TEST_ASSERT_EQUAL(NAN_PACK_OFS, ofs, "pack offset");
+
+    uint8_t expected[sizeof(golden_nan_action)];
+    memcpy(expected, golden_nan_action, sizeof(expected));
+    for (uint16_t counter=0; counter<256; counter++) {
+        expected[NAN_COUNTER_OFS] = counter;
+        expected[NAN_TRAILER_COUNTER_OFS] = counter;
+        const int len = odid_wifi_patch_nan_action_frame(frame, sizeof(frame), ofs,
+                                                         golden_pack, sizeof(golden_pack), counter);
+        TEST_ASSERT_EQUAL(sizeof(expected), len, "frame length");
+        TEST_ASSERT_BYTES_EQUAL(expected, frame, sizeof(expected), "patched frame");
+    }
+
+    // the builder from the pack gives the same frame
+    uint8_t built[ODID_WIFI_NAN_ACTION_FRAME_SIZE];
+    const int len = odid_wifi_build_message_pack_nan_action_frame_from_pack(golden_pack, sizeof(golden_pack),
+                                                                            mac, 0x2A, built, sizeof(built));
+    TEST_ASSERT_EQUAL(sizeof(golden_nan_action), len, "built length");
+    TEST_ASSERT_BYTES_EQUAL(golden_nan_action, built, sizeof(golden_nan_action), "built frame");
+
+    // a pack whose length disagrees with its message count is refused
+    TEST_ASSERT(odid_wifi_patch_nan_action_frame(frame, sizeof(frame), ofs, golden_pack,
+                                                 sizeof(golden_pack) - 1, 1) < 0, "short pack");
+    return true;
+}
+
+// the sync beacon, with the timestamp refreshed in place
+static bool test_nan_sync()
+{
+    uint8_t frame[ODID_WIFI_NAN_SYNC_FRAME_SIZE];
+    const int len = odid_wifi_build_nan_sync_beacon_frame(mac, frame, sizeof(frame));
+    TEST_ASSERT_EQUAL(sizeof(golden_nan_sync), len, "frame length");
+    memset(&frame[SYNC_TSF_OFS], 0, sizeof(uint64_t));
+    TEST_ASSERT_BYTES_EQUAL(golden_nan_sync, frame, sizeof(golden_nan_sync), "frame");
+
+    host_advance_us(0x123456789ULL);
+    odid_wifi_update_beacon_timestamp(frame, len);
+    uint64_t tsf;
+    memcpy(&tsf, &frame[SYNC_TSF_OFS], sizeof(tsf));
+    TEST_ASSERT_EQUAL(uint64_t(host_time_us()), tsf, "TSF");
+    memset(&frame[SYNC_TSF_OFS], 0, sizeof(uint64_t));
+    TEST_ASSERT_BYTES_EQUAL(golden_nan_sync, frame, sizeof(golden_nan_sync), "rest untouched");
+    return true;
+}
+
+static void fill_uas(ODID_UAS_Data &uas)
+{
+    odid_initUasData(&uas);
+    uas.BasicID[0].UAType = ODID_UATYPE_OTHER;
+    uas.BasicID[0].IDType = ODID_IDTYPE_SERIAL_NUMBER;
+    strcpy(uas.BasicID[0].UASID, "ONRID-240AC4000001");
+    uas.BasicIDValid[0] = 1;
+    uas.Location.Status = ODID_STATUS_AIRBORNE;
+    uas.Location.Latitude = 51.4545;
+    uas.Location.Longitude = -2.5879;
+    uas.LocationValid = 1;
+    uas.System.OperatorLatitude = 51.4545;
+    uas.System.OperatorLongitude = -2.5879;
+    uas.System.AreaCount = 1;
+    uas.SystemValid = 1;
+}
+
+/*
+  the frames WiFi_TX sends are the golden ones with its random MAC,
+  its counter and the snapshot pack in place
+ */
+static bool test_wifi_tx()
+{
+    static ODID_UAS_Data uas;
+    static ODID_Snapshot snapshot;
+    static WiFi_TX wifi;
+    fill_uas(uas);
+    snapshot.update(uas);
+    TEST_ASSERT_EQUAL(sizeof(golden_pack), snapshot.get_pack_length(), "three messages");
+    TEST_ASSERT(wifi.init(), "init");
+
+    for (uint16_t counter=1; counter<=300; counter++) {
+        const uint32_t frames = host_radio.wifi_frames;
+        TEST_ASSERT(wifi.transmit_nan(snapshot), "NAN sent");
+        TEST_ASSERT_EQUAL(frames + 2, host_radio.wifi_frames, "sync and action frame");
+
+        const std::vector<uint8_t> &f = host_radio.wifi_last_frame;
+        TEST_ASSERT_EQUAL(sizeof(golden_nan_action), f.size(), "action frame length");
+        uint8_t expected[sizeof(golden_nan_action)];
+        memcpy(expected, golden_nan_action, sizeof(expected));
+        memcpy(&expected[10], &f[10], sizeof(mac));
+        memcpy(&expected[NAN_PACK_OFS], snapshot.get_pack(), sizeof(golden_pack));
+        expected[NAN_COUNTER_OFS] = uint8_t(counter);
+        expected[NAN_TRAILER_COUNTER_OFS] = uint8_t(counter);
+        TEST_ASSERT_BYTES_EQUAL(expected, f.data(), sizeof(expected), "action frame");
+        TEST_ASSERT_EQUAL(0x02, f[10] & 0x03, "local unicast MAC");
+    }
+    return true;
+}
+
+// the slot holding the RID element of a frame type, -1 for none or both
+static int installed_slot(wifi_vendor_ie_type_t type)
+{
+    const auto &slots = host_radio.vendor_ie[type];
+    if (slots[0].empty() == slots[1].empty()) {
+        return -1;
+    }
+    return slots[0].empty() ? 1 : 0;
+}
+
+static bool check_beacon_ie(const ODID_Snapshot &snapshot, uint8_t counter)
+{
+    for (const auto type : { WIFI_VND_IE_TYPE_BEACON, WIFI_VND_IE_TYPE_PROBE_RESP }) {
+        const int slot = installed_slot(type);
+        TEST_ASSERT(slot >= 0, "one RID element");
+        const std::vector<uint8_t> &ie = host_radio.vendor_ie[type][slot];
+        TEST_ASSERT_EQUAL(sizeof(golden_beacon_ie) + snapshot.get_pack_length(), ie.size(), "IE length");
+        uint8_t expected[sizeof(golden_beacon_ie)];
+        memcpy(expected, golden_beacon_ie, sizeof(expected));
+        expected[IE_COUNTER_OFS] = counter;
+        TEST_ASSERT_BYTES_EQUAL(expected, ie.data(), sizeof(expected), "IE header");
+        TEST_ASSERT_BYTES_EQUAL(snapshot.get_pack(), &ie[sizeof(expected)], snapshot.get_pack_length(), "IE pack");
+    }
+    return true;
+}
+
+// a new pack for the next beacon element
+static void next_pack(ODID_UAS_Data &uas, ODID_Snapshot &snapshot)
+{
+    uas.Location.Latitude += 1e-5;
+    snapshot.mark_dirty(ODID_Snapshot::slot_bit(ODID_Snapshot::Slot::LOCATION));
+    snapshot.update(uas);
+}
+
+/*
+  the vendor element in beacons and probe responses: swapped through
+  the free slot when the pack changes, so a beacon never goes out
+  without one, and left alone while the pack stays the same
+ */
+static bool test_beacon_ie()
+{
+    static ODID_UAS_Data uas;
+    static ODID_Snapshot snapshot;
+    static WiFi_TX wifi;
+    fill_uas(uas);
+    snapshot.update(uas);
+    host_radio = Host_Radio();
+
+    TEST_ASSERT(wifi.transmit_beacon(snapshot), "beacon IE set");
+    TEST_ASSERT(check_beacon_ie(snapshot, 1), "first element");
+    TEST_ASSERT(wifi.transmit_beacon(snapshot), "unchanged pack");
+    TEST_ASSERT_EQUAL(1, wifi.get_ie_skipped(), "skipped");
+    TEST_ASSERT_EQUAL(2, host_radio.vendor_ie_sets, "no driver calls");
+
+    for (uint8_t counter=2; counter<10; counter++) {
+        const int slot = installed_slot(WIFI_VND_IE_TYPE_BEACON);
+        next_pack(uas, snapshot);
+        TEST_ASSERT(wifi.transmit_beacon(snapshot), "beacon IE swapped");
+        TEST_ASSERT(check_beacon_ie(snapshot, counter), "new element");
+        TEST_ASSERT(installed_slot(WIFI_VND_IE_TYPE_BEACON) != slot, "through the other slot");
+        TEST_ASSERT(installed_slot(WIFI_VND_IE_TYPE_PROBE_RESP) != slot, "probe responses too");
+    }
+    TEST_ASSERT_EQUAL(9, wifi.get_ie_updates(), "updates");
+    TEST_ASSERT_EQUAL(0, host_radio.vendor_ie_gaps, "never without a RID element");
+    return true;
+}
+
+/*
+  a failed driver call leaves the slots as the driver has them: the
+  next update retries it, with a RID element in every frame throughout
+ */
+static bool test_beacon_ie_errors()
+{
+    static ODID_UAS_Data uas;
+    static ODID_Snapshot snapshot;
+    static WiFi_TX wifi;
+    fill_uas(uas);
+    snapshot.update(uas);
+    host_radio = Host_Radio();
+    TEST_ASSERT(wifi.transmit_beacon(snapshot), "beacon IE set");
+
+    // the set into the free slot fails, the old element stays
+    const int slot = installed_slot(WIFI_VND_IE_TYPE_BEACON);
+    next_pack(uas, snapshot);
+    host_radio.vendor_ie_fail_call = host_radio.vendor_ie_calls + 1;
+    TEST_ASSERT(!wifi.transmit_beacon(snapshot), "set failed");
+    TEST_ASSERT_EQUAL(slot, installed_slot(WIFI_VND_IE_TYPE_BEACON), "old element kept");
+    TEST_ASSERT(wifi.transmit_beacon(snapshot), "retried");
+    TEST_ASSERT(check_beacon_ie(snapshot, 3), "new element");
+
+    // the remove of the old element fails, both stay until the next update
+    next_pack(uas, snapshot);
+    host_radio.vendor_ie_fail_call = host_radio.vendor_ie_calls + 2;
+    TEST_ASSERT(!wifi.transmit_beacon(snapshot), "remove failed");
+    TEST_ASSERT_EQUAL(-1, installed_slot(WIFI_VND_IE_TYPE_BEACON), "both elements");
+    next_pack(uas, snapshot);
+    TEST_ASSERT(wifi.transmit_beacon(snapshot), "next update");
+    TEST_ASSERT(check_beacon_ie(snapshot, 5), "one new element");
+
+    // and a failure on the probe responses after the beacon moved
+    for (uint8_t call=1; call<=4; call++) {
+        next_pack(uas, snapshot);
+        host_radio.vendor_ie_fail_call = host_radio.vendor_ie_calls + call;
+        TEST_ASSERT(!wifi.transmit_beacon(snapshot), "failed");
+        TEST_ASSERT(wifi.transmit_beacon(snapshot), "retried");
+        TEST_ASSERT(check_beacon_ie(snapshot, 5 + 2*call), "new element");
+    }
+    TEST_ASSERT_EQUAL(0, host_radio.vendor_ie_gaps, "never without a RID element");
+    return true;
+}
+
+int main(void)
+{
+    TEST_RUN(test_nan_action_template);
+    TEST_RUN(test_nan_sync);
+    TEST_RUN(test_wifi_tx);
+    TEST_RUN(test_beacon_ie);
+    TEST_RUN(test_beacon_ie_errors);
+    return test_result();
+}
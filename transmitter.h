@@ -8,7 +8,7 @@
 
 class Transmitter {
 public:
-    virtual bool init(void);
+    virtual bool init(void) = 0;
 
 protected:
     void generate_random_mac(uint8_t mac[6]);
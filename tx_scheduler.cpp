@@ -0,0 +1,103 @@
+/*
+  deadline based scheduler for the RemoteID transmitters
+
+  Each channel keeps its next deadline and advances it by its interval
+  when it fires, so the long term rate follows the parameter even when
+  the main loop is late. A channel more than one interval behind is
+  re-synchronised instead of bursting to catch up.
+ */
+
+#include <Arduino.h>
+#include "tx_scheduler.h"
+
+TX_Scheduler tx_scheduler;
+
+uint32_t TX_Scheduler::interval_ms(float rate_hz, uint8_t slots)
+{
+    if (!(rate_hz > 0) || slots == 0) {
+        return 0;
+    }
+    const uint32_t interval = uint32_t(1000 / (rate_hz * slots));
+    return interval > 0 ? interval : 1;
+}
+
+bool TX_Scheduler::due(Channel ch, uint32_t interval, uint32_t now_ms)
+{
+    update_stats(now_ms);
+
+    auto &c = channels[uint8_t(ch)];
+    if (interval == 0) {
+        c.interval_ms = 0;
+        return false;
+    }
+    if (interval != c.interval_ms) {
+        // (re)start the channel at its own phase within the interval
+        const bool was_enabled = c.interval_ms != 0;
+        c.interval_ms = interval;
+        if (!was_enabled) {
+            c.next_due_ms = now_ms + interval * uint8_t(ch) / uint8_t(Channel::COUNT);
+        }
+    }
+
+    if (int32_t(now_ms - c.next_due_ms) < 0) {
+        return false;
+    }
+    if (fired && now_ms == last_fire_ms) {
+        // another channel already went out this millisecond
+        return false;
+    }
+
+    const uint32_t late_ms = now_ms - c.next_due_ms;
+    if (late_ms > c.late_max_ms) {
+        c.late_max_ms = late_ms > UINT16_MAX ? UINT16_MAX : late_ms;
+    }
+    c.next_due_ms += interval;
+    if (int32_t(now_ms - c.next_due_ms) >= 0) {
+        c.next_due_ms = now_ms + interval;
+    }
+
+    last_fire_ms = now_ms;
+    fired = true;
+    return true;
+}
+
+void TX_Scheduler::sent(Channel ch, uint32_t now_ms)
+{
+    channels[uint8_t(ch)].count++;
+    if (first_tx_ms == 0) {
+        first_tx_ms = now_ms;
+    }
+}
+
+uint32_t TX_Scheduler::ms_until_due(uint32_t now_ms) const
+{
+    uint32_t wait_ms = UINT32_MAX;
+    for (const auto &c : channels) {
+        if (c.interval_ms == 0) {
+            continue;
+        }
+        const int32_t remaining = int32_t(c.next_due_ms - now_ms);
+        if (remaining <= 0) {
+            return 0;
+        }
+        if (uint32_t(remaining) < wait_ms) {
+            wait_ms = remaining;
+        }
+    }
+    return wait_ms;
+}
+
+void TX_Scheduler::update_stats(uint32_t now_ms)
+{
+    const uint32_t elapsed_ms = now_ms - window_start_ms;
+    if (elapsed_ms < 1000) {
+        return;
+    }
+    for (auto &c : channels) {
+        c.rate = c.count * 1000.0f / elapsed_ms;
+        c.jitter_ms = c.late_max_ms;
+        c.count = 0;
+        c.late_max_ms = 0;
+    }
+    window_start_ms = now_ms;
+}
@@ -0,0 +1,67 @@
+/*
+  deadline based scheduler for the RemoteID transmitters
+ */
+#pragma once
+
+#include <stdint.h>
+
+class TX_Scheduler {
+public:
+    enum class Channel : uint8_t {
+        WIFI_NAN = 0,
+        WIFI_BEACON,
+        BT4,
+        BT5,
+        COUNT
+    };
+
+    /*
+      return true if a channel is due at now_ms. An interval of 0
+      disables the channel. Channels start at staggered phases and at
+      most one channel fires per millisecond, so WiFi and BLE bursts
+      never go out together
+     */
+    bool due(Channel ch, uint32_t interval_ms, uint32_t now_ms);
+
+    // ms until the earliest enabled channel is due, UINT32_MAX if none
+    uint32_t ms_until_due(uint32_t now_ms) const;
+
+    // interval for sending slots messages at rate_hz, 0 if disabled
+    static uint32_t interval_ms(float rate_hz, uint8_t slots=1);
+
+    // a transmitter sent on a channel at now_ms, after due() returned
+    // true. Only sends count towards the rate
+    void sent(Channel ch, uint32_t now_ms);
+    // ms from boot to the first RemoteID transmission, 0 if none yet
+    uint32_t get_first_tx_ms(void) const {
+        return first_tx_ms;
+    }
+
+    // achieved rate in Hz of successful sends over the last full second
+    float get_rate(Channel ch) const {
+        return channels[uint8_t(ch)].rate;
+    }
+    // worst lateness against the deadline over the last full second
+    uint16_t get_jitter_ms(Channel ch) const {
+        return channels[uint8_t(ch)].jitter_ms;
+    }
+
+private:
+    struct ChannelState {
+        uint32_t interval_ms;
+        uint32_t next_due_ms;
+        uint16_t count;
+        uint16_t late_max_ms;
+        float rate;
+        uint16_t jitter_ms;
+    } channels[uint8_t(Channel::COUNT)];
+
+    uint32_t last_fire_ms;
+    bool fired;
+    uint32_t window_start_ms;
+    uint32_t first_tx_ms;
+
+    void update_stats(uint32_t now_ms);
+};
+
+extern TX_Scheduler tx_scheduler;
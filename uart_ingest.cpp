@@ -0,0 +1,72 @@
+/*
+  event driven UART reception
+
+  The Arduino core installs the ESP-IDF UART driver with an event queue
+  and runs a task that calls onReceive() for each data event: when the
+  hardware FIFO reaches its threshold or the line goes idle after a
+  burst. That task is our single producer; it drains the driver buffer
+  into a lock-free ring and notifies the consumer task, which parses
+  the ring in bulk. The idle timeout fires at the end of each NMEA
+  sentence, UBX frame or MAVLink packet burst, so parsers see whole
+  messages without polling.
+ */
+
+#include "uart_ingest.h"
+#include <string.h>
+#include "util.h"
+
+// receive event once the FIFO holds this many bytes, half the 128
+// byte hardware FIFO, leaving room for the event task to be late
+#define UART_RX_FIFO_THRESHOLD 64
+
+// idle time in symbols that ends a burst
+#define UART_RX_TIMEOUT_SYMBOLS 2
+
+UART_Ingest *UART_Ingest::list_head;
+
+UART_Ingest::UART_Ingest(const char *_name, HardwareSerial &_serial) :
+    name(_name),
+    serial(_serial)
+{
+    list_next = list_head;
+    list_head = this;
+}
+
+UART_Ingest *UART_Ingest::find(const char *_name)
+{
+    for (UART_Ingest *u = list_head; u != nullptr; u = u->list_next) {
+        if (strcmp(u->name, _name) == 0) {
+            return u;
+        }
+    }
+    return nullptr;
+}
+
+void UART_Ingest::start(RID_Task &_task)
+{
+    task = &_task;
+    serial.setRxFIFOFull(UART_RX_FIFO_THRESHOLD);
+    serial.setRxTimeout(UART_RX_TIMEOUT_SYMBOLS);
+    serial.onReceiveError([this](hardwareSerial_error_t err) {
+        if (err == UART_BUFFER_FULL_ERROR || err == UART_FIFO_OVF_ERROR) {
+            overruns++;
+        }
+    });
+    serial.onReceive([this]() { receive(); });
+}
+
+void UART_Ingest::receive(void)
+{
+    uint8_t buf[128];
+    size_t n;
+    while ((n = serial.read(buf, MIN(size_t(serial.available()), sizeof(buf)))) > 0) {
+        const uint32_t written = ring.write(buf, n);
+        bytes += n;
+        overruns += n - written;
+    }
+    const uint32_t used = ring.available();
+    if (used > max_used) {
+        max_used = used;
+    }
+    task->notify();
+}
@@ -0,0 +1,72 @@
+/*
+  event driven UART reception into a ring buffer
+ */
+#pragma once
+
+#include <Arduino.h>
+#include "ring_buffer.h"
+#include "rid_task.h"
+
+class UART_Ingest {
+public:
+    UART_Ingest(const char *_name, HardwareSerial &_serial);
+
+    /*
+      move reception of an opened port to the UART event task. Each
+      receive event drains the driver into the ring and wakes task,
+      which reads the ring in bulk
+     */
+    void start(RID_Task &task);
+
+    // consumer side, called from the woken task only
+    uint32_t read(uint8_t *data, uint32_t len) {
+        return ring.read(data, len);
+    }
+    uint32_t available(void) const {
+        return ring.available();
+    }
+
+    const char *get_name(void) const {
+        return name;
+    }
+    uint32_t get_bytes(void) const {
+        return bytes;
+    }
+    // bytes lost to a full ring or a driver FIFO/buffer overflow
+    uint32_t get_overruns(void) const {
+        return overruns;
+    }
+    uint32_t get_max_used(void) const {
+        return max_used;
+    }
+    static constexpr uint32_t get_size(void) {
+        return RING_SIZE;
+    }
+
+    static UART_Ingest *first(void) {
+        return list_head;
+    }
+    UART_Ingest *next(void) const {
+        return list_next;
+    }
+    static UART_Ingest *find(const char *name);
+
+private:
+    // 2k holds 170ms of 115200 baud, well over the ingest task period
+    static constexpr uint32_t RING_SIZE = 2048;
+
+    const char *name;
+    HardwareSerial &serial;
+    RID_Task *task;
+    Ring_Buffer<RING_SIZE> ring;
+
+    // written by the UART event task only
+    volatile uint32_t bytes;
+    volatile uint32_t overruns;
+    volatile uint32_t max_used;
+
+    UART_Ingest *list_next;
+    static UART_Ingest *list_head;
+
+    void receive(void);
+};
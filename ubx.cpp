@@ -0,0 +1,244 @@
+/*
+  u-blox UBX binary protocol
+
+  In UBX mode the receiver sends a single 100 byte NAV-PVT frame per
+  epoch instead of about 350 bytes of NMEA, and the fields arrive as
+  little endian integers so decoding is a few loads instead of decimal
+  parsing. Configuration uses the generation 9 key/value interface
+  (CFG-VALSET) of the ZED-F9P.
+ */
+
+#include "ubx.h"
+#include <string.h>
+#include <math.h>
+
+#define UBX_SYNC1 0xB5
+#define UBX_SYNC2 0x62
+
+// CFG-VALSET keys, the size of the value is in bits 28..30
+#define CFG_UART1_BAUDRATE            0x40520001U
+#define CFG_UART1OUTPROT_UBX          0x10740001U
+#define CFG_UART1OUTPROT_NMEA         0x10740002U
+#define CFG_MSGOUT_UBX_NAV_PVT_UART1  0x20910007U
+#define CFG_NAVSPG_DYNMODEL           0x20110021U
+#define CFG_RATE_MEAS                 0x30210001U
+#define CFG_RATE_NAV                  0x30210002U
+
+#define DYNMODEL_SEA 5
+
+// NAV-PVT flags
+#define PVT_FLAGS_GNSS_FIX_OK  (1U<<0)
+#define PVT_FLAGS_DIFF_SOLN    (1U<<1)
+#define PVT_FLAGS_CARR_SOLN(f) (((f)>>6) & 3U)
+#define PVT_VALID_DATE         (1U<<0)
+#define PVT_VALID_TIME         (1U<<1)
+
+// payload fields are little endian, like the ESP32
+template <typename T>
+static T get_le(const uint8_t *p)
+{
+    T v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+bool UBX_Parser::feed(uint8_t b)
+{
+    switch (state) {
+    case State::SYNC1:
+        if (b == UBX_SYNC1) {
+            state = State::SYNC2;
+        }
+        return false;
+
+    case State::SYNC2:
+        state = b == UBX_SYNC2 ? State::CLASS : b == UBX_SYNC1 ? State::SYNC2 : State::SYNC1;
+        return false;
+
+    case State::CLASS:
+        ck_a = ck_b = 0;
+        checksum(b);
+        msg_class = b;
+        state = State::ID;
+        return false;
+
+    case State::ID:
+        checksum(b);
+        msg_id = b;
+        state = State::LEN1;
+        return false;
+
+    case State::LEN1:
+        checksum(b);
+        length = b;
+        state = State::LEN2;
+        return false;
+
+    case State::LEN2:
+        checksum(b);
+        length |= uint16_t(b) << 8;
+        count = 0;
+        state = length > 0 ? State::PAYLOAD : State::CK_A;
+        return false;
+
+    case State::PAYLOAD:
+        checksum(b);
+        if (count < PAYLOAD_SIZE) {
+            payload[count] = b;
+        }
+        if (++count == length) {
+            state = State::CK_A;
+        }
+        return false;
+
+    case State::CK_A:
+        if (b != ck_a) {
+            checksum_errors++;
+            state = b == UBX_SYNC1 ? State::SYNC2 : State::SYNC1;
+            return false;
+        }
+        state = State::CK_B;
+        return false;
+
+    case State::CK_B:
+        state = State::SYNC1;
+        if (b != ck_b) {
+            checksum_errors++;
+            return false;
+        }
+        frames++;
+        end_frame();
+        return msg_class == CLASS_NAV && msg_id == MSG_NAV_PVT && length == PAYLOAD_SIZE;
+    }
+    return false;
+}
+
+void UBX_Parser::end_frame(void)
+{
+    switch (msg_class) {
+    case CLASS_NAV:
+        if (msg_id == MSG_NAV_PVT && length == PAYLOAD_SIZE) {
+            decode_nav_pvt();
+        }
+        break;
+    case CLASS_ACK:
+        if (length == 2) {
+            ack_class = payload[0];
+            ack_id = payload[1];
+            ack_ok = msg_id == MSG_ACK_ACK;
+            ack_pending = true;
+        }
+        break;
+    }
+}
+
+bool UBX_Parser::get_ack(uint8_t _class, uint8_t _id, bool &acked)
+{
+    if (!ack_pending || ack_class != _class || ack_id != _id) {
+        return false;
+    }
+    ack_pending = false;
+    acked = ack_ok;
+    return true;
+}
+
+void UBX_Parser::decode_nav_pvt(void)
+{
+    const uint8_t *p = payload;
+    const uint8_t valid = p[11];
+    const uint8_t fix_type = p[20];
+    const uint8_t flags = p[21];
+
+    if (valid & PVT_VALID_TIME) {
+        const int32_t nano = get_le<int32_t>(&p[16]);
+        const int32_t ms = ((p[8]*60 + p[9])*60 + p[10])*1000 + nano / 1000000;
+        fix.time_ms = ms < 0 ? 0 : uint32_t(ms);
+    }
+    if (valid & PVT_VALID_DATE) {
+        fix.date = (p[7]*100 + p[6])*100 + get_le<uint16_t>(&p[4]) % 100;
+    }
+
+    fix.valid = (flags & PVT_FLAGS_GNSS_FIX_OK) && fix_type >= 2 && fix_type <= 4;
+    fix.fix_type = fix_type == 2 ? 2 : (fix_type == 3 || fix_type == 4) ? 3 : 1;
+    if (!fix.valid) {
+        fix.fix_quality = 0;
+    } else {
+        switch (PVT_FLAGS_CARR_SOLN(flags)) {
+        case 1: fix.fix_quality = 5; break;
+        case 2: fix.fix_quality = 4; break;
+        default: fix.fix_quality = (flags & PVT_FLAGS_DIFF_SOLN) ? 2 : 1; break;
+        }
+    }
+    fix.num_sats = p[23];
+
+    fix.longitude = get_le<int32_t>(&p[24]) * 1.0e-7;
+    fix.latitude = get_le<int32_t>(&p[28]) * 1.0e-7;
+    const int32_t height_mm = get_le<int32_t>(&p[32]);
+    const int32_t hmsl_mm = get_le<int32_t>(&p[36]);
+    fix.altitude_msl = hmsl_mm * 0.001f;
+    fix.geoid_sep = (height_mm - hmsl_mm) * 0.001f;
+    fix.horiz_accuracy = get_le<uint32_t>(&p[40]) * 0.001f;
+    fix.vert_accuracy = get_le<uint32_t>(&p[44]) * 0.001f;
+    fix.ground_speed = get_le<int32_t>(&p[60]) * 0.001f;
+    float course = get_le<int32_t>(&p[64]) * 1.0e-5f;
+    if (course < 0) {
+        course += 360;
+    }
+    fix.course = course;
+
+    // NAV-PVT has no HDOP/VDOP split, only PDOP
+    fix.hdop = 0;
+    fix.vdop = 0;
+
+    updated = true;
+}
+
+// append one key/value pair, the value size comes from the key
+static uint8_t *put_key(uint8_t *p, uint32_t key, uint32_t value)
+{
+    static const uint8_t value_size[8] = { 0, 1, 1, 2, 4, 8, 0, 0 };
+    memcpy(p, &key, 4);
+    p += 4;
+    const uint8_t n = value_size[(key >> 28) & 7];
+    memcpy(p, &value, n);
+    return p + n;
+}
+
+size_t UBX_Parser::build_config(uint8_t *buf, size_t size, uint32_t baudrate, uint8_t rate_hz)
+{
+    // header, VALSET header, 7 keys of at most 8 bytes, checksum
+    if (size < 6 + 4 + 7*8 + 2 || rate_hz == 0) {
+        return 0;
+    }
+    uint8_t *p = &buf[6];
+    *p++ = 0;           // version
+    *p++ = 0x03;        // layers: RAM and BBR
+    *p++ = 0;
+    *p++ = 0;
+    p = put_key(p, CFG_UART1OUTPROT_UBX, 1);
+    p = put_key(p, CFG_UART1OUTPROT_NMEA, 0);
+    p = put_key(p, CFG_MSGOUT_UBX_NAV_PVT_UART1, 1);
+    p = put_key(p, CFG_NAVSPG_DYNMODEL, DYNMODEL_SEA);
+    p = put_key(p, CFG_RATE_MEAS, 1000U / rate_hz);
+    p = put_key(p, CFG_RATE_NAV, 1);
+    if (baudrate != 0) {
+        // last, the receiver changes speed once the frame is applied
+        p = put_key(p, CFG_UART1_BAUDRATE, baudrate);
+    }
+    const uint16_t len = p - &buf[6];
+
+    buf[0] = UBX_SYNC1;
+    buf[1] = UBX_SYNC2;
+    buf[2] = CLASS_CFG;
+    buf[3] = MSG_CFG_VALSET;
+    buf[4] = len & 0xFF;
+    buf[5] = len >> 8;
+    uint8_t a = 0, b = 0;
+    for (uint8_t *c = &buf[2]; c < p; c++) {
+        a += *c;
+        b += a;
+    }
+    *p++ = a;
+    *p++ = b;
+    return p - buf;
+}
@@ -0,0 +1,90 @@
+/*
+  u-blox UBX binary protocol: NAV-PVT parser and receiver configuration
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "gnss.h"
+
+class UBX_Parser {
+public:
+    /*
+      feed one byte of the stream. Frames are checked with the UBX
+      Fletcher checksum; a good NAV-PVT updates the fix. Returns true
+      when a NAV-PVT completed
+     */
+    bool feed(uint8_t b);
+
+    const GNSS_Fix &get_fix(void) const {
+        return fix;
+    }
+
+    // true if a NAV-PVT arrived since the last call, clearing it
+    bool get_updated(void) {
+        const bool ret = updated;
+        updated = false;
+        return ret;
+    }
+
+    // last ACK-ACK (true) or ACK-NAK (false) seen for a message, the
+    // ack is cleared when read
+    bool get_ack(uint8_t _class, uint8_t _id, bool &acked);
+
+    uint32_t get_frames(void) const {
+        return frames;
+    }
+    uint32_t get_checksum_errors(void) const {
+        return checksum_errors;
+    }
+
+    /*
+      build a CFG-VALSET frame setting the port to baudrate, UBX only
+      output, NAV-PVT every measurement at rate_hz and the sea dynamic
+      model, in RAM and battery backed RAM. A zero baudrate leaves the
+      port speed alone. Returns the frame length, 0 if buf is too small
+     */
+    static size_t build_config(uint8_t *buf, size_t size, uint32_t baudrate, uint8_t rate_hz);
+
+    static constexpr uint8_t CLASS_NAV = 0x01;
+    static constexpr uint8_t CLASS_ACK = 0x05;
+    static constexpr uint8_t CLASS_CFG = 0x06;
+    static constexpr uint8_t MSG_NAV_PVT = 0x07;
+    static constexpr uint8_t MSG_ACK_NAK = 0x00;
+    static constexpr uint8_t MSG_ACK_ACK = 0x01;
+    static constexpr uint8_t MSG_CFG_VALSET = 0x8A;
+
+private:
+    enum class State : uint8_t {
+        SYNC1, SYNC2, CLASS, ID, LEN1, LEN2, PAYLOAD, CK_A, CK_B,
+    } state;
+
+    uint8_t msg_class;
+    uint8_t msg_id;
+    uint16_t length;
+    uint16_t count;
+    uint8_t ck_a;
+    uint8_t ck_b;
+
+    // NAV-PVT is the largest frame we decode, longer ones are skipped
+    static constexpr uint16_t PAYLOAD_SIZE = 92;
+    uint8_t payload[PAYLOAD_SIZE];
+
+    GNSS_Fix fix;
+    bool updated;
+
+    uint8_t ack_class;
+    uint8_t ack_id;
+    bool ack_pending;
+    bool ack_ok;
+
+    uint32_t frames;
+    uint32_t checksum_errors;
+
+    void checksum(uint8_t b) {
+        ck_a += b;
+        ck_b += ck_a;
+    }
+    void end_frame(void);
+    void decode_nav_pvt(void);
+};
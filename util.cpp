@@ -1,5 +1,6 @@
 #include "util.h"
 #include <string.h>
+#include <math.h>
 
 /*
   64 bit crc from ArduPilot
@@ -27,6 +28,20 @@ uint64_t crc_crc64(const uint32_t *data, uint16_t num_words)
     return crc;
 }
 
+/*
+  32 bit crc from ArduPilot, pass 0 to start
+*/
+uint32_t crc_crc32(uint32_t crc, const uint8_t *buf, uint32_t size)
+{
+    while (size--) {
+        crc ^= *buf++;
+        for (uint8_t i = 0; i < 8; i++) {
+            crc = (crc >> 1u) ^ ((crc & 1u) ? 0xEDB88320U : 0);
+        }
+    }
+    return crc;
+}
+
 static const char b64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 
 /*
@@ -105,3 +120,18 @@ char *base64_encode(const uint8_t *d, int len)
 
     return out;
 }
+
+float wrap_360(float angle_deg)
+{
+    float a = fmodf(angle_deg, 360);
+    if (a < 0) {
+        a += 360;
+    }
+    return a;
+}
+
+float wrap_180(float angle_deg)
+{
+    const float a = wrap_360(angle_deg);
+    return a > 180 ? a - 360 : a;
+}
@@ -4,6 +4,10 @@
 #define MIN(a,b) ((a)<(b)?(a):(b))
 #endif
 
+#ifndef MAX
+#define MAX(a,b) ((a)>(b)?(a):(b))
+#endif
+
 #define ARRAY_SIZE(a) (sizeof(a) / sizeof(a[0]))
 
 #include <stdint.h>
@@ -13,6 +17,11 @@
 */
 uint64_t crc_crc64(const uint32_t *data, uint16_t num_words);
 
+/*
+  32 bit crc from ArduPilot, pass 0 to start
+*/
+uint32_t crc_crc32(uint32_t crc, const uint8_t *buf, uint32_t size);
+
 /*
   decode a base64 string
  */
@@ -23,3 +32,9 @@ int32_t base64_decode(const char *s, uint8_t *out, const uint32_t max_len);
 */
 char *base64_encode(const uint8_t *buf, int len);
 
+
+/*
+  wrap an angle in degrees to -180 to 180 or 0 to 360
+ */
+float wrap_180(float angle_deg);
+float wrap_360(float angle_deg);
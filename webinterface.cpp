@@ -112,6 +112,7 @@ void WebInterface::init(void)
 			server.sendHeader("Connection", "close");
 			server.send(200, "text/plain","OK");
 			Serial.printf("Update Success: \nRebooting...\n");
+			g.flush();
 			delay(1000);
 			ESP.restart();
 		}
@@ -121,6 +122,8 @@ void WebInterface::init(void)
         if (upload.status == UPLOAD_FILE_START) {
             Serial.printf("Update: %s\n", upload.filename.c_str());
             lead_len = 0;
+            // store pending parameter sets before flash is busy with the image
+            g.flush();
 
             if (!Update.begin(UPDATE_SIZE_UNKNOWN)) { //start with max available size
                 Update.printError(Serial);